@@ -484,10 +484,12 @@ HEADERS += \
 #    src/comm/QGCXPlaneLink.h \
     src/comm/serialconnection.h \
     src/ui/CommConfigurationWindow.h \
+    src/ui/MAVLinkRoutingDialog.h \
     src/ui/SerialConfigurationWindow.h \
     src/ui/MainWindow.h \
     src/ui/uas/UASControlWidget.h \
     src/ui/uas/UASListWidget.h \
+    src/ui/uas/UASGroupCommandWidget.h \
     src/ui/uas/UASInfoWidget.h \
     src/ui/HUD.h \
     src/configuration.h \
@@ -498,6 +500,8 @@ HEADERS += \
     src/comm/TCPLink.h \
     src/ui/ParameterInterface.h \
     src/ui/WaypointList.h \
+    src/ui/WaypointListModel.h \
+    src/ui/WaypointItemDelegate.h \
     src/ui/WaypointNavigation.h \
     src/Waypoint.h \
     src/ui/ObjectDetectionView.h \
@@ -545,9 +549,11 @@ HEADERS += \
     src/ui/map/QGCMapWidget.h \
     src/ui/map/MAV2DIcon.h \
     src/ui/map/Waypoint2DIcon.h \
+    src/ui/map/WaypointPathOverlay.h \
     src/ui/map/QGCMapTool.h \
     src/ui/map/QGCMapToolBar.h \
     src/QGCGeo.h \
+    src/TerrainDatabase.h \
     src/ui/QGCToolBar.h \
     src/ui/QGCStatusBar.h \
     src/ui/QGCMAVLinkInspector.h \
@@ -609,6 +615,7 @@ HEADERS += \
     src/ui/configuration/ApmSoftwareConfig.h \
     src/ui/configuration/FrameTypeConfig.h \
     src/ui/configuration/CompassConfig.h \
+    src/ui/configuration/CompassCalibrator.h \
     src/ui/configuration/AccelCalibrationConfig.h \
     src/ui/configuration/RadioCalibrationConfig.h \
     src/ui/configuration/FlightModeConfig.h \
@@ -649,10 +656,15 @@ HEADERS += \
     src/ui/configuration/DownloadRemoteParamsDialog.h \
     src/ui/configuration/ParamCompareDialog.h \
     src/uas/UASParameter.h \
+    src/uas/UASTelemetryStore.h \
+    src/uas/UASTimeSync.h \
+    src/uas/UASSharedTelemetry.h \
+    src/uas/UASSharedTelemetryExporter.h \
     src/output/kmlcreator.h \
     src/output/logdata.h \
     src/ui/AP2DataPlot2D.h \
     src/ui/AP2DataPlotThread.h \
+    src/ui/AP2DataPlotOnlineBuffer.h \
     src/ui/dataselectionscreen.h \
     src/ui/qcustomplot.h \
     src/globalobject.h \
@@ -666,11 +678,15 @@ HEADERS += \
     src/ui/AutoUpdateCheck.h \
     src/ui/AutoUpdateDialog.h \
     src/uas/LogDownloadDialog.h \
+    src/uas/LogDownloader.h \
     src/comm/TLogReplayLink.h \
     src/ui/PrimaryFlightDisplayQML.h \
     src/ui/configuration/CompassMotorCalibrationDialog.h \
     src/comm/MAVLinkDecoder.h \
     src/comm/MAVLinkProtocol.h \
+    src/comm/MAVLinkRouter.h \
+    src/comm/MAVLinkCommandDispatcher.h \
+    src/comm/MAVLinkProfiler.h \
     src/ui/MissionElevationDisplay.h \
     src/ui/GoogleElevationData.h \
     src/comm/UASObject.h \
@@ -696,6 +712,12 @@ HEADERS += \
     src/ui/Loghandling/TlogParser.h \
     src/ui/Loghandling/LogdataStorage.h \
     src/ui/Loghandling/LogExporter.h \
+    src/ui/Loghandling/IExportCallback.h \
+    src/ui/Loghandling/LogExportThread.h \
+    src/ui/Loghandling/LogTableFilterProxyModel.h \
+    src/ui/Loghandling/RangeStatistics.h \
+    src/ui/Loghandling/LogBatchProcessor.h \
+    src/ui/Loghandling/LogAnalysisGraph.h \
     src/ui/Loghandling/LogAnalysis.h \
     src/ui/Loghandling/LogAnalysisMap.h \
     src/ui/Loghandling/PresetManager.h \
@@ -712,10 +734,12 @@ SOURCES += src/main.cc \
 #    src/comm/QGCXPlaneLink.cc \
     src/comm/serialconnection.cc \
     src/ui/CommConfigurationWindow.cc \
+    src/ui/MAVLinkRoutingDialog.cc \
     src/ui/SerialConfigurationWindow.cc \
     src/ui/MainWindow.cc \
     src/ui/uas/UASControlWidget.cc \
     src/ui/uas/UASListWidget.cc \
+    src/ui/uas/UASGroupCommandWidget.cc \
     src/ui/uas/UASInfoWidget.cc \
     src/ui/HUD.cc \
     src/ui/uas/UASView.cc \
@@ -725,6 +749,8 @@ SOURCES += src/main.cc \
     src/comm/TCPLink.cc \
     src/ui/ParameterInterface.cc \
     src/ui/WaypointList.cc \
+    src/ui/WaypointListModel.cc \
+    src/ui/WaypointItemDelegate.cc \
     src/ui/WaypointNavigation.cc \
     src/Waypoint.cc \
     src/ui/ObjectDetectionView.cc \
@@ -771,9 +797,11 @@ SOURCES += src/main.cc \
     src/ui/map/QGCMapWidget.cc \
     src/ui/map/MAV2DIcon.cc \
     src/ui/map/Waypoint2DIcon.cc \
+    src/ui/map/WaypointPathOverlay.cc \
     src/ui/map/QGCMapTool.cc \
     src/ui/map/QGCMapToolBar.cc \
     src/QGCGeo.cc \
+    src/TerrainDatabase.cc \
     src/ui/QGCToolBar.cc \
     src/ui/QGCStatusBar.cc \
     src/ui/QGCMAVLinkInspector.cc \
@@ -834,6 +862,7 @@ SOURCES += src/main.cc \
     src/ui/configuration/ApmSoftwareConfig.cc \
     src/ui/configuration/FrameTypeConfig.cc \
     src/ui/configuration/CompassConfig.cc \
+    src/ui/configuration/CompassCalibrator.cc \
     src/ui/configuration/AccelCalibrationConfig.cc \
     src/ui/configuration/RadioCalibrationConfig.cc \
     src/ui/configuration/FlightModeConfig.cc \
@@ -874,10 +903,14 @@ SOURCES += src/main.cc \
     src/ui/configuration/DownloadRemoteParamsDialog.cc \
     src/ui/configuration/ParamCompareDialog.cpp \
     src/uas/UASParameter.cpp \
+    src/uas/UASTelemetryStore.cpp \
+    src/uas/UASTimeSync.cpp \
+    src/uas/UASSharedTelemetryExporter.cpp \
     src/output/kmlcreator.cc \
     src/output/logdata.cc \
     src/ui/AP2DataPlot2D.cpp \
     src/ui/AP2DataPlotThread.cc \
+    src/ui/AP2DataPlotOnlineBuffer.cc \
     src/ui/dataselectionscreen.cpp \
     src/ui/qcustomplot.cpp \
     src/globalobject.cc \
@@ -891,11 +924,15 @@ SOURCES += src/main.cc \
     src/ui/AutoUpdateCheck.cc \
     src/ui/AutoUpdateDialog.cc \
     src/uas/LogDownloadDialog.cc \
+    src/uas/LogDownloader.cc \
     src/comm/TLogReplayLink.cc \
     src/ui/PrimaryFlightDisplayQML.cpp \
     src/ui/configuration/CompassMotorCalibrationDialog.cpp \
     src/comm/MAVLinkDecoder.cc \
     src/comm/MAVLinkProtocol.cc \
+    src/comm/MAVLinkRouter.cc \
+    src/comm/MAVLinkCommandDispatcher.cc \
+    src/comm/MAVLinkProfiler.cc \
     src/ui/MissionElevationDisplay.cpp \
     src/ui/GoogleElevationData.cpp \
     src/comm/UASObject.cc \
@@ -918,6 +955,11 @@ SOURCES += src/main.cc \
     src/ui/Loghandling/TlogParser.cpp \
     src/ui/Loghandling/LogdataStorage.cpp \
     src/ui/Loghandling/LogExporter.cpp \
+    src/ui/Loghandling/LogExportThread.cpp \
+    src/ui/Loghandling/LogTableFilterProxyModel.cpp \
+    src/ui/Loghandling/RangeStatistics.cpp \
+    src/ui/Loghandling/LogBatchProcessor.cpp \
+    src/ui/Loghandling/LogAnalysisGraph.cpp \
     src/ui/Loghandling/LogAnalysis.cpp \
     src/ui/Loghandling/LogAnalysisMap.cpp\
     src/ui/Loghandling/PresetManager.cpp \
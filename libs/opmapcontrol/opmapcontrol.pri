@@ -46,6 +46,7 @@ HEADERS += opmapcontrol.h \
            src/mapwidget/opmapwidget.h \
            src/mapwidget/trailitem.h \
            src/mapwidget/traillineitem.h \
+           src/mapwidget/trailpathitem.h \
            src/mapwidget/uavitem.h \
            src/mapwidget/uavmapfollowtype.h \
            src/mapwidget/uavtrailtype.h \
@@ -93,6 +94,7 @@ SOURCES += src/core/alllayersoftype.cpp \
            src/mapwidget/opmapwidget.cpp \
            src/mapwidget/trailitem.cpp \
            src/mapwidget/traillineitem.cpp \
+           src/mapwidget/trailpathitem.cpp \
            src/mapwidget/uavitem.cpp \
            src/mapwidget/waypointitem.cpp \
            src/internals/projections/lks94projection.cpp \
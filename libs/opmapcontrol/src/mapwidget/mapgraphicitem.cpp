@@ -93,9 +93,8 @@ namespace mapcontrol
         {
             if (GraphicsItem* w = dynamic_cast<GraphicsItem*>(i))
                 w->RefreshPos();
-
-            emit mapChanged();
         }
+        emit mapChanged();
     }
     void MapGraphicItem::ConstructLastImage(int const& zoomdiff)
     {
@@ -14,7 +14,8 @@ SOURCES += mapgraphicitem.cpp \
     homeitem.cpp \
     mapripform.cpp \
     mapripper.cpp \
-    traillineitem.cpp
+    traillineitem.cpp \
+    trailpathitem.cpp
 
 LIBS += -L../build \
     -lcore \
@@ -38,6 +39,7 @@ HEADERS += mapgraphicitem.h \
     mapripform.h \
     mapripper.h \
     traillineitem.h \
+    trailpathitem.h \
     omapconfiguration.h \
     graphicsitem.h \
     graphicsusertypes.h
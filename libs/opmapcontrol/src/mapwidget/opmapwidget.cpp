@@ -40,6 +40,7 @@ namespace mapcontrol
         Home(0),
         p_Trail(nullptr),
         p_TrailCursor(nullptr),
+        p_TrailPath(nullptr),
         followmouse(true),
         compass(0),
         showuav(false),
@@ -117,6 +118,13 @@ namespace mapcontrol
         return p_TrailCursor;
     }
 
+    TrailPathItem *OPMapWidget::AddTrailPath()
+    {
+        p_TrailPath = new TrailPathItem(map, this);
+        p_TrailPath->setParentItem(map);
+        return p_TrailPath;
+    }
+
     UAVItem* OPMapWidget::AddUAV(int id)
     {
         UAVItem* newUAV = new UAVItem(map,this);
@@ -250,6 +258,7 @@ namespace mapcontrol
         delete UAV;
         delete p_Trail;
         delete p_TrailCursor;
+        delete p_TrailPath;
 
         foreach(UAVItem* uav, this->UAVS)
         {
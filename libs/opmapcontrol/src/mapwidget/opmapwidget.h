@@ -40,6 +40,7 @@
 #include "QtSvg/QGraphicsSvgItem"
 #include "uavitem.h"
 #include "gpsitem.h"
+#include "trailpathitem.h"
 #include "homeitem.h"
 #include "waypointlineitem.h"
 #include "mapripper.h"
@@ -48,6 +49,7 @@ namespace mapcontrol
 {
     class UAVItem;
     class GPSItem;
+    class TrailPathItem;
     class HomeItem;
     /**
     * @brief Collection of static functions to help dealing with various enums used
@@ -365,10 +367,18 @@ namespace mapcontrol
         HomeItem* Home;
         GPSItem *p_Trail;
         GPSItem *p_TrailCursor;
+        TrailPathItem *p_TrailPath;
         // END OF FIXME XXX
 
         GPSItem *AddTrail();
         GPSItem *AddTrailCursor();
+        /**
+        * @brief Adds a trail which takes all positions at once. Use it instead of AddTrail()
+        *        if all positions are known (e.g. log analysis).
+        *
+        * @return TrailPathItem* the trail - the map widget takes the ownership
+        */
+        TrailPathItem *AddTrailPath();
 
         UAVItem* AddUAV(int id);
         void AddUAV(int id, UAVItem* uav);
@@ -0,0 +1,295 @@
+/**
+******************************************************************************
+*
+* @file       trailpathitem.cpp
+* @brief      A graphicsItem representing a complete, simplified trail
+* @see        The GNU Public License (GPL) Version 3
+* @defgroup   OPMapWidget
+* @{
+*
+*****************************************************************************/
+/*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+* or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+* for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#include "../internals/pureprojection.h"
+#include "trailpathitem.h"
+#include "mapgraphicitem.h"
+#include "opmapwidget.h"
+
+#include <QStyleOptionGraphicsItem>
+#include <QPainter>
+#include <QStack>
+#include <limits>
+#include <cmath>
+
+namespace mapcontrol
+{
+    namespace
+    {
+        // distance of p to the segment a-b
+        double DistanceToSegment(QPointF const& p, QPointF const& a, QPointF const& b)
+        {
+            const double dx = b.x() - a.x();
+            const double dy = b.y() - a.y();
+            const double lengthSquared = dx * dx + dy * dy;
+            double t = 0.0;
+            if(lengthSquared > 0.0)
+            {
+                t = ((p.x() - a.x()) * dx + (p.y() - a.y()) * dy) / lengthSquared;
+                t = qBound(0.0, t, 1.0);
+            }
+            return std::hypot(p.x() - (a.x() + t * dx), p.y() - (a.y() + t * dy));
+        }
+    }
+
+    TrailPathItem::TrailPathItem(MapGraphicItem* map, OPMapWidget* parent) :
+        GraphicsItem(map, parent),
+        farthestIndex(0),
+        currentLevel(0),
+        currentScale(1.0),
+        pen(Qt::green)
+    {
+        pen.setWidth(2);
+        pen.setCosmetic(true);
+        this->setZValue(3);
+        this->setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+    }
+
+    TrailPathItem::~TrailPathItem()
+    {
+    }
+
+    void TrailPathItem::SetPath(QVector<double> const& lat, QVector<double> const& lng, int const& first)
+    {
+        prepareGeometryChange();
+        points.clear();
+        significance.clear();
+        levels.clear();
+        bounds = QRectF();
+        farthest = QPointF();
+        farthestIndex = 0;
+
+        const int count = qMin(lat.size(), lng.size());
+        if(first >= count)
+        {
+            return;
+        }
+
+        // Work in pixels of the max zoom level. Every other level is just a power of two smaller.
+        const int maxZoom = mapwidget->MaxZoom();
+        internals::PureProjection* projection = map->Projection();
+        origin = internals::PointLatLng(lat.at(first), lng.at(first));
+        const core::Point originPixel = projection->FromLatLngToPixel(origin, maxZoom);
+
+        points.reserve(count - first);
+        double minX = 0.0, maxX = 0.0, minY = 0.0, maxY = 0.0;
+        double farthestDistance = 0.0;
+        for(int i = first; i < count; ++i)
+        {
+            const core::Point pixel = projection->FromLatLngToPixel(lat.at(i), lng.at(i), maxZoom);
+            const QPointF point(static_cast<double>(pixel.X()) - originPixel.X(), static_cast<double>(pixel.Y()) - originPixel.Y());
+            points.append(point);
+
+            minX = qMin(minX, point.x());
+            maxX = qMax(maxX, point.x());
+            minY = qMin(minY, point.y());
+            maxY = qMax(maxY, point.y());
+
+            const double distance = qAbs(point.x()) + qAbs(point.y());
+            if(distance > farthestDistance)
+            {
+                farthestDistance = distance;
+                farthest = point;
+                farthestIndex = points.size() - 1;
+                farthestCoord = internals::PointLatLng(lat.at(i), lng.at(i));
+            }
+        }
+        bounds = QRectF(QPointF(minX, minY), QPointF(maxX, maxY));
+
+        ComputeSignificance();
+        RefreshPos();
+    }
+
+    void TrailPathItem::SetPen(QPen const& value)
+    {
+        pen = value;
+        pen.setCosmetic(true);
+        this->update();
+    }
+
+    void TrailPathItem::ComputeSignificance()
+    {
+        // Douglas-Peucker without recursion. Instead of simplifying for one tolerance every
+        // position gets the largest tolerance it survives. A position can not be more
+        // significant than the one which split its segment, so the levels are nested.
+        const int count = points.size();
+        significance.fill(0.0, count);
+        if(count == 0)
+        {
+            return;
+        }
+        significance[0] = std::numeric_limits<double>::max();
+        significance[count - 1] = std::numeric_limits<double>::max();
+
+        struct Segment
+        {
+            int start;
+            int end;
+            double parentSignificance;
+        };
+        QStack<Segment> stack;
+        stack.push(Segment{0, count - 1, std::numeric_limits<double>::max()});
+
+        while(!stack.isEmpty())
+        {
+            const Segment segment = stack.pop();
+            if(segment.end - segment.start < 2)
+            {
+                continue;
+            }
+
+            int maxIndex = segment.start + 1;
+            double maxDistance = -1.0;
+            const QPointF& a = points.at(segment.start);
+            const QPointF& b = points.at(segment.end);
+            for(int i = segment.start + 1; i < segment.end; ++i)
+            {
+                const double distance = DistanceToSegment(points.at(i), a, b);
+                if(distance > maxDistance)
+                {
+                    maxDistance = distance;
+                    maxIndex = i;
+                }
+            }
+
+            const double value = qMin(maxDistance, segment.parentSignificance);
+            significance[maxIndex] = value;
+            stack.push(Segment{segment.start, maxIndex, value});
+            stack.push(Segment{maxIndex, segment.end, value});
+        }
+    }
+
+    TrailPathItem::ChunkList const& TrailPathItem::ChunksForLevel(int const& level)
+    {
+        QHash<int, ChunkList>::const_iterator iter = levels.constFind(level);
+        if(iter != levels.constEnd())
+        {
+            return iter.value();
+        }
+
+        // Half a screen pixel at this level is the tolerance. A chunk bound needs a margin of
+        // about one screen pixel as a straight line has an empty bounding rect.
+        const double levelScale = std::ldexp(1.0, level);
+        const double tolerance = 0.5 * levelScale;
+        const double margin = 2.0 * levelScale;
+
+        ChunkList chunks;
+        Chunk chunk;
+        int pointsInChunk = 0;
+        QPointF lastPoint;
+        for(int i = 0; i < points.size(); ++i)
+        {
+            if(significance.at(i) < tolerance)
+            {
+                continue;
+            }
+            const QPointF& point = points.at(i);
+            if(pointsInChunk == 0)
+            {
+                chunk.path.moveTo(point);
+            }
+            else
+            {
+                chunk.path.lineTo(point);
+            }
+            ++pointsInChunk;
+            lastPoint = point;
+
+            if(pointsInChunk >= PointsPerChunk)
+            {
+                chunk.bounds = chunk.path.boundingRect().adjusted(-margin, -margin, margin, margin);
+                chunks.append(chunk);
+                // next chunk starts where this one ends
+                chunk = Chunk();
+                chunk.path.moveTo(lastPoint);
+                pointsInChunk = 1;
+            }
+        }
+        if(pointsInChunk > 1)
+        {
+            chunk.bounds = chunk.path.boundingRect().adjusted(-margin, -margin, margin, margin);
+            chunks.append(chunk);
+        }
+
+        return *levels.insert(level, chunks);
+    }
+
+    void TrailPathItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+    {
+        Q_UNUSED(widget);
+        painter->setPen(pen);
+        painter->setBrush(Qt::NoBrush);
+        foreach(const Chunk& chunk, ChunksForLevel(currentLevel))
+        {
+            if(chunk.bounds.intersects(option->exposedRect))
+            {
+                painter->drawPath(chunk.path);
+            }
+        }
+    }
+
+    QRectF TrailPathItem::boundingRect()const
+    {
+        const double margin = 2.0 / currentScale;  // the cosmetic pen is 2 pixels wide
+        return bounds.adjusted(-margin, -margin, margin, margin);
+    }
+
+    int TrailPathItem::type()const
+    {
+        return Type;
+    }
+
+    void TrailPathItem::RefreshPos()
+    {
+        if(points.isEmpty())
+        {
+            return;
+        }
+
+        const core::Point localOrigin = map->FromLatLngToLocal(origin);
+
+        // The scale between max zoom pixels and screen pixels. Use the farthest position to
+        // measure it (includes the digital zoom of the map). Near positions suffer from
+        // rounding - use the zoom step in that case.
+        qreal scale = std::ldexp(1.0, static_cast<int>(std::floor(mapwidget->ZoomReal())) - mapwidget->MaxZoom());
+        if(farthestIndex > 0)
+        {
+            const core::Point localFarthest = map->FromLatLngToLocal(farthestCoord);
+            const double localDistance = std::hypot(static_cast<double>(localFarthest.X() - localOrigin.X()),
+                                                    static_cast<double>(localFarthest.Y() - localOrigin.Y()));
+            if(localDistance > 100.0)
+            {
+                scale = localDistance / std::hypot(farthest.x(), farthest.y());
+            }
+        }
+
+        prepareGeometryChange();
+        currentScale = scale;
+        currentLevel = qMax(0, static_cast<int>(std::floor(std::log2(1.0 / scale))));
+        this->setPos(localOrigin.X(), localOrigin.Y());
+        this->setTransform(QTransform::fromScale(scale, scale));
+        this->update();
+    }
+}
@@ -0,0 +1,101 @@
+/**
+******************************************************************************
+*
+* @file       trailpathitem.h
+* @brief      A graphicsItem representing a complete, simplified trail
+* @see        The GNU Public License (GPL) Version 3
+* @defgroup   OPMapWidget
+* @{
+*
+*****************************************************************************/
+/*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+* or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+* for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#ifndef TRAILPATHITEM_H
+#define TRAILPATHITEM_H
+
+#include <QPen>
+#include <QPainterPath>
+#include <QVector>
+#include <QHash>
+#include "graphicsitem.h"
+#include "graphicsusertypes.h"
+
+namespace mapcontrol
+{
+    /**
+    * @brief A QGraphicsItem holding a whole trail in one item. In contrast to the GPSItem trail
+    *        which creates one item per position this item takes all positions at once. The
+    *        positions are simplified (Douglas-Peucker) for the current zoom level and split
+    *        into chunks so only the visible part of the trail is painted.
+    *
+    * @class TrailPathItem trailpathitem.h "mapwidget/trailpathitem.h"
+    */
+    class TrailPathItem : public GraphicsItem
+    {
+        Q_OBJECT
+        Q_INTERFACES(QGraphicsItem)
+    public:
+        enum { Type = usertypes::TRAILPATHITEM };
+        TrailPathItem(MapGraphicItem* map, OPMapWidget* parent);
+        ~TrailPathItem();
+
+        /**
+        * @brief Sets all positions of the trail. Replaces the positions set before.
+        *
+        * @param lat latitudes in degrees
+        * @param lng longitudes in degrees. Must have the same size as lat.
+        * @param first index of the first valid position
+        */
+        void SetPath(QVector<double> const& lat, QVector<double> const& lng, int const& first = 0);
+
+        /**
+        * @brief Sets the pen used to paint the trail. The pen is always cosmetic.
+        */
+        void SetPen(QPen const& pen);
+
+        void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
+                    QWidget *widget);
+        void RefreshPos();
+        QRectF boundingRect() const;
+        int type() const;
+
+    private:
+        static constexpr int PointsPerChunk = 256;  // max positions in one painted chunk
+
+        struct Chunk
+        {
+            QRectF bounds;          // bounding rect in item coordinates
+            QPainterPath path;      // the chunk of the trail
+        };
+        typedef QVector<Chunk> ChunkList;
+
+        QVector<QPointF> points;        // positions in pixels of the max zoom level relative to the first one
+        QVector<double> significance;   // Douglas-Peucker tolerance up to which a position is kept
+        QPointF farthest;               // point with the largest distance to the first one (used for scaling)
+        int farthestIndex;
+        internals::PointLatLng origin;  // the first position
+        internals::PointLatLng farthestCoord;
+        QRectF bounds;                  // bounding rect of all points
+        QHash<int, ChunkList> levels;   // simplified chunks per level, created on demand
+        int currentLevel;
+        qreal currentScale;             // screen pixels per max zoom level pixel
+        QPen pen;
+
+        void ComputeSignificance();
+        ChunkList const& ChunksForLevel(int const& level);
+    };
+}
+#endif // TRAILPATHITEM_H
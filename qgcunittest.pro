@@ -369,6 +369,9 @@ HEADERS += src/MG.h \
     src/ui/mission/QGCMissionNavTakeoff.h \
     $$TESTDIR/AutoTest.h \
     $$TESTDIR/UASUnitTest.h \
+    $$TESTDIR/UASSharedTelemetryTest.h \
+    src/uas/UASSharedTelemetry.h \
+    src/uas/UASSharedTelemetryExporter.h \
 
 # Google Earth is only supported on Mac OS and Windows with Visual Studio Compiler
 macx|macx-g++|macx-g++42|win32-msvc2008|win32-msvc2010::HEADERS += src/ui/map3D/QGCGoogleEarthView.h
@@ -516,7 +519,9 @@ SOURCES += src/QGCCore.cc \
     src/ui/QGCPluginHost.cc \
     src/ui/firmwareupdate/QGCPX4FirmwareUpdate.cc \
     $$TESTDIR/testSuite.cc \
-    $$TESTDIR/UASUnitTest.cc
+    $$TESTDIR/UASUnitTest.cc \
+    $$TESTDIR/UASSharedTelemetryTest.cc \
+    src/uas/UASSharedTelemetryExporter.cpp
 
 # Enable Google Earth only on Mac OS and Windows with Visual Studio compiler
 macx|macx-g++|macx-g++42|win32-msvc2008|win32-msvc2010::SOURCES += src/ui/map3D/QGCGoogleEarthView.cc
@@ -30,14 +30,74 @@ This file is part of the QGROUNDCONTROL project
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
-#include <QTemporaryFile>
-#include <QTextStream>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
+#include <QRunnable>
 #include <QStringList>
-#include <QFileInfo>
+#include <QThreadPool>
 #include <QList>
+#include <QVector>
 #include "LogCompressor.h"
 
+namespace
+{
+const qint64 s_ReadBlockSize = 4 * 1024 * 1024;     ///< Bytes read from the input file at once
+const int s_ReorderRows = 1024;                     ///< Rows held back to sort slightly out of order timestamps
+const int s_BlockCells = 1024 * 1024;               ///< Cells (rows * columns) hole filled and written as one block
+const int s_WriteBufferSize = 4 * 1024 * 1024;      ///< Output is written in chunks of this size
+const int s_MinColumnsPerShard = 8;                 ///< Fewer columns are not worth a thread
+const qint64 s_StatusIntervalMs = 1000;             ///< Interval of the throughput status
+
+typedef QVector<QByteArray> Column;
+
+/**
+ * @brief The HoleFillTask class fills the holes of a range of columns of one block
+ *        with the previous value of the same column. Each task owns its columns,
+ *        so the tasks of a block can run concurrently.
+ */
+class HoleFillTask : public QRunnable
+{
+public:
+    HoleFillTask(Column *columns, QByteArray *lastValues, int first, int last) :
+        m_columns(columns),
+        m_lastValues(lastValues),
+        m_first(first),
+        m_last(last)
+    {
+        setAutoDelete(false);
+    }
+
+    void run()
+    {
+        for (int column = m_first; column < m_last; ++column)
+        {
+            QByteArray lastValue = m_lastValues[column];
+            Column &cells = m_columns[column];
+            for (int row = 0; row < cells.size(); ++row)
+            {
+                QByteArray &cell = cells[row];
+                if (cell.isEmpty() || cell == "NaN")
+                {
+                    cell = lastValue;
+                }
+                else
+                {
+                    lastValue = cell;
+                }
+            }
+            m_lastValues[column] = lastValue;
+        }
+    }
+
+private:
+    Column *m_columns;
+    QByteArray *m_lastValues;
+    int m_first;
+    int m_last;
+};
 
+}
 
 /**
  * Initializes all the variables necessary for a compression run. This won't actually happen
@@ -49,7 +109,10 @@ LogCompressor::LogCompressor(QString logFileName, QString outFileName, QString d
 	running(true),
 	currentDataLine(0),
     delimiter(delimiter),
-    holeFillingEnabled(true)
+    holeFillingEnabled(true),
+    rowCounter(0),
+    lastWrittenTimestamp(0),
+    lateLines(0)
 {
 }
 
@@ -57,7 +120,7 @@ void LogCompressor::run()
 {
 	// Verify that the input file is useable
 	QFile infile(logFileName);
-	if (!infile.exists() || !infile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+	if (!infile.exists() || !infile.open(QIODevice::ReadOnly)) {
 		emit logProcessingStatusChanged(tr("Log Compressor: Cannot start/compress log file, since input file %1 is not readable").arg(QFileInfo(infile.fileName()).absoluteFilePath()));
 		return;
 	}
@@ -83,27 +146,31 @@ void LogCompressor::run()
 		return;
 	}
 
+    const QByteArray fieldDelimiter = delimiter.toLocal8Bit();
 
 	// First we search the input file through keySearchLimit number of lines
 	// looking for variables. This is neccessary before CSV files require
 	// the same number of fields for every line.
 	const unsigned int keySearchLimit = 15000;
 	unsigned int keyCounter = 0;
-	QTextStream in(&infile);
 	QMap<QString, int> messageMap;
 
-	while (!in.atEnd() && keyCounter < keySearchLimit) {
-		QString messageName = in.readLine().split(delimiter).at(2);
-		messageMap.insert(messageName, 0);
+	while (!infile.atEnd() && keyCounter < keySearchLimit) {
+        QList<QByteArray> fields = infile.readLine().trimmed().split(fieldDelimiter.at(0));
+        if (fields.size() > 2) {
+            messageMap.insert(QString::fromLocal8Bit(fields.at(2)), 0);
+        }
 		++keyCounter;
 	}
 
 	// Now update each key with its index in the output string. These are
 	// all offset by one to account for the first field: timestamp_ms.
+    columnMap.clear();
     QMap<QString, int>::iterator i = messageMap.begin();
 	int j;
 	for (i = messageMap.begin(), j = 1; i != messageMap.end(); ++i, ++j) {
 		i.value() = j;
+        columnMap.insert(i.key().toLocal8Bit(), j);
 	}
 
 	// Open the output file and write the header line to it
@@ -119,92 +186,203 @@ void LogCompressor::run()
 
     emit logProcessingStatusChanged(tr("Log compressor: Dataset contains dimensions: ") + headerLine);
 
-    // Template list stores a list for populating with data as it's parsed from messages.
-    QStringList templateList;
-    for (int i = 0; i < headerList.size() + 1; ++i) {
-        templateList << (holeFillingEnabled?"NaN":"");
-    }
-
-
-//	// Reset our position in the input file before we start the main processing loop.
-//    in.seek(0);
-
-//    // Search through all lines and build a list of unique timestamps
-//    QMap<quint64, QStringList> timestampMap;
-//    while (!in.atEnd()) {
-//        quint64 timestamp = in.readLine().split(delimiter).at(0).toULongLong();
-//        timestampMap.insert(timestamp, templateList);
-//    }
+    // Template row stores the cells of a new timestamp before its data is parsed.
+    templateRow.fill(holeFillingEnabled ? QByteArray("NaN") : QByteArray(), headerList.size() + 1);
+    lastValues = templateRow;
+    pendingRows.clear();
+    rowCounter = 0;
+    lateLines = 0;
+    outputBuffer.clear();
+    outputBuffer.reserve(s_WriteBufferSize + 4096);
 
     // Jump back to start of file
-    in.seek(0);
-
-    // Map of final output lines, key is time
-    QMap<quint64, QStringList> timestampMap;
-
-    // Run through the whole file and fill map of timestamps
-    while (!in.atEnd()) {
-        QStringList newLine = in.readLine().split(delimiter);
-        quint64 timestamp = newLine.at(0).toULongLong();
-
-        // Check if timestamp does exist - if not, add it
-        if (!timestampMap.contains(timestamp)) {
-            timestampMap.insert(timestamp, templateList);
+    infile.seek(0);
+
+    // Stream through the whole file. Lines are collected per timestamp in a bounded
+    // reorder window, the oldest timestamps are written in blocks as the window fills.
+    QElapsedTimer throughputTimer;
+    throughputTimer.start();
+    qint64 lastStatusMs = 0;
+    const qint64 inputSize = infile.size();
+    const int blockRows = qMax(s_ReorderRows, s_BlockCells / templateRow.size());
+    QByteArray remainder;
+    bool ok = true;
+    while (ok && !infile.atEnd()) {
+        QByteArray block = remainder + infile.read(s_ReadBlockSize);
+        int lineEnd = block.lastIndexOf('\n');
+        if (infile.atEnd()) {
+            lineEnd = block.size();
+        } else if (lineEnd < 0) {
+            // A line longer than the block, keep reading
+            remainder = block;
+            continue;
         }
+        remainder = block.mid(lineEnd + 1);
 
-        QStringList list = timestampMap.value(timestamp);
-
-        QString currentDataName = newLine.at(2);
-        QString currentDataValue = newLine.at(3);
-        list.replace(messageMap.value(currentDataName), currentDataValue);
-        timestampMap.insert(timestamp, list);
-    }
-
-    int lineCounter = 0;
-
-    QStringList lastList = timestampMap.values().at(1);
-
-    foreach (QStringList list, timestampMap.values()) {
-        // Write this current time set out to the file
-        // only do so from the 2nd line on, since the first
-        // line could be incomplete
-        if (lineCounter > 1) {
-            // Set the timestamp
-            list.replace(0,QString("%1").arg(timestampMap.keys().at(lineCounter)));
-
-            // Fill holes if necessary
-            if (holeFillingEnabled) {
-                int index = 0;
-                foreach (QString str, list) {
-                    if (str == "" || str == "NaN") {
-                        list.replace(index, lastList.at(index));
-                    }
-                    index++;
-                }
+        int lineStart = 0;
+        while (lineStart < lineEnd) {
+            int next = block.indexOf('\n', lineStart);
+            if (next < 0 || next > lineEnd) {
+                next = lineEnd;
             }
+            parseLine(block.constData() + lineStart, next - lineStart, fieldDelimiter);
+            lineStart = next + 1;
+            ++currentDataLine;
+        }
 
-            // Set last list
-            lastList = list;
+        if (pendingRows.size() >= s_ReorderRows + blockRows) {
+            ok = writeRows(outTmpFile, pendingRows.size() - s_ReorderRows);
+        }
 
-            // Write data columns
-            QString output = list.join(delimiter) + "\n";
-            outTmpFile.write(output.toLocal8Bit());
+        const qint64 elapsedMs = throughputTimer.elapsed();
+        if (elapsedMs - lastStatusMs >= s_StatusIntervalMs) {
+            lastStatusMs = elapsedMs;
+            const qint64 position = infile.pos();
+            emit logProcessingStatusChanged(tr("Log compressor: %1 of %2 MB processed (%3 MB/s)")
+                                            .arg(position / 1000000.0, 0, 'f', 1)
+                                            .arg(inputSize / 1000000.0, 0, 'f', 1)
+                                            .arg(position / 1000.0 / elapsedMs, 0, 'f', 1));
         }
-        lineCounter++;
     }
+    ok = ok && writeRows(outTmpFile, pendingRows.size()) && flushOutput(outTmpFile);
 
 	// We're now done with the source file
 	infile.close();
+    outTmpFile.close();
 
+    if (!ok) {
+        emit logProcessingStatusChanged(tr("Log Compressor: Writing output file %1 failed: %2").arg(QFileInfo(outFileName).absoluteFilePath()).arg(outTmpFile.errorString()));
+        currentDataLine = 0;
+        running = false;
+        return;
+    }
+    if (lateLines > 0) {
+        emit logProcessingStatusChanged(tr("Log compressor: %1 lines were too far out of order and are written unsorted").arg(lateLines));
+    }
+
+    const double seconds = qMax<qint64>(throughputTimer.elapsed(), 1) / 1000.0;
     emit logProcessingStatusChanged(tr("Log Compressor: Writing output to file %1").arg(QFileInfo(outFileName).absoluteFilePath()));
 
 	// Clean up and update the status before we return.
+    const int lines = currentDataLine;
 	currentDataLine = 0;
-    emit logProcessingStatusChanged(tr("Log compressor: Finished processing file: %1").arg(outFileName));
+    emit logProcessingStatusChanged(tr("Log compressor: Finished processing file: %1 (%2 lines in %3 s, %4 MB/s)")
+                                    .arg(outFileName).arg(lines).arg(seconds, 0, 'f', 1)
+                                    .arg(inputSize / 1000000.0 / seconds, 0, 'f', 1));
 	emit finishedFile(outFileName);
 	running = false;
 }
 
+void LogCompressor::parseLine(const char *line, int length, const QByteArray &fieldDelimiter)
+{
+    // Fields are: timestamp, component, name, value
+    if (length > 0 && line[length - 1] == '\r') {
+        --length;
+    }
+    const char separator = fieldDelimiter.at(0);
+    int fieldStart[4];
+    int fieldEnd[4];
+    int field = 0;
+    int start = 0;
+    for (int pos = 0; pos <= length && field < 4; ++pos) {
+        if (pos == length || line[pos] == separator) {
+            fieldStart[field] = start;
+            fieldEnd[field] = pos;
+            ++field;
+            start = pos + 1;
+        }
+    }
+    if (field < 4) {
+        return;
+    }
+
+    const QByteArray name = QByteArray::fromRawData(line + fieldStart[2], fieldEnd[2] - fieldStart[2]);
+    QHash<QByteArray, int>::const_iterator column = columnMap.constFind(name);
+    if (column == columnMap.constEnd()) {
+        // Only variables of the first lines are part of the output
+        return;
+    }
+    const quint64 timestamp = QByteArray::fromRawData(line + fieldStart[0], fieldEnd[0] - fieldStart[0]).toULongLong();
+    if (rowCounter > 0 && timestamp <= lastWrittenTimestamp) {
+        ++lateLines;
+    }
+
+    QMap<quint64, QVector<QByteArray> >::iterator row = pendingRows.find(timestamp);
+    if (row == pendingRows.end()) {
+        row = pendingRows.insert(timestamp, templateRow);
+    }
+    (*row)[column.value()] = QByteArray(line + fieldStart[3], fieldEnd[3] - fieldStart[3]);
+}
+
+bool LogCompressor::writeRows(QFile &outFile, int count)
+{
+    // Move the oldest rows into a column major block, so the columns can be
+    // hole filled independently.
+    const int columnCount = templateRow.size();
+    QVector<QByteArray> timestamps;
+    QVector<Column> columns(columnCount);
+    for (int column = 1; column < columnCount; ++column) {
+        columns[column].reserve(count);
+    }
+    timestamps.reserve(count);
+
+    for (int n = 0; n < count && !pendingRows.isEmpty(); ++n) {
+        QMap<quint64, QVector<QByteArray> >::iterator row = pendingRows.begin();
+        lastWrittenTimestamp = row.key();
+        // Only write from the 3rd line on, since the first lines could be incomplete.
+        // The 2nd line is the start for the hole filling.
+        if (rowCounter == 1) {
+            lastValues = row.value();
+        } else if (rowCounter > 1) {
+            timestamps.append(QByteArray::number(row.key()));
+            for (int column = 1; column < columnCount; ++column) {
+                columns[column].append(row.value().at(column));
+            }
+        }
+        ++rowCounter;
+        pendingRows.erase(row);
+    }
+
+    // Fill holes if necessary
+    if (holeFillingEnabled && !timestamps.isEmpty()) {
+        const int shardCount = qBound(1, (columnCount - 1) / s_MinColumnsPerShard, fillPool.maxThreadCount() + 1);
+        const int columnsPerShard = (columnCount - 1 + shardCount - 1) / shardCount;
+        QList<HoleFillTask*> tasks;
+        for (int first = 1; first < columnCount; first += columnsPerShard) {
+            tasks.append(new HoleFillTask(columns.data(), lastValues.data(), first, qMin(first + columnsPerShard, columnCount)));
+        }
+        // The last shard runs in this thread
+        for (int n = 0; n < tasks.size() - 1; ++n) {
+            fillPool.start(tasks.at(n));
+        }
+        tasks.last()->run();
+        fillPool.waitForDone();
+        qDeleteAll(tasks);
+    }
+
+    // Write data columns
+    const QByteArray fieldDelimiter = delimiter.toLocal8Bit();
+    for (int row = 0; row < timestamps.size(); ++row) {
+        outputBuffer.append(timestamps.at(row));
+        for (int column = 1; column < columnCount; ++column) {
+            outputBuffer.append(fieldDelimiter);
+            outputBuffer.append(columns.at(column).at(row));
+        }
+        outputBuffer.append('\n');
+        if (outputBuffer.size() >= s_WriteBufferSize && !flushOutput(outFile)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LogCompressor::flushOutput(QFile &outFile)
+{
+    const bool ok = outFile.write(outputBuffer) == outputBuffer.size();
+    outputBuffer.clear();
+    return ok;
+}
+
 /**
  * @param holeFilling If hole filling is enabled, the compressor tries to fill empty data fields with previous
  * values from the same variable (or NaN, if no previous value existed)
@@ -2,7 +2,21 @@
 #define LOGCOMPRESSOR_H
 
 #include <QThread>
+#include <QThreadPool>
+#include <QByteArray>
+#include <QHash>
+#include <QMap>
+#include <QVector>
 
+class QFile;
+
+/**
+ * @brief The LogCompressor class converts a line based log (timestamp, component, name, value)
+ *        into a CSV file with one row per timestamp. The input is streamed in blocks, so the
+ *        memory use does not depend on the size of the log. Timestamps are sorted within a
+ *        window of some thousand rows. The hole filling of a block is sharded by columns
+ *        on a thread pool.
+ */
 class LogCompressor : public QThread
 {
     Q_OBJECT
@@ -23,6 +37,24 @@ protected:
     QString delimiter;              ///< Delimiter between fields in the output file. Defaults to tab ('\t')
     bool holeFillingEnabled;        ///< Enables the filling of holes in the dataset with the previous value (or NaN if none exists)
 
+private:
+    /** @brief Parse one input line into the pending rows */
+    void parseLine(const char *line, int length, const QByteArray &fieldDelimiter);
+    /** @brief Hole fill and write the oldest pending rows */
+    bool writeRows(QFile &outFile, int count);
+    /** @brief Write the output buffer to the file */
+    bool flushOutput(QFile &outFile);
+
+    QHash<QByteArray, int> columnMap;                   ///< Output column of every variable name
+    QVector<QByteArray> templateRow;                    ///< Cells of a new row
+    QVector<QByteArray> lastValues;                     ///< Last value of every column for the hole filling
+    QMap<quint64, QVector<QByteArray> > pendingRows;    ///< Rows not written yet, sorted by timestamp
+    quint64 rowCounter;                                 ///< Number of rows taken from pendingRows
+    quint64 lastWrittenTimestamp;                       ///< Timestamp of the last row taken from pendingRows
+    quint64 lateLines;                                  ///< Lines which arrived after their row was written
+    QByteArray outputBuffer;                            ///< Output collected for a large write
+    QThreadPool fillPool;                               ///< Runs the hole filling shards
+
 signals:
     /** @brief This signal is emitted when there is a change in the status of the parsing algorithm. For instance if an error is encountered.
      * @param status A status message
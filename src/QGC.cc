@@ -24,37 +24,131 @@ This file is part of the QGROUNDCONTROL project
 #include "QGC.h"
 #include "configuration.h"
 
+#include <QElapsedTimer>
+#include <QAtomicInteger>
 #include <qmath.h>
 #include <float.h>
 
 namespace QGC
 {
 
+namespace
+{
+
+/**
+ * @brief The GroundTimebase class holds the monotonic clock and the offset
+ *        to the wall clock. QElapsedTimer uses the cheapest monotonic clock of
+ *        the platform (clock_gettime(CLOCK_MONOTONIC), QueryPerformanceCounter,
+ *        mach_absolute_time) which is much faster than building a QDateTime.
+ *        The offset is checked against the wall clock once per second. Steps
+ *        (suspend / resume, NTP steps) are taken over at once, small deviations
+ *        are slewed so the ground time stays monotonic.
+ */
+class GroundTimebase
+{
+public:
+    GroundTimebase() :
+        m_offsetUsecs(0),
+        m_nextCheckUsecs(s_CheckIntervalUsecs)
+    {
+        m_clock.start();
+        // The wall clock only has millisecond resolution (or worse). Wait for
+        // its next tick to get an offset which is accurate to some microseconds.
+        // The wait is limited as some platforms tick every 16ms.
+        const qint64 startMsecs = QDateTime::currentMSecsSinceEpoch();
+        qint64 tickMsecs = startMsecs;
+        qint64 tickUsecs = m_clock.nsecsElapsed() / 1000;
+        while ((tickMsecs == startMsecs) && (tickUsecs < s_MaxCalibrationUsecs))
+        {
+            tickMsecs = QDateTime::currentMSecsSinceEpoch();
+            tickUsecs = m_clock.nsecsElapsed() / 1000;
+        }
+        m_offsetUsecs.store(tickMsecs * 1000 - tickUsecs);
+        m_nextCheckUsecs.store(tickUsecs + s_CheckIntervalUsecs);
+    }
+
+    qint64 nsecs() const
+    {
+        return m_clock.nsecsElapsed();
+    }
+
+    quint64 usecsSinceEpoch()
+    {
+        const qint64 monotonicUsecs = m_clock.nsecsElapsed() / 1000;
+        const qint64 nextCheckUsecs = m_nextCheckUsecs.load();
+        // only one thread does the check
+        if ((monotonicUsecs >= nextCheckUsecs) &&
+            m_nextCheckUsecs.testAndSetOrdered(nextCheckUsecs, monotonicUsecs + s_CheckIntervalUsecs))
+        {
+            reanchor(monotonicUsecs);
+        }
+        return static_cast<quint64>(m_offsetUsecs.load() + monotonicUsecs);
+    }
+
+private:
+    static constexpr qint64 s_MaxCalibrationUsecs = 20000;
+    static constexpr qint64 s_CheckIntervalUsecs = 1000000;     ///< Interval of the wall clock check
+    static constexpr qint64 s_StepThresholdUsecs = 100000;      ///< Larger deviations are taken over at once
+    static constexpr qint64 s_SlewDeadbandUsecs = 2000;         ///< Smaller deviations are wall clock resolution noise
+    static constexpr qint64 s_MaxSlewUsecs = 500;               ///< Max correction per check (500 ppm)
+
+    /**
+     * @brief reanchor compares the offset with the wall clock and corrects it
+     * @param monotonicUsecs - the actual monotonic time
+     */
+    void reanchor(qint64 monotonicUsecs)
+    {
+        const qint64 offsetUsecs = m_offsetUsecs.load();
+        const qint64 deviationUsecs = QDateTime::currentMSecsSinceEpoch() * 1000 - monotonicUsecs - offsetUsecs;
+        if (qAbs(deviationUsecs) > s_StepThresholdUsecs)
+        {
+            // suspend / resume or the wall clock was set
+            m_offsetUsecs.store(offsetUsecs + deviationUsecs);
+        }
+        else if (qAbs(deviationUsecs) > s_SlewDeadbandUsecs)
+        {
+            const qint64 maxSlewUsecs = s_MaxSlewUsecs;
+            m_offsetUsecs.store(offsetUsecs + qBound(-maxSlewUsecs, deviationUsecs, maxSlewUsecs));
+        }
+    }
+
+    QElapsedTimer m_clock;                      ///< Monotonic clock
+    QAtomicInteger<qint64> m_offsetUsecs;       ///< Wall clock time in usecs when m_clock was started
+    QAtomicInteger<qint64> m_nextCheckUsecs;    ///< Monotonic time of the next wall clock check
+};
+
+GroundTimebase &timebase()
+{
+    // Initialization of a function local static is thread safe
+    static GroundTimebase s_timebase;
+    return s_timebase;
+}
+
+}
+
 quint64 groundTimeUsecs()
 {
-    QDateTime time = QDateTime::currentDateTime();
-    time = time.toUTC();
-    /* Return seconds and milliseconds, in milliseconds unit */
-    quint64 microseconds = time.toTime_t() * static_cast<quint64>(1000000);
-    return static_cast<quint64>(microseconds + (time.time().msec()*1000));
+    return timebase().usecsSinceEpoch();
 }
 
 quint64 groundTimeMilliseconds()
 {
-    QDateTime time = QDateTime::currentDateTime();
-    time = time.toUTC();
-    /* Return seconds and milliseconds, in milliseconds unit */
-    quint64 seconds = time.toTime_t() * static_cast<quint64>(1000);
-    return static_cast<quint64>(seconds + (time.time().msec()));
+    return timebase().usecsSinceEpoch() / 1000;
 }
 
 qreal groundTimeSeconds()
 {
-    QDateTime time = QDateTime::currentDateTime();
-    time = time.toUTC();
-    /* Return time in seconds unit */
-    quint64 seconds = time.toTime_t();
-    return static_cast<qreal>(seconds + (time.time().msec() / 1000.0));
+    return static_cast<qreal>(timebase().usecsSinceEpoch()) / 1000000.0;
+}
+
+qint64 monotonicTimeNsecs()
+{
+    return timebase().nsecs();
+}
+
+qint64 monotonicTimeUsecs()
+{
+    return timebase().nsecs() / 1000;
 }
 
 float limitAngleToPMPIf(float angle)
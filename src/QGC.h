@@ -74,12 +74,23 @@ const QColor colorDarkYellow(180, 180, 0);
 const QColor colorBackground("#050508");
 const QColor colorBlack(0, 0, 0);
 
-/** @brief Get the current ground time in microseconds */
+/**
+ * @brief The ground time is derived from a monotonic clock with a wall clock
+ *        (UTC) offset which is calibrated on first use and checked against the
+ *        wall clock once per second. It is therefore cheap to read and has true
+ *        microsecond resolution. Small drifts are slewed, so it does not jump back;
+ *        steps of the wall clock (suspend / resume, NTP) are taken over at once.
+ */
+/** @brief Get the current ground time in microseconds since epoch (UTC) */
 quint64 groundTimeUsecs();
-/** @brief Get the current ground time in milliseconds */
+/** @brief Get the current ground time in milliseconds since epoch (UTC) */
 quint64 groundTimeMilliseconds();
-/** @brief Get the current ground time in seconds */
+/** @brief Get the current ground time in seconds since epoch (UTC) */
 qreal groundTimeSeconds();
+/** @brief Get the monotonic time in nanoseconds. The reference point is arbitrary, use for intervals only */
+qint64 monotonicTimeNsecs();
+/** @brief Get the monotonic time in microseconds. The reference point is arbitrary, use for intervals only */
+qint64 monotonicTimeUsecs();
 /** @brief Returns the angle limited to -pi - pi */
 float limitAngleToPMPIf(float angle);
 /** @brief Returns the angle limited to -pi - pi */
@@ -0,0 +1,436 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file TerrainDatabase.cc
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the local terrain elevation database
+ */
+
+#include "TerrainDatabase.h"
+#include "logging.h"
+#include "globalobject.h"
+
+#include <QFile>
+#include <QDir>
+#include <QSettings>
+#include <QMutexLocker>
+#include <QtEndian>
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+
+const QString s_TerrainDirectoryKey("TERRAIN_DIRECTORY");
+
+constexpr double s_EarthRadius = 6371000.0;         ///< Mean earth radius in meters
+constexpr double s_MetersPerDegree = 111320.0;      ///< Meters per degree of latitude
+
+/**
+ * @brief tileKey returns the cache key of the tile holding a location
+ * @return - the key or -1 if the location is invalid
+ */
+int tileKey(double latitude, double longitude)
+{
+    if (!(latitude >= -90.0 && latitude <= 90.0) || !(longitude >= -180.0 && longitude <= 180.0))
+    {
+        return -1;
+    }
+    // The north pole and the date line are part of the tiles south and west of them
+    const int latIndex = qMin(static_cast<int>(std::floor(latitude)) + 90, 179);
+    const int lonIndex = qMin(static_cast<int>(std::floor(longitude)) + 180, 359);
+    return latIndex * 360 + lonIndex;
+}
+
+/**
+ * @brief tileName returns the SRTM file name of a tile (e.g. N47E008.hgt)
+ */
+QString tileName(int key)
+{
+    const int latitude = key / 360 - 90;
+    const int longitude = key % 360 - 180;
+    return QString("%1%2%3%4.hgt").arg(latitude < 0 ? 'S' : 'N')
+                                  .arg(qAbs(latitude), 2, 10, QChar('0'))
+                                  .arg(longitude < 0 ? 'W' : 'E')
+                                  .arg(qAbs(longitude), 3, 10, QChar('0'));
+}
+
+}
+
+TerrainDatabase::Sample::Sample() :
+    m_latitude(0.0),
+    m_longitude(0.0),
+    m_distance(0.0),
+    m_altitude(0.0),
+    m_elevation(0.0),
+    m_segment(0),
+    m_valid(false)
+{}
+
+TerrainDatabase::Clearance::Clearance() :
+    m_valid(false),
+    m_complete(false),
+    m_minClearance(std::numeric_limits<double>::max()),
+    m_distance(0.0),
+    m_segment(-1)
+{}
+
+TerrainDatabase* TerrainDatabase::instance()
+{
+    static TerrainDatabase s_instance;
+    return &s_instance;
+}
+
+TerrainDatabase::TerrainDatabase() :
+    m_useCounter(0)
+{
+    QSettings settings;
+    settings.beginGroup("GLOBAL_SETTINGS");
+    m_tileDirectory = settings.value(s_TerrainDirectoryKey,
+                                     GlobalObject::sharedInstance()->appDataDirectory() + "/terrain").toString();
+    settings.endGroup();
+    QLOG_DEBUG() << "Terrain tiles are read from" << m_tileDirectory;
+}
+
+TerrainDatabase::~TerrainDatabase()
+{
+    clearCache();
+}
+
+QString TerrainDatabase::tileDirectory() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_tileDirectory;
+}
+
+void TerrainDatabase::setTileDirectory(const QString &dir)
+{
+    QMutexLocker locker(&m_mutex);
+    if (dir == m_tileDirectory)
+    {
+        return;
+    }
+    QLOG_DEBUG() << "Set terrain dir to:" << dir;
+    clearCache();
+    m_tileDirectory = dir;
+
+    QSettings settings;
+    settings.beginGroup("GLOBAL_SETTINGS");
+    settings.setValue(s_TerrainDirectoryKey, m_tileDirectory);
+    settings.endGroup();
+}
+
+bool TerrainDatabase::elevation(double latitude, double longitude, double &elevation)
+{
+    QMutexLocker locker(&m_mutex);
+    Tile *lastTile = NULL;
+    int lastKey = -1;
+    return sample(latitude, longitude, lastTile, lastKey, elevation);
+}
+
+int TerrainDatabase::elevations(const QVector<double> &latitudes, const QVector<double> &longitudes,
+                                QVector<double> &elevations)
+{
+    const int count = qMin(latitudes.size(), longitudes.size());
+    elevations.resize(count);
+
+    QMutexLocker locker(&m_mutex);
+    Tile *lastTile = NULL;
+    int lastKey = -1;
+    int validCount = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        double value = 0.0;
+        if (sample(latitudes.at(i), longitudes.at(i), lastTile, lastKey, value))
+        {
+            ++validCount;
+        }
+        else
+        {
+            value = std::numeric_limits<double>::quiet_NaN();
+        }
+        elevations[i] = value;
+    }
+    return validCount;
+}
+
+QVector<TerrainDatabase::Sample> TerrainDatabase::samplePath(const QVector<double> &latitudes,
+                                                             const QVector<double> &longitudes,
+                                                             const QVector<double> &altitudes,
+                                                             double spacing, int maxSamples)
+{
+    QVector<Sample> samples;
+    const int vertexCount = qMin(latitudes.size(), longitudes.size());
+    if (vertexCount == 0)
+    {
+        return samples;
+    }
+    const bool hasAltitudes = altitudes.size() >= vertexCount;
+
+    QVector<double> segmentLengths(vertexCount - 1);
+    double totalDistance = 0.0;
+    for (int i = 0; i < vertexCount - 1; ++i)
+    {
+        segmentLengths[i] = distance(latitudes.at(i), longitudes.at(i), latitudes.at(i + 1), longitudes.at(i + 1));
+        totalDistance += segmentLengths.at(i);
+    }
+    // Every vertex is sampled, the spacing only applies to the points in between
+    const int spacingSamples = qMax(1, maxSamples - vertexCount);
+    spacing = qMax(spacing, totalDistance / spacingSamples);
+    if (!(spacing > 0.0))
+    {
+        spacing = 1.0;
+    }
+
+    // Build the whole path first so the tiles are accessed in one go
+    double distanceSoFar = 0.0;
+    for (int i = 0; i < vertexCount - 1; ++i)
+    {
+        const int steps = qMax(1, static_cast<int>(std::ceil(segmentLengths.at(i) / spacing)));
+        for (int step = 0; step < steps; ++step)
+        {
+            const double fraction = static_cast<double>(step) / steps;
+            Sample sample;
+            sample.m_latitude = latitudes.at(i) + fraction * (latitudes.at(i + 1) - latitudes.at(i));
+            sample.m_longitude = longitudes.at(i) + fraction * (longitudes.at(i + 1) - longitudes.at(i));
+            sample.m_distance = distanceSoFar + fraction * segmentLengths.at(i);
+            if (hasAltitudes)
+            {
+                sample.m_altitude = altitudes.at(i) + fraction * (altitudes.at(i + 1) - altitudes.at(i));
+            }
+            sample.m_segment = i;
+            samples.append(sample);
+        }
+        distanceSoFar += segmentLengths.at(i);
+    }
+    Sample last;
+    last.m_latitude = latitudes.at(vertexCount - 1);
+    last.m_longitude = longitudes.at(vertexCount - 1);
+    last.m_distance = distanceSoFar;
+    last.m_altitude = hasAltitudes ? altitudes.at(vertexCount - 1) : 0.0;
+    last.m_segment = qMax(0, vertexCount - 2);
+    samples.append(last);
+
+    QMutexLocker locker(&m_mutex);
+    Tile *lastTile = NULL;
+    int lastKey = -1;
+    for (int i = 0; i < samples.size(); ++i)
+    {
+        Sample &sample = samples[i];
+        sample.m_valid = this->sample(sample.m_latitude, sample.m_longitude, lastTile, lastKey, sample.m_elevation);
+    }
+    return samples;
+}
+
+TerrainDatabase::Clearance TerrainDatabase::clearance(const QVector<Sample> &samples)
+{
+    Clearance result;
+    result.m_complete = !samples.isEmpty();
+    foreach (const Sample &sample, samples)
+    {
+        if (!sample.m_valid)
+        {
+            result.m_complete = false;
+            continue;
+        }
+        result.m_valid = true;
+        const double clearance = sample.m_altitude - sample.m_elevation;
+        if (clearance < result.m_minClearance)
+        {
+            result.m_minClearance = clearance;
+            result.m_distance = sample.m_distance;
+            result.m_segment = sample.m_segment;
+        }
+    }
+    return result;
+}
+
+double TerrainDatabase::resolution(double latitude, double longitude)
+{
+    QMutexLocker locker(&m_mutex);
+    const int key = tileKey(latitude, longitude);
+    if (key < 0)
+    {
+        return 0.0;
+    }
+    const Tile *found = tile(key);
+    return found->m_data ? s_MetersPerDegree / (found->m_size - 1) : 0.0;
+}
+
+double TerrainDatabase::distance(double lat1, double lon1, double lat2, double lon2)
+{
+    const double dLat = (lat2 - lat1) * (M_PI / 180.0);
+    const double dLon = (lon2 - lon1) * (M_PI / 180.0);
+    const double a = sin(dLat / 2.0) * sin(dLat / 2.0)
+                   + cos(lat1 * (M_PI / 180.0)) * cos(lat2 * (M_PI / 180.0)) * sin(dLon / 2.0) * sin(dLon / 2.0);
+    return s_EarthRadius * 2.0 * atan2(sqrt(a), sqrt(1.0 - a));
+}
+
+bool TerrainDatabase::sample(double latitude, double longitude, Tile *&lastTile, int &lastKey, double &elevation)
+{
+    const int key = tileKey(latitude, longitude);
+    if (key < 0)
+    {
+        return false;
+    }
+    if (key != lastKey || lastTile == NULL)
+    {
+        lastTile = tile(key);
+        lastKey = key;
+    }
+    else
+    {
+        // Keep the tile in use the most recent one, so it is never evicted during a batch
+        lastTile->m_lastUse = ++m_useCounter;
+    }
+    if (lastTile->m_data == NULL)
+    {
+        return false;
+    }
+
+    const double south = static_cast<double>(key / 360 - 90);
+    const double west = static_cast<double>(key % 360 - 180);
+    const double last = static_cast<double>(lastTile->m_size - 1);
+    const double row = (south + 1.0 - latitude) * last;
+    const double column = (longitude - west) * last;
+    return sampleTile(lastTile, row, column, elevation);
+}
+
+TerrainDatabase::Tile *TerrainDatabase::tile(int key)
+{
+    QHash<int, Tile *>::const_iterator iter = m_tiles.constFind(key);
+    Tile *found = iter != m_tiles.constEnd() ? iter.value() : loadTile(key);
+    found->m_lastUse = ++m_useCounter;
+    return found;
+}
+
+TerrainDatabase::Tile *TerrainDatabase::loadTile(int key)
+{
+    if (m_tiles.size() >= s_MaxTiles)
+    {
+        // Evict the least recently used tile
+        QHash<int, Tile *>::iterator oldest = m_tiles.begin();
+        for (QHash<int, Tile *>::iterator iter = m_tiles.begin(); iter != m_tiles.end(); ++iter)
+        {
+            if (iter.value()->m_lastUse < oldest.value()->m_lastUse)
+            {
+                oldest = iter;
+            }
+        }
+        delete oldest.value()->m_file;  // unmaps the data as well
+        delete oldest.value();
+        m_tiles.erase(oldest);
+    }
+
+    Tile *newTile = new Tile;
+    newTile->m_file = NULL;
+    newTile->m_data = NULL;
+    newTile->m_size = 0;
+    newTile->m_lastUse = 0;
+    m_tiles.insert(key, newTile);
+
+    const QString name = tileName(key);
+    const QDir dir(m_tileDirectory);
+    QString path = dir.filePath(name);
+    if (!QFile::exists(path))
+    {
+        path = dir.filePath(name.toLower());
+        if (!QFile::exists(path))
+        {
+            return newTile;
+        }
+    }
+
+    QFile *file = new QFile(path);
+    const qint64 fileSize = file->size();
+    const int size = static_cast<int>(std::sqrt(static_cast<double>(fileSize / 2)) + 0.5);
+    if (size < 2 || static_cast<qint64>(size) * size * 2 != fileSize)
+    {
+        QLOG_ERROR() << "Terrain tile" << path << "has an unexpected size of" << fileSize << "bytes";
+        delete file;
+        return newTile;
+    }
+    const uchar *data = file->open(QIODevice::ReadOnly) ? file->map(0, fileSize) : NULL;
+    if (data == NULL)
+    {
+        QLOG_ERROR() << "Unable to map terrain tile" << path << ":" << file->errorString();
+        delete file;
+        return newTile;
+    }
+    QLOG_DEBUG() << "Mapped terrain tile" << path << size << "x" << size;
+    newTile->m_file = file;
+    newTile->m_data = data;
+    newTile->m_size = size;
+    return newTile;
+}
+
+void TerrainDatabase::clearCache()
+{
+    foreach (Tile *cached, m_tiles)
+    {
+        delete cached->m_file;
+        delete cached;
+    }
+    m_tiles.clear();
+}
+
+bool TerrainDatabase::sampleTile(const Tile *tile, double row, double column, double &elevation)
+{
+    const int last = tile->m_size - 1;
+    const int row0 = qBound(0, static_cast<int>(row), last - 1);
+    const int column0 = qBound(0, static_cast<int>(column), last - 1);
+    const double rowFraction = qBound(0.0, row - row0, 1.0);
+    const double columnFraction = qBound(0.0, column - column0, 1.0);
+
+    const uchar *data = tile->m_data + 2 * (row0 * tile->m_size + column0);
+    const qint16 heights[4] = {
+        qFromBigEndian<qint16>(data),
+        qFromBigEndian<qint16>(data + 2),
+        qFromBigEndian<qint16>(data + 2 * tile->m_size),
+        qFromBigEndian<qint16>(data + 2 * tile->m_size + 2)
+    };
+    const double weights[4] = {
+        (1.0 - rowFraction) * (1.0 - columnFraction),
+        (1.0 - rowFraction) * columnFraction,
+        rowFraction * (1.0 - columnFraction),
+        rowFraction * columnFraction
+    };
+
+    // Voids are left out and the weights of the remaining samples scaled up
+    double sum = 0.0;
+    double weightSum = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+        if (heights[i] != s_VoidValue)
+        {
+            sum += weights[i] * heights[i];
+            weightSum += weights[i];
+        }
+    }
+    if (weightSum <= 0.0)
+    {
+        return false;
+    }
+    elevation = sum / weightSum;
+    return true;
+}
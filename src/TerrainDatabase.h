@@ -0,0 +1,187 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file TerrainDatabase.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the local terrain elevation database
+ */
+
+#ifndef TERRAINDATABASE_H
+#define TERRAINDATABASE_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+
+class QFile;
+
+/**
+ * @brief The TerrainDatabase class samples terrain elevation from SRTM height
+ *        tiles (*.hgt) stored on disk, so terrain profiles and clearance checks
+ *        work without network access.
+ *        A tile covers 1x1 degree and is named after its south west corner
+ *        (e.g. N47E008.hgt). Tiles with 1201x1201 (3 arc seconds) and
+ *        3601x3601 (1 arc second) big endian samples are supported.
+ *        The tiles are memory mapped and kept in a small LRU cache, elevations
+ *        are interpolated bilinearly between the four surrounding samples.
+ *        All methods are thread safe.
+ */
+class TerrainDatabase
+{
+public:
+    /**
+     * @brief The Sample struct is one point of a terrain profile
+     */
+    struct Sample
+    {
+        double m_latitude;      ///< Latitude in degrees
+        double m_longitude;     ///< Longitude in degrees
+        double m_distance;      ///< Distance from the start of the path in meters
+        double m_altitude;      ///< Altitude of the path (AMSL) at this point, interpolated between the vertices
+        double m_elevation;     ///< Terrain elevation (AMSL) in meters. Only valid if m_valid is true
+        int m_segment;          ///< Index of the path segment the sample belongs to
+        bool m_valid;           ///< True if terrain data was available for this point
+
+        Sample();
+    };
+
+    /**
+     * @brief The Clearance struct holds the result of a terrain clearance check
+     */
+    struct Clearance
+    {
+        bool m_valid;           ///< True if at least one point of the path had terrain data
+        bool m_complete;        ///< True if all points of the path had terrain data
+        double m_minClearance;  ///< Lowest altitude above terrain along the path in meters
+        double m_distance;      ///< Distance from the start of the path where m_minClearance occurs
+        int m_segment;          ///< Index of the path segment where m_minClearance occurs
+
+        Clearance();
+    };
+
+    /**
+     * @brief instance returns the application wide terrain database
+     */
+    static TerrainDatabase* instance();
+
+    ~TerrainDatabase();
+
+    /**
+     * @brief tileDirectory returns the directory the tiles are read from
+     */
+    QString tileDirectory() const;
+
+    /**
+     * @brief setTileDirectory sets the directory the tiles are read from and
+     *        stores it in the settings. Drops all cached tiles.
+     * @param dir - the tile directory
+     */
+    void setTileDirectory(const QString &dir);
+
+    /**
+     * @brief elevation samples the terrain elevation of one location
+     * @param latitude - latitude in degrees
+     * @param longitude - longitude in degrees
+     * @param elevation - filled with the elevation AMSL in meters
+     * @return - true if terrain data was available
+     */
+    bool elevation(double latitude, double longitude, double &elevation);
+
+    /**
+     * @brief elevations samples the terrain elevation of many locations in one
+     *        call. Consecutive locations in the same tile are sampled without
+     *        a cache lookup.
+     * @param latitudes - latitudes in degrees
+     * @param longitudes - longitudes in degrees. Must have the same size as latitudes.
+     * @param elevations - resized and filled with the elevations. Locations
+     *                     without terrain data are set to NaN.
+     * @return - the number of locations with terrain data
+     */
+    int elevations(const QVector<double> &latitudes, const QVector<double> &longitudes,
+                   QVector<double> &elevations);
+
+    /**
+     * @brief samplePath samples the terrain along a path. Every segment is
+     *        split into samples of equal spacing, the vertices are always sampled.
+     * @param latitudes - latitudes of the path vertices in degrees
+     * @param longitudes - longitudes of the path vertices in degrees
+     * @param altitudes - altitudes (AMSL) of the path vertices in meters. Can be
+     *                    empty if only the terrain is of interest.
+     * @param spacing - maximum distance between two samples in meters
+     * @param maxSamples - upper limit of samples. The spacing is increased if needed.
+     * @return - the samples ordered along the path
+     */
+    QVector<Sample> samplePath(const QVector<double> &latitudes, const QVector<double> &longitudes,
+                               const QVector<double> &altitudes, double spacing, int maxSamples = 100000);
+
+    /**
+     * @brief clearance calculates the lowest altitude above terrain along a path
+     * @param samples - samples as returned by samplePath() including altitudes
+     * @return - the clearance
+     */
+    static Clearance clearance(const QVector<Sample> &samples);
+
+    /**
+     * @brief resolution returns the sample spacing of the tile holding a
+     *        location in meters (about 30m or 90m)
+     * @return - the resolution or 0.0 if there is no tile for this location
+     */
+    double resolution(double latitude, double longitude);
+
+    /**
+     * @brief distance returns the great circle distance between two locations in meters
+     */
+    static double distance(double lat1, double lon1, double lat2, double lon2);
+
+private:
+    /**
+     * @brief The Tile struct is one memory mapped tile. Tiles which do not exist
+     *        on disk are cached too (m_data is NULL) to avoid polling the disk.
+     */
+    struct Tile
+    {
+        QFile *m_file;          ///< The mapped file
+        const uchar *m_data;    ///< Big endian samples, row 0 is the north edge
+        int m_size;             ///< Samples per row and column
+        quint64 m_lastUse;      ///< Value of m_useCounter at the last access (LRU)
+    };
+
+    TerrainDatabase();
+
+    bool sample(double latitude, double longitude, Tile *&lastTile, int &lastKey, double &elevation);
+    Tile *tile(int key);
+    Tile *loadTile(int key);
+    void clearCache();
+    static bool sampleTile(const Tile *tile, double row, double column, double &elevation);
+
+private:
+    static constexpr int s_MaxTiles = 16;           ///< Tiles held in the cache
+    static constexpr qint16 s_VoidValue = -32768;   ///< SRTM marker of a sample without data
+
+    mutable QMutex m_mutex;     ///< Guards all members
+    QString m_tileDirectory;    ///< Directory the tiles are read from
+    QHash<int, Tile *> m_tiles; ///< Cached tiles by (latitude + 90) * 360 + longitude + 180 of the south west corner
+    quint64 m_useCounter;       ///< Incremented with every tile access
+};
+
+#endif // TERRAINDATABASE_H
@@ -45,3 +45,9 @@ LinkInterface::~LinkInterface()
 {
     emit this->deleteLink(this);
 }
+
+void LinkInterface::emitBytesReceived(const QByteArray &data, quint64 ingressTimeUsecs)
+{
+    emit bytesReceived(this, data);
+    emit bytesReceivedAt(this, data, ingressTimeUsecs);
+}
@@ -190,6 +190,17 @@ signals:
      */
     void bytesReceived(LinkInterface* link, QByteArray data);
 
+    /**
+     * @brief New data arrived, same as bytesReceived but carries the ground time
+     *        (see QGC::groundTimeUsecs()) the data was read from the link. Use this
+     *        one if the time of arrival matters, as queued connections may deliver
+     *        the data much later.
+     *
+     * @param data the new bytes
+     * @param ingressTimeUsecs ground time in microseconds the data was read
+     */
+    void bytesReceivedAt(LinkInterface* link, QByteArray data, quint64 ingressTimeUsecs);
+
     /**
      * @brief This signal is emitted instantly when the link is connected
      **/
@@ -342,6 +353,15 @@ protected:
         return dataRate;
     }
 
+    /**
+     * @brief emitBytesReceived emits bytesReceived and bytesReceivedAt. Links should
+     *        take the ingress time right when reading the data from the device.
+     *
+     * @param data The data read from the link
+     * @param ingressTimeUsecs The ground time in microseconds the data was read
+     */
+    void emitBytesReceived(const QByteArray &data, quint64 ingressTimeUsecs);
+
     static int getNextLinkId() {
         static int nextId = 1;
         return nextId++;
@@ -45,7 +45,6 @@ This file is part of the APM_PLANNER project
 #include <QtSerialPort/qserialportinfo.h>
 #include <QTimer>
 
-
 LinkManager* LinkManager::instance()
 {
     static LinkManager _instance;
@@ -59,6 +58,10 @@ LinkManager::LinkManager(QObject *parent) :
     m_mavlinkDecoder.reset(new MAVLinkDecoder(this));
     m_mavlinkProtocol.reset(new MAVLinkProtocol());
     m_mavlinkProtocol->setConnectionManager(this);
+    m_mavlinkRouter.reset(new MAVLinkRouter(this));
+    m_mavlinkProtocol->setRouter(m_mavlinkRouter.data());
+    m_commandDispatcher.reset(new MAVLinkCommandDispatcher(this));
+    m_mavlinkProtocol->setCommandDispatcher(m_commandDispatcher.data());
     connect(m_mavlinkProtocol.data(),SIGNAL(messageReceived(LinkInterface*,mavlink_message_t)),m_mavlinkDecoder.data(),SLOT(receiveMessage(LinkInterface*,mavlink_message_t)));
     connect(m_mavlinkProtocol.data(),SIGNAL(messageReceived(LinkInterface*,mavlink_message_t)),this,SLOT(receiveMessage(LinkInterface*,mavlink_message_t)));
     connect(m_mavlinkProtocol.data(),SIGNAL(protocolStatusMessage(QString,QString)),this,SLOT(protocolStatusMessageRec(QString,QString)));
@@ -114,6 +117,7 @@ void LinkManager::shutdown()
     saveSettings();
     m_mavlinkDecoder.reset();
     m_mavlinkProtocol.reset();
+    m_mavlinkRouter.reset();
 }
 
 void LinkManager::loadSettings()
@@ -121,9 +125,11 @@ void LinkManager::loadSettings()
     QSettings settings;
     settings.beginGroup("LINKMANAGER");
     m_mavlinkLoggingEnabled = settings.value("LOGGING",true).toBool();
+    QList<int> loadedLinkIds;   // Link ids in order of the settings array, used by the routes
     int linkssize = settings.beginReadArray("LINKS");
     for (int i=0;i<linkssize;i++)
     {
+        int linkid = -1;
         settings.setArrayIndex(i);
         QString type = settings.value("type").toString();
         if (type == "SERIAL_LINK")
@@ -136,12 +142,12 @@ void LinkManager::loadSettings()
                 baud = 115200;
             }
 
-            LinkManagerFactory::addSerialConnection(port,baud);
+            linkid = LinkManagerFactory::addSerialConnection(port,baud);
         }
         else if (type == "UDP_LINK")
         {
             int port = settings.value("port").toInt();
-            int linkid = LinkManagerFactory::addUdpConnection(QHostAddress::Any,port);
+            linkid = LinkManagerFactory::addUdpConnection(QHostAddress::Any,port);
             UDPLink *iface = qobject_cast<UDPLink*>(getLink(linkid));
 
             int hostcount = settings.beginReadArray("HOSTS");
@@ -160,16 +166,30 @@ void LinkManager::loadSettings()
             QString hostName = settings.value("hostname").toString();
             int port = settings.value("port").toInt();
             bool asServer = settings.value("asServer").toBool();
-            LinkManagerFactory::addTcpConnection(hostAddress, hostName, port, asServer);
+            linkid = LinkManagerFactory::addTcpConnection(hostAddress, hostName, port, asServer);
         }
         else if (type == "UDP_CLIENT_LINK")
         {
             QString host = settings.value("host").toString();
             int port = settings.value("port").toInt();
-            LinkManagerFactory::addUdpClientConnection(QHostAddress(host),port);
+            linkid = LinkManagerFactory::addUdpClientConnection(QHostAddress(host),port);
         }
+        loadedLinkIds.append(linkid);
     }
     settings.endArray(); // HOSTS
+    int routessize = settings.beginReadArray("ROUTES");
+    for (int i=0;i<routessize;i++)
+    {
+        settings.setArrayIndex(i);
+        MAVLinkRouter::Route route(loadedLinkIds.value(settings.value("source",-1).toInt(), -1),
+                                   loadedLinkIds.value(settings.value("target",-1).toInt(), -1));
+        route.m_sysIds = MAVLinkRouter::idSetFromString(settings.value("sysids").toString());
+        route.m_compIds = MAVLinkRouter::idSetFromString(settings.value("compids").toString());
+        route.m_msgIds = MAVLinkRouter::idSetFromString(settings.value("msgids").toString());
+        route.m_blockedMsgIds = MAVLinkRouter::idSetFromString(settings.value("blockedmsgids").toString());
+        m_mavlinkRouter->addRoute(route);
+    }
+    settings.endArray(); // ROUTES
     int portsize = settings.beginReadArray("PORTBAUDPAIRS");
     for (int i=0;i<portsize;i++)
     {
@@ -189,8 +209,10 @@ void LinkManager::saveSettings()
     settings.setValue("LOGGING",m_mavlinkLoggingEnabled);
     settings.beginWriteArray("LINKS");
     int index = 0;
+    QMap<int,int> linkIndexMap; // Link id to index in the settings array, used by the routes
     for (QMap<int,LinkInterface*>::const_iterator i= m_connectionMap.constBegin();i!=m_connectionMap.constEnd();i++)
     {
+        linkIndexMap.insert(i.key(), index);
         settings.setArrayIndex(index++);
         settings.setValue("linkid",i.value()->getId());
         if (i.value()->getLinkType() == LinkInterface::SERIAL_LINK)
@@ -243,6 +265,24 @@ void LinkManager::saveSettings()
         }
     }
     settings.endArray(); // LINKS
+    settings.beginWriteArray("ROUTES");
+    index = 0;
+    foreach (int routeId, m_mavlinkRouter->getRouteIds())
+    {
+        const MAVLinkRouter::Route route = m_mavlinkRouter->getRoute(routeId);
+        if (!linkIndexMap.contains(route.m_sourceLinkId) || !linkIndexMap.contains(route.m_targetLinkId))
+        {
+            continue;
+        }
+        settings.setArrayIndex(index++);
+        settings.setValue("source",linkIndexMap.value(route.m_sourceLinkId));
+        settings.setValue("target",linkIndexMap.value(route.m_targetLinkId));
+        settings.setValue("sysids",MAVLinkRouter::idSetToString(route.m_sysIds));
+        settings.setValue("compids",MAVLinkRouter::idSetToString(route.m_compIds));
+        settings.setValue("msgids",MAVLinkRouter::idSetToString(route.m_msgIds));
+        settings.setValue("blockedmsgids",MAVLinkRouter::idSetToString(route.m_blockedMsgIds));
+    }
+    settings.endArray(); // ROUTES
     settings.beginWriteArray("PORTBAUDPAIRS");
     index = 0;
     for (QMap<QString,int>::const_iterator i=m_portToBaudMap.constBegin();i!=m_portToBaudMap.constEnd();i++)
@@ -312,6 +352,42 @@ MAVLinkProtocol* LinkManager::getProtocol() const
     return m_mavlinkProtocol.data();
 }
 
+MAVLinkRouter* LinkManager::getRouter() const
+{
+    return m_mavlinkRouter.data();
+}
+
+int LinkManager::addRoute(const MAVLinkRouter::Route &route)
+{
+    const int routeId = m_mavlinkRouter->addRoute(route);
+    if (routeId >= 0)
+    {
+        saveSettings();
+    }
+    return routeId;
+}
+
+bool LinkManager::updateRoute(int routeId, const MAVLinkRouter::Route &route)
+{
+    if (!m_mavlinkRouter->updateRoute(routeId, route))
+    {
+        return false;
+    }
+    saveSettings();
+    return true;
+}
+
+void LinkManager::removeRoute(int routeId)
+{
+    m_mavlinkRouter->removeRoute(routeId);
+    saveSettings();
+}
+
+MAVLinkCommandDispatcher* LinkManager::getCommandDispatcher() const
+{
+    return m_commandDispatcher.data();
+}
+
 LinkInterface::LinkType LinkManager::getLinkType(int linkid)
 {
     if (!m_connectionMap.contains(linkid))
@@ -349,6 +425,7 @@ void LinkManager::removeLink(int linkId)
         {
             m_connectionMap.value(linkId)->disconnect();
         }
+        m_mavlinkRouter->removeRoutesOfLink(linkId);
         delete m_connectionMap.value(linkId);
         m_connectionMap.remove(linkId);
         saveSettings();
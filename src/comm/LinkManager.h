@@ -45,6 +45,8 @@ This file is part of the APM_PLANNER project
  */
 #include "MAVLinkDecoder.h"
 #include "MAVLinkProtocol.h"
+#include "MAVLinkRouter.h"
+#include "MAVLinkCommandDispatcher.h"
 #include <QMap>
 #include <QStringList>
 
@@ -67,6 +69,14 @@ public:
     void enableAllTimeouts();
 
     MAVLinkProtocol* getProtocol() const;
+    MAVLinkRouter* getRouter() const;
+    MAVLinkCommandDispatcher* getCommandDispatcher() const;
+
+    // Route changes through the LinkManager are stored with the link settings
+    int addRoute(const MAVLinkRouter::Route &route);
+    bool updateRoute(int routeId, const MAVLinkRouter::Route &route);
+    void removeRoute(int routeId);
+
     bool connectLink(int index);
     void disconnectLink(int index);
 
@@ -137,6 +147,8 @@ private:
     QMap<QString,int> m_portToBaudMap;
     QScopedPointer<MAVLinkDecoder, QScopedPointerDeleteLater> m_mavlinkDecoder;
     QScopedPointer<MAVLinkProtocol, QScopedPointerDeleteLater> m_mavlinkProtocol;
+    QScopedPointer<MAVLinkRouter> m_mavlinkRouter;
+    QScopedPointer<MAVLinkCommandDispatcher> m_commandDispatcher;
     QString m_logSubDir;
     bool m_mavlinkLoggingEnabled;
 };
@@ -7,7 +7,7 @@
 
 void LinkManagerFactory::connectLinkSignals(LinkInterface *link, LinkManager *lmgr)
 {
-    connect(link,SIGNAL(bytesReceived(LinkInterface*,QByteArray)),lmgr->getProtocol(),SLOT(receiveBytes(LinkInterface*,QByteArray)));
+    connect(link,SIGNAL(bytesReceivedAt(LinkInterface*,QByteArray,quint64)),lmgr->getProtocol(),SLOT(receiveBytesAt(LinkInterface*,QByteArray,quint64)));
     connect(link,SIGNAL(connected(LinkInterface*)),lmgr,SLOT(linkConnected(LinkInterface*)));
     connect(link,SIGNAL(disconnected(LinkInterface*)),lmgr,SLOT(linkDisonnected(LinkInterface*)));
     connect(link,SIGNAL(error(LinkInterface*,QString)),lmgr,SLOT(linkErrorRec(LinkInterface*,QString)));
@@ -0,0 +1,436 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file MAVLinkCommandDispatcher.cc
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the dispatcher which sends a command to
+ *        a group of vehicles at the same time
+ */
+
+#include "MAVLinkCommandDispatcher.h"
+#include "LinkManager.h"
+#include "LinkInterface.h"
+#include "UASInterface.h"
+#include "QGC.h"
+#include "configuration.h"
+#include "logging.h"
+
+#include <QPair>
+
+#include <cmath>
+#include <limits>
+
+MAVLinkCommandDispatcher::VehicleStatus::VehicleStatus() :
+    m_systemId(0),
+    m_result(s_ResultPending),
+    m_attempts(0),
+    m_firstSendUsecs(0),
+    m_lastSendUsecs(0),
+    m_ackUsecs(0),
+    m_latencyUsecs(-1)
+{}
+
+MAVLinkCommandDispatcher::GroupStatus::GroupStatus() :
+    m_command(0),
+    m_dispatchSkewUsecs(0),
+    m_encodeUsecs(0),
+    m_finished(false)
+{}
+
+MAVLinkCommandDispatcher::MAVLinkCommandDispatcher(LinkManager *linkManager, QObject *parent) :
+    QObject(parent),
+    m_linkManager(linkManager),
+    m_nextGroupId(0)
+{
+    m_retryTimer.setSingleShot(true);
+    connect(&m_retryTimer, SIGNAL(timeout()), this, SLOT(retryTimeout()));
+}
+
+int MAVLinkCommandDispatcher::sendCommand(const QList<mavlink_command_long_t> &commands)
+{
+    if (commands.isEmpty())
+    {
+        return -1;
+    }
+
+    Group group;
+    group.m_status.m_command = commands.first().command;
+    foreach (const mavlink_command_long_t &command, commands)
+    {
+        if (command.command != group.m_status.m_command)
+        {
+            QLOG_WARN() << "MAVLinkCommandDispatcher: mixed commands in one group" << command.command << group.m_status.m_command;
+            return -1;
+        }
+        VehicleStatus vehicle;
+        vehicle.m_systemId = command.target_system;
+        group.m_status.m_vehicles.append(vehicle);
+        group.m_commands.append(command);
+    }
+    return start(group);
+}
+
+int MAVLinkCommandDispatcher::sendCommand(const QList<mavlink_command_int_t> &commands)
+{
+    if (commands.isEmpty())
+    {
+        return -1;
+    }
+
+    Group group;
+    group.m_status.m_command = commands.first().command;
+    foreach (const mavlink_command_int_t &command, commands)
+    {
+        if (command.command != group.m_status.m_command)
+        {
+            QLOG_WARN() << "MAVLinkCommandDispatcher: mixed commands in one group" << command.command << group.m_status.m_command;
+            return -1;
+        }
+        VehicleStatus vehicle;
+        vehicle.m_systemId = command.target_system;
+        group.m_status.m_vehicles.append(vehicle);
+        group.m_intCommands.append(command);
+    }
+    return start(group);
+}
+
+int MAVLinkCommandDispatcher::start(Group &group)
+{
+    QList<int> indices;
+    for (int i = 0; i < group.m_status.m_vehicles.size(); ++i)
+    {
+        indices.append(i);
+    }
+
+    if (dispatch(group, indices) == 0)
+    {
+        QLOG_WARN() << "MAVLinkCommandDispatcher: no vehicle of the group is reachable";
+        return -1;
+    }
+
+    // Skew of the first attempt between the vehicles which were written
+    quint64 first = std::numeric_limits<quint64>::max();
+    quint64 last = 0;
+    foreach (const VehicleStatus &vehicle, group.m_status.m_vehicles)
+    {
+        if (vehicle.m_firstSendUsecs != 0)
+        {
+            first = qMin(first, vehicle.m_firstSendUsecs);
+            last = qMax(last, vehicle.m_firstSendUsecs);
+        }
+    }
+    group.m_status.m_dispatchSkewUsecs = static_cast<qint64>(last - first);
+    group.m_deadlineUsecs = QGC::groundTimeUsecs() + static_cast<quint64>(s_AckTimeoutMs) * 1000;
+
+    // Forget the oldest finished groups. Not done in finish() as it is called while iterating.
+    while (m_finishedGroups.size() > s_MaxFinishedGroups)
+    {
+        m_groups.remove(m_finishedGroups.takeFirst());
+    }
+
+    const int groupId = m_nextGroupId++;
+    QLOG_INFO() << "MAVLinkCommandDispatcher: group" << groupId << "command" << group.m_status.m_command
+                << "to" << group.m_status.m_vehicles.size() << "vehicles, skew"
+                << group.m_status.m_dispatchSkewUsecs << "us, encoding" << group.m_status.m_encodeUsecs << "us";
+    m_groups.insert(groupId, group);
+    if (!m_retryTimer.isActive())
+    {
+        m_retryTimer.start(s_AckTimeoutMs);
+    }
+    return groupId;
+}
+
+int MAVLinkCommandDispatcher::sendCommand(const QList<int> &systemIds, MAV_CMD command,
+                                          float param1, float param2, float param3, float param4,
+                                          float param5, float param6, float param7, int component)
+{
+    QList<mavlink_command_long_t> commands;
+    foreach (int systemId, systemIds)
+    {
+        mavlink_command_long_t cmd;
+        cmd.command = static_cast<uint16_t>(command);
+        cmd.confirmation = 0;
+        cmd.param1 = param1;
+        cmd.param2 = param2;
+        cmd.param3 = param3;
+        cmd.param4 = param4;
+        cmd.param5 = param5;
+        cmd.param6 = param6;
+        cmd.param7 = param7;
+        cmd.target_system = static_cast<uint8_t>(systemId);
+        cmd.target_component = static_cast<uint8_t>(component);
+        commands.append(cmd);
+    }
+    return sendCommand(commands);
+}
+
+int MAVLinkCommandDispatcher::setMode(const QList<int> &systemIds, uint32_t customMode)
+{
+    return sendCommand(systemIds, MAV_CMD_DO_SET_MODE, MAV_MODE_FLAG_CUSTOM_MODE_ENABLED, static_cast<float>(customMode));
+}
+
+int MAVLinkCommandDispatcher::setArmed(const QList<int> &systemIds, bool armed)
+{
+    return sendCommand(systemIds, MAV_CMD_COMPONENT_ARM_DISARM, armed ? 1.0f : 0.0f);
+}
+
+int MAVLinkCommandDispatcher::reposition(const QMap<int, GlobalPosition> &positions)
+{
+    QList<mavlink_command_int_t> commands;
+    for (QMap<int, GlobalPosition>::const_iterator iter = positions.constBegin(); iter != positions.constEnd(); ++iter)
+    {
+        mavlink_command_int_t cmd;
+        cmd.command = MAV_CMD_DO_REPOSITION;
+        cmd.frame = MAV_FRAME_GLOBAL;
+        cmd.current = 0;
+        cmd.autocontinue = 0;
+        cmd.param1 = -1.0f;         // default ground speed
+        cmd.param2 = MAV_DO_REPOSITION_FLAGS_CHANGE_MODE;
+        cmd.param3 = 0.0f;
+        cmd.param4 = NAN;           // keep the yaw behaviour
+        cmd.x = static_cast<int32_t>(std::lround(iter.value().m_latitude * 1e7));
+        cmd.y = static_cast<int32_t>(std::lround(iter.value().m_longitude * 1e7));
+        cmd.z = static_cast<float>(iter.value().m_altitude);
+        cmd.target_system = static_cast<uint8_t>(iter.key());
+        cmd.target_component = 0;
+        commands.append(cmd);
+    }
+    return sendCommand(commands);
+}
+
+MAVLinkCommandDispatcher::GroupStatus MAVLinkCommandDispatcher::getStatus(int groupId) const
+{
+    return m_groups.value(groupId).m_status;
+}
+
+void MAVLinkCommandDispatcher::removeGroup(int groupId)
+{
+    m_groups.remove(groupId);
+    m_finishedGroups.removeAll(groupId);
+}
+
+void MAVLinkCommandDispatcher::handleMessage(LinkInterface *link, const mavlink_message_t &message, quint64 ingressTimeUsecs)
+{
+    Q_UNUSED(link);
+    if (message.msgid != MAVLINK_MSG_ID_COMMAND_ACK || m_groups.isEmpty())
+    {
+        return;
+    }
+    mavlink_command_ack_t ack;
+    mavlink_msg_command_ack_decode(&message, &ack);
+
+    // The target is a MAVLink 2 extension and 0 when not set. An acknowledge for
+    // another ground station must not complete our command.
+    if ((ack.target_system != 0 && ack.target_system != QGC::MavlinkID())
+            || (ack.target_component != 0 && ack.target_component != QGC::defaultComponentId))
+    {
+        return;
+    }
+
+    // The acknowledge belongs to the newest unfinished group of this command
+    for (QMap<int, Group>::iterator iter = m_groups.end(); iter != m_groups.begin();)
+    {
+        --iter;
+        Group &group = iter.value();
+        if (group.m_status.m_finished || group.m_status.m_command != ack.command)
+        {
+            continue;
+        }
+        for (int i = 0; i < group.m_status.m_vehicles.size(); ++i)
+        {
+            VehicleStatus &vehicle = group.m_status.m_vehicles[i];
+            if (vehicle.m_systemId != message.sysid || vehicle.m_result != s_ResultPending || vehicle.m_attempts == 0)
+            {
+                continue;
+            }
+            vehicle.m_result = ack.result;
+            vehicle.m_ackUsecs = ingressTimeUsecs;
+            vehicle.m_latencyUsecs = static_cast<qint64>(ingressTimeUsecs - vehicle.m_lastSendUsecs);
+            emit vehicleAcknowledged(iter.key(), vehicle.m_systemId, vehicle.m_result, vehicle.m_latencyUsecs);
+
+            bool pending = false;
+            foreach (const VehicleStatus &other, group.m_status.m_vehicles)
+            {
+                pending |= other.m_result == s_ResultPending;
+            }
+            if (!pending)
+            {
+                finish(iter.key(), group);
+            }
+            return;
+        }
+    }
+}
+
+void MAVLinkCommandDispatcher::retryTimeout()
+{
+    const quint64 now = QGC::groundTimeUsecs();
+    quint64 nextDeadline = std::numeric_limits<quint64>::max();
+    for (QMap<int, Group>::iterator iter = m_groups.begin(); iter != m_groups.end(); ++iter)
+    {
+        Group &group = iter.value();
+        if (group.m_status.m_finished)
+        {
+            continue;
+        }
+        if (now >= group.m_deadlineUsecs)
+        {
+            // Only the vehicles which did not acknowledge are sent again
+            QList<int> indices;
+            for (int i = 0; i < group.m_status.m_vehicles.size(); ++i)
+            {
+                VehicleStatus &vehicle = group.m_status.m_vehicles[i];
+                if (vehicle.m_result != s_ResultPending)
+                {
+                    continue;
+                }
+                if (vehicle.m_attempts >= s_MaxAttempts)
+                {
+                    vehicle.m_result = s_ResultNoAck;
+                    continue;
+                }
+                indices.append(i);
+            }
+            if (indices.isEmpty() || dispatch(group, indices) == 0)
+            {
+                for (int i = 0; i < group.m_status.m_vehicles.size(); ++i)
+                {
+                    VehicleStatus &vehicle = group.m_status.m_vehicles[i];
+                    if (vehicle.m_result == s_ResultPending)
+                    {
+                        vehicle.m_result = s_ResultNoAck;
+                    }
+                }
+                finish(iter.key(), group);
+                continue;
+            }
+            QLOG_DEBUG() << "MAVLinkCommandDispatcher: group" << iter.key() << "sent again to" << indices.size() << "vehicles";
+            group.m_deadlineUsecs = QGC::groundTimeUsecs() + static_cast<quint64>(s_AckTimeoutMs) * 1000;
+        }
+        nextDeadline = qMin(nextDeadline, group.m_deadlineUsecs);
+    }
+
+    if (nextDeadline != std::numeric_limits<quint64>::max())
+    {
+        const quint64 delay = nextDeadline > now ? (nextDeadline - now + 999) / 1000 : 0;
+        m_retryTimer.start(static_cast<int>(qMin(delay, static_cast<quint64>(s_AckTimeoutMs))));
+    }
+}
+
+int MAVLinkCommandDispatcher::dispatch(Group &group, const QList<int> &indices)
+{
+    // Encode everything before the first write. One burst per link, in the order
+    // the links are first needed.
+    QList<QPair<LinkInterface *, QByteArray> > bursts;
+    QList<QList<int> > burstVehicles;
+    const qint64 encodeStart = QGC::monotonicTimeNsecs();
+    foreach (int index, indices)
+    {
+        VehicleStatus &vehicle = group.m_status.m_vehicles[index];
+        UASInterface *uas = m_linkManager->getUas(vehicle.m_systemId);
+        if (!uas)
+        {
+            continue;
+        }
+
+        mavlink_message_t message;
+        if (group.m_intCommands.isEmpty())
+        {
+            mavlink_command_long_t command = group.m_commands.at(index);
+            command.confirmation = static_cast<uint8_t>(vehicle.m_attempts);
+            mavlink_msg_command_long_encode(static_cast<uint8_t>(uas->getSystemId()), static_cast<uint8_t>(uas->getComponentId()),
+                                            &message, &command);
+        }
+        else
+        {
+            // COMMAND_INT has no confirmation field, the attempts are sent unchanged
+            mavlink_msg_command_int_encode(static_cast<uint8_t>(uas->getSystemId()), static_cast<uint8_t>(uas->getComponentId()),
+                                           &message, &group.m_intCommands.at(index));
+        }
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        const int length = mavlink_msg_to_send_buffer(buffer, &message);
+
+        foreach (LinkInterface *link, *uas->getLinks())
+        {
+            if (!link || !link->isConnected())
+            {
+                continue;
+            }
+            int burst = 0;
+            while (burst < bursts.size() && bursts.at(burst).first != link)
+            {
+                ++burst;
+            }
+            if (burst == bursts.size())
+            {
+                bursts.append(qMakePair(link, QByteArray()));
+                burstVehicles.append(QList<int>());
+            }
+            bursts[burst].second.append(reinterpret_cast<const char *>(buffer), length);
+            burstVehicles[burst].append(index);
+        }
+    }
+    group.m_status.m_encodeUsecs = (QGC::monotonicTimeNsecs() - encodeStart) / 1000;
+
+    // Nothing else happens between the writes
+    QList<quint64> writeUsecs;
+    for (int i = 0; i < bursts.size(); ++i)
+    {
+        bursts.at(i).first->writeBytes(bursts.at(i).second.constData(), bursts.at(i).second.size());
+        writeUsecs.append(QGC::groundTimeUsecs());
+    }
+
+    int sent = 0;
+    foreach (int index, indices)
+    {
+        VehicleStatus &vehicle = group.m_status.m_vehicles[index];
+        quint64 sendUsecs = 0;
+        for (int i = 0; i < bursts.size(); ++i)
+        {
+            if (burstVehicles.at(i).contains(index))
+            {
+                // A vehicle on several links counts from its first write
+                sendUsecs = writeUsecs.at(i);
+                break;
+            }
+        }
+        if (sendUsecs == 0)
+        {
+            continue;
+        }
+        if (vehicle.m_attempts == 0)
+        {
+            vehicle.m_firstSendUsecs = sendUsecs;
+        }
+        vehicle.m_lastSendUsecs = sendUsecs;
+        ++vehicle.m_attempts;
+        ++sent;
+    }
+    return sent;
+}
+
+void MAVLinkCommandDispatcher::finish(int groupId, Group &group)
+{
+    group.m_status.m_finished = true;
+    m_finishedGroups.append(groupId);
+    emit groupFinished(groupId);
+}
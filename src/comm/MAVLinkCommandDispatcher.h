@@ -0,0 +1,249 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file MAVLinkCommandDispatcher.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the dispatcher which sends a command to
+ *        a group of vehicles at the same time
+ */
+
+#ifndef MAVLINKCOMMANDDISPATCHER_H
+#define MAVLINKCOMMANDDISPATCHER_H
+
+#include <mavlink.h>
+
+#include <QObject>
+#include <QMap>
+#include <QList>
+#include <QTimer>
+
+class LinkInterface;
+class LinkManager;
+
+/**
+ * @brief The MAVLinkCommandDispatcher class sends COMMAND_LONG or COMMAND_INT messages
+ *        to a group of vehicles (e.g. arming all vehicles of a cooperative lift) with as little
+ *        time between the vehicles as possible.
+ *
+ *        All messages of a group are encoded before the first one is sent. The
+ *        messages of all vehicles reachable on the same link are concatenated and
+ *        handed to the link with a single write, the links are written one after
+ *        another without any other work in between. The time each vehicle was
+ *        written is stored so the skew between the vehicles can be reported.
+ *
+ *        The COMMAND_ACK of every vehicle is matched with the ingress time of the
+ *        link, which gives the latency of each vehicle. Vehicles which did not
+ *        acknowledge within s_AckTimeoutMs are sent the command again (with an
+ *        incremented confirmation field for COMMAND_LONG), vehicles which acknowledged
+ *        are not. Acknowledges addressed to another ground station are ignored.
+ *        Any result counts as acknowledge, including MAV_RESULT_IN_PROGRESS.
+ *
+ *        The dispatcher lives in the same thread as the MAVLinkProtocol.
+ */
+class MAVLinkCommandDispatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int s_ResultPending = -1;      ///< Vehicle has not acknowledged yet
+    static constexpr int s_ResultNoAck = -2;        ///< Vehicle did not acknowledge any attempt
+
+    /**
+     * @brief The VehicleStatus struct holds the state of the command of one vehicle
+     */
+    struct VehicleStatus
+    {
+        int m_systemId;             ///< System id of the vehicle
+        int m_result;               ///< MAV_RESULT of the acknowledge, s_ResultPending or s_ResultNoAck
+        int m_attempts;             ///< Number of times the command was sent
+        quint64 m_firstSendUsecs;   ///< Ground time the first attempt was written to the link
+        quint64 m_lastSendUsecs;    ///< Ground time the last attempt was written to the link
+        quint64 m_ackUsecs;         ///< Ground time the acknowledge was received. 0 if none.
+        qint64 m_latencyUsecs;      ///< Time between the last attempt and the acknowledge. -1 if none.
+
+        VehicleStatus();
+    };
+
+    /**
+     * @brief The GroupStatus struct holds the state of one group command
+     */
+    struct GroupStatus
+    {
+        int m_command;                      ///< MAV_CMD sent to the group
+        QList<VehicleStatus> m_vehicles;    ///< State of every vehicle in dispatch order
+        qint64 m_dispatchSkewUsecs;         ///< Time between the first and the last vehicle of the first attempt
+        qint64 m_encodeUsecs;               ///< Time spent encoding before the first write
+        bool m_finished;                    ///< All vehicles acknowledged or ran out of attempts
+
+        GroupStatus();
+    };
+
+    /**
+     * @brief The GlobalPosition struct holds a setpoint of one vehicle. Kept in double
+     *        as a float latitude or longitude only resolves about a metre.
+     */
+    struct GlobalPosition
+    {
+        double m_latitude;      ///< Latitude in deg
+        double m_longitude;     ///< Longitude in deg
+        double m_altitude;      ///< Altitude in m AMSL
+    };
+
+    explicit MAVLinkCommandDispatcher(LinkManager *linkManager, QObject *parent = nullptr);
+
+    /**
+     * @brief sendCommand sends one command to a group of vehicles. Each command
+     *        carries its own target, so the parameters may differ per vehicle
+     *        (e.g. a position of a formation). All commands must have the same
+     *        command id.
+     * @param commands - the commands, one per vehicle
+     * @return - id of the group or -1 if no vehicle could be reached
+     */
+    int sendCommand(const QList<mavlink_command_long_t> &commands);
+
+    /**
+     * @brief sendCommand sends one COMMAND_INT to a group of vehicles, used for
+     *        commands with a global position which needs the full resolution.
+     *        All commands must have the same command id.
+     * @param commands - the commands, one per vehicle
+     * @return - id of the group or -1 if no vehicle could be reached
+     */
+    int sendCommand(const QList<mavlink_command_int_t> &commands);
+
+    /**
+     * @brief sendCommand sends the same command to a group of vehicles
+     * @param systemIds - the vehicles
+     * @param command - the MAV_CMD
+     * @param param1-7 - the command parameters
+     * @param component - target component of all vehicles
+     * @return - id of the group or -1 if no vehicle could be reached
+     */
+    int sendCommand(const QList<int> &systemIds, MAV_CMD command,
+                    float param1 = 0.0f, float param2 = 0.0f, float param3 = 0.0f, float param4 = 0.0f,
+                    float param5 = 0.0f, float param6 = 0.0f, float param7 = 0.0f, int component = 0);
+
+    /**
+     * @brief setMode switches a group of vehicles to the same custom mode (MAV_CMD_DO_SET_MODE)
+     * @param systemIds - the vehicles
+     * @param customMode - the autopilot specific mode
+     * @return - id of the group or -1 if no vehicle could be reached
+     */
+    int setMode(const QList<int> &systemIds, uint32_t customMode);
+
+    /**
+     * @brief setArmed arms or disarms a group of vehicles (MAV_CMD_COMPONENT_ARM_DISARM)
+     * @param systemIds - the vehicles
+     * @param armed - true to arm
+     * @return - id of the group or -1 if no vehicle could be reached
+     */
+    int setArmed(const QList<int> &systemIds, bool armed);
+
+    /**
+     * @brief reposition sends a guided setpoint to each vehicle of a group
+     *        (MAV_CMD_DO_REPOSITION as COMMAND_INT, latitude and longitude in degE7)
+     * @param positions - position per system id
+     * @return - id of the group or -1 if no vehicle could be reached
+     */
+    int reposition(const QMap<int, GlobalPosition> &positions);
+
+    /**
+     * @brief getStatus returns the state of a group command
+     * @param groupId - id of the group
+     * @return - the state. Has no vehicles if the group is unknown.
+     */
+    GroupStatus getStatus(int groupId) const;
+
+    /**
+     * @brief removeGroup forgets a group. Acknowledges for it are ignored afterwards.
+     * @param groupId - id of the group
+     */
+    void removeGroup(int groupId);
+
+    /**
+     * @brief handleMessage processes COMMAND_ACK messages addressed to this ground station
+     *        (or to nobody), all other messages are ignored
+     * @param link - link the message was received on
+     * @param message - the message
+     * @param ingressTimeUsecs - ground time the message was read from the link
+     */
+    void handleMessage(LinkInterface *link, const mavlink_message_t &message, quint64 ingressTimeUsecs);
+
+signals:
+    /**
+     * @brief vehicleAcknowledged is emitted for every acknowledge of a group command
+     */
+    void vehicleAcknowledged(int groupId, int systemId, int result, qint64 latencyUsecs);
+
+    /**
+     * @brief groupFinished is emitted when all vehicles of a group acknowledged or
+     *        ran out of attempts
+     */
+    void groupFinished(int groupId);
+
+private slots:
+    void retryTimeout();
+
+private:
+    static constexpr int s_AckTimeoutMs = 500;      ///< Time to wait for an acknowledge before sending again
+    static constexpr int s_MaxAttempts = 3;         ///< Attempts per vehicle
+    static constexpr int s_MaxFinishedGroups = 32;  ///< Finished groups kept for getStatus()
+
+    /**
+     * @brief The Group struct holds a group command and its encoded messages
+     */
+    struct Group
+    {
+        GroupStatus m_status;
+        QList<mavlink_command_long_t> m_commands;   ///< COMMAND_LONG per vehicle, same order as m_status.m_vehicles
+        QList<mavlink_command_int_t> m_intCommands; ///< COMMAND_INT per vehicle if the group is sent as COMMAND_INT
+        quint64 m_deadlineUsecs;                    ///< Ground time the pending vehicles are sent again
+    };
+
+    /**
+     * @brief start sends a new group the first time and stores it
+     * @param group - the group with its vehicles and commands
+     * @return - id of the group or -1 if no vehicle could be reached
+     */
+    int start(Group &group);
+
+    /**
+     * @brief dispatch encodes the commands of the given vehicles of a group and writes them
+     *        to their links in one burst per link
+     * @param group - the group
+     * @param indices - indices of the vehicles to send to
+     * @return - number of vehicles written to at least one link
+     */
+    int dispatch(Group &group, const QList<int> &indices);
+
+    /**
+     * @brief finish marks a group as finished and emits groupFinished()
+     */
+    void finish(int groupId, Group &group);
+
+    LinkManager *m_linkManager;
+    int m_nextGroupId;
+    QMap<int, Group> m_groups;      ///< Groups by id
+    QList<int> m_finishedGroups;    ///< Finished group ids, oldest first
+    QTimer m_retryTimer;
+};
+
+#endif // MAVLINKCOMMANDDISPATCHER_H
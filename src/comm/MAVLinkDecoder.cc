@@ -37,6 +37,7 @@ This file is part of the APM_PLANNER project
 #include "LinkManager.h"
 #include "UASManager.h"
 #include "UASInterface.h"
+#include "UASTimeSync.h"
 
 #include <QDataStream>
 
@@ -248,6 +249,37 @@ void MAVLinkDecoder::receiveMessage(LinkInterface* link, mavlink_message_t messa
 }
 
 
+void MAVLinkDecoder::uasValueChanged(const mavlink_message_t *msg, int fieldid, int index, const QString &name,
+                                     const QString &unit, const QVariant &value, quint64 time)
+{
+    int key = -1;
+    // These messages carry the value name in the payload, so it is not fixed per field
+    const bool nameInPayload = (msg->msgid == MAVLINK_MSG_ID_DEBUG_VECT) || (msg->msgid == MAVLINK_MSG_ID_DEBUG) ||
+                               (msg->msgid == MAVLINK_MSG_ID_NAMED_VALUE_FLOAT) || (msg->msgid == MAVLINK_MSG_ID_NAMED_VALUE_INT);
+    if (!nameInPayload)
+    {
+        // sysid | compid | component flag | msgid | field | array index, see the name built in emitFieldValue()
+        const bool componentMulti = m_componentMulti.value(static_cast<int>(msg->msgid));
+        const quint64 fieldId = (static_cast<quint64>(msg->sysid) << 56) |
+                                (static_cast<quint64>(componentMulti ? msg->compid : 0) << 48) |
+                                (static_cast<quint64>(componentMulti ? 1 : 0) << 47) |
+                                (static_cast<quint64>(msg->msgid & 0xFFFFFF) << 23) |
+                                (static_cast<quint64>(fieldid & 0xFF) << 15) |
+                                static_cast<quint64>(index & 0x7FFF);
+        QHash<quint64, int>::const_iterator iter = m_fieldKeys.constFind(fieldId);
+        if (iter == m_fieldKeys.constEnd())
+        {
+            iter = m_fieldKeys.insert(fieldId, UASTelemetryStore::keyFor(name, unit));
+        }
+        key = iter.value();
+    }
+    else
+    {
+        key = UASTelemetryStore::keyFor(name, unit);
+    }
+    mp_uas->valueChangedRec(msg->sysid, key, name, unit, value, time);
+}
+
 void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64 time)
 {
     // check if we have data about the message format
@@ -338,7 +370,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
             }
             else
             {
-                mp_uas->valueChangedRec(msg->sysid, name, unit, b, time);
+                uasValueChanged(msg, fieldid, 0, name, unit, b, time);
             }
         }
         break;
@@ -355,7 +387,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
                 }
                 else
                 {
-                    mp_uas->valueChangedRec(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
+                    uasValueChanged(msg, fieldid, static_cast<int>(j), QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
                 }
             }
         }
@@ -370,7 +402,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
             }
             else
             {
-                mp_uas->valueChangedRec(msg->sysid, name, fieldType, u, time);
+                uasValueChanged(msg, fieldid, 0, name, fieldType, u, time);
             }
         }
         break;
@@ -387,7 +419,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
                 }
                 else
                 {
-                    mp_uas->valueChangedRec(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
+                    uasValueChanged(msg, fieldid, static_cast<int>(j), QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
                 }
             }
         }
@@ -402,7 +434,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
             }
             else
             {
-                mp_uas->valueChangedRec(msg->sysid, name, fieldType, n, time);
+                uasValueChanged(msg, fieldid, 0, name, fieldType, n, time);
             }
         }
         break;
@@ -419,7 +451,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
                 }
                 else
                 {
-                    mp_uas->valueChangedRec(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
+                    uasValueChanged(msg, fieldid, static_cast<int>(j), QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
                 }
             }
         }
@@ -434,7 +466,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
             }
             else
             {
-                mp_uas->valueChangedRec(msg->sysid, name, fieldType, n, time);
+                uasValueChanged(msg, fieldid, 0, name, fieldType, n, time);
             }
         }
         break;
@@ -451,7 +483,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
                 }
                 else
                 {
-                    mp_uas->valueChangedRec(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
+                    uasValueChanged(msg, fieldid, static_cast<int>(j), QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
                 }
             }
         }
@@ -466,7 +498,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
             }
             else
             {
-                mp_uas->valueChangedRec(msg->sysid, name, fieldType, n, time);
+                uasValueChanged(msg, fieldid, 0, name, fieldType, n, time);
             }
         }
         break;
@@ -483,7 +515,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
                 }
                 else
                 {
-                    mp_uas->valueChangedRec(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
+                    uasValueChanged(msg, fieldid, static_cast<int>(j), QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
                 }
             }
         }
@@ -498,7 +530,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
             }
             else
             {
-                mp_uas->valueChangedRec(msg->sysid, name, fieldType, n, time);
+                uasValueChanged(msg, fieldid, 0, name, fieldType, n, time);
             }
         }
         break;
@@ -515,7 +547,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
                 }
                 else
                 {
-                    mp_uas->valueChangedRec(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
+                    uasValueChanged(msg, fieldid, static_cast<int>(j), QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
                 }
             }
         }
@@ -530,7 +562,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
             }
             else
             {
-                mp_uas->valueChangedRec(msg->sysid, name, fieldType, n, time);
+                uasValueChanged(msg, fieldid, 0, name, fieldType, n, time);
             }
         }
         break;
@@ -547,7 +579,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
                 }
                 else
                 {
-                    mp_uas->valueChangedRec(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
+                    uasValueChanged(msg, fieldid, static_cast<int>(j), QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
                 }
             }
         }
@@ -562,7 +594,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
             }
             else
             {
-                mp_uas->valueChangedRec(msg->sysid, name, fieldType, f, time);
+                uasValueChanged(msg, fieldid, 0, name, fieldType, f, time);
             }
         }
         break;
@@ -579,7 +611,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
                 }
                 else
                 {
-                    mp_uas->valueChangedRec(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
+                    uasValueChanged(msg, fieldid, static_cast<int>(j), QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
                 }
             }
         }
@@ -594,7 +626,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
             }
             else
             {
-                mp_uas->valueChangedRec(msg->sysid, name, fieldType, f, time);
+                uasValueChanged(msg, fieldid, 0, name, fieldType, f, time);
             }
         }
         break;
@@ -611,7 +643,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
                 }
                 else
                 {
-                    mp_uas->valueChangedRec(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, static_cast<quint64>(nums[j]), time);
+                    uasValueChanged(msg, fieldid, static_cast<int>(j), QString("%1.%2").arg(name).arg(j), fieldType, static_cast<quint64>(nums[j]), time);
                 }
             }
         }
@@ -626,7 +658,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
             }
             else
             {
-                mp_uas->valueChangedRec(msg->sysid, name, fieldType, static_cast<quint64>(n), time);
+                uasValueChanged(msg, fieldid, 0, name, fieldType, static_cast<quint64>(n), time);
             }
         }
         break;
@@ -643,7 +675,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
                 }
                 else
                 {
-                    mp_uas->valueChangedRec(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, static_cast<quint64>(nums[j]), time);
+                    uasValueChanged(msg, fieldid, static_cast<int>(j), QString("%1.%2").arg(name).arg(j), fieldType, static_cast<quint64>(nums[j]), time);
                 }
             }
         }
@@ -658,7 +690,7 @@ void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64
             }
             else
             {
-                mp_uas->valueChangedRec(msg->sysid, name, fieldType, static_cast<quint64>(n), time);
+                uasValueChanged(msg, fieldid, 0, name, fieldType, static_cast<quint64>(n), time);
             }
         }
         break;
@@ -705,7 +737,17 @@ quint64 MAVLinkDecoder::getUnixTimeFromMs(int systemID, quint64 time)
             firstOnboardTime.insert(systemID,time);
         }
 
-        ret = time + onboardTimeOffset.value(systemID,0);
+        // Live data is mapped like the UAS does it if the vehicle answers TIMESYNC
+        UASTimeSync::Ptr timeSync = m_localDecode ? UASTimeSync::Ptr() : UASTimeSync::find(systemID);
+        quint64 groundTime = 0;
+        if (!timeSync.isNull() && timeSync->toGroundTimeUsecs(time * 1000, groundTime))
+        {
+            ret = groundTime / 1000;
+        }
+        else
+        {
+            ret = time + onboardTimeOffset.value(systemID,0);
+        }
     }
     else
     {
@@ -73,9 +73,24 @@ public slots:
     void emitFieldValue(mavlink_message_t* msg, int fieldid, quint64 time);
 
 private:
+    /**
+     * @brief uasValueChanged hands a field value to the active UAS together with the
+     *        interned key of its name and unit. The key is looked up once per field.
+     * @param msg - the message
+     * @param fieldid - index of the field in the message info
+     * @param index - index in an array field, 0 otherwise
+     * @param name - value name as built by emitFieldValue()
+     * @param unit - unit of the value
+     * @param value - the value
+     * @param time - timestamp of the value
+     */
+    void uasValueChanged(const mavlink_message_t *msg, int fieldid, int index, const QString &name,
+                         const QString &unit, const QVariant &value, quint64 time);
+
 
     QHash<int,int> m_componentID;
     QHash<int,bool> m_componentMulti;
+    QHash<quint64, int> m_fieldKeys;                 ///< Interned telemetry key of every field value, see uasValueChanged()
     QMap<quint32, bool> messageFilter;               ///< Message/field names not to emit
     QMap<quint32, bool> textMessageFilter;           ///< Message/field names not to emit in text mode
 
@@ -0,0 +1,243 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file MAVLinkProfiler.cc
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the MAVLink link profiler
+ */
+
+#include "MAVLinkProfiler.h"
+#include "QGC.h"
+
+namespace
+{
+
+quint64 linkKey(int linkId)
+{
+    return static_cast<quint64>(linkId & 0xffff) + 1;
+}
+
+}
+
+MAVLinkProfiler::Snapshot::Snapshot() :
+    m_timeUsecs(0),
+    m_overflows(0)
+{}
+
+MAVLinkProfiler::MAVLinkProfiler() :
+    m_overflows(0)
+{
+    for (MessageEntry &entry : m_messageTable)
+    {
+        entry.m_key = 0;
+        entry.m_messages = 0;
+        entry.m_bytes = 0;
+    }
+    for (ComponentEntry &entry : m_componentTable)
+    {
+        entry.m_key = 0;
+        entry.m_lastSequence = s_NoSequence;
+        entry.m_received = 0;
+        entry.m_lost = 0;
+        entry.m_outOfOrder = 0;
+    }
+    for (LinkEntry &entry : m_linkTable)
+    {
+        entry.m_key = 0;
+        entry.m_bytes = 0;
+        entry.m_messages = 0;
+        entry.m_parseErrors = 0;
+    }
+}
+
+template <typename Entry, int Size>
+Entry *MAVLinkProfiler::findEntry(Entry (&table)[Size], quint64 key)
+{
+    static_assert((Size & (Size - 1)) == 0, "Table size must be a power of two");
+    // Fibonacci hashing spreads the packed keys over the table
+    int index = static_cast<int>((key * 0x9E3779B97F4A7C15ull) >> 40) & (Size - 1);
+    for (int probe = 0; probe < Size; ++probe, index = (index + 1) & (Size - 1))
+    {
+        Entry &entry = table[index];
+        quint64 current = entry.m_key.load(std::memory_order_acquire);
+        if (current == key)
+        {
+            return &entry;
+        }
+        if (current == 0)
+        {
+            // Claim the empty entry. If another writer was faster check its key.
+            if (entry.m_key.compare_exchange_strong(current, key, std::memory_order_acq_rel) || current == key)
+            {
+                return &entry;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void MAVLinkProfiler::countBytes(int linkId, int bytes, int parseErrors)
+{
+    LinkEntry *entry = findEntry(m_linkTable, linkKey(linkId));
+    if (!entry)
+    {
+        m_overflows.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    entry->m_bytes.fetch_add(static_cast<quint64>(bytes), std::memory_order_relaxed);
+    if (parseErrors > 0)
+    {
+        entry->m_parseErrors.fetch_add(static_cast<quint64>(parseErrors), std::memory_order_relaxed);
+    }
+}
+
+void MAVLinkProfiler::countMessage(int linkId, const mavlink_message_t &message)
+{
+    LinkEntry *link = findEntry(m_linkTable, linkKey(linkId));
+    MessageEntry *entry = findEntry(m_messageTable, messageKey(linkId, message.sysid, message.compid, message.msgid));
+    ComponentEntry *component = findEntry(m_componentTable, componentKey(linkId, message.sysid, message.compid));
+    if (!link || !entry || !component)
+    {
+        m_overflows.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (link)
+    {
+        link->m_messages.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (entry)
+    {
+        entry->m_messages.fetch_add(1, std::memory_order_relaxed);
+        entry->m_bytes.fetch_add(static_cast<quint64>(frameLength(message)), std::memory_order_relaxed);
+    }
+    if (component)
+    {
+        // The sequence is only written by the protocol, so load and store need no exchange
+        const quint32 last = component->m_lastSequence.load(std::memory_order_relaxed);
+        bool inOrder = true;
+        if (last != s_NoSequence)
+        {
+            // Sequence is 8 bit and wraps. A gap of more than half the range is an old message.
+            const quint32 gap = (static_cast<quint32>(message.seq) - last - 1) & 0xff;
+            if (gap >= 0x80)
+            {
+                component->m_outOfOrder.fetch_add(1, std::memory_order_relaxed);
+                // Keep the newest sequence, otherwise the messages following the
+                // late one would be counted as lost a second time.
+                inOrder = false;
+            }
+            else
+            {
+                component->m_lost.fetch_add(gap, std::memory_order_relaxed);
+            }
+        }
+        if (inOrder)
+        {
+            component->m_lastSequence.store(message.seq, std::memory_order_relaxed);
+        }
+        component->m_received.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+MAVLinkProfiler::Snapshot MAVLinkProfiler::snapshot() const
+{
+    Snapshot snapshot;
+    snapshot.m_timeUsecs = QGC::groundTimeUsecs();
+    snapshot.m_overflows = m_overflows.load(std::memory_order_relaxed);
+
+    for (const MessageEntry &entry : m_messageTable)
+    {
+        const quint64 key = entry.m_key.load(std::memory_order_acquire);
+        if (key == 0)
+        {
+            continue;
+        }
+        MessageCounters counters;
+        counters.m_linkId = static_cast<int>(((key - 1) >> 48) & 0xffff);
+        counters.m_sysId = static_cast<int>(((key - 1) >> 40) & 0xff);
+        counters.m_compId = static_cast<int>(((key - 1) >> 32) & 0xff);
+        counters.m_msgId = static_cast<quint32>((key - 1) & 0xffffff);
+        counters.m_messages = entry.m_messages.load(std::memory_order_relaxed);
+        counters.m_bytes = entry.m_bytes.load(std::memory_order_relaxed);
+        snapshot.m_messages.append(counters);
+    }
+
+    for (const ComponentEntry &entry : m_componentTable)
+    {
+        const quint64 key = entry.m_key.load(std::memory_order_acquire);
+        if (key == 0)
+        {
+            continue;
+        }
+        ComponentCounters counters;
+        counters.m_linkId = static_cast<int>(((key - 1) >> 16) & 0xffff);
+        counters.m_sysId = static_cast<int>(((key - 1) >> 8) & 0xff);
+        counters.m_compId = static_cast<int>((key - 1) & 0xff);
+        counters.m_received = entry.m_received.load(std::memory_order_relaxed);
+        counters.m_lost = entry.m_lost.load(std::memory_order_relaxed);
+        counters.m_outOfOrder = entry.m_outOfOrder.load(std::memory_order_relaxed);
+        snapshot.m_components.append(counters);
+    }
+
+    for (const LinkEntry &entry : m_linkTable)
+    {
+        const quint64 key = entry.m_key.load(std::memory_order_acquire);
+        if (key == 0)
+        {
+            continue;
+        }
+        LinkCounters counters;
+        counters.m_linkId = static_cast<int>((key - 1) & 0xffff);
+        counters.m_bytes = entry.m_bytes.load(std::memory_order_relaxed);
+        counters.m_messages = entry.m_messages.load(std::memory_order_relaxed);
+        counters.m_parseErrors = entry.m_parseErrors.load(std::memory_order_relaxed);
+        snapshot.m_links.append(counters);
+    }
+    return snapshot;
+}
+
+int MAVLinkProfiler::frameLength(const mavlink_message_t &message)
+{
+    if (message.magic == MAVLINK_STX_MAVLINK1)
+    {
+        // 6 header bytes and 2 checksum bytes
+        return message.len + 8;
+    }
+    int length = message.len + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+    if (message.incompat_flags & MAVLINK_IFLAG_SIGNED)
+    {
+        length += MAVLINK_SIGNATURE_BLOCK_LEN;
+    }
+    return length;
+}
+
+quint64 MAVLinkProfiler::messageKey(int linkId, int sysId, int compId, quint32 msgId)
+{
+    return ((static_cast<quint64>(linkId & 0xffff) << 48) | (static_cast<quint64>(sysId & 0xff) << 40) |
+            (static_cast<quint64>(compId & 0xff) << 32) | static_cast<quint64>(msgId & 0xffffff)) + 1;
+}
+
+quint64 MAVLinkProfiler::componentKey(int linkId, int sysId, int compId)
+{
+    return ((static_cast<quint64>(linkId & 0xffff) << 16) | (static_cast<quint64>(sysId & 0xff) << 8) |
+            static_cast<quint64>(compId & 0xff)) + 1;
+}
@@ -0,0 +1,189 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file MAVLinkProfiler.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the MAVLink link profiler
+ */
+
+#ifndef MAVLINKPROFILER_H
+#define MAVLINKPROFILER_H
+
+#include <mavlink.h>
+
+#include <QVector>
+
+#include <atomic>
+
+/**
+ * @brief The MAVLinkProfiler class counts the received traffic per link, per
+ *        system/component/message id, the sequence gaps per component and the
+ *        parse errors per link.
+ *        The counters live in fixed size open addressing tables which are written
+ *        by the protocol without any lock or allocation. Readers take a snapshot
+ *        at any time from any thread and compute rates from the difference of two
+ *        snapshots. Counters are never reset, readers keep a baseline instead.
+ */
+class MAVLinkProfiler
+{
+public:
+    static constexpr int s_MaxMessageEntries = 4096;    ///< Max number of link/sysid/compid/msgid combinations
+    static constexpr int s_MaxComponentEntries = 512;   ///< Max number of link/sysid/compid combinations
+    static constexpr int s_MaxLinkEntries = 32;         ///< Max number of links
+
+    /**
+     * @brief The MessageCounters struct holds the counters of one message id
+     *        of one component on one link
+     */
+    struct MessageCounters
+    {
+        int m_linkId;
+        int m_sysId;
+        int m_compId;
+        quint32 m_msgId;
+        quint64 m_messages;     ///< Number of received messages
+        quint64 m_bytes;        ///< Number of received bytes (whole frames)
+    };
+
+    /**
+     * @brief The ComponentCounters struct holds the sequence analysis of one component on one link
+     */
+    struct ComponentCounters
+    {
+        int m_linkId;
+        int m_sysId;
+        int m_compId;
+        quint64 m_received;     ///< Number of received messages
+        quint64 m_lost;         ///< Number of messages missing in the sequence
+        quint64 m_outOfOrder;   ///< Number of messages with a sequence older than expected
+    };
+
+    /**
+     * @brief The LinkCounters struct holds the counters of one link
+     */
+    struct LinkCounters
+    {
+        int m_linkId;
+        quint64 m_bytes;        ///< Number of received bytes
+        quint64 m_messages;     ///< Number of decoded messages
+        quint64 m_parseErrors;  ///< Number of bytes/frames dropped by the parser (bad header, CRC or signature)
+    };
+
+    /**
+     * @brief The Snapshot struct is a copy of all counters at one point in time
+     */
+    struct Snapshot
+    {
+        quint64 m_timeUsecs;                    ///< Ground time the snapshot was taken
+        quint64 m_overflows;                    ///< Number of updates lost because a table was full
+        QVector<MessageCounters> m_messages;
+        QVector<ComponentCounters> m_components;
+        QVector<LinkCounters> m_links;
+
+        Snapshot();
+    };
+
+    MAVLinkProfiler();
+
+    /**
+     * @brief countBytes counts a buffer read from a link
+     * @param linkId - id of the link
+     * @param bytes - size of the buffer
+     * @param parseErrors - number of parse errors while decoding the buffer
+     */
+    void countBytes(int linkId, int bytes, int parseErrors);
+
+    /**
+     * @brief countMessage counts a decoded message and checks its sequence
+     * @param linkId - id of the link the message was received on
+     * @param message - the message
+     */
+    void countMessage(int linkId, const mavlink_message_t &message);
+
+    /**
+     * @brief snapshot copies all counters
+     * @return - the snapshot
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @brief frameLength calculates the length of a message on the wire
+     * @param message - the message
+     * @return - number of bytes including header, checksum and signature
+     */
+    static int frameLength(const mavlink_message_t &message);
+
+    /**
+     * @brief messageKey packs link, system, component and message id into one key
+     * @return - the key. Never 0.
+     */
+    static quint64 messageKey(int linkId, int sysId, int compId, quint32 msgId);
+
+    /**
+     * @brief componentKey packs link, system and component id into one key
+     * @return - the key. Never 0.
+     */
+    static quint64 componentKey(int linkId, int sysId, int compId);
+
+private:
+    static constexpr quint32 s_NoSequence = 0x100;  ///< Marks a component without received sequence
+
+    struct MessageEntry
+    {
+        std::atomic<quint64> m_key;     ///< 0 if unused, else packed key + 1
+        std::atomic<quint64> m_messages;
+        std::atomic<quint64> m_bytes;
+    };
+
+    struct ComponentEntry
+    {
+        std::atomic<quint64> m_key;
+        std::atomic<quint32> m_lastSequence;
+        std::atomic<quint64> m_received;
+        std::atomic<quint64> m_lost;
+        std::atomic<quint64> m_outOfOrder;
+    };
+
+    struct LinkEntry
+    {
+        std::atomic<quint64> m_key;
+        std::atomic<quint64> m_bytes;
+        std::atomic<quint64> m_messages;
+        std::atomic<quint64> m_parseErrors;
+    };
+
+    /**
+     * @brief findEntry finds or inserts the entry of a key (linear probing)
+     * @param table - the table
+     * @param key - the key, must not be 0
+     * @return - the entry or nullptr if the table is full
+     */
+    template <typename Entry, int Size>
+    static Entry *findEntry(Entry (&table)[Size], quint64 key);
+
+    MessageEntry m_messageTable[s_MaxMessageEntries];
+    ComponentEntry m_componentTable[s_MaxComponentEntries];
+    LinkEntry m_linkTable[s_MaxLinkEntries];
+    std::atomic<quint64> m_overflows;
+};
+
+#endif // MAVLINKPROFILER_H
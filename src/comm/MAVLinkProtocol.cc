@@ -35,6 +35,8 @@ This file is part of the APM_PLANNER project
 
 #include "MAVLinkProtocol.h"
 #include "LinkManager.h"
+#include "MAVLinkRouter.h"
+#include "MAVLinkCommandDispatcher.h"
 #include "mavlink_helpers.h"
 
 #include <cstring>
@@ -56,6 +58,11 @@ void MAVLinkProtocol::sendMessage(mavlink_message_t msg)
 }
 
 void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBytes)
+{
+    receiveBytesAt(link, dataBytes, QGC::groundTimeUsecs());
+}
+
+void MAVLinkProtocol::receiveBytesAt(LinkInterface* link, const QByteArray &dataBytes, quint64 ingressTimeUsecs)
 {
     static int nonmavlinkCount = 0;
     static int radioVersionMismatchCount = 0;
@@ -66,12 +73,15 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBy
     mavlink_message_t message;
     memset(&message, 0, sizeof(mavlink_message_t));
     mavlink_status_t status;
+    int parseErrors = 0;
 
     //QLOG_DEBUG() << "MAVLinkProtocol received size:" << dataBytes.size() << " " << dataBytes.at(0);
 
     for(const auto &data : dataBytes)
     {
         unsigned int decodeState = mavlink_parse_char(MAVLINK_COMM_0, static_cast<quint8>(data), &message, &status);
+        // The parser reports the errors of each byte in the drop count
+        parseErrors += status.packet_rx_drop_count;
 
         if (decodeState == 0 && !decodedFirstPacket)
         {
@@ -95,6 +105,8 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBy
 
         if (decodeState == 1)
         {
+            m_profiler.countMessage(link->getId(), message);
+
             mavlink_status_t* mavlinkStatus = mavlink_get_channel_status(MAVLINK_COMM_0);
             if (!decodedFirstPacket)
             {
@@ -224,7 +236,8 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBy
             // Log data
             if (m_loggingEnabled && !m_ScopedLogfilePtr.isNull())
             {
-                quint64 time = QGC::groundTimeUsecs();
+                // All messages of one buffer share the time the buffer was read from the link
+                quint64 time = ingressTimeUsecs;
                 uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
 
                 QDataStream outStream(m_ScopedLogfilePtr.data());
@@ -245,12 +258,25 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBy
                 }
             }
 
+            // Acknowledges are matched with the ingress time, not the time of the queued signal
+            if (m_commandDispatcher && (message.msgid == MAVLINK_MSG_ID_COMMAND_ACK))
+            {
+                m_commandDispatcher->handleMessage(link, message, ingressTimeUsecs);
+            }
+
+            // Forward to other links before the message is processed locally
+            if (m_router)
+            {
+                m_router->routeMessage(link, message);
+            }
+
             if (m_isOnline)
             {
                  handleMessage(link, message);
             }
         }
     }
+    m_profiler.countBytes(link->getId(), dataBytes.size(), parseErrors);
 }
 
 void MAVLinkProtocol::handleMessage(LinkInterface *link, const mavlink_message_t &message)
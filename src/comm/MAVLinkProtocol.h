@@ -40,6 +40,7 @@ This file is part of the APM_PLANNER project
 #include <mavlink.h>
 
 #include "LinkInterface.h"
+#include "MAVLinkProfiler.h"
 #include "QGC.h"
 #include "configuration.h"
 
@@ -48,6 +49,8 @@ This file is part of the APM_PLANNER project
 #include <QMap>
 
 class LinkManager;
+class MAVLinkRouter;
+class MAVLinkCommandDispatcher;
 class MAVLinkProtocol : public QObject
 {
     Q_OBJECT
@@ -58,6 +61,16 @@ public:
     ~MAVLinkProtocol() override;
 
     void setConnectionManager(LinkManager *manager) { m_connectionManager = manager; }
+    /*!
+     * \brief setRouter - Sets the router which forwards received messages to other links
+     * \param router - The router or nullptr to disable forwarding
+     */
+    void setRouter(MAVLinkRouter *router) { m_router = router; }
+    /*!
+     * \brief setCommandDispatcher - Sets the dispatcher which gets the command acknowledges
+     * \param dispatcher - The dispatcher or nullptr
+     */
+    void setCommandDispatcher(MAVLinkCommandDispatcher *dispatcher) { m_commandDispatcher = dispatcher; }
     void sendMessage(mavlink_message_t msg);
     void stopLogging();
     bool startLogging(const QString& filename);
@@ -75,9 +88,22 @@ public:
      * \return - Number of lost messages
      */
     quint64 getTotalMessagesLost(int mavLinkID) const;
+    /*!
+     * \brief getProfiler - Get the profiler holding the traffic counters of all links
+     * \return - The profiler. Its snapshot can be taken from any thread.
+     */
+    const MAVLinkProfiler &getProfiler() const { return m_profiler; }
 
 public slots:
     void receiveBytes(LinkInterface* link, const QByteArray &dataBytes);
+    /*!
+     * \brief receiveBytesAt - Parses data read from a link
+     * \param link - The link the data was read from
+     * \param dataBytes - The data
+     * \param ingressTimeUsecs - Ground time in microseconds the data was read from the link.
+     *        Used for the timestamps of the logfile.
+     */
+    void receiveBytesAt(LinkInterface* link, const QByteArray &dataBytes, quint64 ingressTimeUsecs);
 
 private:
     void handleMessage(LinkInterface *link, const mavlink_message_t &message);
@@ -91,6 +117,8 @@ private:
 
     bool m_throwAwayGCSPackets = false;
     LinkManager *m_connectionManager = nullptr;
+    MAVLinkRouter *m_router = nullptr;
+    MAVLinkCommandDispatcher *m_commandDispatcher = nullptr;
     bool versionMismatchIgnore = false;
     bool m_enable_version_check = false;
 
@@ -100,6 +128,7 @@ private:
     QMap<int, quint64> currReceiveCounter;
     QMap<int, quint64> currLossCounter;
     QMap<int,QMap<int, quint8> > lastIndex;
+    MAVLinkProfiler m_profiler;
 
 signals:
     void protocolStatusMessage(const QString& title, const QString& message);
@@ -0,0 +1,308 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file MAVLinkRouter.cc
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the MAVLink router which forwards
+ *        messages between links
+ */
+
+#include "MAVLinkRouter.h"
+#include "LinkManager.h"
+#include "LinkInterface.h"
+#include "mavlink_helpers.h"
+#include "logging.h"
+
+#include <QStringList>
+
+#include <algorithm>
+
+MAVLinkRouter::Route::Route() :
+    m_sourceLinkId(-1),
+    m_targetLinkId(-1)
+{}
+
+MAVLinkRouter::Route::Route(int sourceLinkId, int targetLinkId) :
+    m_sourceLinkId(sourceLinkId),
+    m_targetLinkId(targetLinkId)
+{}
+
+MAVLinkRouter::RouteStatistics::RouteStatistics() :
+    m_messages(0),
+    m_bytes(0),
+    m_filtered(0),
+    m_dropped(0),
+    m_messageRate(0.0),
+    m_byteRate(0.0)
+{}
+
+MAVLinkRouter::MAVLinkRouter(LinkManager *linkManager, QObject *parent) :
+    QObject(parent),
+    m_linkManager(linkManager),
+    m_nextRouteId(0)
+{
+    m_statisticsTimer.setInterval(s_StatisticsIntervalMs);
+    connect(&m_statisticsTimer, SIGNAL(timeout()), this, SLOT(updateStatistics()));
+}
+
+int MAVLinkRouter::addRoute(const Route &route)
+{
+    if (!isValid(route))
+    {
+        return -1;
+    }
+
+    RouteEntry entry;
+    entry.m_route = route;
+    entry.m_lastMessages = 0;
+    entry.m_lastBytes = 0;
+    const int routeId = m_nextRouteId++;
+    m_routes.insert(routeId, entry);
+
+    if (!m_statisticsTimer.isActive())
+    {
+        m_statisticsElapsed.start();
+        m_statisticsTimer.start();
+    }
+    QLOG_INFO() << "MAVLinkRouter: added route" << routeId << ":" << route.m_sourceLinkId << "->" << route.m_targetLinkId;
+    emit routesChanged();
+    return routeId;
+}
+
+bool MAVLinkRouter::updateRoute(int routeId, const Route &route)
+{
+    QMap<int, RouteEntry>::iterator iter = m_routes.find(routeId);
+    if (iter == m_routes.end() || !isValid(route))
+    {
+        return false;
+    }
+    iter->m_route = route;
+    QLOG_INFO() << "MAVLinkRouter: changed route" << routeId << ":" << route.m_sourceLinkId << "->" << route.m_targetLinkId;
+    emit routesChanged();
+    return true;
+}
+
+void MAVLinkRouter::removeRoute(int routeId)
+{
+    if (m_routes.remove(routeId) == 0)
+    {
+        return;
+    }
+    if (m_routes.isEmpty())
+    {
+        m_statisticsTimer.stop();
+    }
+    QLOG_INFO() << "MAVLinkRouter: removed route" << routeId;
+    emit routesChanged();
+}
+
+void MAVLinkRouter::removeRoutesOfLink(int linkId)
+{
+    foreach (int routeId, m_routes.keys())
+    {
+        const Route &route = m_routes.value(routeId).m_route;
+        if (route.m_sourceLinkId == linkId || route.m_targetLinkId == linkId)
+        {
+            removeRoute(routeId);
+        }
+    }
+
+    // Forget what was learned on this link
+    for (QHash<quint16, int>::iterator iter = m_componentLinks.begin(); iter != m_componentLinks.end();)
+    {
+        iter = iter.value() == linkId ? m_componentLinks.erase(iter) : iter + 1;
+    }
+    for (QHash<int, int>::iterator iter = m_systemLinks.begin(); iter != m_systemLinks.end();)
+    {
+        iter = iter.value() == linkId ? m_systemLinks.erase(iter) : iter + 1;
+    }
+}
+
+void MAVLinkRouter::clear()
+{
+    m_routes.clear();
+    m_componentLinks.clear();
+    m_systemLinks.clear();
+    m_statisticsTimer.stop();
+    emit routesChanged();
+}
+
+QList<int> MAVLinkRouter::getRouteIds() const
+{
+    return m_routes.keys();
+}
+
+MAVLinkRouter::Route MAVLinkRouter::getRoute(int routeId) const
+{
+    return m_routes.value(routeId).m_route;
+}
+
+MAVLinkRouter::RouteStatistics MAVLinkRouter::getStatistics(int routeId) const
+{
+    return m_routes.value(routeId).m_statistics;
+}
+
+QHash<quint16, int> MAVLinkRouter::getRoutingTable() const
+{
+    return m_componentLinks;
+}
+
+void MAVLinkRouter::routeMessage(LinkInterface *link, const mavlink_message_t &message)
+{
+    const int ingressLinkId = link->getId();
+
+    // Learn where the sender lives
+    m_componentLinks.insert(componentKey(message.sysid, message.compid), ingressLinkId);
+    m_systemLinks.insert(message.sysid, ingressLinkId);
+
+    if (m_routes.isEmpty())
+    {
+        return;
+    }
+
+    // Find the link of the addressed system/component. -1 means broadcast or unknown.
+    int targetLinkId = -1;
+    const mavlink_msg_entry_t *msgEntry = mavlink_get_msg_entry(message.msgid);
+    if (msgEntry && (msgEntry->flags & MAV_MSG_ENTRY_FLAG_HAVE_TARGET_SYSTEM))
+    {
+        const quint8 targetSystem = static_cast<quint8>(_MAV_PAYLOAD(&message)[msgEntry->target_system_ofs]);
+        quint8 targetComponent = 0;
+        if (msgEntry->flags & MAV_MSG_ENTRY_FLAG_HAVE_TARGET_COMPONENT)
+        {
+            targetComponent = static_cast<quint8>(_MAV_PAYLOAD(&message)[msgEntry->target_component_ofs]);
+        }
+        if (targetSystem != 0)
+        {
+            targetLinkId = targetComponent != 0 ?
+                        m_componentLinks.value(componentKey(targetSystem, targetComponent), m_systemLinks.value(targetSystem, -1)) :
+                        m_systemLinks.value(targetSystem, -1);
+        }
+    }
+
+    // The frame is serialized on first use only. It keeps the received header,
+    // sequence, checksum and signature, nothing is packed again.
+    quint8 buffer[MAVLINK_MAX_PACKET_LEN];
+    int length = -1;
+
+    for (QMap<int, RouteEntry>::iterator iter = m_routes.begin(); iter != m_routes.end(); ++iter)
+    {
+        const Route &route = iter->m_route;
+        if (route.m_sourceLinkId != ingressLinkId)
+        {
+            continue;
+        }
+        RouteStatistics &statistics = iter->m_statistics;
+        if (!accepts(route, message))
+        {
+            ++statistics.m_filtered;
+            continue;
+        }
+        if (targetLinkId >= 0 && targetLinkId != route.m_targetLinkId)
+        {
+            // Addressed to a system which lives on another link
+            continue;
+        }
+
+        LinkInterface *egress = m_linkManager->getLink(route.m_targetLinkId);
+        if (!egress || !egress->isConnected())
+        {
+            ++statistics.m_dropped;
+            continue;
+        }
+        if (length < 0)
+        {
+            length = mavlink_msg_to_send_buffer(buffer, &message);
+        }
+        egress->writeBytes(reinterpret_cast<const char *>(buffer), length);
+        ++statistics.m_messages;
+        statistics.m_bytes += static_cast<quint64>(length);
+    }
+}
+
+void MAVLinkRouter::updateStatistics()
+{
+    const double seconds = m_statisticsElapsed.restart() / 1000.0;
+    if (seconds <= 0.0)
+    {
+        return;
+    }
+    for (QMap<int, RouteEntry>::iterator iter = m_routes.begin(); iter != m_routes.end(); ++iter)
+    {
+        RouteStatistics &statistics = iter->m_statistics;
+        statistics.m_messageRate = static_cast<double>(statistics.m_messages - iter->m_lastMessages) / seconds;
+        statistics.m_byteRate = static_cast<double>(statistics.m_bytes - iter->m_lastBytes) / seconds;
+        iter->m_lastMessages = statistics.m_messages;
+        iter->m_lastBytes = statistics.m_bytes;
+    }
+    emit statisticsUpdated();
+}
+
+QString MAVLinkRouter::idSetToString(const QSet<int> &ids)
+{
+    QList<int> sorted = ids.values();
+    std::sort(sorted.begin(), sorted.end());
+    QStringList list;
+    foreach (int id, sorted)
+    {
+        list.append(QString::number(id));
+    }
+    return list.join(',');
+}
+
+QSet<int> MAVLinkRouter::idSetFromString(const QString &string)
+{
+    QSet<int> ids;
+    foreach (const QString &item, string.split(','))
+    {
+        bool ok = false;
+        const int id = item.trimmed().toInt(&ok);
+        if (ok)
+        {
+            ids.insert(id);
+        }
+    }
+    return ids;
+}
+
+quint16 MAVLinkRouter::componentKey(int sysId, int compId)
+{
+    return static_cast<quint16>(((sysId & 0xff) << 8) | (compId & 0xff));
+}
+
+bool MAVLinkRouter::isValid(const Route &route)
+{
+    if (route.m_sourceLinkId < 0 || route.m_targetLinkId < 0 || route.m_sourceLinkId == route.m_targetLinkId)
+    {
+        QLOG_WARN() << "MAVLinkRouter: invalid route" << route.m_sourceLinkId << "->" << route.m_targetLinkId;
+        return false;
+    }
+    return true;
+}
+
+bool MAVLinkRouter::accepts(const Route &route, const mavlink_message_t &message)
+{
+    const int msgId = static_cast<int>(message.msgid);
+    return (route.m_sysIds.isEmpty() || route.m_sysIds.contains(message.sysid)) &&
+           (route.m_compIds.isEmpty() || route.m_compIds.contains(message.compid)) &&
+           (route.m_msgIds.isEmpty() || route.m_msgIds.contains(msgId)) &&
+           !route.m_blockedMsgIds.contains(msgId);
+}
@@ -0,0 +1,195 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file MAVLinkRouter.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the MAVLink router which forwards
+ *        messages between links
+ */
+
+#ifndef MAVLINKROUTER_H
+#define MAVLINKROUTER_H
+
+#include <mavlink.h>
+
+#include <QObject>
+#include <QMap>
+#include <QHash>
+#include <QSet>
+#include <QList>
+#include <QTimer>
+#include <QElapsedTimer>
+
+class LinkInterface;
+class LinkManager;
+
+/**
+ * @brief The MAVLinkRouter class forwards received MAVLink messages from one link
+ *        to other links (e.g. from the serial radio to an UDP link of a companion
+ *        computer) so no external mavproxy is needed.
+ *
+ *        Forwarding is configured by routes. Each route forwards the messages of
+ *        one source link to one target link and can be limited by system id,
+ *        component id and message id.
+ *        The router learns from the traffic which system/component is reachable
+ *        on which link. Messages addressed to a known system are only forwarded
+ *        on routes leading to that system, broadcasts are forwarded on all routes.
+ *
+ *        Messages are forwarded with their original header, sequence number,
+ *        checksum and signature. They are only serialized once into a stack
+ *        buffer which is then written to all target links.
+ *        The router lives in the same thread as the MAVLinkProtocol.
+ */
+class MAVLinkRouter : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief The Route struct configures one forwarding direction.
+     *        Empty id sets accept all ids.
+     */
+    struct Route
+    {
+        int m_sourceLinkId;         ///< Messages received on this link are forwarded
+        int m_targetLinkId;         ///< to this link
+        QSet<int> m_sysIds;         ///< Forward only messages of these systems
+        QSet<int> m_compIds;        ///< Forward only messages of these components
+        QSet<int> m_msgIds;         ///< Forward only these message ids
+        QSet<int> m_blockedMsgIds;  ///< Never forward these message ids
+
+        Route();
+        Route(int sourceLinkId, int targetLinkId);
+    };
+
+    /**
+     * @brief The RouteStatistics struct holds the throughput of one route
+     */
+    struct RouteStatistics
+    {
+        quint64 m_messages;     ///< Number of forwarded messages
+        quint64 m_bytes;        ///< Number of forwarded bytes
+        quint64 m_filtered;     ///< Number of messages rejected by the route filter
+        quint64 m_dropped;      ///< Number of messages dropped because the target link was not connected
+        double m_messageRate;   ///< Forwarded messages per second
+        double m_byteRate;      ///< Forwarded bytes per second
+
+        RouteStatistics();
+    };
+
+    explicit MAVLinkRouter(LinkManager *linkManager, QObject *parent = nullptr);
+
+    /**
+     * @brief addRoute adds a new route
+     * @param route - the route
+     * @return - id of the route or -1 if the route is invalid
+     */
+    int addRoute(const Route &route);
+
+    /**
+     * @brief updateRoute replaces the configuration of a route. The statistics are kept.
+     * @param routeId - id of the route
+     * @param route - the new configuration
+     * @return - false if the route does not exist or the new configuration is invalid
+     */
+    bool updateRoute(int routeId, const Route &route);
+
+    /**
+     * @brief removeRoute removes a route
+     * @param routeId - id of the route
+     */
+    void removeRoute(int routeId);
+
+    /**
+     * @brief removeRoutesOfLink removes all routes from or to a link
+     * @param linkId - id of the link
+     */
+    void removeRoutesOfLink(int linkId);
+
+    /**
+     * @brief clear removes all routes and the learned routing table
+     */
+    void clear();
+
+    QList<int> getRouteIds() const;
+    Route getRoute(int routeId) const;
+    RouteStatistics getStatistics(int routeId) const;
+
+    /**
+     * @brief getRoutingTable returns the learned routing table
+     * @return - map of (sysid << 8 | compid) to the id of the link the component was seen on
+     */
+    QHash<quint16, int> getRoutingTable() const;
+
+    /**
+     * @brief idSetToString converts an id filter into a comma separated list
+     */
+    static QString idSetToString(const QSet<int> &ids);
+
+    /**
+     * @brief idSetFromString converts a comma separated list into an id filter.
+     *        Invalid entries are skipped.
+     */
+    static QSet<int> idSetFromString(const QString &string);
+
+    /**
+     * @brief routeMessage forwards a received message on all matching routes
+     * @param link - link the message was received on
+     * @param message - the message
+     */
+    void routeMessage(LinkInterface *link, const mavlink_message_t &message);
+
+signals:
+    void routesChanged();
+    void statisticsUpdated();
+
+private slots:
+    void updateStatistics();
+
+private:
+    static constexpr int s_StatisticsIntervalMs = 1000;   ///< Interval of the throughput calculation
+
+    /**
+     * @brief The RouteEntry struct holds a route and its counters
+     */
+    struct RouteEntry
+    {
+        Route m_route;
+        RouteStatistics m_statistics;
+        quint64 m_lastMessages;     ///< Forwarded messages at the last statistics update
+        quint64 m_lastBytes;        ///< Forwarded bytes at the last statistics update
+    };
+
+    static quint16 componentKey(int sysId, int compId);
+    static bool isValid(const Route &route);
+    static bool accepts(const Route &route, const mavlink_message_t &message);
+
+    LinkManager *m_linkManager;
+    int m_nextRouteId;
+    QMap<int, RouteEntry> m_routes;         ///< Routes by id
+    QHash<quint16, int> m_componentLinks;   ///< Learned link of each system/component
+    QHash<int, int> m_systemLinks;          ///< Learned link of each system
+    QTimer m_statisticsTimer;
+    QElapsedTimer m_statisticsElapsed;
+};
+
+#endif // MAVLINKROUTER_H
@@ -894,7 +894,7 @@ void MAVLinkSimulationLink::readBytes()
     }
 
     QByteArray b(data, len);
-    emit bytesReceived(this, b);
+    emitBytesReceived(b, QGC::groundTimeUsecs());
     readyBufferMutex.unlock();
 
     // Log the amount and time received for future data rate calculations.
@@ -28,6 +28,7 @@ This file is part of the QGROUNDCONTROL project
  */
 #include "QsLog.h"
 #include "OpalLink.h"
+#include "QGC.h"
 
 OpalLink::OpalLink() :
     connectState(false),
@@ -264,7 +265,7 @@ void OpalLink::writeBytes(const char *bytes, qint64 length)
 void OpalLink::readBytes()
 {
     receiveDataMutex.lock();
-    emit bytesReceived(this, receiveBuffer->dequeue());
+    emitBytesReceived(receiveBuffer->dequeue(), QGC::groundTimeUsecs());
     receiveDataMutex.unlock();
 
     // Log the amount and time received for future data rate calculations.
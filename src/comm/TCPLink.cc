@@ -176,8 +176,9 @@ void TCPLink::readBytes()
         buffer.resize(byteCount);
 
         _socket->read(buffer.data(), buffer.size());
+        const quint64 ingressTime = QGC::groundTimeUsecs();
 
-        emit bytesReceived(this, buffer);
+        emitBytesReceived(buffer, ingressTime);
 
         // Log the amount and time received for future data rate calculations.
         QMutexLocker dataRateLocker(&dataRateMutex);
@@ -133,8 +133,9 @@ void UDPClientLink::readBytes()
         datagram.resize(_socket.bytesAvailable());
 
         _socket.read(datagram.data(), datagram.size());
+        const quint64 ingressTime = QGC::groundTimeUsecs();
 
-        emit bytesReceived(this, datagram);
+        emitBytesReceived(datagram, ingressTime);
 
         // Log this data reception for this timestep
         QMutexLocker dataRateLocker(&dataRateMutex);
@@ -282,9 +282,10 @@ void UDPLink::readBytes()
         QHostAddress sender;
         quint16 senderPort;
         socket->readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
+        const quint64 ingressTime = QGC::groundTimeUsecs();
 
         // FIXME TODO Check if this method is better than retrieving the data by individual processes
-        emit bytesReceived(this, datagram);
+        emitBytesReceived(datagram, ingressTime);
 
         // Log this data reception for this timestep
         QMutexLocker dataRateLocker(&dataRateMutex);
@@ -32,6 +32,7 @@ This file is part of the APM_PLANNER project
 
 #include "serialconnection.h"
 #include "logging.h"
+#include "QGC.h"
 #include <QtSerialPort/qserialportinfo.h>
 #include <QSettings>
 #include <QStringList>
@@ -381,12 +382,13 @@ void SerialConnection::readyRead()
     if (m_port)
     {
         m_lastTimeoutMessage = QDateTime::currentMSecsSinceEpoch();
+        const quint64 ingressTime = QGC::groundTimeUsecs();
         QByteArray bytes = m_port->readAll();
         while (m_port->waitForReadyRead(10))
         {
             bytes += m_port->readAll();
         }
-        emit bytesReceived(this,bytes);
+        emitBytesReceived(bytes, ingressTime);
     }
 }
 
@@ -33,6 +33,7 @@ This file is part of the QGROUNDCONTROL project
 #include "QGCCore.h"
 #include "configuration.h"
 #include "logging.h"
+#include "Loghandling/LogBatchProcessor.h"
 
 #include <fstream>
 #include <iostream>
@@ -95,6 +96,18 @@ void loggingMessageHandler(QtMsgType type, const QMessageLogContext &context, co
  */
 int main(int argc, char *argv[])
 {
+    // Headless batch log processing - runs without any window, so no display is needed
+    for (int i = 1; i < argc; ++i)
+    {
+        if (qstrcmp(argv[i], "--batch-logs") == 0)
+        {
+            QCoreApplication app(argc, argv);
+            // only warnings and errors - stdout is used for the results
+            QLoggingCategory::setFilterRules(QStringLiteral("apm.general.debug=false\napm.general.info=false"));
+            return LogBatchProcessor::exec(app.arguments());
+        }
+    }
+
 // install the message handler
 #ifdef Q_OS_WIN
     //qInstallMsgHandler( msgHandler );
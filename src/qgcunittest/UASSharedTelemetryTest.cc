@@ -0,0 +1,205 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file UASSharedTelemetryTest.cc
+ * @date 18 Oct 2026
+ * @brief Unit test of the shared memory telemetry export and its reader functions
+ */
+
+#include "UASSharedTelemetryTest.h"
+#include "UASSharedTelemetryExporter.h"
+#include "UASManager.h"
+#include "MAVLinkProtocol.h"
+#include "UAS.h"
+
+using namespace UASSharedTelemetry;
+
+static const int s_TestSystemId = 100;
+
+UASSharedTelemetryTest::UASSharedTelemetryTest() :
+    m_mav(nullptr),
+    m_uas(nullptr),
+    m_reader(QString(s_SegmentKey)),
+    m_segmentPtr(nullptr)
+{
+}
+
+void UASSharedTelemetryTest::init()
+{
+    QVERIFY(UASSharedTelemetryExporter::instance()->start());
+    m_mav = new MAVLinkProtocol();
+    m_uas = new UAS(m_mav, s_TestSystemId);
+    UASManager::instance()->addUAS(m_uas);
+
+    // Attach like an external process. Read write only to fake a writer in progress.
+    QVERIFY(m_reader.attach(QSharedMemory::ReadWrite));
+    QVERIFY(m_reader.size() >= static_cast<int>(sizeof(Segment)));
+    m_segmentPtr = static_cast<Segment *>(m_reader.data());
+}
+
+void UASSharedTelemetryTest::cleanup()
+{
+    m_segmentPtr = nullptr;
+    m_reader.detach();
+    UASSharedTelemetryExporter::instance()->stop();
+
+    UASManager::instance()->removeUAS(m_uas);
+    delete m_uas;
+    m_uas = nullptr;
+    delete m_mav;
+    m_mav = nullptr;
+}
+
+int UASSharedTelemetryTest::slotOf() const
+{
+    VehicleState state;
+    for (int slot = 0; slot < s_MaxVehicles; ++slot)
+    {
+        if (readSnapshot(m_segmentPtr, slot, state) && state.m_systemId == s_TestSystemId)
+        {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+void UASSharedTelemetryTest::isValid_test()
+{
+    QVERIFY(isValid(m_segmentPtr));
+
+    // A layout of another version must be refused
+    Header &header = m_segmentPtr->m_header;
+    header.m_version = s_Version + 1;
+    QVERIFY(!isValid(m_segmentPtr));
+    header.m_version = s_Version;
+    header.m_recordSize = sizeof(LogRecord) + 8;
+    QVERIFY(!isValid(m_segmentPtr));
+    header.m_recordSize = sizeof(LogRecord);
+    QVERIFY(isValid(m_segmentPtr));
+
+    // The mapping stays readable after the writer stopped, but is marked invalid
+    UASSharedTelemetryExporter::instance()->stop();
+    QVERIFY(!isValid(m_segmentPtr));
+}
+
+void UASSharedTelemetryTest::readSnapshot_test()
+{
+    const int slot = slotOf();
+    QVERIFY(slot >= 0);
+
+    emit m_uas->attitudeChanged(m_uas, 0.1, -0.2, 1.5, 0);
+    emit m_uas->globalPositionChanged(m_uas, -35.3632621, 149.1652374, 584.25, 0);
+    emit m_uas->batteryChanged(m_uas, 12.6, 8.5, 76.0, 420);
+
+    VehicleState state;
+    QVERIFY(readSnapshot(m_segmentPtr, slot, state));
+    QCOMPARE(state.m_systemId, static_cast<quint32>(s_TestSystemId));
+    QCOMPARE(state.m_roll, 0.1);
+    QCOMPARE(state.m_pitch, -0.2);
+    QCOMPARE(state.m_yaw, 1.5);
+    QCOMPARE(state.m_latitude, -35.3632621);
+    QCOMPARE(state.m_longitude, 149.1652374);
+    QCOMPARE(state.m_altitude, 584.25);
+    QCOMPARE(state.m_voltage, 12.6);
+    QCOMPARE(state.m_current, 8.5);
+    QCOMPARE(state.m_batteryPercent, 76.0);
+    QCOMPARE(state.m_batterySeconds, 420);
+    QVERIFY(state.m_attitudeUsecs != 0);
+    QVERIFY(state.m_positionUsecs != 0);
+    QVERIFY(state.m_batteryUsecs != 0);
+    QVERIFY(!readSnapshot(m_segmentPtr, s_MaxVehicles, state));
+}
+
+void UASSharedTelemetryTest::seqlock_test()
+{
+    const int slot = slotOf();
+    QVERIFY(slot >= 0);
+    VehicleSnapshot &snapshot = m_segmentPtr->m_vehicles[slot];
+    const quint32 sequence = snapshot.m_sequence.load();
+    QVERIFY(!(sequence & 1u));
+
+    // An odd sequence is a writer in progress - no copy is consistent
+    VehicleState state;
+    snapshot.m_sequence.store(sequence + 1);
+    QVERIFY(!readSnapshot(m_segmentPtr, slot, state, 3));
+    snapshot.m_sequence.store(sequence);
+    QVERIFY(readSnapshot(m_segmentPtr, slot, state, 3));
+
+    // Every update of the writer advances the sequence by two
+    emit m_uas->attitudeChanged(m_uas, 0.3, 0.0, 0.0, 0);
+    QCOMPARE(snapshot.m_sequence.load(), sequence + 2);
+    QVERIFY(readSnapshot(m_segmentPtr, slot, state));
+    QCOMPARE(state.m_roll, 0.3);
+}
+
+void UASSharedTelemetryTest::readLogRecord_test()
+{
+    const quint64 first = logWriteCount(m_segmentPtr);
+    emit m_uas->attitudeChanged(m_uas, 0.1, -0.2, 1.5, 0);
+    emit m_uas->globalPositionChanged(m_uas, -35.3632621, 149.1652374, 584.25, 0);
+    QCOMPARE(logWriteCount(m_segmentPtr), first + 2);
+
+    LogRecord record;
+    QVERIFY(readLogRecord(m_segmentPtr, first, record));
+    QCOMPARE(record.m_systemId, static_cast<quint32>(s_TestSystemId));
+    QCOMPARE(record.m_type, static_cast<quint32>(RecordAttitude));
+    QCOMPARE(record.m_values[0], 0.1);
+    QCOMPARE(record.m_values[1], -0.2);
+    QCOMPARE(record.m_values[2], 1.5);
+    QCOMPARE(record.m_values[3], 0.0);
+
+    QVERIFY(readLogRecord(m_segmentPtr, first + 1, record));
+    QCOMPARE(record.m_type, static_cast<quint32>(RecordGlobalPosition));
+    QCOMPARE(record.m_values[0], -35.3632621);
+    QCOMPARE(record.m_values[1], 149.1652374);
+    QCOMPARE(record.m_values[2], 584.25);
+
+    // Not written yet
+    QVERIFY(!readLogRecord(m_segmentPtr, first + 2, record));
+}
+
+void UASSharedTelemetryTest::logWraparound_test()
+{
+    const quint64 first = logWriteCount(m_segmentPtr);
+    const int count = s_LogCapacity + 10;
+    for (int i = 0; i < count; ++i)
+    {
+        emit m_uas->attitudeChanged(m_uas, static_cast<double>(i), 0.0, 0.0, 0);
+    }
+    const quint64 last = first + count - 1;
+    QCOMPARE(logWriteCount(m_segmentPtr), last + 1);
+
+    // The oldest records share their index with the newest ones and are overwritten
+    LogRecord record;
+    for (quint64 number = first; number < first + 10; ++number)
+    {
+        QVERIFY(!readLogRecord(m_segmentPtr, number, record));
+    }
+
+    // The last s_LogCapacity records are still readable
+    const quint64 oldest = last + 1 - s_LogCapacity;
+    QVERIFY(readLogRecord(m_segmentPtr, oldest, record));
+    QCOMPARE(record.m_values[0], static_cast<double>(oldest - first));
+    QVERIFY(readLogRecord(m_segmentPtr, last, record));
+    QCOMPARE(record.m_values[0], static_cast<double>(count - 1));
+    QVERIFY(!readLogRecord(m_segmentPtr, last + 1, record));
+}
@@ -0,0 +1,77 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file UASSharedTelemetryTest.h
+ * @date 18 Oct 2026
+ * @brief Unit test of the shared memory telemetry export and its reader functions
+ */
+
+#ifndef UASSHAREDTELEMETRYTEST_H
+#define UASSHAREDTELEMETRYTEST_H
+
+#include <QObject>
+#include <QSharedMemory>
+#include <QtTest/QtTest>
+
+#include "UASSharedTelemetry.h"
+#include "AutoTest.h"
+
+class MAVLinkProtocol;
+class UAS;
+
+/**
+ * @brief The UASSharedTelemetryTest class attaches to the segment of the
+ *        UASSharedTelemetryExporter like an external reader and checks the
+ *        reader functions against the values emitted by a vehicle.
+ */
+class UASSharedTelemetryTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    UASSharedTelemetryTest();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void isValid_test();
+    void readSnapshot_test();
+    void seqlock_test();
+    void readLogRecord_test();
+    void logWraparound_test();
+
+private:
+    /**
+     * @brief slotOf returns the snapshot slot used by the test vehicle
+     * @return - the slot or -1 if the vehicle is not exported
+     */
+    int slotOf() const;
+
+    MAVLinkProtocol *m_mav;
+    UAS *m_uas;
+    QSharedMemory m_reader;                         ///< Reader side attachment of the segment
+    UASSharedTelemetry::Segment *m_segmentPtr;      ///< Segment data of the reader
+};
+
+DECLARE_TEST(UASSharedTelemetryTest)
+#endif // UASSHAREDTELEMETRYTEST_H
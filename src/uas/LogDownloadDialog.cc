@@ -24,10 +24,13 @@ This file is part of the APM_PLANNER project
 #include "LogDownloadDialog.h"
 #include "ui_LogDownloadDialog.h"
 #include "UASManager.h"
+#include "LogDownloader.h"
 #include "configuration.h"
 
+#include <QFile>
+#include <QFileInfo>
 #include <QMessageBox>
-#include <math.h>
+#include <QTimer>
 
 #define LDD_COLUMN_ID 0
 #define LDD_COLUMN_TIME 1
@@ -35,9 +38,6 @@ This file is part of the APM_PLANNER project
 #define LDD_COLUMN_CHECKBOX 3
 #define LOG_EXT QString(".bin")
 
-static const uint32_t LOG_PACKET_SIZE = 90;
-static const int LOG_RETRY_TIMER = 700; //msecs
-
 LogDownloadDescriptor::LogDownloadDescriptor(uint logID, uint time_utc,
                                              uint logSize)
 {
@@ -70,17 +70,18 @@ uint LogDownloadDescriptor::logSize()
     return m_logSize;
 }
 
+LogDownloadDialog::DownloadQueue::DownloadQueue() :
+    retried(false),
+    count(0),
+    countMax(0),
+    downloader(NULL)
+{
+}
+
 LogDownloadDialog::LogDownloadDialog(QWidget *parent) :
     QDialog(parent),
     ui(new Ui::LogDownloadDialog),
-    m_uas(NULL),
-    m_downloadSet(NULL),
-    m_downloadFile(NULL),
-    m_downloadID(0),
-    m_downloadLastTimestamp(0),
-    m_downloadOffset(0),
-    m_lastDownloadOffset(0),
-    m_downloadMaxSize(100)
+    m_uas(NULL)
 {
     ui->setupUi(this); 
 
@@ -88,6 +89,7 @@ LogDownloadDialog::LogDownloadDialog(QWidget *parent) :
     ui->getPushButton->setEnabled(false);
 
     connect(UASManager::instance(),SIGNAL(activeUASSet(UASInterface*)),this,SLOT(setActiveUAS(UASInterface*)));
+    connect(UASManager::instance(),SIGNAL(UASDeleted(UASInterface*)),this,SLOT(uasDeleted(UASInterface*)));
 
     connect(ui->donePushButton, SIGNAL(clicked()), this, SLOT(doneButtonClicked()));
     connect(ui->cancelPushButton, SIGNAL(clicked()), this, SLOT(cancelButtonClicked()));
@@ -96,9 +98,6 @@ LogDownloadDialog::LogDownloadDialog(QWidget *parent) :
     connect(ui->erasePushButton, SIGNAL(clicked()), this, SLOT(eraseAllLogs()));
     connect(ui->checkAllBox, SIGNAL(clicked()), this, SLOT(checkAll()));
 
-    // configure retransimission timer.
-    connect(&m_timer, SIGNAL(timeout()), this, SLOT(processDownloadedLogData()));
-
     QStringList headerList;
     headerList << tr("ID") << tr("Time") << tr("Size") << tr("Download?");
 
@@ -111,32 +110,19 @@ LogDownloadDialog::LogDownloadDialog(QWidget *parent) :
     setActiveUAS(UASManager::instance()->getActiveUAS());
 }
 
-void LogDownloadDialog::resetDownload()
+void LogDownloadDialog::cancelDownloads()
 {
-    if (m_downloadSet){
-        delete m_downloadSet;
-        m_downloadSet = NULL;
+    QMap<int, DownloadQueue>::iterator iter = m_downloads.begin();
+    for(; iter != m_downloads.end(); ++iter){
+        iter->logs.clear();
+        if (iter->downloader)
+            iter->downloader->cancel();
     }
-
-    if (m_downloadFile){
-        m_downloadFile->close();
-        m_downloadFile->deleteLater();
-        m_downloadFile = NULL;
-    }
-
-    m_downloadID = 0;
-    m_downloadFilename.clear();
-    m_downloadStart = QElapsedTimer();
-    m_downloadLastTimestamp = 0;
-    m_downloadOffset = 0;
 }
 
 void LogDownloadDialog::cancelButtonClicked()
 {
-    if(m_uas){
-        m_uas->logRequestEnd();
-    }
-    resetDownload();
+    cancelDownloads();
     accept();
 }
 
@@ -147,7 +133,9 @@ void LogDownloadDialog::doneButtonClicked()
 
 LogDownloadDialog::~LogDownloadDialog()
 {
+    cancelDownloads();
     removeConnections(m_uas);
+    qDeleteAll(m_logEntriesList);
     delete ui;
 }
 
@@ -164,6 +152,29 @@ void LogDownloadDialog::setActiveUAS(UASInterface *uas)
     setWindowTitle(tr("Log Download from MAV%1").arg(m_uas->getUASID()));
     ui->refreshPushButton->setEnabled(true);
     makeConnections(uas);
+
+    // Downloads of other vehicles keep running, show the state of this one
+    QMap<int, DownloadQueue>::const_iterator iter = m_downloads.constFind(m_uas->getUASID());
+    if (iter == m_downloads.constEnd() || iter->downloader == NULL || !iter->downloader->isActive()){
+        ui->progressBar->hide();
+        ui->statusLabel->hide();
+    }
+}
+
+void LogDownloadDialog::uasDeleted(UASInterface *uas)
+{
+    QMap<int, DownloadQueue>::iterator iter = m_downloads.find(uas->getUASID());
+    if (iter != m_downloads.end()){
+        if (iter->downloader){
+            iter->downloader->cancel();
+            iter->downloader->deleteLater();
+        }
+        m_downloads.erase(iter);
+    }
+    if (uas == m_uas){
+        removeConnections(m_uas);
+        m_uas = NULL;
+    }
 }
 
 void LogDownloadDialog::makeConnections(UASInterface *uas)
@@ -171,8 +182,6 @@ void LogDownloadDialog::makeConnections(UASInterface *uas)
     Q_UNUSED(uas);
     connect(m_uas, SIGNAL(logEntry(int,uint32_t,uint32_t,uint16_t,uint16_t,uint16_t)),
             this, SLOT(logEntry(int,uint32_t,uint32_t,uint16_t,uint16_t,uint16_t)));
-    connect(m_uas, SIGNAL(logData(uint32_t,uint32_t,uint16_t,uint8_t,const char*)),
-            this, SLOT(logData(uint32_t,uint32_t,uint16_t,uint8_t,const char*)));
 }
 
 void LogDownloadDialog::removeConnections(UASInterface *uas)
@@ -180,8 +189,6 @@ void LogDownloadDialog::removeConnections(UASInterface *uas)
     Q_UNUSED(uas);
     disconnect(m_uas, SIGNAL(logEntry(int,uint32_t,uint32_t,uint16_t,uint16_t,uint16_t)),
             this, SLOT(logEntry(int,uint32_t,uint32_t,uint16_t,uint16_t,uint16_t)));
-    disconnect(m_uas, SIGNAL(logData(uint32_t,uint32_t,uint16_t,uint8_t,const char*)),
-            this, SLOT(logData(uint32_t,uint32_t,uint16_t,uint8_t,const char*)));
     ui->refreshPushButton->setEnabled(false);
     ui->getPushButton->setEnabled(false);
 }
@@ -191,6 +198,7 @@ void LogDownloadDialog::refreshList()
     QLOG_DEBUG() << "Start Log List Download";
     if (m_uas){
         ui->tableWidget->setRowCount(0);
+        qDeleteAll(m_logEntriesList);
         m_logEntriesList.clear();
         m_uas->logRequestList(0,0xffff); // Currently list all available logs
     }
@@ -199,21 +207,37 @@ void LogDownloadDialog::refreshList()
 void LogDownloadDialog::getSelectedLogs()
 {
     QLOG_DEBUG() << "Start Retrieving selected logs";
-    QTableWidget* table = ui->tableWidget;
-    m_fileSaveList.clear();
+    if (m_uas == NULL)
+        return;
+
+    DownloadQueue &queue = m_downloads[m_uas->getUASID()];
+    if (queue.downloader && queue.downloader->isActive()){
+        QLOG_DEBUG() << "Download of MAV" << m_uas->getUASID() << "already running";
+        return;
+    }
 
+    QTableWidget* table = ui->tableWidget;
+    queue.logs.clear();
     for(int rowCount = 0; rowCount < table->rowCount(); ++rowCount){
         QTableWidgetItem* paramCheck= table->item(rowCount, LDD_COLUMN_CHECKBOX);
 
         if (paramCheck->checkState() == Qt::Checked){
-            m_fileSaveList.append(m_logEntriesList[rowCount]);
-            QLOG_DEBUG() << "Adding id:" << m_fileSaveList.last()->logID() << " "
-                         << m_fileSaveList.last()->logFilename()  << " to download list";
+            queue.logs.append(*m_logEntriesList[rowCount]);
+            QLOG_DEBUG() << "Adding id:" << queue.logs.last().logID() << " "
+                         << queue.logs.last().logFilename()  << " to download list";
         }
     }
-    m_downloadCount = 1;//st
-    m_downloadCountMax = m_fileSaveList.count();
-    startNextDownloadRequest();
+    queue.count = 0;
+    queue.countMax = queue.logs.count();
+
+    if (queue.downloader == NULL){
+        queue.downloader = new LogDownloader(m_uas, this);
+        connect(queue.downloader, SIGNAL(progress(uint,quint64,quint64,double)),
+                this, SLOT(downloadProgress(uint,quint64,quint64,double)));
+        connect(queue.downloader, SIGNAL(finished(uint,QString,bool)),
+                this, SLOT(downloadFinished(uint,QString,bool)));
+    }
+    startNextDownload(m_uas->getUASID());
 }
 
 void LogDownloadDialog::eraseAllLogs()
@@ -229,39 +253,54 @@ void LogDownloadDialog::eraseAllLogs()
    }
 }
 
-void LogDownloadDialog::startNextDownloadRequest()
+void LogDownloadDialog::startNextDownload(int uasId)
 {
-    QTimer::singleShot(500, this, SLOT(triggerNextDownloadRequest()));
+    QMap<int, DownloadQueue>::iterator iter = m_downloads.find(uasId);
+    if (iter == m_downloads.end())
+        return;
+
+    DownloadQueue &queue = *iter;
+    while (!queue.logs.isEmpty()){
+        QLOG_DEBUG() << "Start next log download of MAV" << uasId;
+        queue.current = queue.logs.takeFirst();
+        queue.retried = false;
+        queue.count++;
+        if (issueDownloadRequest(queue))
+            return;
+    }
+
+    if (m_uas && m_uas->getUASID() == uasId){
+        ui->statusLabel->setText("Finished");
+        QTimer::singleShot(500, ui->progressBar, SLOT(hide()));
+        QTimer::singleShot(500, ui->statusLabel, SLOT(hide()));
+    }
 }
 
-void LogDownloadDialog::triggerNextDownloadRequest()
+bool LogDownloadDialog::issueDownloadRequest(DownloadQueue &queue)
 {
-    QLOG_DEBUG() << "Start next log download";
-    if (m_uas && !m_fileSaveList.isEmpty()){
-        resetDownload();
-        LogDownloadDescriptor *descriptor = m_fileSaveList.takeFirst();
-        m_downloadID = descriptor->logID();
-        m_downloadFilename = descriptor->logFilename();
-        m_downloadMaxSize = descriptor->logSize();
-        issueDownloadRequest();
+    const QString filename = uniqueLogFilename(QGC::logDirectory() + "/" + queue.current.logFilename());
+    if (!queue.downloader->start(queue.current.logID(), queue.current.logSize(), filename)){
+        QLOG_ERROR() << "failed to open file to save log:" << filename;
+        return false;
     }
+    QLOG_INFO() << "Log file ready for writing:" << filename << " size:" << queue.current.logSize();
+    if (queue.downloader->isActive())
+        showStatus(queue, 0, queue.current.logSize(), 0.0);
+    return true;
 }
 
-void LogDownloadDialog::issueDownloadRequest()
+QString LogDownloadDialog::uniqueLogFilename(const QString &filename) const
 {
-    QCoreApplication::processEvents(QEventLoop::AllEvents, 2000);
-        // Open a file for the log to be downloaded
-    m_downloadFile = new QFile(QGC::logDirectory() +"/" + m_downloadFilename);
-
     // Append a number to the end if the filename already exists
-    if(m_downloadFile->exists()){
+    QString uniqueName = filename;
+    if(QFile::exists(uniqueName)){
         uint num_dups = 0;
-        QStringList filename_spl = m_downloadFile->fileName().split('.');
-        if (filename_spl.size()>0)
+        QStringList filename_spl = filename.split('.');
+        if (filename_spl.size()>1)
         {
-            while(m_downloadFile->exists()){
+            while(QFile::exists(uniqueName)){
                 num_dups ++;
-                m_downloadFile->setFileName(filename_spl[0] + '_' + QString::number(num_dups) + '.' + filename_spl[1]);
+                uniqueName = filename_spl[0] + '_' + QString::number(num_dups) + '.' + filename_spl[1];
             }
         }
         else
@@ -269,29 +308,68 @@ void LogDownloadDialog::issueDownloadRequest()
             // Filename does not have an extension, avoid a crash and append a number on the end
             // This can not (currently) happen at runtime unless either a define goes away, or the code is otherwise broken elsewhere, but better safe with an error
             // in the log than sorry with a crash report.
-            QLOG_ERROR() << "Download filename is not properly formatted!" << m_downloadFile->fileName();
+            QLOG_ERROR() << "Download filename is not properly formatted!" << filename;
             QLOG_ERROR() << "The above should NEVER happen, please file a bug report with this log!";
-            QString filename_orig = m_downloadFile->fileName();
-            while(m_downloadFile->exists()){
+            while(QFile::exists(uniqueName)){
                 num_dups ++;
-                m_downloadFile->setFileName(filename_orig + '_' + QString::number(num_dups));
+                uniqueName = filename + '_' + QString::number(num_dups);
             }
         }
     }
-    if(m_downloadFile && m_downloadFile->open(QIODevice::WriteOnly)){
-        QLOG_INFO() << "Log file ready for writing:" << m_downloadFilename << " size:" << m_downloadMaxSize;
-        Q_ASSERT(m_downloadOffset == 0);
-        m_lastDownloadOffset = 0;
-        m_uas->logRequestData(m_downloadID, m_downloadOffset, LOG_PACKET_SIZE);
-        updateProgress();
-        m_downloadStart.start();
-        m_timer.start(LOG_RETRY_TIMER);
-        m_downloadSet = new QSet<uint>();
-    } else {
-        QLOG_ERROR() << "failed to open file to save log:" << m_downloadFilename;
+    return uniqueName;
+}
+
+void LogDownloadDialog::downloadProgress(uint logId, quint64 received, quint64 size, double bytesPerSecond)
+{
+    Q_UNUSED(logId);
+    LogDownloader *downloader = qobject_cast<LogDownloader*>(sender());
+    if (downloader == NULL || m_uas == NULL || downloader->uas() != m_uas)
+        return;
+
+    QMap<int, DownloadQueue>::const_iterator iter = m_downloads.constFind(m_uas->getUASID());
+    if (iter != m_downloads.constEnd())
+        showStatus(*iter, received, size, bytesPerSecond);
+}
+
+void LogDownloadDialog::downloadFinished(uint logId, const QString &fileName, bool success)
+{
+    LogDownloader *downloader = qobject_cast<LogDownloader*>(sender());
+    if (downloader == NULL || downloader->uas() == NULL)
+        return;
+
+    const int uasId = downloader->uas()->getUASID();
+    QMap<int, DownloadQueue>::iterator iter = m_downloads.find(uasId);
+    if (iter == m_downloads.end())
+        return;
+
+    if (!success){
+        QLOG_ERROR() << "Download of log" << logId << "from MAV" << uasId << "failed";
+        if (m_uas && m_uas->getUASID() == uasId){
+            ui->statusLabel->setText(tr("Download of log %1 failed").arg(logId));
+        }
+    } else if (QFileInfo(fileName).size() == 0 && iter->current.logSize() > 0 && !iter->retried) {
+        // The vehicle sometimes answers the first request with no data, retry once
+        QLOG_DEBUG() << "File Size is zero, retry";
+        QFile::remove(fileName);
+        iter->retried = true;
+        if (issueDownloadRequest(*iter))
+            return;
     }
+    startNextDownload(uasId);
 }
 
+void LogDownloadDialog::showStatus(const DownloadQueue &queue, quint64 received, quint64 size, double bytesPerSecond)
+{
+    QString status = QString("Downloading %1/%2").arg(queue.count).arg(queue.countMax);
+    if (bytesPerSecond > 0.0)
+        status += QString(" (%1 kB/s)").arg(bytesPerSecond / 1000.0, 0, 'f', 1);
+    ui->statusLabel->setText(status);
+    ui->statusLabel->show();
+    // The progress bar is int based, scale to kB
+    ui->progressBar->setMaximum(static_cast<int>(size / 1024));
+    ui->progressBar->setValue(static_cast<int>(received / 1024));
+    ui->progressBar->show();
+}
 
 void LogDownloadDialog::logEntry(int uasId, uint32_t time_utc, uint32_t size, uint16_t id,
                                  uint16_t num_logs, uint16_t last_log_num)
@@ -333,153 +411,6 @@ void LogDownloadDialog::logEntry(int uasId, uint32_t time_utc, uint32_t size, ui
         ui->getPushButton->setEnabled(true);
 }
 
-void LogDownloadDialog::logData(uint32_t uasId, uint32_t ofs, uint16_t id,
-                                     uint8_t count, const char *data)
-{
-    Q_UNUSED(id);
-//#define SIMULATE_PACKET_LOSS
-#ifdef SIMULATE_PACKET_LOSS
-    QLOG_DEBUG() << "logData ofs:" << ofs << " id:" << id << " count:" << count
-                 /*<< " data:" << data*/;
-#endif
-    if (m_uas == NULL || m_downloadSet == NULL)
-        return;
-    if (m_uas->getUASID() != static_cast<int>(uasId))
-        return;
-    if(m_downloadFile == NULL){
-        QLOG_ERROR() << "No file open to save log info";
-        return;
-    }
-#ifdef SIMULATE_PACKET_LOSS
-    //Simulate packet loss for testing in debug mode
-    if ((rand() % 100) < 20){
-        QLOG_DEBUG() << "Dropping Packet logId=" << id << " packetId=" << (int)ofs/90 << " ofs=" << ofs;
-        return;
-    }
-#endif
-    if (ofs != m_downloadOffset){
-        QLOG_DEBUG() << "seek to " << ofs;
-        m_downloadFile->seek(ofs);
-        m_downloadOffset = ofs;
-        updateProgress();
-    }
-    if (count != 0){
-        int bytesWritten = m_downloadFile->write(data, count);
-        if ((bytesWritten == -1)||(bytesWritten != count)){
-            QLOG_ERROR() << "Log File write bytesWritten:" << bytesWritten << "out of: count=" << count;
-//            QMessageBox::critical(this,tr("Corrupt File")
-//                                  ,tr("Error saving %1.\n file save is corupt."),QMessageBox::Ok);
-            // [TODO] Abort.
-        }
-        m_downloadFile->flush();
-        m_downloadSet->insert(static_cast<uint>(floor(ofs / LOG_PACKET_SIZE)));
-        m_downloadOffset += count;
-        updateProgress();
-    }
-    m_downloadLastTimestamp = QDateTime::currentDateTime().toMSecsSinceEpoch();
-    if ( count==0 || (count<LOG_PACKET_SIZE
-                      && (static_cast<uint>(m_downloadSet->count()) == 1+(static_cast<uint>( floor(ofs / LOG_PACKET_SIZE) ))))){
-        double dt = m_downloadStart.elapsed()/1000.0;
-        double speed = (static_cast<double>(m_downloadFile->size())/dt)/1000.0;
-        QLOG_INFO() << "Finished downloading "<< m_downloadFilename
-                    << "(" << dt << " seconds, "<< speed <<"kbyte/sec)";
-        m_downloadFile->flush();
-        m_timer.stop();
-        updateProgress();
-        m_uas->logRequestEnd();
-        QCoreApplication::processEvents();
-
-        if (m_downloadFile->size() == 0) {
-            // If the file size is zero, retry
-            QLOG_DEBUG() << "File Size is zero, retry";
-            m_downloadOffset = 0;
-            m_lastDownloadOffset = 0;
-            delete m_downloadSet;
-            m_downloadSet = new QSet<uint>();
-            m_timer.start(LOG_RETRY_TIMER);
-            m_downloadStart.start();
-            m_downloadFile->close();
-            delete m_downloadFile;
-            m_downloadFile = NULL;
-            issueDownloadRequest();
-            return;
-        }
-        m_downloadFile->close();
-        QCoreApplication::processEvents();
-        ui->progressBar->setValue(m_downloadMaxSize);
-        if (!(m_downloadCount == m_downloadCountMax)){
-            m_downloadCount++;
-            startNextDownloadRequest();
-        } else {
-            ui->statusLabel->setText("Finished");
-            QTimer::singleShot(500, ui->progressBar, SLOT(hide()));
-            QTimer::singleShot(500, ui->statusLabel, SLOT(hide()));
-            resetDownload();
-        }
-    }
-    QCoreApplication::processEvents();
-}
-
-void LogDownloadDialog::processDownloadedLogData()
-{
-    // Process incoming log data and trigger next request for more
-    if (m_downloadSet==NULL || m_downloadSet->size() == 0)
-        return;
-
-    uint highest = 0;
-
-    QSet<uint>::const_iterator iter;
-    iter = m_downloadSet->constBegin();
-    while (iter != m_downloadSet->constEnd()){
-        uint value = *iter;
-        if (value > highest)
-            highest = value;
-        ++iter;
-    }
-
-    QList<uint> diff;
-    for( uint count = 0; count < highest; count++){
-        if(!m_downloadSet->contains(count))
-            diff.append(count);
-    }
-    QLOG_DEBUG() << "highest:"<< highest << "Diff size:" << diff.size();
-    if(diff.size() == 0){
-        m_uas->logRequestData(m_downloadID, (highest+1)*LOG_PACKET_SIZE, 0xFFFFFFFF);
-        m_timer.start(LOG_RETRY_TIMER);
-
-    } else {
-        int num_requests = 0;
-        while (num_requests < 20){
-            uint start = diff.takeFirst();
-            uint end = start;
-            while(diff.contains(end+1)){
-                end+=1;
-                diff.removeAt(end);
-            }
-            ui->statusLabel->setText(tr("Retransmitting %1").arg(start));
-            m_uas->logRequestData(m_downloadID, (start*LOG_PACKET_SIZE), (end+1-start)*LOG_PACKET_SIZE);
-            num_requests +=1;
-            if(diff.size() == 0)
-                break;
-            QCoreApplication::processEvents();
-        }
-    }
-    QCoreApplication::processEvents();
-}
-
-void LogDownloadDialog::updateProgress()
-{
-    if ( m_downloadOffset > m_lastDownloadOffset + 720){
-        m_lastDownloadOffset = m_downloadOffset;
-        QString status =  QString("Downloading %1/%2").arg(m_downloadCount).arg(m_downloadCountMax);
-        ui->statusLabel->setText(status);
-        ui->statusLabel->show();
-        ui->progressBar->setMaximum(m_downloadMaxSize);
-        ui->progressBar->setValue(m_downloadOffset);
-        ui->progressBar->show();
-    }
-}
-
 void LogDownloadDialog::checkAll()
 {
     QLOG_DEBUG() << " check uncheck all parameters";
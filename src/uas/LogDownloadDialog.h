@@ -25,8 +25,9 @@ This file is part of the APM_PLANNER project
 
 #include "UASInterface.h"
 #include <QDialog>
-#include <QElapsedTimer>
-#include <QFile>
+#include <QMap>
+
+class LogDownloader;
 
 namespace Ui {
 class LogDownloadDialog;
@@ -35,8 +36,8 @@ class LogDownloadDialog;
 class LogDownloadDescriptor
 {
 public:
-    explicit LogDownloadDescriptor(uint logID, uint time_utc,
-                                   uint size);
+    explicit LogDownloadDescriptor(uint logID = 0, uint time_utc = 0,
+                                   uint size = 0);
     const QString &logFilename();
     const QDateTime &logTimeUTC();
     uint logID();
@@ -59,49 +60,50 @@ public:
 
 public slots:
     void setActiveUAS(UASInterface* uas);
+    void uasDeleted(UASInterface* uas);
 
     void refreshList();
     void getSelectedLogs();
 
     // Log Download Signals
     void logEntry(int uasId, uint32_t time_utc, uint32_t size, uint16_t id, uint16_t num_logs, uint16_t last_log_num);
-    void logData(uint32_t uasId, uint32_t ofs, uint16_t id, uint8_t count, const char* data);
 
 private slots:
     void checkAll();
-    void processDownloadedLogData();
     void doneButtonClicked();
     void cancelButtonClicked();
-    void triggerNextDownloadRequest();
     void eraseAllLogs();
+    void downloadProgress(uint logId, quint64 received, quint64 size, double bytesPerSecond);
+    void downloadFinished(uint logId, const QString &fileName, bool success);
 
 private:
+    // Selected logs of one vehicle. Each vehicle downloads its logs back to back,
+    // different vehicles download concurrently.
+    struct DownloadQueue {
+        QList<LogDownloadDescriptor> logs;  // logs still to download
+        LogDownloadDescriptor current;      // log in progress
+        bool retried;                       // current log was requested again as it came back empty
+        int count;
+        int countMax;
+        LogDownloader *downloader;
+
+        DownloadQueue();
+    };
+
     void removeConnections(UASInterface* uas);
     void makeConnections(UASInterface* uas);
-    void startNextDownloadRequest();
-    void issueDownloadRequest();
+    void startNextDownload(int uasId);
+    bool issueDownloadRequest(DownloadQueue &queue);
+    QString uniqueLogFilename(const QString &filename) const;
 
-    void updateProgress();
-    void resetDownload();
+    void showStatus(const DownloadQueue &queue, quint64 received, quint64 size, double bytesPerSecond);
+    void cancelDownloads();
 
 private:
     Ui::LogDownloadDialog *ui;
     UASInterface *m_uas;
     QList<LogDownloadDescriptor*> m_logEntriesList; // id & filename to save data to.
-    QList<LogDownloadDescriptor*> m_fileSaveList; // id & filename to save data to.
-
-    QSet<uint> *m_downloadSet;
-    QFile* m_downloadFile;
-    uint m_downloadID;
-    QString m_downloadFilename;
-    QElapsedTimer m_downloadStart;
-    uint m_downloadLastTimestamp;
-    uint m_downloadOffset;
-    uint m_lastDownloadOffset;
-    uint m_downloadMaxSize;
-    int m_downloadCount;
-    int m_downloadCountMax;
-    QTimer m_timer;
+    QMap<int, DownloadQueue> m_downloads;           // download queue per vehicle id
 };
 
 #endif // LOGDOWNLOADDIALOG_H
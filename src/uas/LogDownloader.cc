@@ -0,0 +1,381 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogDownloader.cc
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the DataFlash log download engine
+ */
+
+#include "LogDownloader.h"
+#include "UASInterface.h"
+#include "logging.h"
+
+#include <limits>
+
+constexpr quint32 LogDownloader::s_BlockSize;
+
+LogDownloader::LogDownloader(UASInterface *uas, QObject *parent) :
+    QObject(parent),
+    m_uasPtr(uas),
+    m_logId(0),
+    m_logSize(0),
+    m_receivedBytes(0),
+    m_receivedBlocks(0),
+    m_firstMissing(0),
+    m_requestEnd(0),
+    m_writeBufferOffset(0),
+    m_writeFailed(false),
+    m_rateBytes(0),
+    m_bytesPerSecond(0.0),
+    m_stallCount(0),
+    m_active(false)
+{
+    m_checkTimer.setInterval(s_CheckIntervalMs);
+    connect(&m_checkTimer, SIGNAL(timeout()), this, SLOT(checkProgress()));
+}
+
+LogDownloader::~LogDownloader()
+{
+    cancel();
+}
+
+bool LogDownloader::start(uint logId, quint32 logSize, const QString &fileName)
+{
+    cancel();
+    if (!m_uasPtr)
+    {
+        return false;
+    }
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        QLOG_ERROR() << "LogDownloader: Cannot open" << fileName << m_file.errorString();
+        return false;
+    }
+
+    m_logId = logId;
+    m_logSize = logSize;
+    m_receivedBytes = 0;
+    const quint32 blockCount = (logSize + s_BlockSize - 1) / s_BlockSize;
+    m_blocks = QBitArray(static_cast<int>(blockCount));
+    m_receivedBlocks = 0;
+    m_firstMissing = 0;
+    m_requestEnd = blockCount;
+    m_writeBuffer.clear();
+    m_writeBuffer.reserve(s_WriteBufferSize + static_cast<int>(s_BlockSize));
+    m_writeBufferOffset = 0;
+    m_writeFailed = false;
+    m_rateBytes = 0;
+    m_bytesPerSecond = 0.0;
+    m_stallCount = 0;
+    m_active = true;
+
+    connect(m_uasPtr, SIGNAL(logData(uint32_t,uint32_t,uint16_t,uint8_t,const char*)),
+            this, SLOT(logData(uint32_t,uint32_t,uint16_t,uint8_t,const char*)));
+
+    QLOG_INFO() << "LogDownloader: Start download of log" << logId << "size" << logSize << "to" << fileName;
+    m_downloadTimer.start();
+    m_lastDataTimer.start();
+    m_rateTimer.start();
+    m_checkTimer.start();
+
+    if (blockCount == 0)
+    {
+        finish(true);
+        return true;
+    }
+    // Ask for everything, the vehicle streams until the end of the log
+    m_uasPtr->logRequestData(static_cast<uint16_t>(logId), 0, std::numeric_limits<uint32_t>::max());
+    return true;
+}
+
+void LogDownloader::cancel()
+{
+    if (!m_active)
+    {
+        return;
+    }
+    QLOG_INFO() << "LogDownloader: Download of log" << m_logId << "canceled";
+    m_active = false;
+    m_checkTimer.stop();
+    flushWriteBuffer();
+    m_file.close();
+    if (m_uasPtr)
+    {
+        disconnect(m_uasPtr, SIGNAL(logData(uint32_t,uint32_t,uint16_t,uint8_t,const char*)),
+                   this, SLOT(logData(uint32_t,uint32_t,uint16_t,uint8_t,const char*)));
+        m_uasPtr->logRequestEnd();
+    }
+}
+
+bool LogDownloader::isActive() const
+{
+    return m_active;
+}
+
+uint LogDownloader::logId() const
+{
+    return m_logId;
+}
+
+QString LogDownloader::fileName() const
+{
+    return m_file.fileName();
+}
+
+UASInterface *LogDownloader::uas() const
+{
+    return m_uasPtr;
+}
+
+void LogDownloader::logData(uint32_t uasId, uint32_t ofs, uint16_t id, uint8_t count, const char *data)
+{
+    Q_UNUSED(uasId)
+    if (!m_active || id != m_logId)
+    {
+        return;
+    }
+    m_lastDataTimer.restart();
+    m_stallCount = 0;
+
+    if (ofs % s_BlockSize != 0 || count > s_BlockSize)
+    {
+        QLOG_WARN() << "LogDownloader: Ignoring unaligned data at offset" << ofs << "count" << count;
+        return;
+    }
+
+    // A short packet marks the end of the log. Vehicles may report a larger size
+    // in LOG_ENTRY than they actually have.
+    if (count < s_BlockSize)
+    {
+        setLogSize(static_cast<quint64>(ofs) + count);
+        if (!m_active)
+        {
+            return;
+        }
+    }
+
+    const quint32 block = ofs / s_BlockSize;
+    if (block >= static_cast<quint32>(m_blocks.size()) || m_blocks.testBit(static_cast<int>(block)))
+    {
+        // Beyond the end or a duplicate of a retransmission
+        return;
+    }
+
+    m_blocks.setBit(static_cast<int>(block));
+    ++m_receivedBlocks;
+    m_receivedBytes += count;
+    m_rateBytes += count;
+    while (m_firstMissing < static_cast<quint32>(m_blocks.size()) && m_blocks.testBit(static_cast<int>(m_firstMissing)))
+    {
+        ++m_firstMissing;
+    }
+
+    if (!writeData(ofs, data, count))
+    {
+        finish(false);
+        return;
+    }
+
+    if (m_receivedBlocks == static_cast<quint32>(m_blocks.size()))
+    {
+        finish(true);
+    }
+    else if (block + 1 >= m_requestEnd)
+    {
+        // End of the outstanding request reached - no need to wait for a timeout
+        requestNextWindow();
+    }
+}
+
+void LogDownloader::checkProgress()
+{
+    if (!m_active)
+    {
+        return;
+    }
+
+    const qint64 rateElapsed = m_rateTimer.elapsed();
+    if (rateElapsed >= 500)
+    {
+        const double rate = static_cast<double>(m_rateBytes) * 1000.0 / static_cast<double>(rateElapsed);
+        m_bytesPerSecond = m_bytesPerSecond > 0.0 ? 0.7 * m_bytesPerSecond + 0.3 * rate : rate;
+        m_rateBytes = 0;
+        m_rateTimer.restart();
+        emit progress(m_logId, m_receivedBytes, m_logSize, m_bytesPerSecond);
+    }
+
+    if (m_lastDataTimer.elapsed() >= s_StallTimeoutMs)
+    {
+        if (++m_stallCount > s_MaxStalls)
+        {
+            QLOG_ERROR() << "LogDownloader: No data for log" << m_logId << "- giving up";
+            finish(false);
+            return;
+        }
+        m_lastDataTimer.restart();
+        requestNextWindow();
+    }
+}
+
+void LogDownloader::requestNextWindow()
+{
+    const quint32 blockCount = static_cast<quint32>(m_blocks.size());
+    if (!m_uasPtr || m_firstMissing >= blockCount)
+    {
+        return;
+    }
+
+    // The window holds the blocks which arrive within s_WindowSeconds. Spanning
+    // some received blocks is cheaper than a request per gap.
+    quint32 windowBlocks = static_cast<quint32>(m_bytesPerSecond * s_WindowSeconds / s_BlockSize);
+    windowBlocks = qMax(windowBlocks, s_MinWindowBlocks);
+    const quint32 windowEnd = qMin(blockCount, m_firstMissing + windowBlocks);
+
+    quint32 lastMissing = m_firstMissing;
+    for (quint32 block = m_firstMissing; block < windowEnd; ++block)
+    {
+        if (!m_blocks.testBit(static_cast<int>(block)))
+        {
+            lastMissing = block;
+        }
+    }
+    // A contiguous missing tail (the stream broke off) is requested as one
+    while (lastMissing + 1 < blockCount && !m_blocks.testBit(static_cast<int>(lastMissing + 1)))
+    {
+        ++lastMissing;
+    }
+
+    m_requestEnd = lastMissing + 1;
+    const quint32 offset = m_firstMissing * s_BlockSize;
+    const quint64 end = qMin(static_cast<quint64>(m_requestEnd) * s_BlockSize, m_logSize);
+    QLOG_DEBUG() << "LogDownloader: Request log" << m_logId << "offset" << offset << "count" << end - offset;
+    m_uasPtr->logRequestData(static_cast<uint16_t>(m_logId), offset, static_cast<uint32_t>(end - offset));
+}
+
+void LogDownloader::setLogSize(quint64 size)
+{
+    if (size >= m_logSize)
+    {
+        return;
+    }
+    QLOG_DEBUG() << "LogDownloader: Log" << m_logId << "ends at" << size << "instead of" << m_logSize;
+    m_logSize = size;
+    const int blockCount = static_cast<int>((size + s_BlockSize - 1) / s_BlockSize);
+    for (int block = blockCount; block < m_blocks.size(); ++block)
+    {
+        if (m_blocks.testBit(block))
+        {
+            --m_receivedBlocks;
+            m_receivedBytes -= qMin(m_receivedBytes, static_cast<quint64>(s_BlockSize));
+        }
+    }
+    m_receivedBytes = qMin(m_receivedBytes, size);
+    m_blocks.resize(blockCount);
+    m_firstMissing = qMin(m_firstMissing, static_cast<quint32>(blockCount));
+    m_requestEnd = qMin(m_requestEnd, static_cast<quint32>(blockCount));
+
+    if (m_active && m_receivedBlocks == static_cast<quint32>(blockCount))
+    {
+        finish(true);
+    }
+}
+
+bool LogDownloader::writeData(quint64 offset, const char *data, int count)
+{
+    if (offset != m_writeBufferOffset + static_cast<quint64>(m_writeBuffer.size()))
+    {
+        // Not contiguous (a retransmitted block), write what we have and start over
+        if (!flushWriteBuffer())
+        {
+            return false;
+        }
+        m_writeBufferOffset = offset;
+    }
+    m_writeBuffer.append(data, count);
+    if (m_writeBuffer.size() >= s_WriteBufferSize)
+    {
+        return flushWriteBuffer();
+    }
+    return true;
+}
+
+bool LogDownloader::flushWriteBuffer()
+{
+    if (m_writeBuffer.isEmpty())
+    {
+        return !m_writeFailed;
+    }
+    if (!m_file.seek(static_cast<qint64>(m_writeBufferOffset)) ||
+        m_file.write(m_writeBuffer) != m_writeBuffer.size())
+    {
+        QLOG_ERROR() << "LogDownloader: Write to" << m_file.fileName() << "failed:" << m_file.errorString();
+        m_writeFailed = true;
+    }
+    m_writeBufferOffset += static_cast<quint64>(m_writeBuffer.size());
+    m_writeBuffer.clear();
+    return !m_writeFailed;
+}
+
+void LogDownloader::finish(bool success)
+{
+    if (!m_active)
+    {
+        return;
+    }
+    m_active = false;
+    m_checkTimer.stop();
+    if (m_uasPtr)
+    {
+        disconnect(m_uasPtr, SIGNAL(logData(uint32_t,uint32_t,uint16_t,uint8_t,const char*)),
+                   this, SLOT(logData(uint32_t,uint32_t,uint16_t,uint8_t,const char*)));
+        m_uasPtr->logRequestEnd();
+    }
+
+    success = flushWriteBuffer() && success;
+    // Drop data of a log which was larger in LOG_ENTRY than it really is
+    if (success && m_file.size() > static_cast<qint64>(m_logSize))
+    {
+        m_file.resize(static_cast<qint64>(m_logSize));
+    }
+    m_file.close();
+
+    const double seconds = m_downloadTimer.elapsed() / 1000.0;
+    QLOG_INFO() << "LogDownloader: Download of log" << m_logId << (success ? "complete" : "failed")
+                << m_receivedBytes << "bytes in" << seconds << "seconds";
+
+    emit progress(m_logId, m_receivedBytes, m_logSize,
+                  seconds > 0.0 ? static_cast<double>(m_receivedBytes) / seconds : 0.0);
+
+    // finish() is called from within logData(). Receivers may start the next
+    // download right away, which must not happen before logData() returned.
+    const uint logId = m_logId;
+    const QString fileName = m_file.fileName();
+    QTimer::singleShot(0, this, [this, logId, fileName, success]() {
+        // A download started in between replaces this one
+        if (!m_active)
+        {
+            emit finished(logId, fileName, success);
+        }
+    });
+}
@@ -0,0 +1,148 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogDownloader.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the DataFlash log download engine
+ */
+
+#ifndef LOGDOWNLOADER_H
+#define LOGDOWNLOADER_H
+
+#include <QObject>
+#include <QBitArray>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QPointer>
+#include <QTimer>
+
+class UASInterface;
+
+/**
+ * @brief The LogDownloader class downloads one DataFlash log of one vehicle using
+ *        LOG_REQUEST_DATA / LOG_DATA.
+ *
+ *        The whole log is requested at once and the vehicle streams it. Received
+ *        blocks are tracked in a bitmap. Missing blocks are requested again in
+ *        windows: a request spans all gaps which can be transferred within
+ *        s_WindowSeconds at the measured throughput, already received blocks in
+ *        between are cheaper than another round trip. The next window is requested
+ *        as soon as the previous one arrived, a timeout only covers lost requests.
+ *        Data is collected in a write buffer and written in large chunks.
+ *
+ *        Each vehicle needs its own downloader, downloaders of different vehicles
+ *        can run concurrently.
+ */
+class LogDownloader : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr quint32 s_BlockSize = 90;              ///< Payload size of LOG_DATA
+
+    explicit LogDownloader(UASInterface *uas, QObject *parent = nullptr);
+    ~LogDownloader();
+
+    /**
+     * @brief start starts the download of a log
+     * @param logId - id of the log on the vehicle
+     * @param logSize - size of the log as reported by LOG_ENTRY
+     * @param fileName - file to store the log. Existing files are overwritten.
+     * @return - true if the download was started, false if the file could not be opened
+     */
+    bool start(uint logId, quint32 logSize, const QString &fileName);
+
+    /**
+     * @brief cancel stops a running download. The file is kept as it is.
+     */
+    void cancel();
+
+    bool isActive() const;
+    uint logId() const;
+    QString fileName() const;
+    UASInterface *uas() const;
+
+signals:
+    /**
+     * @brief progress is emitted a few times per second while downloading
+     * @param logId - id of the log
+     * @param received - number of bytes received
+     * @param size - size of the log
+     * @param bytesPerSecond - actual throughput
+     */
+    void progress(uint logId, quint64 received, quint64 size, double bytesPerSecond);
+
+    /**
+     * @brief finished is emitted when the download is complete or failed. It is
+     *        emitted from the event loop, so a new download can be started from a
+     *        connected slot.
+     * @param logId - id of the log
+     * @param fileName - the file
+     * @param success - true if all data was received and written
+     */
+    void finished(uint logId, const QString &fileName, bool success);
+
+private slots:
+    void logData(uint32_t uasId, uint32_t ofs, uint16_t id, uint8_t count, const char *data);
+    void checkProgress();
+
+private:
+    static constexpr int s_CheckIntervalMs = 100;           ///< Interval of the progress/timeout check
+    static constexpr int s_StallTimeoutMs = 700;            ///< Request again if no data arrived within this time
+    static constexpr int s_MaxStalls = 30;                  ///< Give up after this number of timeouts in a row
+    static constexpr double s_WindowSeconds = 0.25;         ///< A retransmission window holds the blocks of this time
+    static constexpr quint32 s_MinWindowBlocks = 16;        ///< Smallest retransmission window
+    static constexpr int s_WriteBufferSize = 256 * 1024;    ///< Write buffer is flushed at this size
+
+    void requestNextWindow();
+    void setLogSize(quint64 size);
+    bool writeData(quint64 offset, const char *data, int count);
+    bool flushWriteBuffer();
+    void finish(bool success);
+
+    QPointer<UASInterface> m_uasPtr;
+    QFile m_file;
+    uint m_logId;
+    quint64 m_logSize;              ///< Size of the log, reduced if the vehicle sends less
+    quint64 m_receivedBytes;
+
+    QBitArray m_blocks;             ///< Received blocks
+    quint32 m_receivedBlocks;
+    quint32 m_firstMissing;         ///< All blocks before are received
+    quint32 m_requestEnd;           ///< End block (exclusive) of the outstanding request
+
+    QByteArray m_writeBuffer;       ///< Contiguous data not written yet
+    quint64 m_writeBufferOffset;    ///< File offset of the write buffer
+    bool m_writeFailed;
+
+    QTimer m_checkTimer;
+    QElapsedTimer m_downloadTimer;
+    QElapsedTimer m_lastDataTimer;
+    QElapsedTimer m_rateTimer;
+    quint64 m_rateBytes;            ///< Bytes received since the rate timer was started
+    double m_bytesPerSecond;        ///< Filtered throughput
+    int m_stallCount;
+    bool m_active;
+};
+
+#endif // LOGDOWNLOADER_H
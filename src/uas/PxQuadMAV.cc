@@ -51,8 +51,8 @@ void PxQuadMAV::receiveMessage(LinkInterface* link, mavlink_message_t message)
             mavlink_raw_aux_t raw;
             mavlink_msg_raw_aux_decode(&message, &raw);
             quint64 time = getUnixTime(0);
-            emit valueChanged(uasId, "Pressure", "raw", raw.baro, time);
-            emit valueChanged(uasId, "Temperature", "raw", raw.temp, time);
+            valueChangedRec(uasId, "Pressure", "raw", raw.baro, time);
+            valueChangedRec(uasId, "Temperature", "raw", raw.temp, time);
         }
         break;
         case MAVLINK_MSG_ID_IMAGE_TRIGGERED:
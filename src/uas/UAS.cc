@@ -148,6 +148,8 @@ UAS::UAS(MAVLinkProtocol* protocol, int id) : UASInterface(),
 
     paramsOnceRequested(false),
     paramManager(nullptr),
+    m_telemetryStorePtr(new UASTelemetryStore()),
+    m_timeSyncPtr(UASTimeSync::instance(id)),
 
     simulation(nullptr),
     p_protocol(protocol),
@@ -186,6 +188,12 @@ UAS::UAS(MAVLinkProtocol* protocol, int id) : UASInterface(),
     connect(heartbeattimer,SIGNAL(timeout()),this,SLOT(sendHeartbeat()));
     heartbeattimer->start(MAVLINK_HEARTBEAT_DEFAULT_RATE * 1000);
 
+    // The time sync decides itself when a request is due, the timer only has
+    // to be faster than its fastest request interval
+    QTimer *timeSyncTimer = new QTimer(this);
+    connect(timeSyncTimer, SIGNAL(timeout()), this, SLOT(sendTimeSyncRequest()));
+    timeSyncTimer->start(100);
+
     m_parameterSendTimer.setInterval(20);
     connect(&m_parameterSendTimer, SIGNAL(timeout()), this, SLOT(requestNextParamFromQueue()));
 }
@@ -260,6 +268,17 @@ int UAS::getUASID() const
 /**
 * Update the heartbeat.
 */
+void UAS::sendTimeSyncRequest()
+{
+    // Keep the clock estimation of the vehicle up to date
+    if (!connectionLost && (lastHeartbeat != 0) && m_timeSyncPtr->isRequestDue())
+    {
+        mavlink_message_t request;
+        mavlink_msg_timesync_pack(systemId, componentId, &request, 0, m_timeSyncPtr->createRequest());
+        sendMessage(request);
+    }
+}
+
 void UAS::updateState()
 {
     // Check if heartbeat timed out
@@ -446,9 +465,9 @@ void UAS::receiveMessage(LinkInterface* link, mavlink_message_t message)
 			// so the Ground Time checkbox must be ticked for these values to display
             quint64 time = getUnixTime();
 			QString name = QString("M%1:HEARTBEAT.%2").arg(message.sysid);
-			emit valueChanged(uasId, name.arg("base_mode"), "bits", state.base_mode, time);
-			emit valueChanged(uasId, name.arg("custom_mode"), "bits", state.custom_mode, time);
-			emit valueChanged(uasId, name.arg("system_status"), "-", state.system_status, time);
+			valueChangedRec(uasId, name.arg("base_mode"), "bits", state.base_mode, time);
+			valueChangedRec(uasId, name.arg("custom_mode"), "bits", state.custom_mode, time);
+			valueChangedRec(uasId, name.arg("system_status"), "-", state.system_status, time);
 			
             // Set new type if it has changed
             if (this->type != state.type)
@@ -535,17 +554,17 @@ void UAS::receiveMessage(LinkInterface* link, mavlink_message_t message)
 
             // Prepare for sending data to the realtime plotter, which is every field excluding onboard_control_sensors_present.
             quint64 time = getUnixTime();
-            emit valueChanged(uasId, statusName().arg("Sensors Enabled"), "bits", state.onboard_control_sensors_enabled, time);
-            emit valueChanged(uasId, statusName().arg("Sensors Health"), "bits", state.onboard_control_sensors_health, time);
-            emit valueChanged(uasId, statusName().arg("Comms Errors"), "-", state.errors_comm, time);
-            emit valueChanged(uasId, statusName().arg("Errors Count 1"), "-", state.errors_count1, time);
-            emit valueChanged(uasId, statusName().arg("Errors Count 2"), "-", state.errors_count2, time);
-            emit valueChanged(uasId, statusName().arg("Errors Count 3"), "-", state.errors_count3, time);
-            emit valueChanged(uasId, statusName().arg("Errors Count 4"), "-", state.errors_count4, time);
+            valueChangedRec(uasId, statusName().arg("Sensors Enabled"), "bits", state.onboard_control_sensors_enabled, time);
+            valueChangedRec(uasId, statusName().arg("Sensors Health"), "bits", state.onboard_control_sensors_health, time);
+            valueChangedRec(uasId, statusName().arg("Comms Errors"), "-", state.errors_comm, time);
+            valueChangedRec(uasId, statusName().arg("Errors Count 1"), "-", state.errors_count1, time);
+            valueChangedRec(uasId, statusName().arg("Errors Count 2"), "-", state.errors_count2, time);
+            valueChangedRec(uasId, statusName().arg("Errors Count 3"), "-", state.errors_count3, time);
+            valueChangedRec(uasId, statusName().arg("Errors Count 4"), "-", state.errors_count4, time);
 
 			// Process CPU load.
             emit loadChanged(this,state.load/10.0);
-            emit valueChanged(uasId, statusName().arg("CPU Load"), "%", state.load/10.0, time);
+            valueChangedRec(uasId, statusName().arg("CPU Load"), "%", state.load/10.0, time);
 
 			// Battery charge/time remaining/voltage calculations
             currentVoltage = state.voltage_battery/1000.0;
@@ -583,14 +602,14 @@ void UAS::receiveMessage(LinkInterface* link, mavlink_message_t message)
             emit batteryChanged(this, lpVoltage, currentCurrent, getChargeLevel(), timeRemaining);
             // emit voltageChanged(message.sysid, currentVoltage);
 
-            emit valueChanged(uasId, statusName().arg("Battery"), "%", state.battery_remaining, time);
-            emit valueChanged(uasId, statusName().arg("Voltage"), "V", state.voltage_battery/1000.0, time);
+            valueChangedRec(uasId, statusName().arg("Battery"), "%", state.battery_remaining, time);
+            valueChangedRec(uasId, statusName().arg("Voltage"), "V", state.voltage_battery/1000.0, time);
 
 			// And if the battery current draw is measured, log that also.
 			if (state.current_battery != -1)
 			{
                 currentCurrent = ((double)state.current_battery)/100.0;
-                emit valueChanged(uasId, statusName().arg("Current"), "A", currentCurrent, time);
+                valueChangedRec(uasId, statusName().arg("Current"), "A", currentCurrent, time);
 			}
 
             // LOW BATTERY ALARM
@@ -620,14 +639,14 @@ void UAS::receiveMessage(LinkInterface* link, mavlink_message_t message)
 				state.drop_rate_comm = 10000;
 			}
             emit dropRateChanged(this->getUASID(), state.drop_rate_comm/100.0);
-            emit valueChanged(uasId, statusName().arg("Comms Drop Rate"), "%", state.drop_rate_comm/100.0, time);
+            valueChangedRec(uasId, statusName().arg("Comms Drop Rate"), "%", state.drop_rate_comm/100.0, time);
 		}
             break;
         case MAVLINK_MSG_ID_ATTITUDE:
         {
             mavlink_attitude_t attitude;
             mavlink_msg_attitude_decode(&message, &attitude);
-            quint64 time = getUnixReferenceTime(attitude.time_boot_ms);
+            quint64 time = getUnixReferenceTime(static_cast<quint64>(attitude.time_boot_ms) * 1000);
 
             emit attitudeChanged(this, message.compid, QGC::limitAngleToPMPIf(attitude.roll), QGC::limitAngleToPMPIf(attitude.pitch), QGC::limitAngleToPMPIf(attitude.yaw), time);
 
@@ -643,9 +662,9 @@ void UAS::receiveMessage(LinkInterface* link, mavlink_message_t message)
                 emit attitudeChanged(this, getRoll(), getPitch(), getYaw(), time);
                 emit attitudeRotationRatesChanged(uasId, attitude.rollspeed, attitude.pitchspeed, attitude.yawspeed, time);
 
-                emit valueChanged(uasId,statusName().arg("Roll"),"deg",QVariant(getRoll() * (180.0/M_PI)),time);
-                emit valueChanged(uasId,statusName().arg("Pitch"),"deg",QVariant(getPitch() * (180.0/M_PI)),time);
-                emit valueChanged(uasId,statusName().arg("Yaw"),"deg",QVariant(getYaw() * (180.0/M_PI)),time);
+                valueChangedRec(uasId,statusName().arg("Roll"),"deg",QVariant(getRoll() * (180.0/M_PI)),time);
+                valueChangedRec(uasId,statusName().arg("Pitch"),"deg",QVariant(getPitch() * (180.0/M_PI)),time);
+                valueChangedRec(uasId,statusName().arg("Yaw"),"deg",QVariant(getYaw() * (180.0/M_PI)),time);
             }
         }
             break;
@@ -653,7 +672,7 @@ void UAS::receiveMessage(LinkInterface* link, mavlink_message_t message)
         {
             mavlink_attitude_quaternion_t attitude;
             mavlink_msg_attitude_quaternion_decode(&message, &attitude);
-            quint64 time = getUnixReferenceTime(attitude.time_boot_ms);
+            quint64 time = getUnixReferenceTime(static_cast<quint64>(attitude.time_boot_ms) * 1000);
 
             double a = attitude.q1;
             double b = attitude.q2;
@@ -759,7 +778,7 @@ void UAS::receiveMessage(LinkInterface* link, mavlink_message_t message)
         {
             mavlink_local_position_ned_t pos;
             mavlink_msg_local_position_ned_decode(&message, &pos);
-            quint64 time = getUnixTime(pos.time_boot_ms);
+            quint64 time = getUnixTimeFromMs(pos.time_boot_ms);
 
             // Emit position always with component ID
             emit localPositionChanged(this, message.compid, pos.x, pos.y, pos.z, time);
@@ -811,8 +830,8 @@ void UAS::receiveMessage(LinkInterface* link, mavlink_message_t message)
             setAltitudeAMSL(pos.alt/1000.0);
             setAltitudeRelative(pos.relative_alt/1000.0);
 			
-            emit valueChanged(uasId,statusName().arg("Heading"),"degs",QVariant((double)pos.hdg),time);
-            emit valueChanged(uasId,statusName().arg("Climb"),"m/s",QVariant((double)pos.vz / 100.0),time);
+            valueChangedRec(uasId,statusName().arg("Heading"),"degs",QVariant((double)pos.hdg),time);
+            valueChangedRec(uasId,statusName().arg("Climb"),"m/s",QVariant((double)pos.vz / 100.0),time);
 
             globalEstimatorActive = true;
 
@@ -864,7 +883,7 @@ void UAS::receiveMessage(LinkInterface* link, mavlink_message_t message)
             setGPSLatitude(pos.lat/(double)1E7);
             setGPSLongitude(pos.lon/(double)1E7);
             setGPSAltitude(pos.alt/1000.0);
-            emit valueChanged(this->uasId,statusGPS().arg("GPS COG"),"deg",QVariant(pos.cog/100.0),getUnixTime());
+            valueChangedRec(this->uasId,statusGPS().arg("GPS COG"),"deg",QVariant(pos.cog/100.0),getUnixTime());
 
             if (pos.fix_type > 2)
             {
@@ -1367,10 +1386,10 @@ void UAS::receiveMessage(LinkInterface* link, mavlink_message_t message)
             mavlink_msg_radio_decode(&message, &radio);
             emit radioMessageUpdate(this, radio);
 
-            emit valueChanged(uasId, statusName().arg("Radio RSSI"), "", radio.rssi, time);
-            emit valueChanged(uasId, statusName().arg("Radio REM RSSI"), "", radio.remrssi, time);
-            emit valueChanged(uasId, statusName().arg("Radio noise"), "", radio.noise, time);
-            emit valueChanged(uasId, statusName().arg("Radio REM noise"), "", radio.remnoise, time);
+            valueChangedRec(uasId, statusName().arg("Radio RSSI"), "", radio.rssi, time);
+            valueChangedRec(uasId, statusName().arg("Radio REM RSSI"), "", radio.remrssi, time);
+            valueChangedRec(uasId, statusName().arg("Radio noise"), "", radio.noise, time);
+            valueChangedRec(uasId, statusName().arg("Radio REM noise"), "", radio.remnoise, time);
         }
             break;
         // MAVLink Log donwload messages
@@ -1432,12 +1451,21 @@ void UAS::receiveMessage(LinkInterface* link, mavlink_message_t message)
         {
             mavlink_timesync_t timeSync;
             mavlink_msg_timesync_decode(&message, &timeSync);
-            timeSync.tc1 = QDateTime::currentDateTime().toTime_t() * 1000 + QTime::currentTime().msec();
 //            QLOG_DEBUG() << "timesync tc1:" << timeSync.tc1 << " ts1:" << timeSync.ts1;
 
-            mavlink_message_t answer;
-            mavlink_msg_timesync_encode(systemId, componentId, &answer, &timeSync);
-            sendMessage(answer);
+            if (timeSync.tc1 == 0)
+            {
+                // Request of the vehicle - answer with our time
+                timeSync.tc1 = UASTimeSync::responseTime();
+                mavlink_message_t answer;
+                mavlink_msg_timesync_encode(systemId, componentId, &answer, &timeSync);
+                sendMessage(answer);
+            }
+            else
+            {
+                // Answer to one of our requests
+                m_timeSyncPtr->handleResponse(timeSync.ts1, timeSync.tc1);
+            }
             break;
         }
 
@@ -1776,7 +1804,8 @@ quint64 UAS::getUnixReferenceTime(quint64 time)
     if (time == 0)
     {
         //        QLOG_DEBUG() << "XNEW time:" <<QGC::groundTimeMilliseconds();
-        return QGC::groundTimeMilliseconds();
+        // The value was sampled one link latency before we received it
+        return (QGC::groundTimeUsecs() - m_timeSyncPtr->latencyUsecs()) / 1000;
     }
     // Check if time is smaller than 40 years,
     // assuming no system without Unix timestamp
@@ -1801,6 +1830,11 @@ quint64 UAS::getUnixReferenceTime(quint64 time)
 #endif
     {
         //        QLOG_DEBUG() << "GEN time:" << time/1000 + onboardTimeOffset;
+        quint64 groundTime = 0;
+        if (m_timeSyncPtr->toGroundTimeUsecs(time, groundTime))
+        {
+            return groundTime / 1000;
+        }
         if (onboardTimeOffset == 0)
         {
             onboardTimeOffset = QGC::groundTimeMilliseconds() - time/1000;
@@ -1848,7 +1882,8 @@ quint64 UAS::getUnixTime(quint64 time)
 
     if (time == 0)
     {
-        ret = QGC::groundTimeMilliseconds();
+        // The value was sampled one link latency before we received it
+        ret = (QGC::groundTimeUsecs() - m_timeSyncPtr->latencyUsecs()) / 1000;
     }
     // Check if time is smaller than 40 years,
     // assuming no system without Unix timestamp
@@ -1880,7 +1915,15 @@ quint64 UAS::getUnixTime(quint64 time)
         }
         if (time > lastNonNullTime) lastNonNullTime = time;
 
-        ret = time/1000 + onboardTimeOffset;
+        quint64 groundTime = 0;
+        if (m_timeSyncPtr->toGroundTimeUsecs(time, groundTime))
+        {
+            ret = groundTime / 1000;
+        }
+        else
+        {
+            ret = time/1000 + onboardTimeOffset;
+        }
     }
     else
     {
@@ -3390,24 +3433,24 @@ void UAS::sendHilGroundTruth(quint64 time_us, float roll, float pitch, float yaw
     Q_UNUSED(zacc);
     
         // Emit attitude for cross-check
-        emit valueChanged(uasId, "roll sim", "rad", roll, getUnixTime());
-        emit valueChanged(uasId, "pitch sim", "rad", pitch, getUnixTime());
-        emit valueChanged(uasId, "yaw sim", "rad", yaw, getUnixTime());
+        valueChangedRec(uasId, "roll sim", "rad", roll, getUnixTime());
+        valueChangedRec(uasId, "pitch sim", "rad", pitch, getUnixTime());
+        valueChangedRec(uasId, "yaw sim", "rad", yaw, getUnixTime());
 
-        emit valueChanged(uasId, "roll rate sim", "rad/s", rollspeed, getUnixTime());
-        emit valueChanged(uasId, "pitch rate sim", "rad/s", pitchspeed, getUnixTime());
-        emit valueChanged(uasId, "yaw rate sim", "rad/s", yawspeed, getUnixTime());
+        valueChangedRec(uasId, "roll rate sim", "rad/s", rollspeed, getUnixTime());
+        valueChangedRec(uasId, "pitch rate sim", "rad/s", pitchspeed, getUnixTime());
+        valueChangedRec(uasId, "yaw rate sim", "rad/s", yawspeed, getUnixTime());
 
-        emit valueChanged(uasId, "lat sim", "deg", lat*1e7, getUnixTime());
-        emit valueChanged(uasId, "lon sim", "deg", lon*1e7, getUnixTime());
-        emit valueChanged(uasId, "alt sim", "deg", alt*1e3, getUnixTime());
+        valueChangedRec(uasId, "lat sim", "deg", lat*1e7, getUnixTime());
+        valueChangedRec(uasId, "lon sim", "deg", lon*1e7, getUnixTime());
+        valueChangedRec(uasId, "alt sim", "deg", alt*1e3, getUnixTime());
 
-        emit valueChanged(uasId, "vx sim", "m/s", vx*1e2, getUnixTime());
-        emit valueChanged(uasId, "vy sim", "m/s", vy*1e2, getUnixTime());
-        emit valueChanged(uasId, "vz sim", "m/s", vz*1e2, getUnixTime());
+        valueChangedRec(uasId, "vx sim", "m/s", vx*1e2, getUnixTime());
+        valueChangedRec(uasId, "vy sim", "m/s", vy*1e2, getUnixTime());
+        valueChangedRec(uasId, "vz sim", "m/s", vz*1e2, getUnixTime());
 
-        emit valueChanged(uasId, "IAS sim", "m/s", ind_airspeed, getUnixTime());
-        emit valueChanged(uasId, "TAS sim", "m/s", true_airspeed, getUnixTime());
+        valueChangedRec(uasId, "IAS sim", "m/s", ind_airspeed, getUnixTime());
+        valueChangedRec(uasId, "TAS sim", "m/s", true_airspeed, getUnixTime());
 }
 
 /**
@@ -4022,6 +4065,20 @@ void UAS::protocolStatusMessageRec(const QString& title, const QString& message)
 
 void UAS::valueChangedRec(const int uasId, const QString& name, const QString& unit, const QVariant& value, const quint64 msec)
 {
+    valueChangedRec(uasId, UASTelemetryStore::keyFor(name, unit), name, unit, value, msec);
+}
+
+void UAS::valueChangedRec(const int uasId, int key, const QString& name, const QString& unit, const QVariant& value, const quint64 msec)
+{
+    // Every value passes here once, so the store is updated once for all display widgets
+    bool ok = false;
+    const double doubleValue = value.toDouble(&ok);
+    if (ok)
+    {
+        const QMetaType::Type metaType = static_cast<QMetaType::Type>(value.type());
+        const bool isInteger = (metaType != QMetaType::Double) && (metaType != QMetaType::Float);
+        m_telemetryStorePtr->update(key, doubleValue, isInteger, msec);
+    }
     emit valueChanged(uasId,name,unit,value,msec);
 }
 
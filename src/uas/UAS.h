@@ -33,6 +33,7 @@ This file is part of the QGROUNDCONTROL project
 
 #include "UASInterface.h"
 #include "QGCHilLink.h"
+#include "UASTimeSync.h"
 
 #include <MAVLinkProtocol.h>
 
@@ -115,10 +116,10 @@ public:
         groundSpeed = val;
         emit groundSpeedChanged(val,"groundSpeed");
         QString unitName = "Ground Speed";
-        emit valueChanged(this->uasId,statusMetric().arg(unitName),"m/s",QVariant(val),getUnixTime());
-        emit valueChanged(this->uasId,statusMetric().arg(unitName),"km/h",QVariant(val*3.6),getUnixTime());
-        emit valueChanged(this->uasId,statusImperial().arg(unitName),"mi/h",QVariant(val*2.2369362921),getUnixTime());
-        emit valueChanged(this->uasId,statusMetric().arg(unitName),"kn",QVariant(val*1.9438444924),getUnixTime());
+        valueChangedRec(this->uasId,statusMetric().arg(unitName),"m/s",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusMetric().arg(unitName),"km/h",QVariant(val*3.6),getUnixTime());
+        valueChangedRec(this->uasId,statusImperial().arg(unitName),"mi/h",QVariant(val*2.2369362921),getUnixTime());
+        valueChangedRec(this->uasId,statusMetric().arg(unitName),"kn",QVariant(val*1.9438444924),getUnixTime());
     }
     double getGroundSpeed() const
     {
@@ -130,10 +131,10 @@ public:
         airSpeed = val;
         emit airSpeedChanged(val,"airSpeed");
         QString unitName = "Air Speed";
-        emit valueChanged(this->uasId,statusMetric().arg(unitName),"m/s",QVariant(val),getUnixTime());
-        emit valueChanged(this->uasId,statusMetric().arg(unitName),"km/h",QVariant(val*3.6),getUnixTime());
-        emit valueChanged(this->uasId,statusImperial().arg(unitName),"mi/h",QVariant(val*2.2369362921),getUnixTime());
-        emit valueChanged(this->uasId,statusMetric().arg(unitName),"kn",QVariant(val*1.9438444924),getUnixTime());
+        valueChangedRec(this->uasId,statusMetric().arg(unitName),"m/s",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusMetric().arg(unitName),"km/h",QVariant(val*3.6),getUnixTime());
+        valueChangedRec(this->uasId,statusImperial().arg(unitName),"mi/h",QVariant(val*2.2369362921),getUnixTime());
+        valueChangedRec(this->uasId,statusMetric().arg(unitName),"kn",QVariant(val*1.9438444924),getUnixTime());
     }
 
     double getAirSpeed() const
@@ -145,7 +146,7 @@ public:
     {
         localX = val;
         emit localXChanged(val,"localX");
-        emit valueChanged(this->uasId,statusName().arg("localX"),"m",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusName().arg("localX"),"m",QVariant(val),getUnixTime());
     }
 
     double getLocalX() const
@@ -157,7 +158,7 @@ public:
     {
         localY = val;
         emit localYChanged(val,"localY");
-        emit valueChanged(this->uasId,statusName().arg("localY"),"m",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusName().arg("localY"),"m",QVariant(val),getUnixTime());
     }
     double getLocalY() const
     {
@@ -168,7 +169,7 @@ public:
     {
         localZ = val;
         emit localZChanged(val,"localZ");
-        emit valueChanged(this->uasId,statusName().arg("localZ"),"m",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusName().arg("localZ"),"m",QVariant(val),getUnixTime());
     }
     double getLocalZ() const
     {
@@ -179,7 +180,7 @@ public:
     {
         latitude = val;
         emit latitudeChanged(val,"latitude");
-        emit valueChanged(this->uasId,statusName().arg("Latitude"),"deg",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusName().arg("Latitude"),"deg",QVariant(val),getUnixTime());
     }
 
     double getLatitude() const
@@ -191,7 +192,7 @@ public:
     {
         longitude = val;
         emit longitudeChanged(val,"longitude");
-        emit valueChanged(this->uasId,statusName().arg("Longitude"),"deg",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusName().arg("Longitude"),"deg",QVariant(val),getUnixTime());
     }
 
     double getLongitude() const
@@ -205,8 +206,8 @@ public:
         altitudeAMSL = val;
         emit altitudeAMSLChanged(val, "altitudeAMSL");
         QString unitName = "Alt MSL";
-        emit valueChanged(this->uasId,statusMetric().arg(unitName),"m",QVariant(val),getUnixTime());
-        emit valueChanged(this->uasId,statusImperial().arg(unitName),"ft",QVariant(val*3.280839895),getUnixTime());
+        valueChangedRec(this->uasId,statusMetric().arg(unitName),"m",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusImperial().arg(unitName),"ft",QVariant(val*3.280839895),getUnixTime());
     }
 
     double getAltitudeAMSL() const
@@ -219,8 +220,8 @@ public:
         altitudeRelative = val;
         emit altitudeRelativeChanged(val, "altitudeRelative");
         QString unitName = "Alt REL";
-        emit valueChanged(this->uasId,statusMetric().arg(unitName),"m",QVariant(val),getUnixTime());
-        emit valueChanged(this->uasId,statusImperial().arg(unitName),"ft",QVariant(val*3.280839895),getUnixTime());
+        valueChangedRec(this->uasId,statusMetric().arg(unitName),"m",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusImperial().arg(unitName),"ft",QVariant(val*3.280839895),getUnixTime());
     }
 
     double getAltitudeRelative() const
@@ -232,7 +233,7 @@ public:
     void setGPSLatitude(double val)
     {
         latitude_gps = val;
-        emit valueChanged(this->uasId,statusGPS().arg("GPS Lat"),"deg",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusGPS().arg("GPS Lat"),"deg",QVariant(val),getUnixTime());
     }
 
     double getGPSLatitude() const
@@ -243,7 +244,7 @@ public:
     void setGPSLongitude(double val)
     {
         longitude_gps = val;
-        emit valueChanged(this->uasId,statusGPS().arg("GPS Lng"),"deg",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusGPS().arg("GPS Lng"),"deg",QVariant(val),getUnixTime());
     }
 
     double getGPSLongitude() const
@@ -255,8 +256,8 @@ public:
     {
         altitude_gps = val;
         QString unitName = "GPS Alt MSL";
-        emit valueChanged(this->uasId,statusGPS().arg(unitName),"m",QVariant(val),getUnixTime());
-        emit valueChanged(this->uasId,statusGPS().arg(unitName),"ft",QVariant(val*3.280839895),getUnixTime());
+        valueChangedRec(this->uasId,statusGPS().arg(unitName),"m",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusGPS().arg(unitName),"ft",QVariant(val*3.280839895),getUnixTime());
     }
 
     double getGPSAltitude() const
@@ -268,10 +269,10 @@ public:
     {
         velocity_gps = val;
         QString unitName = "GPS Velocity";
-        emit valueChanged(this->uasId,statusGPS().arg(unitName),"m/s",QVariant(val),getUnixTime());
-        emit valueChanged(this->uasId,statusGPS().arg(unitName),"km/h",QVariant(val*3.6),getUnixTime());
-        emit valueChanged(this->uasId,statusGPS().arg(unitName),"mi/h",QVariant(val*2.2369362921),getUnixTime());
-        emit valueChanged(this->uasId,statusGPS().arg(unitName),"kn",QVariant(val*1.9438444924),getUnixTime());
+        valueChangedRec(this->uasId,statusGPS().arg(unitName),"m/s",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusGPS().arg(unitName),"km/h",QVariant(val*3.6),getUnixTime());
+        valueChangedRec(this->uasId,statusGPS().arg(unitName),"mi/h",QVariant(val*2.2369362921),getUnixTime());
+        valueChangedRec(this->uasId,statusGPS().arg(unitName),"kn",QVariant(val*1.9438444924),getUnixTime());
     }
 
     double getGPSVelocity() const
@@ -283,7 +284,7 @@ public:
     {
         m_satelliteCount = val;
         emit satelliteCountChanged(val,"satelliteCount");
-        emit valueChanged(this->uasId,statusGPS().arg("GPS Sats"),"n",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusGPS().arg("GPS Sats"),"n",QVariant(val),getUnixTime());
     }
 
     int getSatelliteCount() const
@@ -295,7 +296,7 @@ public:
     {
         m_gps_hdop = val;
         emit gpsHdopChanged(val,"GPS HDOP");
-        emit valueChanged(this->uasId,statusGPS().arg("GPS HDOP"),"",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusGPS().arg("GPS HDOP"),"",QVariant(val),getUnixTime());
     }
 
     double getGpsHdop() const
@@ -307,7 +308,7 @@ public:
     {
         m_gps_fix = val;
         emit gpsFixChanged(val,"GPS Fix");
-        emit valueChanged(this->uasId,statusGPS().arg("GPS Fix"),"",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusGPS().arg("GPS Fix"),"",QVariant(val),getUnixTime());
     }
 
     double getGpsFix() const
@@ -347,7 +348,7 @@ public:
     {
         distToWaypoint = val;
         emit distToWaypointChanged(val,"distToWaypoint");
-        emit valueChanged(this->uasId,statusName().arg("distToWaypoint"),"m",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusName().arg("distToWaypoint"),"m",QVariant(val),getUnixTime());
     }
 
     double getDistToWaypoint() const
@@ -359,7 +360,7 @@ public:
     {
         bearingToWaypoint = val;
         emit bearingToWaypointChanged(val,"bearingToWaypoint");
-        emit valueChanged(this->uasId,statusName().arg("bearingToWaypoint"),"deg",QVariant(val),getUnixTime());
+        valueChangedRec(this->uasId,statusName().arg("bearingToWaypoint"),"deg",QVariant(val),getUnixTime());
     }
 
     double getBearingToWaypoint() const
@@ -556,6 +557,10 @@ protected: //COMMENTS FOR TEST UNIT
     bool paramsOnceRequested;       ///< If the parameter list has been read at least once
     QGCUASParamManager* paramManager; ///< Parameter manager class
 
+    /// TELEMETRY
+    UASTelemetryStore::Ptr m_telemetryStorePtr;   ///< Latest telemetry values of this system
+    UASTimeSync::Ptr m_timeSyncPtr;               ///< Clock offset and link latency of this system
+
     /// SIMULATION
     QGCHilLink* simulation;         ///< Hardware in the loop simulation link
 
@@ -599,6 +604,16 @@ public:
         return paramManager;
     }
 
+    /** @brief Get the telemetry value store **/
+    UASTelemetryStore::Ptr getTelemetryStore() const {
+        return m_telemetryStorePtr;
+    }
+
+    /** @brief Get the clock estimation of this system */
+    UASTimeSync::Ptr getTimeSync() const {
+        return m_timeSyncPtr;
+    }
+
     /** @brief Get the HIL simulation */
     QGCHilLink* getHILSimulation() const {
         return simulation;
@@ -769,6 +784,7 @@ public slots:
 
     void protocolStatusMessageRec(const QString& title, const QString& message);
     void valueChangedRec(const int uasId, const QString& name, const QString& unit, const QVariant& value, const quint64 msec);
+    void valueChangedRec(const int uasId, int key, const QString& name, const QString& unit, const QVariant& value, const quint64 msec);
     void textMessageReceivedRec(int uasid, int componentid, int severity, const QString& text);
     void receiveLossChangedRec(int id,float value);
 
@@ -968,6 +984,8 @@ public slots:
 
     /** @brief Update the system state */
     virtual void updateState();
+    /** @brief Send a TIMESYNC request if the clock estimation needs one */
+    void sendTimeSyncRequest();
 
     /** @brief Set world frame origin at current GPS position */
     void setLocalOriginAtCurrentGPSPosition();
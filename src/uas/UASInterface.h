@@ -42,6 +42,7 @@ This file is part of the QGROUNDCONTROL project
 #include "ProtocolInterface.h"
 #include "UASWaypointManager.h"
 #include "QGCUASParamManager.h"
+#include "UASTelemetryStore.h"
 #include "RadioCalibration/RadioCalibrationData.h"
 
 enum BatteryType
@@ -161,6 +162,8 @@ public:
     virtual UASWaypointManager* getWaypointManager(void) = 0;
     /** @brief Get reference to the param manager **/
     virtual QGCUASParamManager* getParamManager() const = 0;
+    /** @brief Get the store holding the latest telemetry values **/
+    virtual UASTelemetryStore::Ptr getTelemetryStore() const = 0;
     // TODO Will be removed
     /** @brief Set reference to the param manager **/
     virtual void setParamManager(QGCUASParamManager* manager) = 0;
@@ -290,6 +293,8 @@ public slots:
      */
     virtual void protocolStatusMessageRec(const QString& title, const QString& message)=0;
     virtual void valueChangedRec(const int uasId, const QString& name, const QString& unit, const QVariant& value, const quint64 msec)=0;
+    /** @brief valueChangedRec with the interned key of name and unit (UASTelemetryStore::keyFor()) for callers which cache it */
+    virtual void valueChangedRec(const int uasId, int key, const QString& name, const QString& unit, const QVariant& value, const quint64 msec)=0;
     virtual void textMessageReceivedRec(int uasid, int componentid, int severity, const QString& text)=0;
     virtual void receiveLossChangedRec(int id,float value)=0;
 
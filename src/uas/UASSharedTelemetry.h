@@ -0,0 +1,251 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file UASSharedTelemetry.h
+ * @date 18 Oct 2026
+ * @brief File providing the layout of the shared memory telemetry export
+ */
+
+#ifndef UASSHAREDTELEMETRY_H
+#define UASSHAREDTELEMETRY_H
+
+#include <QtGlobal>
+
+#include <atomic>
+#include <cstring>
+
+/**
+ * @brief The UASSharedTelemetry namespace defines the layout of the shared memory
+ *        segment written by the UASSharedTelemetryExporter. Local processes attach
+ *        to the segment (QSharedMemory key s_SegmentKey) and read it without any
+ *        lock and without copying more than the values they need.
+ *
+ *        The segment starts with a Header followed by one VehicleSnapshot per
+ *        vehicle slot and the append log. There is exactly one writer.
+ *        - Snapshots are protected by a seqlock. The sequence is odd while the
+ *          writer updates the snapshot. A reader copies the state and retries if
+ *          the sequence was odd or changed meanwhile (see readSnapshot()).
+ *        - The append log is a ring of LogRecords. Record n (counted from 0) is
+ *          stored at index n % logCapacity and its sequence is n + 1 once it is
+ *          complete. A reader which is too slow detects overwritten records by
+ *          their sequence (see readLogRecord()).
+ *
+ *        Readers must check magic and version before using anything else. A new
+ *        version is only required if the layout changes, new record types can be
+ *        added without it.
+ *        This header has no dependency beside QtGlobal so external tools can use it.
+ */
+namespace UASSharedTelemetry
+{
+
+static const char s_SegmentKey[] = "APMPlannerSharedTelemetry";
+static const quint32 s_Magic = 0x4d544150;      ///< "APTM" in little endian
+static const quint32 s_Version = 1;
+static const int s_MaxVehicles = 16;            ///< Number of vehicle slots
+static const int s_MaxRcChannels = 18;          ///< Number of RC channels in a snapshot
+static const int s_MaxServoOutputs = 8;         ///< Number of servo outputs in a snapshot
+static const int s_LogCapacity = 8192;          ///< Number of records in the append log
+static const int s_LogValues = 8;               ///< Number of values per log record
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+              "Shared memory export requires lock free atomics");
+
+/**
+ * @brief The RecordType enum defines the content of a log record
+ */
+enum RecordType
+{
+    RecordInvalid = 0,
+    RecordAttitude = 1,         ///< roll, pitch, yaw in radians
+    RecordGlobalPosition = 2,   ///< latitude, longitude in degrees, altitude in meters
+    RecordBattery = 3,          ///< voltage in V, current in A, remaining percent, remaining seconds
+    RecordRcChannel = 4,        ///< channel index, raw value in us
+    RecordServoOutputs = 5,     ///< raw outputs 1 to 8 in us
+    RecordVehicleRemoved = 6    ///< no values
+};
+
+/**
+ * @brief The Header struct is at the start of the segment and describes its layout
+ */
+struct Header
+{
+    quint32 m_magic;                        ///< s_Magic. Written last on initialization
+    quint32 m_version;                      ///< s_Version
+    quint32 m_headerSize;                   ///< sizeof(Header)
+    quint32 m_snapshotSize;                 ///< sizeof(VehicleSnapshot)
+    quint32 m_recordSize;                   ///< sizeof(LogRecord)
+    quint32 m_maxVehicles;                  ///< Number of vehicle slots
+    quint32 m_logCapacity;                  ///< Number of log records
+    quint32 m_reserved;
+    quint64 m_startUsecs;                   ///< Ground time the writer started
+    std::atomic<quint64> m_logWriteCount;   ///< Number of records written so far
+};
+
+/**
+ * @brief The VehicleState struct holds the latest decoded state of one vehicle.
+ *        Timestamps are ground time (UTC) in microseconds, 0 if not received yet.
+ */
+struct VehicleState
+{
+    quint32 m_systemId;                     ///< MAVLink system id. 0 if the slot is unused
+    quint32 m_reserved;
+    quint64 m_updateUsecs;                  ///< Last change of any value
+
+    double m_roll;                          ///< Radians
+    double m_pitch;                         ///< Radians
+    double m_yaw;                           ///< Radians
+    quint64 m_attitudeUsecs;
+
+    double m_latitude;                      ///< Degrees
+    double m_longitude;                     ///< Degrees
+    double m_altitude;                      ///< Meters (AMSL)
+    quint64 m_positionUsecs;
+
+    double m_voltage;                       ///< V
+    double m_current;                       ///< A
+    double m_batteryPercent;                ///< Remaining capacity in percent
+    qint32 m_batterySeconds;                ///< Remaining time in seconds
+    quint32 m_reserved2;
+    quint64 m_batteryUsecs;
+
+    quint16 m_rcRaw[s_MaxRcChannels];       ///< RC channel values in us. 0 if not received
+    quint64 m_rcUsecs;
+
+    quint16 m_servoRaw[s_MaxServoOutputs];  ///< Servo output values in us
+    quint64 m_servoUsecs;
+};
+
+/**
+ * @brief The VehicleSnapshot struct is a seqlock protected VehicleState
+ */
+struct VehicleSnapshot
+{
+    std::atomic<quint32> m_sequence;        ///< Odd while the writer updates the state
+    quint32 m_reserved;
+    VehicleState m_state;
+};
+
+/**
+ * @brief The LogRecord struct is one entry of the append log
+ */
+struct LogRecord
+{
+    std::atomic<quint64> m_sequence;        ///< Record number + 1 if complete, 0 while written
+    quint64 m_groundUsecs;                  ///< Ground time the value was received
+    quint32 m_systemId;                     ///< MAVLink system id of the vehicle
+    quint32 m_type;                         ///< RecordType
+    double m_values[s_LogValues];           ///< Values as described by the RecordType
+};
+
+/**
+ * @brief The Segment struct is the whole shared memory segment
+ */
+struct Segment
+{
+    Header m_header;
+    VehicleSnapshot m_vehicles[s_MaxVehicles];
+    LogRecord m_log[s_LogCapacity];
+};
+
+/**
+ * @brief isValid checks if a segment can be read with this version of the layout
+ * @param segment - the attached segment
+ * @return - true if magic, version and sizes match
+ */
+inline bool isValid(const Segment *segment)
+{
+    const Header &header = segment->m_header;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return header.m_magic == s_Magic && header.m_version == s_Version &&
+           header.m_headerSize == sizeof(Header) && header.m_snapshotSize == sizeof(VehicleSnapshot) &&
+           header.m_recordSize == sizeof(LogRecord) && header.m_maxVehicles == s_MaxVehicles &&
+           header.m_logCapacity == s_LogCapacity;
+}
+
+/**
+ * @brief readSnapshot reads a consistent copy of a vehicle state
+ * @param segment - the attached segment
+ * @param slot - the vehicle slot (0 to s_MaxVehicles - 1)
+ * @param state - filled with the state
+ * @param maxRetries - number of retries if the writer updates the state meanwhile
+ * @return - true if a consistent copy was read
+ */
+inline bool readSnapshot(const Segment *segment, int slot, VehicleState &state, int maxRetries = 100)
+{
+    if (slot < 0 || slot >= s_MaxVehicles)
+    {
+        return false;
+    }
+    const VehicleSnapshot &snapshot = segment->m_vehicles[slot];
+    for (int i = 0; i <= maxRetries; ++i)
+    {
+        const quint32 before = snapshot.m_sequence.load(std::memory_order_acquire);
+        if (before & 1u)
+        {
+            continue;
+        }
+        std::memcpy(&state, &snapshot.m_state, sizeof(VehicleState));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (snapshot.m_sequence.load(std::memory_order_relaxed) == before)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief readLogRecord reads one record of the append log
+ * @param segment - the attached segment
+ * @param number - number of the record (0 to Header::m_logWriteCount - 1)
+ * @param record - filled with the record. Its sequence is left untouched.
+ * @return - true if the record was read, false if it was overwritten or is not written yet
+ */
+inline bool readLogRecord(const Segment *segment, quint64 number, LogRecord &record)
+{
+    const LogRecord &source = segment->m_log[number % s_LogCapacity];
+    if (source.m_sequence.load(std::memory_order_acquire) != number + 1)
+    {
+        return false;
+    }
+    record.m_groundUsecs = source.m_groundUsecs;
+    record.m_systemId = source.m_systemId;
+    record.m_type = source.m_type;
+    std::memcpy(record.m_values, source.m_values, sizeof(record.m_values));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return source.m_sequence.load(std::memory_order_relaxed) == number + 1;
+}
+
+/**
+ * @brief logWriteCount returns the number of records written so far. Records
+ *        older than logWriteCount - s_LogCapacity are overwritten.
+ * @param segment - the attached segment
+ * @return - the write count
+ */
+inline quint64 logWriteCount(const Segment *segment)
+{
+    return segment->m_header.m_logWriteCount.load(std::memory_order_acquire);
+}
+
+}
+
+#endif // UASSHAREDTELEMETRY_H
@@ -0,0 +1,351 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file UASSharedTelemetryExporter.cpp
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the shared memory telemetry export
+ */
+
+#include "UASSharedTelemetryExporter.h"
+#include "UASManager.h"
+#include "UASInterface.h"
+#include "UAS.h"
+#include "QGC.h"
+#include "logging.h"
+
+#include <QApplication>
+#include <QVector>
+
+using namespace UASSharedTelemetry;
+
+UASSharedTelemetryExporter *UASSharedTelemetryExporter::instance()
+{
+    static UASSharedTelemetryExporter *s_instance = nullptr;
+    if (s_instance == nullptr)
+    {
+        // Parent is the application so the segment is released on exit
+        s_instance = new UASSharedTelemetryExporter(qApp);
+    }
+    return s_instance;
+}
+
+UASSharedTelemetryExporter::UASSharedTelemetryExporter(QObject *parent) :
+    QObject(parent),
+    m_sharedMemory(QString(s_SegmentKey)),
+    m_segmentPtr(nullptr),
+    m_logWriteCount(0)
+{
+}
+
+UASSharedTelemetryExporter::~UASSharedTelemetryExporter()
+{
+    // The UASManager might be gone already, so just invalidate the segment.
+    // QSharedMemory detaches on destruction.
+    if (m_segmentPtr)
+    {
+        m_segmentPtr->m_header.m_magic = 0;
+    }
+}
+
+bool UASSharedTelemetryExporter::isActive() const
+{
+    return m_segmentPtr != nullptr;
+}
+
+bool UASSharedTelemetryExporter::start()
+{
+    if (isActive())
+    {
+        return true;
+    }
+
+    // On unix a segment left over by a crashed instance is destroyed by the last detach
+    if (m_sharedMemory.attach())
+    {
+        m_sharedMemory.detach();
+    }
+    if (!m_sharedMemory.create(sizeof(Segment)))
+    {
+        QLOG_WARN() << "Shared telemetry export disabled - could not create segment:" << m_sharedMemory.errorString();
+        return false;
+    }
+
+    m_segmentPtr = static_cast<Segment *>(m_sharedMemory.data());
+    std::memset(static_cast<void *>(m_segmentPtr), 0, sizeof(Segment));
+    Header &header = m_segmentPtr->m_header;
+    header.m_version = s_Version;
+    header.m_headerSize = sizeof(Header);
+    header.m_snapshotSize = sizeof(VehicleSnapshot);
+    header.m_recordSize = sizeof(LogRecord);
+    header.m_maxVehicles = s_MaxVehicles;
+    header.m_logCapacity = s_LogCapacity;
+    header.m_startUsecs = QGC::groundTimeUsecs();
+    m_logWriteCount = 0;
+    // Readers must not see the magic before the rest of the header
+    std::atomic_thread_fence(std::memory_order_release);
+    header.m_magic = s_Magic;
+
+    connect(UASManager::instance(), SIGNAL(UASCreated(UASInterface*)), this, SLOT(addUAS(UASInterface*)));
+    connect(UASManager::instance(), SIGNAL(UASDeleted(UASInterface*)), this, SLOT(removeUAS(UASInterface*)));
+    foreach (UASInterface *uas, UASManager::instance()->getUASList())
+    {
+        addUAS(uas);
+    }
+
+    QLOG_INFO() << "Shared telemetry export started. Key:" << s_SegmentKey << "size:" << sizeof(Segment);
+    return true;
+}
+
+void UASSharedTelemetryExporter::stop()
+{
+    if (!isActive())
+    {
+        return;
+    }
+    disconnect(UASManager::instance(), nullptr, this, nullptr);
+    foreach (UASInterface *uas, UASManager::instance()->getUASList())
+    {
+        disconnect(uas, nullptr, this, nullptr);
+    }
+    m_vehicles.clear();
+
+    // Readers holding the segment keep their mapping, they just see no more updates
+    m_segmentPtr->m_header.m_magic = 0;
+    m_segmentPtr = nullptr;
+    m_sharedMemory.detach();
+    QLOG_INFO() << "Shared telemetry export stopped";
+}
+
+void UASSharedTelemetryExporter::addUAS(UASInterface *uas)
+{
+    if (!isActive() || !uas || m_vehicles.contains(uas->getUASID()))
+    {
+        return;
+    }
+
+    // Find a free slot
+    QVector<bool> used(s_MaxVehicles, false);
+    foreach (const Vehicle &vehicle, m_vehicles)
+    {
+        used[vehicle.m_slot] = true;
+    }
+    const int slot = used.indexOf(false);
+    if (slot < 0)
+    {
+        QLOG_WARN() << "Shared telemetry export: no free slot for system" << uas->getUASID();
+        return;
+    }
+
+    Vehicle vehicle;
+    vehicle.m_slot = slot;
+    std::memset(&vehicle.m_state, 0, sizeof(VehicleState));
+    vehicle.m_state.m_systemId = static_cast<quint32>(uas->getUASID());
+    publish(*m_vehicles.insert(uas->getUASID(), vehicle), QGC::groundTimeUsecs());
+
+    connect(uas, SIGNAL(attitudeChanged(UASInterface*,double,double,double,quint64)),
+            this, SLOT(attitudeChanged(UASInterface*,double,double,double,quint64)));
+    connect(uas, SIGNAL(globalPositionChanged(UASInterface*,double,double,double,quint64)),
+            this, SLOT(globalPositionChanged(UASInterface*,double,double,double,quint64)));
+    connect(uas, SIGNAL(batteryChanged(UASInterface*,double,double,double,int)),
+            this, SLOT(batteryChanged(UASInterface*,double,double,double,int)));
+    connect(uas, SIGNAL(remoteControlChannelRawChanged(int,float)),
+            this, SLOT(remoteControlChannelRawChanged(int,float)));
+    if (qobject_cast<UAS *>(uas))
+    {
+        connect(uas, SIGNAL(servoRawOutputChanged(uint64_t,float,float,float,float,float,float,float,float)),
+                this, SLOT(servoRawOutputChanged(uint64_t,float,float,float,float,float,float,float,float)));
+    }
+    QLOG_DEBUG() << "Shared telemetry export: system" << uas->getUASID() << "uses slot" << slot;
+}
+
+void UASSharedTelemetryExporter::removeUAS(UASInterface *uas)
+{
+    if (!isActive() || !uas)
+    {
+        return;
+    }
+    disconnect(uas, nullptr, this, nullptr);
+
+    QHash<int, Vehicle>::iterator iter = m_vehicles.find(uas->getUASID());
+    if (iter == m_vehicles.end())
+    {
+        return;
+    }
+    const quint64 now = QGC::groundTimeUsecs();
+    appendRecord(uas->getUASID(), RecordVehicleRemoved, nullptr, 0, now);
+    // Slot is free again
+    iter->m_state.m_systemId = 0;
+    publish(*iter, now);
+    m_vehicles.erase(iter);
+}
+
+void UASSharedTelemetryExporter::attitudeChanged(UASInterface *uas, double roll, double pitch, double yaw, quint64 usec)
+{
+    Q_UNUSED(usec);
+    QHash<int, Vehicle>::iterator iter = m_vehicles.find(uas->getUASID());
+    if (iter == m_vehicles.end())
+    {
+        return;
+    }
+    const quint64 now = QGC::groundTimeUsecs();
+    VehicleState &state = iter->m_state;
+    state.m_roll = roll;
+    state.m_pitch = pitch;
+    state.m_yaw = yaw;
+    state.m_attitudeUsecs = now;
+    publish(*iter, now);
+
+    const double values[] = { roll, pitch, yaw };
+    appendRecord(uas->getUASID(), RecordAttitude, values, 3, now);
+}
+
+void UASSharedTelemetryExporter::globalPositionChanged(UASInterface *uas, double lat, double lon, double alt, quint64 usec)
+{
+    Q_UNUSED(usec);
+    QHash<int, Vehicle>::iterator iter = m_vehicles.find(uas->getUASID());
+    if (iter == m_vehicles.end())
+    {
+        return;
+    }
+    const quint64 now = QGC::groundTimeUsecs();
+    VehicleState &state = iter->m_state;
+    state.m_latitude = lat;
+    state.m_longitude = lon;
+    state.m_altitude = alt;
+    state.m_positionUsecs = now;
+    publish(*iter, now);
+
+    const double values[] = { lat, lon, alt };
+    appendRecord(uas->getUASID(), RecordGlobalPosition, values, 3, now);
+}
+
+void UASSharedTelemetryExporter::batteryChanged(UASInterface *uas, double voltage, double current, double percent, int seconds)
+{
+    QHash<int, Vehicle>::iterator iter = m_vehicles.find(uas->getUASID());
+    if (iter == m_vehicles.end())
+    {
+        return;
+    }
+    const quint64 now = QGC::groundTimeUsecs();
+    VehicleState &state = iter->m_state;
+    state.m_voltage = voltage;
+    state.m_current = current;
+    state.m_batteryPercent = percent;
+    state.m_batterySeconds = seconds;
+    state.m_batteryUsecs = now;
+    publish(*iter, now);
+
+    const double values[] = { voltage, current, percent, static_cast<double>(seconds) };
+    appendRecord(uas->getUASID(), RecordBattery, values, 4, now);
+}
+
+void UASSharedTelemetryExporter::remoteControlChannelRawChanged(int channelId, float raw)
+{
+    Vehicle *vehicle = vehicleOfSender();
+    if (!vehicle || channelId < 0 || channelId >= s_MaxRcChannels)
+    {
+        return;
+    }
+    const quint64 now = QGC::groundTimeUsecs();
+    VehicleState &state = vehicle->m_state;
+    state.m_rcRaw[channelId] = static_cast<quint16>(qBound(0.0f, raw, 65535.0f));
+    state.m_rcUsecs = now;
+    publish(*vehicle, now);
+
+    const double values[] = { static_cast<double>(channelId), static_cast<double>(raw) };
+    appendRecord(static_cast<int>(state.m_systemId), RecordRcChannel, values, 2, now);
+}
+
+void UASSharedTelemetryExporter::servoRawOutputChanged(uint64_t time, float act1, float act2, float act3, float act4,
+                                                       float act5, float act6, float act7, float act8)
+{
+    Q_UNUSED(time);
+    Vehicle *vehicle = vehicleOfSender();
+    if (!vehicle)
+    {
+        return;
+    }
+    const quint64 now = QGC::groundTimeUsecs();
+    const double values[] = { act1, act2, act3, act4, act5, act6, act7, act8 };
+    VehicleState &state = vehicle->m_state;
+    for (int i = 0; i < s_MaxServoOutputs; ++i)
+    {
+        state.m_servoRaw[i] = static_cast<quint16>(qBound(0.0, values[i], 65535.0));
+    }
+    state.m_servoUsecs = now;
+    publish(*vehicle, now);
+
+    appendRecord(static_cast<int>(state.m_systemId), RecordServoOutputs, values, s_MaxServoOutputs, now);
+}
+
+UASSharedTelemetryExporter::Vehicle *UASSharedTelemetryExporter::vehicleOfSender()
+{
+    UASInterface *uas = qobject_cast<UASInterface *>(sender());
+    if (!uas)
+    {
+        return nullptr;
+    }
+    QHash<int, Vehicle>::iterator iter = m_vehicles.find(uas->getUASID());
+    return iter != m_vehicles.end() ? &iter.value() : nullptr;
+}
+
+void UASSharedTelemetryExporter::publish(Vehicle &vehicle, quint64 usecs)
+{
+    if (!m_segmentPtr)
+    {
+        return;
+    }
+    vehicle.m_state.m_updateUsecs = usecs;
+
+    // Seqlock write. There is only one writer so the sequence needs no read-modify-write.
+    VehicleSnapshot &snapshot = m_segmentPtr->m_vehicles[vehicle.m_slot];
+    const quint32 sequence = snapshot.m_sequence.load(std::memory_order_relaxed);
+    snapshot.m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&snapshot.m_state, &vehicle.m_state, sizeof(VehicleState));
+    snapshot.m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void UASSharedTelemetryExporter::appendRecord(int systemId, RecordType type, const double *values, int count, quint64 usecs)
+{
+    if (!m_segmentPtr)
+    {
+        return;
+    }
+    const quint64 number = m_logWriteCount++;
+    LogRecord &record = m_segmentPtr->m_log[number % s_LogCapacity];
+
+    // Invalidate the record first so readers of the overwritten one notice the change
+    record.m_sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    record.m_groundUsecs = usecs;
+    record.m_systemId = static_cast<quint32>(systemId);
+    record.m_type = type;
+    count = qBound(0, count, s_LogValues);
+    std::memset(record.m_values, 0, sizeof(record.m_values));
+    if (count > 0)
+    {
+        std::memcpy(record.m_values, values, count * sizeof(double));
+    }
+    record.m_sequence.store(number + 1, std::memory_order_release);
+    m_segmentPtr->m_header.m_logWriteCount.store(m_logWriteCount, std::memory_order_release);
+}
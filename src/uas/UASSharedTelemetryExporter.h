@@ -0,0 +1,126 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file UASSharedTelemetryExporter.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the shared memory telemetry export
+ */
+
+#ifndef UASSHAREDTELEMETRYEXPORTER_H
+#define UASSHAREDTELEMETRYEXPORTER_H
+
+#include "UASSharedTelemetry.h"
+
+#include <QObject>
+#include <QSharedMemory>
+#include <QHash>
+
+class UASInterface;
+
+/**
+ * @brief The UASSharedTelemetryExporter class publishes the decoded state of all
+ *        vehicles (attitude, position, battery, RC and servo outputs) into a shared
+ *        memory segment so local processes can read it without opening additional
+ *        MAVLink streams. The layout of the segment and the lock free reader functions
+ *        are defined in UASSharedTelemetry.h.
+ *        The exporter is the only writer and lives in the GUI thread like the UAS
+ *        objects it is connected to.
+ */
+class UASSharedTelemetryExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    static UASSharedTelemetryExporter *instance();
+
+    /**
+     * @brief isActive
+     * @return - true if the segment is created and the export is running
+     */
+    bool isActive() const;
+
+public slots:
+    /**
+     * @brief start creates the shared memory segment and starts the export for
+     *        all existing and new vehicles.
+     * @return - true on success
+     */
+    bool start();
+
+    /**
+     * @brief stop stops the export and releases the shared memory segment
+     */
+    void stop();
+
+private slots:
+    void addUAS(UASInterface *uas);
+    void removeUAS(UASInterface *uas);
+    void attitudeChanged(UASInterface *uas, double roll, double pitch, double yaw, quint64 usec);
+    void globalPositionChanged(UASInterface *uas, double lat, double lon, double alt, quint64 usec);
+    void batteryChanged(UASInterface *uas, double voltage, double current, double percent, int seconds);
+    void remoteControlChannelRawChanged(int channelId, float raw);
+    void servoRawOutputChanged(uint64_t time, float act1, float act2, float act3, float act4,
+                               float act5, float act6, float act7, float act8);
+
+private:
+    /**
+     * @brief The Vehicle struct holds the writer side copy of one vehicle snapshot
+     */
+    struct Vehicle
+    {
+        int m_slot;                             ///< Slot in the segment
+        UASSharedTelemetry::VehicleState m_state;
+    };
+
+    explicit UASSharedTelemetryExporter(QObject *parent = nullptr);
+    ~UASSharedTelemetryExporter();
+
+    /**
+     * @brief vehicleOfSender returns the vehicle of the sender of a signal
+     * @return - pointer to the vehicle or nullptr if it is not exported
+     */
+    Vehicle *vehicleOfSender();
+
+    /**
+     * @brief publish copies the state of a vehicle into its snapshot
+     * @param vehicle - the vehicle
+     * @param usecs - ground time of the change
+     */
+    void publish(Vehicle &vehicle, quint64 usecs);
+
+    /**
+     * @brief appendRecord appends one record to the log
+     * @param systemId - system id of the vehicle
+     * @param type - UASSharedTelemetry::RecordType
+     * @param values - the values of the record
+     * @param count - number of values (max UASSharedTelemetry::s_LogValues)
+     * @param usecs - ground time of the record
+     */
+    void appendRecord(int systemId, UASSharedTelemetry::RecordType type, const double *values, int count, quint64 usecs);
+
+    QSharedMemory m_sharedMemory;               ///< The exported segment
+    UASSharedTelemetry::Segment *m_segmentPtr;  ///< Segment data, nullptr if not active
+    QHash<int, Vehicle> m_vehicles;             ///< Exported vehicles by system id
+    quint64 m_logWriteCount;                    ///< Writer copy of the log write count
+};
+
+#endif // UASSHAREDTELEMETRYEXPORTER_H
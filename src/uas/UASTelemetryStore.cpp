@@ -0,0 +1,247 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file UASTelemetryStore.cpp
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the per vehicle telemetry value store
+ */
+
+#include "UASTelemetryStore.h"
+#include "QGC.h"
+
+#include <QHash>
+#include <QPair>
+#include <QReadWriteLock>
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <QMutexLocker>
+
+#include <limits>
+
+namespace
+{
+
+/**
+ * @brief The KeyRegistry struct interns name/unit pairs to integer keys.
+ *        Shared by all stores so a key means the same on every vehicle.
+ */
+struct KeyRegistry
+{
+    QReadWriteLock m_lock;
+    QHash<QPair<QString, QString>, int> m_keys;
+    QVector<QPair<QString, QString> > m_names;
+};
+
+KeyRegistry &keyRegistry()
+{
+    static KeyRegistry s_registry;
+    return s_registry;
+}
+
+}
+
+UASTelemetryStore::Value::Value() :
+    m_value(0.0),
+    m_derivative(0.0),
+    m_mean(0.0),
+    m_min(std::numeric_limits<double>::max()),
+    m_max(-std::numeric_limits<double>::max()),
+    m_rate(0.0),
+    m_count(0),
+    m_msecs(0),
+    m_groundTimeUsecs(0),
+    m_isInteger(false)
+{}
+
+UASTelemetryStore::UASTelemetryStore() :
+    m_historyDepth(0),
+    m_generation(0)
+{}
+
+int UASTelemetryStore::keyFor(const QString &name, const QString &unit)
+{
+    KeyRegistry &registry = keyRegistry();
+    const QPair<QString, QString> nameUnit(name, unit);
+    {
+        QReadLocker locker(&registry.m_lock);
+        QHash<QPair<QString, QString>, int>::const_iterator iter = registry.m_keys.constFind(nameUnit);
+        if (iter != registry.m_keys.constEnd())
+        {
+            return iter.value();
+        }
+    }
+
+    QWriteLocker locker(&registry.m_lock);
+    // Another thread might have inserted it in the meantime
+    QHash<QPair<QString, QString>, int>::const_iterator iter = registry.m_keys.constFind(nameUnit);
+    if (iter != registry.m_keys.constEnd())
+    {
+        return iter.value();
+    }
+    const int key = registry.m_names.size();
+    registry.m_names.append(nameUnit);
+    registry.m_keys.insert(nameUnit, key);
+    return key;
+}
+
+QString UASTelemetryStore::nameOf(int key)
+{
+    KeyRegistry &registry = keyRegistry();
+    QReadLocker locker(&registry.m_lock);
+    return (key >= 0 && key < registry.m_names.size()) ? registry.m_names.at(key).first : QString();
+}
+
+QString UASTelemetryStore::unitOf(int key)
+{
+    KeyRegistry &registry = keyRegistry();
+    QReadLocker locker(&registry.m_lock);
+    return (key >= 0 && key < registry.m_names.size()) ? registry.m_names.at(key).second : QString();
+}
+
+void UASTelemetryStore::update(int key, double value, bool isInteger, quint64 msecs)
+{
+    if (key < 0)
+    {
+        return;
+    }
+    const quint64 now = QGC::groundTimeUsecs();
+
+    QMutexLocker locker(&m_mutex);
+    if (key >= m_values.size())
+    {
+        m_values.resize(key + 1);
+        if (m_historyDepth > 0)
+        {
+            m_history.resize(key + 1);
+        }
+    }
+
+    Value &entry = m_values[key];
+    if (entry.m_count > 0 && now > entry.m_groundTimeUsecs)
+    {
+        const double interval = static_cast<double>(now - entry.m_groundTimeUsecs) / 1000000.0;
+        entry.m_derivative = (value - entry.m_value) / interval;
+        const double rate = 1.0 / interval;
+        entry.m_rate = entry.m_count == 1 ? rate : entry.m_rate + s_RateFilterGain * (rate - entry.m_rate);
+    }
+    entry.m_value = value;
+    entry.m_min = qMin(entry.m_min, value);
+    entry.m_max = qMax(entry.m_max, value);
+    ++entry.m_count;
+    entry.m_mean += (value - entry.m_mean) / static_cast<double>(entry.m_count);
+    entry.m_msecs = msecs;
+    entry.m_groundTimeUsecs = now;
+    entry.m_isInteger = isInteger;
+
+    if (m_historyDepth > 0)
+    {
+        QVector<Sample> &ring = m_history[key];
+        if (ring.size() != m_historyDepth)
+        {
+            ring.resize(m_historyDepth);
+        }
+        Sample &sample = ring[static_cast<int>(entry.m_count % static_cast<quint64>(m_historyDepth))];
+        sample.m_groundTimeUsecs = now;
+        sample.m_value = value;
+    }
+    ++m_generation;
+}
+
+bool UASTelemetryStore::value(int key, Value &value) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (key < 0 || key >= m_values.size() || m_values.at(key).m_count == 0)
+    {
+        return false;
+    }
+    value = m_values.at(key);
+    return true;
+}
+
+QVector<int> UASTelemetryStore::keys() const
+{
+    QVector<int> keys;
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < m_values.size(); ++i)
+    {
+        if (m_values.at(i).m_count > 0)
+        {
+            keys.append(i);
+        }
+    }
+    return keys;
+}
+
+quint64 UASTelemetryStore::generation() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_generation;
+}
+
+void UASTelemetryStore::enableHistory(int depth)
+{
+    QMutexLocker locker(&m_mutex);
+    if (depth <= m_historyDepth)
+    {
+        return;
+    }
+    // The ring index depends on the depth so the old samples can not be kept
+    m_historyDepth = depth;
+    m_history.clear();
+    m_history.resize(m_values.size());
+}
+
+quint64 UASTelemetryStore::history(int key, quint64 sinceCount, QVector<Sample> &samples) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (key < 0 || key >= m_values.size())
+    {
+        return 0;
+    }
+    const quint64 count = m_values.at(key).m_count;
+    if (m_historyDepth == 0 || key >= m_history.size() || m_history.at(key).size() != m_historyDepth)
+    {
+        return count;
+    }
+
+    const QVector<Sample> &ring = m_history.at(key);
+    const quint64 depth = static_cast<quint64>(m_historyDepth);
+    quint64 first = qMax(sinceCount, count > depth ? count - depth : 0) + 1;
+    for (; first <= count; ++first)
+    {
+        const Sample &sample = ring.at(static_cast<int>(first % depth));
+        // Samples stored before the history was enabled are not valid
+        if (sample.m_groundTimeUsecs != 0)
+        {
+            samples.append(sample);
+        }
+    }
+    return count;
+}
+
+void UASTelemetryStore::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_values.clear();
+    m_history.clear();
+    ++m_generation;
+}
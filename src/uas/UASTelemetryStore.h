@@ -0,0 +1,172 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file UASTelemetryStore.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the per vehicle telemetry value store
+ */
+
+#ifndef UASTELEMETRYSTORE_H
+#define UASTELEMETRYSTORE_H
+
+#include <QString>
+#include <QVector>
+#include <QMutex>
+#include <QSharedPointer>
+
+/**
+ * @brief The UASTelemetryStore class holds the latest value of every telemetry
+ *        value of one vehicle. Values are addressed by integer keys which are
+ *        interned once from name and unit and are the same for all vehicles.
+ *        The derived statistics (rate, mean, min, max, derivative) are updated
+ *        once per value so the display widgets just read them at their own
+ *        refresh rate instead of receiving a signal per value.
+ *        A short history per value can be enabled for widgets which need every
+ *        sample (plots).
+ *        All methods are thread safe.
+ */
+class UASTelemetryStore
+{
+public:
+    typedef QSharedPointer<UASTelemetryStore> Ptr;
+
+    /**
+     * @brief The Value struct holds the latest value and its statistics
+     */
+    struct Value
+    {
+        double m_value;             ///< Latest value
+        double m_derivative;        ///< First derivative (unit per second)
+        double m_mean;              ///< Mean of all values
+        double m_min;               ///< Minimum of all values
+        double m_max;               ///< Maximum of all values
+        double m_rate;              ///< Filtered update rate in Hz
+        quint64 m_count;            ///< Number of values received so far. 0 means no value yet.
+        quint64 m_msecs;            ///< Timestamp of the latest value as provided by the source
+        quint64 m_groundTimeUsecs;  ///< Ground time of the latest value (QGC::groundTimeUsecs())
+        bool m_isInteger;           ///< Value is of integer type
+
+        Value();
+    };
+
+    /**
+     * @brief The Sample struct is one entry of the value history
+     */
+    struct Sample
+    {
+        quint64 m_groundTimeUsecs;  ///< Ground time the value was stored
+        double m_value;             ///< The value
+    };
+
+    /**
+     * @brief UASTelemetryStore - CTOR
+     */
+    UASTelemetryStore();
+
+    /**
+     * @brief keyFor returns the interned key for a value name and unit.
+     *        Creates a new key if the combination is not known yet.
+     * @param name - name of the value
+     * @param unit - unit of the value
+     * @return - the key. Always >= 0
+     */
+    static int keyFor(const QString &name, const QString &unit);
+
+    /**
+     * @brief nameOf returns the name of a key
+     * @param key - the key
+     * @return - the name or an empty string if the key is unknown
+     */
+    static QString nameOf(int key);
+
+    /**
+     * @brief unitOf returns the unit of a key
+     * @param key - the key
+     * @return - the unit or an empty string if the key is unknown
+     */
+    static QString unitOf(int key);
+
+    /**
+     * @brief update stores a new value and updates its statistics
+     * @param key - key of the value (see keyFor())
+     * @param value - the value
+     * @param isInteger - true if the value is of integer type
+     * @param msecs - timestamp of the value as provided by the source
+     */
+    void update(int key, double value, bool isInteger, quint64 msecs);
+
+    /**
+     * @brief value reads the latest value and its statistics
+     * @param key - key of the value
+     * @param value - filled with the value
+     * @return - true if the store holds a value for this key
+     */
+    bool value(int key, Value &value) const;
+
+    /**
+     * @brief keys returns the keys of all values in the store
+     * @return - vector with keys in ascending order
+     */
+    QVector<int> keys() const;
+
+    /**
+     * @brief generation is incremented with every update. Readers can use it
+     *        to skip a refresh if nothing changed.
+     * @return - the actual generation
+     */
+    quint64 generation() const;
+
+    /**
+     * @brief enableHistory enables the history for all values. The depth is only
+     *        increased, so several readers can request different depths.
+     * @param depth - number of samples to hold per value
+     */
+    void enableHistory(int depth);
+
+    /**
+     * @brief history reads the samples of a value which were stored after a
+     *        given count. If more samples were stored than the history can hold
+     *        only the newest ones are returned.
+     * @param key - key of the value
+     * @param sinceCount - the value count (Value::m_count) the caller has seen last.
+     *                     Use 0 to get the whole history.
+     * @param samples - samples are appended here
+     * @return - the actual value count which should be used as sinceCount on the next call
+     */
+    quint64 history(int key, quint64 sinceCount, QVector<Sample> &samples) const;
+
+    /**
+     * @brief clear removes all values and their history
+     */
+    void clear();
+
+private:
+    static constexpr double s_RateFilterGain = 0.1;     ///< Gain of the update interval low pass
+
+    mutable QMutex m_mutex;             ///< Guards all members
+    QVector<Value> m_values;            ///< Values indexed by key
+    QVector<QVector<Sample> > m_history;///< Ring buffer per key, indexed by Value::m_count % depth
+    int m_historyDepth;                 ///< Number of samples per ring buffer. 0 means disabled
+    quint64 m_generation;               ///< Incremented with every update
+};
+
+#endif // UASTELEMETRYSTORE_H
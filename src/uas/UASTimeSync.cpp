@@ -0,0 +1,294 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file UASTimeSync.cpp
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the TIMESYNC based clock estimation of a vehicle
+ */
+
+#include "UASTimeSync.h"
+#include "QGC.h"
+#include "logging.h"
+
+#include <QHash>
+#include <QMutexLocker>
+
+#include <limits>
+
+namespace
+{
+
+/**
+ * @brief The TimeSyncRegistry struct holds the estimation of every system id
+ */
+struct TimeSyncRegistry
+{
+    QMutex m_mutex;
+    QHash<int, UASTimeSync::Ptr> m_timeSyncs;
+};
+
+TimeSyncRegistry &timeSyncRegistry()
+{
+    static TimeSyncRegistry s_registry;
+    return s_registry;
+}
+
+}
+
+UASTimeSync::Estimate::Estimate() :
+    m_valid(false),
+    m_offsetUsecs(0),
+    m_referenceUsecs(0),
+    m_drift(0.0),
+    m_latencyUsecs(0),
+    m_roundTripUsecs(0),
+    m_samples(0)
+{}
+
+UASTimeSync::Ptr UASTimeSync::instance(int systemId)
+{
+    TimeSyncRegistry &registry = timeSyncRegistry();
+    QMutexLocker locker(&registry.m_mutex);
+    Ptr &timeSync = registry.m_timeSyncs[systemId];
+    if (timeSync.isNull())
+    {
+        timeSync = Ptr(new UASTimeSync());
+    }
+    return timeSync;
+}
+
+UASTimeSync::Ptr UASTimeSync::find(int systemId)
+{
+    TimeSyncRegistry &registry = timeSyncRegistry();
+    QMutexLocker locker(&registry.m_mutex);
+    return registry.m_timeSyncs.value(systemId);
+}
+
+qint64 UASTimeSync::responseTime()
+{
+    return static_cast<qint64>(QGC::groundTimeUsecs()) * 1000;
+}
+
+UASTimeSync::UASTimeSync() :
+    m_lastRequestUsecs(0),
+    m_lastVehicleUsecs(0)
+{}
+
+bool UASTimeSync::isRequestDue() const
+{
+    const quint64 now = QGC::groundTimeUsecs();
+    QMutexLocker locker(&m_mutex);
+    const quint64 interval = static_cast<quint64>(m_estimate.m_valid ? s_RequestIntervalUsecs : s_FastRequestIntervalUsecs);
+    return now >= m_lastRequestUsecs + interval;
+}
+
+qint64 UASTimeSync::createRequest()
+{
+    const quint64 now = QGC::groundTimeUsecs();
+    const qint64 ts1 = static_cast<qint64>(now) * 1000;
+
+    QMutexLocker locker(&m_mutex);
+    m_lastRequestUsecs = now;
+    m_pendingRequests.append(ts1);
+    if (m_pendingRequests.size() > s_MaxPendingRequests)
+    {
+        m_pendingRequests.remove(0, m_pendingRequests.size() - s_MaxPendingRequests);
+    }
+    return ts1;
+}
+
+bool UASTimeSync::handleResponse(qint64 ts1, qint64 tc1)
+{
+    const quint64 now = QGC::groundTimeUsecs();
+
+    QMutexLocker locker(&m_mutex);
+    const int index = m_pendingRequests.indexOf(ts1);
+    if (index < 0)
+    {
+        // Not our request or answered twice
+        return false;
+    }
+    // Older requests will not be answered anymore
+    m_pendingRequests.remove(0, index + 1);
+
+    const quint64 sendUsecs = static_cast<quint64>(ts1 / 1000);
+    if (now < sendUsecs || tc1 <= 0)
+    {
+        return false;
+    }
+    const qint64 roundTrip = static_cast<qint64>(now - sendUsecs);
+    if (roundTrip > s_MaxRoundTripUsecs)
+    {
+        return false;
+    }
+
+    Sample sample;
+    sample.m_groundUsecs = sendUsecs + static_cast<quint64>(roundTrip / 2);
+    sample.m_offsetUsecs = static_cast<qint64>(sample.m_groundUsecs) - tc1 / 1000;
+    sample.m_roundTripUsecs = roundTrip;
+
+    if (tc1 / 1000 < m_lastVehicleUsecs)
+    {
+        QLOG_INFO() << "UASTimeSync: vehicle clock went backwards - restarting estimation";
+        m_samples.clear();
+        m_estimate = Estimate();
+    }
+    else if (m_estimate.m_valid &&
+             qAbs(static_cast<double>(sample.m_offsetUsecs) - offsetAt(static_cast<double>(sample.m_groundUsecs))) > s_ResetThresholdUsecs)
+    {
+        QLOG_INFO() << "UASTimeSync: vehicle clock jumped - restarting estimation";
+        m_samples.clear();
+        m_estimate = Estimate();
+    }
+    m_lastVehicleUsecs = tc1 / 1000;
+
+    m_samples.append(sample);
+    if (m_samples.size() > s_WindowSize)
+    {
+        m_samples.remove(0, m_samples.size() - s_WindowSize);
+    }
+
+    m_estimate.m_roundTripUsecs = m_estimate.m_samples == 0 ? roundTrip :
+            m_estimate.m_roundTripUsecs + static_cast<qint64>(s_RoundTripFilterGain * static_cast<double>(roundTrip - m_estimate.m_roundTripUsecs));
+    updateEstimate();
+    return true;
+}
+
+bool UASTimeSync::isValid() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_estimate.m_valid;
+}
+
+UASTimeSync::Estimate UASTimeSync::estimate() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_estimate;
+}
+
+quint64 UASTimeSync::latencyUsecs() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_estimate.m_valid ? static_cast<quint64>(m_estimate.m_latencyUsecs) : 0;
+}
+
+bool UASTimeSync::toGroundTimeUsecs(quint64 bootTimeUsecs, quint64 &groundTimeUsecs) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_estimate.m_valid)
+    {
+        return false;
+    }
+    // The drift term needs the ground time we are looking for. The offset changes
+    // by less than 1ms per second so one step from the reference offset is exact enough.
+    const double approximation = static_cast<double>(bootTimeUsecs) + static_cast<double>(m_estimate.m_offsetUsecs);
+    const double ground = static_cast<double>(bootTimeUsecs) + offsetAt(approximation);
+    groundTimeUsecs = ground > 0.0 ? static_cast<quint64>(ground) : 0;
+    return true;
+}
+
+void UASTimeSync::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_samples.clear();
+    m_pendingRequests.clear();
+    m_lastRequestUsecs = 0;
+    m_lastVehicleUsecs = 0;
+    m_estimate = Estimate();
+}
+
+void UASTimeSync::updateEstimate()
+{
+    m_estimate.m_samples = m_samples.size();
+    if (m_samples.isEmpty())
+    {
+        m_estimate.m_valid = false;
+        return;
+    }
+
+    // min-RTT filter: samples with a short round trip have the smallest offset error
+    int minIndex = 0;
+    for (int i = 1; i < m_samples.size(); ++i)
+    {
+        if (m_samples.at(i).m_roundTripUsecs < m_samples.at(minIndex).m_roundTripUsecs)
+        {
+            minIndex = i;
+        }
+    }
+    const qint64 minRoundTrip = m_samples.at(minIndex).m_roundTripUsecs;
+    const qint64 maxRoundTrip = minRoundTrip + qMax(minRoundTrip / 2, s_RoundTripToleranceUsecs);
+
+    // Fit offset = offset(reference) + drift * (t - reference) through the filtered samples.
+    // The reference is their mean time which keeps the numbers small.
+    int count = 0;
+    double sumTime = 0.0;
+    double sumOffset = 0.0;
+    quint64 firstUsecs = std::numeric_limits<quint64>::max();
+    quint64 lastUsecs = 0;
+    foreach (const Sample &sample, m_samples)
+    {
+        if (sample.m_roundTripUsecs <= maxRoundTrip)
+        {
+            ++count;
+            sumTime += static_cast<double>(sample.m_groundUsecs - m_samples.first().m_groundUsecs);
+            sumOffset += static_cast<double>(sample.m_offsetUsecs);
+            firstUsecs = qMin(firstUsecs, sample.m_groundUsecs);
+            lastUsecs = qMax(lastUsecs, sample.m_groundUsecs);
+        }
+    }
+
+    if (count >= s_MinDriftSamples && static_cast<qint64>(lastUsecs - firstUsecs) >= s_MinDriftSpanUsecs)
+    {
+        const double meanTime = sumTime / count;
+        const double meanOffset = sumOffset / count;
+        double sumTimeOffset = 0.0;
+        double sumTimeTime = 0.0;
+        foreach (const Sample &sample, m_samples)
+        {
+            if (sample.m_roundTripUsecs <= maxRoundTrip)
+            {
+                const double time = static_cast<double>(sample.m_groundUsecs - m_samples.first().m_groundUsecs) - meanTime;
+                sumTimeOffset += time * (static_cast<double>(sample.m_offsetUsecs) - meanOffset);
+                sumTimeTime += time * time;
+            }
+        }
+        m_estimate.m_drift = sumTimeTime > 0.0 ? qBound(-s_MaxDrift, sumTimeOffset / sumTimeTime, s_MaxDrift) : 0.0;
+        m_estimate.m_offsetUsecs = static_cast<qint64>(meanOffset);
+        m_estimate.m_referenceUsecs = m_samples.first().m_groundUsecs + static_cast<quint64>(meanTime);
+    }
+    else
+    {
+        // Not enough samples for the drift - use the best one
+        m_estimate.m_drift = 0.0;
+        m_estimate.m_offsetUsecs = m_samples.at(minIndex).m_offsetUsecs;
+        m_estimate.m_referenceUsecs = m_samples.at(minIndex).m_groundUsecs;
+    }
+
+    m_estimate.m_latencyUsecs = minRoundTrip / 2;
+    m_estimate.m_valid = m_samples.size() >= s_MinSamples;
+}
+
+double UASTimeSync::offsetAt(double groundUsecs) const
+{
+    return static_cast<double>(m_estimate.m_offsetUsecs) +
+            m_estimate.m_drift * (groundUsecs - static_cast<double>(m_estimate.m_referenceUsecs));
+}
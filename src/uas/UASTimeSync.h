@@ -0,0 +1,187 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file UASTimeSync.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the TIMESYNC based clock estimation of a vehicle
+ */
+
+#ifndef UASTIMESYNC_H
+#define UASTIMESYNC_H
+
+#include <QVector>
+#include <QMutex>
+#include <QSharedPointer>
+
+/**
+ * @brief The UASTimeSync class estimates the relation between the boot clock of one
+ *        vehicle and the ground time (QGC::groundTimeUsecs()) from TIMESYNC round trips.
+ *        Every answered request is a sample of the clock offset with an error of at most
+ *        half its round trip time. Only the samples with a round trip close to the minimum
+ *        of the last s_WindowSize samples are used (min-RTT filter). If they span enough
+ *        time a line is fitted through them to get the drift of the vehicle clock.
+ *        If the vehicle reboots or its clock jumps the estimation starts over.
+ *
+ *        There is one instance per system id so the UAS and the MAVLinkDecoder map the
+ *        time stamps of a vehicle to the same timeline. All methods are thread safe.
+ */
+class UASTimeSync
+{
+public:
+    typedef QSharedPointer<UASTimeSync> Ptr;
+
+    /**
+     * @brief The Estimate struct holds the actual state of the estimation
+     */
+    struct Estimate
+    {
+        bool m_valid;               ///< Enough samples for mapping time stamps
+        qint64 m_offsetUsecs;       ///< Ground time minus vehicle boot time at m_referenceUsecs
+        quint64 m_referenceUsecs;   ///< Ground time the offset is valid for
+        double m_drift;             ///< Change of the offset per ground time (0.000001 is 1ppm)
+        qint64 m_latencyUsecs;      ///< One way link latency (half the minimum round trip)
+        qint64 m_roundTripUsecs;    ///< Filtered round trip time
+        int m_samples;              ///< Number of samples in the window
+
+        Estimate();
+    };
+
+    /**
+     * @brief instance delivers the clock estimation of a system. It is created on first use.
+     * @param systemId - the mavlink system id
+     * @return - the estimation
+     */
+    static Ptr instance(int systemId);
+
+    /**
+     * @brief find delivers the clock estimation of a system if there is one
+     * @param systemId - the mavlink system id
+     * @return - the estimation or a null pointer
+     */
+    static Ptr find(int systemId);
+
+    /**
+     * @brief responseTime delivers the tc1 field for answering a TIMESYNC request
+     *        of a vehicle.
+     * @return - the ground time in nanoseconds
+     */
+    static qint64 responseTime();
+
+    /**
+     * @brief UASTimeSync - CTOR
+     */
+    UASTimeSync();
+
+    /**
+     * @brief isRequestDue checks if the next request should be sent. Requests are sent
+     *        faster as long as the estimate is not valid.
+     * @return - true if a request is due
+     */
+    bool isRequestDue() const;
+
+    /**
+     * @brief createRequest registers a new request.
+     * @return - the ts1 field of the TIMESYNC request (ground time in nanoseconds)
+     */
+    qint64 createRequest();
+
+    /**
+     * @brief handleResponse processes the answer of the vehicle to one of our requests.
+     *        Answers to requests of other ground stations are ignored.
+     * @param ts1 - ts1 field of the answer (the time of our request)
+     * @param tc1 - tc1 field of the answer (boot time of the vehicle in nanoseconds)
+     * @return - true if the answer was used as sample
+     */
+    bool handleResponse(qint64 ts1, qint64 tc1);
+
+    /**
+     * @brief isValid - true if time stamps can be mapped
+     */
+    bool isValid() const;
+
+    /**
+     * @brief estimate delivers the actual state of the estimation
+     */
+    Estimate estimate() const;
+
+    /**
+     * @brief latencyUsecs delivers the one way link latency
+     * @return - the latency or 0 if the estimate is not valid
+     */
+    quint64 latencyUsecs() const;
+
+    /**
+     * @brief toGroundTimeUsecs maps a boot time of the vehicle to ground time
+     * @param bootTimeUsecs - boot time of the vehicle in microseconds
+     * @param groundTimeUsecs - the ground time in microseconds
+     * @return - true if the estimate is valid and groundTimeUsecs was set
+     */
+    bool toGroundTimeUsecs(quint64 bootTimeUsecs, quint64 &groundTimeUsecs) const;
+
+    /**
+     * @brief reset drops all samples and pending requests
+     */
+    void reset();
+
+private:
+    static constexpr int s_WindowSize = 64;                     ///< Number of samples kept
+    static constexpr int s_MinSamples = 3;                      ///< Samples needed for a valid estimate
+    static constexpr int s_MinDriftSamples = 8;                 ///< Filtered samples needed for estimating the drift
+    static constexpr int s_MaxPendingRequests = 8;              ///< Requests waiting for an answer
+    static constexpr qint64 s_MinDriftSpanUsecs = 30000000;     ///< Time the filtered samples must span for estimating the drift
+    static constexpr qint64 s_MaxRoundTripUsecs = 2000000;      ///< Answers taking longer are ignored
+    static constexpr qint64 s_RoundTripToleranceUsecs = 1000;   ///< Minimum tolerance of the min-RTT filter
+    static constexpr qint64 s_ResetThresholdUsecs = 1000000;    ///< Offset change treated as clock jump
+    static constexpr qint64 s_RequestIntervalUsecs = 1000000;   ///< Request interval with valid estimate
+    static constexpr qint64 s_FastRequestIntervalUsecs = 200000;///< Request interval while estimating
+    static constexpr double s_MaxDrift = 0.001;                 ///< Drift is limited to 1000ppm
+    static constexpr double s_RoundTripFilterGain = 0.1;        ///< Gain of the round trip low pass
+
+    /**
+     * @brief The Sample struct is one answered request
+     */
+    struct Sample
+    {
+        quint64 m_groundUsecs;      ///< Ground time the vehicle answered (middle of the round trip)
+        qint64 m_offsetUsecs;       ///< Ground time minus vehicle boot time
+        qint64 m_roundTripUsecs;    ///< Round trip time
+    };
+
+    mutable QMutex m_mutex;             ///< Guards all members
+    QVector<Sample> m_samples;          ///< The last samples, oldest first
+    QVector<qint64> m_pendingRequests;  ///< ts1 of requests without answer, oldest first
+    quint64 m_lastRequestUsecs;         ///< Ground time of the last request
+    qint64 m_lastVehicleUsecs;          ///< Vehicle time of the last sample
+    Estimate m_estimate;                ///< The actual estimate
+
+    /**
+     * @brief updateEstimate recalculates the estimate from the samples. m_mutex must be locked.
+     */
+    void updateEstimate();
+
+    /**
+     * @brief offsetAt delivers the estimated offset at a ground time. m_mutex must be locked.
+     */
+    double offsetAt(double groundUsecs) const;
+};
+
+#endif // UASTIMESYNC_H
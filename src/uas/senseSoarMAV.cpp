@@ -38,9 +38,9 @@ void senseSoarMAV::receiveMessage(LinkInterface *link, mavlink_message_t message
 				{
 					this->m_rotVel[i]=rotVelMsg.rotVel[i];
 				}
-				emit valueChanged(uasId, "rollspeed", "rad/s", this->m_rotVel[0], time);
-                emit valueChanged(uasId, "pitchspeed", "rad/s", this->m_rotVel[1], time);
-                emit valueChanged(uasId, "yawspeed", "rad/s", this->m_rotVel[2], time);
+				valueChangedRec(uasId, "rollspeed", "rad/s", this->m_rotVel[0], time);
+                valueChangedRec(uasId, "pitchspeed", "rad/s", this->m_rotVel[1], time);
+                valueChangedRec(uasId, "yawspeed", "rad/s", this->m_rotVel[2], time);
                 emit attitudeRotationRatesChanged(uasId, this->m_rotVel[0], this->m_rotVel[1], this->m_rotVel[2], time);
 				break;
 			}
@@ -49,12 +49,12 @@ void senseSoarMAV::receiveMessage(LinkInterface *link, mavlink_message_t message
 				mavlink_llc_out_t llcMsg;
 				mavlink_msg_llc_out_decode(&message,&llcMsg);
 				quint64 time = getUnixTime();
-				emit valueChanged(uasId, "Servo. 1", "rad", llcMsg.servoOut[0], time);
-                emit valueChanged(uasId, "Servo. 2", "rad", llcMsg.servoOut[1], time);
-				emit valueChanged(uasId, "Servo. 3", "rad", llcMsg.servoOut[2], time);
-				emit valueChanged(uasId, "Servo. 4", "rad", llcMsg.servoOut[3], time);
-				emit valueChanged(uasId, "Motor. 1", "raw", llcMsg.MotorOut[0]  , time);
-				emit valueChanged(uasId, "Motor. 2", "raw", llcMsg.MotorOut[1], time);
+				valueChangedRec(uasId, "Servo. 1", "rad", llcMsg.servoOut[0], time);
+                valueChangedRec(uasId, "Servo. 2", "rad", llcMsg.servoOut[1], time);
+				valueChangedRec(uasId, "Servo. 3", "rad", llcMsg.servoOut[2], time);
+				valueChangedRec(uasId, "Servo. 4", "rad", llcMsg.servoOut[3], time);
+				valueChangedRec(uasId, "Motor. 1", "raw", llcMsg.MotorOut[0]  , time);
+				valueChangedRec(uasId, "Motor. 2", "raw", llcMsg.MotorOut[1], time);
 				break;
 			}
 		case MAVLINK_MSG_ID_OBS_AIR_TEMP:
@@ -62,7 +62,7 @@ void senseSoarMAV::receiveMessage(LinkInterface *link, mavlink_message_t message
 				mavlink_obs_air_temp_t airTMsg;
 				mavlink_msg_obs_air_temp_decode(&message,&airTMsg);
 				quint64 time = getUnixTime();
-				emit valueChanged(uasId, "Air Temp", "°", airTMsg.airT, time);
+				valueChangedRec(uasId, "Air Temp", "°", airTMsg.airT, time);
 				break;
 			}
 		case MAVLINK_MSG_ID_OBS_AIR_VELOCITY:
@@ -70,9 +70,9 @@ void senseSoarMAV::receiveMessage(LinkInterface *link, mavlink_message_t message
 				mavlink_obs_air_velocity_t airVMsg;
 				mavlink_msg_obs_air_velocity_decode(&message,&airVMsg);
 				quint64 time = getUnixTime();
-				emit valueChanged(uasId, "AirVel. mag", "m/s", airVMsg.magnitude, time);
-				emit valueChanged(uasId, "AirVel. AoA", "rad", airVMsg.aoa, time);
-				emit valueChanged(uasId, "AirVel. Slip", "rad", airVMsg.slip, time);
+				valueChangedRec(uasId, "AirVel. mag", "m/s", airVMsg.magnitude, time);
+				valueChangedRec(uasId, "AirVel. AoA", "rad", airVMsg.aoa, time);
+				valueChangedRec(uasId, "AirVel. Slip", "rad", airVMsg.slip, time);
 				break;
 			}
 		case MAVLINK_MSG_ID_OBS_ATTITUDE:
@@ -81,12 +81,12 @@ void senseSoarMAV::receiveMessage(LinkInterface *link, mavlink_message_t message
 				mavlink_msg_obs_attitude_decode(&message,&quatMsg);
 				quint64 time = getUnixTime();
 				this->quat2euler(quatMsg.quat,this->roll,this->pitch,this->yaw);
-				emit valueChanged(uasId, "roll", "rad", roll, time);
-                emit valueChanged(uasId, "pitch", "rad", pitch, time);
-                emit valueChanged(uasId, "yaw", "rad", yaw, time);
-				emit valueChanged(uasId, "roll deg", "deg", (roll/M_PI)*180.0, time);
-                emit valueChanged(uasId, "pitch deg", "deg", (pitch/M_PI)*180.0, time);
-                emit valueChanged(uasId, "heading deg", "deg", (yaw/M_PI)*180.0, time);
+				valueChangedRec(uasId, "roll", "rad", roll, time);
+                valueChangedRec(uasId, "pitch", "rad", pitch, time);
+                valueChangedRec(uasId, "yaw", "rad", yaw, time);
+				valueChangedRec(uasId, "roll deg", "deg", (roll/M_PI)*180.0, time);
+                valueChangedRec(uasId, "pitch deg", "deg", (pitch/M_PI)*180.0, time);
+                valueChangedRec(uasId, "heading deg", "deg", (yaw/M_PI)*180.0, time);
 				emit attitudeChanged(this, roll, pitch, yaw, time);
 				break;
 			}
@@ -95,12 +95,12 @@ void senseSoarMAV::receiveMessage(LinkInterface *link, mavlink_message_t message
 				mavlink_obs_bias_t biasMsg;
 				mavlink_msg_obs_bias_decode(&message, &biasMsg);
 				quint64 time = getUnixTime();
-				emit valueChanged(uasId, "acc. biasX", "m/s^2", biasMsg.accBias[0], time);
-				emit valueChanged(uasId, "acc. biasY", "m/s^2", biasMsg.accBias[1], time);
-				emit valueChanged(uasId, "acc. biasZ", "m/s^2", biasMsg.accBias[2], time);
-				emit valueChanged(uasId, "gyro. biasX", "rad/s", biasMsg.gyroBias[0], time);
-				emit valueChanged(uasId, "gyro. biasY", "rad/s", biasMsg.gyroBias[1], time);
-				emit valueChanged(uasId, "gyro. biasZ", "rad/s", biasMsg.gyroBias[2], time);
+				valueChangedRec(uasId, "acc. biasX", "m/s^2", biasMsg.accBias[0], time);
+				valueChangedRec(uasId, "acc. biasY", "m/s^2", biasMsg.accBias[1], time);
+				valueChangedRec(uasId, "acc. biasZ", "m/s^2", biasMsg.accBias[2], time);
+				valueChangedRec(uasId, "gyro. biasX", "rad/s", biasMsg.gyroBias[0], time);
+				valueChangedRec(uasId, "gyro. biasY", "rad/s", biasMsg.gyroBias[1], time);
+				valueChangedRec(uasId, "gyro. biasZ", "rad/s", biasMsg.gyroBias[2], time);
 				break;
 			}
 		case MAVLINK_MSG_ID_OBS_POSITION:
@@ -111,9 +111,9 @@ void senseSoarMAV::receiveMessage(LinkInterface *link, mavlink_message_t message
 				this->longitude = posMsg.lon/(double)1E7;
 				this->latitude = posMsg.lat/(double)1E7;
 				this->altitude = posMsg.alt/1000.0;
-				emit valueChanged(uasId, "latitude", "deg", this->latitude, time);
-                emit valueChanged(uasId, "longitude", "deg", this->longitude, time);
-                emit valueChanged(uasId, "altitude", "m", this->altitude, time);
+				valueChangedRec(uasId, "latitude", "deg", this->latitude, time);
+                valueChangedRec(uasId, "longitude", "deg", this->longitude, time);
+                valueChangedRec(uasId, "altitude", "m", this->altitude, time);
 				emit globalPositionChanged(this, this->latitude, this->longitude, this->altitude, time);
 				break;
 			}
@@ -122,7 +122,7 @@ void senseSoarMAV::receiveMessage(LinkInterface *link, mavlink_message_t message
 				mavlink_obs_qff_t qffMsg;
 				mavlink_msg_obs_qff_decode(&message,&qffMsg);
 				quint64 time = getUnixTime();
-				emit valueChanged(uasId, "QFF", "Pa", qffMsg.qff, time);
+				valueChangedRec(uasId, "QFF", "Pa", qffMsg.qff, time);
 				break;
 			}
 		case MAVLINK_MSG_ID_OBS_VELOCITY:
@@ -130,9 +130,9 @@ void senseSoarMAV::receiveMessage(LinkInterface *link, mavlink_message_t message
 				mavlink_obs_velocity_t velMsg;
 				mavlink_msg_obs_velocity_decode(&message, &velMsg);
 				quint64 time = getUnixTime();
-				emit valueChanged(uasId, "x speed", "m/s", velMsg.vel[0], time);
-                emit valueChanged(uasId, "y speed", "m/s", velMsg.vel[1], time);
-                emit valueChanged(uasId, "z speed", "m/s", velMsg.vel[2], time);
+				valueChangedRec(uasId, "x speed", "m/s", velMsg.vel[0], time);
+                valueChangedRec(uasId, "y speed", "m/s", velMsg.vel[1], time);
+                valueChangedRec(uasId, "z speed", "m/s", velMsg.vel[2], time);
 				emit speedChanged(this, velMsg.vel[0], velMsg.vel[1], velMsg.vel[2], time);
 				break;
 			}
@@ -141,9 +141,9 @@ void senseSoarMAV::receiveMessage(LinkInterface *link, mavlink_message_t message
 				mavlink_obs_wind_t windMsg;
 				mavlink_msg_obs_wind_decode(&message, &windMsg);
 				quint64 time = getUnixTime();
-				emit valueChanged(uasId, "Wind speed x", "m/s", windMsg.wind[0], time);
-				emit valueChanged(uasId, "Wind speed y", "m/s", windMsg.wind[1], time);
-				emit valueChanged(uasId, "Wind speed z", "m/s", windMsg.wind[2], time);
+				valueChangedRec(uasId, "Wind speed x", "m/s", windMsg.wind[0], time);
+				valueChangedRec(uasId, "Wind speed y", "m/s", windMsg.wind[1], time);
+				valueChangedRec(uasId, "Wind speed z", "m/s", windMsg.wind[2], time);
 				break;
 			}
 		case MAVLINK_MSG_ID_PM_ELEC:
@@ -151,11 +151,11 @@ void senseSoarMAV::receiveMessage(LinkInterface *link, mavlink_message_t message
 				mavlink_pm_elec_t pmMsg;
 				mavlink_msg_pm_elec_decode(&message, &pmMsg);
 				quint64 time = getUnixTime();
-				emit valueChanged(uasId, "Battery status", "%", pmMsg.BatStat, time);
-				emit valueChanged(uasId, "Power consuming", "W", pmMsg.PwCons, time);
-				emit valueChanged(uasId, "Power generating sys1", "W", pmMsg.PwGen[0], time);
-				emit valueChanged(uasId, "Power generating sys2", "W", pmMsg.PwGen[1], time);
-				emit valueChanged(uasId, "Power generating sys3", "W", pmMsg.PwGen[2], time);
+				valueChangedRec(uasId, "Battery status", "%", pmMsg.BatStat, time);
+				valueChangedRec(uasId, "Power consuming", "W", pmMsg.PwCons, time);
+				valueChangedRec(uasId, "Power generating sys1", "W", pmMsg.PwGen[0], time);
+				valueChangedRec(uasId, "Power generating sys2", "W", pmMsg.PwGen[1], time);
+				valueChangedRec(uasId, "Power generating sys3", "W", pmMsg.PwGen[2], time);
 				break;
 			}
 		case MAVLINK_MSG_ID_SYS_STAT:
@@ -169,22 +169,22 @@ void senseSoarMAV::receiveMessage(LinkInterface *link, mavlink_message_t message
 				mavlink_msg_sys_stat_decode(&message,&statMsg);
 				quint64 time = getUnixTime();
 				// check actuator states
-				emit valueChanged(uasId, "Motor1 status", "on/off", (statMsg.act & 0x01), time);
-				emit valueChanged(uasId, "Motor2 status", "on/off", (statMsg.act & 0x02)>>1, time);
-				emit valueChanged(uasId, "Servo1 status", "on/off", (statMsg.act & 0x04)>>2, time);
-				emit valueChanged(uasId, "Servo2 status", "on/off", (statMsg.act & 0x08)>>3, time);
-				emit valueChanged(uasId, "Servo3 status", "on/off", (statMsg.act & 0x10)>>4, time);
-				emit valueChanged(uasId, "Servo4 status", "on/off", (statMsg.act & 0x20)>>5, time);
+				valueChangedRec(uasId, "Motor1 status", "on/off", (statMsg.act & 0x01), time);
+				valueChangedRec(uasId, "Motor2 status", "on/off", (statMsg.act & 0x02)>>1, time);
+				valueChangedRec(uasId, "Servo1 status", "on/off", (statMsg.act & 0x04)>>2, time);
+				valueChangedRec(uasId, "Servo2 status", "on/off", (statMsg.act & 0x08)>>3, time);
+				valueChangedRec(uasId, "Servo3 status", "on/off", (statMsg.act & 0x10)>>4, time);
+				valueChangedRec(uasId, "Servo4 status", "on/off", (statMsg.act & 0x20)>>5, time);
 				// check the current state of the sensesoar
 				this->senseSoarState = statMsg.mod;
-				emit valueChanged(uasId,"senseSoar status","-",this->senseSoarState,time);
+				valueChangedRec(uasId,"senseSoar status","-",this->senseSoarState,time);
 				// check the gps fixes
-				emit valueChanged(uasId,"Lat Long fix","true/false", (statMsg.gps & 0x01), time);
-				emit valueChanged(uasId,"Altitude fix","true/false", (statMsg.gps & 0x02), time);
-				emit valueChanged(uasId,"GPS horizontal accuracy","m",((statMsg.gps & 0x1C)>>2), time);
-				emit valueChanged(uasId,"GPS vertiacl accuracy","m",((statMsg.gps & 0xE0)>>5),time);
+				valueChangedRec(uasId,"Lat Long fix","true/false", (statMsg.gps & 0x01), time);
+				valueChangedRec(uasId,"Altitude fix","true/false", (statMsg.gps & 0x02), time);
+				valueChangedRec(uasId,"GPS horizontal accuracy","m",((statMsg.gps & 0x1C)>>2), time);
+				valueChangedRec(uasId,"GPS vertiacl accuracy","m",((statMsg.gps & 0xE0)>>5),time);
 				// Xbee RSSI
-				emit valueChanged(uasId, "Xbee strength", "%", statMsg.commRssi, time);
+				valueChangedRec(uasId, "Xbee strength", "%", statMsg.commRssi, time);
 				//emit valueChanged(uasId, "Xbee strength", "%", statMsg.gps, time);  // TO DO: define gps bits
 
 				break;
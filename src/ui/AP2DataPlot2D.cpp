@@ -51,6 +51,8 @@ This file is part of the APM_PLANNER project
 
 AP2DataPlot2D::AP2DataPlot2D(QWidget *parent) : QWidget(parent),
     m_updateTimer(nullptr),
+    m_telemetryTimer(nullptr),
+    m_replotRequired(false),
     m_graphCount(0),
     m_plot(nullptr),
     m_wideAxisRect(nullptr),
@@ -104,6 +106,10 @@ AP2DataPlot2D::AP2DataPlot2D(QWidget *parent) : QWidget(parent),
     ui.horizontalLayout_3->setStretch(0,5);
     ui.horizontalLayout_3->setStretch(1,1);
 
+    m_telemetryTimer = new QTimer(this);
+    connect(m_telemetryTimer,SIGNAL(timeout()),this,SLOT(readTelemetry()));
+    m_telemetryTimer->start(s_TelemetryReadIntervalMs);
+
     connect(UASManager::instance(),SIGNAL(activeUASSet(UASInterface*)),this,SLOT(activeUASSet(UASInterface*)));
     activeUASSet(UASManager::instance()->getActiveUAS());
 
@@ -159,6 +165,7 @@ void AP2DataPlot2D::graphColorsChanged(QMap<QString,QColor> colormap)
         m_graphClassMap[i.key()].axis->setTickLabelColor(i.value());
         m_graphClassMap[i.key()].axis->setTickLabelColor(i.value());
     }
+    m_replotRequired = true;
 }
 
 void AP2DataPlot2D::graphGroupingChanged(QList<AP2DataPlotAxisDialog::GraphRange> graphRangeList)
@@ -274,8 +281,8 @@ void AP2DataPlot2D::showEvent(QShowEvent *evt)
         m_updateTimer = nullptr;
     }
     m_updateTimer = new QTimer(this);
-    connect(m_updateTimer,SIGNAL(timeout()),m_plot,SLOT(replot()));
-    m_updateTimer->start(500);
+    connect(m_updateTimer,SIGNAL(timeout()),this,SLOT(replotOnlineData()));
+    m_updateTimer->start(s_ReplotIntervalMs);
     QWidget::showEvent(evt);
 }
 
@@ -429,7 +436,6 @@ void AP2DataPlot2D::activeUASSet(UASInterface* uas)
     }
     if (m_uas)
     {
-        disconnect(m_uas,SIGNAL(valueChanged(int,QString,QString,QVariant,quint64)),this,SLOT(valueChanged(int,QString,QString,QVariant,quint64)));
         disconnect(m_uas,SIGNAL(navModeChanged(int,int,QString)),this,SLOT(navModeChanged(int,int,QString)));
         disconnect(m_uas,SIGNAL(connected()),this,SLOT(connected()));
         disconnect(m_uas,SIGNAL(disconnected()),this,SLOT(disconnected()));
@@ -442,7 +448,17 @@ void AP2DataPlot2D::activeUASSet(UASInterface* uas)
     ui.horizontalScrollBar->blockSignals(false);
     m_uas = uas;
 
-    connect(m_uas,SIGNAL(valueChanged(int,QString,QString,QVariant,quint64)),this,SLOT(valueChanged(int,QString,QString,QVariant,quint64)));
+    // Only values received from now on are graphed
+    m_telemetryStorePtr = m_uas->getTelemetryStore();
+    m_telemetryStorePtr->enableHistory(s_TelemetryHistoryDepth);
+    m_storeKeyCounts.clear();
+    foreach (int key, m_telemetryStorePtr->keys())
+    {
+        UASTelemetryStore::Value value;
+        m_telemetryStorePtr->value(key, value);
+        m_storeKeyCounts.insert(key, value.m_count);
+    }
+
     connect(m_uas,SIGNAL(navModeChanged(int,int,QString)),this,SLOT(navModeChanged(int,int,QString)));
 
     //textMessageReceived(uasId, message.compid, severity, text);
@@ -499,112 +515,152 @@ void AP2DataPlot2D::navModeChanged(int uasid, int mode, const QString& text)
     plotTextArrow(index, text, ModeMessage::TypeName, QColor(50,125,0), ui.modeDisplayCheckBox);
 }
 
-void AP2DataPlot2D::updateValue(const int uasId, const QString& name, const QString& unit, const double value, const quint64 msec,bool integer)
+void AP2DataPlot2D::readTelemetry()
 {
-    Q_UNUSED(msec)
-    Q_UNUSED(unit)
-    if (m_uas->getUASID() != uasId)
+    if (!m_telemetryStorePtr)
     {
         return;
     }
 
-    QString propername;
-    QStringList parts = name.split(':');
-    if(parts.size() == 2)
+    QVector<UASTelemetryStore::Sample> samples;
+    UASTelemetryStore::Value value;
+    bool newSamples = false;
+    double latestKey = 0.0;
+    foreach (int key, m_telemetryStorePtr->keys())
     {
-        // name looks like M1:ATTITUDE.Pitch or M1:BATTERY_STATUS.voltages.0
-        propername  = parts[1];
+        QHash<int, QString>::const_iterator nameIter = m_storeKeyToName.constFind(key);
+        if (nameIter == m_storeKeyToName.constEnd())
+        {
+            QString propername;
+            QStringList parts = UASTelemetryStore::nameOf(key).split(':');
+            if(parts.size() == 2)
+            {
+                // name looks like M1:ATTITUDE.Pitch or M1:BATTERY_STATUS.voltages.0
+                propername  = parts[1];
+            }
+            nameIter = m_storeKeyToName.insert(key, propername);
+        }
+        if (nameIter.value().isEmpty() || !m_telemetryStorePtr->value(key, value))
+        {
+            continue;
+        }
+
+        samples.clear();
+        m_storeKeyCounts.insert(key, m_telemetryStorePtr->history(key, m_storeKeyCounts.value(key, 0), samples));
+        if (!samples.isEmpty())
+        {
+            latestKey = qMax(latestKey, appendOnlineSamples(nameIter.value(), samples, value.m_isInteger));
+            newSamples = true;
+        }
     }
 
-    if (!m_onlineValueMap.contains(propername))
+    if (!newSamples)
     {
-        ui.dataSelectionScreen->addItem(propername);
+        return;
     }
 
-    qint64 msec_current = QDateTime::currentMSecsSinceEpoch();
-    m_currentIndex = msec_current;
-    qint64 newmsec = (msec_current - m_startIndex);// + m_timeDiff;
+    // Scrolling is done once for all new samples
     if (m_graphCount > 0 && ui.autoScrollCheckBox->isChecked())
     {
-        double diff = (newmsec / 1000.0) - m_wideAxisRect->axis(QCPAxis::atBottom,0)->range().upper;
+        double diff = latestKey - m_wideAxisRect->axis(QCPAxis::atBottom,0)->range().upper;
         if (diff > 1.0)
         {
             m_wideAxisRect->axis(QCPAxis::atBottom,0)->setRangeLower(m_wideAxisRect->axis(QCPAxis::atBottom,0)->range().lower + diff);
-            m_wideAxisRect->axis(QCPAxis::atBottom,0)->setRangeUpper((newmsec / 1000.0));
+            m_wideAxisRect->axis(QCPAxis::atBottom,0)->setRangeUpper(latestKey);
         }
     }
-
-    if (m_graphClassMap.contains(propername))
+    if (m_graphCount > 0)
     {
-        m_graphClassMap[propername].axisIndex = newmsec / 1000.0;// + 18000000;
-        m_graphClassMap.value(propername).graph->addData(m_graphClassMap.value(propername).axisIndex,value);
-        m_scrollEndIndex = newmsec /  1000.0;
-        //ui.horizontalScrollBar->setMinimum(m_startIndex);
+        m_scrollEndIndex = latestKey;
         ui.horizontalScrollBar->setMaximum(m_scrollEndIndex);
-        //Set a timeout for 30 minutes from now, 1800 seconds.
-        qint64 current = QDateTime::currentMSecsSinceEpoch();
-        //This is 30 minutes
-        m_onlineValueTimeoutList.append(QPair<qint64,double>(current + 1800000,msec));
-        //This is 1 minute
-        //m_onlineValueTimeoutList.append(QPair<qint64,double>(current + 60000,m_currentIndex));
-        if (m_onlineValueTimeoutList[0].first <= current)
+    }
+    m_replotRequired = true;
+}
+
+double AP2DataPlot2D::appendOnlineSamples(const QString& propername, const QVector<UASTelemetryStore::Sample>& samples, bool integer)
+{
+    QHash<QString,AP2DataPlotOnlineBuffer>::iterator bufferIter = m_onlineBuffers.find(propername);
+    if (bufferIter == m_onlineBuffers.end())
+    {
+        ui.dataSelectionScreen->addItem(propername);
+        bufferIter = m_onlineBuffers.insert(propername, AP2DataPlotOnlineBuffer(s_OnlineBufferCapacity));
+    }
+    AP2DataPlotOnlineBuffer &buffer = bufferIter.value();
+
+    QVector<double> keys;
+    QVector<double> values;
+    keys.reserve(samples.size());
+    values.reserve(samples.size());
+    QCPRange batchRange(samples.first().m_value, samples.first().m_value);
+    foreach (const UASTelemetryStore::Sample &sample, samples)
+    {
+        const qint64 groundTimeMsecs = static_cast<qint64>(sample.m_groundTimeUsecs / 1000);
+        const double key = (groundTimeMsecs - m_startIndex) / 1000.0;
+        buffer.append(key, sample.m_value);
+        keys.append(key);
+        values.append(sample.m_value);
+        batchRange.expand(sample.m_value);
+        m_currentIndex = groundTimeMsecs;
+    }
+
+    QMap<QString,Graph>::iterator graphIter = m_graphClassMap.find(propername);
+    if (graphIter == m_graphClassMap.end())
+    {
+        return keys.last();
+    }
+
+    Graph &graph = graphIter.value();
+    graph.axisIndex = keys.last();
+    graph.graph->addData(keys, values, true);
+    // The graph holds the same window as the buffer
+    graph.graph->data()->removeBefore(buffer.firstKey());
+
+    if (graph.groupName != "" && graph.groupName != "MANUAL")
+    {
+        //Current graph is in a group
+        QCPRange &groupRange = m_graphGroupRanges[graph.groupName];
+        if (!groupRange.contains(batchRange.lower) || !groupRange.contains(batchRange.upper))
         {
-            for (QMap<QString,Graph>::const_iterator i = m_graphClassMap.constBegin();i!=m_graphClassMap.constEnd();i++)
+            //It's out of scale for the group, expand it.
+            groupRange.expand(batchRange);
+            foreach (const QString &groupGraph, m_graphGrouping.value(graph.groupName))
             {
-//                i.value().graph->removeData(0,m_onlineValueTimeoutList[0].second);
+                m_graphClassMap.value(groupGraph).axis->setRange(groupRange);
             }
-            m_onlineValueTimeoutList.removeAt(0);
-        }
-        if (m_graphClassMap.value(propername).groupName != "" && m_graphClassMap.value(propername).groupName != "MANUAL")
-        {
-            //Current graph is in a group
-            if (!m_graphGroupRanges[m_graphClassMap.value(propername).groupName].contains(value))
+            if (m_axisGroupingDialog)
             {
-                //It's out of scale for the group, expand it.
-                if (m_graphGroupRanges[m_graphClassMap.value(propername).groupName].lower > value)
-                {
-                    m_graphGroupRanges[m_graphClassMap.value(propername).groupName].lower = value;
-                }
-                else if (m_graphGroupRanges[m_graphClassMap.value(propername).groupName].upper < value)
-                {
-                    m_graphGroupRanges[m_graphClassMap.value(propername).groupName].upper = value;
-                }
-                for (int i=0;i<m_graphGrouping[m_graphClassMap.value(propername).groupName].size();i++)
-                {
-                    m_graphClassMap.value(m_graphGrouping[m_graphClassMap.value(propername).groupName][i]).axis->setRange(m_graphGroupRanges[m_graphClassMap.value(propername).groupName]);
-                }
-                if (m_axisGroupingDialog)
-                {
-                    m_axisGroupingDialog->updateAxis(propername,m_graphClassMap.value(propername).axis->range().lower,m_graphClassMap.value(propername).axis->range().upper);
-                }
+                m_axisGroupingDialog->updateAxis(propername,graph.axis->range().lower,graph.axis->range().upper);
             }
         }
-        else if (!m_graphClassMap.value(propername).graph->keyAxis()->range().contains(value) && !m_graphClassMap.value(propername).isManualRange)
+    }
+    else if (!graph.isManualRange &&
+             (!graph.axis->range().contains(batchRange.lower) || !graph.axis->range().contains(batchRange.upper)))
+    {
+        // The buffer knows its value range, no need to scan the graph data
+        QCPRange range(buffer.minValue(), buffer.maxValue());
+        if (range.size() <= 0.0)
         {
-            m_graphClassMap.value(propername).graph->rescaleValueAxis();
-            if (m_axisGroupingDialog)
-            {
-                m_axisGroupingDialog->updateAxis(propername,m_graphClassMap.value(propername).axis->range().lower,m_graphClassMap.value(propername).axis->range().upper);
-            }
+            range = QCPRange(range.lower - 1.0, range.upper + 1.0);
         }
-        if (integer)
+        graph.axis->setRange(range);
+        if (m_axisGroupingDialog)
         {
-            m_graphClassMap.value(propername).axis->setNumberPrecision(0);
+            m_axisGroupingDialog->updateAxis(propername,graph.axis->range().lower,graph.axis->range().upper);
         }
     }
-    m_onlineValueMap[propername].append(QPair<double,double>(newmsec / 1000.0,value));
+    if (integer)
+    {
+        graph.axis->setNumberPrecision(0);
+    }
+    return keys.last();
 }
 
-void AP2DataPlot2D::valueChanged(const int uasId, const QString& name, const QString& unit, const QVariant& value,const quint64 msec)
+void AP2DataPlot2D::replotOnlineData()
 {
-    QMetaType::Type metaType(static_cast<QMetaType::Type>(value.type()));
-    if (metaType == QMetaType::Double || metaType == QMetaType::Float)
-    {
-        updateValue(uasId,name,unit,value.toDouble(),msec,false);
-    }
-    else
+    if (m_replotRequired)
     {
-        updateValue(uasId,name,unit,static_cast<double>(value.toInt()),msec);
+        m_replotRequired = false;
+        m_plot->replot();
     }
 }
 
@@ -663,27 +719,13 @@ AP2DataPlot2D::~AP2DataPlot2D()
 
 void AP2DataPlot2D::itemEnabled(QString name)
 {
-    if (m_onlineValueMap.contains(name))
+    QHash<QString,AP2DataPlotOnlineBuffer>::const_iterator bufferIter = m_onlineBuffers.constFind(name);
+    if (bufferIter != m_onlineBuffers.constEnd() && !bufferIter.value().isEmpty())
     {
         QVector<double> xlist;
         QVector<double> ylist;
+        bufferIter.value().copyTo(xlist, ylist);
 
-        double min = m_onlineValueMap[name][0].second;
-        double max = m_onlineValueMap[name][0].second;
-        for (int j=0;j<m_onlineValueMap[name].size();j++)
-        {
-            xlist.append(m_onlineValueMap[name][j].first);
-            double val = m_onlineValueMap[name][j].second;
-            if (val > max)
-            {
-                max = val;
-            }
-            if (val < min)
-            {
-                min = val;
-            }
-            ylist.append(val);
-        }
         QCPAxis *axis = m_wideAxisRect->addAxis(QCPAxis::atLeft);
         axis->setLabel(name);
         QColor color = QColor::fromRgb(rand()%255,rand()%255,rand()%255);
@@ -692,7 +734,7 @@ void AP2DataPlot2D::itemEnabled(QString name)
         axis->setNumberFormat("f");
         QCPGraph *mainGraph1 = m_plot->addGraph(m_wideAxisRect->axis(QCPAxis::atBottom), m_wideAxisRect->axis(QCPAxis::atLeft,m_graphCount++));
         m_graphNameList.append(name);
-        mainGraph1->setData(xlist, ylist);
+        mainGraph1->setData(xlist, ylist, true);
         mainGraph1->rescaleValueAxis();
 
         if (m_graphCount == 1)
@@ -717,6 +759,7 @@ void AP2DataPlot2D::itemEnabled(QString name)
         m_graphClassMap[name] = graph;
 
         mainGraph1->setPen(QPen(color, 1));
+        m_replotRequired = true;
     }
 }
 
@@ -772,7 +815,7 @@ void AP2DataPlot2D::clearGraph()
 
     m_currentIndex = QDateTime::currentMSecsSinceEpoch();
     m_startIndex = m_currentIndex;
-    m_onlineValueMap.clear();
+    m_onlineBuffers.clear();
     m_plot->replot();
 }
 
@@ -816,6 +859,7 @@ void AP2DataPlot2D::plotTextArrow(double index, const QString &text, const QStri
         itemtext->setVisible(false);
         itemline->setVisible(false);
     }
+    m_replotRequired = true;
 }
 
 
@@ -829,6 +873,7 @@ void AP2DataPlot2D::removeTextArrows(const QString &graphName)
         }
         m_graphClassMap[graphName].itemList.clear();
     }
+    m_replotRequired = true;
 }
 
 void AP2DataPlot2D::showLogDownloadDialog()
@@ -868,6 +913,7 @@ void AP2DataPlot2D::hideShowTextArrows(bool checked, const QString &type)
     {
         m_graphClassMap[type].itemList.at(i)->setVisible(checked);
     }
+    m_replotRequired = true;
 }
 
 void AP2DataPlot2D::childGraphDestroyed(QObject *obj)
@@ -38,6 +38,7 @@ This file is part of the APM_PLANNER project
 #include "AP2DataPlotThread.h"
 #include "dataselectionscreen.h"
 #include "AP2DataPlotAxisDialog.h"
+#include "AP2DataPlotOnlineBuffer.h"
 #include "ui_AP2DataPlot2D.h"
 
 #include <QWidget>
@@ -46,6 +47,7 @@ This file is part of the APM_PLANNER project
 #include <QTextBrowser>
 #include <QSqlDatabase>
 #include <QStandardItemModel>
+#include <QHash>
 
 #include "Loghandling/LogdataStorage.h"
 
@@ -85,10 +87,10 @@ private slots:
     //Called to add an item to the graph
     void itemEnabled(QString name);
 
-    //ValueChanged functions for getting mavlink values
-    void valueChanged(const int uasid, const QString& name, const QString& unit, const QVariant& value,const quint64 msecs);
-    //Called by every valueChanged function to actually save the value/graph it.
-    void updateValue(const int uasId, const QString& name, const QString& unit, const double value, const quint64 msec,bool integer = true);
+    //Reads the new values of the active UAS from its telemetry store
+    void readTelemetry();
+    //Replots if online data was added since the last replot
+    void replotOnlineData();
 
     void navModeChanged(int uasid, int mode, const QString& text);
 
@@ -110,6 +112,10 @@ private slots:
 
 private:
 
+    //Called with all new samples of one value read from the telemetry store to save and graph them.
+    //Returns the key (x axis) of the latest sample.
+    double appendOnlineSamples(const QString& propername, const QVector<UASTelemetryStore::Sample>& samples, bool integer);
+
     void showEvent(QShowEvent *evt) override;
     void hideEvent(QHideEvent *evt) override;
 
@@ -136,7 +142,16 @@ private:
 private:
     Ui::AP2DataPlot2D ui;
 
+    static constexpr int s_TelemetryReadIntervalMs = 100;  /// Interval for reading the telemetry store
+    static constexpr int s_TelemetryHistoryDepth = 64;      /// Samples per value kept by the store between two reads
+    static constexpr int s_OnlineBufferCapacity = 6000;     /// Samples per value kept for the online graphs
+    static constexpr int s_ReplotIntervalMs = 500;          /// Max replot rate of the online graphs
+
     QTimer *m_updateTimer;
+    QTimer *m_telemetryTimer;                       /// Triggers readTelemetry()
+    UASTelemetryStore::Ptr m_telemetryStorePtr;     /// Telemetry values of the active UAS
+    QHash<int, QString> m_storeKeyToName;           /// Graph name of the telemetry store keys
+    QHash<int, quint64> m_storeKeyCounts;           /// Value count of the telemetry store keys already graphed
 
     struct Graph
     {
@@ -156,13 +171,12 @@ private:
     QMap<QString,QList<QString> > m_graphGrouping;
     //Map from group titles to the value axis range.
     QMap<QString,QCPRange> m_graphGroupRanges;
-    //Graph name to list of values for "online" mode
-    QMap<QString,QList<QPair<double,double> > > m_onlineValueMap;
+    //Graph name to latest values for "online" mode
+    QHash<QString,AP2DataPlotOnlineBuffer> m_onlineBuffers;
+    bool m_replotRequired;                                  /// Online data was added since the last replot
     // Child windows which were opened by open log
     QList<QWidget*> m_childGraphList;
 
-    QList<QPair<qint64,double> > m_onlineValueTimeoutList;
-
     //List of graph names, used in m_axisList, m_graphMap,m_graphToGroupMap and the like as the graph name
     QList<QString> m_graphNameList;
     // number of active graphs
@@ -0,0 +1,137 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file AP2DataPlotOnlineBuffer.cc
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the sample ring buffer of the AP2DataPlot online mode
+ */
+
+#include "AP2DataPlotOnlineBuffer.h"
+
+AP2DataPlotOnlineBuffer::AP2DataPlotOnlineBuffer(int capacity) :
+    m_capacity(capacity > 0 ? capacity : 1),
+    m_first(0),
+    m_size(0),
+    m_minValue(0.0),
+    m_maxValue(0.0),
+    m_valueRangeValid(false)
+{}
+
+void AP2DataPlotOnlineBuffer::append(double key, double value)
+{
+    if (m_size < m_capacity)
+    {
+        // The storage grows with the samples, so short lived values stay small
+        m_keys.append(key);
+        m_values.append(value);
+        ++m_size;
+    }
+    else
+    {
+        const double dropped = m_values.at(m_first);
+        if (m_valueRangeValid && (dropped <= m_minValue || dropped >= m_maxValue))
+        {
+            m_valueRangeValid = false;
+        }
+        m_keys[m_first] = key;
+        m_values[m_first] = value;
+        m_first = (m_first + 1) % m_capacity;
+    }
+
+    if (m_size == 1)
+    {
+        m_minValue = value;
+        m_maxValue = value;
+        m_valueRangeValid = true;
+    }
+    else if (m_valueRangeValid)
+    {
+        m_minValue = qMin(m_minValue, value);
+        m_maxValue = qMax(m_maxValue, value);
+    }
+}
+
+int AP2DataPlotOnlineBuffer::size() const
+{
+    return m_size;
+}
+
+bool AP2DataPlotOnlineBuffer::isEmpty() const
+{
+    return m_size == 0;
+}
+
+double AP2DataPlotOnlineBuffer::firstKey() const
+{
+    return m_keys.at(m_first);
+}
+
+double AP2DataPlotOnlineBuffer::minValue() const
+{
+    updateValueRange();
+    return m_minValue;
+}
+
+double AP2DataPlotOnlineBuffer::maxValue() const
+{
+    updateValueRange();
+    return m_maxValue;
+}
+
+void AP2DataPlotOnlineBuffer::copyTo(QVector<double> &keys, QVector<double> &values) const
+{
+    keys.clear();
+    values.clear();
+    keys.reserve(m_size);
+    values.reserve(m_size);
+    for (int i = 0; i < m_size; ++i)
+    {
+        const int index = (m_first + i) % m_size;
+        keys.append(m_keys.at(index));
+        values.append(m_values.at(index));
+    }
+}
+
+void AP2DataPlotOnlineBuffer::clear()
+{
+    m_keys.clear();
+    m_values.clear();
+    m_first = 0;
+    m_size = 0;
+    m_valueRangeValid = false;
+}
+
+void AP2DataPlotOnlineBuffer::updateValueRange() const
+{
+    if (m_valueRangeValid || m_size == 0)
+    {
+        return;
+    }
+    m_minValue = m_values.at(0);
+    m_maxValue = m_values.at(0);
+    for (int i = 1; i < m_size; ++i)
+    {
+        m_minValue = qMin(m_minValue, m_values.at(i));
+        m_maxValue = qMax(m_maxValue, m_values.at(i));
+    }
+    m_valueRangeValid = true;
+}
@@ -0,0 +1,110 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file AP2DataPlotOnlineBuffer.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the sample ring buffer of the AP2DataPlot online mode
+ */
+
+#ifndef AP2DATAPLOTONLINEBUFFER_H
+#define AP2DATAPLOTONLINEBUFFER_H
+
+#include <QVector>
+
+/**
+ * @brief The AP2DataPlotOnlineBuffer class holds the latest samples of one value
+ *        in a ring buffer of fixed capacity. When the buffer is full the oldest
+ *        sample is dropped, so a long online session does not grow the memory.
+ *        Keeps track of the value range of its content, which is only recalculated
+ *        if a dropped sample was an extreme value.
+ */
+class AP2DataPlotOnlineBuffer
+{
+public:
+    /**
+     * @brief AP2DataPlotOnlineBuffer - CTOR
+     * @param capacity - max number of samples to hold
+     */
+    explicit AP2DataPlotOnlineBuffer(int capacity = 0);
+
+    /**
+     * @brief append adds a sample. Drops the oldest one if the buffer is full.
+     *        The keys must be appended in ascending order.
+     * @param key - key (time) of the sample
+     * @param value - the value
+     */
+    void append(double key, double value);
+
+    /**
+     * @brief size
+     * @return - number of samples in the buffer
+     */
+    int size() const;
+
+    /**
+     * @brief isEmpty
+     * @return - true if the buffer holds no sample
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief firstKey returns the key of the oldest sample. Buffer must not be empty.
+     */
+    double firstKey() const;
+
+    /**
+     * @brief minValue returns the smallest value in the buffer. Buffer must not be empty.
+     */
+    double minValue() const;
+
+    /**
+     * @brief maxValue returns the largest value in the buffer. Buffer must not be empty.
+     */
+    double maxValue() const;
+
+    /**
+     * @brief copyTo copies all samples oldest first.
+     * @param keys - the keys are stored here
+     * @param values - the values are stored here
+     */
+    void copyTo(QVector<double> &keys, QVector<double> &values) const;
+
+    /**
+     * @brief clear removes all samples
+     */
+    void clear();
+
+private:
+    void updateValueRange() const;
+
+    int m_capacity;                 ///< Max number of samples
+    int m_first;                    ///< Index of the oldest sample
+    int m_size;                     ///< Number of samples
+    QVector<double> m_keys;         ///< Ring of keys, grows up to m_capacity
+    QVector<double> m_values;       ///< Ring of values, grows up to m_capacity
+
+    mutable double m_minValue;      ///< Smallest value, valid if m_valueRangeValid
+    mutable double m_maxValue;      ///< Largest value, valid if m_valueRangeValid
+    mutable bool m_valueRangeValid; ///< False if an extreme value was dropped
+};
+
+#endif // AP2DATAPLOTONLINEBUFFER_H
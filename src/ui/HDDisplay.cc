@@ -31,6 +31,7 @@
 HDDisplay::HDDisplay(QStringList* plotList, QString title, QWidget *parent) :
     QGraphicsView(parent),
     uas(NULL),
+    lastStoreGeneration(0),
     xCenterOffset(0.0f),
     yCenterOffset(0.0f),
     vwidth(80.0f),
@@ -52,7 +53,6 @@ HDDisplay::HDDisplay(QStringList* plotList, QString title, QWidget *parent) :
     acceptUnitList(new QStringList()),
     lastPaintTime(0),
     columns(3),
-    valuesChanged(true),
     m_ui(NULL)
 {
     setWindowTitle(title);
@@ -170,6 +170,12 @@ void HDDisplay::enableGLRendering(bool enable)
 
 void HDDisplay::triggerUpdate()
 {
+    // Only repaint if the monitored uas received new values
+    if (!telemetryStore || telemetryStore->generation() == lastStoreGeneration)
+    {
+        return;
+    }
+    lastStoreGeneration = telemetryStore->generation();
     // Only repaint the regions necessary
     update(this->geometry());
 }
@@ -287,8 +293,10 @@ void HDDisplay::removeItemByAction()
 void HDDisplay::addGauge()
 {
     QStringList items;
-    for (int i = 0; i < values.count(); ++i) {
-        QString key = values.keys().at(i);
+    const QVector<int> storeKeyList = telemetryStore ? telemetryStore->keys() : QVector<int>();
+    foreach (int storeKey, storeKeyList) {
+        const QString storeName = UASTelemetryStore::nameOf(storeKey);
+        QString key = storeName.mid(storeName.indexOf(':') + 1);
         QString label = key;
         QStringList keySplit = key.split(".");
         if (keySplit.size() > 1)
@@ -296,7 +304,7 @@ void HDDisplay::addGauge()
             keySplit.removeFirst();
             label = keySplit.join(".");
         }
-        QString unit = units.value(key);
+        QString unit = UASTelemetryStore::unitOf(storeKey);
         if (unit.contains("deg") || unit.contains("rad")) {
             items.append(QString("%1,%2,%3,%4,%5,s").arg("-180").arg(key).arg(unit).arg("+180").arg(label));
         } else {
@@ -421,7 +429,7 @@ void HDDisplay::setTitle()
 
 void HDDisplay::renderOverlay()
 {
-    if (!valuesChanged || !isVisible()) return;
+    if (!isVisible()) return;
 
 #if (QGC_EVENTLOOP_DEBUG)
     QLOG_DEBUG() << "EVENTLOOP:" << __FILE__ << __LINE__;
@@ -460,11 +468,19 @@ void HDDisplay::renderOverlay()
     float topSpacing = leftSpacing;
     float yCoord = topSpacing + gaugeWidth/2.0f;
 
+    UASTelemetryStore::Value storeValue;
     for (int i = 0; i < acceptList->size(); ++i)
     {
         QString value = acceptList->at(i);
         QString label = customNames.value(value);
-        drawGauge(xCoord, yCoord, gaugeWidth/2.0f, minValues.value(value, -1.0f), maxValues.value(value, 1.0f), label, values.value(value, minValues.value(value, 0.0f)), gaugeColor, &painter, symmetric.value(value, false), goodRanges.value(value, qMakePair(0.0f, 0.5f)), critRanges.value(value, qMakePair(0.7f, 1.0f)), true);
+        float gaugeValue = minValues.value(value, 0.0f);
+        bool integer = false;
+        if (telemetryValue(value, acceptUnitList->value(i), storeValue))
+        {
+            gaugeValue = storeValue.m_value;
+            integer = storeValue.m_isInteger;
+        }
+        drawGauge(xCoord, yCoord, gaugeWidth/2.0f, minValues.value(value, -1.0f), maxValues.value(value, 1.0f), label, gaugeValue, gaugeColor, &painter, symmetric.value(value, false), goodRanges.value(value, qMakePair(0.0f, 0.5f)), critRanges.value(value, qMakePair(0.7f, 1.0f)), true, integer);
         xCoord += gaugeWidth + leftSpacing;
         // Move one row down if necessary
         if (xCoord + gaugeWidth*0.9f > vwidth)
@@ -483,14 +499,9 @@ void HDDisplay::setActiveUAS(UASInterface* uas)
 {
     if (!uas)
         return;
-    // Disconnect any previously connected active UAS
-    if (this->uas != NULL) {
-        removeSource(this->uas);
-    }
-
-    // Now connect the new UAS
-	addSource(uas);
     this->uas = uas;
+    telemetryStore = uas->getTelemetryStore();
+    lastStoreGeneration = 0;
 }
 
 /**
@@ -578,7 +589,7 @@ void HDDisplay::drawChangeRateStrip(float xRef, float yRef, float height, float
     paintText(label, defaultColor, 3.0f, xRef+width/2.0f, yRef+height-((scaledValue - minRate)/(maxRate-minRate))*height - 1.6f, painter);
 }
 
-void HDDisplay::drawGauge(float xRef, float yRef, float radius, float min, float max, QString name, float value, const QColor& color, QPainter* painter, bool symmetric, QPair<float, float> goodRange, QPair<float, float> criticalRange, bool solid)
+void HDDisplay::drawGauge(float xRef, float yRef, float radius, float min, float max, QString name, float value, const QColor& color, QPainter* painter, bool symmetric, QPair<float, float> goodRange, QPair<float, float> criticalRange, bool solid, bool integer)
 {
     // Draw the circle
     QPen circlePen(Qt::SolidLine);
@@ -625,7 +636,7 @@ void HDDisplay::drawGauge(float xRef, float yRef, float radius, float min, float
     QString label;
 
     // Show integer values without decimal places
-    if (intValues.contains(name)) {
+    if (integer) {
         label.asprintf("% 05d", (int)value);
     } else {
         label.asprintf("% 06.1f", value);
@@ -699,14 +710,16 @@ void HDDisplay::drawGauge(float xRef, float yRef, float radius, float min, float
 
 void HDDisplay::drawSystemIndicator(float xRef, float yRef, int maxNum, float maxWidth, float maxHeight, QPainter* painter)
 {
-    if (values.size() > 0) {
-        QString selectedKey = values.begin().key();
+    const QVector<int> storeKeyList = telemetryStore ? telemetryStore->keys() : QVector<int>();
+    if (storeKeyList.size() > 0) {
+        const int selectedKey = storeKeyList.first();
         //   | | | | | |
         //   | | | | | |
         //   x speed: 2.54
 
         // One column per value
-        QMapIterator<QString, double> value(values);
+        QVectorIterator<int> key(storeKeyList);
+        UASTelemetryStore::Value value;
 
         float x = xRef;
         float y = yRef;
@@ -717,14 +730,14 @@ void HDDisplay::drawSystemIndicator(float xRef, float yRef, int maxNum, float ma
         const float hspacing = 0.6f;
 
         int i = 0;
-        while (value.hasNext() && i < maxNum && x < maxWidth && y < maxHeight) {
-            value.next();
+        while (key.hasNext() && i < maxNum && x < maxWidth && y < maxHeight) {
+            telemetryStore->value(key.next(), value);
             QBrush brush(Qt::SolidPattern);
 
 
-            if (value.value() < 0.01f && value.value() > -0.01f) {
+            if (value.m_value < 0.01f && value.m_value > -0.01f) {
                 brush.setColor(Qt::gray);
-            } else if (value.value() > 0.01f) {
+            } else if (value.m_value > 0.01f) {
                 brush.setColor(Qt::blue);
             } else {
                 brush.setColor(Qt::yellow);
@@ -752,10 +765,10 @@ void HDDisplay::drawSystemIndicator(float xRef, float yRef, int maxNum, float ma
         // Draw detail label
         QString detail = "NO DATA AVAILABLE";
 
-        if (values.contains(selectedKey)) {
-            detail = values.find(selectedKey).key();
+        if (telemetryStore->value(selectedKey, value)) {
+            detail = UASTelemetryStore::nameOf(selectedKey);
             detail.append(": ");
-            detail.append(QString::number(values.find(selectedKey).value()));
+            detail.append(QString::number(value.m_value));
         }
         paintText(detail, QColor(255, 255, 255), 3.0f, xRef, yRef+3.0f*(height+hspacing)+1.0f, painter);
     }
@@ -844,102 +857,33 @@ float HDDisplay::refLineWidthToPen(float line)
     return line * 2.50f;
 }
 
-// Connect a generic source
-void HDDisplay::addSource(QObject* obj)
+bool HDDisplay::telemetryValue(const QString& name, const QString& unit, UASTelemetryStore::Value& value)
 {
-    if (obj)
+    if (!telemetryStore)
     {
-        connect(obj, SIGNAL(valueChanged(int,QString,QString,qint8,quint64)), this, SLOT(updateValue(int,QString,QString,qint8,quint64)));
-        connect(obj, SIGNAL(valueChanged(int,QString,QString,quint8,quint64)), this, SLOT(updateValue(int,QString,QString,quint8,quint64)));
-        connect(obj, SIGNAL(valueChanged(int,QString,QString,qint16,quint64)), this, SLOT(updateValue(int,QString,QString,qint16,quint64)));
-        connect(obj, SIGNAL(valueChanged(int,QString,QString,quint16,quint64)), this, SLOT(updateValue(int,QString,QString,quint16,quint64)));
-        connect(obj, SIGNAL(valueChanged(int,QString,QString,qint32,quint64)), this, SLOT(updateValue(int,QString,QString,qint32,quint64)));
-        connect(obj, SIGNAL(valueChanged(int,QString,QString,quint32,quint64)), this, SLOT(updateValue(int,QString,QString,quint32,quint64)));
-        connect(obj, SIGNAL(valueChanged(int,QString,QString,quint64,quint64)), this, SLOT(updateValue(int,QString,QString,quint64,quint64)));
-        connect(obj, SIGNAL(valueChanged(int,QString,QString,qint64,quint64)), this, SLOT(updateValue(int,QString,QString,qint64,quint64)));
-        connect(obj, SIGNAL(valueChanged(int,QString,QString,double,quint64)), this, SLOT(updateValue(int,QString,QString,double,quint64)));
+        return false;
     }
-}
-
-// Disconnect a generic source
-void HDDisplay::removeSource(QObject* obj)
-{
-    if (obj)
+    // Map new store keys to the variable name without the component prefix (M1:)
+    foreach (int key, telemetryStore->keys())
     {
-        disconnect(obj, SIGNAL(valueChanged(int,QString,QString,qint8,quint64)), this, SLOT(updateValue(int,QString,QString,qint8,quint64)));
-        disconnect(obj, SIGNAL(valueChanged(int,QString,QString,quint8,quint64)), this, SLOT(updateValue(int,QString,QString,quint8,quint64)));
-        disconnect(obj, SIGNAL(valueChanged(int,QString,QString,qint16,quint64)), this, SLOT(updateValue(int,QString,QString,qint16,quint64)));
-        disconnect(obj, SIGNAL(valueChanged(int,QString,QString,quint16,quint64)), this, SLOT(updateValue(int,QString,QString,quint16,quint64)));
-        disconnect(obj, SIGNAL(valueChanged(int,QString,QString,qint32,quint64)), this, SLOT(updateValue(int,QString,QString,qint32,quint64)));
-        disconnect(obj, SIGNAL(valueChanged(int,QString,QString,quint32,quint64)), this, SLOT(updateValue(int,QString,QString,quint32,quint64)));
-        disconnect(obj, SIGNAL(valueChanged(int,QString,QString,quint64,quint64)), this, SLOT(updateValue(int,QString,QString,quint64,quint64)));
-        disconnect(obj, SIGNAL(valueChanged(int,QString,QString,qint64,quint64)), this, SLOT(updateValue(int,QString,QString,qint64,quint64)));
-        disconnect(obj, SIGNAL(valueChanged(int,QString,QString,double,quint64)), this, SLOT(updateValue(int,QString,QString,double,quint64)));
+        if (!knownStoreKeys.contains(key))
+        {
+            knownStoreKeys.insert(key);
+            const QString storeName = UASTelemetryStore::nameOf(key);
+            storeKeys.insert(storeName.mid(storeName.indexOf(':') + 1), key);
+        }
     }
-}
-
-void HDDisplay::updateValue(const int uasId, const QString& name, const QString& unit, const qint8 value, const quint64 msec)
-{
-    if (!intValues.contains(name)) intValues.insert(name, true);
-    updateValue(uasId, name, unit, (double)value, msec);
-}
-
-void HDDisplay::updateValue(const int uasId, const QString& name, const QString& unit, const quint8 value, const quint64 msec)
-{
-    if (!intValues.contains(name)) intValues.insert(name, true);
-    updateValue(uasId, name, unit, (double)value, msec);
-}
-
-void HDDisplay::updateValue(const int uasId, const QString& name, const QString& unit, const qint16 value, const quint64 msec)
-{
-    if (!intValues.contains(name)) intValues.insert(name, true);
-    updateValue(uasId, name, unit, (double)value, msec);
-}
-
-void HDDisplay::updateValue(const int uasId, const QString& name, const QString& unit, const quint16 value, const quint64 msec)
-{
-    if (!intValues.contains(name)) intValues.insert(name, true);
-    updateValue(uasId, name, unit, (double)value, msec);
-}
 
-void HDDisplay::updateValue(const int uasId, const QString& name, const QString& unit, const qint32 value, const quint64 msec)
-{
-    if (!intValues.contains(name)) intValues.insert(name, true);
-    updateValue(uasId, name, unit, (double)value, msec);
-}
-
-void HDDisplay::updateValue(const int uasId, const QString& name, const QString& unit, const quint32 value, const quint64 msec)
-{
-    if (!intValues.contains(name)) intValues.insert(name, true);
-    updateValue(uasId, name, unit, (double)value, msec);
-}
-
-void HDDisplay::updateValue(const int uasId, const QString& name, const QString& unit, const qint64 value, const quint64 msec)
-{
-    if (!intValues.contains(name)) intValues.insert(name, true);
-    updateValue(uasId, name, unit, (double)value, msec);
-}
-
-void HDDisplay::updateValue(const int uasId, const QString& name, const QString& unit, const quint64 value, const quint64 msec)
-{
-    if (!intValues.contains(name)) intValues.insert(name, true);
-    updateValue(uasId, name, unit, (double)value, msec);
-}
-
-void HDDisplay::updateValue(const int uasId, const QString& name, const QString& unit, const double value, const quint64 msec)
-{
-    Q_UNUSED(uasId);
-    Q_UNUSED(unit);
-    // Update mean
-    const float oldMean = valuesMean.value(name, 0.0f);
-    const int meanCount = valuesCount.value(name, 0);
-    valuesMean.insert(name, (oldMean * meanCount +  value) / (meanCount + 1));
-    valuesCount.insert(name, meanCount + 1);
-    valuesDot.insert(name, (value - values.value(name, 0.0f)) / ((msec - lastUpdate.value(name, 0))/1000.0f));
-    if (values.value(name, 0.0) != value) valuesChanged = true;
-    values.insert(name, value);
-    units.insert(name, unit);
-    lastUpdate.insert(name, msec);
+    // Prefer the variable with the matching unit
+    const QList<int> keys = storeKeys.values(name);
+    foreach (int key, keys)
+    {
+        if (UASTelemetryStore::unitOf(key) == unit)
+        {
+            return telemetryStore->value(key, value);
+        }
+    }
+    return !keys.isEmpty() && telemetryStore->value(keys.first(), value);
 }
 
 /**
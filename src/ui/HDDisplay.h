@@ -40,6 +40,8 @@ This file is part of the QGROUNDCONTROL project
 #include <QMap>
 #include <QContextMenuEvent>
 #include <QPair>
+#include <QMultiHash>
+#include <QSet>
 
 #include "UASInterface.h"
 
@@ -64,31 +66,7 @@ public:
     ~HDDisplay();
 
 public slots:
-    /** @brief Update the HDD with new int8 data */
-    void updateValue(const int uasId, const QString& name, const QString& unit, const qint8 value, const quint64 msec);
-    /** @brief Update the HDD with new uint8 data */
-    void updateValue(const int uasId, const QString& name, const QString& unit, const quint8 value, const quint64 msec);
-    /** @brief Update the HDD with new int16 data */
-    void updateValue(const int uasId, const QString& name, const QString& unit, const qint16 value, const quint64 msec);
-    /** @brief Update the HDD with new uint16 data */
-    void updateValue(const int uasId, const QString& name, const QString& unit, const quint16 value, const quint64 msec);
-    /** @brief Update the HDD with new int32 data */
-    void updateValue(const int uasId, const QString& name, const QString& unit, const qint32 value, const quint64 msec);
-    /** @brief Update the HDD with new uint32 data */
-    void updateValue(const int uasId, const QString& name, const QString& unit, const quint32 value, const quint64 msec);
-    /** @brief Update the HDD with new int64 data */
-    void updateValue(const int uasId, const QString& name, const QString& unit, const qint64 value, const quint64 msec);
-    /** @brief Update the HDD with new uint64 data */
-    void updateValue(const int uasId, const QString& name, const QString& unit, const quint64 value, const quint64 msec);
-    /** @brief Update the HDD with new double data */
-    void updateValue(const int uasId, const QString& name, const QString& unit, const double value, const quint64 msec);
-	
     virtual void setActiveUAS(UASInterface* uas);
-	
-	/** @brief Connects a source to the updateValue() signals */
-    void addSource(QObject* obj);
-	/** @brief Disconnects a source to the updateValue() signals */
-    void removeSource(QObject* obj);
 
     /** @brief Removes a plot item by the action data */
     void removeItemByAction();
@@ -137,7 +115,7 @@ protected:
 
     void drawChangeRateStrip(float xRef, float yRef, float height, float minRate, float maxRate, float value, QPainter* painter);
     void drawChangeIndicatorGauge(float xRef, float yRef, float radius, float expectedMaxChange, float value, const QColor& color, QPainter* painter, bool solid=true);
-    void drawGauge(float xRef, float yRef, float radius, float min, float max, const QString name, float value, const QColor& color, QPainter* painter, bool symmetric, QPair<float, float> goodRange, QPair<float, float> criticalRange, bool solid=true);
+    void drawGauge(float xRef, float yRef, float radius, float min, float max, const QString name, float value, const QColor& color, QPainter* painter, bool symmetric, QPair<float, float> goodRange, QPair<float, float> criticalRange, bool solid=true, bool integer=false);
     void drawSystemIndicator(float xRef, float yRef, int maxNum, float maxWidth, float maxHeight, QPainter* painter);
     void paintText(QString text, QColor color, float fontSize, float refX, float refY, QPainter* painter);
 
@@ -158,17 +136,17 @@ protected:
 //     virtual void wheelEvent(QWheelEvent* event);
 //     virtual void resizeEvent(QResizeEvent* event);
 
+    /** @brief Get the latest value of a gauge variable from the telemetry store */
+    bool telemetryValue(const QString& name, const QString& unit, UASTelemetryStore::Value& value);
+
     UASInterface* uas;                 ///< The uas currently monitored
-    QMap<QString, double> values;       ///< The variables this HUD displays
-    QMap<QString, QString> units;      ///< The units
-    QMap<QString, float> valuesDot;    ///< First derivative of the variable
-    QMap<QString, float> valuesMean;   ///< Mean since system startup for this variable
-    QMap<QString, int> valuesCount;    ///< Number of values received so far
-    QMap<QString, quint64> lastUpdate; ///< The last update time for this variable
+    UASTelemetryStore::Ptr telemetryStore; ///< The variables of the monitored uas
+    QMultiHash<QString, int> storeKeys; ///< Telemetry store keys by variable name (without component prefix)
+    QSet<int> knownStoreKeys;          ///< Telemetry store keys already in storeKeys
+    quint64 lastStoreGeneration;       ///< Telemetry store generation of the last repaint
     QMap<QString, float> minValues;    ///< The minimum value this variable is assumed to have
     QMap<QString, float> maxValues;    ///< The maximum value this variable is assumed to have
     QMap<QString, bool> symmetric;     ///< Draw the gauge / dial symmetric bool = yes
-    QMap<QString, bool> intValues;     ///< Is the gauge value an integer?
     QMap<QString, QString> customNames; ///< Custom names for the data names
     QMap<QString, QPair<float, float> > goodRanges; ///< The range of good values
     QMap<QString, QPair<float, float> > critRanges; ///< The range of critical values
@@ -212,7 +190,6 @@ protected:
     QAction* addGaugeAction;   ///< Action adding a gauge
     QAction* setTitleAction;   ///< Action setting the title
     QAction* setColumnsAction; ///< Action setting the number of columns
-    bool valuesChanged;
 
 private:
     Ui::HDDisplay *m_ui;
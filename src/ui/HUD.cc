@@ -125,6 +125,9 @@ HUD::HUD(int width, int height, QWidget* parent)
       yImageFactor(1.0),
       imageRequested(false)
 {
+    scaledImageKey = 0;
+    repaintRequired = true;
+
     // Fill with black background
     QImage fill = QImage(width, height, QImage::Format_Indexed8);
     fill.setColorCount(3);
@@ -145,7 +148,7 @@ HUD::HUD(int width, int height, QWidget* parent)
 
     // Refresh timer
     refreshTimer->setInterval(updateInterval);
-    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(repaint()));
+    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refreshIfChanged()));
 
     // Resize to correct size and fill with image
     QWidget::resize(this->width(), this->height());
@@ -295,6 +298,7 @@ void HUD::setActiveUAS(UASInterface* uas)
         // Set new UAS
         this->uas = uas;
     }
+    repaintRequired = true;
 }
 
 //void HUD::updateAttitudeThrustSetPoint(UASInterface* uas, double rollDesired, double pitchDesired, double yawDesired, double thrustDesired, quint64 msec)
@@ -314,6 +318,7 @@ void HUD::updateAttitude(UASInterface* uas, double roll, double pitch, double ya
         this->roll = roll;
         this->pitch = pitch*3.35f; // Constant here is the 'focal length' of the projection onto the plane
         this->yaw = yaw;
+        repaintRequired = true;
     }
 }
 
@@ -324,6 +329,7 @@ void HUD::updateAttitude(UASInterface* uas, int component, double roll, double p
     if (!qIsNaN(roll) && !qIsInf(roll) && !qIsNaN(pitch) && !qIsInf(pitch) && !qIsNaN(yaw) && !qIsInf(yaw))
     {
         attitudes.insert(component, QVector3D(roll, pitch*3.35f, yaw)); // Constant here is the 'focal length' of the projection onto the plane
+        repaintRequired = true;
     }
 }
 
@@ -340,6 +346,7 @@ void HUD::updateBattery(UASInterface* uas, double voltage, double current, doubl
     } else {
         fuelColor = infoColor;
     }
+    repaintRequired = true;
 }
 
 void HUD::receiveHeartbeat(UASInterface*)
@@ -360,6 +367,7 @@ void HUD::updateLocalPosition(UASInterface* uas,double x,double y,double z,quint
     this->xPos = x;
     this->yPos = y;
     this->zPos = z;
+    repaintRequired = true;
 }
 
 void HUD::updateGlobalPosition(UASInterface* uas,double lat, double lon, double altitude, quint64 timestamp)
@@ -369,6 +377,7 @@ void HUD::updateGlobalPosition(UASInterface* uas,double lat, double lon, double
     this->lat = lat;
     this->lon = lon;
     this->alt = altitude;
+    repaintRequired = true;
 }
 
 void HUD::updateSpeed(UASInterface* uas,double x,double y,double z,quint64 timestamp)
@@ -381,6 +390,7 @@ void HUD::updateSpeed(UASInterface* uas,double x,double y,double z,quint64 times
     double newTotalSpeed = sqrt(xSpeed*xSpeed + ySpeed*ySpeed + zSpeed*zSpeed);
     totalAcc = (newTotalSpeed - totalSpeed) / ((double)(lastSpeedUpdate - timestamp)/1000.0);
     totalSpeed = newTotalSpeed;
+    repaintRequired = true;
 }
 
 /**
@@ -394,6 +404,7 @@ void HUD::updateState(UASInterface* uas,QString state)
     // Only one UAS is connected at a time
     Q_UNUSED(uas);
     this->state = state;
+    repaintRequired = true;
 }
 
 /**
@@ -408,6 +419,7 @@ void HUD::updateMode(int id,QString mode, QString description)
     Q_UNUSED(id);
     Q_UNUSED(description);
     this->mode = mode;
+    repaintRequired = true;
 }
 
 void HUD::updateLoad(UASInterface* uas, double load)
@@ -480,6 +492,16 @@ void HUD::paintEvent(QPaintEvent *event)
     paintHUD();
 }
 
+void HUD::refreshIfChanged()
+{
+    // Values arrive much faster than the refresh rate, so only paint once per
+    // timer tick and only if something changed.
+    if (repaintRequired)
+    {
+        update();
+    }
+}
+
 void HUD::paintHUD()
 {
     if (isVisible()) {
@@ -561,8 +583,13 @@ void HUD::paintHUD()
         painter.begin(this);
         painter.setRenderHint(QPainter::Antialiasing, true);
         painter.setRenderHint(QPainter::HighQualityAntialiasing, true);
-        QPixmap pmap = QPixmap::fromImage(glImage).scaledToWidth(width());
-        painter.drawPixmap(0, (height() - pmap.height()) / 2, pmap);
+        // Converting and scaling the image is expensive, only do it for a new image or size
+        if (scaledImageKey != glImage.cacheKey() || scaledImage.width() != width())
+        {
+            scaledImage = QPixmap::fromImage(glImage).scaledToWidth(width());
+            scaledImageKey = glImage.cacheKey();
+        }
+        painter.drawPixmap(0, (height() - scaledImage.height()) / 2, scaledImage);
 
         // END OF OPENGL PAINTING
 
@@ -659,7 +686,7 @@ void HUD::paintHUD()
             if (yawDeg > 360) yawDeg -= 360;
             /* final safeguard for really stupid systems */
             int yawCompass = static_cast<int>(yawDeg) % 360;
-            yawAngle.asprintf("%03d", yawCompass);
+            yawAngle = QString::asprintf("%03d", yawCompass);
             paintText(yawAngle, defaultColor,8.5f, -9.8f, compassY+ 1.7f, &painter);
 
             painter.setBrush(Qt::NoBrush);
@@ -738,6 +765,7 @@ void HUD::paintHUD()
         }
 
         painter.end();
+        repaintRequired = false;
     }
 
 }
@@ -973,7 +1001,7 @@ void HUD::drawChangeRateStrip(float xRef, float yRef, float height, float minRat
 
         // Text
         QString label;
-        label.asprintf("%+06.2f >", value);
+        label = QString::asprintf("%+06.2f >", value);
 
         QFont font("Bitstream Vera Sans");
         // Enforce minimum font size of 5 pixels
@@ -995,7 +1023,7 @@ void HUD::drawChangeRateStrip(float xRef, float yRef, float height, float minRat
 
         // Text
         QString label;
-        label.asprintf("< %+06.2f", value);
+        label = QString::asprintf("< %+06.2f", value);
         paintText(label, defaultColor, 6.0f, xRef+width/2.0f, yRef+height-((scaledValue - minRate)/(maxRate-minRate))*height - 1.6f, painter);
     }
 }
@@ -1089,7 +1117,7 @@ void HUD::drawChangeIndicatorGauge(float xRef, float yRef, float radius, float e
     drawCircle(xRef, yRef, radius, 200.0f, 170.0f, 1.5f, color, painter);
 
     QString label;
-    label.asprintf("%05.1f", value);
+    label = QString::asprintf("%05.1f", value);
 
     float textSize = radius / 2.5;
 
@@ -1152,6 +1180,7 @@ void HUD::selectWaypoint(int uasId, int id)
 {
     Q_UNUSED(uasId);
     waypointName = tr("WP") + QString::number(id);
+    repaintRequired = true;
 }
 
 void HUD::setImageSize(int width, int height, int depth, int channels)
@@ -1279,6 +1308,7 @@ void HUD::startImage(quint64 timestamp)
     if (videoEnabled && offlineDirectory != "") {
         // Load and diplay image file
         nextOfflineImage = QString(offlineDirectory + "/%1.bmp").arg(timestamp);
+        repaintRequired = true;
     }
 }
 
@@ -1293,11 +1323,13 @@ void HUD::selectOfflineDirectory()
 void HUD::enableHUDInstruments(bool enabled)
 {
     HUDInstrumentsEnabled = enabled;
+    update();
 }
 
 void HUD::enableVideo(bool enabled)
 {
     videoEnabled = enabled;
+    update();
 }
 
 void HUD::setPixels(int imgid, const unsigned char* imageData, int length, int startIndex)
@@ -1346,6 +1378,7 @@ void HUD::copyImage()
     if (u)
     {
         this->glImage = u->getImage();
+        repaintRequired = true;
 
         // Save to directory if logging is enabled
         if (imageLoggingEnabled)
@@ -33,6 +33,7 @@ This file is part of the QGROUNDCONTROL project
 #define HUD_H
 
 #include <QImage>
+#include <QPixmap>
 #include <QWidget>
 #include <QLabel>
 #include <QPainter>
@@ -99,6 +100,8 @@ public slots:
 
 
 protected slots:
+    /** @brief Repaint if a value or the image changed since the last paint */
+    void refreshIfChanged();
     void paintRollPitchStrips();
     void paintPitchLines(float pitch, QPainter* painter);
     /** @brief Paint text on top of the image and OpenGL drawings */
@@ -142,6 +145,9 @@ protected:
 
     QImage* image; ///< Double buffer image
     QImage glImage; ///< The background / camera image
+    QPixmap scaledImage; ///< glImage scaled to the widget width, recreated only if the image or the width changes
+    qint64 scaledImageKey; ///< QImage::cacheKey() of the image in scaledImage
+    bool repaintRequired; ///< A displayed value changed since the last paint
     UASInterface* uas; ///< The uas currently monitored
     float yawInt; ///< The yaw integral. Used to damp the yaw indication.
     QString mode; ///< The current vehicle mode
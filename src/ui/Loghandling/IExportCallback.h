@@ -0,0 +1,62 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file IExportCallback.h
+ * @date 18 Oct 2026
+ * @brief File providing the exporter callback interface
+ */
+
+#ifndef IEXPORTCALLBACK_H
+#define IEXPORTCALLBACK_H
+
+#include <QtGlobal>
+
+/**
+ * @brief The IExportCallback class is used by the log exporters to
+ *        provide progress feedback while exporting. It should be
+ *        implemented by the class running the export.
+ */
+class IExportCallback
+{
+public:
+
+    /**
+     * @brief ~IExportCallback DTOR
+     */
+    virtual ~IExportCallback(){}
+
+    /**
+     * @brief onProgress is called regulary by the exporter to enable the
+     *        implementer to calculate the progress. The exporter calls
+     *        it every s_RowsPerProgressCheck rows and once more when all
+     *        rows are exported. It may still be called many times per
+     *        second, so the implementer has to throttle it if it is
+     *        forwarded to an UI.
+     *
+     * @param pos - Row which is actually exported. With a type filter this
+     *              is the index in the filtered rows, not in the storage.
+     * @param size - Number of rows to be exported (filtered rows with a type filter)
+     */
+    virtual void onProgress(const qint64 pos, const qint64 size) = 0;
+};
+
+#endif // IEXPORTCALLBACK_H
@@ -34,6 +34,8 @@ This file is part of the APM_PLANNER project
 #include "Loghandling/LogExporter.h"
 #include "Loghandling/PresetManager.h"
 
+#include <QtMath>
+
 
 LogAnalysisCursor::LogAnalysisCursor(QCustomPlot *parentPlot, double xPosition, CursorType type) :
     QCPItemStraightLine(parentPlot),
@@ -228,6 +230,8 @@ LogAnalysis::LogAnalysis(QWidget *parent) :
     m_scrollEndIndex(0),
     m_statusTextPos(0),
     m_lastHorizontalScrollVal(0),
+    m_nextCompareLogNumber(2),
+    m_compareAlignment(alignGpsTime),
     m_cursorXAxisRange(0.0),
     mp_cursorSimple(nullptr),
     mp_cursorLeft(nullptr),
@@ -253,6 +257,30 @@ LogAnalysis::LogAnalysis(QWidget *parent) :
     // and add Trail view
     p_Action = viewMenu->addAction("GPS Trail");
     connect(p_Action, SIGNAL(triggered()), this, SLOT(showMapViewClicked()));
+    // add compare menu
+    QMenu *compareMenu = new QMenu("Compare", this);
+    m_menuBarPtr->addMenu(compareMenu);
+    p_Action = compareMenu->addAction("Add logs...");
+    connect(p_Action, SIGNAL(triggered()), this, SLOT(addCompareLogsClicked()));
+    // alignment entries are exclusive
+    QMenu *alignMenu = compareMenu->addMenu("Align on");
+    QActionGroup *alignGroup = new QActionGroup(this);
+    p_Action = alignGroup->addAction("GPS time");
+    p_Action->setData(alignGpsTime);
+    p_Action = alignGroup->addAction("First arming");
+    p_Action->setData(alignArming);
+    p_Action = alignGroup->addAction("Log start");
+    p_Action->setData(alignLogStart);
+    for(QAction *p_alignAction : alignGroup->actions())
+    {
+        p_alignAction->setCheckable(true);
+        p_alignAction->setChecked(p_alignAction->data().toInt() == m_compareAlignment);
+        alignMenu->addAction(p_alignAction);
+    }
+    connect(alignGroup, SIGNAL(triggered(QAction*)), this, SLOT(compareAlignmentChanged(QAction*)));
+    mp_removeCompareLogsMenuEntry = compareMenu->addAction("Remove compared logs");
+    connect(mp_removeCompareLogsMenuEntry, SIGNAL(triggered()), this, SLOT(removeCompareLogsClicked()));
+    mp_removeCompareLogsMenuEntry->setDisabled(true);
 
 
     // create preset menu and give it to preset manager
@@ -371,6 +399,24 @@ LogAnalysis::~LogAnalysis()
     QLOG_DEBUG() << "LogAnalysis::~LogAnalysis - DTOR";
     saveSettings();
 
+    // A running export must be finished before the datastorage can go
+    if (m_exportThreadPtr)
+    {
+        m_exportThreadPtr->stopExport();
+        m_exportThreadPtr->wait();
+    }
+
+    // Same for the compare log loaders. They delete themselves when finished.
+    for(const auto &compareLog : m_compareLogs)
+    {
+        if(compareLog.mp_loaderThread)
+        {
+            disconnect(compareLog.mp_loaderThread, nullptr, this, nullptr);
+            compareLog.mp_loaderThread->stopLoad();
+            compareLog.mp_loaderThread->wait();
+        }
+    }
+
     // Close map window if it is alive...
     if (!mp_logAnalysisMap.isNull())
     {
@@ -411,11 +457,17 @@ void LogAnalysis::setTablePos(double xPosition)
     if(mp_cursorSimple)  // only if simple cursor is active
     {
         double timeStamp = 0.0;
+        int tableRow = -1;
 
         if (m_useTimeOnXAxis)
         {
             timeStamp = xPosition < 0.0 ? 0.0 : xPosition;
             xPosition = m_dataStoragePtr->getNearestIndexForTimestamp(timeStamp);
+            if (mp_tableFilterProxyModel->isFiltered())
+            {
+                // search only the visible types - nearest visible row in time
+                tableRow = m_dataStoragePtr->getNearestIndexForTimestamp(timeStamp, m_tableVisibleTypes);
+            }
         }
 
         qint64 position = static_cast<qint64>(floor(xPosition));
@@ -445,26 +497,13 @@ void LogAnalysis::setTablePos(double xPosition)
         }
         else
         {
-            //search for previous event (remember the table may be filtered)
-            QModelIndex sourceIndex = m_dataStoragePtr->index(static_cast<int>(position - min), 0);
-            QModelIndex index = mp_tableFilterProxyModel->mapFromSource(sourceIndex);
-            while ( sourceIndex.row() >= static_cast<int>(min) && !index.isValid() )
-            {
-                sourceIndex = m_dataStoragePtr->index(sourceIndex.row() - 1, 0);
-                index = mp_tableFilterProxyModel->mapFromSource(sourceIndex);
-            }
-
-            if ( !index.isValid() )
+            // Find the row in the (maybe filtered) table. The proxy delivers the previous
+            // visible row or the first one if there is no previous.
+            if (tableRow < 0)
             {
-                //couldn't find filtered index by looking back, try forward...
-                sourceIndex = m_dataStoragePtr->index(static_cast<int>(position - min), 0);
-                index = mp_tableFilterProxyModel->mapFromSource(sourceIndex);
-                while ( sourceIndex.row() <= static_cast<int>(max) && !index.isValid() )
-                {
-                    sourceIndex = m_dataStoragePtr->index(sourceIndex.row() + 1, 0);
-                    index = mp_tableFilterProxyModel->mapFromSource(sourceIndex);
-                }
+                tableRow = static_cast<int>(position - min);
             }
+            QModelIndex index = mp_tableFilterProxyModel->index(mp_tableFilterProxyModel->nearestProxyRow(tableRow), 0);
             ui.tableWidget->setCurrentIndex(index);
             ui.tableWidget->scrollTo(index);
 
@@ -484,6 +523,9 @@ void LogAnalysis::rangeCursorsMoving()
         double rightPos = mp_cursorRight->getCurrentXPos();
 
         m_cursorXAxisRange = rightPos - leftPos;
+
+        // range values are cheap to calculate - update them while dragging
+        cursorRangeChange();
     }
 }
 
@@ -503,22 +545,23 @@ void LogAnalysis::cursorRangeChange()
         activeGraphType::Iterator iter;
         for(iter = m_activeGraphs.begin(); iter != m_activeGraphs.end(); ++iter)
         {
-            QSharedPointer<QCPGraphDataContainer> dataPtr = iter->p_graph->data();
-            RangeValues rangeVals;
-
-            int rangeStartIndex = iter->p_graph->findBegin(leftPos);
-            int rangeEndIndex   = iter->p_graph->findBegin(rightPos);
-            rangeVals.m_measurements = rangeEndIndex - rangeStartIndex;
-
-            for(int i = rangeStartIndex; i < rangeEndIndex; ++i)
+            if(!iter->m_rangeStatsPtr)
             {
-                double value = dataPtr->at(i)->mainValue();
-                rangeVals.m_average += value;
-                rangeVals.m_min = rangeVals.m_min > value ? value : rangeVals.m_min;
-                rangeVals.m_max = rangeVals.m_max < value ? value : rangeVals.m_max;
+                // first range on this graph - create the statistic tables once
+                const LogdataStorage::Series &series = iter->p_graph->series();
+                QVector<double> keys;
+                QVector<double> values;
+                keys.reserve(series.size());
+                values.reserve(series.size());
+                for(int i = 0; i < series.size(); ++i)
+                {
+                    keys.push_back(series.key(i));
+                    values.push_back(series.value(i));
+                }
+                iter->m_rangeStatsPtr = RangeStatistics::Ptr::create(keys, values);
             }
-            rangeVals.m_average /= rangeVals.m_measurements;
-            m_rangeValuesStorage.insert(iter.key(), rangeVals);
+
+            m_rangeValuesStorage.insert(iter.key(), iter->m_rangeStatsPtr->calculate(leftPos, rightPos));
         }
     }
 }
@@ -531,8 +574,19 @@ void LogAnalysis::setupXAxisAndScroller()
 
     if (m_useTimeOnXAxis)
     {
-        m_scrollStartIndex = static_cast<qint64>(m_dataStoragePtr->getMinTimeStamp());
-        m_scrollEndIndex = static_cast<qint64>(m_dataStoragePtr->getMaxTimeStamp());
+        // Compared logs are shifted by their offset and may start before or end after the loaded log
+        double minTime = m_dataStoragePtr->getMinTimeStamp();
+        double maxTime = m_dataStoragePtr->getMaxTimeStamp();
+        for(const auto &compareLog : m_compareLogs)
+        {
+            if(compareLog.m_loaded)
+            {
+                minTime = qMin(minTime, compareLog.m_dataStoragePtr->getMinTimeStamp() + compareLog.m_timeOffset);
+                maxTime = qMax(maxTime, compareLog.m_dataStoragePtr->getMaxTimeStamp() + compareLog.m_timeOffset);
+            }
+        }
+        m_scrollStartIndex = static_cast<qint64>(qFloor(minTime));
+        m_scrollEndIndex = static_cast<qint64>(qCeil(maxTime));
         xAxis->setNumberPrecision(2);
         xAxis->setLabel("Time s");
     }
@@ -616,12 +670,8 @@ void LogAnalysis::plotTextArrow(double index, const QString &text, const QString
 
 void LogAnalysis::disableTableFilter()
 {
-    // The order of the statements is important to be fast on huge logs (15MB)
-    // It does not really disable the filter but sets the rules to get a fast
-    // result without any filtering
-    mp_tableFilterProxyModel->setFilterKeyColumn(0);
-    mp_tableFilterProxyModel->setFilterRole(Qt::DisplayRole);
-    mp_tableFilterProxyModel->setFilterFixedString("");
+    m_tableVisibleTypes.clear();
+    mp_tableFilterProxyModel->clearFilter();
 }
 
 void LogAnalysis::loadSettings()
@@ -849,7 +899,7 @@ void LogAnalysis::logLoadingDone(AP2DataPlotStatus status)
     ui.verticalScrollBar->setValue(ui.verticalScrollBar->maximum());
 
     // Set up proxy for table filtering
-    mp_tableFilterProxyModel = new QSortFilterProxyModel(this);     // will be deleted upon destruction of "this"
+    mp_tableFilterProxyModel = new LogTableFilterProxyModel(this);  // will be deleted upon destruction of "this"
     mp_tableFilterProxyModel->setSourceModel(m_dataStoragePtr.data());
     ui.tableWidget->setModel(mp_tableFilterProxyModel);
     connect(ui.tableWidget->selectionModel(), SIGNAL(currentRowChanged(QModelIndex, QModelIndex)), this, SLOT(selectedRowChanged(QModelIndex, QModelIndex)));
@@ -955,25 +1005,31 @@ void LogAnalysis::xAxisChanged(QCPRange range)
 
 void LogAnalysis::itemEnabled(QString name)
 {
-    QVector<double> xlist;
-    QVector<double> ylist;
+    // Items of compared logs have the prefix of the log in front of their name
+    LogdataStorage::Ptr storagePtr = m_dataStoragePtr;
+    QString storageName = name;
+    double timeOffset = 0.0;
+    for(const auto &compareLog : m_compareLogs)
+    {
+        if(compareLog.m_loaded && name.startsWith(compareLog.m_prefix))
+        {
+            storagePtr = compareLog.m_dataStoragePtr;
+            storageName = name.mid(compareLog.m_prefix.size());
+            timeOffset = compareLog.m_timeOffset;
+            break;
+        }
+    }
 
-    if (!m_dataStoragePtr->getValues(name, m_useTimeOnXAxis, xlist, ylist))
+    // The graph reads the values directly from the storage - nothing is copied
+    LogdataStorage::Series series;
+    if (!storagePtr->getSeries(storageName, m_useTimeOnXAxis, series))
     {
         //No values!
         QLOG_WARN() << "No values in datamodel for " << name;
         ui.dataSelectionScreen->disableItem(name);
         return;
     }
-
-    // HACK - a graph with only one value is not plottet. So we add a second point with same value
-    // which forces the graph to plot a short line. Moreover the mouse over which is handeled by
-    // the plotMouseMove(QMouseEvent *evt) method delivers always NONE for a graph with only one point.
-    if(xlist.size() == 1)
-    {
-        xlist.append(xlist[0]++);
-        ylist.append(ylist[0]);
-    }
+    series.setKeyOffset(timeOffset);
 
     m_plotPtr->setCurrentLayer("main");     // All plots are on main layer
     QCPAxisRect *axisRect = m_plotPtr->axisRect();
@@ -996,9 +1052,8 @@ void LogAnalysis::itemEnabled(QString name)
     newPlot.p_yAxis->setTickLabelColor(color);
     newPlot.p_yAxis->setSelectableParts(QCPAxis::spAxis);
 
-    newPlot.p_graph = m_plotPtr->addGraph(axisRect->axis(QCPAxis::atBottom), newPlot.p_yAxis);
+    newPlot.p_graph = new LogAnalysisGraph(axisRect->axis(QCPAxis::atBottom), newPlot.p_yAxis, series);
     newPlot.p_graph->setPen(QPen(color, 1));
-    newPlot.p_graph->setData(xlist, ylist);
     newPlot.p_graph->rescaleValueAxis();
 
     m_activeGraphs[name] = newPlot;     // store the plot by name
@@ -1032,7 +1087,7 @@ void LogAnalysis::itemDisabled(QString name)
     {
         // remove axis, graph and stored info from m_activeGraphs
         m_plotPtr->axisRect()->removeAxis(m_activeGraphs.value(name).p_yAxis);
-        m_plotPtr->removeGraph(m_activeGraphs.value(name).p_graph);
+        m_plotPtr->removePlottable(m_activeGraphs.value(name).p_graph);
         m_activeGraphs.remove(name);
 
         // if cursors are present call range change to update tool tip values
@@ -1126,17 +1181,11 @@ void LogAnalysis::filterAcceptClicked()
     {
         disableTableFilter();
     }
-    // one or more elements selected -> RegEx must be used
+    // one or more elements selected -> show only the rows of the selected types
     else
     {
-        // It is VERY important to disable the filtering prior to set up a new one
-        // If this is not done the regex filter gets terribly slow!!!
-        disableTableFilter();
-        QString regex = m_tableFilterList.join("\\b|");  // Create regex like val1\b|val2\b|val3
-        regex.append("\\b");                             // append the final \b
-        mp_tableFilterProxyModel->setFilterRegExp(regex);
-        mp_tableFilterProxyModel->setFilterRole(Qt::DisplayRole);
-        mp_tableFilterProxyModel->setFilterKeyColumn(1);
+        m_tableVisibleTypes = m_tableFilterList;
+        mp_tableFilterProxyModel->setVisibleRows(m_dataStoragePtr->getIndexesOfTypes(m_tableVisibleTypes));
     }
 
     ui.tableFilterGroupBox->setVisible(false);
@@ -1265,26 +1314,32 @@ void LogAnalysis::doExport(bool kmlExport, double iconInterval)
 
     if(dialog.exec())
     {
-        QElapsedTimer timer;
-        QString result;
         QString outputFileName = dialog.selectedFiles().at(0);
-        timer.start();
+        LogExporterBase::Ptr exporterPtr;
 
         if(kmlExport)
         {
             QLOG_DEBUG() << "iconInterval: " << iconInterval;
-
-            KmlLogExporter kmlExporter(this, m_loadedLogMavType, iconInterval);
-            result = kmlExporter.exportToFile(outputFileName, m_dataStoragePtr);
+            exporterPtr = LogExporterBase::Ptr(new KmlLogExporter(m_loadedLogMavType, iconInterval));
         }
         else
         {
-            AsciiLogExporter asciiExporter(this);
-            result = asciiExporter.exportToFile(outputFileName, m_dataStoragePtr);
+            exporterPtr = LogExporterBase::Ptr(new AsciiLogExporter());
         }
 
-        QLOG_DEBUG() << "Log export took " << timer.elapsed() << "ms";
-        QMessageBox::information(this,  "Information", result);
+        // The export runs in its own thread - the UI stays responsive
+        m_exportThreadPtr.reset(new LogExportThread(exporterPtr, m_dataStoragePtr));
+        connect(m_exportThreadPtr.data(), SIGNAL(exportProgress(qint64, qint64)), this, SLOT(exportProgress(qint64, qint64)));
+        connect(m_exportThreadPtr.data(), SIGNAL(done(QString)), this, SLOT(exportDone(QString)));
+        connect(m_exportThreadPtr.data(), SIGNAL(finished()), this, SLOT(exportThreadTerminated()));
+
+        m_exportProgressDialog.reset(new QProgressDialog("Exporting File", "Cancel", 0, 100, this));
+        m_exportProgressDialog->setWindowModality(Qt::WindowModal);
+        connect(m_exportProgressDialog.data(), SIGNAL(canceled()), this, SLOT(exportProgressDialogCanceled()));
+        m_exportProgressDialog->show();
+
+        m_menuBarPtr->setDisabled(true);    // only one export at a time
+        m_exportThreadPtr->exportFile(outputFileName);
     }
     else
     {
@@ -1292,6 +1347,43 @@ void LogAnalysis::doExport(bool kmlExport, double iconInterval)
     }
 }
 
+void LogAnalysis::exportProgress(qint64 pos, qint64 size)
+{
+    if (m_exportProgressDialog && size > 0)
+    {
+        double tempProgress = (static_cast<double>(pos) / static_cast<double>(size)) * 100.0;
+        // do not reach 100 here - this would close the dialog before the result is available
+        m_exportProgressDialog->setValue(qMin(static_cast<int>(tempProgress), 99));
+    }
+}
+
+void LogAnalysis::exportDone(QString result)
+{
+    if (m_exportProgressDialog)
+    {
+        disconnect(m_exportProgressDialog.data(), SIGNAL(canceled()), this, SLOT(exportProgressDialogCanceled()));
+        m_exportProgressDialog->close();
+        m_exportProgressDialog.reset();
+    }
+    m_menuBarPtr->setDisabled(false);
+    QMessageBox::information(this,  "Information", result);
+}
+
+void LogAnalysis::exportThreadTerminated()
+{
+    QLOG_DEBUG() << "LogAnalysis::exportThreadTerminated.";
+    m_exportThreadPtr.reset();
+}
+
+void LogAnalysis::exportProgressDialogCanceled()
+{
+    QLOG_DEBUG() << "LogAnalysis::exportProgressDialogCanceled.";
+    if (m_exportThreadPtr)
+    {
+        m_exportThreadPtr->stopExport();
+    }
+}
+
 void LogAnalysis::graphControlsButtonClicked()
 {
     activeGraphType::const_iterator iter;
@@ -1431,9 +1523,10 @@ void LogAnalysis::plotMouseMove(QMouseEvent *evt)
 
         if(insideCursorRange && m_rangeValuesStorage.contains(iter.key()))
         {
-            RangeValues &range = m_rangeValuesStorage[iter.key()];
+            const RangeStatistics::Values &range = m_rangeValuesStorage[iter.key()];
             outStream << " min:" << range.m_min << " max:" << range.m_max << " " << QChar(0x0394) << ":" << range.m_max - range.m_min
-                      << " avg:" << range.m_average;
+                      << " avg:" << range.m_average << " std:" << range.m_stdDev << " rms:" << range.m_rms
+                      << " p5:" << range.m_p5 << " med:" << range.m_median << " p95:" << range.m_p95;
         }
 
         outStream.setRealNumberPrecision(4);
@@ -1626,6 +1719,12 @@ void LogAnalysis::applyGraphSettingsPressed()
     // get preset from manager
     PresetManager::presetElementVec preset;
     bool usesTimeAxis = m_presetMgrPtr->loadSpecialSet(preset);
+    // Compared logs are aligned on the time axis only
+    if (!m_compareLogs.isEmpty() && !usesTimeAxis)
+    {
+        QLOG_DEBUG() << "Preset uses the index axis - keeping the time axis for the compared logs";
+        usesTimeAxis = true;
+    }
 
     // disable all open graphs
     ui.dataSelectionScreen->disableAllItems();
@@ -1720,3 +1819,280 @@ void LogAnalysis::showMapViewClicked()
         mp_logAnalysisMap->raise();
     }
 }
+
+void LogAnalysis::startCompareLogLoading()
+{
+    int runningLoaders = 0;
+    for(const auto &compareLog : m_compareLogs)
+    {
+        if(compareLog.mp_loaderThread)
+        {
+            ++runningLoaders;
+        }
+    }
+
+    // Every log has its own storage and parser, so they can be parsed in parallel
+    const int maxLoaders = qMax(1, QThread::idealThreadCount());
+    while(!m_pendingCompareLogs.isEmpty() && (runningLoaders < maxLoaders))
+    {
+        CompareLog compareLog;
+        compareLog.m_filename = m_pendingCompareLogs.takeFirst();
+        compareLog.m_prefix = QString("#%1:").arg(m_nextCompareLogNumber);
+        compareLog.m_dataStoragePtr = LogdataStorage::Ptr(new LogdataStorage());
+        compareLog.mp_loaderThread = new AP2DataPlotThread(compareLog.m_dataStoragePtr);
+        connect(compareLog.mp_loaderThread, SIGNAL(loadProgress(qint64, qint64)), this, SLOT(compareLogLoadingProgress(qint64, qint64)));
+        connect(compareLog.mp_loaderThread, SIGNAL(error(QString)), this, SLOT(compareLogLoadingError(QString)));
+        connect(compareLog.mp_loaderThread, SIGNAL(done(AP2DataPlotStatus)), this, SLOT(compareLogLoadingDone(AP2DataPlotStatus)));
+        connect(compareLog.mp_loaderThread, SIGNAL(finished()), compareLog.mp_loaderThread, SLOT(deleteLater()));
+
+        QLOG_DEBUG() << "LogAnalysis::startCompareLogLoading - loading" << compareLog.m_filename << "as" << compareLog.m_prefix;
+        m_compareLogs.insert(m_nextCompareLogNumber, compareLog);
+        ++m_nextCompareLogNumber;
+        ++runningLoaders;
+        compareLog.mp_loaderThread->loadFile(compareLog.m_filename);
+    }
+
+    if((runningLoaders == 0) && m_compareProgressDialog)
+    {
+        // all done - setting the value to maximum closes the dialog
+        m_compareProgressDialog->setValue(m_compareProgressDialog->maximum());
+        m_compareProgressDialog.reset();
+    }
+}
+
+int LogAnalysis::compareLogOfSender() const
+{
+    for(auto iter = m_compareLogs.constBegin(); iter != m_compareLogs.constEnd(); ++iter)
+    {
+        if(iter->mp_loaderThread && (iter->mp_loaderThread == sender()))
+        {
+            return iter.key();
+        }
+    }
+    return -1;
+}
+
+bool LogAnalysis::alignmentReference(const LogdataStorage::Ptr &storagePtr, double &reference) const
+{
+    switch(m_compareAlignment)
+    {
+    case alignGpsTime:
+        // log time is GPS time minus offset - so minus offset is the log time at GPS time 0
+        if(storagePtr->getGpsTimeOffset(reference))
+        {
+            reference = -reference;
+            return true;
+        }
+        return false;
+
+    case alignArming:
+        return storagePtr->getFirstEventTime(s_ArmedEventId, reference);
+
+    case alignLogStart:
+    default:
+        reference = storagePtr->getMinTimeStamp();
+        return true;
+    }
+}
+
+double LogAnalysis::compareTimeOffset(const LogdataStorage::Ptr &storagePtr) const
+{
+    double mainReference = 0.0;
+    double reference = 0.0;
+    if(!alignmentReference(m_dataStoragePtr, mainReference) || !alignmentReference(storagePtr, reference))
+    {
+        QLOG_WARN() << "LogAnalysis::compareTimeOffset - Alignment reference not found in both logs. Aligning on log start.";
+        mainReference = m_dataStoragePtr->getMinTimeStamp();
+        reference = storagePtr->getMinTimeStamp();
+    }
+    return mainReference - reference;
+}
+
+void LogAnalysis::replotCompareLogs()
+{
+    QStringList activeCompareItems;
+    for(const auto &compareLog : m_compareLogs)
+    {
+        for(auto iter = m_activeGraphs.constBegin(); iter != m_activeGraphs.constEnd(); ++iter)
+        {
+            if(iter.key().startsWith(compareLog.m_prefix))
+            {
+                activeCompareItems.append(iter.key());
+            }
+        }
+    }
+
+    for(const auto &name : activeCompareItems)
+    {
+        ui.dataSelectionScreen->disableItem(name);
+    }
+    for(const auto &name : activeCompareItems)
+    {
+        ui.dataSelectionScreen->enableItem(name);
+    }
+}
+
+void LogAnalysis::addCompareLogsClicked()
+{
+    if(!m_dataStoragePtr || m_loaderThreadPtr)
+    {
+        QMessageBox::information(this, "Information", "Compared logs can be added as soon as the log is loaded.");
+        return;
+    }
+
+    QStringList filenames = QFileDialog::getOpenFileNames(this, "Add Logs To Compare", QGC::logDirectory(),
+                                                          "Dataflash Log Files (*.log *.bin *.BIN *.tlog);;All Files (*.*)");
+    if(filenames.isEmpty())
+    {
+        return;
+    }
+
+    m_pendingCompareLogs.append(filenames);
+    if(!m_compareProgressDialog)
+    {
+        m_compareProgressDialog.reset(new QProgressDialog("Loading logs to compare", "Cancel", 0, 100, nullptr));
+        m_compareProgressDialog->setWindowModality(Qt::WindowModal);
+        connect(m_compareProgressDialog.data(), SIGNAL(canceled()), this, SLOT(compareLogLoadingCanceled()));
+        m_compareProgressDialog->show();
+    }
+    startCompareLogLoading();
+}
+
+void LogAnalysis::compareAlignmentChanged(QAction *action)
+{
+    m_compareAlignment = static_cast<CompareAlignment>(action->data().toInt());
+    QLOG_DEBUG() << "LogAnalysis::compareAlignmentChanged - new alignment" << m_compareAlignment;
+
+    for(auto &compareLog : m_compareLogs)
+    {
+        if(compareLog.m_loaded)
+        {
+            compareLog.m_timeOffset = compareTimeOffset(compareLog.m_dataStoragePtr);
+        }
+    }
+    setupXAxisAndScroller();
+    replotCompareLogs();
+}
+
+void LogAnalysis::removeCompareLogsClicked()
+{
+    compareLogLoadingCanceled();
+
+    for(const auto &compareLog : m_compareLogs)
+    {
+        ui.dataSelectionScreen->removeGroups(compareLog.m_prefix);
+    }
+    m_compareLogs.clear();
+    m_nextCompareLogNumber = 2;
+    setupXAxisAndScroller();
+
+    // The loaded log alone can be plotted by index again
+    ui.indexTypeCheckBox->setEnabled(true);
+    mp_removeCompareLogsMenuEntry->setDisabled(true);
+    m_plotPtr->replot();
+}
+
+void LogAnalysis::compareLogLoadingProgress(qint64 pos, qint64 size)
+{
+    const int number = compareLogOfSender();
+    if((number < 0) || (size <= 0))
+    {
+        return;
+    }
+    m_compareLogs[number].m_progress = static_cast<double>(pos) / static_cast<double>(size);
+
+    // the progress dialog shows the mean progress of all logs still to be loaded
+    double progress = 0.0;
+    int logsToLoad = m_pendingCompareLogs.size();
+    for(const auto &compareLog : m_compareLogs)
+    {
+        if(!compareLog.m_loaded)
+        {
+            progress += compareLog.m_progress;
+            ++logsToLoad;
+        }
+    }
+    if(m_compareProgressDialog && (logsToLoad > 0))
+    {
+        m_compareProgressDialog->setValue(static_cast<int>(progress / logsToLoad * 100.0));
+    }
+}
+
+void LogAnalysis::compareLogLoadingError(QString errorstr)
+{
+    const int number = compareLogOfSender();
+    if(number < 0)
+    {
+        return;
+    }
+    const QString filename = m_compareLogs.value(number).m_filename;
+    QLOG_ERROR() << "LogAnalysis::compareLogLoadingError - Loading of" << filename << "stopped with error:" << errorstr;
+    // The thread deletes itself when finished
+    m_compareLogs.remove(number);
+    QMessageBox::warning(this, "Error", filename + ":\n" + errorstr);
+    startCompareLogLoading();
+}
+
+void LogAnalysis::compareLogLoadingDone(AP2DataPlotStatus status)
+{
+    const int number = compareLogOfSender();
+    if(number < 0)
+    {
+        return;
+    }
+    CompareLog &compareLog = m_compareLogs[number];
+    if(status.getParsingState() != AP2DataPlotStatus::OK)
+    {
+        QLOG_WARN() << "LogAnalysis::compareLogLoadingDone -" << compareLog.m_filename << "parsed with errors:" << status.getErrorOverview();
+    }
+
+    // The thread deletes itself when finished
+    compareLog.mp_loaderThread = nullptr;
+    compareLog.m_loaded = true;
+    compareLog.m_timeOffset = compareTimeOffset(compareLog.m_dataStoragePtr);
+    QLOG_DEBUG() << "LogAnalysis::compareLogLoadingDone -" << compareLog.m_filename << "time offset" << compareLog.m_timeOffset;
+
+    // Add the items with the prefix of the log
+    fmtMapType prefixedFmtMap;
+    const fmtMapType fmtMap = compareLog.m_dataStoragePtr->getFmtValues(true);
+    for (fmtMapType::const_iterator iter = fmtMap.constBegin(); iter != fmtMap.constEnd(); ++iter)
+    {
+        prefixedFmtMap.insert(compareLog.m_prefix + iter.key(), iter.value());
+    }
+    ui.dataSelectionScreen->addItems(prefixedFmtMap);
+
+    // Logs can only be compared on the time axis
+    if(!m_useTimeOnXAxis)
+    {
+        ui.indexTypeCheckBox->setChecked(true);
+        indexTypeCheckBoxClicked(true);
+    }
+    ui.indexTypeCheckBox->setEnabled(false);
+    mp_removeCompareLogsMenuEntry->setEnabled(true);
+    // The aligned log may reach beyond the loaded one
+    setupXAxisAndScroller();
+
+    startCompareLogLoading();
+}
+
+void LogAnalysis::compareLogLoadingCanceled()
+{
+    QLOG_DEBUG() << "LogAnalysis::compareLogLoadingCanceled.";
+    m_pendingCompareLogs.clear();
+
+    // Drop all logs which are still loading - their threads delete themselves when finished
+    for(auto iter = m_compareLogs.begin(); iter != m_compareLogs.end();)
+    {
+        if(iter->mp_loaderThread)
+        {
+            disconnect(iter->mp_loaderThread, nullptr, this, nullptr);
+            iter->mp_loaderThread->stopLoad();
+            iter = m_compareLogs.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+    m_compareProgressDialog.reset();
+}
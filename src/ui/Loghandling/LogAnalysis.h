@@ -40,6 +40,10 @@ This file is part of the APM_PLANNER project
 #include "qcustomplot.h"
 
 #include "LogdataStorage.h"
+#include "LogAnalysisGraph.h"
+#include "LogExportThread.h"
+#include "LogTableFilterProxyModel.h"
+#include "RangeStatistics.h"
 #include "AP2DataPlotThread.h"
 #include "AP2DataPlotStatus.h"
 #include "AP2DataPlotAxisDialog.h"
@@ -230,6 +234,35 @@ private:
 
     static const int s_ROW_HEIGHT_PADDING = 3;  ///< Number of additional pixels over font height for each row for the table view.
     static const int s_TextArrowPositions = 12;  ///< Max number of different positions for the test arrows
+    static const quint32 s_ArmedEventId = 10;    ///< Id of the ARMED event (EV) used for aligning compared logs
+
+    /**
+     * @brief The CompareAlignment enum defines how compared logs are aligned to the loaded log
+     */
+    enum CompareAlignment
+    {
+        alignGpsTime,   ///< Align on GPS time - needs a GPS with 3D fix in both logs
+        alignArming,    ///< Align on the first arming event
+        alignLogStart   ///< Align on the first time stamp of both logs
+    };
+
+    /**
+     * @brief The CompareLog struct holds a log which is loaded additionally to compare it with the
+     *        loaded log. Its items are shown in the data selection screen with m_prefix in front of
+     *        the group name and are plotted on the time axis of the loaded log.
+     */
+    struct CompareLog
+    {
+        QString m_filename;                     ///< filename of the log
+        QString m_prefix;                       ///< prefix of all item names of this log like "#2:"
+        LogdataStorage::Ptr m_dataStoragePtr;   ///< data storage of this log
+        AP2DataPlotThread *mp_loaderThread;     ///< loader thread - only valid while loading
+        double m_progress;                      ///< loading progress 0.0 - 1.0
+        double m_timeOffset;                    ///< offset in seconds added to the time to align the log
+        bool m_loaded;                          ///< true if the log is loaded
+
+        CompareLog() : mp_loaderThread(nullptr), m_progress(0.0), m_timeOffset(0.0), m_loaded(false) {}
+    };
 
     /**
      * @brief The GraphElements struct holds all needed information about an active graph
@@ -237,10 +270,11 @@ private:
     struct GraphElements
     {
         QCPAxis  *p_yAxis;     ///< pointer to the y-Axis of this graph
-        QCPGraph *p_graph;     ///< pointer to the graph itself
+        LogAnalysisGraph *p_graph;  ///< pointer to the graph itself
         QString m_groupName;   ///< name of the group the plot belongs to.
         bool m_manualRange;    ///< has user defined scaling
         bool m_inGroup;        ///< has group scaling
+        RangeStatistics::Ptr m_rangeStatsPtr;  ///< statistics for range cursors - created on first use
 
         GraphElements() : p_yAxis(nullptr), p_graph(nullptr), m_manualRange(false), m_inGroup(false) {}
     };
@@ -259,19 +293,6 @@ private:
         GroupElement() : m_lower(std::numeric_limits<double>::max()), m_upper(m_lower * -1) {}
     };
 
-    /**
-     * @brief The RangeValues struct stores all additiona values calculated by cursorRangeChanged() method.
-     */
-    struct RangeValues
-    {
-        double m_min;           ///< Min value in range
-        double m_max;           ///< Max value in range
-        double m_average;       ///< Average value in range
-        int    m_measurements;  ///< Number of measurements in range
-
-        RangeValues() : m_min(std::numeric_limits<double>::max()), m_max(m_min * -1), m_average(0.0), m_measurements(0) {}
-    };
-
     typedef QMap<QString, QStringList> fmtMapType;          ///< type for handling fmt values from datamodel
     typedef QHash<QString, GraphElements> activeGraphType;  ///< type for handling active graph container
 
@@ -279,6 +300,7 @@ private:
 
     Ui::LogAnalysis ui;             ///< The user interface
     QAction *mp_KMLExportMenuEntry; ///<< used to en/disable the entry
+    QAction *mp_removeCompareLogsMenuEntry; ///<< used to en/disable the entry
 
     QScopedPointer<QCustomPlot>  m_plotPtr;            ///< Scoped pointer to QCustomplot
     LogdataStorage::Ptr          m_dataStoragePtr;     ///< Shared pointer to data storage
@@ -289,15 +311,24 @@ private:
     QScopedPointer<AP2DataPlotThread, QScopedPointerDeleteLater> m_loaderThreadPtr;        ///< Scoped pointer to AP2DataPlotThread
     QScopedPointer<QProgressDialog, QScopedPointerDeleteLater>   m_loadProgressDialog;     ///< Scoped pointer to load progress window
     QScopedPointer<AP2DataPlotAxisDialog, QScopedPointerDeleteLater> m_axisGroupingDialog; ///< Scoped pointer to axis grouping dialog
+    QScopedPointer<LogExportThread, QScopedPointerDeleteLater>   m_exportThreadPtr;        ///< Scoped pointer to the export thread - only valid while exporting
+    QScopedPointer<QProgressDialog, QScopedPointerDeleteLater>   m_exportProgressDialog;   ///< Scoped pointer to export progress window
+    QScopedPointer<QProgressDialog, QScopedPointerDeleteLater>   m_compareProgressDialog;  ///< Scoped pointer to compare log load progress window
+
+    QMap<int, CompareLog> m_compareLogs;        ///< Logs loaded for comparison by their number
+    QStringList m_pendingCompareLogs;           ///< Filenames of compare logs waiting for a free loader
+    int m_nextCompareLogNumber;                 ///< Number of the next compare log. The loaded log is #1.
+    CompareAlignment m_compareAlignment;        ///< How the compared logs are aligned
 
     activeGraphType m_activeGraphs;                         ///< Holds all active graphs
-    QHash<QString, RangeValues> m_rangeValuesStorage;       ///< If there is a range cursor the range values are stored here.
+    QHash<QString, RangeStatistics::Values> m_rangeValuesStorage; ///< If there is a range cursor the range values are stored here.
     QMap<quint64, MessageBase::Ptr> m_indexToMessageMap;    ///< Map holding all Messages which are printed as arrows
     GraphElements m_arrowGraph;                             ///< The text arrows have an own graph
 
-    QStringList m_tableFilterList;   ///< Used to create regex filter pattern for table view.
+    QStringList m_tableFilterList;   ///< Types selected in the filter window.
+    QStringList m_tableVisibleTypes; ///< Types visible in table view - only valid if table is filtered.
 
-    QSortFilterProxyModel *mp_tableFilterProxyModel;    ///< Filter model for table view.
+    LogTableFilterProxyModel *mp_tableFilterProxyModel;    ///< Filter model for table view.
 
     QString m_filename;              ///< Filename of the loaded Log - mainly used for export
 
@@ -320,7 +351,8 @@ private:
     /**
      * @brief setupXAxisAndScroller sets up x axis and the horizontal scroller
      *        to use the normal index (the artifical) or the time index regarding
-     *        to the value of m_useTimeOnXAxis.
+     *        to the value of m_useTimeOnXAxis. On the time axis the range covers
+     *        the loaded compare logs shifted by their offset, too.
      */
     void setupXAxisAndScroller();
 
@@ -367,6 +399,41 @@ private:
      */
     QList<AP2DataPlotAxisDialog::GraphRange> presetToRangeConverter(const PresetManager::presetElementVec &preset);
 
+    /**
+     * @brief startCompareLogLoading - starts loading of pending compare logs. Every log is parsed
+     *        by its own loader thread. At most QThread::idealThreadCount() loaders run in parallel.
+     */
+    void startCompareLogLoading();
+
+    /**
+     * @brief compareLogOfSender - finds the compare log whose loader thread sent the current signal.
+     * @return - number of the compare log or -1 if the sender is no compare log loader
+     */
+    int compareLogOfSender() const;
+
+    /**
+     * @brief alignmentReference - delivers the time of the alignment reference selected by
+     *        m_compareAlignment in a log.
+     * @param storagePtr - the data storage of the log
+     * @param reference - time of the reference in seconds (time base of the log)
+     * @return - true if the log has the reference, false otherwise
+     */
+    bool alignmentReference(const LogdataStorage::Ptr &storagePtr, double &reference) const;
+
+    /**
+     * @brief compareTimeOffset - calculates the offset which aligns a compared log to the loaded
+     *        log. Falls back to the log start if one of the logs does not have the reference.
+     * @param storagePtr - the data storage of the compared log
+     * @return - offset in seconds to be added to the time of the compared log
+     */
+    double compareTimeOffset(const LogdataStorage::Ptr &storagePtr) const;
+
+    /**
+     * @brief replotCompareLogs - disables and reenables all active graphs of compared logs, so
+     *        they get the current time offset.
+     */
+    void replotCompareLogs();
+
 private slots:
 
     /**
@@ -543,6 +610,32 @@ private slots:
      */
     void doExport(bool kmlExport, double iconInterval);
 
+    /**
+     * @brief exportProgress - sets the progressbar of the export progress dialog.
+     * @param pos - Row which is actually exported.
+     * @param size - Number of rows to export.
+     */
+    void exportProgress(qint64 pos, qint64 size);
+
+    /**
+     * @brief exportDone - closes the export progress dialog and shows the
+     *        result of the export.
+     * @param result - result string of the exporter
+     */
+    void exportDone(QString result);
+
+    /**
+     * @brief exportThreadTerminated - shall be called as soon as the export
+     *        thread terminates. Resets the pointer to the thread object.
+     */
+    void exportThreadTerminated();
+
+    /**
+     * @brief exportProgressDialogCanceled - should be called if someone presses
+     *        cancel in the export progress dialog. Stops the export.
+     */
+    void exportProgressDialogCanceled();
+
     /**
      * @brief graphControlsButtonClicked - opens the plot grouping dialog and sends
      *        the current group settings to the grouping dialog.
@@ -640,6 +733,52 @@ private slots:
 
     void showMapViewClicked();
 
+    /**
+     * @brief addCompareLogsClicked - opens a file dialog to select logs which shall be compared
+     *        with the loaded log and starts loading them.
+     */
+    void addCompareLogsClicked();
+
+    /**
+     * @brief compareAlignmentChanged - handles the selection of the compare alignment. Recalculates
+     *        the offsets of all compared logs.
+     * @param action - the selected alignment action. Its data holds the CompareAlignment.
+     */
+    void compareAlignmentChanged(QAction *action);
+
+    /**
+     * @brief removeCompareLogsClicked - removes all compared logs and their graphs.
+     */
+    void removeCompareLogsClicked();
+
+    /**
+     * @brief compareLogLoadingProgress - sets the progressbar to the mean progress of all
+     *        loading compare logs.
+     * @param pos - Position of log loading.
+     * @param size - Size of data to be loaded.
+     */
+    void compareLogLoadingProgress(qint64 pos, qint64 size);
+
+    /**
+     * @brief compareLogLoadingError - to be called on compare log loading error. The log
+     *        is dropped.
+     * @param errorstr - The error string to be printed.
+     */
+    void compareLogLoadingError(QString errorstr);
+
+    /**
+     * @brief compareLogLoadingDone - aligns the loaded compare log and adds its items to the
+     *        data selection screen.
+     * @param status - status of the parsing.
+     */
+    void compareLogLoadingDone(AP2DataPlotStatus status);
+
+    /**
+     * @brief compareLogLoadingCanceled - stops loading of all compare logs which are not
+     *        loaded yet.
+     */
+    void compareLogLoadingCanceled();
+
 };
 
 #endif // LOGANALYSIS_HPP
@@ -0,0 +1,478 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogAnalysisGraph.cpp
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the plottable reading its data from the log data storage
+ */
+
+#include "LogAnalysisGraph.h"
+
+#include <cmath>
+#include <limits>
+
+LogAnalysisGraph::LogAnalysisGraph(QCPAxis *keyAxis, QCPAxis *valueAxis, const LogdataStorage::Series &series) :
+    QCPAbstractPlottable(keyAxis, valueAxis),
+    m_series(series),
+    m_valueRangeValid(false),
+    m_valueRangeFound(false)
+{}
+
+LogAnalysisGraph::~LogAnalysisGraph()
+{}
+
+const LogdataStorage::Series &LogAnalysisGraph::series() const
+{
+    return m_series;
+}
+
+double LogAnalysisGraph::selectTest(const QPointF &pos, bool onlySelectable, QVariant *details) const
+{
+    if ((onlySelectable && mSelectable == QCP::stNone) || (m_series.size() == 0) || !mKeyAxis || !mValueAxis)
+    {
+        return -1;
+    }
+    QCPAxis *keyAxis = mKeyAxis.data();
+    if (!keyAxis->axisRect()->rect().contains(pos.toPoint())
+            && !mParentPlot->interactions().testFlag(QCP::iSelectPlottablesBeyondAxisRect))
+    {
+        return -1;
+    }
+
+    // Only the values within the selection tolerance around the position are tested
+    const double tolerance = mParentPlot->selectionTolerance();
+    const double keyPixel = keyAxis->orientation() == Qt::Horizontal ? pos.x() : pos.y();
+    QCPRange keyRange(keyAxis->pixelToCoord(keyPixel - tolerance), keyAxis->pixelToCoord(keyPixel + tolerance));
+    keyRange.normalize();
+    const int begin = findBegin(keyRange.lower);
+    const int end = findEnd(keyRange.upper);
+
+    const QCPVector2D position(pos);
+    double minDistSqr = std::numeric_limits<double>::max();
+    int closest = -1;
+    QCPVector2D last;
+    bool lastValid = false;
+    for (int i = begin; i < end; ++i)
+    {
+        const double value = m_series.value(i);
+        if (!std::isfinite(value))
+        {
+            lastValid = false;
+            continue;
+        }
+        const QCPVector2D point(coordsToPixels(m_series.key(i), value));
+        const double distSqr = lastValid ? position.distanceSquaredToLine(last, point) : (position - point).lengthSquared();
+        if (distSqr < minDistSqr)
+        {
+            minDistSqr = distSqr;
+            closest = i;
+        }
+        last = point;
+        lastValid = true;
+    }
+
+    if (closest < 0)
+    {
+        return -1;
+    }
+    if (details)
+    {
+        details->setValue(QCPDataSelection(QCPDataRange(closest, closest + 1)));
+    }
+    return std::sqrt(minDistSqr);
+}
+
+QCPPlottableInterface1D *LogAnalysisGraph::interface1D()
+{
+    return this;
+}
+
+QCPRange LogAnalysisGraph::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+{
+    foundRange = false;
+    QCPRange range;
+    const int count = m_series.size();
+    if (count == 0)
+    {
+        return range;
+    }
+
+    if (inSignDomain == QCP::sdBoth)
+    {
+        // keys are sorted
+        foundRange = true;
+        return QCPRange(m_series.key(0), m_series.key(count - 1));
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        const double key = m_series.key(i);
+        if ((inSignDomain == QCP::sdNegative && key >= 0) || (inSignDomain == QCP::sdPositive && key <= 0))
+        {
+            continue;
+        }
+        if (!foundRange)
+        {
+            range.lower = range.upper = key;
+            foundRange = true;
+        }
+        else
+        {
+            range.lower = qMin(range.lower, key);
+            range.upper = qMax(range.upper, key);
+        }
+    }
+    return range;
+}
+
+QCPRange LogAnalysisGraph::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain, const QCPRange &inKeyRange) const
+{
+    const bool restrictKeyRange = inKeyRange != QCPRange();
+    if (!restrictKeyRange && (inSignDomain == QCP::sdBoth))
+    {
+        // The most common request - calculate it only once
+        if (!m_valueRangeValid)
+        {
+            m_valueRange = calcValueRange(0, m_series.size(), QCP::sdBoth, m_valueRangeFound);
+            m_valueRangeValid = true;
+        }
+        foundRange = m_valueRangeFound;
+        return m_valueRange;
+    }
+
+    int begin = 0;
+    int end = m_series.size();
+    if (restrictKeyRange)
+    {
+        begin = findBegin(inKeyRange.lower, false);
+        end = findEnd(inKeyRange.upper, false);
+    }
+    return calcValueRange(begin, end, inSignDomain, foundRange);
+}
+
+int LogAnalysisGraph::dataCount() const
+{
+    return m_series.size();
+}
+
+double LogAnalysisGraph::dataMainKey(int index) const
+{
+    return m_series.key(index);
+}
+
+double LogAnalysisGraph::dataSortKey(int index) const
+{
+    return m_series.key(index);
+}
+
+double LogAnalysisGraph::dataMainValue(int index) const
+{
+    return m_series.value(index);
+}
+
+QCPRange LogAnalysisGraph::dataValueRange(int index) const
+{
+    const double value = m_series.value(index);
+    return QCPRange(value, value);
+}
+
+QPointF LogAnalysisGraph::dataPixelPosition(int index) const
+{
+    return coordsToPixels(m_series.key(index), m_series.value(index));
+}
+
+bool LogAnalysisGraph::sortKeyIsMainKey() const
+{
+    return true;
+}
+
+QCPDataSelection LogAnalysisGraph::selectTestRect(const QRectF &rect, bool onlySelectable) const
+{
+    QCPDataSelection result;
+    if ((onlySelectable && mSelectable == QCP::stNone) || (m_series.size() == 0) || !mKeyAxis || !mValueAxis)
+    {
+        return result;
+    }
+
+    double key1, value1, key2, value2;
+    pixelsToCoords(rect.topLeft(), key1, value1);
+    pixelsToCoords(rect.bottomRight(), key2, value2);
+    QCPRange keyRange(key1, key2);
+    keyRange.normalize();
+    QCPRange valueRange(value1, value2);
+    valueRange.normalize();
+
+    const int begin = findBegin(keyRange.lower, false);
+    const int end = findEnd(keyRange.upper, false);
+    int rangeBegin = -1;
+    for (int i = begin; i < end; ++i)
+    {
+        if (valueRange.contains(m_series.value(i)))
+        {
+            if (rangeBegin < 0)
+            {
+                rangeBegin = i;
+            }
+        }
+        else if (rangeBegin >= 0)
+        {
+            result.addDataRange(QCPDataRange(rangeBegin, i), false);
+            rangeBegin = -1;
+        }
+    }
+    if (rangeBegin >= 0)
+    {
+        result.addDataRange(QCPDataRange(rangeBegin, end), false);
+    }
+    result.simplify();
+    return result;
+}
+
+int LogAnalysisGraph::findBegin(double sortKey, bool expandedRange) const
+{
+    // lower bound - first key not less than sortKey
+    int first = 0;
+    int count = m_series.size();
+    while (count > 0)
+    {
+        const int step = count / 2;
+        if (m_series.key(first + step) < sortKey)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    if (expandedRange && first > 0)
+    {
+        --first;
+    }
+    return first;
+}
+
+int LogAnalysisGraph::findEnd(double sortKey, bool expandedRange) const
+{
+    // upper bound - first key greater than sortKey
+    int first = 0;
+    int count = m_series.size();
+    while (count > 0)
+    {
+        const int step = count / 2;
+        if (!(sortKey < m_series.key(first + step)))
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    if (expandedRange && first < m_series.size())
+    {
+        ++first;
+    }
+    return first;
+}
+
+void LogAnalysisGraph::draw(QCPPainter *painter)
+{
+    if (!mKeyAxis || !mValueAxis)
+    {
+        return;
+    }
+    QCPAxis *keyAxis = mKeyAxis.data();
+    if ((keyAxis->range().size() <= 0) || (m_series.size() == 0))
+    {
+        return;
+    }
+
+    QVector<QVector<QPointF> > lines;
+    if (m_series.size() == 1)
+    {
+        // a graph with only one value is drawn as short line with the same value
+        const double key = m_series.key(0);
+        const double value = m_series.value(0);
+        lines.append(QVector<QPointF>() << coordsToPixels(key, value) << coordsToPixels(key + 1.0, value));
+    }
+    else
+    {
+        // expanded range - one value beyond each border, so the lines leave the axis rect
+        const int begin = findBegin(keyAxis->range().lower);
+        const int end = findEnd(keyAxis->range().upper);
+        const double keyPixels = qAbs(keyAxis->coordToPixel(keyAxis->range().upper) - keyAxis->coordToPixel(keyAxis->range().lower));
+        if ((end - begin) > s_MinValuesPerPixel * keyPixels)
+        {
+            getReducedLines(begin, end, lines);
+        }
+        else
+        {
+            getLines(begin, end, lines);
+        }
+    }
+
+    if (mSelectionDecorator && selected())
+    {
+        mSelectionDecorator->applyPen(painter);
+    }
+    else
+    {
+        painter->setPen(mPen);
+    }
+    painter->setBrush(Qt::NoBrush);
+    applyDefaultAntialiasingHint(painter);
+    for (const auto &line : lines)
+    {
+        painter->drawPolyline(line.constData(), line.size());
+    }
+}
+
+void LogAnalysisGraph::drawLegendIcon(QCPPainter *painter, const QRectF &rect) const
+{
+    // draw line vertically centered
+    applyDefaultAntialiasingHint(painter);
+    painter->setPen(mPen);
+    painter->drawLine(QLineF(rect.left(), rect.top() + rect.height() / 2.0, rect.right() + 5, rect.top() + rect.height() / 2.0));
+}
+
+QCPRange LogAnalysisGraph::calcValueRange(int begin, int end, QCP::SignDomain inSignDomain, bool &foundRange) const
+{
+    foundRange = false;
+    QCPRange range;
+    for (int i = begin; i < end; ++i)
+    {
+        const double value = m_series.value(i);
+        if (!std::isfinite(value)
+                || (inSignDomain == QCP::sdNegative && value >= 0) || (inSignDomain == QCP::sdPositive && value <= 0))
+        {
+            continue;
+        }
+        if (!foundRange)
+        {
+            range.lower = range.upper = value;
+            foundRange = true;
+        }
+        else
+        {
+            range.lower = qMin(range.lower, value);
+            range.upper = qMax(range.upper, value);
+        }
+    }
+    return range;
+}
+
+QPointF LogAnalysisGraph::pixelPoint(double keyPixel, double valuePixel) const
+{
+    return mKeyAxis.data()->orientation() == Qt::Horizontal ? QPointF(keyPixel, valuePixel) : QPointF(valuePixel, keyPixel);
+}
+
+void LogAnalysisGraph::getLines(int begin, int end, QVector<QVector<QPointF> > &lines) const
+{
+    QVector<QPointF> line;
+    line.reserve(end - begin);
+    for (int i = begin; i < end; ++i)
+    {
+        const double value = m_series.value(i);
+        if (!std::isfinite(value))
+        {
+            // gap in the line
+            if (line.size() > 1)
+            {
+                lines.append(line);
+            }
+            line.resize(0);
+            continue;
+        }
+        line.append(coordsToPixels(m_series.key(i), value));
+    }
+    if (line.size() > 1)
+    {
+        lines.append(line);
+    }
+}
+
+void LogAnalysisGraph::getReducedLines(int begin, int end, QVector<QVector<QPointF> > &lines) const
+{
+    QCPAxis *keyAxis = mKeyAxis.data();
+    QCPAxis *valueAxis = mValueAxis.data();
+
+    QVector<QPointF> line;
+    bool columnValid = false;
+    int column = 0;
+    double first = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double last = 0.0;
+    bool minFirst = true;
+
+    const auto appendColumn = [&]()
+    {
+        line.append(pixelPoint(column, valueAxis->coordToPixel(first)));
+        line.append(pixelPoint(column, valueAxis->coordToPixel(minFirst ? min : max)));
+        line.append(pixelPoint(column, valueAxis->coordToPixel(minFirst ? max : min)));
+        line.append(pixelPoint(column, valueAxis->coordToPixel(last)));
+    };
+
+    for (int i = begin; i < end; ++i)
+    {
+        const double value = m_series.value(i);
+        if (!std::isfinite(value))
+        {
+            continue;
+        }
+        const int valueColumn = static_cast<int>(std::floor(keyAxis->coordToPixel(m_series.key(i))));
+        if (!columnValid || (valueColumn != column))
+        {
+            if (columnValid)
+            {
+                appendColumn();
+            }
+            column = valueColumn;
+            first = min = max = value;
+            minFirst = true;
+            columnValid = true;
+        }
+        else if (value < min)
+        {
+            min = value;
+            minFirst = false;
+        }
+        else if (value > max)
+        {
+            max = value;
+            minFirst = true;
+        }
+        last = value;
+    }
+    if (columnValid)
+    {
+        appendColumn();
+    }
+
+    if (line.size() > 1)
+    {
+        lines.append(line);
+    }
+}
@@ -0,0 +1,126 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogAnalysisGraph.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the plottable reading its data from the log data storage
+ */
+
+#ifndef LOGANALYSISGRAPH_H
+#define LOGANALYSISGRAPH_H
+
+#include "qcustomplot.h"
+#include "LogdataStorage.h"
+
+/**
+ * @brief The LogAnalysisGraph class is a line graph which reads its data directly from
+ *        a LogdataStorage::Series instead of copying it into a QCPGraphDataContainer.
+ *        Adding a graph does not depend on the number of values and the values are only
+ *        held once by the storage.
+ *        The keys of the series must be sorted ascending (time or row index).
+ *        If there are more values than pixels, only first, min, max and last value of every
+ *        pixel column are drawn. A series with only one value is drawn as a short line.
+ */
+class LogAnalysisGraph : public QCPAbstractPlottable, public QCPPlottableInterface1D
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief LogAnalysisGraph - CTOR. The graph is added to the plot of the axes.
+     * @param keyAxis - the X axis
+     * @param valueAxis - the Y axis
+     * @param series - the series to be drawn
+     */
+    LogAnalysisGraph(QCPAxis *keyAxis, QCPAxis *valueAxis, const LogdataStorage::Series &series);
+
+    /**
+     * @brief ~LogAnalysisGraph - DTOR
+     */
+    virtual ~LogAnalysisGraph() override;
+
+    /**
+     * @brief series - getter for the drawn series
+     * @return - the series
+     */
+    const LogdataStorage::Series &series() const;
+
+    // QCPAbstractPlottable
+    virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details = nullptr) const override;
+    virtual QCPPlottableInterface1D *interface1D() override;
+    virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth) const override;
+    virtual QCPRange getValueRange(bool &foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth,
+                                   const QCPRange &inKeyRange = QCPRange()) const override;
+
+    // QCPPlottableInterface1D
+    virtual int dataCount() const override;
+    virtual double dataMainKey(int index) const override;
+    virtual double dataSortKey(int index) const override;
+    virtual double dataMainValue(int index) const override;
+    virtual QCPRange dataValueRange(int index) const override;
+    virtual QPointF dataPixelPosition(int index) const override;
+    virtual bool sortKeyIsMainKey() const override;
+    virtual QCPDataSelection selectTestRect(const QRectF &rect, bool onlySelectable) const override;
+    virtual int findBegin(double sortKey, bool expandedRange = true) const override;
+    virtual int findEnd(double sortKey, bool expandedRange = true) const override;
+
+protected:
+    virtual void draw(QCPPainter *painter) override;
+    virtual void drawLegendIcon(QCPPainter *painter, const QRectF &rect) const override;
+
+private:
+    static constexpr double s_MinValuesPerPixel = 2.0;  ///< Above this density the values are reduced per pixel column
+
+    LogdataStorage::Series m_series;    ///< The drawn series
+
+    mutable bool m_valueRangeValid;     ///< m_valueRange is valid
+    mutable bool m_valueRangeFound;     ///< The series has at least one finite value
+    mutable QCPRange m_valueRange;      ///< Value range of the whole series - calculated on first use
+
+    /**
+     * @brief calcValueRange - calculates the range of the finite values in [begin, end)
+     */
+    QCPRange calcValueRange(int begin, int end, QCP::SignDomain inSignDomain, bool &foundRange) const;
+
+    /**
+     * @brief pixelPoint - creates the pixel point from key and value pixel coordinates
+     *        respecting the orientation of the key axis
+     */
+    QPointF pixelPoint(double keyPixel, double valuePixel) const;
+
+    /**
+     * @brief getLines - delivers the pixel points of the lines between begin and end. Every
+     *        run of points between non finite values is a polyline of its own.
+     * @param begin - first index
+     * @param end - index behind the last one
+     * @param lines - the polylines are appended here
+     */
+    void getLines(int begin, int end, QVector<QVector<QPointF> > &lines) const;
+
+    /**
+     * @brief getReducedLines - like getLines() but delivers only first, min, max and last
+     *        value of every pixel column.
+     */
+    void getReducedLines(int begin, int end, QVector<QVector<QPointF> > &lines) const;
+};
+
+#endif // LOGANALYSISGRAPH_H
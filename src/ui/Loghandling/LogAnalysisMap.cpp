@@ -33,6 +33,7 @@ This file is part of the APM_PLANNER project
 #include "ui_LogAnalysisMap.h"
 
 #include <utility>
+#include <algorithm>
 
 //************************************************************************************
 
@@ -81,25 +82,15 @@ void LogAnalysisMap::paintUAVTrail()
     {
         scaleData();
 
-        // setup trail
-        mapcontrol::GPSItem *p_uav = mp_Ui->map->AddTrail();
-        p_uav->SetTrailDistance(0);
-        p_uav->ShowUavPic(false);
+        // setup trail - all positions are handed over at once. The trail simplifies
+        // them for the zoom level and paints only the visible part.
+        mapcontrol::TrailPathItem *p_trail = mp_Ui->map->AddTrailPath();
+        p_trail->SetPath(m_latValues, m_lonValues, m_validIndex);
 
         // set position of map
         internals::PointLatLng pos(m_latValues.at(m_validIndex), m_lonValues.at(m_validIndex));
         mp_Ui->map->SetCurrentPosition(pos);
 
-        // add all GPS positions to the trail
-        for (auto i = m_validIndex; i < m_latValues.size(); ++i)
-        {
-            internals::PointLatLng pos(m_latValues.at(i), m_lonValues.at(i));
-            p_uav->SetUAVPos(pos, 10);
-        }
-
-        p_uav->SetShowTrail(false);
-        p_uav->RefreshPos();
-
         // create UAV icon as cursor
         if (mp_trailCursor == nullptr)
         {
@@ -117,6 +108,11 @@ void LogAnalysisMap::paintUAVTrail()
 
 void LogAnalysisMap::setUavCursor(int index)
 {
+    if (mp_trailCursor == nullptr || m_latValues.empty())
+    {
+        return;     // no trail no cursor
+    }
+
     auto bestGpsIndex = findBestIndexMatch(index, m_xValues);
     auto bestHeadingIndex = findBestIndexMatch(index, m_xValuesHeading);
 
@@ -235,37 +231,28 @@ void LogAnalysisMap::findDataNames()
 
 int LogAnalysisMap::findBestIndexMatch(int index, const QVector<double> &data)
 {
-    int intervalSize = data.size();
-    int intervalStart = 0;
-    int middle = 0;
-
-    if (index <= 0.0)
+    if (data.empty())
     {
-        middle = 0;
+        return 0;
     }
-    else if (index >= data.back())
+
+    // data is sorted ascending - binary search for the first element not less than index
+    auto iter = std::lower_bound(data.constBegin(), data.constEnd(), static_cast<double>(index));
+    if (iter == data.constEnd())
     {
-        middle = data.size() - 1;
+        return data.size() - 1;
     }
-    else
+    if (iter != data.constBegin())
     {
-        while (intervalSize > 1)
+        // the previous element may be closer
+        auto prev = iter - 1;
+        if ((index - *prev) < (*iter - index))
         {
-            middle = intervalStart + intervalSize / 2;
-            auto temp = static_cast<int>(data.at(middle) + 0.5);
-            if (index > temp)
-            {
-                intervalStart = middle;
-            }
-            else if (index == temp)
-            {
-                break;
-            }
-            intervalSize = intervalSize / 2;
+            iter = prev;
         }
     }
 
-    return middle;
+    return static_cast<int>(iter - data.constBegin());
 }
 
 void LogAnalysisMap::scaleData()
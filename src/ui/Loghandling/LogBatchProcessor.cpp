@@ -0,0 +1,505 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogBatchProcessor.cpp
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the headless batch log processor
+ */
+
+#include "LogBatchProcessor.h"
+#include "logging.h"
+#include "BinLogParser.h"
+#include "AsciiLogParser.h"
+#include "TlogParser.h"
+#include "LogExporter.h"
+#include "RangeStatistics.h"
+
+#include <QCommandLineParser>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QDir>
+#include <QHash>
+#include <QMap>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+namespace
+{
+
+/**
+ * @brief The BatchParserCallback class collects the errors of a parser. The progress
+ *        is not of interest in batch mode.
+ */
+class BatchParserCallback : public IParserCallback
+{
+public:
+    virtual void onProgress(const qint64 pos, const qint64 size)
+    {
+        Q_UNUSED(pos)
+        Q_UNUSED(size)
+    }
+
+    virtual void onError(const QString &errorMsg)
+    {
+        m_errors.append(errorMsg);
+    }
+
+    QStringList m_errors;   ///< All errors reported by the parser
+};
+
+}
+
+/**
+ * @brief The LogBatchProcessor::Task class processes one log in a pool thread
+ */
+class LogBatchProcessor::Task : public QRunnable
+{
+public:
+    Task(LogBatchProcessor *p_processor, const LogFile &log, Result *p_result) :
+        mp_processor(p_processor),
+        m_log(log),
+        mp_result(p_result)
+    {}
+
+    void run()
+    {
+        mp_processor->processLog(m_log, *mp_result);
+    }
+
+private:
+    LogBatchProcessor *mp_processor;
+    LogFile m_log;
+    Result *mp_result;
+};
+
+LogBatchProcessor::Options::Options() :
+    m_startTime(-std::numeric_limits<double>::max()),
+    m_endTime(std::numeric_limits<double>::max()),
+    m_exportCsv(false),
+    m_exportLog(false),
+    m_exportKml(false),
+    m_summary(false),
+    m_kmlIconInterval(2.0),
+    m_maxThreads(0)
+{}
+
+LogBatchProcessor::LogBatchProcessor(const Options &options) :
+    m_options(options)
+{
+    QLOG_DEBUG() << "LogBatchProcessor::LogBatchProcessor - CTOR";
+}
+
+QVector<LogBatchProcessor::LogFile> LogBatchProcessor::findLogs(const QStringList &paths, bool recursive) const
+{
+    const QStringList logFilters {"*.bin", "*.BIN", "*.log", "*.tlog"};
+    QMap<QString, LogFile> logMap;      // sorted by filename, without duplicates
+    auto addLog = [&logMap](const QString &filename, const QString &relativePath)
+    {
+        const QString absoluteFilename = QFileInfo(filename).absoluteFilePath();
+        if(!logMap.contains(absoluteFilename))
+        {
+            LogFile log;
+            log.m_filename = filename;
+            log.m_relativePath = relativePath;
+            log.m_baseName = QFileInfo(filename).completeBaseName();
+            logMap.insert(absoluteFilename, log);
+        }
+    };
+
+    for(const auto &path : paths)
+    {
+        const QFileInfo pathInfo(path);
+        if(pathInfo.isDir())
+        {
+            const QDir root(path);
+            QDirIterator iter(path, logFilters, QDir::Files, recursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags);
+            while(iter.hasNext())
+            {
+                const QString filename = iter.next();
+                const QString relativePath = root.relativeFilePath(QFileInfo(filename).absolutePath());
+                addLog(filename, relativePath == "." ? QString() : relativePath);
+            }
+        }
+        else if(pathInfo.isFile())
+        {
+            addLog(path, QString());
+        }
+        else
+        {
+            QLOG_WARN() << "LogBatchProcessor::findLogs -" << path << "does not exist";
+        }
+    }
+    QVector<LogFile> logs = logMap.values().toVector();
+
+    // Logs with the same output base name would overwrite each others output. First
+    // the extension is appended to their base name, then a number if that is not enough.
+    // The comparison ignores the case as some file systems do.
+    for(int pass = 0; pass < 2; ++pass)
+    {
+        QHash<QString, QVector<int> > outputs;
+        for(int i = 0; i < logs.size(); ++i)
+        {
+            outputs[outputBaseName(logs.at(i)).toLower()].append(i);
+        }
+        for(const auto &indices : outputs)
+        {
+            if(indices.size() < 2)
+            {
+                continue;
+            }
+            for(int i = 0; i < indices.size(); ++i)
+            {
+                LogFile &log = logs[indices.at(i)];
+                if(pass == 0)
+                {
+                    log.m_baseName += '_' + QFileInfo(log.m_filename).suffix().toLower();
+                }
+                else if(i > 0)
+                {
+                    log.m_baseName += '_' + QString::number(i + 1);
+                }
+                QLOG_INFO() << "LogBatchProcessor::findLogs - output files of" << log.m_filename
+                            << "are named" << outputBaseName(log) << "to avoid overwriting";
+                fprintf(stdout, "Output of %s is named %s.*\n", qPrintable(log.m_filename), qPrintable(outputBaseName(log)));
+            }
+        }
+    }
+    return logs;
+}
+
+QVector<LogBatchProcessor::Result> LogBatchProcessor::process(const QVector<LogFile> &logs)
+{
+    // Every task writes into its own element - so the vector must not reallocate
+    QVector<Result> results(logs.size());
+
+    QThreadPool pool;
+    if(m_options.m_maxThreads > 0)
+    {
+        pool.setMaxThreadCount(m_options.m_maxThreads);
+    }
+    QLOG_INFO() << "LogBatchProcessor::process -" << logs.size() << "logs with" << pool.maxThreadCount() << "threads";
+
+    for(int i = 0; i < logs.size(); ++i)
+    {
+        pool.start(new Task(this, logs.at(i), &results[i]));     // pool deletes the task
+    }
+    pool.waitForDone();
+    return results;
+}
+
+void LogBatchProcessor::processLog(const LogFile &log, Result &result)
+{
+    QElapsedTimer timer;
+    timer.start();
+    const QString &filename = log.m_filename;
+    result.m_filename = filename;
+
+    QFile logfile(filename);
+    if(!logfile.open(QIODevice::ReadOnly))
+    {
+        result.m_messages.append("Unable to open log file");
+    }
+    else
+    {
+        // same parser selection as AP2DataPlotThread
+        LogdataStorage::Ptr storagePtr(new LogdataStorage());
+        BatchParserCallback callback;
+        AP2DataPlotStatus status;
+        bool parsed = true;
+        const QString lowerFilename = filename.toLower();
+        if(lowerFilename.endsWith(".bin"))
+        {
+            BinLogParser parser(storagePtr, &callback);
+            status = parser.parse(logfile);
+        }
+        else if(lowerFilename.endsWith(".log"))
+        {
+            AsciiLogParser parser(storagePtr, &callback);
+            status = parser.parse(logfile);
+        }
+        else if(lowerFilename.endsWith(".tlog"))
+        {
+            TlogParser parser(storagePtr, &callback);
+            status = parser.parse(logfile);
+        }
+        else
+        {
+            result.m_messages.append("Unable to detect file type from filename");
+            parsed = false;
+        }
+        logfile.close();
+
+        if(parsed && !callback.m_errors.isEmpty())
+        {
+            result.m_messages.append(callback.m_errors);
+            parsed = false;
+        }
+
+        if(parsed)
+        {
+            if(status.getParsingState() != AP2DataPlotStatus::OK)
+            {
+                // The data is usable anyway - like in the LogAnalysis window
+                result.m_messages.append("Parsed with errors: " + status.getErrorOverview().simplified());
+            }
+
+            bool ok = true;
+            const QString baseName = outputBaseName(log);
+            if(!QDir().mkpath(QFileInfo(baseName).absolutePath()))
+            {
+                result.m_messages.append("Unable to create output directory " + QFileInfo(baseName).absolutePath());
+                ok = false;
+            }
+            if(m_options.m_summary)
+            {
+                ok &= writeSummary(baseName + "_summary.csv", storagePtr, result);
+            }
+
+            const bool timeFiltered = (m_options.m_startTime > -std::numeric_limits<double>::max()) ||
+                                      (m_options.m_endTime < std::numeric_limits<double>::max());
+            auto runExport = [&](LogExporterBase &exporter, const QString &exportName)
+            {
+                if(!m_options.m_typeNames.isEmpty())
+                {
+                    exporter.setTypeFilter(m_options.m_typeNames);
+                }
+                if(timeFiltered)
+                {
+                    exporter.setTimeFilter(m_options.m_startTime, m_options.m_endTime);
+                }
+                const QString exportResult = exporter.exportToFile(exportName, storagePtr);
+                result.m_messages.append(exportResult);
+                ok &= exportResult.startsWith("Successfull");    // the exporters report success with this text
+            };
+
+            if(m_options.m_exportCsv)
+            {
+                CsvLogExporter exporter;
+                runExport(exporter, baseName + ".csv");
+            }
+            if(m_options.m_exportLog)
+            {
+                // do not overwrite an ascii log with its own export
+                const bool isSource = QFileInfo(baseName + ".log") == QFileInfo(filename);
+                AsciiLogExporter exporter;
+                runExport(exporter, isSource ? baseName + "_export.log" : baseName + ".log");
+            }
+            if(m_options.m_exportKml)
+            {
+                QMutexLocker kmlLocker(&m_kmlMutex);
+                KmlLogExporter exporter(status.getMavType(), m_options.m_kmlIconInterval);
+                runExport(exporter, baseName + ".kml");
+            }
+            result.m_ok = ok;
+        }
+    }
+    result.m_msecs = timer.elapsed();
+
+    QMutexLocker locker(&m_outputMutex);
+    fprintf(stdout, "%s %s (%.1f s)\n", result.m_ok ? "OK    " : "FAILED", qPrintable(filename), result.m_msecs / 1000.0);
+    for(const auto &message : result.m_messages)
+    {
+        fprintf(stdout, "       %s\n", qPrintable(message));
+    }
+    fflush(stdout);
+}
+
+bool LogBatchProcessor::writeSummary(const QString &filename, const LogdataStorage::Ptr &storagePtr, Result &result) const
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        result.m_messages.append("Unable to open summary file: " + file.errorString());
+        return false;
+    }
+
+    QTextStream stream(&file);
+    stream << "Name,Count,Start,End,Min,Max,Average,StdDev,Median,P95\n";
+
+    QVector<double> keys;
+    QVector<double> values;
+    QVector<int> order;
+    const QMap<QString, QStringList> fmtMap = storagePtr->getFmtValues(true);
+    for(auto iter = fmtMap.constBegin(); iter != fmtMap.constEnd(); ++iter)
+    {
+        // indexed types are named like "BAT.0" - filter by the type name only
+        if(!m_options.m_typeNames.isEmpty() && !m_options.m_typeNames.contains(iter.key().section('.', 0, 0)))
+        {
+            continue;
+        }
+        for(const auto &valueName : iter.value())
+        {
+            const QString name = iter.key() + '.' + valueName;
+            keys.clear();
+            values.clear();
+            if(!storagePtr->getValues(name, true, keys, values) || keys.isEmpty())
+            {
+                continue;
+            }
+
+            // RangeStatistics needs sorted keys - time stamps are sorted almost always
+            if(!std::is_sorted(keys.constBegin(), keys.constEnd()))
+            {
+                order.resize(keys.size());
+                for(int i = 0; i < order.size(); ++i)
+                {
+                    order[i] = i;
+                }
+                std::stable_sort(order.begin(), order.end(), [&keys](int a, int b) { return keys.at(a) < keys.at(b); });
+                QVector<double> sortedKeys(keys.size());
+                QVector<double> sortedValues(values.size());
+                for(int i = 0; i < order.size(); ++i)
+                {
+                    sortedKeys[i] = keys.at(order.at(i));
+                    sortedValues[i] = values.at(order.at(i));
+                }
+                keys.swap(sortedKeys);
+                values.swap(sortedValues);
+            }
+
+            const RangeStatistics statistics(keys, values);
+            const RangeStatistics::Values stats = statistics.calculate(m_options.m_startTime, m_options.m_endTime);
+            if(stats.m_measurements == 0)
+            {
+                continue;
+            }
+            const auto first = std::lower_bound(keys.constBegin(), keys.constEnd(), m_options.m_startTime);
+            const auto last = std::lower_bound(keys.constBegin(), keys.constEnd(), m_options.m_endTime) - 1;
+            stream << name << ',' << stats.m_measurements << ',' << *first << ',' << *last << ','
+                   << stats.m_min << ',' << stats.m_max << ',' << stats.m_average << ',' << stats.m_stdDev << ','
+                   << stats.m_median << ',' << stats.m_p95 << '\n';
+        }
+    }
+
+    stream.flush();
+    if(stream.status() != QTextStream::Ok)
+    {
+        result.m_messages.append("Unable to write summary file: " + file.errorString());
+        return false;
+    }
+    result.m_messages.append("Summary written to " + filename);
+    return true;
+}
+
+QString LogBatchProcessor::outputBaseName(const LogFile &log) const
+{
+    if(m_options.m_outputDirectory.isEmpty())
+    {
+        return QDir(QFileInfo(log.m_filename).absolutePath()).filePath(log.m_baseName);
+    }
+    const QDir outputDir(QDir(m_options.m_outputDirectory).absoluteFilePath(log.m_relativePath));
+    return QDir::cleanPath(outputDir.filePath(log.m_baseName));
+}
+
+int LogBatchProcessor::exec(const QStringList &arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Processes logs without user interface.");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("batch-logs", "Run the batch log processing."));
+    parser.addPositionalArgument("paths", "Logs (*.bin, *.log, *.tlog) or directories containing logs.", "paths...");
+    const QCommandLineOption recursiveOption({"r", "recursive"}, "Search the directories recursively.");
+    const QCommandLineOption outputOption({"o", "output"}, "Write all output files to <dir> instead of next to the log.", "dir");
+    const QCommandLineOption typesOption({"t", "types"}, "Only export and summarize the message types <types> (comma separated like GPS,ATT).", "types");
+    const QCommandLineOption fromOption("from", "Start of the time range in seconds.", "seconds");
+    const QCommandLineOption toOption("to", "End of the time range in seconds.", "seconds");
+    const QCommandLineOption csvOption("csv", "Export one csv file per message type.");
+    const QCommandLineOption logOption("log", "Export an ascii log (*.log).");
+    const QCommandLineOption kmlOption("kml", "Export a KMZ file.");
+    const QCommandLineOption iconIntervalOption("kml-icon-interval", "Minimum plane icon interval of the KMZ export in meters (default 2).", "meters", "2");
+    const QCommandLineOption summaryOption("summary", "Write summary statistics of all values (*_summary.csv).");
+    const QCommandLineOption threadsOption({"j", "threads"}, "Number of logs processed concurrently (default one per core).", "count", "0");
+    parser.addOptions({recursiveOption, outputOption, typesOption, fromOption, toOption, csvOption, logOption,
+                       kmlOption, iconIntervalOption, summaryOption, threadsOption});
+    parser.process(arguments);
+
+    Options options;
+    if(parser.isSet(typesOption))
+    {
+#if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
+        options.m_typeNames = parser.value(typesOption).split(',', QString::SkipEmptyParts);
+#else
+        options.m_typeNames = parser.value(typesOption).split(',', Qt::SkipEmptyParts);
+#endif
+    }
+    bool ok = true;
+    if(parser.isSet(fromOption))
+    {
+        options.m_startTime = parser.value(fromOption).toDouble(&ok);
+    }
+    if(ok && parser.isSet(toOption))
+    {
+        options.m_endTime = parser.value(toOption).toDouble(&ok);
+    }
+    if(ok)
+    {
+        options.m_kmlIconInterval = parser.value(iconIntervalOption).toDouble(&ok);
+    }
+    if(ok)
+    {
+        options.m_maxThreads = parser.value(threadsOption).toInt(&ok);
+    }
+    if(!ok || (options.m_startTime >= options.m_endTime))
+    {
+        fprintf(stderr, "Invalid time range, icon interval or thread count.\n");
+        return 1;
+    }
+    options.m_exportCsv = parser.isSet(csvOption);
+    options.m_exportLog = parser.isSet(logOption);
+    options.m_exportKml = parser.isSet(kmlOption);
+    options.m_summary = parser.isSet(summaryOption);
+    options.m_outputDirectory = parser.value(outputOption);
+    if(!options.m_outputDirectory.isEmpty() && !QDir().mkpath(options.m_outputDirectory))
+    {
+        fprintf(stderr, "Unable to create output directory %s\n", qPrintable(options.m_outputDirectory));
+        return 1;
+    }
+
+    LogBatchProcessor processor(options);
+    const QVector<LogFile> logs = processor.findLogs(parser.positionalArguments(), parser.isSet(recursiveOption));
+    if(logs.isEmpty())
+    {
+        fprintf(stderr, "No logs found.\n");
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const QVector<Result> results = processor.process(logs);
+
+    int failed = 0;
+    for(const auto &result : results)
+    {
+        if(!result.m_ok)
+        {
+            ++failed;
+        }
+    }
+    fprintf(stdout, "%d logs processed in %.1f s - %d failed\n", results.size(), timer.elapsed() / 1000.0, failed);
+    return failed == 0 ? 0 : 2;
+}
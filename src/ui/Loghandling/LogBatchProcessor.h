@@ -0,0 +1,156 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogBatchProcessor.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the headless batch log processor
+ */
+
+#ifndef LOGBATCHPROCESSOR_H
+#define LOGBATCHPROCESSOR_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMutex>
+
+#include "LogdataStorage.h"
+
+/**
+ * @brief The LogBatchProcessor class parses, filters, summarizes and exports many
+ *        logs without any UI. It uses the same parsers, storage and exporters as the
+ *        LogAnalysis window. Each log is processed by one thread of a thread pool, so
+ *        several logs are processed concurrently.
+ *        Started with "--batch-logs" on the command line - see exec().
+ */
+class LogBatchProcessor
+{
+public:
+    /**
+     * @brief The Options struct holds what shall be done with every log
+     */
+    struct Options
+    {
+        QStringList m_typeNames;        ///< Types to export and summarize - empty means all
+        double m_startTime;             ///< Start of the time range in seconds (included)
+        double m_endTime;               ///< End of the time range in seconds (excluded)
+        bool m_exportCsv;               ///< Export one csv file per type
+        bool m_exportLog;               ///< Export an ascii log (*.log)
+        bool m_exportKml;               ///< Export a KMZ file
+        bool m_summary;                 ///< Write the summary statistics (*_summary.csv)
+        double m_kmlIconInterval;       ///< Minimum plane icon interval of the KMZ export in meters
+        QString m_outputDirectory;      ///< Directory for all output files - empty means next to the log
+        int m_maxThreads;               ///< Number of logs processed concurrently - 0 means one per core
+
+        Options();
+    };
+
+    /**
+     * @brief The Result struct holds the result of processing one log
+     */
+    struct Result
+    {
+        QString m_filename;             ///< Filename of the log
+        bool m_ok;                      ///< true if all steps succeeded
+        QStringList m_messages;         ///< Results and errors of the single steps
+        qint64 m_msecs;                 ///< Processing time in milliseconds
+
+        Result() : m_ok(false), m_msecs(0) {}
+    };
+
+    /**
+     * @brief The LogFile struct holds a log and the names of its output files
+     */
+    struct LogFile
+    {
+        QString m_filename;             ///< Filename of the log
+        QString m_relativePath;         ///< Directory of the log relative to the searched directory - mirrored in the output directory
+        QString m_baseName;             ///< Base name of the output files - unique within the output directory
+    };
+
+    /**
+     * @brief LogBatchProcessor - CTOR
+     * @param options - what shall be done with every log
+     */
+    explicit LogBatchProcessor(const Options &options);
+
+    /**
+     * @brief findLogs - collects all logs (*.bin, *.log, *.tlog) from a list of files and directories.
+     *        Logs whose output files would overwrite each other (like x.bin and x.tlog) get the
+     *        extension or a number appended to the base name of their output files.
+     * @param paths - files and directories
+     * @param recursive - true: search the sub directories too
+     * @return - all logs sorted by filename
+     */
+    QVector<LogFile> findLogs(const QStringList &paths, bool recursive) const;
+
+    /**
+     * @brief process - processes all logs and blocks until they are done. A line is printed to
+     *        stdout as soon as a log is done.
+     * @param logs - the logs to process
+     * @return - the result of every log in the order of logs
+     */
+    QVector<Result> process(const QVector<LogFile> &logs);
+
+    /**
+     * @brief exec - command line entry. Parses the arguments, processes the logs and prints
+     *        an overview. A QCoreApplication must exist.
+     * @param arguments - the command line arguments
+     * @return - exit code. 0 if all logs were processed successfully
+     */
+    static int exec(const QStringList &arguments);
+
+private:
+    class Task;
+
+    Options m_options;      ///< What shall be done with every log
+    QMutex m_outputMutex;   ///< Guards stdout
+    QMutex m_kmlMutex;      ///< The KMZ export copies and removes a shared model file in the output directory
+
+    /**
+     * @brief processLog - parses one log and runs all selected steps on it. Called by the pool threads.
+     * @param log - the log to process
+     * @param result - filled with the result
+     */
+    void processLog(const LogFile &log, Result &result);
+
+    /**
+     * @brief writeSummary - writes the statistics of every value in the selected time range into a csv
+     *        file. One line per value: Name, Count, Start, End, Min, Max, Average, StdDev, Median, P95.
+     * @param filename - name of the summary file
+     * @param storagePtr - the storage of the log
+     * @param result - the result is appended to its messages
+     * @return - true on success, false otherwise
+     */
+    bool writeSummary(const QString &filename, const LogdataStorage::Ptr &storagePtr, Result &result) const;
+
+    /**
+     * @brief outputBaseName - delivers the base name (path without extension) of the output files of a log.
+     *        Without output directory the files are written next to the log, otherwise the directory
+     *        structure of the searched directories is mirrored in the output directory.
+     * @param log - the log
+     * @return - the base name
+     */
+    QString outputBaseName(const LogFile &log) const;
+};
+
+#endif // LOGBATCHPROCESSOR_H
@@ -0,0 +1,80 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogExportThread.cpp
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the log export thread
+ */
+
+#include "LogExportThread.h"
+#include "logging.h"
+
+LogExportThread::LogExportThread(LogExporterBase::Ptr exporterPtr, LogdataStorage::Ptr storagePtr, QObject *parent) :
+    QThread(parent),
+    m_exporterPtr(exporterPtr),
+    m_dataStoragePtr(storagePtr),
+    m_lastProgressPercent(-1)
+{
+    QLOG_DEBUG() << "Created LogExportThread:" << this;
+}
+
+LogExportThread::~LogExportThread()
+{
+    QLOG_DEBUG() << "Destroyed LogExportThread:" << this;
+}
+
+void LogExportThread::exportFile(const QString &fileName)
+{
+    m_fileName = fileName;
+    start();
+}
+
+void LogExportThread::stopExport()
+{
+    m_exporterPtr->stopExport();
+}
+
+void LogExportThread::onProgress(const qint64 pos, const qint64 size)
+{
+    // Only emit if the percentage changed and some time has passed or the export is complete.
+    int percent = size > 0 ? static_cast<int>((100 * pos) / size) : 100;
+    if ((percent != m_lastProgressPercent) &&
+        ((percent == 100) || m_progressTimer.hasExpired(s_MinProgressIntervalMs)))
+    {
+        m_lastProgressPercent = percent;
+        m_progressTimer.restart();
+        emit exportProgress(pos, size);
+    }
+}
+
+void LogExportThread::run()
+{
+    emit exportStarted();
+    QElapsedTimer timer;
+    timer.start();
+    m_progressTimer.start();
+
+    QString result = m_exporterPtr->exportToFile(m_fileName, m_dataStoragePtr, this);
+
+    QLOG_INFO() << "Log export took" << timer.elapsed() / 1000.0 << "seconds -" << m_dataStoragePtr->rowCount() << "rows";
+    emit done(result);
+}
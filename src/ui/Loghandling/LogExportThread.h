@@ -0,0 +1,97 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogExportThread.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the log export thread
+ */
+
+#ifndef LOGEXPORTTHREAD_H
+#define LOGEXPORTTHREAD_H
+
+#include <QThread>
+#include <QElapsedTimer>
+
+#include "IExportCallback.h"
+#include "LogExporter.h"
+#include "LogdataStorage.h"
+
+/**
+ * @brief The LogExportThread class runs a LogExporterBase derived exporter in its
+ *        own thread. It throttles the progress information of the exporter so the
+ *        UI is not flooded with signals.
+ */
+class LogExportThread : public QThread, public IExportCallback
+{
+    Q_OBJECT
+public:
+
+    /**
+     * @brief LogExportThread - CTOR
+     * @param exporterPtr - the exporter to be used
+     * @param storagePtr - the datastorage holding the data to export
+     * @param parent - parent object
+     */
+    explicit LogExportThread(LogExporterBase::Ptr exporterPtr, LogdataStorage::Ptr storagePtr, QObject *parent = nullptr);
+
+    /**
+     * @brief ~LogExportThread - DTOR
+     */
+    ~LogExportThread() override;
+
+    /**
+     * @brief exportFile starts the export into file
+     * @param fileName - filename of the file to export to
+     */
+    void exportFile(const QString &fileName);
+
+    /**
+     * @brief stopExport stops the exporting process and forces
+     *        the exporter to return as soon as possible
+     */
+    void stopExport();
+
+    /**
+     * @copydoc IExportCallback::onProgress
+     */
+    void onProgress(const qint64 pos, const qint64 size) override;
+
+signals:
+    void exportStarted();                           /// Emited as soon as the export starts
+    void exportProgress(qint64 pos, qint64 size);   /// Emited to show export progress. Throttled.
+    void done(QString result);                      /// Emited as soon as the export is done. Contains result text
+
+private:
+
+    static constexpr qint64 s_MinProgressIntervalMs = 100;  /// Minimum time between two progress signals
+
+    QString m_fileName;                     /// Filename of the file to export to
+    LogExporterBase::Ptr m_exporterPtr;     /// The exporter doing the work
+    LogdataStorage::Ptr m_dataStoragePtr;   /// The data to be exported
+
+    QElapsedTimer m_progressTimer;  /// Used for throttling the progress signal
+    int m_lastProgressPercent;      /// Last emitted progress in percent
+
+    void run() override;            /// from QThread - the thread;
+};
+
+#endif // LOGEXPORTTHREAD_H
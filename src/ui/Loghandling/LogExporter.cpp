@@ -30,12 +30,17 @@ This file is part of the APM_PLANNER project
 #include "LogExporter.h"
 #include "logging.h"
 
-#include <QMessageBox>
-#include <QApplication>
-#include <QProgressDialog>
-#include <QScopedPointer>
-
-LogExporterBase::LogExporterBase(QWidget *parent) : mp_parent(parent)
+#include <QTextStream>
+#include <QFileInfo>
+#include <QDir>
+#include <QLocale>
+#include <cmath>
+
+LogExporterBase::LogExporterBase() :
+    m_stop(0),
+    m_timeFiltered(false),
+    m_startTime(0.0),
+    m_endTime(0.0)
 {
     QLOG_DEBUG() << "LogExporterBase::LogExporterBase()";
 }
@@ -45,11 +50,25 @@ LogExporterBase::~LogExporterBase()
     QLOG_DEBUG() << "LogExporterBase::~LogExporterBase()";
 }
 
+void LogExporterBase::stopExport()
+{
+    m_stop.store(1);
+}
+
+void LogExporterBase::setTypeFilter(const QStringList &typeNames)
+{
+    m_typeFilter = typeNames;
+}
 
-QString LogExporterBase::exportToFile(const QString &fileName, LogdataStorage::Ptr dataStoragePtr)
+void LogExporterBase::setTimeFilter(double startTime, double endTime)
 {
-    typedef QScopedPointer<QProgressDialog, QScopedPointerDeleteLater> scopedDelLaterPtr;
+    m_timeFiltered = true;
+    m_startTime = startTime;
+    m_endTime = endTime;
+}
 
+QString LogExporterBase::exportToFile(const QString &fileName, LogdataStorage::Ptr dataStoragePtr, IExportCallback *p_callback)
+{
     QLOG_DEBUG() << "LogExporterBase::exportToFile() Filename:" << fileName;
 
     if(!startExport(fileName))
@@ -57,27 +76,33 @@ QString LogExporterBase::exportToFile(const QString &fileName, LogdataStorage::P
         return m_ExportResult;
     }
 
-    // create progress dialog
-    scopedDelLaterPtr progressDialogPtr(new QProgressDialog("Exporting File", "Cancel", 0, 100, mp_parent));
-    progressDialogPtr->setWindowModality(Qt::WindowModal);
-    progressDialogPtr->show();
-    QApplication::processEvents();
+    // The buffer is reused for the whole export - reserve() keeps the capacity when truncating
+    m_outputBuffer.reserve(s_BlockSize + s_BlockSize / 4);
+    m_outputBuffer.truncate(0);
 
     // Export header data
-    QString formatheader = "FMT,128,89,FMT,BBnNZ,Type,Length,Name,Format,Columns";
-    writeLine(formatheader);
+    appendLine("FMT,128,89,FMT,BBnNZ,Type,Length,Name,Format,Columns");
 
     QVector<LogdataStorage::dataType> allDataTypesInModel;
     allDataTypesInModel = dataStoragePtr->getAllDataTypes();
 
+    // Cache the latin1 names and time stamp columns of all types - they are needed for every row
+    QHash<QString, QByteArray> typeNameCache;
+    typeNameCache.reserve(allDataTypesInModel.size());
+    QHash<QString, int> timeStampIndexCache;
+    timeStampIndexCache.reserve(allDataTypesInModel.size());
+
     QString outputLine;
     for(const auto &type : allDataTypesInModel)
     {
         QTextStream fmtStream(&outputLine);
         fmtStream << "FMT," << type.m_ID << "," << type.m_length << "," << type.m_name << ","
                   << type.m_format << "," << type.m_labels.join(",");
-        writeLine(outputLine);
+        fmtStream.flush();
+        appendLine(outputLine);
         outputLine.clear();
+        typeNameCache.insert(type.m_name, type.m_name.toLatin1());
+        timeStampIndexCache.insert(type.m_name, type.m_timeStampIndex);
     }
 
     // Export unit data
@@ -88,9 +113,10 @@ QString LogExporterBase::exportToFile(const QString &fileName, LogdataStorage::P
     {
         QTextStream unitStream(&outputLine);
         unitStream << "UNIT," << artificialTimeStamp << "," << unitIter.key() << "," << unitIter.value();
+        unitStream.flush();
         ++artificialTimeStamp;
         ++unitIter;
-        writeLine(outputLine);
+        appendLine(outputLine);
         outputLine.clear();
     }
 
@@ -100,9 +126,10 @@ QString LogExporterBase::exportToFile(const QString &fileName, LogdataStorage::P
     {
         QTextStream multStream(&outputLine);
         multStream << "MULT," << artificialTimeStamp << "," << multiIter.key() << "," << multiIter.value();
+        multStream.flush();
         ++artificialTimeStamp;
         ++multiIter;
-        writeLine(outputLine);
+        appendLine(outputLine);
         outputLine.clear();
     }
 
@@ -111,47 +138,210 @@ QString LogExporterBase::exportToFile(const QString &fileName, LogdataStorage::P
         QTextStream fmtuStream(&outputLine);
         auto dataPair = dataStoragePtr->getMsgToUnitAndMultiplierData(type.m_ID);
         fmtuStream << "FMTU," << artificialTimeStamp << "," << type.m_ID << ","<< dataPair.second << "," << dataPair.first;
+        fmtuStream.flush();
         ++artificialTimeStamp;
-        writeLine(outputLine);
+        appendLine(outputLine);
         outputLine.clear();
     }
 
-    // Export measurements
+    // Export measurements. With a type filter only the rows of those types are visited.
+    QString typeName;
     QVector<QVariant> measurements;
-    for(auto i = 0; i < dataStoragePtr->rowCount(); ++i)
+    const bool typeFiltered = !m_typeFilter.isEmpty();
+    const QVector<int> filteredRows = typeFiltered ? dataStoragePtr->getIndexesOfTypes(m_typeFilter) : QVector<int>();
+    const int rowCount = typeFiltered ? filteredRows.size() : dataStoragePtr->rowCount();
+    const double timeDivisor = dataStoragePtr->getTimeDivisor();
+    for(int i = 0; i < rowCount; ++i)
     {
-        dataStoragePtr->getRawDataRow(i, outputLine, measurements);
-        foreach(const QVariant &value, measurements)
+        if(!(i % s_RowsPerProgressCheck))
         {
-            outputLine.append(',');
-            outputLine.append(value.toString());
+            if(p_callback)
+            {
+                p_callback->onProgress(i, rowCount);
+            }
+            if(m_stop.load())
+            {
+                m_ExportResult.append("Export was canceled by user");
+                QLOG_DEBUG() << m_ExportResult;
+                return m_ExportResult;
+            }
+        }
+
+        dataStoragePtr->getRawDataRow(typeFiltered ? filteredRows.at(i) : i, typeName, measurements);
+        if(typeName.isEmpty())
+        {
+            continue;
         }
-        writeLine(outputLine);
-        outputLine.clear();
-        measurements.clear();
 
-        if(!(i % 5))
+        if(m_timeFiltered)
         {
-            progressDialogPtr->setValue(static_cast<int>(100.0 * (static_cast<double>(i) / static_cast<double>(dataStoragePtr->rowCount()))));
+            const double time = measurements.value(timeStampIndexCache.value(typeName)).toDouble() / timeDivisor;
+            if((time < m_startTime) || (time >= m_endTime))
+            {
+                continue;
+            }
         }
-        QApplication::processEvents();
-        if(progressDialogPtr->wasCanceled())
+
+        m_outputBuffer.append(typeNameCache.value(typeName));
+        for(const QVariant &value : qAsConst(measurements))
+        {
+            m_outputBuffer.append(',');
+            appendValue(m_outputBuffer, value);
+        }
+        m_outputBuffer.append("\r\n", 2);
+
+        if((m_outputBuffer.size() >= s_BlockSize) && !flushBuffer())
         {
-            progressDialogPtr->close();
-            m_ExportResult.append("Export was canceled by user");
-            QLOG_DEBUG() << m_ExportResult;
             return m_ExportResult;
         }
     }
 
-    progressDialogPtr->close();
+    if(!flushBuffer())
+    {
+        return m_ExportResult;
+    }
+    if(p_callback)
+    {
+        p_callback->onProgress(rowCount, rowCount);
+    }
+
     endExport();
     return m_ExportResult;
 }
 
+void LogExporterBase::appendLine(const QString &line)
+{
+    if(line.size() > 0)
+    {
+        m_outputBuffer.append(line.toLatin1());
+        m_outputBuffer.append("\r\n", 2);
+    }
+}
+
+bool LogExporterBase::flushBuffer()
+{
+    bool rc = true;
+    if(m_outputBuffer.size() > 0)
+    {
+        rc = writeBlock(m_outputBuffer);
+        m_outputBuffer.truncate(0);
+    }
+    return rc;
+}
+
+void LogExporterBase::appendValue(QByteArray &buffer, const QVariant &value) const
+{
+    switch(static_cast<QMetaType::Type>(value.userType()))
+    {
+    case QMetaType::Int:
+    case QMetaType::Short:
+    case QMetaType::SChar:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+        appendSigned(buffer, value.toLongLong());
+        break;
+
+    case QMetaType::UInt:
+    case QMetaType::UShort:
+    case QMetaType::UChar:
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+        appendUnsigned(buffer, value.toULongLong());
+        break;
+
+    case QMetaType::Float:
+        appendDouble(buffer, static_cast<double>(value.toFloat()), true);
+        break;
+
+    case QMetaType::Double:
+        appendDouble(buffer, value.toDouble(), false);
+        break;
+
+    default:
+        appendString(buffer, value.toString());
+        break;
+    }
+}
+
+void LogExporterBase::appendString(QByteArray &buffer, const QString &value) const
+{
+    buffer.append(value.toLatin1());
+}
+
+void LogExporterBase::appendUnsigned(QByteArray &buffer, quint64 value)
+{
+    char digits[20];    // max 20 digits for a 64 bit value
+    int pos = sizeof(digits);
+    do
+    {
+        digits[--pos] = static_cast<char>('0' + (value % 10));
+        value /= 10;
+    } while(value);
+
+    buffer.append(digits + pos, static_cast<int>(sizeof(digits)) - pos);
+}
+
+void LogExporterBase::appendSigned(QByteArray &buffer, qint64 value)
+{
+    if(value < 0)
+    {
+        buffer.append('-');
+        // negate in unsigned domain to handle the smallest qint64 correctly
+        appendUnsigned(buffer, ~static_cast<quint64>(value) + 1);
+    }
+    else
+    {
+        appendUnsigned(buffer, static_cast<quint64>(value));
+    }
+}
+
+void LogExporterBase::appendDouble(QByteArray &buffer, double value, bool isFloat)
+{
+    static constexpr double s_MaxExactIntegral = 9007199254740992.0;  // 2^53 - all integers up to here are exact
+
+    if(qIsNaN(value))
+    {
+        buffer.append("nan");
+        return;
+    }
+    if(qIsInf(value))
+    {
+        buffer.append(value < 0.0 ? "-inf" : "inf");
+        return;
+    }
+    // Most values in logs are integral (scaling is done by multipliers) - format them as integers
+    if((std::fabs(value) < s_MaxExactIntegral) && (std::floor(value) == value))
+    {
+        appendSigned(buffer, static_cast<qint64>(value));
+        return;
+    }
+
+    if(isFloat)
+    {
+        // Find the shortest representation which reads back to the same float.
+        // 9 digits always do, most values need less.
+        const float floatValue = static_cast<float>(value);
+        QByteArray text;
+        for(int precision = 6; precision <= 9; ++precision)
+        {
+            text = QByteArray::number(value, 'g', precision);
+            if(static_cast<float>(text.toDouble()) == floatValue)
+            {
+                break;
+            }
+        }
+        buffer.append(text);
+    }
+    else
+    {
+        // QLocale::FloatingPointShortest is locale independent and round trip safe
+        buffer.append(QByteArray::number(value, 'g', QLocale::FloatingPointShortest));
+    }
+}
+
 //***********************************************************************
 
-AsciiLogExporter::AsciiLogExporter(QWidget *parent) : LogExporterBase (parent)
+AsciiLogExporter::AsciiLogExporter()
 {
     QLOG_DEBUG() << "AsciiLogExporter::AsciiLogExporter()";
 }
@@ -168,7 +358,7 @@ AsciiLogExporter::~AsciiLogExporter()
 bool AsciiLogExporter::startExport(const QString &fileName)
 {
     m_outputFile.setFileName(fileName);
-    if (!m_outputFile.open(QIODevice::ReadWrite | QIODevice::Truncate))
+    if (!m_outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
     {
         QLOG_WARN() << "AsciiLogExporter::startExport() unable to open file.";
         m_ExportResult.append("Unable to open output file: ");
@@ -178,13 +368,17 @@ bool AsciiLogExporter::startExport(const QString &fileName)
     return true;
 }
 
-void AsciiLogExporter::writeLine(QString &line)
+bool AsciiLogExporter::writeBlock(const QByteArray &block)
 {
-    if (line.size() > 0)
+    if (m_outputFile.write(block) != block.size())
     {
-        line.append("\r\n");
-        m_outputFile.write(line.toLatin1());
+        QLOG_WARN() << "AsciiLogExporter::writeBlock() unable to write to file.";
+        m_ExportResult.append("Unable to write output file: ");
+        m_ExportResult.append(m_outputFile.errorString());
+        m_outputFile.close();
+        return false;
     }
+    return true;
 }
 
 void AsciiLogExporter::endExport()
@@ -197,8 +391,8 @@ void AsciiLogExporter::endExport()
 
 //***********************************************************************
 
-KmlLogExporter::KmlLogExporter(QWidget *parent, MAV_TYPE mav_type, double iconInterval) :
-    LogExporterBase (parent), m_kmlExporter(mav_type, iconInterval)
+KmlLogExporter::KmlLogExporter(MAV_TYPE mav_type, double iconInterval) :
+    m_kmlExporter(mav_type, iconInterval)
 {
     QLOG_DEBUG() << "KmlLogExporter::KmlLogExporter()";
 }
@@ -215,13 +409,20 @@ bool KmlLogExporter::startExport(const QString &fileName)
     return true;
 }
 
-void KmlLogExporter::writeLine(QString &line)
+bool KmlLogExporter::writeBlock(const QByteArray &block)
 {
-    if (line.size() > 0)
+    // The KML creator is line based - feed it line by line including the line ending
+    QString line;
+    int lineStart = 0;
+    int lineEnd = block.indexOf('\n', lineStart);
+    while (lineEnd != -1)
     {
-        line.append("\r\n");
+        line = QString::fromLatin1(block.constData() + lineStart, lineEnd - lineStart + 1);
         m_kmlExporter.processLine(line);
+        lineStart = lineEnd + 1;
+        lineEnd = block.indexOf('\n', lineStart);
     }
+    return true;
 }
 
 void KmlLogExporter::endExport()
@@ -231,3 +432,133 @@ void KmlLogExporter::endExport()
     m_ExportResult.append(generated);
     QLOG_DEBUG() << m_ExportResult;
 }
+
+//***********************************************************************
+
+CsvLogExporter::CsvLogExporter()
+{
+    QLOG_DEBUG() << "CsvLogExporter::CsvLogExporter()";
+}
+
+CsvLogExporter::~CsvLogExporter()
+{
+    QLOG_DEBUG() << "CsvLogExporter::~CsvLogExporter()";
+}
+
+bool CsvLogExporter::startExport(const QString &fileName)
+{
+    const QFileInfo fileInfo(fileName);
+    m_baseName = fileInfo.dir().filePath(fileInfo.completeBaseName());
+    m_typeToLabels.clear();
+    m_files.clear();
+    return true;
+}
+
+bool CsvLogExporter::writeBlock(const QByteArray &block)
+{
+    int lineStart = 0;
+    int lineEnd = block.indexOf('\n', lineStart);
+    while (lineEnd != -1)
+    {
+        const int nameEnd = block.indexOf(',', lineStart);
+        if ((nameEnd != -1) && (nameEnd < lineEnd))
+        {
+            const QByteArray typeName = block.mid(lineStart, nameEnd - lineStart);
+            if (typeName == "FMT")
+            {
+                // FMT,Type,Length,Name,Format,Columns... - the columns are the header of the type
+                const QList<QByteArray> parts = block.mid(lineStart, lineEnd - lineStart).trimmed().split(',');
+                if (parts.size() > 5)
+                {
+                    QByteArray labels = parts.at(5);
+                    for (int i = 6; i < parts.size(); ++i)
+                    {
+                        labels.append(',');
+                        labels.append(parts.at(i));
+                    }
+                    m_typeToLabels.insert(parts.at(3), labels);
+                }
+            }
+            else if ((typeName != "UNIT") && (typeName != "MULT") && (typeName != "FMTU"))
+            {
+                QFile *p_file = fileForType(typeName);
+                if (!p_file)
+                {
+                    return false;
+                }
+                // write the values including the line ending
+                const qint64 size = lineEnd - nameEnd;
+                if (p_file->write(block.constData() + nameEnd + 1, size) != size)
+                {
+                    QLOG_WARN() << "CsvLogExporter::writeBlock() unable to write to file.";
+                    m_ExportResult.append("Unable to write output file: ");
+                    m_ExportResult.append(p_file->errorString());
+                    return false;
+                }
+            }
+        }
+        lineStart = lineEnd + 1;
+        lineEnd = block.indexOf('\n', lineStart);
+    }
+    return true;
+}
+
+void CsvLogExporter::appendString(QByteArray &buffer, const QString &value) const
+{
+    buffer.append('"');
+    for (const QChar &character : value)
+    {
+        const char latin1 = character.toLatin1();
+        if (latin1 == '"')
+        {
+            buffer.append("\"\"", 2);
+        }
+        else if ((latin1 == '\r') || (latin1 == '\n'))
+        {
+            buffer.append(' ');
+        }
+        else
+        {
+            buffer.append(latin1);
+        }
+    }
+    buffer.append('"');
+}
+
+void CsvLogExporter::endExport()
+{
+    for (auto &filePtr : m_files)
+    {
+        filePtr->close();
+    }
+    m_ExportResult.append("Successfull exported ");
+    m_ExportResult.append(QString::number(m_files.size()));
+    m_ExportResult.append(" types to ");
+    m_ExportResult.append(m_baseName);
+    m_ExportResult.append("_*.csv");
+    QLOG_DEBUG() << m_ExportResult;
+    m_files.clear();
+}
+
+QFile *CsvLogExporter::fileForType(const QByteArray &typeName)
+{
+    auto iter = m_files.find(typeName);
+    if (iter != m_files.end())
+    {
+        return iter->data();
+    }
+
+    QSharedPointer<QFile> filePtr(new QFile(m_baseName + '_' + QString::fromLatin1(typeName) + ".csv"));
+    if (!filePtr->open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        QLOG_WARN() << "CsvLogExporter::fileForType() unable to open file" << filePtr->fileName();
+        m_ExportResult.append("Unable to open output file: ");
+        m_ExportResult.append(filePtr->errorString());
+        return nullptr;
+    }
+    QByteArray header = m_typeToLabels.value(typeName);
+    header.append("\r\n", 2);
+    filePtr->write(header);
+    m_files.insert(typeName, filePtr);
+    return filePtr.data();
+}
@@ -31,14 +31,21 @@ This file is part of the APM_PLANNER project
 #define LOGEXPORTER_H
 
 #include <QString>
+#include <QByteArray>
+#include <QAtomicInt>
+#include <QStringList>
+#include <QHash>
 
 #include "LogdataStorage.h"
+#include "IExportCallback.h"
 #include "src/output/kmlcreator.h"
 
 /**
  * @brief The LogExporterBase class - for different log exporters. It handles
  *        the exporting workflow for every line oriented export.
- *        It provides a progress dialog with a cancel button.
+ *        The exporter does not need any UI so it can (and should) be run in
+ *        its own thread. The lines are formatted into a big reusable buffer
+ *        which is handed to the derived class blockwise.
  */
 class LogExporterBase
 {
@@ -51,9 +58,8 @@ public:
 
     /**
      * @brief LogExporterBase - CTOR
-     * @param parent - Parent widget needed for progress and info windows.
      */
-    explicit LogExporterBase(QWidget *parent);
+    explicit LogExporterBase();
 
     /**
      * @brief ~LogExporterBase - DTOR
@@ -65,9 +71,31 @@ public:
      *        dataStoragePtr to a file with name fileName.
      * @param fileName - filename for the export
      * @param dataStoragePtr - shared pointer to a filled LogdataStorage
+     * @param p_callback - pointer to a callback for progress information. Can be nullptr.
      * @return QString with information about the export. Can be shown to the user.
      */
-    QString exportToFile(const QString &fileName, LogdataStorage::Ptr dataStoragePtr);
+    QString exportToFile(const QString &fileName, LogdataStorage::Ptr dataStoragePtr, IExportCallback *p_callback = nullptr);
+
+    /**
+     * @brief stopExport - forces the exportToFile method to return as soon as possible.
+     *        Can be called from any thread.
+     */
+    void stopExport();
+
+    /**
+     * @brief setTypeFilter - restricts the exported rows to some types. The format
+     *        descriptors of all types are exported anyway. Must be called before exportToFile().
+     * @param typeNames - names of the types to export. An empty list exports all types.
+     */
+    void setTypeFilter(const QStringList &typeNames);
+
+    /**
+     * @brief setTimeFilter - restricts the exported rows to a time range. Must be called
+     *        before exportToFile().
+     * @param startTime - start of the range in seconds (included)
+     * @param endTime - end of the range in seconds (excluded)
+     */
+    void setTimeFilter(double startTime, double endTime);
 
 protected:
 
@@ -75,22 +103,33 @@ protected:
 
 private:
 
-    QWidget *mp_parent; /// pointer to parent widget - do not delete
+    static constexpr int s_BlockSize = 4 * 1024 * 1024;   /// Size of the output buffer. It is handed to writeBlock() when full.
+    static constexpr int s_RowsPerProgressCheck = 5000;   /// Number of rows between progress reports and stop checks
+
+    QByteArray m_outputBuffer;  /// Buffer holding the formatted lines until written
+    QAtomicInt m_stop;          /// != 0 if export shall be stopped
+
+    QStringList m_typeFilter;   /// Types to export - empty exports all
+    bool m_timeFiltered;        /// true if the rows are filtered by time
+    double m_startTime;         /// Start of the exported time range in seconds
+    double m_endTime;           /// End of the exported time range in seconds
 
     /**
      * @brief startExport - must be implemented by derived classes. It has to setup
-     *        all preconditions needed to call writeline afterwards.
+     *        all preconditions needed to call writeBlock afterwards.
      * @param fileName - filename for the export
      * @return true on success, false otherwise
      */
     virtual bool startExport(const QString &fileName) = 0;
 
     /**
-     * @brief writeLine - must be implemented by derived classes. Will be called by the
-     *        export function for every logline stored in datamodel.
-     * @param line - All data as a string
+     * @brief writeBlock - must be implemented by derived classes. Will be called by the
+     *        export function whenever the output buffer is full and at the end of the
+     *        export. The block contains complete lines terminated by "\r\n".
+     * @param block - the formatted lines
+     * @return true on success, false otherwise (export will be aborted)
      */
-    virtual void writeLine(QString &line) = 0;
+    virtual bool writeBlock(const QByteArray &block) = 0;
 
     /**
      * @brief endExport - must be implemented by derived classes. Will be called by the
@@ -98,6 +137,56 @@ private:
      *        resources.
      */
     virtual void endExport() = 0;
+
+    /**
+     * @brief appendLine - appends line plus line ending to the output buffer. Used for the
+     *        header lines.
+     * @param line - the line to append
+     */
+    void appendLine(const QString &line);
+
+    /**
+     * @brief flushBuffer - hands the output buffer to writeBlock() and clears it
+     *        keeping its capacity.
+     * @return result of writeBlock()
+     */
+    bool flushBuffer();
+
+    /**
+     * @brief appendValue - formats value and appends it to buffer. Numeric types are
+     *        formatted without creating any temporary strings where possible, all
+     *        other types are handed to appendString().
+     * @param buffer - buffer to append to
+     * @param value - value to be formatted
+     */
+    void appendValue(QByteArray &buffer, const QVariant &value) const;
+
+    /**
+     * @brief appendString - appends a string value to buffer. The default appends the
+     *        plain latin1 text, derived classes may escape it for their format.
+     * @param buffer - buffer to append to
+     * @param value - the string value
+     */
+    virtual void appendString(QByteArray &buffer, const QString &value) const;
+
+    /**
+     * @brief appendUnsigned - appends the decimal text of value to buffer
+     */
+    static void appendUnsigned(QByteArray &buffer, quint64 value);
+
+    /**
+     * @brief appendSigned - appends the decimal text of value to buffer
+     */
+    static void appendSigned(QByteArray &buffer, qint64 value);
+
+    /**
+     * @brief appendDouble - appends the shortest text of value which reads back to the
+     *        same value. Integral values are handled by appendSigned().
+     * @param buffer - buffer to append to
+     * @param value - value to be formatted
+     * @param isFloat - true if value is a single precision value
+     */
+    static void appendDouble(QByteArray &buffer, double value, bool isFloat);
 };
 
 //***********************************************************************
@@ -116,9 +205,8 @@ public:
 
     /**
      * @brief AsciiLogExporter - CTOR
-     * @param parent - Parent widget needed for progress and info windows.
      */
-    AsciiLogExporter(QWidget *parent);
+    AsciiLogExporter();
 
     /**
      * @brief ~AsciiLogExporter - DTOR
@@ -137,10 +225,11 @@ private:
     virtual bool startExport(const QString &fileName);
 
     /**
-     * @brief writeLine - writes the line directly into the output file.
-     * @param line - string to be written to the file
+     * @brief writeBlock - writes the block directly into the output file.
+     * @param block - data to be written to the file
+     * @return true on success, false otherwise
      */
-    virtual void writeLine(QString &line);
+    virtual bool writeBlock(const QByteArray &block);
 
     /**
      * @brief endExport - closes the output file
@@ -165,9 +254,10 @@ public:
 
     /**
      * @brief KmlLogExporter - CTOR
-     * @param parent - Parent widget needed for progress and info windows.
+     * @param mav_type - MAV type used for the plane icons
+     * @param iconInterval - minimum plane icon interval in meters
      */
-    KmlLogExporter(QWidget *parent, MAV_TYPE mav_type, double iconInterval);
+    KmlLogExporter(MAV_TYPE mav_type, double iconInterval);
 
     /**
      * @brief ~KmlLogExporter - DTOR
@@ -186,11 +276,12 @@ private:
     virtual bool startExport(const QString &fileName);
 
     /**
-     * @brief writeLine - gives the line to kmlExporter which extracts the
-     *        neede data.
-     * @param line - data to be analyzed
+     * @brief writeBlock - splits the block into lines and gives them to the
+     *        kmlExporter which extracts the needed data.
+     * @param block - data to be analyzed
+     * @return always true
      */
-    virtual void writeLine(QString &line);
+    virtual bool writeBlock(const QByteArray &block);
 
     /**
      * @brief endExport - exports the data collected by the kmlExporter to
@@ -200,4 +291,73 @@ private:
 };
 
 
+//***********************************************************************
+
+/**
+ * @brief The CsvLogExporter class is used to export csv files. As every type has
+ *        its own columns one file per type is created. The files are named like
+ *        the export file with the type name appended ("flight_GPS.csv"). The first
+ *        line of each file holds the column labels.
+ */
+class CsvLogExporter : public LogExporterBase
+{
+public:
+    /**
+     * @brief Shared pointer for CsvLogExporter objects
+     */
+    typedef QSharedPointer<CsvLogExporter> Ptr;
+
+    /**
+     * @brief CsvLogExporter - CTOR
+     */
+    CsvLogExporter();
+
+    /**
+     * @brief ~CsvLogExporter - DTOR
+     */
+    virtual ~CsvLogExporter();
+
+private:
+    QString m_baseName;                                 /// Export file name without extension
+    QHash<QByteArray, QByteArray> m_typeToLabels;       /// Header line of every type - taken from the FMT lines
+    QHash<QByteArray, QSharedPointer<QFile> > m_files;  /// Output file of every type - created on first row
+
+    /**
+     * @brief startExport - stores the base name of the output files
+     * @param fileName - file name. Its extension is replaced by "_<type>.csv"
+     * @return - always true
+     */
+    virtual bool startExport(const QString &fileName);
+
+    /**
+     * @brief writeBlock - splits the block into lines and writes each data line
+     *        without its type name to the file of its type.
+     * @param block - data to be written
+     * @return true on success, false otherwise
+     */
+    virtual bool writeBlock(const QByteArray &block);
+
+    /**
+     * @brief appendString - appends the value as quoted csv field. Embedded quotes
+     *        are doubled, line breaks are replaced by spaces as writeBlock() splits
+     *        the rows at the line endings.
+     * @param buffer - buffer to append to
+     * @param value - the string value
+     */
+    virtual void appendString(QByteArray &buffer, const QString &value) const;
+
+    /**
+     * @brief endExport - closes all output files
+     */
+    virtual void endExport();
+
+    /**
+     * @brief fileForType - delivers the output file of a type. Creates and opens it
+     *        and writes the header line if needed.
+     * @param typeName - name of the type
+     * @return - the file or nullptr if it could not be opened
+     */
+    QFile *fileForType(const QByteArray &typeName);
+};
+
 #endif // LOGEXPORTER_H
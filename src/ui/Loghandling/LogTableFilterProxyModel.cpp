@@ -0,0 +1,211 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogTableFilterProxyModel.cpp
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the filter proxy of the log table view
+ */
+
+#include "LogTableFilterProxyModel.h"
+#include "logging.h"
+
+#include <algorithm>
+
+LogTableFilterProxyModel::LogTableFilterProxyModel(QObject *parent) :
+    QAbstractProxyModel(parent),
+    m_filtered(false)
+{
+    QLOG_DEBUG() << "LogTableFilterProxyModel::LogTableFilterProxyModel()";
+}
+
+LogTableFilterProxyModel::~LogTableFilterProxyModel()
+{
+    QLOG_DEBUG() << "LogTableFilterProxyModel::~LogTableFilterProxyModel()";
+}
+
+void LogTableFilterProxyModel::setVisibleRows(const QVector<int> &sourceRows)
+{
+    beginResetModel();
+    m_proxyToSourceRow = sourceRows;
+    m_filtered = true;
+    endResetModel();
+}
+
+void LogTableFilterProxyModel::clearFilter()
+{
+    beginResetModel();
+    m_proxyToSourceRow.clear();
+    m_proxyToSourceRow.squeeze();
+    m_filtered = false;
+    endResetModel();
+}
+
+bool LogTableFilterProxyModel::isFiltered() const
+{
+    return m_filtered;
+}
+
+int LogTableFilterProxyModel::nearestProxyRow(int sourceRow) const
+{
+    if (!m_filtered)
+    {
+        return sourceModel() ? qBound(0, sourceRow, sourceModel()->rowCount() - 1) : -1;
+    }
+    if (m_proxyToSourceRow.empty())
+    {
+        return -1;
+    }
+
+    // first visible row which is bigger than sourceRow. The one before is the one we want.
+    auto iter = std::upper_bound(m_proxyToSourceRow.constBegin(), m_proxyToSourceRow.constEnd(), sourceRow);
+    if (iter == m_proxyToSourceRow.constBegin())
+    {
+        return 0;   // no visible row before - use the first one
+    }
+    return static_cast<int>(iter - m_proxyToSourceRow.constBegin()) - 1;
+}
+
+void LogTableFilterProxyModel::setSourceModel(QAbstractItemModel *newSourceModel)
+{
+    beginResetModel();
+    if (sourceModel())
+    {
+        disconnect(sourceModel(), nullptr, this, nullptr);
+    }
+
+    QAbstractProxyModel::setSourceModel(newSourceModel);
+    m_proxyToSourceRow.clear();
+    m_filtered = false;
+
+    if (newSourceModel)
+    {
+        connect(newSourceModel, SIGNAL(headerDataChanged(Qt::Orientation,int,int)),
+                this, SLOT(sourceHeaderDataChanged(Qt::Orientation,int,int)));
+        connect(newSourceModel, SIGNAL(modelAboutToBeReset()), this, SLOT(sourceModelAboutToBeReset()));
+        connect(newSourceModel, SIGNAL(modelReset()), this, SLOT(sourceModelReset()));
+    }
+    endResetModel();
+}
+
+QModelIndex LogTableFilterProxyModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+    if (!sourceIndex.isValid())
+    {
+        return {};
+    }
+    if (!m_filtered)
+    {
+        return createIndex(sourceIndex.row(), sourceIndex.column());
+    }
+
+    auto iter = std::lower_bound(m_proxyToSourceRow.constBegin(), m_proxyToSourceRow.constEnd(), sourceIndex.row());
+    if (iter == m_proxyToSourceRow.constEnd() || *iter != sourceIndex.row())
+    {
+        return {};  // row is filtered
+    }
+    return createIndex(static_cast<int>(iter - m_proxyToSourceRow.constBegin()), sourceIndex.column());
+}
+
+QModelIndex LogTableFilterProxyModel::mapToSource(const QModelIndex &proxyIndex) const
+{
+    if (!proxyIndex.isValid() || !sourceModel())
+    {
+        return {};
+    }
+    int sourceRow = m_filtered ? m_proxyToSourceRow.at(proxyIndex.row()) : proxyIndex.row();
+    return sourceModel()->index(sourceRow, proxyIndex.column());
+}
+
+QModelIndex LogTableFilterProxyModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (parent.isValid() || row < 0 || column < 0 || row >= rowCount() || column >= columnCount())
+    {
+        return {};
+    }
+    return createIndex(row, column);
+}
+
+QModelIndex LogTableFilterProxyModel::parent(const QModelIndex &child) const
+{
+    Q_UNUSED(child)
+    return {};  // flat table
+}
+
+int LogTableFilterProxyModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid() || !sourceModel())
+    {
+        return 0;
+    }
+    return m_filtered ? m_proxyToSourceRow.size() : sourceModel()->rowCount();
+}
+
+int LogTableFilterProxyModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid() || !sourceModel())
+    {
+        return 0;
+    }
+    return sourceModel()->columnCount();
+}
+
+QVariant LogTableFilterProxyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (!sourceModel())
+    {
+        return {};
+    }
+    // Columns are not filtered so the horizontal header can be passed directly
+    if (orientation == Qt::Vertical && m_filtered)
+    {
+        if (section < 0 || section >= m_proxyToSourceRow.size())
+        {
+            return {};
+        }
+        section = m_proxyToSourceRow.at(section);
+    }
+    return sourceModel()->headerData(section, orientation, role);
+}
+
+void LogTableFilterProxyModel::sourceHeaderDataChanged(Qt::Orientation orientation, int first, int last)
+{
+    if (orientation == Qt::Horizontal)
+    {
+        emit headerDataChanged(orientation, first, last);
+    }
+    else
+    {
+        emit headerDataChanged(orientation, 0, rowCount() - 1);
+    }
+}
+
+void LogTableFilterProxyModel::sourceModelAboutToBeReset()
+{
+    beginResetModel();
+}
+
+void LogTableFilterProxyModel::sourceModelReset()
+{
+    m_proxyToSourceRow.clear();
+    m_filtered = false;
+    endResetModel();
+}
@@ -0,0 +1,147 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogTableFilterProxyModel.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the filter proxy of the log table view
+ */
+
+#ifndef LOGTABLEFILTERPROXYMODEL_H
+#define LOGTABLEFILTERPROXYMODEL_H
+
+#include <QAbstractProxyModel>
+#include <QVector>
+
+/**
+ * @brief The LogTableFilterProxyModel class is a flat proxy model for the
+ *        log table view. Instead of evaluating a filter expression on every
+ *        source row like QSortFilterProxyModel does, it holds a sorted
+ *        projection of the visible source rows. Mapping between source
+ *        and proxy rows is done by binary search.
+ *        Without a projection the proxy passes all rows 1:1.
+ */
+class LogTableFilterProxyModel : public QAbstractProxyModel
+{
+    Q_OBJECT
+public:
+
+    /**
+     * @brief LogTableFilterProxyModel - CTOR
+     * @param parent - parent object
+     */
+    explicit LogTableFilterProxyModel(QObject *parent = nullptr);
+
+    /**
+     * @brief ~LogTableFilterProxyModel - DTOR
+     */
+    ~LogTableFilterProxyModel() override;
+
+    /**
+     * @brief setVisibleRows sets the source rows which shall be visible.
+     * @param sourceRows - the visible source rows. MUST be sorted ascending.
+     */
+    void setVisibleRows(const QVector<int> &sourceRows);
+
+    /**
+     * @brief clearFilter removes the projection - all source rows are visible.
+     */
+    void clearFilter();
+
+    /**
+     * @brief isFiltered
+     * @return true if a projection is active, false otherwise
+     */
+    bool isFiltered() const;
+
+    /**
+     * @brief nearestProxyRow delivers the proxy row of the last visible source
+     *        row which is less or equal to sourceRow. If there is none the first
+     *        visible row is delivered.
+     * @param sourceRow - row in source model
+     * @return the proxy row or -1 if there are no visible rows at all
+     */
+    int nearestProxyRow(int sourceRow) const;
+
+    /**
+     * @see help of QAbstractProxyModel::setSourceModel
+     */
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+    /**
+     * @see help of QAbstractProxyModel::mapFromSource
+     */
+    QModelIndex mapFromSource(const QModelIndex &sourceIndex) const override;
+
+    /**
+     * @see help of QAbstractProxyModel::mapToSource
+     */
+    QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+
+    /**
+     * @see help of QAbstractItemModel::index
+     */
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+
+    /**
+     * @see help of QAbstractItemModel::parent
+     */
+    QModelIndex parent(const QModelIndex &child) const override;
+
+    /**
+     * @see help of QAbstractItemModel::rowCount
+     */
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /**
+     * @see help of QAbstractItemModel::columnCount
+     */
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /**
+     * @see help of QAbstractProxyModel::headerData
+     */
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private slots:
+
+    /**
+     * @brief sourceHeaderDataChanged forwards header changes of the source model
+     */
+    void sourceHeaderDataChanged(Qt::Orientation orientation, int first, int last);
+
+    /**
+     * @brief sourceModelAboutToBeReset forwards the reset of the source model
+     */
+    void sourceModelAboutToBeReset();
+
+    /**
+     * @brief sourceModelReset forwards the reset of the source model and drops the projection
+     */
+    void sourceModelReset();
+
+private:
+
+    bool m_filtered;                    ///< true if m_proxyToSourceRow is in use
+    QVector<int> m_proxyToSourceRow;    ///< Sorted source rows - the proxy row is the position in vector
+};
+
+#endif // LOGTABLEFILTERPROXYMODEL_H
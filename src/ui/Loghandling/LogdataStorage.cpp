@@ -29,7 +29,54 @@ This file is part of the APM_PLANNER project
 
 #include "LogdataStorage.h"
 #include "logging.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <QMultiHash>
 #include <algorithm>
+#include <iterator>
+
+namespace
+{
+
+/**
+ * @brief The LayoutCache struct holds the data type layouts of all storages.
+ *        Used by LogdataStorage::shareLayout().
+ */
+struct LayoutCache
+{
+    static constexpr int s_MaxLayouts = 4096;   /// The cache is cleared if it grows larger
+
+    QMutex m_mutex;
+    QMultiHash<QString, LogdataStorage::dataType> m_layouts;
+};
+
+LayoutCache &layoutCache()
+{
+    static LayoutCache s_cache;
+    return s_cache;
+}
+
+/**
+ * @brief sameMultipliers compares two multiplier vectors. Unknown multipliers are
+ *        NaN which have to be treated as equal.
+ */
+bool sameMultipliers(const QVector<double> &first, const QVector<double> &second)
+{
+    if(first.size() != second.size())
+    {
+        return false;
+    }
+    for(int i = 0; i < first.size(); ++i)
+    {
+        if(!(first.at(i) == second.at(i) || (qIsNaN(first.at(i)) && qIsNaN(second.at(i)))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
 
 /**
  * @brief The TimeStampToIndexPairComparer class is a functor for sorting the
@@ -163,11 +210,24 @@ bool LogdataStorage::addDataType(const QString &typeName, quint32 typeID, int ty
     // One for the index and one for the name.
     m_columnCount = m_columnCount < (typeLabels.size() + s_ColumnOffset) ? typeLabels.size() + s_ColumnOffset : m_columnCount;
 
-    // create new type and store it
+    // create new type and store it. Logs of the same firmware share the layout.
     dataType NewType(typeName, typeID, typeLength, typeFormat, typeLabels, timeColumn);
-    m_typeStorage.insert(typeName, NewType);
+    shareLayout(NewType);
+    m_typeStorage.insert(NewType.m_name, NewType);
     // to be able to recreate the order we store the names in a vector.
-    m_indexToTypeRow.push_back(typeName);
+    m_indexToTypeRow.push_back(NewType.m_name);
+
+    // Event types get an event index which is filled while adding rows
+    QStringList eventFields = getEventFieldNames(typeName);
+    if(!eventFields.empty())
+    {
+        EventIndex &eventIndex = m_eventIndex[typeName];
+        eventIndex.m_fieldIndexes.clear();
+        for(const auto &field : eventFields)
+        {
+            eventIndex.m_fieldIndexes.push_back(typeLabels.indexOf(field));
+        }
+    }
 
     return true;
 }
@@ -222,6 +282,31 @@ bool LogdataStorage::addDataRow(const QString &typeName, const QList<QPair<QStri
     TimeStampToIndexPair timeIndex(tempTime, newRow.m_index);
     // and add it to time index
     m_TimeToIndexList.push_back(timeIndex);
+
+    // add event types to the event index
+    auto eventIter = m_eventIndex.find(typeName);
+    if(eventIter != m_eventIndex.end())
+    {
+        EventRecord record;
+        record.m_index = newRow.m_index;
+        record.m_timeStamp = tempTime;
+        for(int i = 0; i < eventIter->m_fieldIndexes.size() && i < 3; ++i)
+        {
+            int fieldIndex = eventIter->m_fieldIndexes.at(i);
+            if(fieldIndex >= 0)
+            {
+                // ascii logs store numbers as strings - only fields which can not be
+                // converted (MSG text) are not stored in the record
+                bool ok = false;
+                const quint32 value = values.at(fieldIndex).second.toUInt(&ok);
+                if(ok)
+                {
+                    record.m_values[i] = value;
+                }
+            }
+        }
+        eventIter->m_records.push_back(record);
+    }
     return true;
 }
 
@@ -259,6 +344,23 @@ void LogdataStorage::setTimeStamp(const QString &timeStampName, double divisor)
     // As this method is called at the End of the parsing we should use the chance to sort the time index by
     // time - just to be sure...
     std::stable_sort(m_TimeToIndexList.begin(), m_TimeToIndexList.end(), TimeStampToIndexPairComparer());
+
+    // Create the time index for each type. Used for fast lookups on a subset of types.
+    m_typeTimeIndex.clear();
+    for(auto iter = m_dataStorage.constBegin(); iter != m_dataStorage.constEnd(); ++iter)
+    {
+        const int timeStampIndex = m_typeStorage.value(iter.key()).m_timeStampIndex;
+        QVector<TimeStampToIndexPair> &timeIndex = m_typeTimeIndex[iter.key()];
+        timeIndex.reserve(iter.value().size());
+        for(const auto &row : iter.value())
+        {
+            timeIndex.push_back(TimeStampToIndexPair(row.m_values.at(timeStampIndex).toULongLong(), row.m_index));
+        }
+        if(!std::is_sorted(timeIndex.constBegin(), timeIndex.constEnd(), TimeStampToIndexPairComparer()))
+        {
+            std::stable_sort(timeIndex.begin(), timeIndex.end(), TimeStampToIndexPairComparer());
+        }
+    }
 }
 
 double LogdataStorage::getTimeDivisor() const
@@ -327,6 +429,30 @@ QVector<LogdataStorage::dataType> LogdataStorage::getAllDataTypes() const
 
 
 bool LogdataStorage::getValues(const QString &name, bool useTimeAsIndex, QVector<double> &xValues, QVector<double> &yValues) const
+{
+    Series series;
+    if(!getSeries(name, useTimeAsIndex, series))
+    {
+        return false;
+    }
+
+    const int size {series.size()};
+    xValues.clear();
+    xValues.reserve(size);
+    yValues.clear();
+    yValues.reserve(size);
+
+    // copy the requested data
+    for(int i = 0; i < size; ++i)
+    {
+        xValues.push_back(series.key(i));
+        yValues.push_back(series.value(i));
+    }
+
+    return true;
+}
+
+bool LogdataStorage::getSeries(const QString &name, bool useTimeAsIndex, Series &series) const
 {
     // we expect a name like groupName.indexName:idx.valueName or groupName.valueName
 
@@ -353,62 +479,34 @@ bool LogdataStorage::getValues(const QString &name, bool useTimeAsIndex, QVector
         return false;    // don't have this value type
     }
 
-    const int timeStampIndex {type.m_timeStampIndex};
-    double multiplier {qQNaN()};                        // Unknown multiplier is always qQNaN
-    if(type.m_multipliers.size() > valueIndex)
+    series = Series();
+    series.m_rows = m_dataStorage[splitName.at(0)];     // shallow copy
+    series.m_valueColumn = valueIndex;
+    if(useTimeAsIndex)
     {
-        multiplier = type.m_multipliers[valueIndex];
+        series.m_keyColumn = type.m_timeStampIndex;
+        series.m_timeDivisor = m_timeDivisor;
+    }
+    // Unknown multiplier is always qQNaN - the values are not scaled then
+    if((type.m_multipliers.size() > valueIndex) && !qIsNaN(type.m_multipliers[valueIndex]))
+    {
+        series.m_multiplier = type.m_multipliers[valueIndex];
     }
 
-    int reqDataline {};
-    bool canHaveMultipleDatalines {false};
-    if (splitName.size() == 3)
+    // only if we really have more than one dataline.
+    if ((splitName.size() == 3) && (type.m_maxIndex > 0))
     {
         // this is an indexed type. The index is splitName[1]. Its like instance:0, instance:1 ...
         const auto indexSplit = splitName[1].split(':');
-        reqDataline = indexSplit.at(1).trimmed().toInt();
-        canHaveMultipleDatalines = true;
-    }
+        const int reqDataline {indexSplit.at(1).trimmed().toInt()};
 
-    int datalines {type.m_maxIndex + 1};
-    const ValueTable &data {m_dataStorage[splitName.at(0)]};
-
-    xValues.clear();
-    xValues.reserve((data.size() / (datalines)) + 2 );  // the +2 is to gurantee the vector is big enough (really no reallocation is needed)
-    yValues.clear();
-    yValues.reserve((data.size() / (datalines)) + 2 );
-
-    // copy the requested data
-    if (canHaveMultipleDatalines && (datalines > 1))    // only if we really have more than one dataline.
-    {
-        for (const auto &valueRow: data)
-        {
-            if (valueRow.m_values.at(type.m_indexFieldIndex).toInt() == reqDataline)    // only if its the requested dataline
-            {
-                xValues.push_back((useTimeAsIndex ? valueRow.m_values.at(timeStampIndex).toDouble() / m_timeDivisor : valueRow.m_index));
-                if(!qIsNaN(multiplier))
-                {
-                    yValues.push_back(valueRow.m_values.at(valueIndex).toDouble() * multiplier);
-                }
-                else
-                {
-                    yValues.push_back(valueRow.m_values.at(valueIndex).toDouble());
-                }
-            }
-        }
-    }
-    else
-    {
-        for (const auto &valueRow: data)
+        series.m_usePositions = true;
+        series.m_positions.reserve((series.m_rows.size() / (type.m_maxIndex + 1)) + 2);
+        for (int i = 0; i < series.m_rows.size(); ++i)
         {
-            xValues.push_back((useTimeAsIndex ? valueRow.m_values.at(timeStampIndex).toDouble() / m_timeDivisor : valueRow.m_index));
-            if(!qIsNaN(multiplier))
+            if (series.m_rows.at(i).m_values.at(type.m_indexFieldIndex).toInt() == reqDataline)    // only if its the requested dataline
             {
-                yValues.push_back(valueRow.m_values.at(valueIndex).toDouble() * multiplier);
-            }
-            else
-            {
-                yValues.push_back(valueRow.m_values.at(valueIndex).toDouble());
+                series.m_positions.push_back(i);
             }
         }
     }
@@ -462,11 +560,12 @@ double LogdataStorage::getMaxTimeStamp() const
 
 int LogdataStorage::getNearestIndexForTimestamp(double timevalue) const
 {
-    auto timeToFind   = static_cast<quint64>(m_timeDivisor * timevalue);
-    auto intervalSize = static_cast<float>(m_TimeToIndexList.size());
-    float intervalStart = 0;
-    float middle = 0;
-    int   index = 0;
+    if(m_TimeToIndexList.empty())
+    {
+        return 0;
+    }
+
+    auto timeToFind = static_cast<quint64>(m_timeDivisor * timevalue);
 
     // first check if timevalue is within our range
     if(m_TimeToIndexList.first().first > timeToFind)
@@ -479,53 +578,113 @@ int LogdataStorage::getNearestIndexForTimestamp(double timevalue) const
         return m_TimeToIndexList.size();    // timevalue too big deliver last index.
     }
 
-    while (intervalSize > 1)
+    return m_TimeToIndexList[findNearestTimeStamp(m_TimeToIndexList, timeToFind)].second;
+}
+
+int LogdataStorage::getNearestIndexForTimestamp(double timevalue, const QStringList &typeNames) const
+{
+    auto timeToFind = static_cast<quint64>(m_timeDivisor * (timevalue < 0.0 ? 0.0 : timevalue));
+    int bestIndex = -1;
+    quint64 bestDeviation = ULLONG_MAX;
+
+    for(const auto &typeName : typeNames)
     {
-        middle = intervalStart + intervalSize / 2;
-        index = qRound(middle);
-        quint64 tempTime = m_TimeToIndexList[index].first;
-        if (timeToFind > tempTime)
+        auto iter = m_typeTimeIndex.constFind(typeName);
+        if(iter == m_typeTimeIndex.constEnd())
         {
-            intervalStart = middle;
+            continue;   // no data for this type
         }
-        else if (timeToFind == tempTime)
+        int pos = findNearestTimeStamp(iter.value(), timeToFind);
+        if(pos < 0)
         {
-            break;
+            continue;
+        }
+        const TimeStampToIndexPair &candidate = iter.value().at(pos);
+        quint64 deviation = candidate.first > timeToFind ? candidate.first - timeToFind : timeToFind - candidate.first;
+        if((deviation < bestDeviation) || ((deviation == bestDeviation) && (candidate.second < bestIndex)))
+        {
+            bestDeviation = deviation;
+            bestIndex = candidate.second;
         }
-        intervalSize = intervalSize / 2;
     }
 
-    return m_TimeToIndexList[index].second;
+    return bestIndex;
+}
+
+QVector<int> LogdataStorage::getIndexesOfTypes(const QStringList &typeNames) const
+{
+    int count = 0;
+    for(const auto &typeName : typeNames)
+    {
+        count += m_dataStorage.value(typeName).size();
+    }
+
+    QVector<int> indexes;
+    indexes.reserve(count);
+    for(const auto &typeName : typeNames)
+    {
+        auto iter = m_dataStorage.constFind(typeName);
+        if(iter == m_dataStorage.constEnd())
+        {
+            continue;
+        }
+        auto middle = indexes.size();
+        // rows of one type are stored in index order - so every type is already sorted
+        for(const auto &row : iter.value())
+        {
+            indexes.push_back(row.m_index);
+        }
+        std::inplace_merge(indexes.begin(), indexes.begin() + middle, indexes.end());
+    }
+
+    return indexes;
 }
 
 void LogdataStorage::getMessagesOfType(const QString &type, QMap<quint64, MessageBase::Ptr> &indexToMessageMap) const
 {
-    if(!m_dataStorage.contains(type))
+    getMessagesOfType(type, 0, m_indexToDataRow.size(), indexToMessageMap);
+}
+
+void LogdataStorage::getMessagesOfType(const QString &type, int fromIndex, int toIndex,
+                                       QMap<quint64, MessageBase::Ptr> &indexToMessageMap) const
+{
+    auto eventIter = m_eventIndex.constFind(type);
+    if(eventIter == m_eventIndex.constEnd() || eventIter->m_records.empty())
     {
         QLOG_DEBUG() << "Graph loaded with no table of type " << type;
         return;
     }
 
-    QList<NameValuePair> nameValueList;
-
-    for(const auto &row : m_dataStorage[type])
+    for(const auto &record : getEventsOfType(type, fromIndex, toIndex))
     {
-        nameValueList.clear();
-        nameValueList.append(NameValuePair("Index", row.m_index));  // Add Data index
-
-        for(int i = 0; i < row.m_values.size(); ++i)
-        {
-            NameValuePair tempPair(m_typeStorage[type].m_labels.at(i), row.m_values.at(i)); // add names and values
-            nameValueList.append(tempPair);
-        }
-        MessageBase::Ptr msgPtr = MessageFactory::CreateMessageOfType(type, nameValueList, m_timeStampName, m_timeDivisor);
+        MessageBase::Ptr msgPtr = createMessage(type, eventIter->m_fieldIndexes, record);
         if(msgPtr != nullptr)
         {
-            indexToMessageMap.insert(static_cast<quint64>(row.m_index), msgPtr);
+            indexToMessageMap.insert(static_cast<quint64>(record.m_index), msgPtr);
         }
     }
 }
 
+QVector<LogdataStorage::EventRecord> LogdataStorage::getEventsOfType(const QString &type, int fromIndex, int toIndex) const
+{
+    auto eventIter = m_eventIndex.constFind(type);
+    if(eventIter == m_eventIndex.constEnd() || fromIndex >= toIndex)
+    {
+        return {};
+    }
+
+    // records are sorted by index as they are added in index order
+    auto lessIndex = [](const EventRecord &record, int index) { return record.m_index < index; };
+    const QVector<EventRecord> &records = eventIter->m_records;
+    auto first = std::lower_bound(records.constBegin(), records.constEnd(), fromIndex, lessIndex);
+    auto last  = std::lower_bound(first, records.constEnd(), toIndex, lessIndex);
+
+    QVector<EventRecord> result;
+    result.reserve(static_cast<int>(last - first));
+    std::copy(first, last, std::back_inserter(result));
+    return result;
+}
+
 QString LogdataStorage::getError() const
 {
     return m_errorText;
@@ -604,6 +763,8 @@ QStringList LogdataStorage::setupUnitData(const QString &timeStampName, double d
                 QString error("No multiplier description for data type " + type.m_name + " found");
                 errors.append(error);
             }
+            // units and multipliers are complete - share the final layout
+            shareLayout(type);
         }
     }
 
@@ -617,6 +778,82 @@ bool LogdataStorage::ModelIsScaled() const
     return !m_typeIDToMultiplierFieldInfo.empty();
 }
 
+bool LogdataStorage::getGpsTimeOffset(double &offset) const
+{
+    static constexpr int s_maxRowsToCheck {64};
+    static constexpr double s_secondsPerWeek {604800.0};
+
+    const auto typeIter = m_typeStorage.constFind("GPS");
+    const auto dataIter = m_dataStorage.constFind("GPS");
+    if((typeIter == m_typeStorage.constEnd()) || (dataIter == m_dataStorage.constEnd()) || (m_timeDivisor <= 0.0))
+    {
+        return false;
+    }
+
+    // older logs have GPSTimeMS and Week instead of GMS and GWk
+    const dataType &type = typeIter.value();
+    int msIndex = type.m_labels.indexOf("GMS");
+    if(msIndex == -1)
+    {
+        msIndex = type.m_labels.indexOf("GPSTimeMS");
+    }
+    int weekIndex = type.m_labels.indexOf("GWk");
+    if(weekIndex == -1)
+    {
+        weekIndex = type.m_labels.indexOf("Week");
+    }
+    const int statusIndex = type.m_labels.indexOf("Status");
+    if((msIndex == -1) || (weekIndex == -1))
+    {
+        return false;
+    }
+
+    QVector<double> offsets;
+    offsets.reserve(s_maxRowsToCheck);
+    for(const auto &row : dataIter.value())
+    {
+        const double week = row.m_values.at(weekIndex).toDouble();
+        if((week <= 0.0) || ((statusIndex != -1) && (row.m_values.at(statusIndex).toInt() < 3)))
+        {
+            continue;   // no 3D fix - no valid GPS time
+        }
+        const double gpsTime = week * s_secondsPerWeek + row.m_values.at(msIndex).toDouble() / 1000.0;
+        const double logTime = row.m_values.at(type.m_timeStampIndex).toDouble() / m_timeDivisor;
+        offsets.push_back(gpsTime - logTime);
+        if(offsets.size() >= s_maxRowsToCheck)
+        {
+            break;
+        }
+    }
+    if(offsets.isEmpty())
+    {
+        return false;
+    }
+
+    std::nth_element(offsets.begin(), offsets.begin() + offsets.size() / 2, offsets.end());
+    offset = offsets.at(offsets.size() / 2);
+    return true;
+}
+
+bool LogdataStorage::getFirstEventTime(quint32 eventId, double &time) const
+{
+    const auto eventIter = m_eventIndex.constFind(EventMessage::TypeName);
+    if((eventIter == m_eventIndex.constEnd()) || (m_timeDivisor <= 0.0))
+    {
+        return false;
+    }
+    // The Id is the first value of an EV record
+    for(const auto &record : eventIter->m_records)
+    {
+        if(record.m_values[0] == eventId)
+        {
+            time = static_cast<double>(record.m_timeStamp) / m_timeDivisor;
+            return true;
+        }
+    }
+    return false;
+}
+
 QString LogdataStorage::getLabelName(int index, const dataType & type)
 {
     QString label = type.m_labels.at(index);
@@ -634,3 +871,106 @@ QString LogdataStorage::getLabelName(int index, const dataType & type)
     return label;
 }
 
+void LogdataStorage::shareLayout(dataType &type)
+{
+    LayoutCache &cache = layoutCache();
+    QMutexLocker locker(&cache.m_mutex);
+    for(auto iter = cache.m_layouts.constFind(type.m_name); (iter != cache.m_layouts.constEnd()) && (iter.key() == type.m_name); ++iter)
+    {
+        const dataType &layout = iter.value();
+        if((layout.m_ID == type.m_ID) && (layout.m_length == type.m_length) && (layout.m_format == type.m_format) &&
+           (layout.m_labels == type.m_labels) && (layout.m_units == type.m_units) &&
+           sameMultipliers(layout.m_multipliers, type.m_multipliers) && (layout.m_timeStampIndex == type.m_timeStampIndex) &&
+           (layout.m_maxIndex == type.m_maxIndex) && (layout.m_indexFieldIndex == type.m_indexFieldIndex))
+        {
+            type = layout;
+            return;
+        }
+    }
+
+    if(cache.m_layouts.size() >= LayoutCache::s_MaxLayouts)
+    {
+        cache.m_layouts.clear();    // the storages keep their copies
+    }
+    cache.m_layouts.insert(type.m_name, type);
+}
+
+int LogdataStorage::findNearestTimeStamp(const QVector<TimeStampToIndexPair> &timeIndex, quint64 timeToFind)
+{
+    if(timeIndex.empty())
+    {
+        return -1;
+    }
+
+    // first element which is not less than timeToFind
+    auto iter = std::lower_bound(timeIndex.constBegin(), timeIndex.constEnd(), TimeStampToIndexPair(timeToFind, 0),
+                                 TimeStampToIndexPairComparer());
+    if(iter == timeIndex.constEnd())
+    {
+        return timeIndex.size() - 1;
+    }
+    if(iter != timeIndex.constBegin())
+    {
+        // the previous element may be closer
+        auto prev = iter - 1;
+        if((timeToFind - prev->first) < (iter->first - timeToFind))
+        {
+            iter = prev;
+        }
+    }
+    return static_cast<int>(iter - timeIndex.constBegin());
+}
+
+QStringList LogdataStorage::getEventFieldNames(const QString &typeName)
+{
+    if(typeName == ModeMessage::TypeName)
+    {
+        return {"Mode", "ModeNum", "Rsn"};
+    }
+    if(typeName == ErrorMessage::TypeName)
+    {
+        return {"Subsys", "ECode"};
+    }
+    if(typeName == EventMessage::TypeName)
+    {
+        return {"Id"};
+    }
+    if(typeName == MsgMessage::TypeName)
+    {
+        return {"Message"};
+    }
+    return {};
+}
+
+MessageBase::Ptr LogdataStorage::createMessage(const QString &typeName, const QVector<int> &fieldIndexes, const EventRecord &record) const
+{
+    auto index = static_cast<quint32>(record.m_index);
+    double timeStamp = static_cast<double>(record.m_timeStamp) / m_timeDivisor;
+
+    if(typeName == ModeMessage::TypeName)
+    {
+        return MessageBase::Ptr(new ModeMessage(index, timeStamp, record.m_values[0], record.m_values[1], record.m_values[2]));
+    }
+    if(typeName == ErrorMessage::TypeName)
+    {
+        return MessageBase::Ptr(new ErrorMessage(index, timeStamp, record.m_values[0], record.m_values[1]));
+    }
+    if(typeName == EventMessage::TypeName)
+    {
+        return MessageBase::Ptr(new EventMessage(index, timeStamp, record.m_values[0]));
+    }
+    if(typeName == MsgMessage::TypeName)
+    {
+        // The text is not part of the record - fetch it from the row
+        QString message;
+        if(!fieldIndexes.empty() && fieldIndexes.at(0) >= 0)
+        {
+            const TypeIndexPair &typeIndex = m_indexToDataRow.at(record.m_index);
+            message = m_dataStorage[typeName].at(typeIndex.second).m_values.at(fieldIndexes.at(0)).toString();
+        }
+        return MessageBase::Ptr(new MsgMessage(index, timeStamp, message));
+    }
+
+    QLOG_WARN() << "LogdataStorage::createMessage: No message of type '" << typeName << "' could be created";
+    return MessageBase::Ptr();
+}
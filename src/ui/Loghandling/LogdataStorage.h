@@ -79,6 +79,21 @@ public:
         {}
     };
 
+    /**
+     * @brief The EventRecord struct is a compact entry of the event index. The event index
+     *        holds one record for every MODE, ERR, EV and MSG row. It is created while
+     *        the rows are added, so the event messages can be created without scanning
+     *        or converting the stored rows.
+     */
+    struct EventRecord
+    {
+        int     m_index{};          /// Global index of the row
+        quint64 m_timeStamp{};      /// Time stamp (not scaled)
+        quint32 m_values[3]{};      /// MODE: Mode, ModeNum, Rsn - ERR: Subsys, ECode - EV: Id - MSG: unused
+    };
+
+    class Series;
+
     /**
      * @brief LogdataStorage - CTOR
      */
@@ -214,6 +229,17 @@ public:
      */
     virtual bool getValues(const QString &name, bool useTimeAsIndex, QVector<double> &xValues, QVector<double> &yValues) const;
 
+    /**
+     * @brief getSeries - delivers a view on the X and Y values of one type for plotting. In contrast
+     *        to getValues() no values are copied. The values are converted and scaled when they are
+     *        read from the series.
+     * @param name - The name of the type containig the measurement like "IMU.GyrX", "IMU.GyrX [rad/s]" or "IMU.I:0.GyrX [rad/s]" for indexed types
+     * @param useTimeAsIndex - true - use time in index
+     * @param series - reference of the series to be set up
+     * @return true - data found, false otherwise
+     */
+    virtual bool getSeries(const QString &name, bool useTimeAsIndex, Series &series) const;
+
     /**
      * @brief getRawDataRow - gets a whole data row like it was written into the model. Even if the Model
      *        supports scaling the data is NOT scaled. Used for Ascii Log exporting.
@@ -269,6 +295,27 @@ public:
      */
     virtual int getNearestIndexForTimestamp(double timevalue) const;
 
+    /**
+     * @brief getNearestIndexForTimestamp delivers the row index of the row of one of the
+     *        types in typeNames which has the smallest deviation in its timeStamp to the
+     *        delivered timeValue. Uses the per type time index, so the cost does not depend
+     *        on the number of rows of other types.
+     *
+     * @param timevalue - The timeStamp to search for
+     * @param typeNames - Names of the types to search in
+     * @return The index with the best timestamp match. -1 if none of the types has data.
+     */
+    virtual int getNearestIndexForTimestamp(double timevalue, const QStringList &typeNames) const;
+
+    /**
+     * @brief getIndexesOfTypes delivers the row indexes of all rows of the types in typeNames.
+     *        Can be used to create a filtered view of the model.
+     *
+     * @param typeNames - Names of the types to fetch the indexes for
+     * @return Vector holding the row indexes sorted ascending
+     */
+    virtual QVector<int> getIndexesOfTypes(const QStringList &typeNames) const;
+
     /**
      * @brief getMessagesOfType fetches the special messages (ModeMessage, ErrorMessage,
      *        EventMessage, MsgMessage) from the datamodel. These messages need special handling
@@ -279,6 +326,30 @@ public:
      */
     virtual void getMessagesOfType(const QString &type, QMap<quint64, MessageBase::Ptr> &indexToMessageMap) const;
 
+    /**
+     * @brief getMessagesOfType fetches the special messages (ModeMessage, ErrorMessage,
+     *        EventMessage, MsgMessage) with fromIndex <= index < toIndex from the datamodel.
+     *
+     * @param type - Type the message to be fetched. like ModeMessage::TypeName or ErrorMessage::TypeName
+     * @param fromIndex - first row index of the range
+     * @param toIndex - row index behind the range
+     * @param indexToMessageMap - A map to store the results. The Map maintains the order.
+     */
+    virtual void getMessagesOfType(const QString &type, int fromIndex, int toIndex,
+                                   QMap<quint64, MessageBase::Ptr> &indexToMessageMap) const;
+
+    /**
+     * @brief getEventsOfType delivers the records of the event index of one type with
+     *        fromIndex <= index < toIndex. Cheaper than getMessagesOfType() if only
+     *        index, time or the values are needed.
+     *
+     * @param type - Type of the records like ModeMessage::TypeName or ErrorMessage::TypeName
+     * @param fromIndex - first row index of the range
+     * @param toIndex - row index behind the range
+     * @return Vector holding the records sorted by index
+     */
+    virtual QVector<EventRecord> getEventsOfType(const QString &type, int fromIndex, int toIndex) const;
+
     /**
      * @brief getError delivers the last error detected by the datamodel. This method should be called
      *        if the addDataRow(...) returns false. In that case the reason could be read here.
@@ -305,6 +376,23 @@ public:
      */
     virtual bool ModelIsScaled() const;
 
+    /**
+     * @brief getGpsTimeOffset delivers the offset between the time stamps of the log and the
+     *        GPS time. Uses the median of the first GPS rows with a 3D fix, so a single late
+     *        GPS row does not shift the result.
+     * @param offset - GPS time (seconds since GPS epoch) minus log time (seconds)
+     * @return true - offset is valid, false if the log has no GPS time
+     */
+    virtual bool getGpsTimeOffset(double &offset) const;
+
+    /**
+     * @brief getFirstEventTime delivers the time of the first event (EV) with a given id
+     * @param eventId - id of the event like 10 for ARMED
+     * @param time - time stamp of the event scaled to seconds
+     * @return true - event found, false otherwise
+     */
+    virtual bool getFirstEventTime(quint32 eventId, double &time) const;
+
 private:
 
     constexpr static int s_ColumnOffset  = 2;           /// Offset for columns cause model adds index and name column
@@ -327,6 +415,15 @@ private:
 
     using ValueTable = QVector<IndexValueRow>;          /// Type holding all data rows of a specific type
 
+    /**
+     * @brief The EventIndex struct holds the event index of one event type
+     */
+    struct EventIndex
+    {
+        QVector<int> m_fieldIndexes;        /// Column of the fields stored in EventRecord::m_values (-1 if missing)
+        QVector<EventRecord> m_records;     /// The records - sorted by index
+    };
+
     int m_columnCount{};           /// Holds the maximum column count of all rows
     int m_currentRow{};            /// The current selected row in table
 
@@ -336,11 +433,13 @@ private:
     quint64 m_maxTimeStamp{};          /// the max time stamp in data
 
     QVector<TimeStampToIndexPair> m_TimeToIndexList;    /// List holding pairs of time stamp and table row index
+    QHash<QString, QVector<TimeStampToIndexPair> > m_typeTimeIndex; /// Time index per type - created in setTimeStamp()
 
     QHash<QString, dataType> m_typeStorage;     /// Holds all known types
     QVector<QString>         m_indexToTypeRow;  /// Holds the Type name in the order they were added
 
     QHash<QString, ValueTable> m_dataStorage;    /// Holds the complete data
+    QHash<QString, EventIndex> m_eventIndex;     /// Holds the event index of MODE, ERR, EV and MSG rows
     QVector<TypeIndexPair>     m_indexToDataRow; /// The global index pointing to the row
 
     QString m_errorText;                         /// Used to store current error
@@ -359,6 +458,101 @@ private:
      * @return - String containing a least the label plus unit name if available.
      */
     static QString getLabelName(int index, const dataType &type);
+
+    /**
+     * @brief shareLayout looks up the layout of a type in the layout cache shared by all
+     *        storages. If an identical layout is found the type is replaced by it, so the
+     *        strings describing the type are shared (implicit sharing) between all logs
+     *        using the same firmware. Otherwise the layout is added to the cache.
+     * @param type - the type to share
+     */
+    static void shareLayout(dataType &type);
+
+    /**
+     * @brief findNearestTimeStamp - binary search for the time stamp in a time index
+     * @param timeIndex - the time index to search in. Must be sorted by time.
+     * @param timeToFind - the unscaled time stamp to search for
+     * @return - position in timeIndex with the smallest deviation. -1 if timeIndex is empty.
+     */
+    static int findNearestTimeStamp(const QVector<TimeStampToIndexPair> &timeIndex, quint64 timeToFind);
+
+    /**
+     * @brief getEventFieldNames - delivers the names of the fields stored in the event index
+     *        for an event type.
+     * @param typeName - name of the type
+     * @return - field names in order of EventRecord::m_values. Empty if the type is no event type.
+     */
+    static QStringList getEventFieldNames(const QString &typeName);
+
+    /**
+     * @brief createMessage - creates a message from an event index record
+     * @param typeName - type of the record
+     * @param fieldIndexes - field indexes of the event index
+     * @param record - the record
+     * @return - the message or a null pointer if the type is no event type
+     */
+    MessageBase::Ptr createMessage(const QString &typeName, const QVector<int> &fieldIndexes, const EventRecord &record) const;
+};
+
+/**
+ * @brief The LogdataStorage::Series class is a read only view on the values of one measurement.
+ *        It shares the rows of the type with the storage (implicit sharing) and converts and
+ *        scales a value only when it is read, so setting up a series does not depend on the
+ *        number of rows. Only for indexed types the positions of the rows of the requested
+ *        instance are stored.
+ */
+class LogdataStorage::Series
+{
+public:
+    /**
+     * @brief size - number of values in this series
+     */
+    int size() const
+    {
+        return m_usePositions ? m_positions.size() : m_rows.size();
+    }
+
+    /**
+     * @brief key - delivers the X value (time in seconds or row index)
+     * @param index - index of the value. Must be 0 <= index < size()
+     */
+    double key(int index) const
+    {
+        const IndexValueRow &row = m_rows.at(m_usePositions ? m_positions.at(index) : index);
+        return m_keyColumn < 0 ? row.m_index : row.m_values.at(m_keyColumn).toDouble() / m_timeDivisor + m_keyOffset;
+    }
+
+    /**
+     * @brief value - delivers the Y value scaled to its unit
+     * @param index - index of the value. Must be 0 <= index < size()
+     */
+    double value(int index) const
+    {
+        const IndexValueRow &row = m_rows.at(m_usePositions ? m_positions.at(index) : index);
+        return row.m_values.at(m_valueColumn).toDouble() * m_multiplier;
+    }
+
+    /**
+     * @brief setKeyOffset - sets an offset which is added to the time keys. Used to align
+     *        the series of several logs on one time axis. Has no effect on index keys.
+     * @param offset - the offset in seconds
+     */
+    void setKeyOffset(double offset)
+    {
+        m_keyOffset = offset;
+    }
+
+private:
+    friend class LogdataStorage;
+
+    ValueTable m_rows;              /// The rows of the type - shared with the storage
+    QVector<int> m_positions;       /// Positions in m_rows of the rows of the requested instance (indexed types only)
+    bool m_usePositions{false};     /// True if m_positions is used
+    int m_keyColumn{-1};            /// Column of the time stamp. -1 means the row index is the key
+    int m_valueColumn{};            /// Column of the value
+    double m_multiplier{1.0};       /// Multiplier scaling the value to its unit
+    double m_timeDivisor{1.0};      /// Divisor scaling the time stamp to seconds
+    double m_keyOffset{0.0};        /// Offset added to the time keys in seconds
 };
 
 #endif // LOGDATASTORAGE_H
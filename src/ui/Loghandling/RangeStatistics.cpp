@@ -0,0 +1,370 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file RangeStatistics.cpp
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the range statistics of a data series
+ */
+
+#include "RangeStatistics.h"
+
+#include <QtAlgorithms>
+#include <QtNumeric>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    /**
+     * @brief floorLog2 - integer logarithm. value must be > 0.
+     */
+    int floorLog2(int value)
+    {
+        int result = 0;
+        while (value > 1)
+        {
+            value >>= 1;
+            ++result;
+        }
+        return result;
+    }
+}
+
+//****************************************************
+
+RangeStatistics::Values::Values() :
+    m_min(qQNaN()), m_max(qQNaN()), m_average(qQNaN()), m_stdDev(qQNaN()),
+    m_rms(qQNaN()), m_p5(qQNaN()), m_median(qQNaN()), m_p95(qQNaN())
+{}
+
+int RangeStatistics::BitLevel::rankOne(int pos) const
+{
+    int word = pos >> 6;
+    int bit  = pos & 63;
+    int ones = m_ones.at(word);
+    if (bit != 0)
+    {
+        ones += static_cast<int>(qPopulationCount(m_bits.at(word) & ((Q_UINT64_C(1) << bit) - 1)));
+    }
+    return ones;
+}
+
+//****************************************************
+
+RangeStatistics::RangeStatistics(const QVector<double> &keys, const QVector<double> &values) :
+    m_keys(keys),
+    m_values(values),
+    m_shift(0.0)
+{
+    // keys and values must match - just cut the longer one
+    int size = qMin(m_keys.size(), m_values.size());
+    m_keys.resize(size);
+    m_values.resize(size);
+
+    buildPrefixSums();
+    buildMinMaxTables();
+    buildWaveletMatrix();
+}
+
+RangeStatistics::Values RangeStatistics::calculate(double fromKey, double toKey) const
+{
+    Values result;
+    int first = 0;
+    int last  = 0;
+    findRange(fromKey, toKey, first, last);
+
+    int count = m_finiteCount.at(last) - m_finiteCount.at(first);
+    if (count == 0)
+    {
+        return result;
+    }
+
+    double sum       = m_sum.at(last) - m_sum.at(first);
+    double squareSum = m_squareSum.at(last) - m_squareSum.at(first);
+    double shiftedMean = sum / count;
+    double variance    = qMax(0.0, squareSum / count - shiftedMean * shiftedMean);
+
+    result.m_measurements = count;
+    result.m_average = m_shift + shiftedMean;
+    result.m_stdDev  = std::sqrt(variance);
+    result.m_rms     = std::sqrt(variance + result.m_average * result.m_average);
+    minMax(first, last, result.m_min, result.m_max);
+    result.m_p5     = percentile(first, last, count, 5.0);
+    result.m_median = percentile(first, last, count, 50.0);
+    result.m_p95    = percentile(first, last, count, 95.0);
+
+    return result;
+}
+
+double RangeStatistics::percentile(double fromKey, double toKey, double percent) const
+{
+    int first = 0;
+    int last  = 0;
+    findRange(fromKey, toKey, first, last);
+    return percentile(first, last, m_finiteCount.at(last) - m_finiteCount.at(first), percent);
+}
+
+void RangeStatistics::buildPrefixSums()
+{
+    int size = m_values.size();
+    m_sum.resize(size + 1);
+    m_squareSum.resize(size + 1);
+    m_finiteCount.resize(size + 1);
+
+    // Shifting by the mean keeps the squares small (e.g. altitudes far away from 0)
+    double sum = 0.0;
+    int count = 0;
+    for (double value : m_values)
+    {
+        if (std::isfinite(value))
+        {
+            sum += value;
+            ++count;
+        }
+    }
+    m_shift = count > 0 ? sum / count : 0.0;
+
+    m_sum[0] = 0.0;
+    m_squareSum[0] = 0.0;
+    m_finiteCount[0] = 0;
+    for (int i = 0; i < size; ++i)
+    {
+        double value = m_values.at(i);
+        bool finite = std::isfinite(value);
+        double shifted = finite ? value - m_shift : 0.0;
+        m_sum[i + 1]         = m_sum.at(i) + shifted;
+        m_squareSum[i + 1]   = m_squareSum.at(i) + shifted * shifted;
+        m_finiteCount[i + 1] = m_finiteCount.at(i) + (finite ? 1 : 0);
+    }
+}
+
+void RangeStatistics::buildMinMaxTables()
+{
+    int blockCount = (m_values.size() + s_BlockSize - 1) / s_BlockSize;
+    if (blockCount == 0)
+    {
+        return;
+    }
+
+    // level 0 holds min / max of each block
+    QVector<double> blockMin(blockCount, std::numeric_limits<double>::infinity());
+    QVector<double> blockMax(blockCount, -std::numeric_limits<double>::infinity());
+    for (int i = 0; i < m_values.size(); ++i)
+    {
+        double value = m_values.at(i);
+        if (std::isfinite(value))
+        {
+            int block = i >> s_BlockBits;
+            blockMin[block] = qMin(blockMin.at(block), value);
+            blockMax[block] = qMax(blockMax.at(block), value);
+        }
+    }
+    m_blockMin.append(blockMin);
+    m_blockMax.append(blockMax);
+
+    // level j holds min / max of 2^j blocks
+    for (int level = 1; (1 << level) <= blockCount; ++level)
+    {
+        const QVector<double> &prevMin = m_blockMin.at(level - 1);
+        const QVector<double> &prevMax = m_blockMax.at(level - 1);
+        int half = 1 << (level - 1);
+        int levelSize = blockCount - (1 << level) + 1;
+        QVector<double> levelMin(levelSize);
+        QVector<double> levelMax(levelSize);
+        for (int i = 0; i < levelSize; ++i)
+        {
+            levelMin[i] = qMin(prevMin.at(i), prevMin.at(i + half));
+            levelMax[i] = qMax(prevMax.at(i), prevMax.at(i + half));
+        }
+        m_blockMin.append(levelMin);
+        m_blockMax.append(levelMax);
+    }
+}
+
+void RangeStatistics::buildWaveletMatrix()
+{
+    int size = m_values.size();
+    if (size == 0)
+    {
+        return;
+    }
+
+    // Rank all values. Not finite values get the highest ranks, so they are never
+    // selected as long as k is smaller than the count of finite values.
+    QVector<int> order(size);
+    for (int i = 0; i < size; ++i)
+    {
+        order[i] = i;
+    }
+    const QVector<double> &values = m_values;
+    std::stable_sort(order.begin(), order.end(), [&values](int a, int b)
+    {
+        bool finiteA = std::isfinite(values.at(a));
+        bool finiteB = std::isfinite(values.at(b));
+        if (finiteA != finiteB)
+        {
+            return finiteA;
+        }
+        return finiteA && (values.at(a) < values.at(b));
+    });
+
+    QVector<quint32> ranks(size);
+    m_sortedValues.resize(size);
+    for (int pos = 0; pos < size; ++pos)
+    {
+        ranks[order.at(pos)] = static_cast<quint32>(pos);
+        m_sortedValues[pos] = m_values.at(order.at(pos));
+    }
+    order.clear();
+
+    int bitCount = qMax(1, floorLog2(size - 1) + 1);
+    int wordCount = (size >> 6) + 1;    // one additional word so rankOne(size) is valid
+    QVector<quint32> nextRanks(size);
+
+    for (int bit = bitCount - 1; bit >= 0; --bit)
+    {
+        BitLevel level;
+        level.m_bits.fill(0, wordCount);
+        level.m_ones.resize(wordCount);
+        for (int i = 0; i < size; ++i)
+        {
+            if ((ranks.at(i) >> bit) & 1u)
+            {
+                level.m_bits[i >> 6] |= (Q_UINT64_C(1) << (i & 63));
+            }
+        }
+        int ones = 0;
+        for (int word = 0; word < wordCount; ++word)
+        {
+            level.m_ones[word] = ones;
+            ones += static_cast<int>(qPopulationCount(level.m_bits.at(word)));
+        }
+        level.m_zeros = size - ones;
+
+        // stable partition - zeros first then ones
+        int zeroPos = 0;
+        int onePos  = level.m_zeros;
+        for (int i = 0; i < size; ++i)
+        {
+            if ((ranks.at(i) >> bit) & 1u)
+            {
+                nextRanks[onePos++] = ranks.at(i);
+            }
+            else
+            {
+                nextRanks[zeroPos++] = ranks.at(i);
+            }
+        }
+        ranks.swap(nextRanks);
+        m_levels.append(level);
+    }
+}
+
+void RangeStatistics::findRange(double fromKey, double toKey, int &first, int &last) const
+{
+    first = static_cast<int>(std::lower_bound(m_keys.constBegin(), m_keys.constEnd(), fromKey) - m_keys.constBegin());
+    last  = static_cast<int>(std::lower_bound(m_keys.constBegin(), m_keys.constEnd(), toKey) - m_keys.constBegin());
+    last  = qMax(first, last);
+}
+
+void RangeStatistics::minMax(int first, int last, double &min, double &max) const
+{
+    min = std::numeric_limits<double>::infinity();
+    max = -std::numeric_limits<double>::infinity();
+
+    // whole blocks inside the range
+    int firstBlock = (first + s_BlockSize - 1) >> s_BlockBits;
+    int lastBlock  = last >> s_BlockBits;   // exclusive
+
+    auto scan = [this, &min, &max](int from, int to)
+    {
+        for (int i = from; i < to; ++i)
+        {
+            double value = m_values.at(i);
+            if (std::isfinite(value))
+            {
+                min = qMin(min, value);
+                max = qMax(max, value);
+            }
+        }
+    };
+
+    if (firstBlock >= lastBlock)
+    {
+        scan(first, last);  // range is smaller than 2 blocks
+    }
+    else
+    {
+        scan(first, firstBlock << s_BlockBits);
+        scan(lastBlock << s_BlockBits, last);
+
+        int level = floorLog2(lastBlock - firstBlock);
+        int otherBlock = lastBlock - (1 << level);
+        min = qMin(min, qMin(m_blockMin.at(level).at(firstBlock), m_blockMin.at(level).at(otherBlock)));
+        max = qMax(max, qMax(m_blockMax.at(level).at(firstBlock), m_blockMax.at(level).at(otherBlock)));
+    }
+}
+
+double RangeStatistics::kthSmallest(int first, int last, int k) const
+{
+    quint32 rank = 0;
+    int bit = m_levels.size() - 1;
+    for (const auto &level : m_levels)
+    {
+        int zerosBefore = level.rankZero(first);
+        int zerosInRange = level.rankZero(last) - zerosBefore;
+        if (k < zerosInRange)
+        {
+            first = zerosBefore;
+            last  = zerosBefore + zerosInRange;
+        }
+        else
+        {
+            k -= zerosInRange;
+            first = level.m_zeros + (first - zerosBefore);
+            last  = level.m_zeros + (last - zerosBefore - zerosInRange);
+            rank |= (1u << bit);
+        }
+        --bit;
+    }
+    return m_sortedValues.at(static_cast<int>(rank));
+}
+
+double RangeStatistics::percentile(int first, int last, int count, double percent) const
+{
+    if (count <= 0)
+    {
+        return qQNaN();
+    }
+
+    double position = qBound(0.0, percent / 100.0, 1.0) * (count - 1);
+    int lower = static_cast<int>(std::floor(position));
+    double fraction = position - lower;
+
+    double value = kthSmallest(first, last, lower);
+    if ((fraction > 0.0) && (lower + 1 < count))
+    {
+        value += fraction * (kthSmallest(first, last, lower + 1) - value);
+    }
+    return value;
+}
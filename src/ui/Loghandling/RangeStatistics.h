@@ -0,0 +1,157 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file RangeStatistics.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the range statistics of a data series
+ */
+
+#ifndef RANGESTATISTICS_H
+#define RANGESTATISTICS_H
+
+#include <QSharedPointer>
+#include <QVector>
+
+/**
+ * @brief The RangeStatistics class calculates statistic values of a data series
+ *        for an arbitrary key range. All helper structures are created once in the
+ *        CTOR, so a query does not depend on the size of the range:
+ *        @li prefix sums for count, mean, standard deviation and RMS - O(log n) for
+ *            finding the range, O(1) for the values.
+ *        @li a sparse table over blocks of values for min and max - O(1)
+ *        @li a wavelet matrix over the value ranks for percentiles - O(log n)
+ *
+ *        Values which are not finite (NaN, inf) are ignored.
+ */
+class RangeStatistics
+{
+public:
+
+    /**
+     * @brief Ptr - shared pointer type for this class
+     */
+    using Ptr = QSharedPointer<RangeStatistics>;
+
+    /**
+     * @brief The Values struct holds the statistic values of a range. If there are no
+     *        measurements in range all values are NaN.
+     */
+    struct Values
+    {
+        int    m_measurements{0};   ///< Number of measurements in range
+        double m_min;               ///< Min value in range
+        double m_max;               ///< Max value in range
+        double m_average;           ///< Average value in range
+        double m_stdDev;            ///< Standard deviation in range
+        double m_rms;               ///< Root mean square in range
+        double m_p5;                ///< 5th percentile in range
+        double m_median;            ///< Median in range
+        double m_p95;               ///< 95th percentile in range
+
+        Values();
+    };
+
+    /**
+     * @brief RangeStatistics - CTOR creates all helper structures.
+     * @param keys - the keys (x values) of the series. MUST be sorted ascending.
+     * @param values - the values (y values) of the series. Same size as keys.
+     */
+    RangeStatistics(const QVector<double> &keys, const QVector<double> &values);
+
+    /**
+     * @brief calculate delivers the statistic values of all measurements with
+     *        fromKey <= key < toKey
+     * @param fromKey - start of the range
+     * @param toKey - end of the range
+     * @return - the statistic values
+     */
+    Values calculate(double fromKey, double toKey) const;
+
+    /**
+     * @brief percentile delivers a percentile of all measurements with
+     *        fromKey <= key < toKey. Linear interpolation between the ranks is used.
+     * @param fromKey - start of the range
+     * @param toKey - end of the range
+     * @param percent - the percentile 0.0 - 100.0
+     * @return - the percentile or NaN if there are no measurements in range
+     */
+    double percentile(double fromKey, double toKey, double percent) const;
+
+private:
+
+    static constexpr int s_BlockBits = 6;                   ///< log2 of the block size
+    static constexpr int s_BlockSize = 1 << s_BlockBits;    ///< Values per block of the min / max table
+
+    /**
+     * @brief The BitLevel struct is one level of the wavelet matrix. It holds one bit
+     *        of every value rank and a rank directory for counting bits fast.
+     */
+    struct BitLevel
+    {
+        QVector<quint64> m_bits;    ///< the bits, 64 per word
+        QVector<int> m_ones;        ///< number of set bits before each word
+        int m_zeros{0};             ///< number of zero bits in this level
+
+        int rankOne(int pos) const; ///< number of ones in [0, pos)
+        int rankZero(int pos) const { return pos - rankOne(pos); } ///< number of zeros in [0, pos)
+    };
+
+    QVector<double> m_keys;         ///< keys of the series
+    QVector<double> m_values;       ///< values of the series
+
+    double m_shift;                 ///< mean of the series - values are shifted by this before summing to reduce cancellation
+    QVector<double> m_sum;          ///< prefix sums of the shifted values
+    QVector<double> m_squareSum;    ///< prefix sums of the squared shifted values
+    QVector<int> m_finiteCount;     ///< prefix count of the finite values
+
+    QVector<QVector<double> > m_blockMin;   ///< sparse table of the block minimums
+    QVector<QVector<double> > m_blockMax;   ///< sparse table of the block maximums
+
+    QVector<double> m_sortedValues; ///< all values sorted. The rank of a value is its position in here.
+    QVector<BitLevel> m_levels;     ///< wavelet matrix of the value ranks - most significant bit first
+
+    void buildPrefixSums();
+    void buildMinMaxTables();
+    void buildWaveletMatrix();
+
+    /**
+     * @brief findRange delivers the index range [first, last) of keys within [fromKey, toKey)
+     */
+    void findRange(double fromKey, double toKey, int &first, int &last) const;
+
+    /**
+     * @brief minMax calculates the min and max value in index range [first, last)
+     */
+    void minMax(int first, int last, double &min, double &max) const;
+
+    /**
+     * @brief kthSmallest delivers the k-th (0 based) smallest value in index range [first, last)
+     */
+    double kthSmallest(int first, int last, int k) const;
+
+    /**
+     * @brief percentile of index range [first, last) holding count finite values
+     */
+    double percentile(int first, int last, int count, double percent) const;
+};
+
+#endif // RANGESTATISTICS_H
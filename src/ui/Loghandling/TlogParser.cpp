@@ -31,6 +31,8 @@ This file is part of the APM_PLANNER project
 #include "TlogParser.h"
 #include "logging.h"
 
+#include <cstring>
+
 
 bool TlogParser::tlogDescriptor::isValid() const
 {
@@ -43,21 +45,25 @@ bool TlogParser::tlogDescriptor::isValid() const
 TlogParser::TlogParser(LogdataStorage::Ptr storagePtr, IParserCallback *object) :
     QObject(),
     LogParserBase (storagePtr, object),
-    m_mavDecoderPtr(new MAVLinkDecoder()),
-    m_lastModeVal(255),
-    mp_ReceiveData(nullptr)
+    m_lastModeVal(255)
 {
     QLOG_DEBUG() << "TlogParser::TlogParser - CTOR";
-    // connect to the callbacks of the mavlink deoder - all data is delivered through them
-    connect(m_mavDecoderPtr.data(), &MAVLinkDecoder::valueChanged, this, &TlogParser::newValue);
-    connect(m_mavDecoderPtr.data(), &MAVLinkDecoder::textMessageReceived, this, &TlogParser::newTextValue);
+    memset(&m_rxBuffer, 0, sizeof(m_rxBuffer));
+    memset(&m_rxStatus, 0, sizeof(m_rxStatus));
+    // copy message description into hashmap for fast access
+    QVector<mavlink_message_info_t> mavlinkMsg = MAVLINK_MESSAGE_INFO;
+    for(const auto &typeInfo : mavlinkMsg)
+    {
+        if(!m_idToMessageInfo.contains(typeInfo.msgid))
+        {
+            m_idToMessageInfo.insert(typeInfo.msgid, typeInfo);
+        }
+    }
 }
 
 TlogParser::~TlogParser()
 {
     QLOG_DEBUG() << "TlogParser::TlogParser - DTOR";
-    disconnect(m_mavDecoderPtr.data(), &MAVLinkDecoder::valueChanged, this, &TlogParser::newValue);
-    disconnect(m_mavDecoderPtr.data(), &MAVLinkDecoder::textMessageReceived, this, &TlogParser::newTextValue);
 }
 
 AP2DataPlotStatus TlogParser::parse(QFile &logfile)
@@ -90,7 +96,7 @@ AP2DataPlotStatus TlogParser::parse(QFile &logfile)
 
         for (int i = 0; i < m_dataBlock.size(); ++i)
         {
-            unsigned int decodeState = mavlink_parse_char(14, static_cast<uint8_t>(m_dataBlock[i]), &mavlinkMessage, &mavlinkStatus);
+            unsigned int decodeState = parseChar(static_cast<quint8>(m_dataBlock[i]), mavlinkMessage, mavlinkStatus);
             if (decodeState == MAVLINK_FRAMING_OK)
             {
                 if ((mavlinkMessage.sysid > 250) || ((mavlinkMessage.msgid <= 23) && (mavlinkMessage.msgid >= 20)))
@@ -101,66 +107,85 @@ AP2DataPlotStatus TlogParser::parse(QFile &logfile)
                     continue;
                 }
 
-                tlogDescriptor descriptor;
-                descriptor.m_name = m_mavDecoderPtr->getMessageName(mavlinkMessage.msgid);
-                if (descriptor.m_name != "EMPTY")
+#ifndef ENABLE_DEBUG_DATALOG_PARSING
+                if (mavlinkMessage.msgid == MAVLINK_MSG_ID_LOG_DATA)
+                {
+                    continue;   // log download data is useless for plotting
+                }
+#endif
+                const auto infoIter = m_idToMessageInfo.constFind(mavlinkMessage.msgid);
+                if ((infoIter == m_idToMessageInfo.constEnd()) || (qstrcmp(infoIter->name, "EMPTY") == 0))
+                {
+                    emptyMessages++;
+                    continue;
+                }
+
+                auto descIter = m_idToDescriptorMap.constFind(mavlinkMessage.msgid);
+                if (descIter == m_idToDescriptorMap.constEnd())
                 {
+                    // First message of this type - create descriptor. Invalid descriptors are stored
+                    // too, so they are not parsed again for every message.
+                    tlogDescriptor descriptor;
+                    descriptor.m_name = infoIter->name;
                     descriptor.m_ID = mavlinkMessage.msgid;
-                    if(!m_nameToDescriptorMap.contains(descriptor.m_name))
+                    if(parseDescriptor(descriptor, *infoIter))
                     {
-                        if(parseDescriptor(descriptor))
+                        descriptor.finalize(m_activeTimestamp);
+                        if(!storeDescriptor(descriptor))
                         {
-                            descriptor.finalize(m_activeTimestamp);
-                            if(!storeDescriptor(descriptor))
-                            {
-                                return m_logLoadingState;
-                            }
+                            return m_logLoadingState;
                         }
                     }
+                    else
+                    {
+                        descriptor.m_ID = tlogDescriptor::s_InvalidID;
+                    }
+                    descIter = m_idToDescriptorMap.insert(mavlinkMessage.msgid, descriptor);
+                }
+
+                if (!descIter->isValid())
+                {
+                    continue;
+                }
+
+                // Read packet data - if there is something
+                QList<NameValuePair> NameValuePairList;
+                if(decodeData(mavlinkMessage, *infoIter, *descIter, NameValuePairList))
+                {
+                    if(!storeNameValuePairList(NameValuePairList, *descIter))
+                    {
+                        // Data could not be stored cause of defects. Continue with next data package.
+                        continue;
+                    }
 
-                    // Read packet data - if there is something
-                    QList<NameValuePair> NameValuePairList;
-                    if(decodeData(mavlinkMessage, NameValuePairList))
+                    // Special message handling - Heartbeat
+                    if(mavlinkMessage.msgid == MAVLINK_MSG_ID_HEARTBEAT)
                     {
-                        if(!storeNameValuePairList(NameValuePairList, m_nameToDescriptorMap.value(descriptor.m_name)))
+                        if (currentSysID != mavlinkMessage.sysid)
                         {
-                            // Data could not be stored cause of defects. Continue with next data package.
-                            continue;
+                            QLOG_DEBUG() << "MavLink SysID Changed: " << mavlinkMessage.sysid;
+                            currentSysID = mavlinkMessage.sysid;
                         }
-
-                        // Special message handling - Heartbeat
-                        if(mavlinkMessage.msgid == MAVLINK_MSG_ID_HEARTBEAT)
+                        // extract mode message from tlog data
+                        if(!extractModeMessage(NameValuePairList))
                         {
-                            if (currentSysID != mavlinkMessage.sysid)
-                            {
-                                QLOG_DEBUG() << "MavLink SysID Changed: " << mavlinkMessage.sysid;
-                                currentSysID = mavlinkMessage.sysid;
-                            }
-                            // extract mode message from tlog data
-                            if(!extractModeMessage(NameValuePairList))
-                            {
-                                return m_logLoadingState;
-                            }
-                            // detect mav type
-                            if(m_loadedLogType == MAV_TYPE_GENERIC)
-                            {
-                                detectMavType(NameValuePairList);
-                            }
+                            return m_logLoadingState;
                         }
-                        // Special message handling - Statustext
-                        else if(mavlinkMessage.msgid == MAVLINK_MSG_ID_STATUSTEXT)
+                        // detect mav type
+                        if(m_loadedLogType == MAV_TYPE_GENERIC)
                         {
-                            // Create a MsgMessage from STATUSTEXT
-                            if(!extractMsgMessage(NameValuePairList))
-                            {
-                                return m_logLoadingState;
-                            }
+                            detectMavType(NameValuePairList);
+                        }
+                    }
+                    // Special message handling - Statustext
+                    else if(mavlinkMessage.msgid == MAVLINK_MSG_ID_STATUSTEXT)
+                    {
+                        // Create a MsgMessage from STATUSTEXT
+                        if(!extractMsgMessage(NameValuePairList))
+                        {
+                            return m_logLoadingState;
                         }
                     }
-                }
-                else
-                {
-                   emptyMessages++;
                 }
             }
             else if(decodeState == MAVLINK_FRAMING_BAD_CRC)
@@ -179,6 +204,26 @@ AP2DataPlotStatus TlogParser::parse(QFile &logfile)
     return m_logLoadingState;
 }
 
+quint8 TlogParser::parseChar(quint8 c, mavlink_message_t &mavlinkMessage, mavlink_status_t &mavlinkStatus)
+{
+    const quint8 framingState = mavlink_frame_char_buffer(&m_rxBuffer, &m_rxStatus, c, &mavlinkMessage, &mavlinkStatus);
+    if ((framingState == MAVLINK_FRAMING_BAD_CRC) || (framingState == MAVLINK_FRAMING_BAD_SIGNATURE))
+    {
+        // Treat as parse failure and restart framing - same as mavlink_parse_char() does
+        _mav_parse_error(&m_rxStatus);
+        m_rxStatus.msg_received = MAVLINK_FRAMING_INCOMPLETE;
+        m_rxStatus.parse_state = MAVLINK_PARSE_STATE_IDLE;
+        if (c == MAVLINK_STX)
+        {
+            m_rxStatus.parse_state = MAVLINK_PARSE_STATE_GOT_STX;
+            m_rxBuffer.len = 0;
+            mavlink_start_checksum(&m_rxBuffer);
+        }
+        return MAVLINK_FRAMING_INCOMPLETE;
+    }
+    return framingState;
+}
+
 void TlogParser::addMissingDescriptors()
 {
     // Tlog does not contain MODE messages the mode information ins transmitted in
@@ -211,12 +256,11 @@ void TlogParser::addMissingDescriptors()
     storeDescriptor(descriptor);
 }
 
-bool TlogParser::parseDescriptor(tlogDescriptor &desc)
+bool TlogParser::parseDescriptor(tlogDescriptor &desc, const mavlink_message_info_t &messageInfo)
 {
-    QList<QString> fieldnames = m_mavDecoderPtr->getFieldList(desc.m_name);
-    for (int i = 0; i < fieldnames.size(); ++i)
+    for (unsigned int i = 0; i < messageInfo.num_fields; ++i)
     {
-        mavlink_field_info_t fieldinfo = m_mavDecoderPtr->getFieldInfo(desc.m_name, fieldnames.at(i));
+        const mavlink_field_info_t &fieldinfo = messageInfo.fields[i];
 
         switch (fieldinfo.type)
         {
@@ -343,76 +387,115 @@ bool TlogParser::storeDescriptor(tlogDescriptor desc)
     return true;
 }
 
-bool TlogParser::decodeData(const mavlink_message_t &mavlinkMessage, QList<NameValuePair> &NameValuePairList)
+bool TlogParser::decodeData(const mavlink_message_t &mavlinkMessage, const mavlink_message_info_t &messageInfo,
+                            const tlogDescriptor &desc, QList<NameValuePair> &NameValuePairList)
 {
-    bool success = true;
-    mp_ReceiveData = &NameValuePairList;
+    const char *p_payload = _MAV_PAYLOAD(&mavlinkMessage);
+    int labelIndex = 0;
 
-    m_mavDecoderPtr->decodeMessage(mavlinkMessage);
+    // +1 as storing may prepend a time stamp
+    NameValuePairList.reserve(desc.m_labels.size() + 1);
 
-    if(NameValuePairList.empty())
+    for (unsigned int i = 0; i < messageInfo.num_fields; ++i)
     {
-        success = false;
+        const mavlink_field_info_t &fieldinfo = messageInfo.fields[i];
+        const char *p_field = p_payload + fieldinfo.wire_offset;
+
+        if ((fieldinfo.type == MAVLINK_TYPE_CHAR) && (fieldinfo.array_length > 0))
+        {
+            // char arrays are strings - they must not be null terminated
+            if (labelIndex >= desc.m_labels.size())
+            {
+                break;
+            }
+            int length = static_cast<int>(qstrnlen(p_field, fieldinfo.array_length));
+            NameValuePairList.append(NameValuePair(desc.m_labels.at(labelIndex++), QString::fromUtf8(p_field, length)));
+            continue;
+        }
+
+        int elements = fieldinfo.array_length == 0 ? 1 : static_cast<int>(fieldinfo.array_length);
+        for (int element = 0; (element < elements) && (labelIndex < desc.m_labels.size()); ++element)
+        {
+            NameValuePairList.append(NameValuePair(desc.m_labels.at(labelIndex++), decodeValue(fieldinfo.type, p_field, element)));
+        }
     }
 
-    mp_ReceiveData = nullptr;
-    return success;
+    return !NameValuePairList.empty();
 }
 
-void TlogParser::newValue(int uasId, const QString &name, const QString &unit, const QVariant &value, quint64 msec)
+QVariant TlogParser::decodeValue(mavlink_message_type_t type, const char *p_field, int element)
 {
-    Q_UNUSED(uasId)
-    Q_UNUSED(msec)
-    Q_UNUSED(unit)
-
-    // the name of the expected data looks like this:
-    // "M1:RAW_IMU.time_usec" in standart case
-    // "M1:BATTERY_STATUS.voltages.0" in case of an array
-
-    if((mp_ReceiveData != nullptr) && value.isValid())
+    // payload is not aligned - memcpy does the job.
+    switch (type)
     {
-        QStringList list = name.split(".");
-        if(list.size() == 2)
-        {   // handle standart data
-            mp_ReceiveData->append(NameValuePair(list[1], value));
+        case MAVLINK_TYPE_CHAR:
+        {
+            char value;
+            memcpy(&value, p_field + element, sizeof(value));
+            return static_cast<int>(value);
         }
-        else if(list.size() == 3)
-        {   // handle array data
-            QString name(list[1] + "-" + list[2]);
-            mp_ReceiveData->append(NameValuePair(name, value));
+        case MAVLINK_TYPE_UINT8_T:
+        {
+            quint8 value;
+            memcpy(&value, p_field + element * sizeof(value), sizeof(value));
+            return static_cast<int>(value);
         }
-        else
+        case MAVLINK_TYPE_INT8_T:
         {
-            QLOG_WARN() << "Missing data type information. Message:" << name <<  ":"
-                        << value.toString();
-            m_logLoadingState.corruptDataRead(static_cast<int>(m_MessageCounter),
-                                              "Missing data type information. Message:" + name +
-                                              ":" + value.toString());
+            qint8 value;
+            memcpy(&value, p_field + element * sizeof(value), sizeof(value));
+            return static_cast<int>(value);
         }
-    }
-}
-
-void TlogParser::newTextValue(int uasId, int componentId, int severity, const QString &text)
-{
-    Q_UNUSED(uasId)
-    Q_UNUSED(componentId)
-    Q_UNUSED(severity)
-
-    // The date we are expecting looks like this:
-    // M1:STATUSTEXT.text: ArduCopter V3.6-dev (12a53ed6)
-    // M1:STATUSTEXT.text: Frame: QUAD
-
-    if(mp_ReceiveData != nullptr && text.contains(':'))
-    {
-         // we remove the "M1:STATUSTEXT.text:" part
-        int index = text.indexOf(':') + 1;
-        index = text.indexOf(':', index) + 1;
-
-        if(index != -1)
+        case MAVLINK_TYPE_UINT16_T:
+        {
+            quint16 value;
+            memcpy(&value, p_field + element * sizeof(value), sizeof(value));
+            return static_cast<int>(value);
+        }
+        case MAVLINK_TYPE_INT16_T:
+        {
+            qint16 value;
+            memcpy(&value, p_field + element * sizeof(value), sizeof(value));
+            return static_cast<int>(value);
+        }
+        case MAVLINK_TYPE_UINT32_T:
+        {
+            quint32 value;
+            memcpy(&value, p_field + element * sizeof(value), sizeof(value));
+            return value;
+        }
+        case MAVLINK_TYPE_INT32_T:
+        {
+            qint32 value;
+            memcpy(&value, p_field + element * sizeof(value), sizeof(value));
+            return value;
+        }
+        case MAVLINK_TYPE_FLOAT:
+        {
+            float value;
+            memcpy(&value, p_field + element * sizeof(value), sizeof(value));
+            return value;
+        }
+        case MAVLINK_TYPE_DOUBLE:
+        {
+            double value;
+            memcpy(&value, p_field + element * sizeof(value), sizeof(value));
+            return value;
+        }
+        case MAVLINK_TYPE_UINT64_T:
+        {
+            quint64 value;
+            memcpy(&value, p_field + element * sizeof(value), sizeof(value));
+            return value;
+        }
+        case MAVLINK_TYPE_INT64_T:
         {
-            mp_ReceiveData->append(NameValuePair("text", text.mid(index)));
+            qint64 value;
+            memcpy(&value, p_field + element * sizeof(value), sizeof(value));
+            return value;
         }
     }
+    return {};
 }
 
 bool TlogParser::extractModeMessage(const QList<NameValuePair> &NameValuePairList)
@@ -32,8 +32,9 @@ This file is part of the APM_PLANNER project
 #include "ILogParser.h"
 #include "IParserCallback.h"
 #include "LogParserBase.h"
-#include "MAVLinkDecoder.h"
 #include "LogdataStorage.h"
+#include "QGC.h"
+#include "mavlink.h"
 
 /**
  * @brief The TlogParser class is a parser for tlog ArduPilot
@@ -63,25 +64,6 @@ public:
      */
     virtual AP2DataPlotStatus parse(QFile &logfile) override;
 
-    /**
-     * @brief newValue - Callback for the mavlink decoder - called for every decoded value
-     * @param uasId - UAS ID
-     * @param name  - Name of the value
-     * @param unit  - Unit / data type
-     * @param value - the value itself
-     * @param msec  - some sort of timestamp
-     */
-    void newValue(int uasId, const QString &name, const QString &unit, const QVariant &value, quint64 msec);
-
-    /**
-     * @brief newTextValue - Callback for the mavlink decoder - called for every decoded string
-     * @param uasId         - UAS ID
-     * @param componentId   - Component ID
-     * @param severity      - severity
-     * @param text          - The text
-     */
-    void newTextValue(int uasId, int componentId, int severity, const QString &text);
-
 private:
 
     /**
@@ -95,17 +77,28 @@ private:
     };
 
     QHash<QString, tlogDescriptor> m_nameToDescriptorMap;   /// hashMap storing a format descriptor for every message type
+    QHash<quint32, tlogDescriptor> m_idToDescriptorMap;     /// hashMap storing the format descriptor for every mavlink message ID
+    QHash<quint32, mavlink_message_info_t> m_idToMessageInfo; /// mavlink message description used for decoding
 
     QByteArray m_dataBlock;                 /// Data buffer for parsing.
-
-    QScopedPointer<MAVLinkDecoder> m_mavDecoderPtr;     /// pointer to mavlink decoder
+    mavlink_message_t m_rxBuffer;           /// Framing buffer - own one per parser, so several logs can be parsed in parallel
+    mavlink_status_t m_rxStatus;            /// Framing state belonging to m_rxBuffer
 
     quint8 m_lastModeVal;       /// holds the current mode used to detect changes
 
-    QList<NameValuePair> *mp_ReceiveData;  /// pointer to the data structure for receiving data
-
     quint8 m_GCSMavID = QGC::MavlinkID();  /// sys id of Ground station
 
+    /**
+     * @brief parseChar - frames one byte using the framing state of this parser. Works like
+     *        mavlink_parse_char() but does not use the global mavlink channel buffers which
+     *        are shared by all parsers.
+     * @param c - the byte to frame
+     * @param mavlinkMessage - the received message if MAVLINK_FRAMING_OK is returned
+     * @param mavlinkStatus - the framing status
+     * @return - MAVLINK_FRAMING_OK if a message was received, MAVLINK_FRAMING_INCOMPLETE otherwise
+     */
+    quint8 parseChar(quint8 c, mavlink_message_t &mavlinkMessage, mavlink_status_t &mavlinkStatus);
+
     /**
      * @brief addMissingDescriptors adds the missing type descriptors to the
      *        database. tlogs do not have a message for MODE or MSG messages
@@ -116,11 +109,12 @@ private:
 
     /**
      * @brief parseDescriptor extracts the descriptor data from tlog messages.
-     *        It reads its data direcly from the mavlink decoder.
+     *        It reads its data direcly from the mavlink message info.
      * @param desc - The descriptor is filled.
+     * @param messageInfo - mavlink description of the message
      * @return - true - success, false - data could not be parsed
      */
-    bool parseDescriptor(tlogDescriptor &desc);
+    bool parseDescriptor(tlogDescriptor &desc, const mavlink_message_info_t &messageInfo);
 
     /**
      * @brief extractDataFields extracts the datafields of a descriptor. it is a helper
@@ -143,12 +137,26 @@ private:
 
     /**
      * @brief decodeData - decodes data from a mavlink message to a name value
-     *        pair list.
+     *        pair list. The values are read directly from the payload using the
+     *        field offsets and types of the message info. The labels of the descriptor
+     *        are used as names.
      * @param mavlinkMessage - the message to decode
+     * @param messageInfo - mavlink description of the message
+     * @param desc - the descriptor of the message
      * @param NameValuePairList - the parsing result as list of NameValuePair
      * @return true - success, false otherwise or no result
      */
-    bool decodeData(const mavlink_message_t &mavlinkMessage, QList<NameValuePair> &NameValuePairList);
+    bool decodeData(const mavlink_message_t &mavlinkMessage, const mavlink_message_info_t &messageInfo,
+                    const tlogDescriptor &desc, QList<NameValuePair> &NameValuePairList);
+
+    /**
+     * @brief decodeValue - reads one value of a payload field
+     * @param type - mavlink type of the field
+     * @param p_field - pointer to the first element of the field in payload
+     * @param element - element index for array fields, 0 otherwise
+     * @return - the value. Invalid QVariant if the type is unknown
+     */
+    static QVariant decodeValue(mavlink_message_type_t type, const char *p_field, int element);
 
     /**
      * @brief extractModeMessage - extracts the data needed for a MODE message from
@@ -0,0 +1,265 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file MAVLinkRoutingDialog.cc
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the dialog which edits the MAVLink routes
+ */
+
+#include "MAVLinkRoutingDialog.h"
+#include "LinkManager.h"
+#include "MAVLinkRouter.h"
+#include "logging.h"
+
+#include <QComboBox>
+#include <QDialogButtonBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+
+MAVLinkRoutingDialog::MAVLinkRoutingDialog(QWidget *parent) :
+    QDialog(parent),
+    m_routeTable(new QTableWidget(this)),
+    m_removeButton(new QPushButton(tr("Remove Route"), this)),
+    m_updating(false)
+{
+    setWindowTitle(tr("MAVLink Routing"));
+
+    QLabel *helpLabel = new QLabel(tr("Messages received on the source link are forwarded to the target link. "
+                                      "Filters are comma separated ids, an empty filter accepts all ids."), this);
+    helpLabel->setWordWrap(true);
+
+    m_routeTable->setColumnCount(ColumnCount);
+    m_routeTable->setHorizontalHeaderLabels(QStringList() << tr("Source") << tr("Target") << tr("Systems")
+                                            << tr("Components") << tr("Messages") << tr("Blocked")
+                                            << tr("Msg/s") << tr("kB/s") << tr("Forwarded")
+                                            << tr("Filtered") << tr("Dropped"));
+    m_routeTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_routeTable->verticalHeader()->hide();
+    m_routeTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    QPushButton *addButton = new QPushButton(tr("Add Route"), this);
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addWidget(addButton);
+    buttonLayout->addWidget(m_removeButton);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(buttonBox);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(helpLabel);
+    layout->addWidget(m_routeTable);
+    layout->addLayout(buttonLayout);
+    resize(900, 300);
+
+    connect(addButton, SIGNAL(clicked()), this, SLOT(addRouteClicked()));
+    connect(m_removeButton, SIGNAL(clicked()), this, SLOT(removeRouteClicked()));
+    connect(buttonBox, SIGNAL(rejected()), this, SLOT(reject()));
+    connect(m_routeTable, SIGNAL(itemSelectionChanged()), this, SLOT(selectionChanged()));
+    connect(m_routeTable, SIGNAL(itemChanged(QTableWidgetItem*)), this, SLOT(filterEdited(QTableWidgetItem*)));
+
+    MAVLinkRouter *router = LinkManager::instance()->getRouter();
+    connect(router, SIGNAL(routesChanged()), this, SLOT(rebuildTable()));
+    connect(router, SIGNAL(statisticsUpdated()), this, SLOT(updateStatistics()));
+    connect(LinkManager::instance(), SIGNAL(newLink(int)), this, SLOT(rebuildTable()));
+
+    rebuildTable();
+}
+
+void MAVLinkRoutingDialog::addRouteClicked()
+{
+    const QList<int> links = LinkManager::instance()->getLinks();
+    if (links.size() < 2)
+    {
+        QMessageBox::information(this, tr("MAVLink Routing"), tr("A route needs at least two links."));
+        return;
+    }
+    // A new route forwards from the first to the second link, the user adjusts it in the table
+    if (LinkManager::instance()->addRoute(MAVLinkRouter::Route(links.at(0), links.at(1))) >= 0)
+    {
+        m_routeTable->selectRow(m_routeTable->rowCount() - 1);
+    }
+}
+
+void MAVLinkRoutingDialog::removeRouteClicked()
+{
+    QList<int> routeIds;
+    foreach (const QModelIndex &index, m_routeTable->selectionModel()->selectedRows())
+    {
+        routeIds.append(routeIdOfRow(index.row()));
+    }
+    foreach (int routeId, routeIds)
+    {
+        LinkManager::instance()->removeRoute(routeId);
+    }
+}
+
+void MAVLinkRoutingDialog::selectionChanged()
+{
+    m_removeButton->setEnabled(!m_routeTable->selectionModel()->selectedRows().isEmpty());
+}
+
+void MAVLinkRoutingDialog::linkEdited()
+{
+    QComboBox *combo = qobject_cast<QComboBox*>(sender());
+    for (int row = 0; combo && row < m_routeTable->rowCount(); ++row)
+    {
+        if (m_routeTable->cellWidget(row, ColumnSource) == combo || m_routeTable->cellWidget(row, ColumnTarget) == combo)
+        {
+            applyRow(row);
+            return;
+        }
+    }
+}
+
+void MAVLinkRoutingDialog::filterEdited(QTableWidgetItem *item)
+{
+    if (m_updating || item->column() < ColumnSystems || item->column() > ColumnBlocked)
+    {
+        return;
+    }
+    applyRow(item->row());
+}
+
+void MAVLinkRoutingDialog::rebuildTable()
+{
+    if (m_updating)
+    {
+        return;
+    }
+    m_updating = true;
+    const MAVLinkRouter *router = LinkManager::instance()->getRouter();
+    const QList<int> routeIds = router->getRouteIds();
+    m_routeTable->setRowCount(0);     // deletes the combo boxes as well
+    m_routeTable->setRowCount(routeIds.size());
+    for (int row = 0; row < routeIds.size(); ++row)
+    {
+        const MAVLinkRouter::Route route = router->getRoute(routeIds.at(row));
+
+        // The route id is kept in the item below the source link combo box
+        QTableWidgetItem *idItem = new QTableWidgetItem();
+        idItem->setData(Qt::UserRole, routeIds.at(row));
+        m_routeTable->setItem(row, ColumnSource, idItem);
+        m_routeTable->setCellWidget(row, ColumnSource, createLinkCombo(route.m_sourceLinkId));
+        m_routeTable->setCellWidget(row, ColumnTarget, createLinkCombo(route.m_targetLinkId));
+
+        m_routeTable->setItem(row, ColumnSystems, new QTableWidgetItem(MAVLinkRouter::idSetToString(route.m_sysIds)));
+        m_routeTable->setItem(row, ColumnComponents, new QTableWidgetItem(MAVLinkRouter::idSetToString(route.m_compIds)));
+        m_routeTable->setItem(row, ColumnMessages, new QTableWidgetItem(MAVLinkRouter::idSetToString(route.m_msgIds)));
+        m_routeTable->setItem(row, ColumnBlocked, new QTableWidgetItem(MAVLinkRouter::idSetToString(route.m_blockedMsgIds)));
+        for (int column = ColumnMessageRate; column < ColumnCount; ++column)
+        {
+            QTableWidgetItem *item = new QTableWidgetItem();
+            item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            m_routeTable->setItem(row, column, item);
+        }
+    }
+    m_updating = false;
+    updateStatistics();
+    selectionChanged();
+}
+
+void MAVLinkRoutingDialog::updateStatistics()
+{
+    if (m_updating)
+    {
+        return;
+    }
+    m_updating = true;
+    const MAVLinkRouter *router = LinkManager::instance()->getRouter();
+    for (int row = 0; row < m_routeTable->rowCount(); ++row)
+    {
+        const MAVLinkRouter::RouteStatistics statistics = router->getStatistics(routeIdOfRow(row));
+        m_routeTable->item(row, ColumnMessageRate)->setText(QString::number(statistics.m_messageRate, 'f', 1));
+        m_routeTable->item(row, ColumnByteRate)->setText(QString::number(statistics.m_byteRate / 1000.0, 'f', 1));
+        m_routeTable->item(row, ColumnForwarded)->setText(QString::number(statistics.m_messages));
+        m_routeTable->item(row, ColumnFiltered)->setText(QString::number(statistics.m_filtered));
+        m_routeTable->item(row, ColumnDropped)->setText(QString::number(statistics.m_dropped));
+    }
+    m_updating = false;
+}
+
+QComboBox *MAVLinkRoutingDialog::createLinkCombo(int linkId) const
+{
+    QComboBox *combo = new QComboBox();
+    foreach (int id, LinkManager::instance()->getLinks())
+    {
+        combo->addItem(LinkManager::instance()->getLinkName(id), id);
+    }
+    int index = combo->findData(linkId);
+    if (index < 0)
+    {
+        combo->addItem(tr("Link %1").arg(linkId), linkId);
+        index = combo->count() - 1;
+    }
+    combo->setCurrentIndex(index);
+    connect(combo, SIGNAL(currentIndexChanged(int)), this, SLOT(linkEdited()));
+    return combo;
+}
+
+int MAVLinkRoutingDialog::routeIdOfRow(int row) const
+{
+    const QTableWidgetItem *idItem = m_routeTable->item(row, ColumnSource);
+    return idItem ? idItem->data(Qt::UserRole).toInt() : -1;
+}
+
+void MAVLinkRoutingDialog::applyRow(int row)
+{
+    const QComboBox *sourceCombo = qobject_cast<QComboBox*>(m_routeTable->cellWidget(row, ColumnSource));
+    const QComboBox *targetCombo = qobject_cast<QComboBox*>(m_routeTable->cellWidget(row, ColumnTarget));
+    if (!sourceCombo || !targetCombo)
+    {
+        return;
+    }
+
+    MAVLinkRouter::Route route(sourceCombo->currentData().toInt(), targetCombo->currentData().toInt());
+    route.m_sysIds = MAVLinkRouter::idSetFromString(m_routeTable->item(row, ColumnSystems)->text());
+    route.m_compIds = MAVLinkRouter::idSetFromString(m_routeTable->item(row, ColumnComponents)->text());
+    route.m_msgIds = MAVLinkRouter::idSetFromString(m_routeTable->item(row, ColumnMessages)->text());
+    route.m_blockedMsgIds = MAVLinkRouter::idSetFromString(m_routeTable->item(row, ColumnBlocked)->text());
+
+    // The row stays as it is - rebuilding would delete the editor which sent the change
+    m_updating = true;
+    const bool ok = LinkManager::instance()->updateRoute(routeIdOfRow(row), route);
+    if (ok)
+    {
+        // Show the filters as the router understood them
+        m_routeTable->item(row, ColumnSystems)->setText(MAVLinkRouter::idSetToString(route.m_sysIds));
+        m_routeTable->item(row, ColumnComponents)->setText(MAVLinkRouter::idSetToString(route.m_compIds));
+        m_routeTable->item(row, ColumnMessages)->setText(MAVLinkRouter::idSetToString(route.m_msgIds));
+        m_routeTable->item(row, ColumnBlocked)->setText(MAVLinkRouter::idSetToString(route.m_blockedMsgIds));
+    }
+    m_updating = false;
+
+    if (!ok)
+    {
+        QLOG_WARN() << "MAVLinkRoutingDialog: route" << routeIdOfRow(row) << "not changed";
+        QMessageBox::warning(this, tr("MAVLink Routing"), tr("Source and target of a route must be different links."));
+        QTimer::singleShot(0, this, SLOT(rebuildTable()));
+    }
+}
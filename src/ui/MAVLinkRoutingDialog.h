@@ -0,0 +1,93 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file MAVLinkRoutingDialog.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the dialog which edits the MAVLink routes
+ */
+
+#ifndef MAVLINKROUTINGDIALOG_H
+#define MAVLINKROUTINGDIALOG_H
+
+#include <QDialog>
+
+class QComboBox;
+class QPushButton;
+class QTableWidget;
+class QTableWidgetItem;
+
+/**
+ * @brief The MAVLinkRoutingDialog class lists the routes of the MAVLinkRouter
+ *        with their filters and throughput. Routes can be added, removed and
+ *        edited in place: source and target link are selected from the links,
+ *        the filters are comma separated id lists. Changes are applied at once
+ *        and stored with the link settings by the LinkManager.
+ */
+class MAVLinkRoutingDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    enum Column
+    {
+        ColumnSource,
+        ColumnTarget,
+        ColumnSystems,
+        ColumnComponents,
+        ColumnMessages,
+        ColumnBlocked,
+        ColumnMessageRate,
+        ColumnByteRate,
+        ColumnForwarded,
+        ColumnFiltered,
+        ColumnDropped,
+        ColumnCount
+    };
+
+    explicit MAVLinkRoutingDialog(QWidget *parent = nullptr);
+
+private slots:
+    void addRouteClicked();
+    void removeRouteClicked();
+    void selectionChanged();
+    void linkEdited();
+    void filterEdited(QTableWidgetItem *item);
+    void rebuildTable();
+    void updateStatistics();
+
+private:
+    QComboBox *createLinkCombo(int linkId) const;
+    int routeIdOfRow(int row) const;
+
+    /**
+     * @brief applyRow sends the configuration of a row to the router. An invalid
+     *        configuration is reported and the row is reset.
+     * @param row - the row
+     */
+    void applyRow(int row);
+
+    QTableWidget *m_routeTable;
+    QPushButton *m_removeButton;
+    bool m_updating;                ///< The table is changed by code, not by the user
+};
+
+#endif // MAVLINKROUTINGDIALOG_H
@@ -32,6 +32,7 @@ This file is part of the QGROUNDCONTROL project
 #include "dockwidgettitlebareventfilter.h"
 #include "QGC.h"
 #include "CommConfigurationWindow.h"
+#include "MAVLinkRoutingDialog.h"
 #include "GAudioOutput.h"
 #include "QGCToolWidget.h"
 #include "QGCMAVLinkLogPlayer.h"
@@ -50,6 +51,7 @@ This file is part of the QGROUNDCONTROL project
 #include "EKFMonitor.h"
 #include "VibrationMonitor.h"
 #include "UASInfoWidget.h"
+#include "UASSharedTelemetryExporter.h"
 #include "HSIDisplay.h"
 #include "PrimaryFlightDisplay.h"
 #include "PrimaryFlightDisplayQML.h"
@@ -262,6 +264,9 @@ MainWindow::MainWindow(QWidget *parent):
     connect(LinkManager::instance(),SIGNAL(linkError(int,QString)),this,SLOT(linkError(int,QString)));
 
     connect(ui.actionTerminalConsole, SIGNAL(triggered()), this, SLOT(showTerminalConsole()));
+    // The link actions of the menu carry the link id, this one is no link
+    ui.actionMAVLinkRouting->setData(-1);
+    connect(ui.actionMAVLinkRouting, SIGNAL(triggered()), this, SLOT(showMAVLinkRouting()));
 
 #ifndef QGC_TOOLBAR_ENABLED
     // Add the APM 'toolbar'
@@ -927,7 +932,6 @@ void MainWindow::loadDockWidget(QString name)
         acceptList->append("-3.3,ATTITUDE.pitch,deg,+3.3,s");
         acceptList->append("-3.3,ATTITUDE.yaw,deg,+3.3,s");
         HDDisplay *hddisplay = new HDDisplay(acceptList,"Flight Display",this);
-        hddisplay->addSource(mavlinkDecoder);
         createDockWidget(centerStack->currentWidget(),hddisplay,tr("Flight Display"),"HEAD_DOWN_DISPLAY_1_DOCKWIDGET",currentView,Qt::RightDockWidgetArea);
     }
     else if (name == "HEAD_DOWN_DISPLAY_2_DOCKWIDGET")
@@ -936,7 +940,6 @@ void MainWindow::loadDockWidget(QString name)
         QStringList* acceptList2 = new QStringList();
         acceptList2->append("0,RAW_PRESSURE.pres_abs,hPa,65500");
         HDDisplay *hddisplay = new HDDisplay(acceptList2,"Actuator Status",this);
-        hddisplay->addSource(mavlinkDecoder);
         createDockWidget(centerStack->currentWidget(),hddisplay,tr("Actuator Status"),"HEAD_DOWN_DISPLAY_2_DOCKWIDGET",currentView,Qt::RightDockWidgetArea);
     }
     else if (name == "Radio Control")
@@ -1265,6 +1268,11 @@ void MainWindow::loadSettings()
     dockWidgetTitleBarEnabled = settings.value("DOCK_WIDGET_TITLEBARS", true).toBool();
     isAdvancedMode = settings.value("ADVANCED_MODE", false).toBool();
     enableHeartbeat(settings.value("HEARTBEATS_ENABLED",true).toBool());
+    if (settings.value("SHARED_TELEMETRY_EXPORT", true).toBool())
+    {
+        // Publish vehicle state for local analysis processes
+        UASSharedTelemetryExporter::instance()->start();
+    }
     settings.endGroup();
 }
 
@@ -2489,3 +2497,13 @@ void MainWindow::closeTerminalConsole()
         m_terminalDialog = NULL;
     }
 }
+
+void MainWindow::showMAVLinkRouting()
+{
+    if (m_routingDialog.isNull()){
+        m_routingDialog = new MAVLinkRoutingDialog(this);
+        m_routingDialog->setAttribute(Qt::WA_DeleteOnClose);
+    }
+    m_routingDialog->show();
+    m_routingDialog->raise();
+}
@@ -69,6 +69,7 @@ class QGCMapTool;
 class QGCFirmwareUpdate;
 class QSplashScreen;
 class QGCStatusBar;
+class MAVLinkRoutingDialog;
 
 /**
  * @brief The LogWindowSingleton class is a helper class providing
@@ -512,6 +513,7 @@ private slots:
 
     void showTerminalConsole();
     void closeTerminalConsole();
+    void showMAVLinkRouting();
 
 private:
     bool m_heartbeatEnabled;
@@ -531,6 +533,7 @@ private:
     AutoUpdateDialog* m_dialog;
 
     QDialog* m_terminalDialog;
+    QPointer<MAVLinkRoutingDialog> m_routingDialog;
 
 };
 
@@ -26,6 +26,7 @@ This file is part of the APM_PLANNER project
 #include "UAS.h"
 #include "UASManager.h"
 #include "GoogleElevationData.h"
+#include "TerrainDatabase.h"
 
 #include "MissionElevationDisplay.h"
 #include "ui_MissionElevationDisplay.h"
@@ -40,6 +41,8 @@ static const double ElevationDefaultDistanceMax = 50.0; //m
 static const int ElevationGraphMissionId = 0; //m
 static const int ElevationGraphElevationId = 1; //m
 
+static const double TerrainDefaultSpacing = 30.0; //m
+
 MissionElevationDisplay::MissionElevationDisplay(QWidget *parent) :
     QWidget(parent),
     ui(new Ui::MissionElevationDisplay),
@@ -49,7 +52,8 @@ MissionElevationDisplay::MissionElevationDisplay(QWidget *parent) :
     m_elevationData(NULL),
     m_useHomeAltOffset(false),
     m_homeAltOffset(0.0),
-    m_elevationShown(false)
+    m_elevationShown(false),
+    m_localTerrain(false)
 {
     ui->setupUi(this);
 
@@ -180,12 +184,22 @@ void MissionElevationDisplay::updateDisplay()
 
     m_totalDistance = plotElevationGraph(m_waypointList.values(), ElevationGraphMissionId, m_homeAltOffset);
     addWaypointLabels();
+
+    // Local terrain is instant, so keep the profile in sync with the mission
+    if (m_localTerrain && !updateTerrainProfile()){
+        m_localTerrain = false;
+        ui->refreshButton->setText("Refresh Elevation");
+        ui->refreshButton->setEnabled(true);
+    }
 }
 
 void MissionElevationDisplay::updateElevationGraph(QList<Waypoint *> waypointList, double averageResolution)
 {
     if (m_waypointList.count() == 0)
         return;
+    ui->customPlot->graph(ElevationGraphElevationId)->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssDiamond, 10));
+    ui->resolutionLabel->setStyleSheet("");
+    ui->resolutionLabel->setToolTip("");
     int distance = plotElevationGraph(waypointList, ElevationGraphElevationId, 0.0);
     ui->resolutionLabel->setText(QString::number(averageResolution)+"(m)");
     if (distance > m_totalDistance)
@@ -275,8 +289,73 @@ void MissionElevationDisplay::addWaypointLabels()
     }
 }
 
+bool MissionElevationDisplay::updateTerrainProfile()
+{
+    if (m_waypointList.count() < 2)
+        return false;
+
+    // Same altitudes as plotted for the mission graph
+    QVector<double> latitudes;
+    QVector<double> longitudes;
+    QVector<double> altitudes;
+    double homeAlt = 0.0;
+    foreach(Waypoint* wp, m_waypointList){
+        double altitude = wp->getAltitude();
+        if (wp->getId() == 0){
+            homeAlt = altitude;
+            altitude += m_homeAltOffset;
+        } else if (wp->getFrame() == MAV_FRAME_GLOBAL_RELATIVE_ALT){
+            altitude += homeAlt + m_homeAltOffset;
+        }
+        latitudes.append(wp->getLatitude());
+        longitudes.append(wp->getLongitude());
+        altitudes.append(altitude);
+    }
+
+    TerrainDatabase* terrain = TerrainDatabase::instance();
+    double resolution = terrain->resolution(latitudes.first(), longitudes.first());
+    QVector<TerrainDatabase::Sample> samples = terrain->samplePath(latitudes, longitudes, altitudes,
+                                                                   resolution > 0.0 ? resolution : TerrainDefaultSpacing);
+    TerrainDatabase::Clearance clearance = TerrainDatabase::clearance(samples);
+    if (!clearance.m_valid)
+        return false;
+
+    QCustomPlot* customPlot = ui->customPlot;
+    QCPGraph* graph = customPlot->graph(ElevationGraphElevationId);
+    graph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssNone));
+    graph->data()->clear();
+    foreach(const TerrainDatabase::Sample& sample, samples){
+        if (sample.m_valid)
+            graph->addData(sample.m_distance, sample.m_elevation);
+    }
+    customPlot->rescaleAxes();
+    customPlot->replot();
+
+    QList<int> ids = m_waypointList.keys();
+    ui->resolutionLabel->setText(QString::number(resolution, 'f', 0) + "(m)\n"
+                                 + QString::number(clearance.m_minClearance, 'f', 0) + "m clear"
+                                 + (clearance.m_complete ? "" : "*"));
+    ui->resolutionLabel->setToolTip(QString("Lowest clearance above terrain %1m at %2m between WP%3 and WP%4%5")
+                                    .arg(clearance.m_minClearance, 0, 'f', 1)
+                                    .arg(clearance.m_distance, 0, 'f', 0)
+                                    .arg(ids.at(clearance.m_segment)).arg(ids.at(clearance.m_segment + 1))
+                                    .arg(clearance.m_complete ? "" : "\n* terrain tiles are missing for parts of the mission"));
+    ui->resolutionLabel->setStyleSheet(clearance.m_minClearance < 0.0 ? "QLabel { color: red; }" : "");
+    return true;
+}
+
 void MissionElevationDisplay::updateElevationData()
 {
+    // Use the local terrain tiles if there are any for this area
+    if (updateTerrainProfile()){
+        m_localTerrain = true;
+        m_elevationShown = true;
+        ui->refreshButton->setEnabled(false);
+        ui->refreshButton->setText("Updated");
+        return;
+    }
+    m_localTerrain = false;
+
     if(m_elevationData == NULL){
         m_elevationData = new GoogleElevationData();
         connect(m_elevationData, SIGNAL(elevationDataReady(QList<Waypoint*>,double)),
@@ -328,6 +407,8 @@ void MissionElevationDisplay::setHomeAltOffset()
 
 void MissionElevationDisplay::showInfoBox()
 {
-    QMessageBox::information(this, "Elevation Display", "The Elevation Display will show your mission elevation (blue) against Google's elevation data for that area (red)"
+    QMessageBox::information(this, "Elevation Display", "The Elevation Display will show your mission elevation (blue) against the elevation data for that area (red)."
+                             "\nLocal SRTM terrain tiles (*.hgt) in " + TerrainDatabase::instance()->tileDirectory() + " are used if available, "
+                             "otherwise Google's elevation data is downloaded."
                              "\nWARNING: The datas resolution can be reduced in some areas, so please use caution.",QMessageBox::Ok);
 }
@@ -60,6 +60,7 @@ private slots:
 
 private:
     int plotElevationGraph(QList<Waypoint *> waypointList, int graphId, double homeAltOffset);
+    bool updateTerrainProfile();
     double distanceBetweenLatLng(double lat1, double lon1, double lat2, double lon2);
     double getHomeAlt(Waypoint* wp);
     void addWaypointLabels();
@@ -76,6 +77,7 @@ private:
     bool m_useHomeAltOffset;
     double m_homeAltOffset;
     bool m_elevationShown;
+    bool m_localTerrain;    // Elevation is taken from the local terrain tiles instead of Google
 };
 
 #endif // MISSONELEVATIONDISPLAY_H
@@ -9,6 +9,7 @@
 #include <QPainter>
 #include <QPainterPath>
 #include <QResizeEvent>
+#include <QStaticText>
 #include <QtCore/qmath.h>
 //#include <cmath>
 
@@ -87,6 +88,10 @@ static const int AIRSPEED_LINEAR_SPAN = 15;
 static const int AIRSPEED_LINEAR_RESOLUTION = 1;
 static const int AIRSPEED_LINEAR_MAJOR_RESOLUTION = 5;
 
+// Smallest change of a value which causes a repaint. Smaller changes are not visible.
+static const float ATTITUDE_REPAINT_THRESHOLD = 0.1f;  // degrees
+static const float VALUE_REPAINT_THRESHOLD = 0.01f;    // m, m/s
+
 static const int UNKNOWN_ATTITUDE = -1000;
 static const int UNKNOWN_ALTITUDE = -1000;
 static const int UNKNOWN_SPEED = -1;
@@ -108,6 +113,15 @@ qreal PrimaryFlightDisplay_constrain(qreal value, qreal min, qreal max) {
     return value;
 }
 
+bool PrimaryFlightDisplay_changed(float value, float painted, float threshold) {
+    return value != painted && !(std::abs(value - painted) < threshold);
+}
+
+// Center of a layer pixmap in logical (device independent) pixels
+QPointF PrimaryFlightDisplay_layerCenter(const QPixmap& layer) {
+    return QPointF(layer.width(), layer.height()) / (2 * layer.devicePixelRatio());
+}
+
 const int PrimaryFlightDisplay::tickValues[] = {10, 20, 30, 45, 60};
 const QString PrimaryFlightDisplay::compassWindNames[] = {
     QString("N"),
@@ -161,11 +175,15 @@ PrimaryFlightDisplay::PrimaryFlightDisplay(int width, int height, QWidget *paren
     instrumentOpagueBackground(QColor::fromHsvF(0, 0, 0.3, 1.0)),
 
     font("Bitstream Vera Sans"),
-    refreshTimer(new QTimer(this))
+    refreshTimer(new QTimer(this)),
+    m_compassDiskLayerLabels(false),
+    m_repaintRequired(true)
 {
     Q_UNUSED(width);
     Q_UNUSED(height);
 
+    m_paintedValues = displayedValues();
+
     preArmCheckFailure = false;
     preArmCheckMessage = "";
     preArmMessageTimer = new QTimer(this);
@@ -184,7 +202,7 @@ PrimaryFlightDisplay::PrimaryFlightDisplay(int width, int height, QWidget *paren
     // Refresh timer
     refreshTimer->setInterval(updateInterval);
     //    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(paintHUD()));
-    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(update()));
+    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refreshIfChanged()));
 }
 
 PrimaryFlightDisplay::~PrimaryFlightDisplay()
@@ -241,6 +259,8 @@ void PrimaryFlightDisplay::resizeEvent(QResizeEvent *e) {
         layout = COMPASS_INTEGRATED;
     */
     // qDebug("Width %d height %d decision %d", e->size().width(), e->size().height(), layout);
+
+    invalidateLayers();
 }
 
 void PrimaryFlightDisplay::paintEvent(QPaintEvent *event)
@@ -249,6 +269,42 @@ void PrimaryFlightDisplay::paintEvent(QPaintEvent *event)
     doPaint();
 }
 
+PrimaryFlightDisplay::DisplayedValues PrimaryFlightDisplay::displayedValues() const
+{
+    DisplayedValues values;
+    values.roll = roll;
+    values.pitch = pitch;
+    values.heading = heading;
+    values.altitudeRelative = m_altitudeRelative;
+    values.altitudeAMSL = m_altitudeAMSL;
+    values.groundspeed = m_groundspeed;
+    values.airspeed = m_airspeed;
+    values.climbRate = m_climbRate;
+    values.crosstrackError = navigationCrosstrackError;
+    values.targetBearing = navigationTargetBearing;
+    return values;
+}
+
+void PrimaryFlightDisplay::refreshIfChanged()
+{
+    // The values arrive much faster than the display can show a difference.
+    // Only repaint if something visibly changed.
+    const DisplayedValues values = displayedValues();
+    if (m_repaintRequired
+            || PrimaryFlightDisplay_changed(values.roll, m_paintedValues.roll, ATTITUDE_REPAINT_THRESHOLD)
+            || PrimaryFlightDisplay_changed(values.pitch, m_paintedValues.pitch, ATTITUDE_REPAINT_THRESHOLD)
+            || PrimaryFlightDisplay_changed(values.heading, m_paintedValues.heading, ATTITUDE_REPAINT_THRESHOLD)
+            || PrimaryFlightDisplay_changed(values.targetBearing, m_paintedValues.targetBearing, ATTITUDE_REPAINT_THRESHOLD)
+            || PrimaryFlightDisplay_changed(values.altitudeRelative, m_paintedValues.altitudeRelative, VALUE_REPAINT_THRESHOLD)
+            || PrimaryFlightDisplay_changed(values.altitudeAMSL, m_paintedValues.altitudeAMSL, VALUE_REPAINT_THRESHOLD)
+            || PrimaryFlightDisplay_changed(values.groundspeed, m_paintedValues.groundspeed, VALUE_REPAINT_THRESHOLD)
+            || PrimaryFlightDisplay_changed(values.airspeed, m_paintedValues.airspeed, VALUE_REPAINT_THRESHOLD)
+            || PrimaryFlightDisplay_changed(values.climbRate, m_paintedValues.climbRate, VALUE_REPAINT_THRESHOLD)
+            || PrimaryFlightDisplay_changed(values.crosstrackError, m_paintedValues.crosstrackError, VALUE_REPAINT_THRESHOLD)) {
+        update();
+    }
+}
+
 ///*
 // * Interface towards qgroundcontrol
 // */
@@ -333,6 +389,7 @@ void PrimaryFlightDisplay::setActiveUAS(UASInterface* uas)
         // Set new UAS
         this->uas = uas;
     }
+    m_repaintRequired = true;
 }
 void PrimaryFlightDisplay::uasTextMessage(int uasid, int componentid, int severity, QString text)
 {
@@ -346,6 +403,7 @@ void PrimaryFlightDisplay::uasTextMessage(int uasid, int componentid, int severi
         preArmCheckMessage =  QString("M%1:%2").arg(uasid).arg(text);
         preArmCheckFailure = true;
         preArmMessageTimer->start(4000);
+        m_repaintRequired = true;
     }
 }
 
@@ -446,10 +504,8 @@ void PrimaryFlightDisplay::drawTextCenter (
     font.setPixelSize(pixelSize);
     painter.setFont(font);
 
-    QFontMetrics metrics = QFontMetrics(font);
-    QRect bounds = metrics.boundingRect(text);
-    int flags = Qt::AlignCenter |  Qt::TextDontClip; // For some reason the bounds rect is too small!
-    painter.drawText(x /*+bounds.x()*/ -bounds.width()/2, y /*+bounds.y()*/ -bounds.height()/2, bounds.width(), bounds.height(), flags, text);
+    const QStaticText& cachedText = staticText(text);
+    painter.drawStaticText(QPointF(x - cachedText.size().width()/2, y - cachedText.size().height()/2), cachedText);
 }
 
 void PrimaryFlightDisplay::drawTextLeftCenter (
@@ -462,10 +518,8 @@ void PrimaryFlightDisplay::drawTextLeftCenter (
     font.setPixelSize(pixelSize);
     painter.setFont(font);
 
-    QFontMetrics metrics = QFontMetrics(font);
-    QRect bounds = metrics.boundingRect(text);
-    int flags = Qt::AlignLeft | Qt::TextDontClip; // For some reason the bounds rect is too small!
-    painter.drawText(x /*+bounds.x()*/, y /*+bounds.y()*/ -bounds.height()/2, bounds.width(), bounds.height(), flags, text);
+    const QStaticText& cachedText = staticText(text);
+    painter.drawStaticText(QPointF(x, y - cachedText.size().height()/2), cachedText);
 }
 
 void PrimaryFlightDisplay::drawTextRightCenter (
@@ -478,10 +532,8 @@ void PrimaryFlightDisplay::drawTextRightCenter (
     font.setPixelSize(pixelSize);
     painter.setFont(font);
 
-    QFontMetrics metrics = QFontMetrics(font);
-    QRect bounds = metrics.boundingRect(text);
-    int flags = Qt::AlignRight | Qt::TextDontClip; // For some reason the bounds rect is too small!
-    painter.drawText(x /*+bounds.x()*/ -bounds.width(), y /*+bounds.y()*/ -bounds.height()/2, bounds.width(), bounds.height(), flags, text);
+    const QStaticText& cachedText = staticText(text);
+    painter.drawStaticText(QPointF(x - cachedText.size().width(), y - cachedText.size().height()/2), cachedText);
 }
 
 void PrimaryFlightDisplay::drawTextCenterTop (
@@ -494,10 +546,8 @@ void PrimaryFlightDisplay::drawTextCenterTop (
     font.setPixelSize(pixelSize);
     painter.setFont(font);
 
-    QFontMetrics metrics = QFontMetrics(font);
-    QRect bounds = metrics.boundingRect(text);
-    int flags = Qt::AlignCenter | Qt::TextDontClip; // For some reason the bounds rect is too small!
-    painter.drawText(x /*+bounds.x()*/ -bounds.width()/2, y+bounds.height() /*+bounds.y()*/, bounds.width(), bounds.height(), flags, text);
+    const QStaticText& cachedText = staticText(text);
+    painter.drawStaticText(QPointF(x - cachedText.size().width()/2, y + cachedText.size().height()), cachedText);
 }
 
 void PrimaryFlightDisplay::drawTextCenterBottom (
@@ -510,10 +560,93 @@ void PrimaryFlightDisplay::drawTextCenterBottom (
     font.setPixelSize(pixelSize);
     painter.setFont(font);
 
-    QFontMetrics metrics = QFontMetrics(font);
-    QRect bounds = metrics.boundingRect(text);
-    int flags = Qt::AlignCenter;
-    painter.drawText(x /*+bounds.x()*/ -bounds.width()/2, y /*+bounds.y()*/, bounds.width(), bounds.height(), flags, text);
+    const QStaticText& cachedText = staticText(text);
+    painter.drawStaticText(QPointF(x - cachedText.size().width()/2, y), cachedText);
+}
+
+const QStaticText& PrimaryFlightDisplay::staticText(const QString& text)
+{
+    // The numbers on the scales repeat all the time. Keep their layout
+    // so the glyphs are not looked up and positioned on every paint.
+    const QPair<int, QString> key(font.pixelSize(), text);
+    QHash<QPair<int, QString>, QStaticText>::const_iterator iter = m_staticTexts.constFind(key);
+    if (iter != m_staticTexts.constEnd())
+        return iter.value();
+
+    if (m_staticTexts.size() >= maxStaticTexts)
+        m_staticTexts.clear();
+
+    QStaticText cachedText(text);
+    cachedText.setTextFormat(Qt::PlainText);
+    cachedText.setPerformanceHint(QStaticText::AggressiveCaching);
+    cachedText.prepare(QTransform(), font);
+    return *m_staticTexts.insert(key, cachedText);
+}
+
+QPixmap PrimaryFlightDisplay::createLayer(const QSizeF& size) const
+{
+    const qreal ratio = devicePixelRatioF();
+    QPixmap layer(qCeil(size.width() * ratio), qCeil(size.height() * ratio));
+    layer.setDevicePixelRatio(ratio);
+    layer.fill(Qt::transparent);
+    return layer;
+}
+
+void PrimaryFlightDisplay::invalidateLayers()
+{
+    // All sizes depend on the widget size
+    m_rollScaleLayer = QPixmap();
+    m_compassDiskLayer = QPixmap();
+    m_airframeLayer = QPixmap();
+    m_staticTexts.clear();
+    m_repaintRequired = true;
+}
+
+const QPixmap& PrimaryFlightDisplay::rollScaleLayer(QRectF area)
+{
+    if (m_rollScaleLayer.isNull()) {
+        qreal w = area.width();
+        if (w<area.height()) w = area.height();
+        // The numbers are outside of the tick marks
+        qreal halfSize = w*(ROLL_SCALE_RADIUS+ROLL_SCALE_TICKMARKLENGTH*1.7f) + mediumTextSize*2 + lineWidth;
+
+        m_rollScaleLayer = createLayer(QSizeF(halfSize*2, halfSize*2));
+        QPainter painter(&m_rollScaleLayer);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.translate(PrimaryFlightDisplay_layerCenter(m_rollScaleLayer));
+        drawRollScale(painter, area, true, true);
+    }
+    return m_rollScaleLayer;
+}
+
+const QPixmap& PrimaryFlightDisplay::compassDiskLayer(QRectF area, bool drawLabels)
+{
+    if (m_compassDiskLayer.isNull() || m_compassDiskLayerLabels != drawLabels) {
+        qreal margin = instrumentEdgePen.widthF() + lineWidth;
+
+        m_compassDiskLayer = createLayer(area.size() + QSizeF(margin*2, margin*2));
+        m_compassDiskLayerLabels = drawLabels;
+        QPainter painter(&m_compassDiskLayer);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        QPointF center = PrimaryFlightDisplay_layerCenter(m_compassDiskLayer);
+        renderCompassDiskScale(painter, QRectF(center.x()-area.width()/2, center.y()-area.height()/2, area.width(), area.height()), drawLabels);
+    }
+    return m_compassDiskLayer;
+}
+
+const QPixmap& PrimaryFlightDisplay::airframeLayer(QRectF area)
+{
+    if (m_airframeLayer.isNull()) {
+        qreal w = area.width();
+        qreal margin = lineWidth*3;
+        // From the side lines to the roll scale marker on top
+        m_airframeLayer = createLayer(QSizeF(w + margin*2, (w*ROLL_SCALE_RADIUS + margin)*2));
+        QPainter painter(&m_airframeLayer);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.translate(PrimaryFlightDisplay_layerCenter(m_airframeLayer));
+        renderAIAirframeFixedFeatures(painter, area);
+    }
+    return m_airframeLayer;
 }
 
 void PrimaryFlightDisplay::drawInstrumentBackground(QPainter& painter, QRectF edge) {
@@ -542,14 +675,19 @@ qreal pitchAngleToTranslation(qreal viewHeight, float pitch) {
 }
 
 void PrimaryFlightDisplay::drawAIAirframeFixedFeatures(QPainter& painter, QRectF area) {
+    const QPixmap& airframe = airframeLayer(area);
+    painter.resetTransform();
+    painter.translate(area.center());
+    painter.drawPixmap(-PrimaryFlightDisplay_layerCenter(airframe), airframe);
+}
+
+void PrimaryFlightDisplay::renderAIAirframeFixedFeatures(QPainter& painter, QRectF area) {
     // red line from -7/10 to -5/10 half-width
     // red line from 7/10 to 5/10 half-width
     // red slanted line from -2/10 half-width to 0
     // red slanted line from 2/10 half-width to 0
     // red arrow thing under roll scale
-    // prepareTransform(painter, width, height);
-    painter.resetTransform();
-    painter.translate(area.center());
+    // Painted relative to the center of area, the caller translates there.
 
     qreal w = area.width();
     qreal h = area.height();
@@ -726,9 +864,9 @@ void PrimaryFlightDisplay::drawPitchScale(
             if (SHOW_ZERO_ON_SCALES || degrees) {
                 QString s_number;
                 if (this->pitch == UNKNOWN_ATTITUDE)
-                    s_number.asprintf("-");
+                    s_number = QString::asprintf("-");
                 else
-                    s_number.asprintf("%d", displayDegrees);
+                    s_number = QString::asprintf("%d", displayDegrees);
                 if (drawNumbersLeft)  drawTextRightCenter(painter, s_number, mediumTextSize, -PITCH_SCALE_MAJORWIDTH * w-10, 0);
                 if (drawNumbersRight) drawTextLeftCenter(painter, s_number, mediumTextSize, PITCH_SCALE_MAJORWIDTH * w+10, 0);
             }
@@ -777,7 +915,7 @@ void PrimaryFlightDisplay::drawRollScale(
 
             QString s_number; //= QString("%d").arg(degrees);
             if (SHOW_ZERO_ON_SCALES || degrees)
-                s_number.asprintf("%d", abs(degrees));
+                s_number = QString::asprintf("%d", abs(degrees));
 
             if (drawNumbers) {
                 drawTextCenterBottom(painter, s_number, mediumTextSize, 0, -(ROLL_SCALE_RADIUS+ROLL_SCALE_TICKMARKLENGTH*1.7)*w);
@@ -800,22 +938,14 @@ void PrimaryFlightDisplay::drawAIAttitudeScales(
     painter.rotate(-displayRoll);
     QTransform saved = painter.transform();
 
-    drawRollScale(painter, area, true, true);
+    const QPixmap& rollScale = rollScaleLayer(area);
+    painter.drawPixmap(-PrimaryFlightDisplay_layerCenter(rollScale), rollScale);
     painter.setTransform(saved);
     drawPitchScale(painter, area, intrusion, true, true);
 }
 
-void PrimaryFlightDisplay::drawAICompassDisk(QPainter& painter, QRectF area, float halfspan) {
-    float displayHeading = this->heading;
-    if(displayHeading == UNKNOWN_ATTITUDE)
-        displayHeading = 0;
-
-    float start = displayHeading - halfspan;
-    float end = displayHeading + halfspan;
-
-    int firstTick = ceil(start / COMPASS_DISK_RESOLUTION) * COMPASS_DISK_RESOLUTION;
-    int lastTick = floor(end / COMPASS_DISK_RESOLUTION) * COMPASS_DISK_RESOLUTION;
-
+void PrimaryFlightDisplay::renderCompassDiskScale(QPainter& painter, QRectF area, bool drawLabels) {
+    // Rendered for heading 0, the caller rotates the disk to the heading.
     float radius = area.width()/2;
     float innerRadius = radius * 0.96;
     painter.resetTransform();
@@ -827,23 +957,14 @@ void PrimaryFlightDisplay::drawAICompassDisk(QPainter& painter, QRectF area, flo
     QPen scalePen(Qt::black);
     scalePen.setWidthF(fineLineWidth);
 
-    for (int tickYaw = firstTick; tickYaw <= lastTick; tickYaw += COMPASS_DISK_RESOLUTION) {
-        int displayTick = tickYaw;
-        if (displayTick < 0) displayTick+=360;
-        else if (displayTick>=360) displayTick-=360;
-
-        // yaw is in center.
-        float off = tickYaw - displayHeading;
-        // wrap that to ]-180..180]
-        if (off<=-180) off+= 360; else if (off>180) off -= 360;
-
+    for (int displayTick = 0; displayTick < 360; displayTick += COMPASS_DISK_RESOLUTION) {
         painter.translate(area.center());
-        painter.rotate(off);
+        painter.rotate(displayTick);
         bool drewArrow = false;
         bool isMajor = displayTick % COMPASS_DISK_MAJORTICK == 0;
 
         // If heading unknown, still draw marks but no numbers.
-        if (this->heading != UNKNOWN_ATTITUDE &&
+        if (drawLabels &&
                 (displayTick==30 || displayTick==60 ||
                 displayTick==120 || displayTick==150 ||
                 displayTick==210 || displayTick==240 ||
@@ -851,7 +972,7 @@ void PrimaryFlightDisplay::drawAICompassDisk(QPainter& painter, QRectF area, flo
         ) {
             // draw a number
             QString s_number;
-            s_number.asprintf("%d", displayTick/10);
+            s_number = QString::asprintf("%d", displayTick/10);
             painter.setPen(scalePen);
             drawTextCenter(painter, s_number, smallTextSize, 0, -innerRadius*0.75);
         } else {
@@ -868,7 +989,7 @@ void PrimaryFlightDisplay::drawAICompassDisk(QPainter& painter, QRectF area, flo
                     drewArrow = true;
                 }
                 // If heading unknown, still draw marks but no N S E W.
-                if (this->heading != UNKNOWN_ATTITUDE && displayTick%90 == 0) {
+                if (drawLabels && displayTick%90 == 0) {
                     // Also draw a label
                     QString name = compassWindNames[displayTick / 45];
                     painter.setPen(scalePen);
@@ -885,6 +1006,28 @@ void PrimaryFlightDisplay::drawAICompassDisk(QPainter& painter, QRectF area, flo
         painter.drawLine(p_start, p_end);
         painter.resetTransform();
     }
+}
+
+void PrimaryFlightDisplay::drawAICompassDisk(QPainter& painter, QRectF area, float halfspan) {
+    // The disk is blitted as a whole, the part outside of the widget is clipped.
+    Q_UNUSED(halfspan);
+
+    float displayHeading = this->heading;
+    if(displayHeading == UNKNOWN_ATTITUDE)
+        displayHeading = 0;
+
+    float radius = area.width()/2;
+
+    // If heading unknown, still draw marks but no numbers.
+    const QPixmap& disk = compassDiskLayer(area, this->heading != UNKNOWN_ATTITUDE);
+    painter.resetTransform();
+    painter.translate(area.center());
+    painter.rotate(-displayHeading);
+    painter.drawPixmap(-PrimaryFlightDisplay_layerCenter(disk), disk);
+    painter.resetTransform();
+
+    QPen scalePen(Qt::black);
+    scalePen.setWidthF(fineLineWidth);
 
     painter.setPen(scalePen);
     //painter.setBrush(Qt::SolidPattern);
@@ -910,11 +1053,11 @@ void PrimaryFlightDisplay::drawAICompassDisk(QPainter& painter, QRectF area, flo
     QString s_digitalCompass;
 
     if (this->heading == UNKNOWN_ATTITUDE)
-        s_digitalCompass.asprintf("---");
+        s_digitalCompass = QString::asprintf("---");
     else {
     /* final safeguard for really stupid systems */
         int digitalCompassValue = static_cast<int>(qRound((double)heading)) % 360;
-        s_digitalCompass.asprintf("%03d", digitalCompassValue);
+        s_digitalCompass = QString::asprintf("%03d", digitalCompassValue);
     }
 
     QPen pen;
@@ -1014,7 +1157,7 @@ void PrimaryFlightDisplay::drawAltimeter(
         if (isMajor) {
             painter.drawLine(tickmarkLeft, 0, tickmarkRightMajor, 0);
             QString s_alt;
-            s_alt.asprintf("%d", abs(tickAlt));
+            s_alt = QString::asprintf("%d", abs(tickAlt));
             drawTextLeftCenter(painter, s_alt, mediumTextSize, numbersLeft, 0);
         } else {
             painter.drawLine(tickmarkLeft, 0, tickmarkRightMinor, 0);
@@ -1044,9 +1187,9 @@ void PrimaryFlightDisplay::drawAltimeter(
 
     QString s_alt;
     if(altitudeRelative == UNKNOWN_ALTITUDE)
-        s_alt.asprintf("---");
+        s_alt = QString::asprintf("---");
     else
-        s_alt.asprintf("%3.0f", altitudeRelative);
+        s_alt = QString::asprintf("%3.0f", altitudeRelative);
 
     float xCenter = (markerTip+rightEdge)/2;
     drawTextCenter(painter, s_alt, mediumTextSize, xCenter, 0);
@@ -1083,7 +1226,7 @@ void PrimaryFlightDisplay::drawAltimeter(
         painter.resetTransform();
         painter.translate(saBox.center());
         QString s_salt;
-        s_salt.asprintf("%3.0f", altitudeAMSL);
+        s_salt = QString::asprintf("%3.0f", altitudeAMSL);
         drawTextCenter(painter, s_salt, mediumTextSize, 0, 0);
     }
 
@@ -1141,7 +1284,7 @@ void PrimaryFlightDisplay::drawVelocityMeter(
         if (hasText) {
             painter.drawLine(tickmarkLeftMajor, 0, tickmarkRight, 0);
             QString s_speed;
-            s_speed.asprintf("%d", abs(tickSpeed));
+            s_speed = QString::asprintf("%d", abs(tickSpeed));
             drawTextRightCenter(painter, s_speed, mediumTextSize, numbersRight, 0);
         } else {
             painter.drawLine(tickmarkLeftMinor, 0, tickmarkRight, 0);
@@ -1170,9 +1313,9 @@ void PrimaryFlightDisplay::drawVelocityMeter(
     painter.setPen(pen);
     QString s_alt;
     if (groundspeed == UNKNOWN_SPEED)
-        s_alt.asprintf("---");
+        s_alt = QString::asprintf("---");
     else
-        s_alt.asprintf("%3.1f", groundspeed);
+        s_alt = QString::asprintf("%3.1f", groundspeed);
     float xCenter = (markerTip+leftEdge)/2;
     drawTextCenter(painter, s_alt + speedType, /* TAPES_TEXT_SIZE*width()*/ mediumTextSize, xCenter, 0);
 }
@@ -1252,6 +1395,7 @@ void PrimaryFlightDisplay::doPaint() {
     painter.begin(this);
     painter.setRenderHint(QPainter::Antialiasing, true);
     painter.setRenderHint(QPainter::HighQualityAntialiasing, true);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
 
     qreal margin = height()/100.0f;
 
@@ -1545,11 +1689,15 @@ void PrimaryFlightDisplay::doPaint() {
         p2.drawText((this->width()/2.0) - (textwidth/2.0),this->height()/4.0,preArmCheckMessage);
     }
     p2.end();
+
+    m_paintedValues = displayedValues();
+    m_repaintRequired = false;
 }
 void PrimaryFlightDisplay::preArmMessageTimeout()
 {
     preArmMessageTimer->stop();
     preArmCheckFailure = false;
+    m_repaintRequired = true;
 
 }
 
@@ -3,6 +3,10 @@
 
 #include <QWidget>
 #include <QPen>
+#include <QPixmap>
+#include <QStaticText>
+#include <QHash>
+#include <QPair>
 #include "UASInterface.h"
 
 class PrimaryFlightDisplay : public QWidget
@@ -65,6 +69,10 @@ protected:
 signals:
     void visibilityChanged(bool visible);
 
+private slots:
+    /** @brief Repaint if a displayed value changed since the last paint */
+    void refreshIfChanged();
+
 private:
     /*
     enum AltimeterMode {
@@ -96,10 +104,12 @@ private:
     void drawTextCenterTop(QPainter& painter, QString text, float fontSize, float x, float y);
     void drawAIGlobalFeatures(QPainter& painter, QRectF mainArea, QRectF paintArea);
     void drawAIAirframeFixedFeatures(QPainter& painter, QRectF area);
+    void renderAIAirframeFixedFeatures(QPainter& painter, QRectF area);
     void drawPitchScale(QPainter& painter, QRectF area, float intrusion, bool drawNumbersLeft, bool drawNumbersRight);
     void drawRollScale(QPainter& painter, QRectF area, bool drawTicks, bool drawNumbers);
     void drawAIAttitudeScales(QPainter& painter, QRectF area, float intrusion);
     void drawAICompassDisk(QPainter& painter, QRectF area, float halfspan);
+    void renderCompassDiskScale(QPainter& painter, QRectF area, bool drawLabels);
     void drawSeparateCompassDisk(QPainter& painter, QRectF area);
 
     void drawAltimeter(QPainter& painter, QRectF area, float altitudeRelative, float altitudeAMSL, float vv);
@@ -117,6 +127,34 @@ private:
 
     void doPaint();
 
+    /*
+     * Layer cache. The parts of the instruments which only move as a whole
+     * (roll scale, compass disk, airframe symbol) are rendered once per size
+     * into a pixmap and blitted with the actual transformation.
+     */
+    QPixmap createLayer(const QSizeF& size) const;
+    const QPixmap& rollScaleLayer(QRectF area);
+    const QPixmap& compassDiskLayer(QRectF area, bool drawLabels);
+    const QPixmap& airframeLayer(QRectF area);
+    void invalidateLayers();
+    /** @brief Get the cached layout of a text for the current font */
+    const QStaticText& staticText(const QString& text);
+
+    /** @brief The values shown by the display, used to detect changes */
+    struct DisplayedValues {
+        float roll;
+        float pitch;
+        float heading;
+        float altitudeRelative;
+        float altitudeAMSL;
+        float groundspeed;
+        float airspeed;
+        float climbRate;
+        float crosstrackError;
+        float targetBearing;
+    };
+    DisplayedValues displayedValues() const;
+
     UASInterface* uas;          ///< The uas currently monitored
 
     /*
@@ -177,10 +215,20 @@ private:
 
     QTimer* refreshTimer;       ///< The main timer, controls the update rate
 
+    QPixmap m_rollScaleLayer;           ///< Roll scale centered in the pixmap
+    QPixmap m_compassDiskLayer;         ///< Compass disk for heading 0 centered in the pixmap
+    bool m_compassDiskLayerLabels;      ///< Compass disk layer was rendered with labels
+    QPixmap m_airframeLayer;            ///< Airframe symbol centered in the pixmap
+    QHash<QPair<int, QString>, QStaticText> m_staticTexts;  ///< Text layouts by pixel size and text
+
+    DisplayedValues m_paintedValues;    ///< Values at the last paint
+    bool m_repaintRequired;             ///< Repaint even if no value changed (layout, messages)
+
     static const int tickValues[];
     static const QString compassWindNames[];
 
     static const int updateInterval = 250;
+    static const int maxStaticTexts = 512;  ///< Limit of cached text layouts
 };
 
 #endif // PRIMARYFLIGHTDISPLAY_H
@@ -1,10 +1,31 @@
 #include <QList>
+#include <QFile>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QTextStream>
+#include <QDateTime>
 
 #include "QGCMAVLinkInspector.h"
 #include "UASManager.h"
 #include "LinkManager.h"
 #include "ui_QGCMAVLinkInspector.h"
 
+constexpr int QGCMAVLinkInspector::s_ProfileWindowsSec[3];
+
+QGCMAVLinkInspector::ProfileRow::ProfileRow() :
+    m_type(Link),
+    m_linkId(0),
+    m_sysId(0),
+    m_compId(0),
+    m_msgId(0),
+    m_messageRate{0.0, 0.0, 0.0},
+    m_byteRate{0.0, 0.0, 0.0},
+    m_messages(0),
+    m_bytes(0),
+    m_lost(0),
+    m_outOfOrder(0),
+    m_parseErrors(0)
+{}
 
 QGCMAVLinkInspector::QGCMAVLinkInspector(QWidget *parent) :
     QWidget(parent),
@@ -42,6 +63,21 @@ QGCMAVLinkInspector::QGCMAVLinkInspector(QWidget *parent) :
     mp_Ui->rateTreeWidget->setHeaderLabels(rateHeader);
     mp_Ui->rateTreeWidget->hide();
 
+    // Set up the column headers for the link profile
+    QStringList profileHeader;
+    profileHeader << tr("Link / Component / Message");
+    for (int window : s_ProfileWindowsSec)
+    {
+        profileHeader << tr("msg/s (%1s)").arg(window);
+    }
+    for (int window : s_ProfileWindowsSec)
+    {
+        profileHeader << tr("B/s (%1s)").arg(window);
+    }
+    profileHeader << tr("Messages") << tr("Lost") << tr("Parse errors");
+    mp_Ui->profileTreeWidget->setHeaderLabels(profileHeader);
+    profileBaseline.m_timeUsecs = 0;
+
 //    connect(mp_Ui->refreshButton, &QPushButton::clicked, this, &ApmCustomFirmwareConfig::FillDeviceList);
 //    connect(mp_px4Updater.data(), QOverload<QString>::of(&PX4FirmwareUploader::statusUpdate), this, &ApmCustomFirmwareConfig::statusUpdate);
     //connect(mp_Ui->rateTreeWidget, QOverload<QTreeWidgetItem*, int>::of(&QTreeWidgetItem::itemChanged), this, &QGCMAVLinkInspector::rateTreeItemChanged);
@@ -51,6 +87,7 @@ QGCMAVLinkInspector::QGCMAVLinkInspector(QWidget *parent) :
     connect(mp_Ui->systemComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &QGCMAVLinkInspector::selectDropDownMenuSystem);
     connect(mp_Ui->componentComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this,  &QGCMAVLinkInspector::selectDropDownMenuComponent);
     connect(mp_Ui->clearButton, &QPushButton::clicked, this, &QGCMAVLinkInspector::clearView);
+    connect(mp_Ui->exportButton, &QPushButton::clicked, this, &QGCMAVLinkInspector::exportProfile);
 
     // Connect external connections
     connect(UASManager::instance(), QOverload<UASInterface*>::of(&UASManager::UASCreated), this, &QGCMAVLinkInspector::addSystem);
@@ -180,39 +217,22 @@ void QGCMAVLinkInspector::clearView()
         iteTree.value() = NULL;
     }
     uasTreeWidgetItems.clear();
-    
-    QMultiMap<int, QMap<int, float>* >::iterator iteHz;
-    for (iteHz=uasMessageHz.begin(); iteHz!=uasMessageHz.end();++iteHz)
-    {
 
-        iteHz.value()->clear();
-        delete iteHz.value();
-        iteHz.value() = NULL;
-    }
-    uasMessageHz.clear();
-
-    QMultiMap<int, QMap<int, unsigned int>* >::iterator iteCount;
-    for(iteCount=uasMessageCount.begin(); iteCount!=uasMessageCount.end();++iteCount)
-    {
-        iteCount.value()->clear();
-        delete iteCount.value();
-        iteCount.value() = NULL;
-    }
-    uasMessageCount.clear();
+    onboardMessageInterval.clear();
 
-    QMultiMap<int, QMap<int, quint64>* >::iterator iteLast;
-    for(iteLast=uasLastMessageUpdate.begin(); iteLast!=uasLastMessageUpdate.end();++iteLast)
+    // The profiler counters are never reset, the totals are shown relative to the baseline
+    MAVLinkProtocol *protocol = LinkManager::instance()->getProtocol();
+    if (protocol)
     {
-        iteLast.value()->clear();
-        delete iteLast.value();
-        iteLast.value() = NULL;
+        profileBaseline = toProfileSample(protocol->getProfiler().snapshot());
     }
-    uasLastMessageUpdate.clear();
-
-    onboardMessageInterval.clear();
+    profileHistory.clear();
+    messageRates.clear();
+    profileTreeItems.clear();
 
     mp_Ui->treeWidget->clear();
     mp_Ui->rateTreeWidget->clear();
+    mp_Ui->profileTreeWidget->clear();
 
 }
 
@@ -227,6 +247,8 @@ void QGCMAVLinkInspector::refreshView()
         mp_Ui->msg_lost->setText(message);
     }
 
+    updateProfile();
+
     QMultiMap<int, mavlink_message_t* >::const_iterator ite;
 
     for(ite=uasMessageStorage.constBegin(); ite!=uasMessageStorage.constEnd();++ite)
@@ -236,44 +258,8 @@ void QGCMAVLinkInspector::refreshView()
         // Ignore NULL values
         if (msg->msgid == 0xFF) continue;
 
-        // Update the message frenquency
-
-        // Get the previous frequency for low-pass filtering
-        float msgHz = 0.0f;
-        QMultiMap<int, QMap<int, float>* >::const_iterator iteHz = uasMessageHz.find(msg->sysid);
-        QMap<int, float>* uasMsgHz = iteHz.value();
-
-        while((iteHz != uasMessageHz.end()) && (iteHz.key() == msg->sysid))
-        {
-            if(iteHz.value()->contains(msg->msgid))
-            {
-                uasMsgHz = iteHz.value();
-                msgHz = iteHz.value()->value(msg->msgid);
-                break;
-            }
-            ++iteHz;
-        }
-
-        // Get the number of message received
-        float msgCount = 0;
-        QMultiMap<int, QMap<int, unsigned int> * >::const_iterator iter = uasMessageCount.find(msg->sysid);
-        QMap<int, unsigned int>* uasMsgCount = iter.value();
-
-        while((iter != uasMessageCount.end()) && (iter.key()==msg->sysid))
-        {
-            if(iter.value()->contains(msg->msgid))
-            {
-                msgCount = (float) iter.value()->value(msg->msgid);
-                uasMsgCount = iter.value();
-                break;
-            }
-            ++iter;
-        }
-
-        // Compute the new low-pass filtered frequency and update the message count
-        msgHz = (1.0f-updateHzLowpass)* msgHz + updateHzLowpass*msgCount/((float)updateInterval/1000.0f);
-        uasMsgHz->insert(msg->msgid,msgHz);
-        uasMsgCount->insert(msg->msgid,(unsigned int) 0);
+        // The message frequency is measured by the profiler
+        const double msgHz = messageRates.value(qMakePair(static_cast<int>(msg->sysid), static_cast<quint32>(msg->msgid)));
 
         // Update the tree view
         QString messageName("%1 (%2 Hz, #%3)");
@@ -384,12 +370,290 @@ void QGCMAVLinkInspector::addUAStoTree(int sysId)
     }
 }
 
+QGCMAVLinkInspector::ProfileSample QGCMAVLinkInspector::toProfileSample(const MAVLinkProfiler::Snapshot &snapshot)
+{
+    ProfileSample sample;
+    sample.m_timeUsecs = snapshot.m_timeUsecs;
+    for (const auto &counters : snapshot.m_messages)
+    {
+        sample.m_messages.insert(MAVLinkProfiler::messageKey(counters.m_linkId, counters.m_sysId, counters.m_compId, counters.m_msgId), counters);
+    }
+    for (const auto &counters : snapshot.m_components)
+    {
+        sample.m_components.insert(MAVLinkProfiler::componentKey(counters.m_linkId, counters.m_sysId, counters.m_compId), counters);
+    }
+    for (const auto &counters : snapshot.m_links)
+    {
+        sample.m_links.insert(counters.m_linkId, counters);
+    }
+    return sample;
+}
+
+void QGCMAVLinkInspector::updateProfile()
+{
+    MAVLinkProtocol *protocol = LinkManager::instance()->getProtocol();
+    if (!protocol)
+    {
+        return;
+    }
+
+    // Keep enough samples for the longest window
+    profileHistory.append(toProfileSample(protocol->getProfiler().snapshot()));
+    const int maxSamples = s_ProfileWindowsSec[2] * 1000 / static_cast<int>(updateInterval) + 1;
+    while (profileHistory.size() > maxSamples)
+    {
+        profileHistory.removeFirst();
+    }
+
+    const QList<ProfileRow> rows = buildProfileRows();
+
+    messageRates.clear();
+    for (const auto &row : rows)
+    {
+        const QString parentPath = row.m_path.left(row.m_path.lastIndexOf('/'));
+        QTreeWidgetItem *item = profileTreeItem(row.m_path, row.m_type == ProfileRow::Link ? nullptr : profileTreeItems.value(parentPath), row.m_name);
+
+        for (int window = 0; window < 3; ++window)
+        {
+            item->setData(1 + window, Qt::DisplayRole, QString::number(row.m_messageRate[window], 'f', 1));
+            item->setData(4 + window, Qt::DisplayRole, QString::number(row.m_byteRate[window], 'f', 0));
+        }
+        item->setData(7, Qt::DisplayRole, row.m_messages);
+
+        if (row.m_type == ProfileRow::Message)
+        {
+            messageRates[qMakePair(row.m_sysId, row.m_msgId)] += row.m_messageRate[1];
+        }
+        else
+        {
+            const quint64 expected = row.m_messages + row.m_lost;
+            const double lossPercent = expected > 0 ? 100.0 * static_cast<double>(row.m_lost) / static_cast<double>(expected) : 0.0;
+            item->setData(8, Qt::DisplayRole, QString("%1 (%2%)").arg(row.m_lost).arg(lossPercent, 0, 'f', 1));
+        }
+        if (row.m_type == ProfileRow::Link)
+        {
+            item->setData(9, Qt::DisplayRole, row.m_parseErrors);
+        }
+    }
+}
+
+QList<QGCMAVLinkInspector::ProfileRow> QGCMAVLinkInspector::buildProfileRows() const
+{
+    if (profileHistory.isEmpty())
+    {
+        return QList<ProfileRow>();
+    }
+
+    // Start sample and duration of each window. Short history shortens the windows.
+    const ProfileSample &current = profileHistory.last();
+    const ProfileSample *windowStart[3];
+    double windowSeconds[3];
+    for (int window = 0; window < 3; ++window)
+    {
+        const int index = qMax(0, profileHistory.size() - 1 - s_ProfileWindowsSec[window] * 1000 / static_cast<int>(updateInterval));
+        windowStart[window] = &profileHistory.at(index);
+        windowSeconds[window] = static_cast<double>(current.m_timeUsecs - windowStart[window]->m_timeUsecs) / 1000000.0;
+    }
+    auto rate = [](quint64 now, quint64 before, double seconds)
+    {
+        return (seconds > 0.0 && now >= before) ? static_cast<double>(now - before) / seconds : 0.0;
+    };
+
+    // Zero padded ids make the path order the display order
+    auto linkPath = [](int linkId)
+    {
+        return QString("L%1").arg(linkId, 5, 10, QChar('0'));
+    };
+    auto componentPath = [&linkPath](int linkId, int sysId, int compId)
+    {
+        return linkPath(linkId) + QString("/C%1.%2").arg(sysId, 3, 10, QChar('0')).arg(compId, 3, 10, QChar('0'));
+    };
+
+    QMap<QString, ProfileRow> rowMap;
+    auto findRow = [&rowMap](const QString &path, ProfileRow::Type type, int linkId, int sysId, int compId) -> ProfileRow&
+    {
+        QMap<QString, ProfileRow>::iterator iter = rowMap.find(path);
+        if (iter == rowMap.end())
+        {
+            ProfileRow row;
+            row.m_type = type;
+            row.m_path = path;
+            row.m_linkId = linkId;
+            row.m_sysId = sysId;
+            row.m_compId = compId;
+            iter = rowMap.insert(path, row);
+        }
+        return iter.value();
+    };
+
+    for (const auto &counters : current.m_messages)
+    {
+        const quint64 key = MAVLinkProfiler::messageKey(counters.m_linkId, counters.m_sysId, counters.m_compId, counters.m_msgId);
+        const QString parentPath = componentPath(counters.m_linkId, counters.m_sysId, counters.m_compId);
+        ProfileRow &row = findRow(parentPath + QString("/M%1").arg(counters.m_msgId, 8, 10, QChar('0')),
+                                  ProfileRow::Message, counters.m_linkId, counters.m_sysId, counters.m_compId);
+        row.m_msgId = counters.m_msgId;
+        row.m_name = QString("%1 (#%2)").arg(messageName(counters.m_msgId)).arg(counters.m_msgId);
+
+        // Entries which did not exist at the start of a window started with zero
+        for (int window = 0; window < 3; ++window)
+        {
+            const auto before = windowStart[window]->m_messages.constFind(key);
+            const bool found = before != windowStart[window]->m_messages.constEnd();
+            row.m_messageRate[window] = rate(counters.m_messages, found ? before->m_messages : 0, windowSeconds[window]);
+            row.m_byteRate[window] = rate(counters.m_bytes, found ? before->m_bytes : 0, windowSeconds[window]);
+        }
+        const auto base = profileBaseline.m_messages.constFind(key);
+        const bool hasBase = base != profileBaseline.m_messages.constEnd();
+        row.m_messages = counters.m_messages - (hasBase ? base->m_messages : 0);
+        row.m_bytes = counters.m_bytes - (hasBase ? base->m_bytes : 0);
+
+        // The component is the sum of its messages
+        ProfileRow &component = findRow(parentPath, ProfileRow::Component, counters.m_linkId, counters.m_sysId, counters.m_compId);
+        for (int window = 0; window < 3; ++window)
+        {
+            component.m_messageRate[window] += row.m_messageRate[window];
+            component.m_byteRate[window] += row.m_byteRate[window];
+        }
+        component.m_messages += row.m_messages;
+        component.m_bytes += row.m_bytes;
+    }
+
+    for (const auto &counters : current.m_components)
+    {
+        const quint64 key = MAVLinkProfiler::componentKey(counters.m_linkId, counters.m_sysId, counters.m_compId);
+        ProfileRow &row = findRow(componentPath(counters.m_linkId, counters.m_sysId, counters.m_compId),
+                                  ProfileRow::Component, counters.m_linkId, counters.m_sysId, counters.m_compId);
+        row.m_name = tr("System %1 / Component %2").arg(counters.m_sysId).arg(counters.m_compId);
+        const auto base = profileBaseline.m_components.constFind(key);
+        const bool hasBase = base != profileBaseline.m_components.constEnd();
+        row.m_lost = counters.m_lost - (hasBase ? base->m_lost : 0);
+        row.m_outOfOrder = counters.m_outOfOrder - (hasBase ? base->m_outOfOrder : 0);
+
+        ProfileRow &link = findRow(linkPath(counters.m_linkId), ProfileRow::Link, counters.m_linkId, 0, 0);
+        link.m_lost += row.m_lost;
+        link.m_outOfOrder += row.m_outOfOrder;
+    }
+
+    for (const auto &counters : current.m_links)
+    {
+        ProfileRow &row = findRow(linkPath(counters.m_linkId), ProfileRow::Link, counters.m_linkId, 0, 0);
+        const QString linkName = LinkManager::instance()->getLinkShortName(counters.m_linkId);
+        row.m_name = QString("%1 (#%2)").arg(linkName.isEmpty() ? tr("Link") : linkName).arg(counters.m_linkId);
+
+        // Bytes of the link include everything read, not only valid frames
+        for (int window = 0; window < 3; ++window)
+        {
+            const auto before = windowStart[window]->m_links.constFind(counters.m_linkId);
+            const bool found = before != windowStart[window]->m_links.constEnd();
+            row.m_messageRate[window] = rate(counters.m_messages, found ? before->m_messages : 0, windowSeconds[window]);
+            row.m_byteRate[window] = rate(counters.m_bytes, found ? before->m_bytes : 0, windowSeconds[window]);
+        }
+        const auto base = profileBaseline.m_links.constFind(counters.m_linkId);
+        const bool hasBase = base != profileBaseline.m_links.constEnd();
+        row.m_messages = counters.m_messages - (hasBase ? base->m_messages : 0);
+        row.m_bytes = counters.m_bytes - (hasBase ? base->m_bytes : 0);
+        row.m_parseErrors = counters.m_parseErrors - (hasBase ? base->m_parseErrors : 0);
+    }
+
+    return rowMap.values();
+}
+
+QTreeWidgetItem* QGCMAVLinkInspector::profileTreeItem(const QString& path, QTreeWidgetItem* parent, const QString& name)
+{
+    QTreeWidgetItem *item = profileTreeItems.value(path);
+    if (!item)
+    {
+        item = new QTreeWidgetItem();
+        if (parent)
+        {
+            parent->addChild(item);
+        }
+        else
+        {
+            mp_Ui->profileTreeWidget->addTopLevelItem(item);
+        }
+        profileTreeItems.insert(path, item);
+    }
+    item->setData(0, Qt::DisplayRole, name);
+    return item;
+}
+
+QString QGCMAVLinkInspector::messageName(quint32 msgid) const
+{
+    const auto info = messageInfo.constFind(msgid);
+    return info != messageInfo.constEnd() ? QString(info->name) : tr("UNKNOWN");
+}
+
+void QGCMAVLinkInspector::exportProfile()
+{
+    const QList<ProfileRow> rows = buildProfileRows();
+    if (rows.isEmpty())
+    {
+        QMessageBox::information(this, tr("Export link profile"), tr("No traffic has been profiled yet."));
+        return;
+    }
+
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Export link profile"),
+                                                    QGC::logDirectory() + "/linkprofile_" + QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss") + ".csv",
+                                                    tr("CSV (*.csv)"));
+    if (fileName.isEmpty())
+    {
+        return;
+    }
+    if (!fileName.endsWith(".csv", Qt::CaseInsensitive))
+    {
+        fileName.append(".csv");
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        QMessageBox::warning(this, tr("Export link profile"), tr("Could not open %1 for writing: %2").arg(fileName).arg(file.errorString()));
+        return;
+    }
+
+    static const char *typeNames[] = { "link", "component", "message" };
+    const quint64 timeUsecs = profileHistory.last().m_timeUsecs;
+
+    QTextStream out(&file);
+    out << "time_usecs,type,link,sysid,compid,msgid,name";
+    for (int window : s_ProfileWindowsSec)
+    {
+        out << ",msg_per_s_" << window << "s";
+    }
+    for (int window : s_ProfileWindowsSec)
+    {
+        out << ",bytes_per_s_" << window << "s";
+    }
+    out << ",messages,bytes,lost,out_of_order,parse_errors\n";
+
+    for (const auto &row : rows)
+    {
+        QString name = row.m_name;
+        name.replace('"', "\"\"");
+        out << timeUsecs << ',' << typeNames[row.m_type] << ',' << row.m_linkId << ','
+            << row.m_sysId << ',' << row.m_compId << ',' << row.m_msgId << ",\"" << name << '"';
+        for (double messageRate : row.m_messageRate)
+        {
+            out << ',' << QString::number(messageRate, 'f', 3);
+        }
+        for (double byteRate : row.m_byteRate)
+        {
+            out << ',' << QString::number(byteRate, 'f', 1);
+        }
+        out << ',' << row.m_messages << ',' << row.m_bytes << ',' << row.m_lost << ','
+            << row.m_outOfOrder << ',' << row.m_parseErrors << '\n';
+    }
+    out.flush();
+    file.close();
+    QLOG_INFO() << "Exported link profile to" << fileName;
+}
+
 void QGCMAVLinkInspector::receiveMessage(LinkInterface* link,mavlink_message_t message)
 {
     Q_UNUSED(link);
 
-    quint64 receiveTime;
-    
     if (selectedSystemID != 0 && selectedSystemID != message.sysid) return;
     if (selectedComponentID != 0 && selectedComponentID != message.compid) return;
 
@@ -425,70 +689,6 @@ void QGCMAVLinkInspector::receiveMessage(LinkInterface* link,mavlink_message_t m
         *uasMessage = message;
     }
 
-    // Looking if this message has already been received once
-    msgFound = false;
-    QMultiMap<int, QMap<int, quint64>* >::const_iterator ite = uasLastMessageUpdate.find(message.sysid);
-    QMap<int, quint64>* lastMsgUpdate = ite.value();
-    while((ite != uasLastMessageUpdate.end()) && (ite.key() == message.sysid))
-    {   
-        if(ite.value()->contains(message.msgid))
-        {
-            msgFound = true;
-
-            // Point to the found message
-            lastMsgUpdate = ite.value();
-            break;
-        }
-        ++ite;
-    }
-
-    receiveTime = QGC::groundTimeMilliseconds();
-
-    // If the message doesn't exist, create a map for the frequency, message count and time of reception
-    if(!msgFound)
-    {
-        // Create a map for the message frequency
-        QMap<int, float>* messageHz = new QMap<int,float>;
-        messageHz->insert(message.msgid,0.0f);
-        uasMessageHz.insert(message.sysid,messageHz);
-
-        // Create a map for the message count
-        QMap<int, unsigned int>* messagesCount = new QMap<int, unsigned int>;
-        messagesCount->insert(message.msgid,0);
-        uasMessageCount.insert(message.sysid,messagesCount);
-
-        // Create a map for the time of reception of the message
-        QMap<int, quint64>* lastMessage = new QMap<int, quint64>;
-        lastMessage->insert(message.msgid,receiveTime);
-        uasLastMessageUpdate.insert(message.sysid,lastMessage);
-
-        // Point to the created message
-        lastMsgUpdate = lastMessage;
-    }
-    else
-    {
-        // The message has been found/created
-        if ((lastMsgUpdate->contains(message.msgid))&&(uasMessageCount.contains(message.sysid)))
-        {
-            // Looking for and updating the message count
-            unsigned int count = 0;
-            QMultiMap<int, QMap<int, unsigned int>* >::const_iterator iter = uasMessageCount.find(message.sysid);
-            QMap<int, unsigned int> * uasMsgCount = iter.value();
-            while((iter != uasMessageCount.end()) && (iter.key() == message.sysid))
-            {
-                if(iter.value()->contains(message.msgid))
-                {
-                    uasMsgCount = iter.value();
-                    count = uasMsgCount->value(message.msgid,0);
-                    uasMsgCount->insert(message.msgid,count+1);
-                    break;
-                }
-                ++iter;
-            }
-        }
-        lastMsgUpdate->insert(message.msgid,receiveTime);
-    }
-
     if (selectedSystemID == 0 || selectedComponentID == 0)
     {
         return;
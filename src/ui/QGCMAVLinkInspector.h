@@ -5,8 +5,11 @@
 #include <QTreeWidget>
 #include <QMap>
 #include <QTimer>
+#include <QHash>
+#include <QList>
 
 #include "MAVLinkProtocol.h"
+#include "MAVLinkProfiler.h"
 
 namespace Ui {
     class QGCMAVLinkInspector;
@@ -39,6 +42,8 @@ public slots:
     void selectDropDownMenuComponent(int dropdownid);
 
     void rateTreeItemChanged(QTreeWidgetItem* paramItem, int column);
+    /** @brief Export the actual link profile as CSV file */
+    void exportProfile();
 
 private:
     MAVLinkProtocol *_protocol {nullptr};     ///< MAVLink instance
@@ -75,10 +80,47 @@ private:
 
     QMultiMap<int, mavlink_message_t* > uasMessageStorage; ///< Stores the messages for every UAS
 
-    QMultiMap<int, QMap<int, float>* > uasMessageHz; ///< Stores the frequency of each message of each UAS
-    QMultiMap<int, QMap<int, unsigned int>* > uasMessageCount; ///< Stores the message count of each message of each UAS
-
-    QMultiMap<int, QMap<int, quint64>* > uasLastMessageUpdate; ///< Stores the time of the last message for each message of each UAS
+    /**
+     * @brief The ProfileSample struct holds the profiler counters of one refresh, keyed
+     *        for fast lookup when computing the rates of the sliding windows.
+     */
+    struct ProfileSample
+    {
+        quint64 m_timeUsecs;
+        QHash<quint64, MAVLinkProfiler::MessageCounters> m_messages;       ///< By link/sysid/compid/msgid
+        QHash<quint64, MAVLinkProfiler::ComponentCounters> m_components;   ///< By link/sysid/compid
+        QHash<int, MAVLinkProfiler::LinkCounters> m_links;                 ///< By link id
+    };
+
+    /**
+     * @brief The ProfileRow struct is one row of the profile (tree row and CSV line)
+     */
+    struct ProfileRow
+    {
+        enum Type { Link, Component, Message };
+
+        Type m_type;
+        QString m_path;             ///< Unique path of the row, the parent path is the part before the last '/'
+        int m_linkId;
+        int m_sysId;
+        int m_compId;
+        quint32 m_msgId;
+        QString m_name;
+        double m_messageRate[3];    ///< Messages per second for each window
+        double m_byteRate[3];       ///< Bytes per second for each window
+        quint64 m_messages;         ///< Messages since the last clear
+        quint64 m_bytes;            ///< Bytes since the last clear
+        quint64 m_lost;             ///< Messages lost since the last clear
+        quint64 m_outOfOrder;       ///< Messages out of order since the last clear
+        quint64 m_parseErrors;      ///< Parse errors since the last clear
+
+        ProfileRow();
+    };
+
+    QList<ProfileSample> profileHistory;    ///< Profiler samples of the last s_ProfileWindowsSec[2] seconds, newest last
+    ProfileSample profileBaseline;          ///< Counters at the last clear, totals are shown relative to it
+    QHash<QPair<int, quint32>, double> messageRates; ///< Message rate (medium window) of each sysid/msgid
+    QHash<QString, QTreeWidgetItem*> profileTreeItems; ///< Items of the profile tree by path
 
     /* @brief Update one message field */
     void updateField(int sysid, int msgid, int fieldid, QTreeWidgetItem* item);
@@ -88,9 +130,19 @@ private:
     void changeStreamInterval(int msgid, int interval);
     /* @brief Create a new tree for a new UAS */
     void addUAStoTree(int sysId);
+    /** @brief Take a new profiler sample and update the profile tree */
+    void updateProfile();
+    /** @brief Convert a profiler snapshot into a sample */
+    static ProfileSample toProfileSample(const MAVLinkProfiler::Snapshot &snapshot);
+    /** @brief Build the profile rows (links, their components and messages) from the sample history */
+    QList<ProfileRow> buildProfileRows() const;
+    /** @brief Find or create an item of the profile tree */
+    QTreeWidgetItem* profileTreeItem(const QString& path, QTreeWidgetItem* parent, const QString& name);
+    /** @brief Name of a message id */
+    QString messageName(quint32 msgid) const;
 
     static constexpr unsigned int updateInterval {1000}; ///< The update interval of the refresh function
-    static constexpr float updateHzLowpass {0.2f}; ///< The low-pass filter value for the frequency of each message
+    static constexpr int s_ProfileWindowsSec[3] {1, 10, 60}; ///< Sliding windows of the profiler rates
 
 
     Ui::QGCMAVLinkInspector *mp_Ui;
@@ -0,0 +1,136 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file WaypointItemDelegate.cc
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the editor delegate of the mission table
+ */
+
+#include "WaypointItemDelegate.h"
+#include "WaypointListModel.h"
+
+#include <QComboBox>
+#include <QDoubleSpinBox>
+
+WaypointItemDelegate::WaypointItemDelegate(QObject *parent) :
+    QStyledItemDelegate(parent)
+{}
+
+QWidget *WaypointItemDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+                                            const QModelIndex &index) const
+{
+    typedef QPair<QString, int> Entry;
+    const int column = index.column();
+
+    if (column == WaypointListModel::ColumnCommand || column == WaypointListModel::ColumnFrame)
+    {
+        QComboBox *comboBox = new QComboBox(parent);
+        const QList<Entry> entries = column == WaypointListModel::ColumnCommand ? WaypointListModel::commands()
+                                                                                 : WaypointListModel::frames();
+        foreach (const Entry &entry, entries)
+        {
+            if (entry.first.isEmpty())
+            {
+                comboBox->insertSeparator(comboBox->count());
+            }
+            else
+            {
+                comboBox->addItem(entry.first, entry.second);
+            }
+        }
+        // Keep commands and frames we have no entry for selectable
+        const int value = index.data(Qt::EditRole).toInt();
+        if (comboBox->findData(value) < 0)
+        {
+            comboBox->addItem(index.data(Qt::DisplayRole).toString(), value);
+        }
+        connect(comboBox, SIGNAL(activated(int)), this, SLOT(commitAndClose()));
+        return comboBox;
+    }
+
+    if (column >= WaypointListModel::ColumnParam1 && column <= WaypointListModel::ColumnAltitude)
+    {
+        const WaypointListModel::ParamInfo info =
+                WaypointListModel::paramInfo(index.data(WaypointListModel::CommandRole).toInt(),
+                                             index.data(WaypointListModel::FrameRole).toInt(), column);
+        QDoubleSpinBox *spinBox = new QDoubleSpinBox(parent);
+        spinBox->setDecimals(info.m_decimals);
+        spinBox->setRange(info.m_min, info.m_max);
+        spinBox->setToolTip(info.m_label);
+        spinBox->setFrame(false);
+        spinBox->setAlignment(Qt::AlignRight);
+        return spinBox;
+    }
+
+    return QStyledItemDelegate::createEditor(parent, option, index);
+}
+
+void WaypointItemDelegate::setEditorData(QWidget *editor, const QModelIndex &index) const
+{
+    if (QComboBox *comboBox = qobject_cast<QComboBox *>(editor))
+    {
+        comboBox->setCurrentIndex(comboBox->findData(index.data(Qt::EditRole).toInt()));
+        return;
+    }
+    if (QDoubleSpinBox *spinBox = qobject_cast<QDoubleSpinBox *>(editor))
+    {
+        spinBox->setValue(index.data(Qt::EditRole).toDouble());
+        return;
+    }
+    QStyledItemDelegate::setEditorData(editor, index);
+}
+
+void WaypointItemDelegate::setModelData(QWidget *editor, QAbstractItemModel *model, const QModelIndex &index) const
+{
+    if (QComboBox *comboBox = qobject_cast<QComboBox *>(editor))
+    {
+        const QVariant value = comboBox->currentData();
+        if (value.isValid() && value != index.data(Qt::EditRole))
+        {
+            model->setData(index, value, Qt::EditRole);
+        }
+        return;
+    }
+    if (QDoubleSpinBox *spinBox = qobject_cast<QDoubleSpinBox *>(editor))
+    {
+        spinBox->interpretText();
+        // Only write real changes, every write is a change of the mission. The
+        // stored value can have more decimals than the spin box shows.
+        const QString oldValue = QString::number(index.data(Qt::EditRole).toDouble(), 'f', spinBox->decimals());
+        if (QString::number(spinBox->value(), 'f', spinBox->decimals()) != oldValue)
+        {
+            model->setData(index, spinBox->value(), Qt::EditRole);
+        }
+        return;
+    }
+    QStyledItemDelegate::setModelData(editor, model, index);
+}
+
+void WaypointItemDelegate::commitAndClose()
+{
+    QWidget *editor = qobject_cast<QWidget *>(sender());
+    if (editor)
+    {
+        emit commitData(editor);
+        emit closeEditor(editor);
+    }
+}
@@ -0,0 +1,53 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file WaypointItemDelegate.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the editor delegate of the mission table
+ */
+
+#ifndef WAYPOINTITEMDELEGATE_H
+#define WAYPOINTITEMDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+/**
+ * @brief The WaypointItemDelegate class creates the editors of a
+ *        WaypointListModel cell. The command and frame are picked from a
+ *        combo box, the parameters get a spin box with the range and
+ *        decimals of the parameter for the command of the row.
+ */
+class WaypointItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+public:
+    explicit WaypointItemDelegate(QObject *parent = NULL);
+
+    QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const;
+    void setEditorData(QWidget *editor, const QModelIndex &index) const;
+    void setModelData(QWidget *editor, QAbstractItemModel *model, const QModelIndex &index) const;
+
+private slots:
+    void commitAndClose();
+};
+
+#endif // WAYPOINTITEMDELEGATE_H
@@ -33,6 +33,8 @@ This file is part of the PIXHAWK project
 
 #include "WaypointList.h"
 #include "ui_WaypointList.h"
+#include "WaypointListModel.h"
+#include "WaypointItemDelegate.h"
 #include <UASInterface.h>
 #include <UAS.h>
 #include <UASManager.h>
@@ -40,10 +42,18 @@ This file is part of the PIXHAWK project
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QMouseEvent>
+#include <QTableView>
+#include <QHeaderView>
+#include <QMenu>
 #include "LinkManager.h"
 
+#include <algorithm>
+#include <functional>
+
 WaypointList::WaypointList(QWidget *parent, UASWaypointManager* wpm) :
     QWidget(parent),
+    m_editableModel(new WaypointListModel(true, this)),
+    m_viewOnlyModel(new WaypointListModel(false, this)),
     m_uas(NULL),
     WPM(wpm),
     mavX(0.0),
@@ -58,11 +68,20 @@ WaypointList::WaypointList(QWidget *parent, UASWaypointManager* wpm) :
 
     //EDIT TAB
 
-    editableListLayout = new QVBoxLayout(m_ui->editableListWidget);
-    editableListLayout->setSpacing(0);
-    editableListLayout->setMargin(0);
-    editableListLayout->setAlignment(Qt::AlignTop);
-    m_ui->editableListWidget->setLayout(editableListLayout);
+    setupTableView(m_ui->editableTableView, m_editableModel);
+    connect(m_ui->editableTableView->selectionModel(), SIGNAL(currentRowChanged(QModelIndex,QModelIndex)),
+            this, SLOT(editableRowChanged(QModelIndex)));
+    m_ui->editableTableView->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(m_ui->editableTableView, SIGNAL(customContextMenuRequested(QPoint)),
+            this, SLOT(editableContextMenu(QPoint)));
+
+    // REMOVE SELECTED WAYPOINTS
+    QAction* removeAction = new QAction(tr("Remove"), m_ui->editableTableView);
+    removeAction->setShortcut(QKeySequence::Delete);
+    removeAction->setShortcutContext(Qt::WidgetShortcut);
+    connect(removeAction, SIGNAL(triggered()), this, SLOT(removeSelected()));
+    m_ui->editableTableView->addAction(removeAction);
+
     m_ui->wpRadiusSpinBox->setEnabled(false);
 
     // ADD WAYPOINT
@@ -90,11 +109,10 @@ WaypointList::WaypointList(QWidget *parent, UASWaypointManager* wpm) :
 
     //VIEW TAB
 
-    viewOnlyListLayout = new QVBoxLayout(m_ui->viewOnlyListWidget);
-    viewOnlyListLayout->setSpacing(0);
-    viewOnlyListLayout->setMargin(0);
-    viewOnlyListLayout->setAlignment(Qt::AlignTop);
-    m_ui->viewOnlyListWidget->setLayout(viewOnlyListLayout);
+    setupTableView(m_ui->viewOnlyTableView, m_viewOnlyModel);
+    m_ui->viewOnlyTableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    connect(m_ui->viewOnlyTableView->selectionModel(), SIGNAL(currentRowChanged(QModelIndex,QModelIndex)),
+            this, SLOT(viewOnlyRowChanged(QModelIndex)));
 
     // REFRESH VIEW TAB
 
@@ -111,7 +129,8 @@ WaypointList::WaypointList(QWidget *parent, UASWaypointManager* wpm) :
             m_ui->refreshButton->setEnabled(false);
             //FIXME: The whole "Onboard Waypoints"-tab should be hidden, instead of "refresh" button
             UnconnectedUASInfoWidget* inf = new UnconnectedUASInfoWidget(this);
-            viewOnlyListLayout->insertWidget(0, inf); //insert a "NO UAV" info into the Onboard Tab
+            m_ui->viewOnlyTableView->hide();
+            m_ui->gridLayout_3->addWidget(inf, 0, 0, 1, 4); //insert a "NO UAV" info into the Onboard Tab
             showOfflineWarning = true;
         } else {
             setUAS(static_cast<UASInterface*>(WPM->getUAS()));
@@ -125,6 +144,9 @@ WaypointList::WaypointList(QWidget *parent, UASWaypointManager* wpm) :
         connect(WPM, SIGNAL(waypointViewOnlyChanged(int,Waypoint*)), this, SLOT(updateWaypointViewOnly(int,Waypoint*)));
         connect(WPM, SIGNAL(currentWaypointChanged(quint16)),            this, SLOT(currentWaypointViewOnlyChanged(quint16)));
 
+        m_editableModel->setWaypointManager(WPM);
+        m_viewOnlyModel->setWaypointManager(WPM);
+
         m_ui->altSpinBox->setValue(WPM->getDefaultRelAltitude());
         connect(m_ui->altSpinBox, SIGNAL(valueChanged(double)), WPM, SLOT(setDefaultRelAltitude(double)));
 
@@ -204,6 +226,8 @@ void WaypointList::setUAS(UASInterface* uas)
     if (!uas)
         return;
     WPM = uas->getWaypointManager();
+    m_editableModel->setWaypointManager(WPM);
+    m_viewOnlyModel->setWaypointManager(WPM);
 
     connect(WPM, SIGNAL(updateStatusString(const QString &)),
             this, SLOT(updateStatusLabel(const QString &)));
@@ -440,129 +464,35 @@ void WaypointList::changeCurrentWaypoint(quint16 seq)
 // Request UASWaypointManager to set the new "current" and make sure all other waypoints are not "current"
 void WaypointList::currentWaypointEditableChanged(quint16 seq)
 {
+    // The models update their rows from the waypoint change signals
     WPM->setCurrentEditable(seq);
-    const QList<Waypoint *> &waypoints = WPM->getWaypointEditableList();
-
-    if (seq < waypoints.count())
-    {
-        for(int i = 0; i < waypoints.count(); i++)
-        {
-            QMap<Waypoint*, WaypointEditableView*>::ConstIterator iter = wpEditableViews.find(waypoints[i]);
-            if (iter != wpEditableViews.end())
-            {
-                WaypointEditableView* widget = iter.value();
-                if (widget)
-                {
-                    if (waypoints[i]->getId() == seq)
-                    {
-                        widget->setCurrent(true);
-                    }
-                    else
-                    {
-                        widget->setCurrent(false);
-                    }
-                }
-            }
-        }
-    }
 }
 
 
 // Update waypointViews to correctly indicate the new current waypoint
 void WaypointList::currentWaypointViewOnlyChanged(quint16 seq)
 {
-    // First update the edit list
+    // Update the edit list, the view list follows the waypoint manager itself
     currentWaypointEditableChanged(seq);
-
-    const QList<Waypoint *> &waypoints = WPM->getWaypointViewOnlyList();
-
-    if (seq < waypoints.count())
-    {
-        for(int i = 0; i < waypoints.count(); i++)
-        {
-            QMap<Waypoint*, WaypointViewOnlyView*>::ConstIterator iter = wpViewOnlyViews.find(waypoints[i]);
-            if (iter != wpViewOnlyViews.end())
-            {
-                WaypointViewOnlyView* widget = iter.value();
-                if (widget)
-                {
-                    if (waypoints[i]->getId() == seq)
-                    {
-                        widget->setCurrent(true);
-                    }
-                    else
-                    {
-                        widget->setCurrent(false);
-                    }
-                }
-            }
-        }
-    }
 }
 
 void WaypointList::updateWaypointEditable(int uas, Waypoint* wp)
 {
     Q_UNUSED(uas);
-    WaypointEditableView *wpv = wpEditableViews.value(wp);
-    wpv->updateValues();
+    Q_UNUSED(wp);
     m_ui->tabWidget->setCurrentIndex(0); // XXX magic number
 }
 
 void WaypointList::updateWaypointViewOnly(int uas, Waypoint* wp)
 {
     Q_UNUSED(uas);
-    WaypointViewOnlyView *wpv = wpViewOnlyViews.value(wp);
-    wpv->updateValues();
+    Q_UNUSED(wp);
     m_ui->tabWidget->setCurrentIndex(1); // XXX magic number
 }
 
 void WaypointList::waypointViewOnlyListChanged()
 {
-    // Prevent updates to prevent visual flicker
-    setUpdatesEnabled(false);
-    const QList<Waypoint *> &waypoints = WPM->getWaypointViewOnlyList();
-
-    if (!wpViewOnlyViews.empty()) {
-        QMapIterator<Waypoint*,WaypointViewOnlyView*> viewIt(wpViewOnlyViews);
-        viewIt.toFront();
-        while(viewIt.hasNext()) {
-            viewIt.next();
-            Waypoint *cur = viewIt.key();
-            int i;
-            for (i = 0; i < waypoints.count(); i++) {
-                if (waypoints[i] == cur) {
-                    break;
-                }
-            }
-            if (i == waypoints.count()) {
-                WaypointViewOnlyView* widget = wpViewOnlyViews.find(cur).value();
-                widget->hide();
-                viewOnlyListLayout->removeWidget(widget);
-                wpViewOnlyViews.remove(cur);
-            }
-        }
-    }
-
-    // then add/update the views for each waypoint in the list
-    for(int i = 0; i < waypoints.count(); i++) {
-        Waypoint *wp = waypoints[i];
-        if (!wpViewOnlyViews.contains(wp)) {
-            WaypointViewOnlyView* wpview = new WaypointViewOnlyView(wp, this);
-            wpViewOnlyViews.insert(wp, wpview);
-            connect(wpview, SIGNAL(changeCurrentWaypoint(quint16)), this, SLOT(changeCurrentWaypoint(quint16)));
-            viewOnlyListLayout->insertWidget(i, wpview);
-        }
-        WaypointViewOnlyView *wpv = wpViewOnlyViews.value(wp);
-
-        //check if ordering has changed
-        if(viewOnlyListLayout->itemAt(i)->widget() != wpv) {
-            viewOnlyListLayout->removeWidget(wpv);
-            viewOnlyListLayout->insertWidget(i, wpv);
-        }
-
-        wpv->updateValues();    // update the values of the ui elements in the view
-    }
-    setUpdatesEnabled(true);
+    // The rows are updated by the model
     loadFileGlobalWP = false;
 
     m_ui->tabWidget->setCurrentIndex(1);
@@ -571,57 +501,7 @@ void WaypointList::waypointViewOnlyListChanged()
 
 void WaypointList::waypointEditableListChanged()
 {
-    // Prevent updates to prevent visual flicker
-    setUpdatesEnabled(false);
-    const QList<Waypoint *> &waypoints = WPM->getWaypointEditableList();
-
-    if (!wpEditableViews.empty()) {
-        QMapIterator<Waypoint*,WaypointEditableView*> viewIt(wpEditableViews);
-        viewIt.toFront();
-        while(viewIt.hasNext()) {
-            viewIt.next();
-            Waypoint *cur = viewIt.key();
-            int i;
-            for (i = 0; i < waypoints.count(); i++) {
-                if (waypoints[i] == cur) {
-                    break;
-                }
-            }
-            if (i == waypoints.count()) {
-                WaypointEditableView* widget = wpEditableViews.find(cur).value();
-                widget->hide();
-                editableListLayout->removeWidget(widget);
-                wpEditableViews.remove(cur);
-            }
-        }
-    }
-
-    // then add/update the views for each waypoint in the list
-    for(int i = 0; i < waypoints.count(); i++) {
-        Waypoint *wp = waypoints[i];
-        if (!wpEditableViews.contains(wp)) {
-            WaypointEditableView* wpview = new WaypointEditableView(wp, this);
-            wpEditableViews.insert(wp, wpview);
-            connect(wpview, SIGNAL(moveDownWaypoint(Waypoint*)),    this, SLOT(moveDown(Waypoint*)));
-            connect(wpview, SIGNAL(moveUpWaypoint(Waypoint*)),      this, SLOT(moveUp(Waypoint*)));
-            connect(wpview, SIGNAL(moveTopWaypoint(Waypoint*)),    this, SLOT(moveTop(Waypoint*)));
-            connect(wpview, SIGNAL(moveBottomWaypoint(Waypoint*)),  this, SLOT(moveBottom(Waypoint*)));
-            connect(wpview, SIGNAL(removeWaypoint(Waypoint*)),      this, SLOT(removeWaypoint(Waypoint*)));
-            //connect(wpview, SIGNAL(currentWaypointChanged(quint16)), this, SLOT(currentWaypointChanged(quint16)));
-            connect(wpview, SIGNAL(changeCurrentWaypoint(quint16)), this, SLOT(currentWaypointEditableChanged(quint16)));
-            editableListLayout->insertWidget(i, wpview);
-        }
-        WaypointEditableView *wpv = wpEditableViews.value(wp);
-
-        //check if ordering has changed
-        if(editableListLayout->itemAt(i)->widget() != wpv) {
-            editableListLayout->removeWidget(wpv);
-            editableListLayout->insertWidget(i, wpv);
-        }
-
-        wpv->updateValues();    // update the values of the ui elements in the view
-    }
-    setUpdatesEnabled(true);
+    // The rows are updated by the model
     loadFileGlobalWP = false;
 
 }
@@ -705,6 +585,102 @@ void WaypointList::removeWaypoint(Waypoint* wp)
     }
 }
 
+void WaypointList::removeSelected()
+{
+    QList<int> rows;
+    foreach (const QModelIndex& index, m_ui->editableTableView->selectionModel()->selectedRows()) {
+        rows.append(index.row());
+    }
+    // Remove from the end, so the rows of the remaining selection stay valid
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+    foreach (int row, rows) {
+        removeWaypoint(m_editableModel->waypoint(row));
+    }
+}
+
+void WaypointList::setupTableView(QTableView* view, WaypointListModel* model)
+{
+    view->setModel(model);
+    view->setItemDelegate(new WaypointItemDelegate(view));
+    view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    view->setEditTriggers(QAbstractItemView::DoubleClicked | QAbstractItemView::SelectedClicked
+                          | QAbstractItemView::EditKeyPressed);
+    view->setAlternatingRowColors(true);
+    view->verticalHeader()->hide();
+
+    // Fixed sizes, so the view never has to measure all rows of a large mission
+    view->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    view->verticalHeader()->setDefaultSectionSize(view->fontMetrics().height() + 8);
+    view->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    view->horizontalHeader()->setStretchLastSection(true);
+    view->setColumnWidth(WaypointListModel::ColumnId, 40);
+    view->setColumnWidth(WaypointListModel::ColumnCommand, 140);
+    view->setColumnWidth(WaypointListModel::ColumnLatitude, 110);
+    view->setColumnWidth(WaypointListModel::ColumnLongitude, 110);
+}
+
+void WaypointList::editableContextMenu(const QPoint& pos)
+{
+    QTableView* view = m_ui->editableTableView;
+    const QModelIndex index = view->indexAt(pos);
+    Waypoint* wp = m_editableModel->waypoint(index.row());
+    if (wp == NULL)
+        return;
+
+    QMenu menu(this);
+    QAction* upAction = menu.addAction(tr("Move Up"));
+    QAction* downAction = menu.addAction(tr("Move Down"));
+    QAction* topAction = menu.addAction(tr("Move to Top"));
+    QAction* bottomAction = menu.addAction(tr("Move to Bottom"));
+    menu.addSeparator();
+    QAction* currentAction = menu.addAction(tr("Set as Current"));
+    QAction* removeAction = menu.addAction(tr("Remove"));
+    if (wp->getId() == 0) {
+        // For APM WP0 is the home location
+        upAction->setEnabled(false);
+        downAction->setEnabled(false);
+        topAction->setEnabled(false);
+        bottomAction->setEnabled(false);
+        removeAction->setEnabled(false);
+    }
+
+    QAction* chosen = menu.exec(view->viewport()->mapToGlobal(pos));
+    if (chosen == NULL)
+        return;
+
+    if (chosen == upAction) {
+        moveUp(wp);
+    } else if (chosen == downAction) {
+        moveDown(wp);
+    } else if (chosen == topAction) {
+        moveTop(wp);
+    } else if (chosen == bottomAction) {
+        moveBottom(wp);
+    } else if (chosen == currentAction) {
+        currentWaypointEditableChanged(wp->getId());
+        return;
+    } else if (chosen == removeAction) {
+        if (view->selectionModel()->isRowSelected(index.row(), QModelIndex())) {
+            removeSelected();
+        } else {
+            removeWaypoint(wp);
+        }
+        return;
+    }
+    // Keep the moved waypoint selected
+    view->selectRow(wp->getId());
+}
+
+void WaypointList::editableRowChanged(const QModelIndex& current)
+{
+    m_editableModel->setHeaderRow(current.row());
+}
+
+void WaypointList::viewOnlyRowChanged(const QModelIndex& current)
+{
+    m_viewOnlyModel->setHeaderRow(current.row());
+}
+
 void WaypointList::changeEvent(QEvent *e)
 {
     switch (e->type()) {
@@ -725,8 +701,7 @@ void WaypointList::on_clearWPListButton_clicked()
         //Remove all but 1 waypoint, since the first is "home" on APM
         //Also, remove from the END first, work your way back to the first
         while (waypoints.size() > 1) {
-            WaypointEditableView *widget = wpEditableViews.find(waypoints[waypoints.size()-1]).value();
-            widget->remove();
+            removeWaypoint(waypoints.last());
         }
     }
 }
@@ -742,8 +717,7 @@ void WaypointList::clearWPWidget()
     //Remove all but 1 waypoint, since the first is "home" on APM
     //Also, remove from the END first, work your way back to the first
     while(waypoints.size() > 1) {
-        WaypointEditableView* widget = wpEditableViews.find(waypoints[waypoints.size()-1]).value();
-        widget->remove();
+        removeWaypoint(waypoints.last());
     }
 }
 
@@ -35,14 +35,13 @@ This file is part of the QGROUNDCONTROL project
 #define WAYPOINTLIST_H
 
 #include <QtWidgets/QWidget>
-#include <QMap>
-#include <QVBoxLayout>
 #include <QTimer>
 #include "Waypoint.h"
 #include "UASInterface.h"
-#include "WaypointEditableView.h"
-#include "WaypointViewOnlyView.h"
 #include "UnconnectedUASInfoWidget.h"
+
+class QTableView;
+class WaypointListModel;
 //#include "PopupMessage.h"
 
 
@@ -117,6 +116,8 @@ public slots:
     void moveTop(Waypoint* wp);
     void moveBottom(Waypoint* wp);
     void removeWaypoint(Waypoint* wp);
+    /** @brief Remove all selected waypoints of the "edit"-tab */
+    void removeSelected();
 
     void parameterChanged(int uas, int component, QString parameterName, QVariant value);
 
@@ -130,10 +131,8 @@ protected:
     virtual void changeEvent(QEvent *e);
 
 protected:
-    QMap<Waypoint*, WaypointEditableView*> wpEditableViews;
-    QMap<Waypoint*, WaypointViewOnlyView*> wpViewOnlyViews;
-    QVBoxLayout* viewOnlyListLayout;
-    QVBoxLayout* editableListLayout;
+    WaypointListModel* m_editableModel;
+    WaypointListModel* m_viewOnlyModel;
     UASInterface* m_uas;
     UASWaypointManager* WPM;
     double mavX;
@@ -145,11 +144,17 @@ protected:
     bool readGlobalWP;
     bool showOfflineWarning;
 
+private:
+    void setupTableView(QTableView* view, WaypointListModel* model);
+
 private:
     Ui::WaypointList *m_ui;
 
 private slots:
     void on_clearWPListButton_clicked();
+    void editableContextMenu(const QPoint& pos);
+    void editableRowChanged(const QModelIndex& current);
+    void viewOnlyRowChanged(const QModelIndex& current);
 
 };
 
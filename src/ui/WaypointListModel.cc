@@ -0,0 +1,705 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file WaypointListModel.cc
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the table model of a mission
+ */
+
+#include "WaypointListModel.h"
+#include "Waypoint.h"
+#include "UASWaypointManager.h"
+#include "logging.h"
+
+#include <QFont>
+
+WaypointListModel::ParamInfo::ParamInfo() :
+    m_min(0.0),
+    m_max(0.0),
+    m_decimals(0),
+    m_used(false)
+{}
+
+WaypointListModel::ParamInfo::ParamInfo(const QString &label, double min, double max, int decimals) :
+    m_label(label),
+    m_min(min),
+    m_max(max),
+    m_decimals(decimals),
+    m_used(true)
+{}
+
+WaypointListModel::WaypointListModel(bool editable, QObject *parent) :
+    QAbstractTableModel(parent),
+    m_editable(editable),
+    m_currentSeq(-1),
+    m_headerRow(-1)
+{}
+
+void WaypointListModel::setWaypointManager(UASWaypointManager *wpm)
+{
+    if (m_wpm == wpm)
+    {
+        return;
+    }
+    if (m_wpm)
+    {
+        disconnect(m_wpm, 0, this, 0);
+    }
+
+    beginResetModel();
+    m_wpm = wpm;
+    m_waypoints = source();
+    m_currentSeq = -1;
+    m_headerRow = -1;
+    endResetModel();
+
+    if (m_wpm)
+    {
+        if (m_editable)
+        {
+            connect(m_wpm, SIGNAL(waypointEditableListChanged()), this, SLOT(waypointListChanged()));
+            connect(m_wpm, SIGNAL(waypointEditableChanged(int,Waypoint*)), this, SLOT(waypointChanged(int,Waypoint*)));
+        }
+        else
+        {
+            connect(m_wpm, SIGNAL(waypointViewOnlyListChanged()), this, SLOT(waypointListChanged()));
+            connect(m_wpm, SIGNAL(waypointViewOnlyChanged(int,Waypoint*)), this, SLOT(waypointChanged(int,Waypoint*)));
+            connect(m_wpm, SIGNAL(currentWaypointChanged(quint16)), this, SLOT(currentWaypointChanged(quint16)));
+        }
+    }
+}
+
+Waypoint *WaypointListModel::waypoint(int row) const
+{
+    return (row >= 0 && row < m_waypoints.size()) ? m_waypoints.at(row) : NULL;
+}
+
+void WaypointListModel::setHeaderRow(int row)
+{
+    if (row == m_headerRow)
+    {
+        return;
+    }
+    m_headerRow = row;
+    emit headerDataChanged(Qt::Horizontal, ColumnParam1, ColumnAltitude);
+}
+
+QList<QPair<QString, int> > WaypointListModel::commands()
+{
+    static QList<QPair<QString, int> > s_commands;
+    if (s_commands.isEmpty())
+    {
+        // NAV Commands
+        s_commands << qMakePair(tr("Waypoint"), static_cast<int>(MAV_CMD_NAV_WAYPOINT))
+                   << qMakePair(tr("Spline Waypoint"), static_cast<int>(MAV_CMD_NAV_SPLINE_WAYPOINT))
+                   << qMakePair(tr("TakeOff"), static_cast<int>(MAV_CMD_NAV_TAKEOFF))
+                   << qMakePair(tr("Loiter Unlim."), static_cast<int>(MAV_CMD_NAV_LOITER_UNLIM))
+                   << qMakePair(tr("Loiter Time"), static_cast<int>(MAV_CMD_NAV_LOITER_TIME))
+                   << qMakePair(tr("Loiter Turns"), static_cast<int>(MAV_CMD_NAV_LOITER_TURNS))
+                   << qMakePair(tr("Ret. to Launch"), static_cast<int>(MAV_CMD_NAV_RETURN_TO_LAUNCH))
+                   << qMakePair(tr("Land"), static_cast<int>(MAV_CMD_NAV_LAND))
+                   << qMakePair(tr("Change Alt & cont."), static_cast<int>(MAV_CMD_NAV_CONTINUE_AND_CHANGE_ALT))
+                   << qMakePair(tr("Loiter to Alt."), static_cast<int>(MAV_CMD_NAV_LOITER_TO_ALT))
+                   << qMakePair(QString(), -1)
+        // IF Commands
+                   << qMakePair(tr("Condition Delay"), static_cast<int>(MAV_CMD_CONDITION_DELAY))
+                   << qMakePair(tr("Condition Yaw"), static_cast<int>(MAV_CMD_CONDITION_YAW))
+                   << qMakePair(tr("Condition Distance"), static_cast<int>(MAV_CMD_CONDITION_DISTANCE))
+                   << qMakePair(QString(), -1)
+        // DO Commands
+                   << qMakePair(tr("Jump to Index"), static_cast<int>(MAV_CMD_DO_JUMP))
+                   << qMakePair(tr("Set Reverse"), static_cast<int>(MAV_CMD_DO_SET_REVERSE))
+                   << qMakePair(tr("Set Servo"), static_cast<int>(MAV_CMD_DO_SET_SERVO))
+                   << qMakePair(tr("Repeat Servo"), static_cast<int>(MAV_CMD_DO_REPEAT_SERVO))
+                   << qMakePair(tr("Digicam Control"), static_cast<int>(MAV_CMD_DO_DIGICAM_CONTROL))
+                   << qMakePair(tr("Set Relay"), static_cast<int>(MAV_CMD_DO_SET_RELAY))
+                   << qMakePair(tr("Repeat Relay"), static_cast<int>(MAV_CMD_DO_REPEAT_RELAY))
+                   << qMakePair(tr("Set Cam Trigg Dist"), static_cast<int>(MAV_CMD_DO_SET_CAM_TRIGG_DIST))
+                   << qMakePair(tr("Change Speed"), static_cast<int>(MAV_CMD_DO_CHANGE_SPEED))
+                   << qMakePair(tr("Set Home"), static_cast<int>(MAV_CMD_DO_SET_HOME))
+                   << qMakePair(tr("Mount Control"), static_cast<int>(MAV_CMD_DO_MOUNT_CONTROL))
+                   << qMakePair(tr("Set ROI"), static_cast<int>(MAV_CMD_DO_SET_ROI));
+    }
+    return s_commands;
+}
+
+QList<QPair<QString, int> > WaypointListModel::frames()
+{
+    QList<QPair<QString, int> > frames;
+    frames << qMakePair(QString("Abs.Alt"), static_cast<int>(MAV_FRAME_GLOBAL))
+           << qMakePair(QString("Rel.Alt"), static_cast<int>(MAV_FRAME_GLOBAL_RELATIVE_ALT))
+           << qMakePair(QString("Ter.Alt"), static_cast<int>(MAV_FRAME_GLOBAL_TERRAIN_ALT))
+           << qMakePair(QString("Mission"), static_cast<int>(MAV_FRAME_MISSION));
+    return frames;
+}
+
+QString WaypointListModel::commandName(int command)
+{
+    typedef QPair<QString, int> Entry;
+    foreach (const Entry &entry, commands())
+    {
+        if (entry.second == command)
+        {
+            return entry.first;
+        }
+    }
+    return tr("Other (%1)").arg(command);
+}
+
+WaypointListModel::ParamInfo WaypointListModel::paramInfo(int command, int frame, int column)
+{
+    const int param = column - ColumnParam1;
+    if (param < 0 || param > 6)
+    {
+        return ParamInfo();
+    }
+
+    const bool local = frame == MAV_FRAME_LOCAL_NED || frame == MAV_FRAME_LOCAL_ENU
+                    || frame == MAV_FRAME_LOCAL_OFFSET_NED || frame == MAV_FRAME_BODY_NED
+                    || frame == MAV_FRAME_BODY_OFFSET_NED;
+    const ParamInfo position[3] = {
+        local ? ParamInfo(tr("X (m)"), -100000.0, 100000.0, 2) : ParamInfo(tr("Latitude"), -90.0, 90.0, 7),
+        local ? ParamInfo(tr("Y (m)"), -100000.0, 100000.0, 2) : ParamInfo(tr("Longitude"), -180.0, 180.0, 7),
+        local ? ParamInfo(tr("Z (m)"), -100000.0, 100000.0, 2) : ParamInfo(tr("Altitude (m)"), -100000.0, 100000.0, 2)
+    };
+    const ParamInfo radius(tr("Radius (m)"), -32767.0, 32767.0, 1);
+    const ParamInfo yaw(tr("Yaw (deg)"), -360.0, 360.0, 1);
+
+    ParamInfo params[7];
+    bool hasPosition = false;
+    bool hasAltitude = false;
+    switch (command)
+    {
+    case MAV_CMD_NAV_WAYPOINT:
+        params[0] = ParamInfo(tr("Delay (s)"), 0.0, 3600.0, 0);
+        params[1] = ParamInfo(tr("Accept radius (m)"), 0.0, 1000.0, 1);
+        params[2] = ParamInfo(tr("Pass radius (m)"), -1000.0, 1000.0, 1);
+        params[3] = yaw;
+        hasPosition = true;
+        break;
+    case MAV_CMD_NAV_SPLINE_WAYPOINT:
+        params[0] = ParamInfo(tr("Delay (s)"), 0.0, 3600.0, 0);
+        hasPosition = true;
+        break;
+    case MAV_CMD_NAV_LOITER_UNLIM:
+        params[2] = radius;
+        params[3] = yaw;
+        hasPosition = true;
+        break;
+    case MAV_CMD_NAV_LOITER_TURNS:
+        params[0] = ParamInfo(tr("Turns"), 0.0, 255.0, 0);
+        params[2] = radius;
+        hasPosition = true;
+        break;
+    case MAV_CMD_NAV_LOITER_TIME:
+        params[0] = ParamInfo(tr("Time (s)"), 0.0, 65535.0, 0);
+        params[2] = radius;
+        hasPosition = true;
+        break;
+    case MAV_CMD_NAV_RETURN_TO_LAUNCH:
+        break;
+    case MAV_CMD_NAV_LAND:
+        params[3] = yaw;
+        hasPosition = true;
+        break;
+    case MAV_CMD_NAV_TAKEOFF:
+        params[0] = ParamInfo(tr("Pitch (deg)"), -90.0, 90.0, 1);
+        params[3] = yaw;
+        hasPosition = true;
+        break;
+    case MAV_CMD_NAV_CONTINUE_AND_CHANGE_ALT:
+        params[0] = ParamInfo(tr("Climb (0/1/2)"), 0.0, 2.0, 0);
+        hasAltitude = true;
+        break;
+    case MAV_CMD_NAV_LOITER_TO_ALT:
+        params[0] = ParamInfo(tr("Heading req. (0/1)"), 0.0, 1.0, 0);
+        params[1] = radius;
+        hasPosition = true;
+        break;
+    case MAV_CMD_CONDITION_DELAY:
+        params[0] = ParamInfo(tr("Delay (s)"), 0.0, 65535.0, 0);
+        break;
+    case MAV_CMD_CONDITION_YAW:
+        params[0] = ParamInfo(tr("Angle (deg)"), 0.0, 360.0, 1);
+        params[1] = ParamInfo(tr("Rate (deg/s)"), 0.0, 360.0, 1);
+        params[2] = ParamInfo(tr("Direction (-1/1)"), -1.0, 1.0, 0);
+        params[3] = ParamInfo(tr("Relative (0/1)"), 0.0, 1.0, 0);
+        break;
+    case MAV_CMD_CONDITION_DISTANCE:
+        params[0] = ParamInfo(tr("Distance (m)"), 0.0, 100000.0, 1);
+        break;
+    case MAV_CMD_DO_JUMP:
+        params[0] = ParamInfo(tr("Index"), 0.0, 65535.0, 0);
+        params[1] = ParamInfo(tr("Repeat"), -1.0, 65535.0, 0);
+        break;
+    case MAV_CMD_DO_SET_REVERSE:
+        params[0] = ParamInfo(tr("Reverse (0/1)"), 0.0, 1.0, 0);
+        break;
+    case MAV_CMD_DO_SET_SERVO:
+        params[0] = ParamInfo(tr("Servo"), 0.0, 255.0, 0);
+        params[1] = ParamInfo(tr("PWM (us)"), 0.0, 3000.0, 0);
+        break;
+    case MAV_CMD_DO_REPEAT_SERVO:
+        params[0] = ParamInfo(tr("Servo"), 0.0, 255.0, 0);
+        params[1] = ParamInfo(tr("PWM (us)"), 0.0, 3000.0, 0);
+        params[2] = ParamInfo(tr("Count"), 0.0, 65535.0, 0);
+        params[3] = ParamInfo(tr("Cycle (s)"), 0.0, 3600.0, 1);
+        break;
+    case MAV_CMD_DO_DIGICAM_CONTROL:
+        params[0] = ParamInfo(tr("Session"), 0.0, 255.0, 0);
+        params[1] = ParamInfo(tr("Zoom abs."), 0.0, 255.0, 0);
+        params[2] = ParamInfo(tr("Zoom rel."), -255.0, 255.0, 0);
+        params[3] = ParamInfo(tr("Focus"), 0.0, 255.0, 0);
+        params[4] = ParamInfo(tr("Shoot"), 0.0, 255.0, 0);
+        break;
+    case MAV_CMD_DO_SET_RELAY:
+        params[0] = ParamInfo(tr("Relay"), 0.0, 255.0, 0);
+        params[1] = ParamInfo(tr("On (0/1)"), 0.0, 1.0, 0);
+        break;
+    case MAV_CMD_DO_REPEAT_RELAY:
+        params[0] = ParamInfo(tr("Relay"), 0.0, 255.0, 0);
+        params[1] = ParamInfo(tr("Count"), 0.0, 65535.0, 0);
+        params[2] = ParamInfo(tr("Cycle (s)"), 0.0, 3600.0, 1);
+        break;
+    case MAV_CMD_DO_SET_CAM_TRIGG_DIST:
+        params[0] = ParamInfo(tr("Distance (m)"), 0.0, 10000.0, 1);
+        break;
+    case MAV_CMD_DO_CHANGE_SPEED:
+        params[0] = ParamInfo(tr("Type (0=air,1=gnd)"), 0.0, 1.0, 0);
+        params[1] = ParamInfo(tr("Speed (m/s)"), -1.0, 1000.0, 1);
+        params[2] = ParamInfo(tr("Throttle (%)"), -1.0, 100.0, 0);
+        break;
+    case MAV_CMD_DO_SET_HOME:
+        params[0] = ParamInfo(tr("Use current (0/1)"), 0.0, 1.0, 0);
+        hasPosition = true;
+        break;
+    case MAV_CMD_DO_MOUNT_CONTROL:
+        params[0] = ParamInfo(tr("Pitch (deg)"), -180.0, 180.0, 1);
+        params[1] = ParamInfo(tr("Roll (deg)"), -180.0, 180.0, 1);
+        params[2] = ParamInfo(tr("Yaw (deg)"), -180.0, 180.0, 1);
+        break;
+    case MAV_CMD_DO_SET_ROI:
+        params[0] = ParamInfo(tr("ROI mode"), 0.0, 255.0, 0);
+        hasPosition = true;
+        break;
+    default:
+        // Unknown command, every parameter can be edited
+        return ParamInfo(tr("Param %1").arg(param + 1), -1.0e7, 1.0e7, param < 4 ? 4 : 7);
+    }
+
+    if (hasPosition)
+    {
+        params[4] = position[0];
+        params[5] = position[1];
+        params[6] = position[2];
+    }
+    else if (hasAltitude)
+    {
+        params[6] = position[2];
+    }
+    return params[param];
+}
+
+int WaypointListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_waypoints.size();
+}
+
+int WaypointListModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant WaypointListModel::data(const QModelIndex &index, int role) const
+{
+    const Waypoint *wp = waypoint(index.row());
+    if (wp == NULL)
+    {
+        return QVariant();
+    }
+    switch (role)
+    {
+    case CommandRole:
+        return static_cast<int>(wp->getAction());
+    case FrameRole:
+        return static_cast<int>(wp->getFrame());
+    case Qt::FontRole:
+        if (isCurrent(wp))
+        {
+            QFont font;
+            font.setBold(true);
+            return font;
+        }
+        return QVariant();
+    case Qt::CheckStateRole:
+        if (index.column() == ColumnAutoContinue)
+        {
+            return wp->getAutoContinue() ? Qt::Checked : Qt::Unchecked;
+        }
+        if (index.column() == ColumnCurrent)
+        {
+            return isCurrent(wp) ? Qt::Checked : Qt::Unchecked;
+        }
+        return QVariant();
+    case Qt::ToolTipRole:
+        if (index.column() >= ColumnParam1 && index.column() <= ColumnAltitude)
+        {
+            return paramInfo(wp->getAction(), wp->getFrame(), index.column()).m_label;
+        }
+        return QVariant();
+    case Qt::TextAlignmentRole:
+        if (index.column() >= ColumnParam1 && index.column() <= ColumnAltitude)
+        {
+            return static_cast<int>(Qt::AlignRight | Qt::AlignVCenter);
+        }
+        return QVariant();
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        break;
+    default:
+        return QVariant();
+    }
+
+    const bool display = role == Qt::DisplayRole;
+    switch (index.column())
+    {
+    case ColumnId:
+        return wp->getId();
+    case ColumnCommand:
+        if (display)
+        {
+            // For APM WP0 is the home location
+            return (m_editable && index.row() == 0) ? tr("HOME") : commandName(wp->getAction());
+        }
+        return static_cast<int>(wp->getAction());
+    case ColumnFrame:
+        if (display)
+        {
+            typedef QPair<QString, int> Entry;
+            foreach (const Entry &entry, frames())
+            {
+                if (entry.second == wp->getFrame())
+                {
+                    return entry.first;
+                }
+            }
+            return QString::number(wp->getFrame());
+        }
+        return static_cast<int>(wp->getFrame());
+    case ColumnParam1:
+    case ColumnParam2:
+    case ColumnParam3:
+    case ColumnParam4:
+    case ColumnLatitude:
+    case ColumnLongitude:
+    case ColumnAltitude:
+    {
+        const double params[7] = { wp->getParam1(), wp->getParam2(), wp->getParam3(), wp->getParam4(),
+                                   wp->getParam5(), wp->getParam6(), wp->getParam7() };
+        const double value = params[index.column() - ColumnParam1];
+        if (!display)
+        {
+            return value;
+        }
+        const ParamInfo info = paramInfo(wp->getAction(), wp->getFrame(), index.column());
+        if (!info.m_used)
+        {
+            return QVariant();
+        }
+        return QString::number(value, 'f', info.m_decimals);
+    }
+    default:
+        return QVariant();
+    }
+}
+
+bool WaypointListModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    Waypoint *wp = waypoint(index.row());
+    if (wp == NULL || m_wpm == NULL)
+    {
+        return false;
+    }
+
+    // The views are updated by the change signals of the waypoint manager
+    if (role == Qt::CheckStateRole)
+    {
+        const bool checked = value.toInt() == Qt::Checked;
+        if (index.column() == ColumnAutoContinue && m_editable)
+        {
+            wp->setAutocontinue(checked);
+            return true;
+        }
+        if (index.column() == ColumnCurrent && checked)
+        {
+            if (m_editable)
+            {
+                m_wpm->setCurrentEditable(wp->getId());
+            }
+            else
+            {
+                m_wpm->setCurrentWaypoint(wp->getId());
+            }
+            return true;
+        }
+        return false;
+    }
+    if (role != Qt::EditRole || !m_editable)
+    {
+        return false;
+    }
+
+    bool ok = false;
+    const double number = value.toDouble(&ok);
+    if (!ok)
+    {
+        return false;
+    }
+    switch (index.column())
+    {
+    case ColumnCommand:
+        wp->setAction(static_cast<int>(number));
+        break;
+    case ColumnFrame:
+        wp->setFrame(static_cast<MAV_FRAME>(static_cast<int>(number)));
+        break;
+    case ColumnParam1:
+        wp->setParam1(number);
+        break;
+    case ColumnParam2:
+        wp->setParam2(number);
+        break;
+    case ColumnParam3:
+        wp->setParam3(number);
+        break;
+    case ColumnParam4:
+        wp->setParam4(number);
+        break;
+    case ColumnLatitude:
+        wp->setParam5(number);
+        break;
+    case ColumnLongitude:
+        wp->setParam6(number);
+        break;
+    case ColumnAltitude:
+        wp->setParam7(number);
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+Qt::ItemFlags WaypointListModel::flags(const QModelIndex &index) const
+{
+    const Waypoint *wp = waypoint(index.row());
+    if (wp == NULL)
+    {
+        return Qt::NoItemFlags;
+    }
+    Qt::ItemFlags flags = Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+    if (index.column() == ColumnCurrent)
+    {
+        return flags | Qt::ItemIsUserCheckable;
+    }
+    if (!m_editable || index.row() == 0)
+    {
+        // Onboard items and home can not be edited
+        return flags;
+    }
+
+    switch (index.column())
+    {
+    case ColumnCommand:
+    case ColumnFrame:
+        return flags | Qt::ItemIsEditable;
+    case ColumnAutoContinue:
+        return flags | Qt::ItemIsUserCheckable;
+    case ColumnParam1:
+    case ColumnParam2:
+    case ColumnParam3:
+    case ColumnParam4:
+    case ColumnLatitude:
+    case ColumnLongitude:
+    case ColumnAltitude:
+        if (paramInfo(wp->getAction(), wp->getFrame(), index.column()).m_used)
+        {
+            return flags | Qt::ItemIsEditable;
+        }
+        return flags;
+    default:
+        return flags;
+    }
+}
+
+QVariant WaypointListModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    const Waypoint *wp = waypoint(m_headerRow);
+    if (section >= ColumnParam1 && section <= ColumnAltitude && wp != NULL)
+    {
+        const ParamInfo info = paramInfo(wp->getAction(), wp->getFrame(), section);
+        if (info.m_used)
+        {
+            return info.m_label;
+        }
+    }
+
+    switch (section)
+    {
+    case ColumnId:
+        return tr("#");
+    case ColumnCommand:
+        return tr("Command");
+    case ColumnParam1:
+        return tr("Param 1");
+    case ColumnParam2:
+        return tr("Param 2");
+    case ColumnParam3:
+        return tr("Param 3");
+    case ColumnParam4:
+        return tr("Param 4");
+    case ColumnLatitude:
+        return tr("Lat/X");
+    case ColumnLongitude:
+        return tr("Lon/Y");
+    case ColumnAltitude:
+        return tr("Alt/Z");
+    case ColumnFrame:
+        return tr("Frame");
+    case ColumnAutoContinue:
+        return tr("Cont.");
+    case ColumnCurrent:
+        return tr("Current");
+    default:
+        return QVariant();
+    }
+}
+
+void WaypointListModel::waypointListChanged()
+{
+    const QList<Waypoint *> &waypoints = source();
+
+    // Most changes add, remove or move a few items. Only the range between
+    // the unchanged head and tail of the list is inserted or removed.
+    const int oldCount = m_waypoints.size();
+    const int newCount = waypoints.size();
+    int head = 0;
+    while (head < oldCount && head < newCount && m_waypoints.at(head) == waypoints.at(head))
+    {
+        ++head;
+    }
+    int tail = 0;
+    while (tail < oldCount - head && tail < newCount - head
+           && m_waypoints.at(oldCount - 1 - tail) == waypoints.at(newCount - 1 - tail))
+    {
+        ++tail;
+    }
+    const int removed = oldCount - head - tail;
+    const int inserted = newCount - head - tail;
+
+    if (removed > 0 && removed == inserted)
+    {
+        // Items were moved or replaced
+        m_waypoints = waypoints;
+    }
+    else
+    {
+        if (removed > 0)
+        {
+            beginRemoveRows(QModelIndex(), head, head + removed - 1);
+            m_waypoints.erase(m_waypoints.begin() + head, m_waypoints.begin() + head + removed);
+            endRemoveRows();
+        }
+        if (inserted > 0)
+        {
+            beginInsertRows(QModelIndex(), head, head + inserted - 1);
+            m_waypoints = waypoints;
+            endInsertRows();
+        }
+    }
+
+    // Ids of the following items might have changed, and a deleted waypoint
+    // can be reallocated at the same address. The views only repaint what is visible.
+    if (!m_waypoints.isEmpty())
+    {
+        emit dataChanged(index(0, 0), index(m_waypoints.size() - 1, ColumnCount - 1));
+    }
+    emit headerDataChanged(Qt::Horizontal, ColumnParam1, ColumnAltitude);
+}
+
+void WaypointListModel::waypointChanged(int uasId, Waypoint *wp)
+{
+    Q_UNUSED(uasId);
+    const int row = rowOf(wp);
+    if (row >= 0)
+    {
+        emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+        if (row == m_headerRow)
+        {
+            emit headerDataChanged(Qt::Horizontal, ColumnParam1, ColumnAltitude);
+        }
+    }
+}
+
+void WaypointListModel::currentWaypointChanged(quint16 seq)
+{
+    m_currentSeq = seq;
+    if (!m_waypoints.isEmpty())
+    {
+        emit dataChanged(index(0, 0), index(m_waypoints.size() - 1, ColumnCount - 1));
+    }
+}
+
+const QList<Waypoint *> &WaypointListModel::source() const
+{
+    static const QList<Waypoint *> s_empty;
+    if (m_wpm == NULL)
+    {
+        return s_empty;
+    }
+    return m_editable ? m_wpm->getWaypointEditableList() : m_wpm->getWaypointViewOnlyList();
+}
+
+int WaypointListModel::rowOf(Waypoint *wp) const
+{
+    // The id is the row, unless the list is being changed right now
+    const int row = wp->getId();
+    if (row < m_waypoints.size() && m_waypoints.at(row) == wp)
+    {
+        return row;
+    }
+    return m_waypoints.indexOf(wp);
+}
+
+bool WaypointListModel::isCurrent(const Waypoint *wp) const
+{
+    if (!m_editable && m_currentSeq >= 0)
+    {
+        return wp->getId() == m_currentSeq;
+    }
+    return wp->getCurrent();
+}
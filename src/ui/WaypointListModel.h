@@ -0,0 +1,167 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file WaypointListModel.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the table model of a mission
+ */
+
+#ifndef WAYPOINTLISTMODEL_H
+#define WAYPOINTLISTMODEL_H
+
+#include <QAbstractTableModel>
+#include <QList>
+#include <QPair>
+#include <QPointer>
+
+class Waypoint;
+class UASWaypointManager;
+
+/**
+ * @brief The WaypointListModel class presents the editable or the view only
+ *        waypoint list of a UASWaypointManager as a table with one row per
+ *        mission item. The views only create editors for the cell being
+ *        edited, so the cost of a mission no longer grows with its size.
+ *        Changes of single waypoints update their row only, changes of the
+ *        list are turned into row insertions and removals.
+ */
+class WaypointListModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum Column
+    {
+        ColumnId,
+        ColumnCommand,
+        ColumnParam1,
+        ColumnParam2,
+        ColumnParam3,
+        ColumnParam4,
+        ColumnLatitude,     ///< Param 5 (latitude or local X)
+        ColumnLongitude,    ///< Param 6 (longitude or local Y)
+        ColumnAltitude,     ///< Param 7 (altitude or local Z)
+        ColumnFrame,
+        ColumnAutoContinue,
+        ColumnCurrent,
+        ColumnCount
+    };
+
+    enum Role
+    {
+        CommandRole = Qt::UserRole,     ///< MAV_CMD of the row
+        FrameRole                       ///< MAV_FRAME of the row
+    };
+
+    /**
+     * @brief The ParamInfo struct describes the meaning of one parameter
+     *        column for a command
+     */
+    struct ParamInfo
+    {
+        QString m_label;    ///< Name and unit of the parameter
+        double m_min;       ///< Lowest valid value
+        double m_max;       ///< Highest valid value
+        int m_decimals;     ///< Decimals to display and edit
+        bool m_used;        ///< False if the command does not use the parameter
+
+        ParamInfo();
+        ParamInfo(const QString &label, double min, double max, int decimals);
+    };
+
+    /**
+     * @brief WaypointListModel - CTOR
+     * @param editable - true to present the editable list, false for the view only list
+     * @param parent - parent object
+     */
+    explicit WaypointListModel(bool editable, QObject *parent = NULL);
+
+    /**
+     * @brief setWaypointManager sets the waypoint manager to present
+     * @param wpm - the waypoint manager, can be NULL
+     */
+    void setWaypointManager(UASWaypointManager *wpm);
+
+    /**
+     * @brief waypoint returns the waypoint of a row
+     * @return - the waypoint or NULL if row is out of range
+     */
+    Waypoint *waypoint(int row) const;
+
+    /**
+     * @brief setHeaderRow sets the row whose command the parameter headers are
+     *        labelled for. Usually the selected row.
+     * @param row - the row or -1 for generic labels
+     */
+    void setHeaderRow(int row);
+
+    /**
+     * @brief commands returns the commands offered for mission items
+     * @return - list of names and MAV_CMD ids in menu order. A separator is an
+     *           entry with an empty name.
+     */
+    static QList<QPair<QString, int> > commands();
+
+    /**
+     * @brief frames returns the frames offered for mission items
+     * @return - list of names and MAV_FRAME ids
+     */
+    static QList<QPair<QString, int> > frames();
+
+    /**
+     * @brief commandName returns the display name of a command
+     */
+    static QString commandName(int command);
+
+    /**
+     * @brief paramInfo returns the meaning of a parameter column for a command
+     * @param command - the MAV_CMD
+     * @param frame - the MAV_FRAME, selects between global and local coordinates
+     * @param column - one of ColumnParam1 to ColumnAltitude
+     */
+    static ParamInfo paramInfo(int command, int frame, int column);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole);
+    Qt::ItemFlags flags(const QModelIndex &index) const;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+
+private slots:
+    void waypointListChanged();
+    void waypointChanged(int uasId, Waypoint *wp);
+    void currentWaypointChanged(quint16 seq);
+
+private:
+    const QList<Waypoint *> &source() const;
+    int rowOf(Waypoint *wp) const;
+    bool isCurrent(const Waypoint *wp) const;
+
+private:
+    QPointer<UASWaypointManager> m_wpm;
+    bool m_editable;                    ///< Presents the editable list
+    QList<Waypoint *> m_waypoints;      ///< The list as known by the views
+    int m_currentSeq;                   ///< Current item reported by the vehicle (view only), -1 if unknown
+    int m_headerRow;                    ///< Row the headers are labelled for
+};
+
+#endif // WAYPOINTLISTMODEL_H
@@ -51,6 +51,26 @@ private:
 
 public:
 
+    /**
+     * @brief Returns true if the waypoint ends a drawn segment
+     *        (straight or spline). Other navigation commands are skipped.
+     */
+    static bool hasPath(const Waypoint& wp);
+
+    /**
+     * @brief Returns the QPainterPath (in the map coordinates) of the single
+     *        segment ending at waypoint i. The path starts at waypoint start
+     *        which is the last waypoint before i having a path (see hasPath()).
+     *        m1 is the spline velocity at the end of the previous segment on input
+     *        and the one at the end of this segment on output.
+     *        Returns an empty path if waypoint i has no path.
+     */
+    static QPainterPath segment(const QList<Waypoint*>& waypoints,
+                                int i,
+                                int start,
+                                mapcontrol::MapGraphicItem& map,
+                                QPointF& m1);
+
     /**
      * @brief Returns a QPainterPath (in the map coordinates)
      *        the UAS would take between the waypoints.
@@ -0,0 +1,479 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file CompassCalibrator.cc
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the incremental compass ellipsoid fit
+ */
+
+#include "CompassCalibrator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+/**
+ * @brief solveLinear solves a x = b with partial pivoting. a is given by its upper
+ *        triangle and is destroyed.
+ * @return - false if the system is singular
+ */
+template<int N>
+bool solveLinear(double (&a)[N][N], double (&b)[N], double (&x)[N])
+{
+    for (int row = 0; row < N; ++row)
+    {
+        for (int column = 0; column < row; ++column)
+        {
+            a[row][column] = a[column][row];
+        }
+    }
+
+    double scale = 0.0;
+    for (int i = 0; i < N; ++i)
+    {
+        scale = std::max(scale, std::fabs(a[i][i]));
+    }
+    if (scale <= 0.0)
+    {
+        return false;
+    }
+
+    for (int column = 0; column < N; ++column)
+    {
+        int pivot = column;
+        for (int row = column + 1; row < N; ++row)
+        {
+            if (std::fabs(a[row][column]) > std::fabs(a[pivot][column]))
+            {
+                pivot = row;
+            }
+        }
+        if (std::fabs(a[pivot][column]) < 1e-12 * scale)
+        {
+            return false;
+        }
+        if (pivot != column)
+        {
+            for (int k = 0; k < N; ++k)
+            {
+                std::swap(a[pivot][k], a[column][k]);
+            }
+            std::swap(b[pivot], b[column]);
+        }
+        for (int row = column + 1; row < N; ++row)
+        {
+            const double factor = a[row][column] / a[column][column];
+            for (int k = column; k < N; ++k)
+            {
+                a[row][k] -= factor * a[column][k];
+            }
+            b[row] -= factor * b[column];
+        }
+    }
+    for (int row = N - 1; row >= 0; --row)
+    {
+        double sum = b[row];
+        for (int k = row + 1; k < N; ++k)
+        {
+            sum -= a[row][k] * x[k];
+        }
+        x[row] = sum / a[row][row];
+    }
+    return true;
+}
+
+/**
+ * @brief symmetricEigen decomposes a symmetric 3x3 matrix (Jacobi rotations)
+ * @param a - the matrix, destroyed
+ * @param values - the eigenvalues
+ * @param vectors - the eigenvectors as columns
+ */
+void symmetricEigen(double (&a)[3][3], double (&values)[3], double (&vectors)[3][3])
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            vectors[i][j] = i == j ? 1.0 : 0.0;
+        }
+    }
+    for (int sweep = 0; sweep < 50; ++sweep)
+    {
+        const double offDiagonal = std::fabs(a[0][1]) + std::fabs(a[0][2]) + std::fabs(a[1][2]);
+        if (offDiagonal < 1e-15)
+        {
+            break;
+        }
+        for (int p = 0; p < 2; ++p)
+        {
+            for (int q = p + 1; q < 3; ++q)
+            {
+                if (std::fabs(a[p][q]) < 1e-300)
+                {
+                    continue;
+                }
+                const double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0);
+                const double s = t * c;
+                for (int k = 0; k < 3; ++k)
+                {
+                    const double akp = a[k][p];
+                    const double akq = a[k][q];
+                    a[k][p] = c * akp - s * akq;
+                    a[k][q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < 3; ++k)
+                {
+                    const double apk = a[p][k];
+                    const double aqk = a[q][k];
+                    a[p][k] = c * apk - s * aqk;
+                    a[q][k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < 3; ++k)
+                {
+                    const double vkp = vectors[k][p];
+                    const double vkq = vectors[k][q];
+                    vectors[k][p] = c * vkp - s * vkq;
+                    vectors[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        values[i] = a[i][i];
+    }
+}
+
+}
+
+CompassCalibrator::Result::Result() :
+    m_valid(false),
+    m_ellipsoid(false),
+    m_diagonals(1.0, 1.0, 1.0),
+    m_radius(0.0),
+    m_residual(0.0),
+    m_coverage(0.0),
+    m_sampleCount(0)
+{}
+
+CompassCalibrator::CompassCalibrator()
+{
+    reset();
+}
+
+void CompassCalibrator::reset()
+{
+    m_scale = 0.0;
+    m_sampleCount = 0;
+    for (int i = 0; i < 9; ++i)
+    {
+        m_ellipsoidB[i] = 0.0;
+        for (int j = 0; j < 9; ++j)
+        {
+            m_ellipsoidN[i][j] = 0.0;
+        }
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        m_sphereB[i] = 0.0;
+        for (int j = 0; j < 4; ++j)
+        {
+            m_sphereN[i][j] = 0.0;
+        }
+    }
+    m_kept.clear();
+    m_cellCounts.fill(0, s_CellCount);
+    m_result = Result();
+}
+
+void CompassCalibrator::addSample(const Vector3d &reading)
+{
+    if (m_scale == 0.0)
+    {
+        if (reading.isNull())
+        {
+            return;
+        }
+        m_scale = 1.0 / reading.length();
+    }
+    ++m_sampleCount;
+
+    const double x = reading.x() * m_scale;
+    const double y = reading.y() * m_scale;
+    const double z = reading.z() * m_scale;
+
+    // Quadric a x^2 + b y^2 + c z^2 + 2f yz + 2g xz + 2h xy + 2p x + 2q y + 2r z = 1
+    const double d[9] = { x * x, y * y, z * z, 2.0 * y * z, 2.0 * x * z, 2.0 * x * y, 2.0 * x, 2.0 * y, 2.0 * z };
+    for (int i = 0; i < 9; ++i)
+    {
+        for (int j = i; j < 9; ++j)
+        {
+            m_ellipsoidN[i][j] += d[i] * d[j];
+        }
+        m_ellipsoidB[i] += d[i];
+    }
+
+    // Sphere x^2 + y^2 + z^2 = 2 cx x + 2 cy y + 2 cz z + (r^2 - |c|^2)
+    const double e[4] = { 2.0 * x, 2.0 * y, 2.0 * z, 1.0 };
+    const double t = x * x + y * y + z * z;
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = i; j < 4; ++j)
+        {
+            m_sphereN[i][j] += e[i] * e[j];
+        }
+        m_sphereB[i] += e[i] * t;
+    }
+
+    // Keep a few samples per cell around the current center
+    const int cell = cellOf(correct(m_result, reading));
+    if (m_cellCounts[cell] < s_SamplesPerCell)
+    {
+        ++m_cellCounts[cell];
+        m_kept.append(reading);
+    }
+}
+
+const CompassCalibrator::Result &CompassCalibrator::solve()
+{
+    Result result;
+    result.m_sampleCount = m_sampleCount;
+    if (m_sampleCount >= 10)
+    {
+        result.m_valid = solveEllipsoid(result) || solveSphere(result);
+    }
+    result.m_coverage = m_result.m_coverage;
+    m_result = result;
+    updateCoverage();
+    return m_result;
+}
+
+const CompassCalibrator::Result &CompassCalibrator::result() const
+{
+    return m_result;
+}
+
+CompassCalibrator::Result CompassCalibrator::sphereFit() const
+{
+    Result result = m_result;
+    result.m_valid = (m_sampleCount >= 10) && solveSphere(result);
+    return result;
+}
+
+bool CompassCalibrator::isComplete() const
+{
+    return m_result.m_valid && m_result.m_sampleCount >= s_MinSamples
+            && m_result.m_coverage >= s_MinCoverage && m_result.m_residual <= s_MaxResidual;
+}
+
+int CompassCalibrator::sampleCount() const
+{
+    return m_sampleCount;
+}
+
+bool CompassCalibrator::solveEllipsoid(Result &result) const
+{
+    double n[9][9];
+    double b[9];
+    double v[9];
+    for (int i = 0; i < 9; ++i)
+    {
+        b[i] = m_ellipsoidB[i];
+        for (int j = 0; j < 9; ++j)
+        {
+            n[i][j] = m_ellipsoidN[i][j];
+        }
+    }
+    if (!solveLinear(n, b, v))
+    {
+        return false;
+    }
+
+    // Center c = -A^-1 (p, q, r)
+    double a[3][3] = { { v[0], v[5], v[4] }, { v[5], v[1], v[3] }, { v[4], v[3], v[2] } };
+    double rhs[3] = { -v[6], -v[7], -v[8] };
+    double center[3];
+    double aUpper[3][3] = { { a[0][0], a[0][1], a[0][2] }, { 0.0, a[1][1], a[1][2] }, { 0.0, 0.0, a[2][2] } };
+    if (!solveLinear(aUpper, rhs, center))
+    {
+        return false;
+    }
+
+    // (x - c)^T M (x - c) = 1 with M = A / (1 + c^T A c)
+    double k = 1.0;
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            k += center[i] * a[i][j] * center[j];
+        }
+    }
+    if (k <= 0.0)
+    {
+        return false;
+    }
+    double m[3][3];
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            m[i][j] = a[i][j] / k;
+        }
+    }
+
+    double values[3];
+    double vectors[3][3];
+    symmetricEigen(m, values, vectors);
+    const double minValue = std::min(values[0], std::min(values[1], values[2]));
+    const double maxValue = std::max(values[0], std::max(values[1], values[2]));
+    // Not an ellipsoid or too distorted for a soft iron correction (axis ratio is the
+    // square root of the eigenvalue ratio)
+    if (minValue <= 0.0 || maxValue / minValue > s_MaxAxisRatio * s_MaxAxisRatio)
+    {
+        return false;
+    }
+
+    // S = R * sqrt(M) maps the ellipsoid onto a sphere of radius R. R is the mean
+    // semi axis, so det(S) = 1 and the field strength is kept.
+    const double radius = std::pow(values[0] * values[1] * values[2], -1.0 / 6.0);
+    double s[3][3];
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            s[i][j] = 0.0;
+            for (int e = 0; e < 3; ++e)
+            {
+                s[i][j] += vectors[i][e] * std::sqrt(values[e]) * radius * vectors[j][e];
+            }
+        }
+    }
+
+    result.m_ellipsoid = true;
+    result.m_offsets.set(-center[0] / m_scale, -center[1] / m_scale, -center[2] / m_scale);
+    result.m_diagonals.set(s[0][0], s[1][1], s[2][2]);
+    result.m_offDiagonals.set(s[0][1], s[0][2], s[1][2]);
+    result.m_radius = radius / m_scale;
+    return true;
+}
+
+bool CompassCalibrator::solveSphere(Result &result) const
+{
+    double n[4][4];
+    double b[4];
+    double v[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        b[i] = m_sphereB[i];
+        for (int j = 0; j < 4; ++j)
+        {
+            n[i][j] = m_sphereN[i][j];
+        }
+    }
+    if (!solveLinear(n, b, v))
+    {
+        return false;
+    }
+    const double radiusSquared = v[3] + v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+    if (radiusSquared <= 0.0)
+    {
+        return false;
+    }
+
+    result.m_ellipsoid = false;
+    result.m_offsets.set(-v[0] / m_scale, -v[1] / m_scale, -v[2] / m_scale);
+    result.m_diagonals.set(1.0, 1.0, 1.0);
+    result.m_offDiagonals.set(0.0, 0.0, 0.0);
+    result.m_radius = std::sqrt(radiusSquared) / m_scale;
+    return true;
+}
+
+Vector3d CompassCalibrator::correct(const Result &result, const Vector3d &reading) const
+{
+    const Vector3d v = reading + result.m_offsets;
+    const Vector3d &d = result.m_diagonals;
+    const Vector3d &o = result.m_offDiagonals;
+    return Vector3d(d.x() * v.x() + o.x() * v.y() + o.y() * v.z(),
+                    o.x() * v.x() + d.y() * v.y() + o.z() * v.z(),
+                    o.y() * v.x() + o.z() * v.y() + d.z() * v.z());
+}
+
+int CompassCalibrator::cellOf(const Vector3d &direction) const
+{
+    const double length = direction.length();
+    if (length <= 0.0)
+    {
+        return 0;
+    }
+    // Bands of equal height on the unit sphere have equal area
+    const double z = direction.z() / length;
+    const int band = qBound(0, static_cast<int>((z + 1.0) * 0.5 * s_ElevationBands), s_ElevationBands - 1);
+    const double azimuth = std::atan2(direction.y(), direction.x()) + M_PI;
+    const int sector = qBound(0, static_cast<int>(azimuth / (2.0 * M_PI) * s_AzimuthSectors), s_AzimuthSectors - 1);
+    return band * s_AzimuthSectors + sector;
+}
+
+void CompassCalibrator::updateCoverage()
+{
+    // Rebin the kept samples around the new center
+    m_cellCounts.fill(0, s_CellCount);
+    int coveredCells = 0;
+    double errorSum = 0.0;
+    for (int i = 0; i < m_kept.size(); ++i)
+    {
+        const Vector3d corrected = correct(m_result, m_kept.at(i));
+        int &count = m_cellCounts[cellOf(corrected)];
+        if (count == 0)
+        {
+            ++coveredCells;
+        }
+        ++count;
+        if (m_result.m_valid && m_result.m_radius > 0.0)
+        {
+            const double error = (corrected.length() - m_result.m_radius) / m_result.m_radius;
+            errorSum += error * error;
+        }
+    }
+    m_result.m_coverage = static_cast<double>(coveredCells) / s_CellCount;
+    m_result.m_residual = m_kept.isEmpty() ? 0.0 : std::sqrt(errorSum / m_kept.size());
+
+    // Drop samples of over full cells, so new directions can still be kept
+    if (m_kept.size() > s_CellCount * s_SamplesPerCell)
+    {
+        QVector<Vector3d> kept;
+        m_cellCounts.fill(0, s_CellCount);
+        for (int i = 0; i < m_kept.size(); ++i)
+        {
+            int &count = m_cellCounts[cellOf(correct(m_result, m_kept.at(i)))];
+            if (count < s_SamplesPerCell)
+            {
+                ++count;
+                kept.append(m_kept.at(i));
+            }
+        }
+        m_kept = kept;
+    }
+}
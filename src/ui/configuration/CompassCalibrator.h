@@ -0,0 +1,138 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file CompassCalibrator.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the incremental compass ellipsoid fit
+ */
+
+#ifndef COMPASSCALIBRATOR_H
+#define COMPASSCALIBRATOR_H
+
+#include "QGCGeo.h"
+#include <QVector>
+
+/**
+ * @brief The CompassCalibrator class fits an ellipsoid to the readings of one compass
+ *        while they arrive. Only the normal equations of the linear least squares
+ *        problems are accumulated, so a sample costs the same no matter how many were
+ *        added before and solving is a 9x9 system.
+ *
+ *        The ellipsoid gives the offsets and the soft iron matrix (scale and cross axis
+ *        terms). A sphere fit from the same samples is the fallback if the ellipsoid
+ *        is not well defined yet.
+ *
+ *        Coverage is measured with 72 equal area cells around the fitted center. A few
+ *        samples per cell are kept to recompute the coverage and the fit residual when
+ *        the center moves.
+ */
+class CompassCalibrator
+{
+public:
+    /**
+     * @brief The Result struct holds the latest fit
+     */
+    struct Result
+    {
+        bool m_valid;               ///< A fit is available
+        bool m_ellipsoid;           ///< The fit is an ellipsoid, false means sphere fit
+        Vector3d m_offsets;         ///< Offsets to add to the readings (negative center)
+        Vector3d m_diagonals;       ///< Soft iron matrix diagonal (1, 1, 1 for a sphere)
+        Vector3d m_offDiagonals;    ///< Soft iron matrix off diagonals (xy, xz, yz)
+        double m_radius;            ///< Field strength after correction
+        double m_residual;          ///< RMS of the radius error relative to the radius
+        double m_coverage;          ///< Fraction of the coverage cells with samples (0..1)
+        int m_sampleCount;          ///< Number of samples in the fit
+
+        Result();
+    };
+
+    CompassCalibrator();
+
+    /**
+     * @brief reset drops all samples
+     */
+    void reset();
+
+    /**
+     * @brief addSample adds a reading to the normal equations
+     * @param reading - the magnetometer reading
+     */
+    void addSample(const Vector3d &reading);
+
+    /**
+     * @brief solve updates the fit, the coverage and the residual
+     * @return - the updated result
+     */
+    const Result &solve();
+
+    /**
+     * @brief result returns the result of the last solve()
+     */
+    const Result &result() const;
+
+    /**
+     * @brief sphereFit returns a sphere fit (offsets only) of the samples. Coverage
+     *        and residual are those of the last solve().
+     */
+    Result sphereFit() const;
+
+    /**
+     * @brief isComplete returns true if the last fit is good enough to stop collecting
+     *        samples: enough samples, enough coverage and a small residual.
+     */
+    bool isComplete() const;
+
+    /**
+     * @brief sampleCount returns the number of samples added since the last reset
+     */
+    int sampleCount() const;
+
+private:
+    static constexpr int s_ElevationBands = 6;
+    static constexpr int s_AzimuthSectors = 12;
+    static constexpr int s_CellCount = s_ElevationBands * s_AzimuthSectors;
+    static constexpr int s_SamplesPerCell = 4;          ///< Kept samples per coverage cell
+    static constexpr int s_MinSamples = 100;            ///< Samples needed to complete
+    static constexpr double s_MinCoverage = 0.8;        ///< Coverage needed to complete
+    static constexpr double s_MaxResidual = 0.05;       ///< Residual needed to complete
+    static constexpr double s_MaxAxisRatio = 2.0;       ///< Largest accepted soft iron scale ratio
+
+    bool solveEllipsoid(Result &result) const;
+    bool solveSphere(Result &result) const;
+    Vector3d correct(const Result &result, const Vector3d &reading) const;
+    int cellOf(const Vector3d &direction) const;
+    void updateCoverage();
+
+    double m_scale;                 ///< Scales readings to about 1 for the normal equations
+    int m_sampleCount;
+    double m_ellipsoidN[9][9];      ///< Normal matrix of the quadric fit (upper triangle)
+    double m_ellipsoidB[9];         ///< Right hand side of the quadric fit
+    double m_sphereN[4][4];         ///< Normal matrix of the sphere fit (upper triangle)
+    double m_sphereB[4];            ///< Right hand side of the sphere fit
+
+    QVector<Vector3d> m_kept;       ///< Samples kept for coverage and residual
+    QVector<int> m_cellCounts;      ///< Kept samples per cell
+    Result m_result;
+};
+
+#endif // COMPASSCALIBRATOR_H
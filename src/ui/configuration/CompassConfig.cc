@@ -33,6 +33,7 @@ CompassConfig::CompassConfig(QWidget *parent) : AP2ConfigWidget(parent),
     m_compatibilityMode(false),
     m_haveSecondCompass(false),
     m_haveThirdCompass(false),
+    m_elapsedSeconds(0),
     m_avgSamples(0.0),
     m_rad(0.0)
 {
@@ -332,7 +333,8 @@ void CompassConfig::liveCalibrationClicked()
     }
 
     QMessageBox::information(this,tr("Live Compass calibration"),
-                             tr("Data will be collected for 60 seconds, Please click ok and move the apm around all axes"));
+                             tr("Data will be collected for up to 60 seconds, Please click ok and move the apm around all axes.\n"
+                                "The calibration finishes as soon as all directions are covered."));
 
     // Initialiase to zero
     m_uas->setParameter( 1,"COMPASS_OFS_X", 0.0);
@@ -347,6 +349,11 @@ void CompassConfig::liveCalibrationClicked()
     m_uas->setParameter(1,"COMPASS_OFS3_Y", 0.0);
     m_uas->setParameter(1,"COMPASS_OFS3_Z", 0.0);
 
+    // The fit needs uncorrected readings, reset the soft iron matrix as well
+    resetSoftIron(QString());
+    resetSoftIron("2");
+    resetSoftIron("3");
+
     QTimer::singleShot(1000,this,SLOT(startDataCollection()));
 }
 
@@ -374,6 +381,11 @@ void CompassConfig::startDataCollection()
                             pm->getParameterValue(1, "COMPASS_OFS3_Y").toDouble(),
                             pm->getParameterValue(1, "COMPASS_OFS3_Z").toDouble());
 
+    m_compass1Calibrator.reset();
+    m_compass2Calibrator.reset();
+    m_compass3Calibrator.reset();
+    m_elapsedSeconds = 0;
+
     m_compass1LastValue.set(0.0, 0.0, 0.0); // Compass 1
     m_compass2LastValue.set(0.0, 0.0, 0.0); // Compass 2
     m_compass3LastValue.set(0.0, 0.0, 0.0); // Compass 3
@@ -392,8 +404,11 @@ void CompassConfig::startDataCollection()
     m_uas->enableRawSensorDataTransmission(10);
     m_calibratingCompass = true;
 
-    m_progressDialog = new QProgressDialog(tr("Compass calibration in progress. Please rotate your craft around all its axes for 60 seconds."),
-                                           tr("Cancel"), 0, 60, this);
+    m_progressDialog = new QProgressDialog(tr("Compass calibration in progress. Please rotate your craft around all its axes."),
+                                           tr("Cancel"), 0, 100, this);
+    // The value is the coverage, reaching 100% must not close the dialog
+    m_progressDialog->setAutoReset(false);
+    m_progressDialog->setAutoClose(false);
     connect(m_progressDialog, SIGNAL(canceled()), this, SLOT(cancelCompassCalibration()));
     m_timer = new QTimer(this);
     connect(m_timer, SIGNAL(timeout()), this, SLOT(progressCounter()));
@@ -402,10 +417,28 @@ void CompassConfig::startDataCollection()
 
 void CompassConfig::progressCounter()
 {
+    // Update the fits and show the coverage of the worst compass
+    const CompassCalibrator::Result &result1 = m_compass1Calibrator.solve();
+    double coverage = result1.m_coverage;
+    bool complete = m_compass1Calibrator.isComplete();
+    QString status = tr("Compass 1: %1% covered, %2 samples").arg(qRound(result1.m_coverage * 100))
+                                                             .arg(result1.m_sampleCount);
+    if (m_haveSecondCompass) {
+        const CompassCalibrator::Result &result2 = m_compass2Calibrator.solve();
+        coverage = qMin(coverage, result2.m_coverage);
+        complete = complete && m_compass2Calibrator.isComplete();
+        status += tr("\nCompass 2: %1% covered, %2 samples").arg(qRound(result2.m_coverage * 100))
+                                                             .arg(result2.m_sampleCount);
+    }
 
-    int newValue = m_progressDialog->value()+1;
-    m_progressDialog->setValue(newValue);
-    if (newValue < 60) {
+    ++m_elapsedSeconds;
+    m_progressDialog->setLabelText(tr("Compass calibration in progress. Please rotate your craft around all its axes.\n\n")
+                                   + status);
+    m_progressDialog->setValue(qRound(coverage * 100));
+    if (complete) {
+        QLOG_INFO() << "Compass calibration complete after" << m_elapsedSeconds << "seconds";
+        finishCompassCalibration();
+    } else if (m_elapsedSeconds < 60) {
         m_timer->start(1000);
     } else {
         finishCompassCalibration();
@@ -427,16 +460,16 @@ void CompassConfig::cleanup()
 {
     if (m_timer) m_timer->stop();
     delete m_timer;
-    m_compass1RawImuList.clear();
-    m_compass2RawImuList.clear();
-    m_compass3RawImuList.clear();
+    m_compass1Calibrator.reset();
+    m_compass2Calibrator.reset();
+    m_compass3Calibrator.reset();
     delete m_progressDialog;
 }
 
 void CompassConfig::finishCompassCalibration()
 {
-    QLOG_INFO() << "finishCompassCalibration with compass 1:" << m_compass1RawImuList.count() << " data points";
-    QLOG_INFO() << "finishCompassCalibration with compass 2:" << m_compass2RawImuList.count() << " data points";
+    QLOG_INFO() << "finishCompassCalibration with compass 1:" << m_compass1Calibrator.sampleCount() << " data points";
+    QLOG_INFO() << "finishCompassCalibration with compass 2:" << m_compass2Calibrator.sampleCount() << " data points";
     disconnect(m_uas, SIGNAL(rawImuMessageUpdate(UASInterface*,mavlink_raw_imu_t)),
                 this, SLOT(rawImuMessageUpdate(UASInterface*,mavlink_raw_imu_t)));
     disconnect(m_uas, SIGNAL(scaledImu2MessageUpdate(UASInterface*,mavlink_scaled_imu2_t)),
@@ -446,44 +479,63 @@ void CompassConfig::finishCompassCalibration()
     m_timer->stop();
 
     // Calculate and send the update message
-    QVariant deviceId;
-    QString message; // resultant calibration message
-    Vector3d centerCompass1;
-    Vector3d centerCompass2;
+    QString message = calibrationResult(1, m_compass1Calibrator, MAV_SENSOR_OFFSET_MAGNETOMETER, QString());
 
-    QGCUASParamManager *paramMgr = m_uas->getParamManager();
+    if(m_haveSecondCompass) {
+        // Second Compass Calibration
+        message.append("\n\n" + calibrationResult(2, m_compass2Calibrator, MAV_SENSOR_OFFSET_MAGNETOMETER2, "2"));
+    }
+    cleanup();
 
-    if ( centerCompass1.setToLeastSquaresSphericalCenter(m_compass1RawImuList)){
-        saveOffsets(centerCompass1, MAV_SENSOR_OFFSET_MAGNETOMETER);
+    QMessageBox::information(this, tr("New Compass Offsets"), message + tr("\n\nThese have been saved for you."));
+}
 
-        paramMgr->getParameterValue(1, "COMPASS_DEV_ID", deviceId);
-        message = tr("New offsets (Compass 1) are \n\nx:") + QString::number(centerCompass1.x(),'f',3)
-                            + " y:" + QString::number(centerCompass1.y(),'f',3) + " z:" + QString::number(centerCompass1.z(),'f',3)
-                            + " dev id:" + deviceId.toString();
-    } else {
-        QLOG_ERROR() << "Not enough data points for calculation of compass 1:" ;
-        QMessageBox::warning(this, tr("Compass 1 Calibration Failed"), tr("Not enough data points to calibrate the compass."));
-        message = "\n" + tr("Compass 1 Calibration Failed");
+QString CompassConfig::calibrationResult(int compassNumber, CompassCalibrator &calibrator,
+                                         int sensorOffsetId, const QString &paramSuffix)
+{
+    const CompassCalibrator::Result &fit = calibrator.solve();
+    if (!fit.m_valid){
+        QLOG_ERROR() << "Not enough data points for calculation of compass" << compassNumber;
+        QMessageBox::warning(this, tr("Compass %1 Calibration Failed").arg(compassNumber),
+                             tr("Not enough data points to calibrate the compass."));
+        return tr("Compass %1 Calibration Failed").arg(compassNumber);
     }
 
-    if(m_haveSecondCompass) {
-        // Second Compass Calibration
-        if ( centerCompass2.setToLeastSquaresSphericalCenter(m_compass2RawImuList)){
-            saveOffsets(centerCompass2, MAV_SENSOR_OFFSET_MAGNETOMETER2);
-
-            paramMgr->getParameterValue(1, "COMPASS_DEV_ID2", deviceId);
-            message.append(tr("\n\nNew offsets (Compass 2) are \n\nx:") + QString::number(centerCompass2.x(),'f',3)
-                           + " y:" + QString::number(centerCompass2.y(),'f',3) + " z:" + QString::number(centerCompass2.z(),'f',3)
-                           + " dev id:" + deviceId.toString());
-        } else {
-            QLOG_ERROR() << "Not enough data points for calculation of compass 2:" ;
-            QMessageBox::warning(this, tr("Compass 2 Calibration Failed"), tr("Not enough data points to calibrate the compass."));
-            message = "\n" + tr("Compass 2 Calibration Failed");;
+    // The soft iron matrix of an incomplete data set is not reliable, only the
+    // offsets of a sphere fit are used then.
+    const bool complete = calibrator.isComplete();
+    CompassCalibrator::Result result = fit;
+    if (!complete){
+        QLOG_WARN() << "Compass" << compassNumber << "was not rotated in all directions, saving offsets only";
+        const CompassCalibrator::Result sphere = calibrator.sphereFit();
+        if (sphere.m_valid){
+            result = sphere;
         }
     }
-    cleanup();
 
-    QMessageBox::information(this, tr("New Compass Offsets"), message + tr("\n\nThese have been saved for you."));
+    QLOG_INFO() << "Compass" << compassNumber << (result.m_ellipsoid ? "ellipsoid" : "sphere") << "fit"
+                << "offsets" << result.m_offsets.x() << result.m_offsets.y() << result.m_offsets.z()
+                << "radius" << result.m_radius << "residual" << result.m_residual << "coverage" << result.m_coverage;
+    saveOffsets(result.m_offsets, sensorOffsetId);
+    const bool softIron = complete && saveSoftIron(result, paramSuffix);
+
+    QVariant deviceId;
+    m_uas->getParamManager()->getParameterValue(1, "COMPASS_DEV_ID" + paramSuffix, deviceId);
+    QString message = tr("New offsets (Compass %1) are \n\nx:").arg(compassNumber) + QString::number(result.m_offsets.x(),'f',3)
+                      + " y:" + QString::number(result.m_offsets.y(),'f',3) + " z:" + QString::number(result.m_offsets.z(),'f',3)
+                      + " dev id:" + deviceId.toString();
+    if (softIron){
+        message += tr("\nScale x:%1 y:%2 z:%3").arg(result.m_diagonals.x(),0,'f',3)
+                                               .arg(result.m_diagonals.y(),0,'f',3)
+                                               .arg(result.m_diagonals.z(),0,'f',3);
+    }
+    message += tr("\nCoverage %1%, fit error %2%").arg(qRound(result.m_coverage * 100))
+                                                   .arg(result.m_residual * 100, 0, 'f', 1);
+    if (!complete){
+        message += tr("\nThe compass was not rotated in all directions, only the offsets were saved."
+                      " Consider repeating the calibration.");
+    }
+    return message;
 }
 
 void CompassConfig::saveOffsets(const Vector3d &offset, int compassId)
@@ -497,15 +549,50 @@ void CompassConfig::saveOffsets(const Vector3d &offset, int compassId)
                           MAV_COMP_ID_PRIMARY);
 }
 
+bool CompassConfig::hasSoftIron(const QString &suffix)
+{
+    // Only firmware with soft iron support has COMPASS_DIA/COMPASS_ODI
+    QVariant value;
+    return m_uas->getParamManager()->getParameterValue(1, "COMPASS_DIA" + suffix + "_X", value);
+}
+
+bool CompassConfig::saveSoftIron(const CompassCalibrator::Result &result, const QString &suffix)
+{
+    if (!result.m_ellipsoid || !hasSoftIron(suffix)){
+        return false;
+    }
+    QGCUASParamManager* paramMgr = m_uas->getParamManager();
+    paramMgr->setParameter(1, "COMPASS_DIA" + suffix + "_X", result.m_diagonals.x());
+    paramMgr->setParameter(1, "COMPASS_DIA" + suffix + "_Y", result.m_diagonals.y());
+    paramMgr->setParameter(1, "COMPASS_DIA" + suffix + "_Z", result.m_diagonals.z());
+    paramMgr->setParameter(1, "COMPASS_ODI" + suffix + "_X", result.m_offDiagonals.x());
+    paramMgr->setParameter(1, "COMPASS_ODI" + suffix + "_Y", result.m_offDiagonals.y());
+    paramMgr->setParameter(1, "COMPASS_ODI" + suffix + "_Z", result.m_offDiagonals.z());
+    return true;
+}
+
+void CompassConfig::resetSoftIron(const QString &suffix)
+{
+    if (!hasSoftIron(suffix)){
+        return;
+    }
+    m_uas->setParameter(1, "COMPASS_DIA" + suffix + "_X", 1.0);
+    m_uas->setParameter(1, "COMPASS_DIA" + suffix + "_Y", 1.0);
+    m_uas->setParameter(1, "COMPASS_DIA" + suffix + "_Z", 1.0);
+    m_uas->setParameter(1, "COMPASS_ODI" + suffix + "_X", 0.0);
+    m_uas->setParameter(1, "COMPASS_ODI" + suffix + "_Y", 0.0);
+    m_uas->setParameter(1, "COMPASS_ODI" + suffix + "_Z", 0.0);
+}
+
 void CompassConfig::updateImuList(const Vector3d &currentReading, Vector3d &compassLastValue,
-                                  Vector3d &compassOffset, QVector<Vector3d> &list)
+                                  Vector3d &compassOffset, CompassCalibrator &calibrator)
 {
     if (isCalibratingCompass()){
         if (compassLastValue != currentReading){
             Vector3d adjustedValue;
             // Remove the current offset from the reading.
             adjustedValue = currentReading - compassOffset;
-            list.append(adjustedValue);
+            calibrator.addSample(adjustedValue);
 
             compassLastValue = currentReading;
         }
@@ -518,7 +605,7 @@ void CompassConfig::rawImuMessageUpdate(UASInterface* uas, mavlink_raw_imu_t raw
     QLOG_TRACE() << "RAW IMU x:" << rawImu.xmag << " y:" << rawImu.ymag << " z:" << rawImu.zmag;
     const Vector3d currentReading(rawImu.xmag, rawImu.ymag, rawImu.zmag);
     updateImuList(currentReading, m_compass1LastValue,
-                  m_compass1Offset, m_compass1RawImuList);
+                  m_compass1Offset, m_compass1Calibrator);
 }
 
 void CompassConfig::scaledImu2MessageUpdate(UASInterface* uas, mavlink_scaled_imu2_t scaledImu)
@@ -534,7 +621,7 @@ void CompassConfig::scaledImu2MessageUpdate(UASInterface* uas, mavlink_scaled_im
     m_haveSecondCompass = true;
     const Vector3d currentReading(scaledImu.xmag, scaledImu.ymag, scaledImu.zmag);
     updateImuList(currentReading, m_compass2LastValue,
-                  m_compass2Offset, m_compass2RawImuList);
+                  m_compass2Offset, m_compass2Calibrator);
 
 }
 
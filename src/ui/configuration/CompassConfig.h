@@ -34,6 +34,7 @@ This file is part of the APM_PLANNER project
 #include "UASManager.h"
 #include "UASInterface.h"
 #include "AP2ConfigWidget.h"
+#include "CompassCalibrator.h"
 #include <QWidget>
 #include <QProgressDialog>
 
@@ -85,6 +86,8 @@ private slots:
     void scaledImu2MessageUpdate(UASInterface* uas, mavlink_scaled_imu2_t scaledImu);
 
     void saveOffsets(const Vector3d &ofs, int compassId);
+    bool saveSoftIron(const CompassCalibrator::Result &result, const QString &suffix);
+    void resetSoftIron(const QString &suffix);
     void degreeEditFinished();
 
     void setCompassAPMOnBoard();
@@ -98,8 +101,11 @@ private:
     void readSettings();
     void writeSettings();
     void updateImuList(const Vector3d& currentReading, Vector3d& compassLastValue,
-                       Vector3d& compassOffset, QVector<Vector3d>& list);
+                       Vector3d& compassOffset, CompassCalibrator& calibrator);
+    QString calibrationResult(int compassNumber, CompassCalibrator& calibrator,
+                              int sensorOffsetId, const QString& paramSuffix);
     bool isCalibratingCompass() {return m_calibratingCompass;}
+    bool hasSoftIron(const QString& suffix);
 
 private:
     Ui::CompassConfig ui;
@@ -112,10 +118,11 @@ private:
     int m_compassId2;
     int m_compassId3;
 
-    // Compass Mag Readings
-    QVector<Vector3d> m_compass1RawImuList;
-    QVector<Vector3d> m_compass2RawImuList;
-    QVector<Vector3d> m_compass3RawImuList;
+    // Compass Mag Readings, fitted while they arrive
+    CompassCalibrator m_compass1Calibrator;
+    CompassCalibrator m_compass2Calibrator;
+    CompassCalibrator m_compass3Calibrator;
+    int m_elapsedSeconds;
 
     Vector3d m_compass1Offset;
     Vector3d m_compass2Offset;
@@ -7,6 +7,7 @@
 #include <QJsonObject>
 #include <QProcess>
 #include <QApplication>
+#include <QSettings>
 #include "logging.h"
 
 #define PROTO_OK 0x10
@@ -17,6 +18,12 @@
 #define PROTO_DEVICE_BOARD_REV 0x03
 #define PROTO_DEVICE_FW_SIZE 0x04
 #define PROTO_DEVICE_VEC_AREA 0x05
+#define PROTO_PROG_MULTI 0x27
+
+static const int PROG_MULTI_MAX_V2 = 60;    // PROG_MULTI payload of old bootloaders (rev < 3)
+static const int PROG_MULTI_MAX = 252;      // PROG_MULTI payload of current bootloaders, multiple of 4
+static const int DEFAULT_PACKETS_IN_FLIGHT = 4;
+static const int PROGRESS_INTERVAL = 16 * 1024;
 
 static const quint32 crctab[] =
 {
@@ -54,12 +61,55 @@ static const quint32 crctab[] =
     0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 };
 
-static quint32 crc32(const QByteArray src)
+/**
+ * @brief The Crc32Tables struct holds the tables for the slicing-by-8 CRC. table[0] is
+ *        crctab, table[k] advances table[k-1] by one more zero byte.
+ */
+struct Crc32Tables
 {
-    quint32 state = 0;
-    for (int i = 0; i < src.size(); i++) //Limited to half of 32bits, since QByteArray::size() is an integer. Shouldn't ever be larger anyway
+    quint32 table[8][256];
+
+    Crc32Tables()
     {
-        state = crctab[(state ^ static_cast<unsigned char>(src[i])) & 0xff] ^ (state >> 8);
+        for (int i = 0; i < 256; ++i)
+        {
+            table[0][i] = crctab[i];
+        }
+        for (int k = 1; k < 8; ++k)
+        {
+            for (int i = 0; i < 256; ++i)
+            {
+                table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xff];
+            }
+        }
+    }
+};
+
+/**
+ * @brief crc32 calculates the bootloader CRC processing 8 bytes per step
+ * @param data - the data
+ * @param size - number of bytes
+ * @param state - CRC of the preceding data, 0 to start
+ * @return - the CRC
+ */
+static quint32 crc32(const char *data, qint64 size, quint32 state = 0)
+{
+    static const Crc32Tables tables;
+    const quint32 (*table)[256] = tables.table;
+    const unsigned char *bytes = reinterpret_cast<const unsigned char*>(data);
+
+    while (size >= 8)
+    {
+        const quint32 one = (bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<quint32>(bytes[3]) << 24)) ^ state;
+        const quint32 two = bytes[4] | (bytes[5] << 8) | (bytes[6] << 16) | (static_cast<quint32>(bytes[7]) << 24);
+        state = table[7][one & 0xff] ^ table[6][(one >> 8) & 0xff] ^ table[5][(one >> 16) & 0xff] ^ table[4][one >> 24] ^
+                table[3][two & 0xff] ^ table[2][(two >> 8) & 0xff] ^ table[1][(two >> 16) & 0xff] ^ table[0][two >> 24];
+        bytes += 8;
+        size -= 8;
+    }
+    while (size-- > 0)
+    {
+        state = table[0][(state ^ *bytes++) & 0xff] ^ (state >> 8);
     }
     return state;
 }
@@ -67,8 +117,22 @@ static quint32 crc32(const QByteArray src)
 PX4FirmwareUploader::PX4FirmwareUploader(QObject *parent) :
     QThread(parent),
     m_waitingForSync(false),
-    m_currentSNAddress(0)
+    m_currentSNAddress(0),
+    m_flashSize(0),
+    m_bootloaderRev(0),
+    m_flashOffset(0),
+    m_lastProgressOffset(0),
+    m_packetsInFlight(0),
+    m_maxPacketsInFlight(DEFAULT_PACKETS_IN_FLIGHT),
+    m_progMultiMax(PROG_MULTI_MAX_V2)
+{
+    QSettings settings;
+    setMaxPacketsInFlight(settings.value("PX4_UPLOADER_PACKETS_IN_FLIGHT", DEFAULT_PACKETS_IN_FLIGHT).toInt());
+}
+
+void PX4FirmwareUploader::setMaxPacketsInFlight(int count)
 {
+    m_maxPacketsInFlight = qBound(1, count, 64);
 }
 
 void PX4FirmwareUploader::loadFile(QString filename)
@@ -153,11 +217,26 @@ void PX4FirmwareUploader::loadFile(QString filename)
     {
         uncompressed.append((char)0xFF);
     }
-    m_localChecksum = crc32(uncompressed);
-    tempFile = new QTemporaryFile(this);
-    tempFile->open();
-    tempFile->write(uncompressed);
-    tempFile->close();
+    m_firmware = uncompressed;
+    m_imageChecksum = crc32(m_firmware.constData(), m_firmware.size());
+
+    // A port given in the environment (e.g. a bootloader emulator on a pty) is used
+    // without waiting for a new port to show up.
+    const QString forcedPort = QString::fromLocal8Bit(qgetenv("APMPLANNER_PX4_UPLOADER_PORT"));
+    if (!forcedPort.isEmpty())
+    {
+        QLOG_INFO() << "Using port from APMPLANNER_PX4_UPLOADER_PORT:" << forcedPort;
+        mp_checkTimer->stop();
+        mp_checkTimer.reset();
+        m_portToUse = forcedPort;
+        m_devInfoList.append(PROTO_DEVICE_BL_REV);
+        m_devInfoList.append(PROTO_DEVICE_BOARD_ID);
+        m_devInfoList.append(PROTO_DEVICE_BOARD_REV);
+        m_devInfoList.append(PROTO_DEVICE_FW_SIZE);
+        emit devicePlugDetected();
+        emit kickOff();
+        return;
+    }
 
     QLOG_DEBUG() << "Requesting device replug";
     emit requestDevicePlug();
@@ -211,11 +290,13 @@ bool PX4FirmwareUploader::readChecksum()
         m_checksum += static_cast<unsigned char>(infobuf[1]) << 8;
         m_checksum += static_cast<unsigned char>(infobuf[2]) << 16;
         m_checksum += static_cast<unsigned char>(infobuf[3]) << 24;
-        for (int i=m_toflashbytes.size();i<m_flashSize;i++)
+        // The bootloader checksums the whole flash, the rest is erased (0xFF)
+        const QByteArray erased(4096, static_cast<char>(0xFF));
+        m_localChecksum = m_imageChecksum;
+        for (qint64 remaining = m_flashSize - m_firmware.size(); remaining > 0; remaining -= erased.size())
         {
-            m_toflashbytes.append((char)0xFF);
+            m_localChecksum = crc32(erased.constData(), qMin<qint64>(remaining, erased.size()), m_localChecksum);
         }
-        m_localChecksum = crc32(m_toflashbytes);
         return true;
     }
     return false;
@@ -353,48 +434,73 @@ void PX4FirmwareUploader::reqFlash()
     QLOG_INFO() << "Flash requested, flashing firmware";
     emit statusUpdate("Flashing Firmware");
     emit startFlashing();
-    tempFile->open();
     m_currentState = SEND_FW;
-    m_waitingForSync = true;
-    m_fwBytesCounter = 0;
+    m_waitingForSync = false;
+    m_flashOffset = 0;
+    m_lastProgressOffset = 0;
+    m_packetsInFlight = 0;
+    m_progMultiMax = m_bootloaderRev >= 3 ? PROG_MULTI_MAX : PROG_MULTI_MAX_V2;
+    QLOG_INFO() << "Flashing" << m_firmware.size() << "bytes in chunks of" << m_progMultiMax
+                << "bytes," << m_maxPacketsInFlight << "packets in flight";
+    m_flashTimer.start();
     sendNextFwBytes();
 }
 
 bool PX4FirmwareUploader::sendNextFwBytes()
 {
-    if (!tempFile)
-    {
-        QLOG_ERROR() << "Called sendNextFwBytes with no firmware file!";
-        return false;
-    }
     if (!mp_port)
     {
         QLOG_ERROR() << "Called sendNextFwBytes with a null port!";
         return false;
     }
-    if (tempFile->atEnd())
+    if (m_flashOffset >= m_firmware.size())
     {
-        tempFile->close();
-        delete tempFile;
-        tempFile = nullptr;
         return false;
     }
-    if (m_fwBytesCounter++ % 50 == 0)
+
+    // Fill the window. Every PROG_MULTI is answered with INSYNC/OK, the bootloader
+    // handles the packets in order, so several can be queued in the USB buffers.
+    QByteArray tosend;
+    while (m_packetsInFlight < m_maxPacketsInFlight && m_flashOffset < m_firmware.size())
     {
-        emit flashProgress(tempFile->pos(),tempFile->size());
-        QLOG_INFO() << "flashing:" << tempFile->pos() << "/" << tempFile->size();
+        const int count = qMin(m_progMultiMax, m_firmware.size() - m_flashOffset);
+        tosend.append(static_cast<char>(PROTO_PROG_MULTI));
+        tosend.append(static_cast<char>(count));
+        tosend.append(m_firmware.constData() + m_flashOffset, count);
+        tosend.append(static_cast<char>(PROTO_EOC));
+        m_flashOffset += count;
+        ++m_packetsInFlight;
+    }
+    if (!tosend.isEmpty())
+    {
+        mp_port->write(tosend);
+    }
+
+    if (m_flashOffset - m_lastProgressOffset >= PROGRESS_INTERVAL || m_flashOffset == m_firmware.size())
+    {
+        m_lastProgressOffset = m_flashOffset;
+        emit flashProgress(m_flashOffset, m_firmware.size());
+        QLOG_DEBUG() << "flashing:" << m_flashOffset << "/" << m_firmware.size();
     }
-    QByteArray bytes = tempFile->read(60);
-    m_toflashbytes.append(bytes);
-    QByteArray tosend;
-    tosend.append(0x27);
-    tosend.append(bytes.size());
-    tosend.append(bytes);
-    tosend.append(0x20);
-    mp_port->write(tosend);
     return true;
 }
 
+int PX4FirmwareUploader::readSyncReplies()
+{
+    int replies = 0;
+    while (mp_port->bytesAvailable() >= 2)
+    {
+        QByteArray infobuf = mp_port->read(2);
+        if (infobuf[0] != (char)0x12  || infobuf[1] != (char)0x10)
+        {
+            QLOG_INFO() << "Bad sync return:" << QString::number(infobuf[0],16) << QString::number(infobuf[1],16);
+            return -1;
+        }
+        ++replies;
+    }
+    return replies;
+}
+
 void PX4FirmwareUploader::getSNAddress(int address)
 {
     if (!mp_port)
@@ -486,6 +592,14 @@ bool PX4FirmwareUploader::readDeviceInfo()
         emit gotDeviceInfo(m_waitingDeviceInfoVar,reply);
         switch (m_waitingDeviceInfoVar)
         {
+            case PROTO_DEVICE_BL_REV:
+            {
+                QLOG_DEBUG() << "Bootloader Rev:" << reply;
+                emit statusUpdate("Bootloader Rev: " + QString::number(reply));
+                emit bootloaderRev(reply);
+                m_bootloaderRev = reply;
+            }
+                break;
             case PROTO_DEVICE_BOARD_ID:
             {
                 QLOG_DEBUG() << "Board ID:" << reply;
@@ -579,22 +693,27 @@ void PX4FirmwareUploader::portReadyRead()
     }
     else if (m_currentState == SEND_FW)
     {
-        if (m_waitingForSync)
+        const int replies = readSyncReplies();
+        if (replies < 0)
         {
-            if (getSync())
-            {
-                m_waitingForSync = false;
-                if (!sendNextFwBytes())
-                {
-                    //At end
-                    QLOG_INFO() << "finished writing firmware";
-                    emit statusUpdate("Flashing complete, verifying firmware");
-                    m_waitingForSync = false;
-                    reqChecksum();
-                    return;
-                }
-                m_waitingForSync = true;
-            }
+            QLOG_ERROR() << "Flashing failed at offset" << m_flashOffset;
+            emit error("Flashing failed, the bootloader rejected the firmware. Please try again");
+            emit statusUpdate("Flashing process stopped. Perhaps you should try again or use a different tool.");
+            mp_port->close();
+            mp_port.reset();    // calls deleteLater
+            emit complete();
+            return;
+        }
+        m_packetsInFlight -= replies;
+        if (!sendNextFwBytes() && m_packetsInFlight <= 0)
+        {
+            //At end
+            const double seconds = m_flashTimer.elapsed() / 1000.0;
+            QLOG_INFO() << "finished writing firmware:" << m_firmware.size() << "bytes in" << seconds << "seconds";
+            emit statusUpdate("Flashing complete, verifying firmware");
+            m_waitingForSync = false;
+            reqChecksum();
+            return;
         }
     }
     else if (m_currentState == REQ_CHECKSUM)
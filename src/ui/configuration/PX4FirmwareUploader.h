@@ -4,7 +4,7 @@
 #include <QThread>
 #include <QSerialPort>
 #include <QTimer>
-#include <QTemporaryFile>
+#include <QElapsedTimer>
 class PX4FirmwareUploader : public QThread
 {
     Q_OBJECT
@@ -21,6 +21,13 @@ public:
     void stop();
     void loadFile(QString filename);
 
+    /**
+     * @brief setMaxPacketsInFlight sets the number of PROG_MULTI packets sent
+     *        before waiting for the replies. Defaults to the PX4_UPLOADER_PACKETS_IN_FLIGHT
+     *        setting. 1 is the classic stop and wait flashing.
+     */
+    void setMaxPacketsInFlight(int count);
+
 private:
     QList<QString> m_portlist;
     QString m_portToUse;
@@ -39,7 +46,6 @@ private:
     bool readSN();
     int m_currentSNAddress;
     QByteArray m_snBytes;
-    int m_fwBytesCounter;
 
     bool reqNextDeviceInfo();
     void getDeviceInfo(unsigned char infobyte);
@@ -54,8 +60,9 @@ private:
     bool readChecksum();
     quint32 m_checksum;
     quint32 m_localChecksum;
+    quint32 m_imageChecksum;    ///< CRC of m_firmware, continued over the erased flash for m_localChecksum
     int m_flashSize;
-    QByteArray m_toflashbytes;
+    int m_bootloaderRev;
 
 
 
@@ -65,7 +72,14 @@ private:
 
 
     void reqFlash();
-    QTemporaryFile *tempFile;
+    int readSyncReplies();
+    QByteArray m_firmware;      ///< The image to flash, padded to a multiple of 4
+    int m_flashOffset;          ///< Bytes of m_firmware sent so far
+    int m_lastProgressOffset;
+    int m_packetsInFlight;      ///< PROG_MULTI packets not acknowledged yet
+    int m_maxPacketsInFlight;
+    int m_progMultiMax;         ///< Payload size of a PROG_MULTI packet
+    QElapsedTimer m_flashTimer;
 
 
 
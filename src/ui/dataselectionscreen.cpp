@@ -56,6 +56,27 @@ void DataSelectionScreen::enableItemList(QList<QString> &itemList)
     }
 }
 
+void DataSelectionScreen::removeGroups(const QString &prefix)
+{
+    // Disable the enabled items first so their graphs get removed
+    const QList<QString> enabledList(m_enabledList);
+    for(const auto &name : enabledList)
+    {
+        if(name.startsWith(prefix))
+        {
+            handleItem(name, Qt::Unchecked);
+        }
+    }
+
+    for(int i = ui.treeWidget->topLevelItemCount() - 1; i >= 0; --i)
+    {
+        if(ui.treeWidget->topLevelItem(i)->text(0).startsWith(prefix))
+        {
+            delete ui.treeWidget->takeTopLevelItem(i);
+        }
+    }
+}
+
 void DataSelectionScreen::addItem(QString name)
 {
     if (name.contains(":"))
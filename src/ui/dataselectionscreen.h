@@ -18,6 +18,7 @@ public:
     void disableItem(const QString &name);
     QList<QString> disableAllItems();
     void enableItemList(QList<QString> &itemList);
+    void removeGroups(const QString &prefix);
 
 
 signals:
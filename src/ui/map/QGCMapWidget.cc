@@ -7,12 +7,14 @@
 #include "Waypoint2DIcon.h"
 #include "UASWaypointManager.h"
 #include "ArduPilotMegaMAV.h"
-#include "WaypointNavigation.h"
+#include "WaypointPathOverlay.h"
 #include <QInputDialog>
+#include <QSet>
 
 QGCMapWidget::QGCMapWidget(QWidget *parent) :
     mapcontrol::OPMapWidget(parent),
     firingWaypointChange(NULL),
+    m_pathOverlay(NULL),
     maxUpdateInterval(2.1f), // 2 seconds
     followUAVEnabled(false),
     trailType(mapcontrol::UAVTrailType::ByTimeElapsed),
@@ -26,7 +28,8 @@ QGCMapWidget::QGCMapWidget(QWidget *parent) :
     configuration->SetCacheLocation(QGC::appDataDirectory() + "/mapscache/");
 
     currWPManager = UASManager::instance()->getActiveUASWaypointManager();
-    waypointLines.insert(0, new QGraphicsItemGroup(map));
+    m_pathOverlay = new WaypointPathOverlay(map, this);
+    m_pathOverlay->setWaypointManager(currWPManager, QColor(Qt::red));
     connect(currWPManager, SIGNAL(waypointEditableListChanged(int)), this, SLOT(updateWaypointList(int)));
     connect(currWPManager, SIGNAL(waypointEditableChanged(int, Waypoint*)), this, SLOT(updateWaypoint(int,Waypoint*)));
     connect(this, SIGNAL(waypointCreated(Waypoint*)), currWPManager, SLOT(addWaypointEditable(Waypoint*)));
@@ -394,22 +397,12 @@ void QGCMapWidget::activeUASSet(UASInterface* uas)
         disconnect(currWPManager, SIGNAL(waypointEditableChanged(int, Waypoint*)), this, SLOT(updateWaypoint(int,Waypoint*)));
         disconnect(this, SIGNAL(waypointCreated(Waypoint*)), currWPManager, SLOT(addWaypointEditable(Waypoint*)));
         disconnect(this, SIGNAL(waypointChanged(Waypoint*)), currWPManager, SLOT(notifyOfChangeEditable(Waypoint*)));
-
-        QGraphicsItemGroup* group = waypointLine(this->uas ? this->uas->getUASID() : 0);
-        if (group)
-        {
-            // Delete existing waypoint lines
-            foreach (QGraphicsItem* item, group->childItems())
-            {
-                group->removeFromGroup(item);
-                delete item;
-                item = 0;
-            }
-        }
     }
 
     this->uas = uas;
     this->currWPManager = uas->getWaypointManager();
+    // Removes the lines of the previous system
+    m_pathOverlay->setWaypointManager(currWPManager, uas->getColor());
 
     updateSelectedSystem(uas->getUASID());
     followUAVID = uas->getUASID();
@@ -754,73 +747,18 @@ void QGCMapWidget::updateWaypoint(int uas, Waypoint* wp)
     }
     // Currently only accept waypoint updates from the UAS in focus
     // this has to be changed to accept read-only updates from other systems as well.
-    UASInterface* uasInstance = UASManager::instance()->getUASForId(uas);
     if (currWPManager)
     {
-        // Only accept waypoints in global coordinate frame
-        if (((wp->getFrame() == MAV_FRAME_GLOBAL) ||
-             (wp->getFrame() == MAV_FRAME_GLOBAL_RELATIVE_ALT) ||
-             (wp->getFrame() == MAV_FRAME_GLOBAL_TERRAIN_ALT)) && (wp->isNavigationType() || wp->visibleOnMapWidget()))
-        {
-            // We're good, this is a global waypoint
+        // The lines are updated with the next frame, together with all other changes
+        m_pathOverlay->waypointChanged(wp);
 
+        if (isMapWaypoint(wp))
+        {
             // Get the index of this waypoint
             int wpindex = currWPManager->getIndexOf(wp);
             // If not found, return (this should never happen, but helps safety)
             if (wpindex < 0) return;
-            // Mark this wp as currently edited
-            firingWaypointChange = wp;
-
-            QLOG_TRACE() << "UPDATING WAYPOINT" << wpindex << "IN 2D MAP";
-
-            // Check if wp exists yet in map
-            if (!waypointsToIcons.contains(wp))
-            {
-                QLOG_TRACE() << "UPDATING NEW WAYPOINT" << wpindex << "IN 2D MAP";
-                // Create icon for new WP
-                QColor wpColor(Qt::red);
-                if (uasInstance) wpColor = uasInstance->getColor();
-                Waypoint2DIcon* icon = new Waypoint2DIcon(map, this, wp, wpColor, wpindex);
-                ConnectWP(icon);
-                icon->setParentItem(map);
-                // Update maps to allow inverse data association
-                waypointsToIcons.insert(wp, icon);
-                iconsToWaypoints.insert(icon, wp);
-            }
-            else
-            {
-                QLOG_TRACE() << "UPDATING EXISTING WAYPOINT" << wpindex << "IN 2D MAP";
-                // Waypoint exists, block it's signals and update it
-                mapcontrol::WayPointItem* icon = waypointsToIcons.value(wp);
-                // Make sure we don't die on a null pointer
-                // this should never happen, just a precaution
-                if (!icon) return;
-                // Block outgoing signals to prevent an infinite signal loop
-                // should not happen, just a precaution
-                this->blockSignals(true);
-                // Update the WP
-                Waypoint2DIcon* wpicon = dynamic_cast<Waypoint2DIcon*>(icon);
-                if (wpicon)
-                {
-                    // Let icon read out values directly from waypoint
-                    icon->SetNumber(wpindex);
-                    wpicon->updateWaypoint();
-                }
-                else
-                {
-                    // Use safe standard interfaces for non Waypoint-class based wps
-                    icon->SetCoord(internals::PointLatLng(wp->getLatitude(), wp->getLongitude()));
-                    icon->SetAltitude(wp->getAltitude());
-                    icon->SetHeading(wp->getYaw());
-                    icon->SetNumber(wpindex);
-                }
-                // Re-enable signals again
-                this->blockSignals(false);
-            }
-
-            redrawWaypointLines(uas);
-
-            firingWaypointChange = NULL;
+            updateWaypointIcon(uas, wp, wpindex);
         }
         else
         {
@@ -836,50 +774,70 @@ void QGCMapWidget::updateWaypoint(int uas, Waypoint* wp)
     }
 }
 
-void QGCMapWidget::redrawWaypointLines()
+bool QGCMapWidget::isMapWaypoint(const Waypoint* wp)
 {
-    redrawWaypointLines(uas ? uas->getUASID() : 0);
+    // Only accept waypoints in global coordinate frame
+    return ((wp->getFrame() == MAV_FRAME_GLOBAL) ||
+            (wp->getFrame() == MAV_FRAME_GLOBAL_RELATIVE_ALT) ||
+            (wp->getFrame() == MAV_FRAME_GLOBAL_TERRAIN_ALT)) && (wp->isNavigationType() || wp->visibleOnMapWidget());
 }
 
-void QGCMapWidget::redrawWaypointLines(int uas)
+void QGCMapWidget::updateWaypointIcon(int uas, Waypoint* wp, int wpindex)
 {
-    QLOG_TRACE() << "REDRAW WAYPOINT LINES FOR UAS" << uas;
-
-    if (!currWPManager)
-        return;
+    // Mark this wp as currently edited
+    firingWaypointChange = wp;
 
-    QGraphicsItemGroup* group = waypointLine(uas);
-    if (!group)
-        return;
-    Q_ASSERT(group->parentItem() == map);
+    QLOG_TRACE() << "UPDATING WAYPOINT" << wpindex << "IN 2D MAP";
 
-    // Delete existing waypoint lines
-    foreach (QGraphicsItem* item, group->childItems())
+    // Check if wp exists yet in map
+    mapcontrol::WayPointItem* icon = waypointsToIcons.value(wp, NULL);
+    if (!icon)
     {
-        QLOG_TRACE() << "DELETE EXISTING WAYPOINT LINES" << item;
-        delete item;
+        QLOG_TRACE() << "UPDATING NEW WAYPOINT" << wpindex << "IN 2D MAP";
+        // Create icon for new WP
+        QColor wpColor(Qt::red);
+        UASInterface* uasInstance = UASManager::instance()->getUASForId(uas);
+        if (uasInstance) wpColor = uasInstance->getColor();
+        icon = new Waypoint2DIcon(map, this, wp, wpColor, wpindex);
+        ConnectWP(icon);
+        icon->setParentItem(map);
+        // Update maps to allow inverse data association
+        waypointsToIcons.insert(wp, icon);
+        iconsToWaypoints.insert(icon, wp);
     }
-
-    QList<Waypoint*> wps = currWPManager->getGlobalFrameAndNavTypeWaypointList(true);
-    if (wps.size() > 1)
+    else
     {
-        QPainterPath path = WaypointNavigation::path(wps, *map);
-        if (path.elementCount() > 1)
+        QLOG_TRACE() << "UPDATING EXISTING WAYPOINT" << wpindex << "IN 2D MAP";
+        // Waypoint exists, block it's signals and update it
+        // Block outgoing signals to prevent an infinite signal loop
+        // should not happen, just a precaution
+        this->blockSignals(true);
+        // Update the WP
+        Waypoint2DIcon* wpicon = dynamic_cast<Waypoint2DIcon*>(icon);
+        if (wpicon)
+        {
+            // Let icon read out values directly from waypoint
+            icon->SetNumber(wpindex);
+            wpicon->updateWaypoint();
+        }
+        else
         {
-            QGraphicsPathItem* gpi = new QGraphicsPathItem(map);
-            gpi->setPath(path);
-
-            QColor color(Qt::red);
-            UASInterface* uasInstance = UASManager::instance()->getUASForId(uas);
-            if (uasInstance) color = uasInstance->getColor();
-            QPen pen(color);
-            pen.setWidth(2);
-            gpi->setPen(pen);
-
-            QLOG_TRACE() << "ADDING WAYPOINT LINES" << gpi;
-            group->addToGroup(gpi);
+            // Use safe standard interfaces for non Waypoint-class based wps
+            icon->SetCoord(internals::PointLatLng(wp->getLatitude(), wp->getLongitude()));
+            icon->SetAltitude(wp->getAltitude());
+            icon->SetHeading(wp->getYaw());
+            icon->SetNumber(wpindex);
         }
+        // Re-enable signals again
+        this->blockSignals(false);
     }
+
+    firingWaypointChange = NULL;
+}
+
+void QGCMapWidget::redrawWaypointLines()
+{
+    m_pathOverlay->invalidate();
 }
 
 /**
@@ -894,40 +852,42 @@ void QGCMapWidget::updateWaypointList(int uas)
     // this has to be changed to accept read-only updates from other systems as well.
     if (currWPManager)
     {
+        m_pathOverlay->waypointListChanged();
+
+        QSet<Waypoint*> wps;
+        foreach (Waypoint* wp, currWPManager->getGlobalFrameAndNavTypeWaypointList(false))
+        {
+            wps.insert(wp);
+        }
+
         // Delete first all old waypoints
-        // this is suboptimal (quadratic, but wps should stay in the sub-100 range anyway)
-        QList<Waypoint* > wps = currWPManager->getGlobalFrameAndNavTypeWaypointList(false);
-        foreach (Waypoint* wp, waypointsToIcons.keys())
+        QMap<Waypoint*, mapcontrol::WayPointItem*>::iterator iter = waypointsToIcons.begin();
+        while (iter != waypointsToIcons.end())
         {
-            if (!wps.contains(wp))
+            if (!wps.contains(iter.key()))
             {
-                QLOG_TRACE() << "DELETE EXISTING WP" << wp->getId();
-                // Get icon to work on
-                mapcontrol::WayPointItem* icon = waypointsToIcons.value(wp);
-                waypointsToIcons.remove(wp);
+                QLOG_TRACE() << "DELETE EXISTING WP" << iter.key();
+                mapcontrol::WayPointItem* icon = iter.value();
+                iter = waypointsToIcons.erase(iter);
                 iconsToWaypoints.remove(icon);
                 WPDelete(icon);
             }
+            else
+            {
+                ++iter;
+            }
         }
 
-        // Update all existing waypoints
-        foreach (Waypoint* wp, waypointsToIcons.keys())
-        {
-            QLOG_TRACE() << "UPDATING EXISTING WP" << wp->getId();
-            updateWaypoint(uas, wp);
-        }
-
-        // Update all potentially new waypoints
-        foreach (Waypoint* wp, wps)
+        // Update the existing and add the new waypoints in one pass.
+        // The icon number is the index in the whole list.
+        const QList<Waypoint*>& waypoints = currWPManager->getWaypointEditableList();
+        for (int wpindex = 0; wpindex < waypoints.size(); ++wpindex)
         {
-            // Update / add only if new
-            if (!waypointsToIcons.contains(wp))
+            Waypoint* wp = waypoints.at(wpindex);
+            if (wps.contains(wp) && isMapWaypoint(wp) && firingWaypointChange != wp)
             {
-                QLOG_TRACE() << "UPDATING NEW WP" << wp->getId();
-                updateWaypoint(uas, wp);
+                updateWaypointIcon(uas, wp, wpindex);
             }
         }
-
-//        redrawWaypointLines(uas);
     }
 }
@@ -8,6 +8,7 @@
 class UASInterface;
 class UASWaypointManager;
 class Waypoint;
+class WaypointPathOverlay;
 typedef mapcontrol::WayPointItem WayPointItem;
 
 /**
@@ -70,9 +71,8 @@ public slots:
     void updateWaypoint(int uas, Waypoint* wp);
     /** @brief Update the whole waypoint */
     void updateWaypointList(int uas);
-    /** @brief Redraw lines between waypoints */
+    /** @brief Redraw lines between waypoints with the next frame */
     void redrawWaypointLines();
-    void redrawWaypointLines(int uas);
     /** @brief Update the home position on the map */
     void updateHomePosition(double latitude, double longitude, double altitude);
     /** @brief Set update rate limit */
@@ -134,6 +134,10 @@ protected slots:
 private:
     void sendGuidedAction(Waypoint *wp, double alt);
     bool isValidGpsLocation(UASInterface* system) const;
+    /** @brief Check if the waypoint is shown with an icon on the map */
+    static bool isMapWaypoint(const Waypoint* wp);
+    /** @brief Create or update the icon of a waypoint. wpindex is the index in the whole list. */
+    void updateWaypointIcon(int uas, Waypoint* wp, int wpindex);
 
     void shiftOtherSelectedWaypoints(mapcontrol::WayPointItem* selectedWaypoint,
                                      double shiftLong, double shiftLat);
@@ -153,6 +157,7 @@ protected:
     QMap<Waypoint* , mapcontrol::WayPointItem*> waypointsToIcons;
     QMap<mapcontrol::WayPointItem*, Waypoint*> iconsToWaypoints;
     Waypoint* firingWaypointChange;
+    WaypointPathOverlay* m_pathOverlay; ///< Lines between the waypoints
     QTimer updateTimer;
     float maxUpdateInterval;
     enum editMode {
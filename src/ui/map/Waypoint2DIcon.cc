@@ -2,6 +2,7 @@
 #include "logging.h"
 #include "opmapcontrol.h"
 #include "QGC.h"
+#include "TerrainDatabase.h"
 #include <QPainter>
 
 Waypoint2DIcon::Waypoint2DIcon(mapcontrol::MapGraphicItem* map, mapcontrol::OPMapWidget* parent, qreal latitude, qreal longitude, qreal altitude, int listindex, QString name, QString description, int radius)
@@ -65,7 +66,18 @@ void Waypoint2DIcon::updateWaypoint()
 
         // QLOG_DEBUG() << "UPDATING WP:" << waypoint->getId() << "LAT:" << waypoint->getLatitude() << "LON:" << waypoint->getLongitude();
 
-        SetDescription(waypoint->getDescription());
+        // Add the terrain below the waypoint from the local tiles
+        QString description = waypoint->getDescription();
+        double terrainAlt = 0.0;
+        if (TerrainDatabase::instance()->elevation(waypoint->getLatitude(), waypoint->getLongitude(), terrainAlt))
+        {
+            description += QString("\nTerrain: %1 m").arg(terrainAlt, 0, 'f', 0);
+            if (waypoint->getFrame() == MAV_FRAME_GLOBAL)
+            {
+                description += QString(" (clearance %1 m)").arg(waypoint->getAltitude() - terrainAlt, 0, 'f', 0);
+            }
+        }
+        SetDescription(description);
         SetAltitude(waypoint->getAltitude());
         // FIXME Add SetNumber (currently needs a separate call)
         drawIcon();
@@ -0,0 +1,256 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file WaypointPathOverlay.cc
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the incremental mission path overlay of the 2D map
+ */
+
+#include "WaypointPathOverlay.h"
+#include "WaypointNavigation.h"
+#include "UASWaypointManager.h"
+#include "Waypoint.h"
+#include "logging.h"
+
+#include <QGraphicsPathItem>
+
+namespace
+{
+
+/**
+ * @brief markDirty marks the segments from first to last (exclusive) for update.
+ *        Segment 0 does not exist as no segment ends at home.
+ */
+void markDirty(QVector<bool> &dirty, int first, int last)
+{
+    last = qMin(last, dirty.size());
+    for (int i = qMax(first, 1); i < last; ++i)
+    {
+        dirty[i] = true;
+    }
+}
+
+}
+
+WaypointPathOverlay::WaypointState::WaypointState(const Waypoint &wp) :
+    m_x(wp.getX()),
+    m_y(wp.getY()),
+    m_z(wp.getZ()),
+    m_frame(wp.getFrame()),
+    m_action(wp.getAction())
+{
+    m_params[0] = wp.getParam1();
+    m_params[1] = wp.getParam2();
+    m_params[2] = wp.getParam3();
+    m_params[3] = wp.getParam4();
+}
+
+bool WaypointPathOverlay::WaypointState::operator==(const WaypointState &other) const
+{
+    return m_x == other.m_x && m_y == other.m_y && m_z == other.m_z
+            && m_params[0] == other.m_params[0] && m_params[1] == other.m_params[1]
+            && m_params[2] == other.m_params[2] && m_params[3] == other.m_params[3]
+            && m_frame == other.m_frame && m_action == other.m_action;
+}
+
+WaypointPathOverlay::WaypointPathOverlay(mapcontrol::MapGraphicItem *map, QObject *parent) :
+    QObject(parent),
+    m_map(map),
+    m_pen(Qt::red),
+    m_invalid(false)
+{
+    m_pen.setWidth(2);
+    m_updateTimer.setSingleShot(true);
+    m_updateTimer.setInterval(s_UpdateInterval);
+    connect(&m_updateTimer, SIGNAL(timeout()), this, SLOT(updateSegments()));
+}
+
+void WaypointPathOverlay::setWaypointManager(UASWaypointManager *manager, const QColor &color)
+{
+    clear();
+    m_manager = manager;
+    m_pen.setColor(color);
+    scheduleUpdate();
+}
+
+void WaypointPathOverlay::clear()
+{
+    foreach (QGraphicsPathItem *item, m_segments)
+    {
+        delete item;
+    }
+    m_waypoints.clear();
+    m_states.clear();
+    m_segments.clear();
+    m_starts.clear();
+    m_velocities.clear();
+    m_changed.clear();
+}
+
+void WaypointPathOverlay::waypointChanged(Waypoint *wp)
+{
+    m_changed.insert(wp);
+    scheduleUpdate();
+}
+
+void WaypointPathOverlay::waypointListChanged()
+{
+    // The list is compared with the drawn one on every update
+    scheduleUpdate();
+}
+
+void WaypointPathOverlay::invalidate()
+{
+    m_invalid = true;
+    scheduleUpdate();
+}
+
+void WaypointPathOverlay::scheduleUpdate()
+{
+    if (!m_updateTimer.isActive())
+    {
+        m_updateTimer.start();
+    }
+}
+
+void WaypointPathOverlay::updateSegments()
+{
+    if (!m_manager)
+    {
+        clear();
+        m_invalid = false;
+        return;
+    }
+
+    const QList<Waypoint*> wps = m_manager->getGlobalFrameAndNavTypeWaypointList(true);
+    const int oldCount = m_waypoints.size();
+    const int newCount = wps.size();
+    QVector<WaypointState> states;
+    states.reserve(newCount);
+    foreach (const Waypoint *wp, wps)
+    {
+        states.append(WaypointState(*wp));
+    }
+
+    // Keep the segments of the unchanged head and tail of the list
+    int head = 0;
+    while (head < oldCount && head < newCount && m_waypoints.at(head) == wps.at(head)
+           && m_states.at(head) == states.at(head))
+    {
+        ++head;
+    }
+    int tail = 0;
+    while (tail < oldCount - head && tail < newCount - head
+           && m_waypoints.at(oldCount - 1 - tail) == wps.at(newCount - 1 - tail)
+           && m_states.at(oldCount - 1 - tail) == states.at(newCount - 1 - tail))
+    {
+        ++tail;
+    }
+    const int removed = oldCount - head - tail;
+    const int inserted = newCount - head - tail;
+
+    for (int i = head; i < head + removed; ++i)
+    {
+        delete m_segments.at(i);
+    }
+    m_segments.remove(head, removed);
+    m_starts.remove(head, removed);
+    m_velocities.remove(head, removed);
+    m_segments.insert(head, inserted, NULL);
+    m_starts.insert(head, inserted, NULL);
+    m_velocities.insert(head, inserted, QPointF());
+    m_waypoints = wps;
+    m_states = states;
+
+    // A segment depends on the waypoints from two before up to one after its end
+    QVector<bool> dirty(newCount, m_invalid);
+    if (removed > 0 || inserted > 0)
+    {
+        markDirty(dirty, head - 1, head + inserted + 2);
+    }
+    if (!m_changed.isEmpty())
+    {
+        for (int i = 0; i < newCount; ++i)
+        {
+            if (m_changed.contains(wps.at(i)))
+            {
+                markDirty(dirty, i - 1, i + 3);
+            }
+        }
+    }
+
+    int start = 0;
+    int updated = 0;
+    bool velocityChanged = false;
+    for (int i = 1; i < newCount; ++i)
+    {
+        Waypoint *startWp = wps.at(start);
+        const bool spline = wps.at(i)->getAction() == MAV_CMD_NAV_SPLINE_WAYPOINT;
+
+        // The segment also follows its start waypoint (which is not the previous
+        // one if that has no path) and a spline the velocity of the previous segment
+        if (dirty.at(i) || (velocityChanged && spline)
+                || m_starts.at(i) != startWp || m_changed.contains(startWp))
+        {
+            QPointF velocity = m_velocities.at(i - 1);
+            setSegmentPath(i, WaypointNavigation::segment(wps, i, start, *m_map, velocity));
+            velocityChanged = velocity != m_velocities.at(i);
+            m_velocities[i] = velocity;
+            m_starts[i] = startWp;
+            ++updated;
+        }
+        else if (velocityChanged)
+        {
+            // Other segments just pass the velocity on
+            m_velocities[i] = m_velocities.at(i - 1);
+        }
+
+        if (WaypointNavigation::hasPath(*wps.at(i)))
+        {
+            start = i;
+        }
+    }
+
+    QLOG_TRACE() << "UPDATED" << updated << "OF" << qMax(newCount - 1, 0) << "WAYPOINT SEGMENTS";
+
+    m_changed.clear();
+    m_invalid = false;
+}
+
+void WaypointPathOverlay::setSegmentPath(int index, const QPainterPath &path)
+{
+    QGraphicsPathItem *item = m_segments.at(index);
+    if (path.isEmpty())
+    {
+        delete item;
+        m_segments[index] = NULL;
+        return;
+    }
+
+    if (!item)
+    {
+        item = new QGraphicsPathItem(m_map);
+        item->setPen(m_pen);
+        m_segments[index] = item;
+    }
+    item->setPath(path);
+}
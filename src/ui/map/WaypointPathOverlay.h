@@ -0,0 +1,145 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file WaypointPathOverlay.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the incremental mission path overlay of the 2D map
+ */
+
+#ifndef WAYPOINTPATHOVERLAY_H
+#define WAYPOINTPATHOVERLAY_H
+
+#include <QObject>
+#include <QList>
+#include <QVector>
+#include <QSet>
+#include <QPointF>
+#include <QPointer>
+#include <QPen>
+#include <QTimer>
+
+class Waypoint;
+class UASWaypointManager;
+class QGraphicsPathItem;
+class QPainterPath;
+
+namespace mapcontrol
+{
+    class MapGraphicItem;
+}
+
+/**
+ * @brief The WaypointPathOverlay class draws the path between the mission waypoints
+ *        on the map. Every waypoint owns the graphics item of the segment ending at it,
+ *        so a changed waypoint only updates the few segments depending on it and a
+ *        changed list only the segments of the changed range.
+ *        Changes are collected and applied once per frame, so dragging a waypoint
+ *        or moving the map does not rebuild the path for every notification.
+ */
+class WaypointPathOverlay : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief WaypointPathOverlay - CTOR
+     * @param map - map the segments are drawn on. The segment items are its children.
+     * @param parent - QObject parent
+     */
+    explicit WaypointPathOverlay(mapcontrol::MapGraphicItem *map, QObject *parent = 0);
+
+    /**
+     * @brief setWaypointManager sets the waypoint manager whose editable list is drawn.
+     *        Removes the segments of the previous manager.
+     * @param manager - the waypoint manager, may be NULL
+     * @param color - color of the path
+     */
+    void setWaypointManager(UASWaypointManager *manager, const QColor &color);
+
+    /**
+     * @brief clear removes all segments from the map
+     */
+    void clear();
+
+public slots:
+    /**
+     * @brief waypointChanged marks the segments depending on this waypoint for update
+     * @param wp - the changed waypoint
+     */
+    void waypointChanged(Waypoint *wp);
+
+    /**
+     * @brief waypointListChanged marks the waypoint list for update. Only the segments
+     *        of the range which differs from the drawn list are recreated.
+     */
+    void waypointListChanged();
+
+    /**
+     * @brief invalidate marks all segments for update (e.g. map moved or zoomed)
+     */
+    void invalidate();
+
+private slots:
+    /**
+     * @brief updateSegments applies all collected changes
+     */
+    void updateSegments();
+
+private:
+    static constexpr int s_UpdateInterval = 16;     ///< Time in ms changes are collected (about one frame)
+
+    /**
+     * @brief The WaypointState struct holds what the path of a waypoint depends on.
+     *        Reloading a mission deletes the waypoints and may allocate new ones at
+     *        the same addresses, so the pointer alone does not identify a waypoint.
+     */
+    struct WaypointState
+    {
+        double m_x;
+        double m_y;
+        double m_z;
+        double m_params[4];
+        int m_frame;
+        int m_action;
+
+        explicit WaypointState(const Waypoint &wp);
+        bool operator==(const WaypointState &other) const;
+    };
+
+    mapcontrol::MapGraphicItem *m_map;              ///< Map the segments are drawn on
+    QPointer<UASWaypointManager> m_manager;         ///< Waypoint manager providing the mission
+    QPen m_pen;                                     ///< Pen of all segments
+
+    QList<Waypoint*> m_waypoints;                   ///< Waypoints the segments were built for
+    QVector<WaypointState> m_states;                ///< State of m_waypoints when the segments were built
+    QVector<QGraphicsPathItem*> m_segments;         ///< Segment ending at the waypoint of the same index. NULL if there is none.
+    QVector<Waypoint*> m_starts;                    ///< Waypoint each segment starts at
+    QVector<QPointF> m_velocities;                  ///< Spline velocity at the end of each segment
+
+    QSet<Waypoint*> m_changed;                      ///< Waypoints changed since the last update
+    bool m_invalid;                                 ///< All segments need an update
+    QTimer m_updateTimer;                           ///< Single shot timer batching the updates
+
+    void scheduleUpdate();
+    void setSegmentPath(int index, const QPainterPath &path);
+};
+
+#endif // WAYPOINTPATHOVERLAY_H
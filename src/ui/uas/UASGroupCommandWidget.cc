@@ -0,0 +1,365 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file UASGroupCommandWidget.cc
+ * @date 18 Oct 2026
+ * @brief File providing implementation for the widget which commands several vehicles at once
+ */
+
+#include "UASGroupCommandWidget.h"
+#include "UASManager.h"
+#include "UASInterface.h"
+#include "LinkManager.h"
+#include "MAVLinkCommandDispatcher.h"
+#include "ApmUiHelpers.h"
+#include "logging.h"
+
+#include <QComboBox>
+#include <QDoubleSpinBox>
+#include <QGridLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+UASGroupCommandWidget::UASGroupCommandWidget(QWidget *parent) :
+    QWidget(parent),
+    m_vehicleTree(new QTreeWidget(this)),
+    m_armButton(new QPushButton(tr("Arm"), this)),
+    m_disarmButton(new QPushButton(tr("Disarm"), this)),
+    m_modeComboBox(new QComboBox(this)),
+    m_setModeButton(new QPushButton(tr("Set Mode"), this)),
+    m_altitudeSpinBox(new QDoubleSpinBox(this)),
+    m_altitudeButton(new QPushButton(tr("Change Alt"), this)),
+    m_statusLabel(new QLabel(this)),
+    m_modeClass(NoVehicle),
+    m_groupId(-1)
+{
+    m_vehicleTree->setColumnCount(ColumnCount);
+    m_vehicleTree->setHeaderLabels(QStringList() << tr("Group") << tr("Result") << tr("Latency"));
+    m_vehicleTree->setRootIsDecorated(false);
+    m_vehicleTree->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_vehicleTree->setMaximumHeight(120);
+
+    m_altitudeSpinBox->setRange(0.0, 1000.0);
+    m_altitudeSpinBox->setValue(10.0);
+    m_altitudeSpinBox->setSuffix(tr(" m"));
+    m_altitudeSpinBox->setToolTip(tr("Altitude above home"));
+    m_statusLabel->setWordWrap(true);
+
+    QGridLayout *commandLayout = new QGridLayout();
+    commandLayout->addWidget(m_armButton, 0, 0);
+    commandLayout->addWidget(m_disarmButton, 0, 1);
+    commandLayout->addWidget(m_modeComboBox, 1, 0);
+    commandLayout->addWidget(m_setModeButton, 1, 1);
+    commandLayout->addWidget(m_altitudeSpinBox, 2, 0);
+    commandLayout->addWidget(m_altitudeButton, 2, 1);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setMargin(0);
+    layout->addWidget(m_vehicleTree);
+    layout->addLayout(commandLayout);
+    layout->addWidget(m_statusLabel);
+
+    connect(m_vehicleTree, SIGNAL(itemChanged(QTreeWidgetItem*,int)), this, SLOT(selectionChanged()));
+    connect(m_armButton, SIGNAL(clicked()), this, SLOT(armClicked()));
+    connect(m_disarmButton, SIGNAL(clicked()), this, SLOT(disarmClicked()));
+    connect(m_setModeButton, SIGNAL(clicked()), this, SLOT(setModeClicked()));
+    connect(m_altitudeButton, SIGNAL(clicked()), this, SLOT(changeAltitudeClicked()));
+
+    MAVLinkCommandDispatcher *dispatcher = LinkManager::instance()->getCommandDispatcher();
+    connect(dispatcher, SIGNAL(vehicleAcknowledged(int,int,int,qint64)), this, SLOT(vehicleAcknowledged(int,int,int,qint64)));
+    connect(dispatcher, SIGNAL(groupFinished(int)), this, SLOT(groupFinished(int)));
+
+    connect(UASManager::instance(), SIGNAL(UASCreated(UASInterface*)), this, SLOT(addUAS(UASInterface*)));
+    connect(UASManager::instance(), SIGNAL(UASDeleted(UASInterface*)), this, SLOT(removeUAS(UASInterface*)));
+    foreach (UASInterface *uas, UASManager::instance()->getUASList())
+    {
+        addUAS(uas);
+    }
+    selectionChanged();
+}
+
+void UASGroupCommandWidget::addUAS(UASInterface *uas)
+{
+    if (itemOfSystem(uas->getUASID()))
+    {
+        return;
+    }
+    // Vehicles join the group when checked, nothing is commanded by surprise
+    QTreeWidgetItem *item = new QTreeWidgetItem();
+    item->setText(ColumnVehicle, uas->getUASName());
+    item->setData(ColumnVehicle, Qt::UserRole, uas->getUASID());
+    item->setFlags(Qt::ItemIsEnabled | Qt::ItemIsUserCheckable);
+    item->setCheckState(ColumnVehicle, Qt::Unchecked);
+    m_vehicleTree->addTopLevelItem(item);
+}
+
+void UASGroupCommandWidget::removeUAS(UASInterface *uas)
+{
+    delete itemOfSystem(uas->getUASID());
+    selectionChanged();
+}
+
+void UASGroupCommandWidget::selectionChanged()
+{
+    const QList<UASInterface*> vehicles = selectedVehicles();
+    VehicleClass vehicleClass = NoVehicle;
+    foreach (UASInterface *uas, vehicles)
+    {
+        const VehicleClass uasClass = vehicleClassOf(uas);
+        vehicleClass = (vehicleClass == NoVehicle || vehicleClass == uasClass) ? uasClass : MixedVehicles;
+    }
+
+    if (vehicleClass != m_modeClass)
+    {
+        m_modeClass = vehicleClass;
+        switch (vehicleClass)
+        {
+        case Copter:
+            ApmUiHelpers::addCopterModes(m_modeComboBox);
+            break;
+        case Plane:
+            ApmUiHelpers::addPlaneModes(m_modeComboBox);
+            break;
+        case Rover:
+            ApmUiHelpers::addRoverModes(m_modeComboBox);
+            break;
+        default:
+            m_modeComboBox->clear();
+            break;
+        }
+    }
+
+    const bool haveVehicles = !vehicles.isEmpty();
+    m_armButton->setEnabled(haveVehicles);
+    m_disarmButton->setEnabled(haveVehicles);
+    m_setModeButton->setEnabled(m_modeComboBox->count() > 0);
+    m_modeComboBox->setEnabled(m_modeComboBox->count() > 0);
+    m_modeComboBox->setToolTip(vehicleClass == MixedVehicles ? tr("Modes can only be set for vehicles of the same type") : QString());
+    m_altitudeButton->setEnabled(haveVehicles && vehicleClass != Rover);
+}
+
+void UASGroupCommandWidget::armClicked()
+{
+    const QList<int> systemIds = selectedSystemIds();
+    if (QMessageBox::question(this, tr("Arm Vehicles"), tr("Arm %n vehicle(s)?", "", systemIds.size()),
+                              QMessageBox::Yes | QMessageBox::No, QMessageBox::No) != QMessageBox::Yes)
+    {
+        return;
+    }
+    showGroup(tr("Arm"), LinkManager::instance()->getCommandDispatcher()->setArmed(systemIds, true));
+}
+
+void UASGroupCommandWidget::disarmClicked()
+{
+    showGroup(tr("Disarm"), LinkManager::instance()->getCommandDispatcher()->setArmed(selectedSystemIds(), false));
+}
+
+void UASGroupCommandWidget::setModeClicked()
+{
+    const uint32_t customMode = m_modeComboBox->currentData().toUInt();
+    showGroup(tr("Mode %1").arg(m_modeComboBox->currentText()),
+              LinkManager::instance()->getCommandDispatcher()->setMode(selectedSystemIds(), customMode));
+}
+
+void UASGroupCommandWidget::changeAltitudeClicked()
+{
+    // Every vehicle keeps its position and climbs or descends to the same height above its home
+    QMap<int, MAVLinkCommandDispatcher::GlobalPosition> positions;
+    QStringList unknown;
+    foreach (UASInterface *uas, selectedVehicles())
+    {
+        if (!uas->globalPositionKnown())
+        {
+            unknown.append(uas->getUASName());
+            continue;
+        }
+        const double homeAltitude = uas->getAltitudeAMSL() - uas->getAltitudeRelative();
+        MAVLinkCommandDispatcher::GlobalPosition position;
+        position.m_latitude = uas->getLatitude();
+        position.m_longitude = uas->getLongitude();
+        position.m_altitude = homeAltitude + m_altitudeSpinBox->value();
+        positions.insert(uas->getUASID(), position);
+    }
+    if (!unknown.isEmpty())
+    {
+        QMessageBox::warning(this, tr("Change Altitude"), tr("No position of %1, these vehicles are left out.").arg(unknown.join(", ")));
+    }
+    if (!positions.isEmpty())
+    {
+        showGroup(tr("Altitude %1 m").arg(m_altitudeSpinBox->value()),
+                  LinkManager::instance()->getCommandDispatcher()->reposition(positions));
+    }
+}
+
+void UASGroupCommandWidget::vehicleAcknowledged(int groupId, int systemId, int result, qint64 latencyUsecs)
+{
+    QTreeWidgetItem *item = itemOfSystem(systemId);
+    if (groupId != m_groupId || !item)
+    {
+        return;
+    }
+    item->setText(ColumnResult, resultText(result));
+    item->setText(ColumnLatency, latencyUsecs >= 0 ? tr("%1 ms").arg(latencyUsecs / 1000.0, 0, 'f', 1) : QString());
+}
+
+void UASGroupCommandWidget::groupFinished(int groupId)
+{
+    if (groupId != m_groupId)
+    {
+        return;
+    }
+    const MAVLinkCommandDispatcher::GroupStatus status = LinkManager::instance()->getCommandDispatcher()->getStatus(groupId);
+    int accepted = 0;
+    foreach (const MAVLinkCommandDispatcher::VehicleStatus &vehicle, status.m_vehicles)
+    {
+        if (vehicle.m_result == MAV_RESULT_ACCEPTED)
+        {
+            ++accepted;
+        }
+        QTreeWidgetItem *item = itemOfSystem(vehicle.m_systemId);
+        if (item)
+        {
+            item->setText(ColumnResult, resultText(vehicle.m_result));
+        }
+    }
+    m_statusLabel->setText(tr("%1: %2 of %3 accepted, dispatch skew %4 ms")
+                           .arg(m_groupName).arg(accepted).arg(status.m_vehicles.size())
+                           .arg(status.m_dispatchSkewUsecs / 1000.0, 0, 'f', 2));
+    QLOG_INFO() << "Group command" << m_groupName << ":" << accepted << "of" << status.m_vehicles.size()
+                << "accepted, skew" << status.m_dispatchSkewUsecs << "us";
+}
+
+UASGroupCommandWidget::VehicleClass UASGroupCommandWidget::vehicleClassOf(UASInterface *uas)
+{
+    if (uas->isMultirotor())
+    {
+        return Copter;
+    }
+    if (uas->isFixedWing())
+    {
+        return Plane;
+    }
+    if (uas->isGroundRover())
+    {
+        return Rover;
+    }
+    return MixedVehicles;   // no known mode list
+}
+
+QString UASGroupCommandWidget::resultText(int result)
+{
+    switch (result)
+    {
+    case MAVLinkCommandDispatcher::s_ResultPending:
+        return tr("Pending");
+    case MAVLinkCommandDispatcher::s_ResultNoAck:
+        return tr("No answer");
+    case MAV_RESULT_ACCEPTED:
+        return tr("Accepted");
+    case MAV_RESULT_TEMPORARILY_REJECTED:
+        return tr("Rejected");
+    case MAV_RESULT_DENIED:
+        return tr("Denied");
+    case MAV_RESULT_UNSUPPORTED:
+        return tr("Unsupported");
+    case MAV_RESULT_FAILED:
+        return tr("Failed");
+    case MAV_RESULT_IN_PROGRESS:
+        return tr("In progress");
+    default:
+        return tr("Result %1").arg(result);
+    }
+}
+
+QList<UASInterface*> UASGroupCommandWidget::selectedVehicles() const
+{
+    QList<UASInterface*> vehicles;
+    foreach (int systemId, selectedSystemIds())
+    {
+        UASInterface *uas = UASManager::instance()->getUASForId(systemId);
+        if (uas)
+        {
+            vehicles.append(uas);
+        }
+    }
+    return vehicles;
+}
+
+QList<int> UASGroupCommandWidget::selectedSystemIds() const
+{
+    QList<int> systemIds;
+    for (int i = 0; i < m_vehicleTree->topLevelItemCount(); ++i)
+    {
+        const QTreeWidgetItem *item = m_vehicleTree->topLevelItem(i);
+        if (item->checkState(ColumnVehicle) == Qt::Checked)
+        {
+            systemIds.append(item->data(ColumnVehicle, Qt::UserRole).toInt());
+        }
+    }
+    return systemIds;
+}
+
+QTreeWidgetItem *UASGroupCommandWidget::itemOfSystem(int systemId) const
+{
+    for (int i = 0; i < m_vehicleTree->topLevelItemCount(); ++i)
+    {
+        QTreeWidgetItem *item = m_vehicleTree->topLevelItem(i);
+        if (item->data(ColumnVehicle, Qt::UserRole).toInt() == systemId)
+        {
+            return item;
+        }
+    }
+    return nullptr;
+}
+
+void UASGroupCommandWidget::showGroup(const QString &name, int groupId)
+{
+    m_groupId = groupId;
+    m_groupName = name;
+    for (int i = 0; i < m_vehicleTree->topLevelItemCount(); ++i)
+    {
+        m_vehicleTree->topLevelItem(i)->setText(ColumnResult, QString());
+        m_vehicleTree->topLevelItem(i)->setText(ColumnLatency, QString());
+    }
+    if (groupId < 0)
+    {
+        m_statusLabel->setText(tr("%1: no vehicle could be reached").arg(name));
+        return;
+    }
+
+    const MAVLinkCommandDispatcher::GroupStatus status = LinkManager::instance()->getCommandDispatcher()->getStatus(groupId);
+    foreach (const MAVLinkCommandDispatcher::VehicleStatus &vehicle, status.m_vehicles)
+    {
+        QTreeWidgetItem *item = itemOfSystem(vehicle.m_systemId);
+        if (item)
+        {
+            item->setText(ColumnResult, resultText(vehicle.m_result));
+        }
+    }
+    m_statusLabel->setText(tr("%1: sent to %2 vehicle(s), dispatch skew %3 ms")
+                           .arg(name).arg(status.m_vehicles.size())
+                           .arg(status.m_dispatchSkewUsecs / 1000.0, 0, 'f', 2));
+}
@@ -0,0 +1,115 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file UASGroupCommandWidget.h
+ * @date 18 Oct 2026
+ * @brief File providing header for the widget which commands several vehicles at once
+ */
+
+#ifndef UASGROUPCOMMANDWIDGET_H
+#define UASGROUPCOMMANDWIDGET_H
+
+#include <QWidget>
+
+class UASInterface;
+class QComboBox;
+class QDoubleSpinBox;
+class QLabel;
+class QPushButton;
+class QTreeWidget;
+class QTreeWidgetItem;
+
+/**
+ * @brief The UASGroupCommandWidget class arms, disarms, switches the mode of and
+ *        changes the altitude of all checked vehicles with one group command of the
+ *        MAVLinkCommandDispatcher, so the vehicles get the command with minimal skew.
+ *        The acknowledge and latency of each vehicle and the dispatch skew of the
+ *        group are shown as they arrive.
+ */
+class UASGroupCommandWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit UASGroupCommandWidget(QWidget *parent = nullptr);
+
+private slots:
+    void addUAS(UASInterface *uas);
+    void removeUAS(UASInterface *uas);
+    void selectionChanged();
+    void armClicked();
+    void disarmClicked();
+    void setModeClicked();
+    void changeAltitudeClicked();
+    void vehicleAcknowledged(int groupId, int systemId, int result, qint64 latencyUsecs);
+    void groupFinished(int groupId);
+
+private:
+    enum Column
+    {
+        ColumnVehicle,
+        ColumnResult,
+        ColumnLatency,
+        ColumnCount
+    };
+
+    /**
+     * @brief The VehicleClass enum selects the mode list. Modes can only be set
+     *        for a group of the same class, the mode numbers differ between them.
+     */
+    enum VehicleClass
+    {
+        NoVehicle,
+        Copter,
+        Plane,
+        Rover,
+        MixedVehicles
+    };
+
+    static VehicleClass vehicleClassOf(UASInterface *uas);
+    static QString resultText(int result);
+
+    QList<UASInterface*> selectedVehicles() const;
+    QList<int> selectedSystemIds() const;
+    QTreeWidgetItem *itemOfSystem(int systemId) const;
+
+    /**
+     * @brief showGroup shows a new group command in the status
+     * @param name - name of the command
+     * @param groupId - id of the group, -1 if no vehicle could be reached
+     */
+    void showGroup(const QString &name, int groupId);
+
+    QTreeWidget *m_vehicleTree;
+    QPushButton *m_armButton;
+    QPushButton *m_disarmButton;
+    QComboBox *m_modeComboBox;
+    QPushButton *m_setModeButton;
+    QDoubleSpinBox *m_altitudeSpinBox;
+    QPushButton *m_altitudeButton;
+    QLabel *m_statusLabel;
+    VehicleClass m_modeClass;       ///< Vehicle class the mode list is filled for
+    int m_groupId;                  ///< Group shown in the status, -1 for none
+    QString m_groupName;            ///< Name of the command of m_groupId
+};
+
+#endif // UASGROUPCOMMANDWIDGET_H
@@ -31,6 +31,7 @@ This file is part of the PIXHAWK project
 #include "UASManager.h"
 #include "UASView.h"
 #include "QGCUnconnectedInfoWidget.h"
+#include "UASGroupCommandWidget.h"
 
 #include <QString>
 #include <QTimer>
@@ -47,7 +48,7 @@ UASListWidget::UASListWidget(QWidget *parent) : QWidget(parent),
     m_ui->setupUi(this);
 
     // Setup container for scrollbar
-    mainLayout = new QHBoxLayout(this);
+    mainLayout = new QVBoxLayout(this);
     mainLayout->setMargin(0);
     scrollArea = new QScrollArea(this);
     scrollArea->setWidgetResizable(true);
@@ -62,6 +63,8 @@ UASListWidget::UASListWidget(QWidget *parent) : QWidget(parent),
     scrollArea->setWidget(scrollAreaWidgetContents);
 
     mainLayout->addWidget(scrollArea);
+    // Commands for several vehicles at once below the list
+    mainLayout->addWidget(new UASGroupCommandWidget(this));
     this->setLayout(mainLayout);
     setObjectName("UNMANNED_SYSTEMS_LIST");
 
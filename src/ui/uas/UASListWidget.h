@@ -55,7 +55,7 @@ public slots:
 
 protected:
     QMap<UASInterface*, UASView*> uasViews;
-    QHBoxLayout* mainLayout;
+    QVBoxLayout* mainLayout;
     QScrollArea* scrollArea;
     QWidget* scrollAreaWidgetContents;
     QVBoxLayout* listLayout;
@@ -5,7 +5,9 @@
 #include <QMetaMethod>
 #include <QSettings>
 #include <QInputDialog>
-UASQuickView::UASQuickView(QWidget *parent) : QWidget(parent)
+UASQuickView::UASQuickView(QWidget *parent) : QWidget(parent),
+    uas(nullptr),
+    m_lastStoreGeneration(0)
 {
     quickViewSelectDialog=0;
     m_columnCount=2;
@@ -29,7 +31,7 @@ UASQuickView::UASQuickView(QWidget *parent) : QWidget(parent)
     loadSettings();
 
     //If we don't have any predefined settings, set some defaults.
-    if (uasPropertyValueMap.size() == 0)
+    if (uasPropertyKeyMap.size() == 0)
     {
         m_columnCount = 2;
         valueEnabled("GCS Metric.Alt MSL (m)");
@@ -86,7 +88,7 @@ void UASQuickView::replaceSingleItem(QString olditem)
     UASQuickViewItemSelect *itemSelect = new UASQuickViewItemSelect(true);
     itemSelect->setAttribute(Qt::WA_DeleteOnClose,true);
     connect(itemSelect,SIGNAL(valueSwapped(QString,QString)),this,SLOT(replaceSingleItemSelected(QString,QString)));
-    for (QMap<QString,double>::const_iterator i = uasPropertyValueMap.constBegin();i!=uasPropertyValueMap.constEnd();i++)
+    for (QMap<QString,int>::const_iterator i = uasPropertyKeyMap.constBegin();i!=uasPropertyKeyMap.constEnd();i++)
     {
         if (i.key().contains(olditem))
         {
@@ -115,10 +117,7 @@ void UASQuickView::replaceSingleItemSelected(QString newitem,QString olditem)
         uasPropertyToLabelMap[newitem] = olditemptr;
 
 
-        uasPropertyValueMap.remove(olditem);
-        uasPropertyValueMap.remove(newitem);
-        uasPropertyValueMap[newitem] = 0;
-        uasPropertyValueMap[olditem] = 0;
+        // The keys stay with the property names, only the display items are swapped
         olditemptr->setTitle(newitem);
         newitemptr->setTitle(olditem);
 
@@ -134,8 +133,10 @@ void UASQuickView::replaceSingleItemSelected(QString newitem,QString olditem)
         UASQuickViewItem *item = uasPropertyToLabelMap[olditem];
         uasPropertyToLabelMap.remove(olditem);
         uasPropertyToLabelMap[newitem] = item;
-        uasPropertyValueMap.remove(olditem);
-        uasPropertyValueMap[newitem] = 0;
+        if (!uasPropertyKeyMap.contains(newitem))
+        {
+            uasPropertyKeyMap[newitem] = -1;
+        }
         item->setTitle(newitem);
         int index = m_PropertyToLayoutIndexMap[olditem];
         m_PropertyToLayoutIndexMap.remove(olditem);
@@ -160,7 +161,7 @@ void UASQuickView::actionTriggered()
     connect(quickViewSelectDialog,SIGNAL(valueDisabled(QString)),this,SLOT(valueDisabled(QString)));
     connect(quickViewSelectDialog,SIGNAL(valueEnabled(QString)),this,SLOT(quickViewValueChanged(QString)));
     quickViewSelectDialog->setAttribute(Qt::WA_DeleteOnClose,true);
-    for (QMap<QString,double>::const_iterator i = uasPropertyValueMap.constBegin();i!=uasPropertyValueMap.constEnd();i++)
+    for (QMap<QString,int>::const_iterator i = uasPropertyKeyMap.constBegin();i!=uasPropertyKeyMap.constEnd();i++)
     {
         quickViewSelectDialog->addItem(i.key(),uasEnabledPropertyList.contains(i.key()));
     }
@@ -229,9 +230,9 @@ void UASQuickView::valueEnabled(const QString &value)
     uasPropertyToLabelMap[value] = item;
     uasEnabledPropertyList.append(value);
 
-    if (!uasPropertyValueMap.contains(value))
+    if (!uasPropertyKeyMap.contains(value))
     {
-        uasPropertyValueMap[value] = 0;
+        uasPropertyKeyMap[value] = -1;
     }
     item->show();
     sortItems(m_columnCount);
@@ -331,13 +332,45 @@ void UASQuickView::selectDialogClosed()
 
 void UASQuickView::updateTimerTick()
 {
-    //uasPropertyValueMap
+    if (!m_telemetryStorePtr)
+    {
+        return;
+    }
+    const quint64 generation = m_telemetryStorePtr->generation();
+    if (generation == m_lastStoreGeneration)
+    {
+        // Nothing received since last update
+        return;
+    }
+    m_lastStoreGeneration = generation;
+    updateKnownProperties();
+
+    UASTelemetryStore::Value value;
     for (QMap<QString,UASQuickViewItem*>::const_iterator i = uasPropertyToLabelMap.constBegin(); i != uasPropertyToLabelMap.constEnd();i++)
     {
-        if (uasPropertyValueMap.contains(i.key()))
+        if (m_telemetryStorePtr->value(uasPropertyKeyMap.value(i.key(), -1), value))
+        {
+            i.value()->setValue(value.m_value);
+        }
+    }
+}
+
+void UASQuickView::updateKnownProperties()
+{
+    foreach (int key, m_telemetryStorePtr->keys())
+    {
+        if (m_knownStoreKeys.contains(key))
         {
-            i.value()->setValue(uasPropertyValueMap[i.key()]);
+            continue;
         }
+        m_knownStoreKeys.insert(key);
+        const QString name = UASTelemetryStore::nameOf(key);
+        const QString propername = name.mid(name.indexOf(":")+1) + " (" + UASTelemetryStore::unitOf(key) + ")";
+        if (!uasPropertyKeyMap.contains(propername) && quickViewSelectDialog)
+        {
+            quickViewSelectDialog->addItem(propername);
+        }
+        uasPropertyKeyMap[propername] = key;
     }
 }
 
@@ -359,39 +392,14 @@ void UASQuickView::setActiveUAS(UASInterface* uas)
         return;
     }
     this->uas = uas;
-    connect(uas,SIGNAL(valueChanged(int,QString,QString,QVariant,quint64)),this,
-            SLOT(valueChanged(int,QString,QString,QVariant,quint64)));
-
+    m_telemetryStorePtr = uas->getTelemetryStore();
+    m_lastStoreGeneration = 0;
 }
 void UASQuickView::addSource(MAVLinkDecoder *decoder)
 {
     Q_UNUSED(decoder);
     //connect(decoder,SIGNAL(valueChanged(int,QString,QString,QVariant,quint64)),this,SLOT(valueChanged(int,QString,QString,QVariant,quint64)));
 }
-void UASQuickView::valueChanged(const int uasId, const QString& name, const QString& unit, const QVariant& value, const quint64 msec)
-{
-    Q_UNUSED(msec);
-
-    if (this->uas->getUASID() != uasId)
-    {
-        //This message is for the non active UAS
-        return;
-    }
-    QString propername = name.mid(name.indexOf(":")+1);
-    if (!uasPropertyValueMap.contains(propername +" ("+unit+")"))
-    {
-        if (quickViewSelectDialog)
-        {
-            quickViewSelectDialog->addItem(propername +" ("+unit+")");
-        }
-    }
-    bool ok = false;
-    uasPropertyValueMap[propername +" ("+unit+")"] = value.toDouble(&ok);
-    if (!ok){
-        QLOG_ERROR() << "Quick View: Error Converting QuickView Item Value: " << propername;
-    }
-}
-
 void UASQuickView::actionTriggered(bool checked)
 {
     QAction *senderlabel = qobject_cast<QAction*>(sender());
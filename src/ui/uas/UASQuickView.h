@@ -4,6 +4,7 @@
 #include <QWidget>
 #include <QTimer>
 #include <QLabel>
+#include <QSet>
 #include "uas/UASManager.h"
 #include "uas/UASInterface.h"
 #include "ui_UASQuickView.h"
@@ -24,8 +25,20 @@ private:
     /** List of enabled properties */
     QList<QString> uasEnabledPropertyList;
 
-    /** Maps from the property name to the current value */
-    QMap<QString,double> uasPropertyValueMap;
+    /** Maps from the property name to the key in the telemetry store, -1 if not received yet */
+    QMap<QString,int> uasPropertyKeyMap;
+
+    /** Telemetry values of the active UAS */
+    UASTelemetryStore::Ptr m_telemetryStorePtr;
+
+    /** Store generation shown by the last update */
+    quint64 m_lastStoreGeneration;
+
+    /** Cache of telemetry store keys already assigned to a property name */
+    QSet<int> m_knownStoreKeys;
+
+    /** Adds the properties of all new keys in the telemetry store */
+    void updateKnownProperties();
 
     /** Maps from property name to the display item */
     QMap<QString,UASQuickViewItem*> uasPropertyToLabelMap;
@@ -45,7 +58,6 @@ private:
 
     void recalculateItemTextSizing();
 
-    void valueUpdate(const int uasId,const QString &name,const QString &unit,const double value,const quint64 msec);
 
     /** Column Count */
     int m_columnCount;
@@ -63,8 +75,6 @@ protected:
 signals:
     
 public slots:
-    void valueChanged(const int uasid, const QString& name, const QString& unit, const QVariant& value,const quint64 msecs);
-
     void actionTriggered(bool checked);
     void actionTriggered();
     void updateTimerTick();
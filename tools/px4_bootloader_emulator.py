@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+#
+# PX4 bootloader emulator on a pseudo terminal
+#
+# Emulates the serial protocol of the PX4 bootloader, so firmware flashing can be
+# tried without hardware. Start it and point APM Planner to the printed port:
+#
+#   ./px4_bootloader_emulator.py --flash-size 2080768
+#   APMPLANNER_PX4_UPLOADER_PORT=/dev/pts/5 apmplanner2
+#
+# Faults can be scripted to check the error handling of the uploader.
+#
+
+import argparse
+import os
+import pty
+import struct
+import sys
+import time
+import tty
+import zlib
+
+if sys.version_info.major < 3:
+    print("This tool requires python3")
+    sys.exit(1)
+
+INSYNC = 0x12
+EOC = 0x20
+OK = 0x10
+FAILED = 0x11
+INVALID = 0x13
+
+GET_SYNC = 0x21
+GET_DEVICE = 0x22
+CHIP_ERASE = 0x23
+PROG_MULTI = 0x27
+GET_CRC = 0x29
+GET_SN = 0x2b
+REBOOT = 0x30
+
+DEVICE_BL_REV = 0x01
+DEVICE_BOARD_ID = 0x02
+DEVICE_BOARD_REV = 0x03
+DEVICE_FW_SIZE = 0x04
+
+PROG_MULTI_MAX = 252
+
+
+class Bootloader(object):
+    """Protocol state of the emulated bootloader"""
+
+    def __init__(self, args):
+        self.args = args
+        self.flash = bytearray(b"\xff" * args.flash_size)
+        self.address = 0
+        self.packets = 0
+        self.bytes = 0
+        self.started = None
+
+    def device_info(self, param):
+        values = {
+            DEVICE_BL_REV: self.args.bl_rev,
+            DEVICE_BOARD_ID: self.args.board_id,
+            DEVICE_BOARD_REV: self.args.board_rev,
+            DEVICE_FW_SIZE: self.args.flash_size,
+        }
+        if param not in values:
+            return None
+        return struct.pack("<I", values[param])
+
+    def prog_multi(self, data):
+        max_size = PROG_MULTI_MAX if self.args.bl_rev >= 3 else 64
+        if len(data) % 4 != 0 or len(data) > max_size or self.address + len(data) > len(self.flash):
+            return False
+        self.packets += 1
+        if self.args.fail_packet and self.packets == self.args.fail_packet:
+            print("Failing PROG_MULTI packet %d as requested" % self.packets)
+            return False
+        if self.started is None:
+            self.started = time.time()
+        self.flash[self.address:self.address + len(data)] = data
+        self.address += len(data)
+        self.bytes += len(data)
+        return True
+
+    def crc(self):
+        # The bootloader crc32 has no initial or final inversion
+        crc = zlib.crc32(bytes(self.flash), 0xffffffff) ^ 0xffffffff
+        if self.args.bad_crc:
+            crc ^= 0x1
+        return struct.pack("<I", crc)
+
+
+class Emulator(object):
+    """Reads commands from the pty master and answers them"""
+
+    def __init__(self, fd, bootloader, args):
+        self.fd = fd
+        self.bl = bootloader
+        self.args = args
+        self.buffer = bytearray()
+
+    def read(self, count):
+        while len(self.buffer) < count:
+            self.buffer.extend(os.read(self.fd, 4096))
+        data = self.buffer[:count]
+        del self.buffer[:count]
+        return bytes(data)
+
+    def reply(self, data=b"", status=OK):
+        if self.args.latency > 0:
+            time.sleep(self.args.latency / 1000.0)
+        os.write(self.fd, data + bytes([INSYNC, status]))
+
+    def expect_eoc(self):
+        return self.read(1)[0] == EOC
+
+    def run(self):
+        while True:
+            command = self.read(1)[0]
+            if command == GET_SYNC:
+                if self.expect_eoc():
+                    self.reply()
+            elif command == GET_DEVICE:
+                param = self.read(1)[0]
+                if self.expect_eoc():
+                    info = self.bl.device_info(param)
+                    if info is None:
+                        self.reply(status=INVALID)
+                    else:
+                        self.reply(info)
+            elif command == GET_SN:
+                address = self.read(4)[0]
+                if self.expect_eoc():
+                    self.reply(struct.pack("<I", 0x12345678 + address))
+            elif command == CHIP_ERASE:
+                if self.expect_eoc():
+                    print("Erasing")
+                    time.sleep(self.args.erase_time)
+                    self.bl.flash[:] = b"\xff" * len(self.bl.flash)
+                    self.bl.address = 0
+                    self.reply()
+            elif command == PROG_MULTI:
+                count = self.read(1)[0]
+                data = self.read(count)
+                if self.expect_eoc():
+                    self.reply(status=OK if self.bl.prog_multi(data) else FAILED)
+            elif command == GET_CRC:
+                if self.expect_eoc():
+                    if self.bl.started is not None:
+                        elapsed = time.time() - self.bl.started
+                        print("Programmed %d bytes in %d packets, %.1f s (%.1f kB/s)" %
+                              (self.bl.bytes, self.bl.packets, elapsed, self.bl.bytes / 1000.0 / max(elapsed, 0.001)))
+                    self.reply(self.bl.crc())
+            elif command == REBOOT:
+                if self.expect_eoc():
+                    self.reply()
+                    print("Reboot requested")
+                    if not self.args.keep_running:
+                        return
+            else:
+                print("Unknown command 0x%02x" % command)
+                self.reply(status=INVALID)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="PX4 bootloader emulator on a pseudo terminal")
+    parser.add_argument("--bl-rev", type=int, default=5, help="bootloader revision (< 3 limits PROG_MULTI to 64 bytes)")
+    parser.add_argument("--board-id", type=int, default=9, help="board id (9 = fmu-v2)")
+    parser.add_argument("--board-rev", type=int, default=0, help="board revision")
+    parser.add_argument("--flash-size", type=int, default=2080768, help="flash size in bytes")
+    parser.add_argument("--erase-time", type=float, default=1.0, help="seconds a chip erase takes")
+    parser.add_argument("--latency", type=float, default=0.0, help="milliseconds before each reply")
+    parser.add_argument("--fail-packet", type=int, default=0, help="reject the n-th PROG_MULTI packet")
+    parser.add_argument("--bad-crc", action="store_true", help="report a wrong CRC")
+    parser.add_argument("--keep-running", action="store_true", help="keep running after a reboot request")
+    args = parser.parse_args()
+
+    master, slave = pty.openpty()
+    tty.setraw(slave)
+    print("Bootloader emulator listening on %s" % os.ttyname(slave))
+    sys.stdout.flush()
+    try:
+        Emulator(master, Bootloader(args), args).run()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()